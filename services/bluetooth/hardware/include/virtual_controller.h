@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIRTUAL_CONTROLLER_H
+#define VIRTUAL_CONTROLLER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bluetooth_hdi.h"
+
+namespace OHOS {
+namespace bluetooth {
+struct VirtualControllerConfig {
+    // Public device address, most significant byte first.
+    std::array<uint8_t, 6> address {0x00, 0x1B, 0xDC, 0x00, 0x00, 0x01};
+    // Num_HCI_Command_Packets granted by every Command Complete/Status event.
+    uint8_t numHciCommandPackets = 1;
+    uint16_t aclDataPacketLength = 1021;
+    uint16_t totalNumAclDataPackets = 8;
+    uint16_t leAclDataPacketLength = 251;
+    uint8_t totalNumLeAclDataPackets = 8;
+    // Application throughput of the simulated radio link per transport, 0 means unlimited.
+    uint32_t brEdrAirKbps = 2000;
+    uint32_t leAirKbps = 1300;
+    // LE Advertising Report events generated per second while scanning, 0 disables synthetic reports.
+    uint32_t advertisingReportsPerSecond = 10;
+    uint8_t syntheticAdvertisers = 16;
+    // Number Of Completed Packets events are coalesced over this interval.
+    uint32_t completedPacketsIntervalUs = 0;
+};
+
+/**
+ * @brief In-process Bluetooth controller behind the BtHdi interface.
+ *
+ * It keeps HCI command flow control and ACL buffer credits (Number Of Completed Packets) like a real controller,
+ * generates LE advertising reports, and links with one peer controller, in-process or over a stream socket, so
+ * that two hosts can inquire, page, connect, encrypt and exchange ACL data. All state is owned by one worker
+ * thread; packets for the host are delivered on it.
+ */
+class VirtualController {
+public:
+    using HostReceiver = std::function<void(BtPacketType type, const uint8_t *data, size_t size)>;
+    using AirSender = std::function<void(const std::vector<uint8_t> &pdu)>;
+
+    struct Stats {
+        uint64_t commands = 0;
+        // Commands sent while the host had no Num_HCI_Command_Packets credit.
+        uint64_t commandFlowViolations = 0;
+        // ACL packets sent while the host had no buffer credit.
+        uint64_t aclCreditViolations = 0;
+        uint64_t aclPacketsSent = 0;
+        uint64_t aclBytesSent = 0;
+        uint64_t aclPacketsReceived = 0;
+        uint64_t aclBytesReceived = 0;
+        // Air time the sent ACL data takes at the configured rate, in microseconds.
+        uint64_t aclAirTimeUs = 0;
+        uint64_t advertisingReports = 0;
+        // Due time of the last synthetic report after scanning was enabled, on the controller clock.
+        uint64_t lastAdvertisingReportUs = 0;
+    };
+
+    VirtualController(const VirtualControllerConfig &config, const HostReceiver &receiver);
+    ~VirtualController();
+
+    void Start();
+    void Stop();
+
+    /**
+     * @brief Host to controller packet, may be called from any thread.
+     */
+    void SendFromHost(BtPacketType type, const uint8_t *data, size_t size);
+
+    /**
+     * @brief Link two in-process controllers. Both must outlive the link.
+     */
+    static void Link(VirtualController &first, VirtualController &second);
+
+    /**
+     * @brief Link with a controller in another process over a connected stream socket. Takes ownership of fd.
+     */
+    void LinkSocket(int fd);
+
+    /**
+     * @brief Run task on the controller thread.
+     */
+    void Post(std::function<void()> task);
+
+    Stats GetStats();
+
+private:
+    enum ConnectionState : uint8_t {
+        DISCONNECTED,
+        PAGING,
+        INCOMING,
+        CONNECTED,
+    };
+
+    struct Connection {
+        ConnectionState state = DISCONNECTED;
+        uint16_t handle = 0;
+        // Bumped on every disconnection so that scheduled air transfers of an old link are dropped.
+        uint32_t epoch = 0;
+        // ACL packets accepted from the host and not yet reported as completed.
+        uint16_t inFlight = 0;
+        std::array<uint8_t, 6> address {};
+        bool encrypted = false;
+        bool encryptionPending = false;
+        std::array<uint8_t, 16> ltk {};
+        // Time at which the radio is free again.
+        std::chrono::steady_clock::time_point airBusyUntil {};
+    };
+
+    struct PeerState {
+        bool known = false;
+        std::array<uint8_t, 6> address {};
+        std::string name {};
+        bool pageScan = false;
+        bool inquiryScan = false;
+        bool advertising = false;
+        std::vector<uint8_t> advertisingData {};
+    };
+
+    struct Timer {
+        std::chrono::steady_clock::time_point when;
+        uint64_t sequence;
+        std::function<void()> task;
+        bool operator>(const Timer &other) const
+        {
+            return when != other.when ? when > other.when : sequence > other.sequence;
+        }
+    };
+
+    void PostAt(std::chrono::steady_clock::time_point when, std::function<void()> task);
+    void Run();
+
+    void OnCommand(const std::vector<uint8_t> &packet, uint64_t grant);
+    void OnAclFromHost(const std::vector<uint8_t> &packet);
+    void OnAir(const std::vector<uint8_t> &pdu);
+    // Answers a command shorter than its specified parameters with Invalid HCI Command Parameters.
+    bool RejectShortCommand(uint16_t opcode, size_t length);
+    bool OnLinkControlCommand(uint16_t opcode, const uint8_t *param, size_t length);
+    bool OnLeCommand(uint16_t opcode, const uint8_t *param, size_t length);
+    void OnLocalCommand(uint16_t opcode, const uint8_t *param, size_t length);
+
+    void SendEvent(uint8_t code, const std::vector<uint8_t> &param);
+    void SendLeEvent(uint8_t subevent, const std::vector<uint8_t> &param);
+    void SendCommandComplete(uint16_t opcode, const std::vector<uint8_t> &returnParam);
+    void SendCommandStatus(uint16_t opcode, uint8_t status);
+    void SendAir(uint8_t type, const std::vector<uint8_t> &payload);
+    void SendState();
+
+    void ConnectionComplete(bool le, uint8_t status, uint8_t role);
+    void Disconnected(bool le, uint8_t reason);
+    void EncryptionChange(bool le, uint8_t status);
+    void TryLeConnect();
+    void CompletePacket(uint16_t handle);
+    void FlushCompletedPackets();
+    void AdvertisingTick(uint64_t generation, std::chrono::steady_clock::time_point when);
+    void SendAdvertisingReport(uint64_t dueUs);
+    void OnLinkLost();
+    void ResetState();
+    void CloseLink();
+
+    Connection *FindConnection(uint16_t handle, bool &le);
+    int &Credits(bool le);
+
+    VirtualControllerConfig config_;
+    HostReceiver receiver_;
+    AirSender airSender_ {};
+
+    std::mutex mutex_ {};
+    std::condition_variable cond_ {};
+    std::queue<std::function<void()>> tasks_ {};
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_ {};
+    uint64_t timerSequence_ = 0;
+    bool running_ = false;
+    bool stopped_ = false;
+    std::thread thread_ {};
+
+    int linkFd_ = -1;
+    std::thread linkReader_ {};
+
+    std::mutex statsMutex_ {};
+    Stats stats_ {};
+
+    // Worker thread state.
+    // Command Complete/Status events delivered; a command carries the count the host had seen when sending it.
+    std::atomic<uint64_t> commandGrants_ {0};
+    uint64_t lastGrant_ = 0;
+    int commandsSinceGrant_ = 0;
+    int aclCredits_ = 0;
+    int leAclCredits_ = 0;
+    std::string localName_ {"virtual"};
+    bool pageScan_ = false;
+    bool inquiryScan_ = false;
+    bool advertising_ = false;
+    std::vector<uint8_t> advertisingData_ {};
+    bool scanning_ = false;
+    uint64_t scanGeneration_ = 0;
+    std::chrono::steady_clock::time_point scanStart_ {};
+    uint64_t inquiryGeneration_ = 0;
+    uint8_t syntheticIndex_ = 0;
+    bool leConnectPending_ = false;
+    bool leConnectAnyPeer_ = false;
+    std::array<uint8_t, 6> leConnectAddress_ {};
+    PeerState peer_ {};
+    Connection brEdr_ {};
+    Connection le_ {};
+    std::map<uint16_t, uint16_t> completedPackets_ {};
+    bool completedFlushPending_ = false;
+};
+}  // namespace bluetooth
+}  // namespace OHOS
+
+#endif  // VIRTUAL_CONTROLLER_H
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * BtHdi backed by VirtualController, for running the stack without a Bluetooth chip.
+ *
+ * Environment:
+ *   BT_VIRTUAL_ADDRESS  device address, "00:1B:DC:00:00:01" by default.
+ *   BT_VIRTUAL_LINK     unix socket path; the first process listens on it, the second connects, and the two
+ *                       virtual controllers see each other over the air.
+ *   BT_VIRTUAL_ADV_RATE synthetic LE advertising reports per second while scanning.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "bluetooth_hdi.h"
+#include "virtual_controller.h"
+
+#ifndef NO_SANITIZE
+#ifdef __has_attribute
+#if __has_attribute(no_sanitize)
+#define NO_SANITIZE(type) __attribute__((no_sanitize(type)))
+#endif
+#endif
+#endif
+
+#ifndef NO_SANITIZE
+#define NO_SANITIZE(type)
+#endif
+
+using OHOS::bluetooth::VirtualController;
+using OHOS::bluetooth::VirtualControllerConfig;
+
+namespace {
+constexpr int ADDRESS_FIELDS = 6;
+
+std::mutex g_mutex;
+std::unique_ptr<VirtualController> g_controller = nullptr;
+int g_listenFd = -1;
+std::thread g_acceptThread;
+
+NO_SANITIZE("cfi") void DeliverPacket(const BtHciCallbacks *callbacks, BtPacketType type, const uint8_t *data,
+    size_t size)
+{
+    BtPacket packet = {
+        .data = const_cast<uint8_t *>(data),
+        .size = static_cast<uint32_t>(size),
+    };
+    callbacks->OnReceivedHciPacket(type, &packet);
+}
+
+NO_SANITIZE("cfi") void ReportInited(const BtHciCallbacks *callbacks)
+{
+    callbacks->OnInited(SUCCESS);
+}
+
+void LoadConfig(VirtualControllerConfig &config)
+{
+    const char *address = getenv("BT_VIRTUAL_ADDRESS");
+    unsigned int fields[ADDRESS_FIELDS];
+    if (address != nullptr && sscanf(address, "%2x:%2x:%2x:%2x:%2x:%2x", &fields[0], &fields[1], &fields[2],
+        &fields[3], &fields[4], &fields[5]) == ADDRESS_FIELDS) {
+        for (int i = 0; i < ADDRESS_FIELDS; i++) {
+            config.address[i] = static_cast<uint8_t>(fields[i]);
+        }
+    }
+    const char *rate = getenv("BT_VIRTUAL_ADV_RATE");
+    if (rate != nullptr) {
+        config.advertisingReportsPerSecond = static_cast<uint32_t>(strtoul(rate, nullptr, 0));
+    }
+}
+
+// Connects to the peer process, or waits for it on a fresh socket when nobody listens yet.
+void StartLink(VirtualController &controller, const char *path)
+{
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        return;
+    }
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0) {
+        controller.LinkSocket(fd);
+        return;
+    }
+    unlink(path);
+    if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(fd, 1) != 0) {
+        close(fd);
+        return;
+    }
+    g_listenFd = fd;
+    g_acceptThread = std::thread([&controller, fd]() {
+        int peer = accept4(fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (peer >= 0) {
+            controller.LinkSocket(peer);
+        }
+    });
+}
+
+void StopLink()
+{
+    if (g_listenFd >= 0) {
+        shutdown(g_listenFd, SHUT_RDWR);
+    }
+    if (g_acceptThread.joinable()) {
+        g_acceptThread.join();
+    }
+    if (g_listenFd >= 0) {
+        close(g_listenFd);
+        g_listenFd = -1;
+    }
+}
+}  // namespace
+
+int HdiInit(BtHciCallbacks *callbacks)
+{
+    if (callbacks == nullptr) {
+        return INITIALIZATION_ERROR;
+    }
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (g_controller != nullptr) {
+        return INITIALIZATION_ERROR;
+    }
+
+    VirtualControllerConfig config;
+    LoadConfig(config);
+    g_controller = std::make_unique<VirtualController>(
+        config, [callbacks](BtPacketType type, const uint8_t *data, size_t size) {
+            DeliverPacket(callbacks, type, data, size);
+        });
+    g_controller->Start();
+    const char *link = getenv("BT_VIRTUAL_LINK");
+    if (link != nullptr && link[0] != '\0') {
+        StartLink(*g_controller, link);
+    }
+    // Like the chip HDI, initialization is reported from the controller thread.
+    g_controller->Post([callbacks]() { ReportInited(callbacks); });
+    return SUCCESS;
+}
+
+int HdiSendHciPacket(BtPacketType type, const BtPacket *packet)
+{
+    if (packet == nullptr) {
+        return TRANSPORT_ERROR;
+    }
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (g_controller == nullptr) {
+        return INITIALIZATION_ERROR;
+    }
+    g_controller->SendFromHost(type, packet->data, packet->size);
+    return SUCCESS;
+}
+
+void HdiClose()
+{
+    std::unique_ptr<VirtualController> controller;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        controller = std::move(g_controller);
+    }
+    if (controller != nullptr) {
+        StopLink();
+        controller->Stop();
+    }
+}
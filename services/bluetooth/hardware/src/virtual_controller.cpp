@@ -0,0 +1,1552 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "virtual_controller.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <random>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr uint8_t OGF_LINK_CONTROL = 0x01;
+constexpr uint8_t OGF_LINK_POLICY = 0x02;
+constexpr uint8_t OGF_LE = 0x08;
+
+constexpr uint16_t HCI_INQUIRY = 0x0401;
+constexpr uint16_t HCI_INQUIRY_CANCEL = 0x0402;
+constexpr uint16_t HCI_CREATE_CONNECTION = 0x0405;
+constexpr uint16_t HCI_DISCONNECT = 0x0406;
+constexpr uint16_t HCI_CREATE_CONNECTION_CANCEL = 0x0408;
+constexpr uint16_t HCI_ACCEPT_CONNECTION_REQUEST = 0x0409;
+constexpr uint16_t HCI_REJECT_CONNECTION_REQUEST = 0x040A;
+constexpr uint16_t HCI_AUTHENTICATION_REQUESTED = 0x0411;
+constexpr uint16_t HCI_SET_CONNECTION_ENCRYPTION = 0x0413;
+constexpr uint16_t HCI_REMOTE_NAME_REQUEST = 0x0419;
+constexpr uint16_t HCI_READ_REMOTE_SUPPORTED_FEATURES = 0x041B;
+constexpr uint16_t HCI_READ_REMOTE_EXTENDED_FEATURES = 0x041C;
+constexpr uint16_t HCI_READ_REMOTE_VERSION_INFORMATION = 0x041D;
+constexpr uint16_t HCI_READ_CLOCK_OFFSET = 0x041F;
+constexpr uint16_t HCI_SNIFF_MODE = 0x0803;
+constexpr uint16_t HCI_EXIT_SNIFF_MODE = 0x0804;
+constexpr uint16_t HCI_RESET = 0x0C03;
+constexpr uint16_t HCI_WRITE_LOCAL_NAME = 0x0C13;
+constexpr uint16_t HCI_READ_LOCAL_NAME = 0x0C14;
+constexpr uint16_t HCI_WRITE_SCAN_ENABLE = 0x0C1A;
+constexpr uint16_t HCI_READ_LOCAL_VERSION_INFORMATION = 0x1001;
+constexpr uint16_t HCI_READ_LOCAL_SUPPORTED_COMMANDS = 0x1002;
+constexpr uint16_t HCI_READ_LOCAL_SUPPORTED_FEATURES = 0x1003;
+constexpr uint16_t HCI_READ_LOCAL_EXTENDED_FEATURES = 0x1004;
+constexpr uint16_t HCI_READ_BUFFER_SIZE = 0x1005;
+constexpr uint16_t HCI_READ_BD_ADDR = 0x1009;
+constexpr uint16_t HCI_LE_READ_BUFFER_SIZE = 0x2002;
+constexpr uint16_t HCI_LE_READ_LOCAL_SUPPORTED_FEATURES = 0x2003;
+constexpr uint16_t HCI_LE_READ_ADVERTISING_CHANNEL_TX_POWER = 0x2007;
+constexpr uint16_t HCI_LE_SET_ADVERTISING_DATA = 0x2008;
+constexpr uint16_t HCI_LE_SET_ADVERTISING_ENABLE = 0x200A;
+constexpr uint16_t HCI_LE_SET_SCAN_ENABLE = 0x200C;
+constexpr uint16_t HCI_LE_CREATE_CONNECTION = 0x200D;
+constexpr uint16_t HCI_LE_CREATE_CONNECTION_CANCEL = 0x200E;
+constexpr uint16_t HCI_LE_READ_WHITE_LIST_SIZE = 0x200F;
+constexpr uint16_t HCI_LE_CONNECTION_UPDATE = 0x2013;
+constexpr uint16_t HCI_LE_READ_REMOTE_FEATURES = 0x2016;
+constexpr uint16_t HCI_LE_ENCRYPT = 0x2017;
+constexpr uint16_t HCI_LE_RAND = 0x2018;
+constexpr uint16_t HCI_LE_START_ENCRYPTION = 0x2019;
+constexpr uint16_t HCI_LE_LONG_TERM_KEY_REQUEST_REPLY = 0x201A;
+constexpr uint16_t HCI_LE_LONG_TERM_KEY_REQUEST_NEGATIVE_REPLY = 0x201B;
+constexpr uint16_t HCI_LE_READ_SUPPORTED_STATES = 0x201C;
+constexpr uint16_t HCI_LE_READ_SUGGESTED_DEFAULT_DATA_LENGTH = 0x2023;
+constexpr uint16_t HCI_LE_READ_LOCAL_P256_PUBLIC_KEY = 0x2025;
+constexpr uint16_t HCI_LE_GENERATE_DHKEY = 0x2026;
+constexpr uint16_t HCI_LE_READ_RESOLVING_LIST_SIZE = 0x202A;
+constexpr uint16_t HCI_LE_READ_MAXIMUM_DATA_LENGTH = 0x202F;
+
+constexpr uint8_t HCI_INQUIRY_COMPLETE_EVENT = 0x01;
+constexpr uint8_t HCI_INQUIRY_RESULT_EVENT = 0x02;
+constexpr uint8_t HCI_CONNECTION_COMPLETE_EVENT = 0x03;
+constexpr uint8_t HCI_CONNECTION_REQUEST_EVENT = 0x04;
+constexpr uint8_t HCI_DISCONNECTION_COMPLETE_EVENT = 0x05;
+constexpr uint8_t HCI_AUTHENTICATION_COMPLETE_EVENT = 0x06;
+constexpr uint8_t HCI_REMOTE_NAME_REQUEST_COMPLETE_EVENT = 0x07;
+constexpr uint8_t HCI_ENCRYPTION_CHANGE_EVENT = 0x08;
+constexpr uint8_t HCI_READ_REMOTE_SUPPORTED_FEATURES_COMPLETE_EVENT = 0x0B;
+constexpr uint8_t HCI_READ_REMOTE_VERSION_INFORMATION_COMPLETE_EVENT = 0x0C;
+constexpr uint8_t HCI_COMMAND_COMPLETE_EVENT = 0x0E;
+constexpr uint8_t HCI_COMMAND_STATUS_EVENT = 0x0F;
+constexpr uint8_t HCI_NUMBER_OF_COMPLETED_PACKETS_EVENT = 0x13;
+constexpr uint8_t HCI_MODE_CHANGE_EVENT = 0x14;
+constexpr uint8_t HCI_READ_CLOCK_OFFSET_COMPLETE_EVENT = 0x1C;
+constexpr uint8_t HCI_READ_REMOTE_EXTENDED_FEATURES_COMPLETE_EVENT = 0x23;
+constexpr uint8_t HCI_ENCRYPTION_KEY_REFRESH_COMPLETE_EVENT = 0x30;
+constexpr uint8_t HCI_LE_META_EVENT = 0x3E;
+
+constexpr uint8_t HCI_LE_CONNECTION_COMPLETE_EVENT = 0x01;
+constexpr uint8_t HCI_LE_ADVERTISING_REPORT_EVENT = 0x02;
+constexpr uint8_t HCI_LE_CONNECTION_UPDATE_COMPLETE_EVENT = 0x03;
+constexpr uint8_t HCI_LE_READ_REMOTE_FEATURES_COMPLETE_EVENT = 0x04;
+constexpr uint8_t HCI_LE_LONG_TERM_KEY_REQUEST_EVENT = 0x05;
+constexpr uint8_t HCI_LE_READ_LOCAL_P256_PUBLIC_KEY_COMPLETE_EVENT = 0x08;
+constexpr uint8_t HCI_LE_GENERATE_DHKEY_COMPLETE_EVENT = 0x09;
+
+constexpr uint8_t HCI_SUCCESS = 0x00;
+constexpr uint8_t HCI_UNKNOWN_HCI_COMMAND = 0x01;
+constexpr uint8_t HCI_UNKNOWN_CONNECTION_IDENTIFIER = 0x02;
+constexpr uint8_t HCI_PAGE_TIMEOUT = 0x04;
+constexpr uint8_t HCI_PIN_OR_KEY_MISSING = 0x06;
+constexpr uint8_t HCI_CONNECTION_TIMEOUT = 0x08;
+constexpr uint8_t HCI_ACL_CONNECTION_ALREADY_EXISTS = 0x0B;
+constexpr uint8_t HCI_COMMAND_DISALLOWED = 0x0C;
+constexpr uint8_t HCI_REJECTED_LIMITED_RESOURCES = 0x0D;
+constexpr uint8_t HCI_INVALID_HCI_COMMAND_PARAMETERS = 0x12;
+constexpr uint8_t HCI_REMOTE_POWER_OFF = 0x15;
+constexpr uint8_t HCI_LOCAL_HOST_TERMINATED = 0x16;
+constexpr uint8_t HCI_MIC_FAILURE = 0x3D;
+
+constexpr uint8_t ROLE_MASTER = 0x00;
+constexpr uint8_t ROLE_SLAVE = 0x01;
+constexpr uint8_t LINK_TYPE_ACL = 0x01;
+constexpr uint8_t MODE_ACTIVE = 0x00;
+constexpr uint8_t MODE_SNIFF = 0x02;
+constexpr uint8_t ADV_IND = 0x00;
+constexpr uint8_t ADDRESS_TYPE_PUBLIC = 0x00;
+constexpr uint8_t ADDRESS_TYPE_RANDOM = 0x01;
+constexpr uint8_t PB_FIRST_FLUSHABLE = 0x02;
+constexpr uint8_t PB_FIRST_NON_FLUSHABLE = 0x00;
+constexpr uint8_t PB_FLAG_MASK = 0x03;
+
+constexpr uint16_t BR_EDR_HANDLE = 0x0001;
+constexpr uint16_t LE_HANDLE = 0x0041;
+constexpr uint16_t HANDLE_MASK = 0x0FFF;
+constexpr uint8_t HANDLE_FLAGS_SHIFT = 12;
+
+struct CommandParamSpec {
+    uint16_t opcode;
+    // Parameter length defined by the core specification.
+    uint8_t length;
+    // Answered by Command Complete rather than Command Status.
+    bool complete;
+};
+
+// Commands handled by OnLinkControlCommand and OnLeCommand.
+constexpr CommandParamSpec COMMAND_PARAM_SPECS[] = {
+    {HCI_INQUIRY, 5, false},
+    {HCI_INQUIRY_CANCEL, 0, true},
+    {HCI_CREATE_CONNECTION, 13, false},
+    {HCI_DISCONNECT, 3, false},
+    {HCI_CREATE_CONNECTION_CANCEL, 6, true},
+    {HCI_ACCEPT_CONNECTION_REQUEST, 7, false},
+    {HCI_REJECT_CONNECTION_REQUEST, 7, false},
+    {HCI_AUTHENTICATION_REQUESTED, 2, false},
+    {HCI_SET_CONNECTION_ENCRYPTION, 3, false},
+    {HCI_REMOTE_NAME_REQUEST, 10, false},
+    {HCI_READ_REMOTE_SUPPORTED_FEATURES, 2, false},
+    {HCI_READ_REMOTE_EXTENDED_FEATURES, 3, false},
+    {HCI_READ_REMOTE_VERSION_INFORMATION, 2, false},
+    {HCI_READ_CLOCK_OFFSET, 2, false},
+    {HCI_SNIFF_MODE, 10, false},
+    {HCI_EXIT_SNIFF_MODE, 2, false},
+    {HCI_LE_SET_ADVERTISING_DATA, 32, true},
+    {HCI_LE_SET_ADVERTISING_ENABLE, 1, true},
+    {HCI_LE_SET_SCAN_ENABLE, 2, true},
+    {HCI_LE_CREATE_CONNECTION, 25, false},
+    {HCI_LE_CREATE_CONNECTION_CANCEL, 0, true},
+    {HCI_LE_CONNECTION_UPDATE, 14, false},
+    {HCI_LE_READ_REMOTE_FEATURES, 2, false},
+    {HCI_LE_ENCRYPT, 32, true},
+    {HCI_LE_RAND, 0, true},
+    {HCI_LE_START_ENCRYPTION, 28, false},
+    {HCI_LE_LONG_TERM_KEY_REQUEST_REPLY, 18, true},
+    {HCI_LE_LONG_TERM_KEY_REQUEST_NEGATIVE_REPLY, 2, true},
+    {HCI_LE_READ_LOCAL_P256_PUBLIC_KEY, 0, false},
+    {HCI_LE_GENERATE_DHKEY, 64, false},
+};
+constexpr size_t COMMAND_HEADER_SIZE = 3;
+constexpr size_t ACL_HEADER_SIZE = 4;
+constexpr size_t MAX_PARAM_SIZE = 255;
+constexpr size_t ADDRESS_SIZE = 6;
+constexpr size_t NAME_SIZE = 248;
+constexpr size_t KEY_SIZE = 16;
+constexpr size_t RAND_SIZE = 8;
+constexpr size_t EDIV_SIZE = 2;
+constexpr size_t P256_PUBLIC_KEY_SIZE = 64;
+constexpr size_t DHKEY_SIZE = 32;
+constexpr size_t FEATURES_SIZE = 8;
+constexpr size_t SUPPORTED_COMMANDS_SIZE = 64;
+constexpr size_t MAX_ADVERTISING_DATA_SIZE = 31;
+constexpr uint8_t HCI_VERSION_5_0 = 0x09;
+constexpr uint16_t MANUFACTURER_UNKNOWN = 0xFFFF;
+constexpr uint8_t WHITE_LIST_SIZE = 16;
+constexpr uint8_t RESOLVING_LIST_SIZE = 16;
+constexpr uint16_t LE_MAX_DATA_OCTETS = 251;
+constexpr uint16_t LE_MAX_DATA_TIME = 2120;
+constexpr uint16_t LE_DEFAULT_DATA_OCTETS = 27;
+constexpr uint16_t LE_DEFAULT_DATA_TIME = 328;
+constexpr uint16_t LE_CONNECTION_INTERVAL = 0x0018;
+constexpr uint16_t LE_SUPERVISION_TIMEOUT = 0x01F4;
+constexpr uint8_t SCAN_ENABLE_INQUIRY = 0x01;
+constexpr uint8_t SCAN_ENABLE_PAGE = 0x02;
+constexpr uint8_t STATE_PAGE_SCAN = 0x01;
+constexpr uint8_t STATE_INQUIRY_SCAN = 0x02;
+constexpr uint8_t STATE_ADVERTISING = 0x04;
+constexpr uint8_t LE_FILTER_WHITE_LIST = 0x01;
+constexpr int8_t SYNTHETIC_RSSI = -60;
+constexpr uint8_t ADVERTISING_TX_POWER = 0;
+constexpr std::array<uint8_t, 3> CLASS_OF_DEVICE = {0x0C, 0x02, 0x5A};
+
+constexpr auto INQUIRY_LENGTH_UNIT = std::chrono::milliseconds(1280);
+constexpr auto INQUIRY_RESPONSE_DELAY = std::chrono::milliseconds(50);
+constexpr auto PAGE_TIMEOUT = std::chrono::milliseconds(200);
+constexpr auto REMOTE_NAME_DELAY = std::chrono::milliseconds(20);
+constexpr uint64_t MICROSECONDS_PER_SECOND = 1000000;
+constexpr uint64_t BITS_PER_BYTE = 8;
+constexpr uint64_t BITS_PER_KBIT = 1000;
+
+// LMP features page 0: 3-slot and 5-slot packets, encryption, sniff, RSSI, EDR, eSCO, SSP, LE and extended features.
+constexpr std::array<uint8_t, FEATURES_SIZE> LMP_FEATURES = {0xFF, 0xFE, 0x8F, 0xFE, 0xDB, 0xFF, 0x5B, 0x87};
+// LMP features page 1: Secure Simple Pairing, LE and simultaneous LE/BR-EDR host support.
+constexpr std::array<uint8_t, FEATURES_SIZE> LMP_HOST_FEATURES = {0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+// Encryption, connection parameters request, extended reject, slave features exchange, ping, data length.
+constexpr std::array<uint8_t, FEATURES_SIZE> LE_FEATURES = {0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+enum AirType : uint8_t {
+    AIR_STATE,
+    AIR_PAGE,
+    AIR_PAGE_ACCEPT,
+    AIR_PAGE_REJECT,
+    AIR_PAGE_CANCEL,
+    AIR_LE_CONNECT,
+    AIR_LE_ACCEPT,
+    AIR_LE_REJECT,
+    AIR_ACL,
+    AIR_DISCONNECT,
+    AIR_ENCRYPT,
+    AIR_LE_ENC_REQUEST,
+    AIR_LE_ENC_RESULT,
+    AIR_LE_ENC_DONE,
+    AIR_LE_CONNECTION_UPDATE,
+};
+
+// Air PDUs on a socket link are prefixed by a little endian 16 bit length.
+constexpr size_t AIR_FRAME_HEADER_SIZE = 2;
+
+void AppendUint16(std::vector<uint8_t> &out, uint16_t value)
+{
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+uint16_t ReadUint16(const uint8_t *data)
+{
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+// Addresses are kept most significant byte first and are little endian on HCI.
+void AppendAddress(std::vector<uint8_t> &out, const std::array<uint8_t, ADDRESS_SIZE> &address)
+{
+    out.insert(out.end(), address.rbegin(), address.rend());
+}
+
+std::array<uint8_t, ADDRESS_SIZE> ReadAddress(const uint8_t *data)
+{
+    std::array<uint8_t, ADDRESS_SIZE> address;
+    std::reverse_copy(data, data + ADDRESS_SIZE, address.begin());
+    return address;
+}
+
+template<size_t N>
+void AppendArray(std::vector<uint8_t> &out, const std::array<uint8_t, N> &data)
+{
+    out.insert(out.end(), data.begin(), data.end());
+}
+
+void AppendName(std::vector<uint8_t> &out, const std::string &name)
+{
+    size_t length = std::min(name.size(), NAME_SIZE);
+    out.insert(out.end(), name.begin(), name.begin() + length);
+    out.insert(out.end(), NAME_SIZE - length, 0);
+}
+
+constexpr uint8_t AES_SBOX[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+constexpr size_t AES_BLOCK_SIZE = 16;
+constexpr size_t AES_ROUNDS = 10;
+constexpr size_t AES_COLUMNS = 4;
+
+uint8_t AesXtime(uint8_t value)
+{
+    return static_cast<uint8_t>((value << 1) ^ ((value & 0x80) ? 0x1B : 0x00));
+}
+
+// AES-128 on big endian blocks, as LE Encrypt requires.
+std::array<uint8_t, AES_BLOCK_SIZE> Aes128Encrypt(
+    const std::array<uint8_t, AES_BLOCK_SIZE> &key, const std::array<uint8_t, AES_BLOCK_SIZE> &plaintext)
+{
+    std::array<uint8_t, AES_BLOCK_SIZE * (AES_ROUNDS + 1)> roundKeys;
+    std::copy(key.begin(), key.end(), roundKeys.begin());
+    uint8_t rcon = 0x01;
+    for (size_t i = AES_BLOCK_SIZE; i < roundKeys.size(); i += AES_COLUMNS) {
+        uint8_t word[AES_COLUMNS] = {roundKeys[i - 4], roundKeys[i - 3], roundKeys[i - 2], roundKeys[i - 1]};
+        if (i % AES_BLOCK_SIZE == 0) {
+            uint8_t first = word[0];
+            word[0] = AES_SBOX[word[1]] ^ rcon;
+            word[1] = AES_SBOX[word[2]];
+            word[2] = AES_SBOX[word[3]];
+            word[3] = AES_SBOX[first];
+            rcon = AesXtime(rcon);
+        }
+        for (size_t j = 0; j < AES_COLUMNS; j++) {
+            roundKeys[i + j] = roundKeys[i + j - AES_BLOCK_SIZE] ^ word[j];
+        }
+    }
+
+    std::array<uint8_t, AES_BLOCK_SIZE> state;
+    for (size_t i = 0; i < AES_BLOCK_SIZE; i++) {
+        state[i] = plaintext[i] ^ roundKeys[i];
+    }
+    for (size_t round = 1; round <= AES_ROUNDS; round++) {
+        std::array<uint8_t, AES_BLOCK_SIZE> shifted;
+        for (size_t column = 0; column < AES_COLUMNS; column++) {
+            for (size_t row = 0; row < AES_COLUMNS; row++) {
+                shifted[column * AES_COLUMNS + row] =
+                    AES_SBOX[state[((column + row) % AES_COLUMNS) * AES_COLUMNS + row]];
+            }
+        }
+        if (round != AES_ROUNDS) {
+            for (size_t column = 0; column < AES_COLUMNS; column++) {
+                uint8_t *c = &shifted[column * AES_COLUMNS];
+                uint8_t all = c[0] ^ c[1] ^ c[2] ^ c[3];
+                uint8_t first = c[0];
+                c[0] ^= all ^ AesXtime(c[0] ^ c[1]);
+                c[1] ^= all ^ AesXtime(c[1] ^ c[2]);
+                c[2] ^= all ^ AesXtime(c[2] ^ c[3]);
+                c[3] ^= all ^ AesXtime(c[3] ^ first);
+            }
+        }
+        for (size_t i = 0; i < AES_BLOCK_SIZE; i++) {
+            state[i] = shifted[i] ^ roundKeys[round * AES_BLOCK_SIZE + i];
+        }
+    }
+    return state;
+}
+
+// Stand-in for a P-256 key pair: a public key derived from the address. Generate DHKey combines both public
+// keys symmetrically, so two virtual controllers agree on the DHKey without elliptic curve arithmetic.
+std::array<uint8_t, P256_PUBLIC_KEY_SIZE> PublicKeyFromAddress(const std::array<uint8_t, ADDRESS_SIZE> &address)
+{
+    std::array<uint8_t, P256_PUBLIC_KEY_SIZE> key;
+    uint64_t seed = 0;
+    for (uint8_t byte : address) {
+        seed = (seed << 8) | byte;
+    }
+    std::mt19937_64 generator(seed);
+    for (auto &byte : key) {
+        byte = static_cast<uint8_t>(generator());
+    }
+    return key;
+}
+
+bool ReadFully(int fd, uint8_t *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t ret = read(fd, data, size);
+        if (ret <= 0) {
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += ret;
+        size -= static_cast<size_t>(ret);
+    }
+    return true;
+}
+
+bool WriteFully(int fd, const uint8_t *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t ret = send(fd, data, size, MSG_NOSIGNAL);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += ret;
+        size -= static_cast<size_t>(ret);
+    }
+    return true;
+}
+}  // namespace
+
+VirtualController::VirtualController(const VirtualControllerConfig &config, const HostReceiver &receiver)
+    : config_(config), receiver_(receiver)
+{}
+
+VirtualController::~VirtualController()
+{
+    Stop();
+}
+
+void VirtualController::Start()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_ || stopped_) {
+        return;
+    }
+    ResetState();
+    running_ = true;
+    thread_ = std::thread(&VirtualController::Run, this);
+}
+
+void VirtualController::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            return;
+        }
+        stopped_ = true;
+        running_ = false;
+        cond_.notify_all();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    CloseLink();
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_ = {};
+    timers_ = {};
+}
+
+void VirtualController::Post(std::function<void()> task)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+        return;
+    }
+    tasks_.push(std::move(task));
+    cond_.notify_one();
+}
+
+void VirtualController::PostAt(std::chrono::steady_clock::time_point when, std::function<void()> task)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+        return;
+    }
+    timers_.push(Timer {when, timerSequence_++, std::move(task)});
+    cond_.notify_one();
+}
+
+void VirtualController::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        std::function<void()> task;
+        if (!timers_.empty() && timers_.top().when <= std::chrono::steady_clock::now()) {
+            task = std::move(const_cast<Timer &>(timers_.top()).task);
+            timers_.pop();
+        } else if (!tasks_.empty()) {
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        } else if (timers_.empty()) {
+            cond_.wait(lock);
+            continue;
+        } else {
+            cond_.wait_until(lock, timers_.top().when);
+            continue;
+        }
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+void VirtualController::SendFromHost(BtPacketType type, const uint8_t *data, size_t size)
+{
+    if (data == nullptr || size == 0) {
+        return;
+    }
+    std::vector<uint8_t> packet(data, data + size);
+    if (type == PACKET_TYPE_CMD) {
+        uint64_t grant = commandGrants_.load();
+        Post([this, packet, grant]() { OnCommand(packet, grant); });
+    } else if (type == PACKET_TYPE_ACL) {
+        Post([this, packet]() { OnAclFromHost(packet); });
+    }
+}
+
+void VirtualController::Link(VirtualController &first, VirtualController &second)
+{
+    first.Post([&first, &second]() {
+        first.airSender_ = [&second](const std::vector<uint8_t> &pdu) {
+            second.Post([&second, pdu]() { second.OnAir(pdu); });
+        };
+        first.SendState();
+    });
+    second.Post([&first, &second]() {
+        second.airSender_ = [&first](const std::vector<uint8_t> &pdu) {
+            first.Post([&first, pdu]() { first.OnAir(pdu); });
+        };
+        second.SendState();
+    });
+}
+
+void VirtualController::LinkSocket(int fd)
+{
+    linkFd_ = fd;
+    linkReader_ = std::thread([this, fd]() {
+        std::vector<uint8_t> pdu;
+        uint8_t header[AIR_FRAME_HEADER_SIZE];
+        while (ReadFully(fd, header, sizeof(header))) {
+            pdu.resize(ReadUint16(header));
+            if (!ReadFully(fd, pdu.data(), pdu.size())) {
+                break;
+            }
+            Post([this, pdu]() { OnAir(pdu); });
+        }
+        Post([this]() { OnLinkLost(); });
+    });
+    Post([this, fd]() {
+        airSender_ = [fd](const std::vector<uint8_t> &pdu) {
+            std::vector<uint8_t> frame;
+            frame.reserve(AIR_FRAME_HEADER_SIZE + pdu.size());
+            AppendUint16(frame, static_cast<uint16_t>(pdu.size()));
+            frame.insert(frame.end(), pdu.begin(), pdu.end());
+            WriteFully(fd, frame.data(), frame.size());
+        };
+        SendState();
+    });
+}
+
+void VirtualController::CloseLink()
+{
+    if (linkFd_ < 0) {
+        return;
+    }
+    shutdown(linkFd_, SHUT_RDWR);
+    if (linkReader_.joinable()) {
+        linkReader_.join();
+    }
+    close(linkFd_);
+    linkFd_ = -1;
+}
+
+VirtualController::Stats VirtualController::GetStats()
+{
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return stats_;
+}
+
+void VirtualController::ResetState()
+{
+    for (bool le : {false, true}) {
+        Connection &connection = le ? le_ : brEdr_;
+        if (connection.state != DISCONNECTED) {
+            SendAir(AIR_DISCONNECT, {static_cast<uint8_t>(le), HCI_REMOTE_POWER_OFF});
+        }
+        uint32_t epoch = connection.epoch + 1;
+        connection = Connection();
+        connection.epoch = epoch;
+        connection.handle = le ? LE_HANDLE : BR_EDR_HANDLE;
+    }
+    aclCredits_ = config_.totalNumAclDataPackets;
+    leAclCredits_ = config_.totalNumLeAclDataPackets;
+    pageScan_ = false;
+    inquiryScan_ = false;
+    advertising_ = false;
+    scanning_ = false;
+    scanGeneration_++;
+    inquiryGeneration_++;
+    leConnectPending_ = false;
+    completedPackets_.clear();
+    SendState();
+}
+
+VirtualController::Connection *VirtualController::FindConnection(uint16_t handle, bool &le)
+{
+    if (handle == brEdr_.handle && brEdr_.state == CONNECTED) {
+        le = false;
+        return &brEdr_;
+    }
+    if (handle == le_.handle && le_.state == CONNECTED) {
+        le = true;
+        return &le_;
+    }
+    return nullptr;
+}
+
+int &VirtualController::Credits(bool le)
+{
+    return le ? leAclCredits_ : aclCredits_;
+}
+
+void VirtualController::SendEvent(uint8_t code, const std::vector<uint8_t> &param)
+{
+    std::vector<uint8_t> packet;
+    packet.reserve(param.size() + 2);
+    packet.push_back(code);
+    packet.push_back(static_cast<uint8_t>(param.size()));
+    packet.insert(packet.end(), param.begin(), param.end());
+    receiver_(PACKET_TYPE_EVENT, packet.data(), packet.size());
+}
+
+void VirtualController::SendLeEvent(uint8_t subevent, const std::vector<uint8_t> &param)
+{
+    std::vector<uint8_t> event;
+    event.reserve(param.size() + 1);
+    event.push_back(subevent);
+    event.insert(event.end(), param.begin(), param.end());
+    SendEvent(HCI_LE_META_EVENT, event);
+}
+
+void VirtualController::SendCommandComplete(uint16_t opcode, const std::vector<uint8_t> &returnParam)
+{
+    commandGrants_++;
+    std::vector<uint8_t> param = {config_.numHciCommandPackets};
+    AppendUint16(param, opcode);
+    param.insert(param.end(), returnParam.begin(), returnParam.end());
+    SendEvent(HCI_COMMAND_COMPLETE_EVENT, param);
+}
+
+void VirtualController::SendCommandStatus(uint16_t opcode, uint8_t status)
+{
+    commandGrants_++;
+    std::vector<uint8_t> param = {status, config_.numHciCommandPackets};
+    AppendUint16(param, opcode);
+    SendEvent(HCI_COMMAND_STATUS_EVENT, param);
+}
+
+void VirtualController::SendAir(uint8_t type, const std::vector<uint8_t> &payload)
+{
+    if (!airSender_) {
+        return;
+    }
+    std::vector<uint8_t> pdu;
+    pdu.reserve(payload.size() + 1);
+    pdu.push_back(type);
+    pdu.insert(pdu.end(), payload.begin(), payload.end());
+    airSender_(pdu);
+}
+
+void VirtualController::SendState()
+{
+    std::vector<uint8_t> payload;
+    AppendArray(payload, config_.address);
+    payload.push_back(static_cast<uint8_t>((pageScan_ ? STATE_PAGE_SCAN : 0) |
+                                           (inquiryScan_ ? STATE_INQUIRY_SCAN : 0) |
+                                           (advertising_ ? STATE_ADVERTISING : 0)));
+    std::string name = localName_.substr(0, NAME_SIZE);
+    payload.push_back(static_cast<uint8_t>(std::min(name.size(), MAX_PARAM_SIZE)));
+    payload.insert(payload.end(), name.begin(), name.end());
+    payload.push_back(static_cast<uint8_t>(advertisingData_.size()));
+    payload.insert(payload.end(), advertisingData_.begin(), advertisingData_.end());
+    SendAir(AIR_STATE, payload);
+}
+
+void VirtualController::OnCommand(const std::vector<uint8_t> &packet, uint64_t grant)
+{
+    if (packet.size() < COMMAND_HEADER_SIZE) {
+        return;
+    }
+    uint16_t opcode = ReadUint16(packet.data());
+    // Commands are processed in order, so the credit must be judged by what the host had seen when it sent.
+    if (grant > lastGrant_) {
+        lastGrant_ = grant;
+        commandsSinceGrant_ = 0;
+    }
+    commandsSinceGrant_++;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.commands++;
+        if (commandsSinceGrant_ > config_.numHciCommandPackets) {
+            stats_.commandFlowViolations++;
+        }
+    }
+
+    // Parameters are zero padded, so that handlers read fixed offsets of short commands safely.
+    std::array<uint8_t, MAX_PARAM_SIZE> param {};
+    size_t length = std::min<size_t>(packet[COMMAND_HEADER_SIZE - 1], packet.size() - COMMAND_HEADER_SIZE);
+    std::copy(packet.begin() + COMMAND_HEADER_SIZE, packet.begin() + COMMAND_HEADER_SIZE + length, param.begin());
+
+    uint8_t ogf = static_cast<uint8_t>(opcode >> 10);
+    if (ogf == OGF_LINK_CONTROL || ogf == OGF_LINK_POLICY) {
+        if (OnLinkControlCommand(opcode, param.data(), length)) {
+            return;
+        }
+    } else if (ogf == OGF_LE) {
+        if (OnLeCommand(opcode, param.data(), length)) {
+            return;
+        }
+    }
+    OnLocalCommand(opcode, param.data(), length);
+}
+
+bool VirtualController::RejectShortCommand(uint16_t opcode, size_t length)
+{
+    for (auto &spec : COMMAND_PARAM_SPECS) {
+        if (spec.opcode != opcode) {
+            continue;
+        }
+        if (length >= spec.length) {
+            return false;
+        }
+        if (spec.complete) {
+            SendCommandComplete(opcode, {HCI_INVALID_HCI_COMMAND_PARAMETERS});
+        } else {
+            SendCommandStatus(opcode, HCI_INVALID_HCI_COMMAND_PARAMETERS);
+        }
+        return true;
+    }
+    return false;
+}
+
+bool VirtualController::OnLinkControlCommand(uint16_t opcode, const uint8_t *param, size_t length)
+{
+    if (RejectShortCommand(opcode, length)) {
+        return true;
+    }
+    auto now = std::chrono::steady_clock::now();
+    bool le = false;
+    Connection *connection = FindConnection(ReadUint16(param) & HANDLE_MASK, le);
+    switch (opcode) {
+        case HCI_INQUIRY: {
+            SendCommandStatus(opcode, HCI_SUCCESS);
+            uint64_t generation = ++inquiryGeneration_;
+            PostAt(now + INQUIRY_RESPONSE_DELAY, [this, generation]() {
+                if (generation != inquiryGeneration_ || !peer_.known || !peer_.inquiryScan) {
+                    return;
+                }
+                std::vector<uint8_t> result = {1};
+                AppendAddress(result, peer_.address);
+                result.insert(result.end(), {0x01, 0x00, 0x00});
+                AppendArray(result, CLASS_OF_DEVICE);
+                AppendUint16(result, 0);
+                SendEvent(HCI_INQUIRY_RESULT_EVENT, result);
+            });
+            PostAt(now + INQUIRY_LENGTH_UNIT * param[3], [this, generation]() {
+                if (generation == inquiryGeneration_) {
+                    inquiryGeneration_++;
+                    SendEvent(HCI_INQUIRY_COMPLETE_EVENT, {HCI_SUCCESS});
+                }
+            });
+            return true;
+        }
+        case HCI_INQUIRY_CANCEL:
+            inquiryGeneration_++;
+            SendCommandComplete(opcode, {HCI_SUCCESS});
+            return true;
+        case HCI_CREATE_CONNECTION: {
+            if (brEdr_.state != DISCONNECTED) {
+                SendCommandStatus(opcode, HCI_ACL_CONNECTION_ALREADY_EXISTS);
+                return true;
+            }
+            SendCommandStatus(opcode, HCI_SUCCESS);
+            brEdr_.state = PAGING;
+            brEdr_.address = ReadAddress(param);
+            if (peer_.known && peer_.address == brEdr_.address) {
+                SendAir(AIR_PAGE, {});
+            } else {
+                uint32_t epoch = brEdr_.epoch;
+                PostAt(now + PAGE_TIMEOUT, [this, epoch]() {
+                    if (brEdr_.epoch == epoch && brEdr_.state == PAGING) {
+                        Disconnected(false, HCI_PAGE_TIMEOUT);
+                    }
+                });
+            }
+            return true;
+        }
+        case HCI_CREATE_CONNECTION_CANCEL: {
+            std::vector<uint8_t> result = {HCI_SUCCESS};
+            AppendAddress(result, ReadAddress(param));
+            if (brEdr_.state != PAGING || brEdr_.address != ReadAddress(param)) {
+                result[0] = HCI_UNKNOWN_CONNECTION_IDENTIFIER;
+                SendCommandComplete(opcode, result);
+                return true;
+            }
+            SendCommandComplete(opcode, result);
+            SendAir(AIR_PAGE_CANCEL, {});
+            Disconnected(false, HCI_UNKNOWN_CONNECTION_IDENTIFIER);
+            return true;
+        }
+        case HCI_ACCEPT_CONNECTION_REQUEST:
+            if (brEdr_.state != INCOMING) {
+                SendCommandStatus(opcode, HCI_UNKNOWN_CONNECTION_IDENTIFIER);
+                return true;
+            }
+            SendCommandStatus(opcode, HCI_SUCCESS);
+            SendAir(AIR_PAGE_ACCEPT, {});
+            ConnectionComplete(false, HCI_SUCCESS, ROLE_SLAVE);
+            return true;
+        case HCI_REJECT_CONNECTION_REQUEST:
+            if (brEdr_.state != INCOMING) {
+                SendCommandStatus(opcode, HCI_UNKNOWN_CONNECTION_IDENTIFIER);
+                return true;
+            }
+            SendCommandStatus(opcode, HCI_SUCCESS);
+            SendAir(AIR_PAGE_REJECT, {param[ADDRESS_SIZE]});
+            Disconnected(false, param[ADDRESS_SIZE]);
+            return true;
+        case HCI_REMOTE_NAME_REQUEST: {
+            SendCommandStatus(opcode, HCI_SUCCESS);
+            auto address = ReadAddress(param);
+            PostAt(now + REMOTE_NAME_DELAY, [this, address]() {
+                bool found = peer_.known && peer_.address == address;
+                std::vector<uint8_t> result = {found ? HCI_SUCCESS : HCI_PAGE_TIMEOUT};
+                AppendAddress(result, address);
+                AppendName(result, found ? peer_.name : std::string());
+                SendEvent(HCI_REMOTE_NAME_REQUEST_COMPLETE_EVENT, result);
+            });
+            return true;
+        }
+        default:
+            break;
+    }
+
+    // The remaining link commands act on an existing connection.
+    switch (opcode) {
+        case HCI_DISCONNECT:
+        case HCI_AUTHENTICATION_REQUESTED:
+        case HCI_SET_CONNECTION_ENCRYPTION:
+        case HCI_READ_REMOTE_SUPPORTED_FEATURES:
+        case HCI_READ_REMOTE_EXTENDED_FEATURES:
+        case HCI_READ_REMOTE_VERSION_INFORMATION:
+        case HCI_READ_CLOCK_OFFSET:
+        case HCI_SNIFF_MODE:
+        case HCI_EXIT_SNIFF_MODE:
+            break;
+        default:
+            return false;
+    }
+    if (connection == nullptr || (le && opcode != HCI_DISCONNECT && opcode != HCI_READ_REMOTE_VERSION_INFORMATION)) {
+        SendCommandStatus(opcode, HCI_UNKNOWN_CONNECTION_IDENTIFIER);
+        return true;
+    }
+    SendCommandStatus(opcode, HCI_SUCCESS);
+    std::vector<uint8_t> result = {HCI_SUCCESS};
+    AppendUint16(result, connection->handle);
+    switch (opcode) {
+        case HCI_DISCONNECT:
+            SendAir(AIR_DISCONNECT, {static_cast<uint8_t>(le), param[2]});
+            Disconnected(le, HCI_LOCAL_HOST_TERMINATED);
+            break;
+        case HCI_AUTHENTICATION_REQUESTED:
+            // Links between virtual controllers are always authenticated, no link key exchange is simulated.
+            SendEvent(HCI_AUTHENTICATION_COMPLETE_EVENT, result);
+            break;
+        case HCI_SET_CONNECTION_ENCRYPTION:
+            SendAir(AIR_ENCRYPT, {param[2]});
+            if (param[2] != 0) {
+                EncryptionChange(false, HCI_SUCCESS);
+            } else {
+                connection->encrypted = false;
+                result.push_back(0);
+                SendEvent(HCI_ENCRYPTION_CHANGE_EVENT, result);
+            }
+            break;
+        case HCI_READ_REMOTE_SUPPORTED_FEATURES:
+            AppendArray(result, LMP_FEATURES);
+            SendEvent(HCI_READ_REMOTE_SUPPORTED_FEATURES_COMPLETE_EVENT, result);
+            break;
+        case HCI_READ_REMOTE_EXTENDED_FEATURES:
+            result.insert(result.end(), {param[2], 1});
+            AppendArray(result, param[2] == 0 ? LMP_FEATURES : LMP_HOST_FEATURES);
+            SendEvent(HCI_READ_REMOTE_EXTENDED_FEATURES_COMPLETE_EVENT, result);
+            break;
+        case HCI_READ_REMOTE_VERSION_INFORMATION:
+            result.push_back(HCI_VERSION_5_0);
+            AppendUint16(result, MANUFACTURER_UNKNOWN);
+            AppendUint16(result, 0);
+            SendEvent(HCI_READ_REMOTE_VERSION_INFORMATION_COMPLETE_EVENT, result);
+            break;
+        case HCI_READ_CLOCK_OFFSET:
+            AppendUint16(result, 0);
+            SendEvent(HCI_READ_CLOCK_OFFSET_COMPLETE_EVENT, result);
+            break;
+        case HCI_SNIFF_MODE:
+            result.push_back(MODE_SNIFF);
+            AppendUint16(result, ReadUint16(param + 2));
+            SendEvent(HCI_MODE_CHANGE_EVENT, result);
+            break;
+        default:
+            result.push_back(MODE_ACTIVE);
+            AppendUint16(result, 0);
+            SendEvent(HCI_MODE_CHANGE_EVENT, result);
+            break;
+    }
+    return true;
+}
+
+bool VirtualController::OnLeCommand(uint16_t opcode, const uint8_t *param, size_t length)
+{
+    if (RejectShortCommand(opcode, length)) {
+        return true;
+    }
+    bool le = false;
+    Connection *connection = FindConnection(ReadUint16(param) & HANDLE_MASK, le);
+    if (!le) {
+        connection = nullptr;
+    }
+    switch (opcode) {
+        case HCI_LE_SET_ADVERTISING_DATA:
+            advertisingData_.assign(param + 1, param + 1 + std::min<size_t>(param[0], MAX_ADVERTISING_DATA_SIZE));
+            SendCommandComplete(opcode, {HCI_SUCCESS});
+            SendState();
+            return true;
+        case HCI_LE_SET_ADVERTISING_ENABLE:
+            advertising_ = param[0] != 0;
+            SendCommandComplete(opcode, {HCI_SUCCESS});
+            SendState();
+            return true;
+        case HCI_LE_SET_SCAN_ENABLE:
+            SendCommandComplete(opcode, {HCI_SUCCESS});
+            if (param[0] != 0 && !scanning_) {
+                scanning_ = true;
+                if (config_.advertisingReportsPerSecond != 0) {
+                    scanStart_ = std::chrono::steady_clock::now();
+                    AdvertisingTick(++scanGeneration_, scanStart_);
+                }
+            } else if (param[0] == 0) {
+                scanning_ = false;
+                scanGeneration_++;
+            }
+            return true;
+        case HCI_LE_CREATE_CONNECTION:
+            if (le_.state != DISCONNECTED || leConnectPending_) {
+                SendCommandStatus(opcode, HCI_COMMAND_DISALLOWED);
+                return true;
+            }
+            SendCommandStatus(opcode, HCI_SUCCESS);
+            leConnectPending_ = true;
+            leConnectAnyPeer_ = param[4] == LE_FILTER_WHITE_LIST;
+            leConnectAddress_ = ReadAddress(param + 6);
+            TryLeConnect();
+            return true;
+        case HCI_LE_CREATE_CONNECTION_CANCEL:
+            if (!leConnectPending_) {
+                SendCommandComplete(opcode, {HCI_COMMAND_DISALLOWED});
+                return true;
+            }
+            SendCommandComplete(opcode, {HCI_SUCCESS});
+            leConnectPending_ = false;
+            le_.state = PAGING;
+            le_.address = leConnectAddress_;
+            Disconnected(true, HCI_UNKNOWN_CONNECTION_IDENTIFIER);
+            return true;
+        case HCI_LE_ENCRYPT: {
+            std::array<uint8_t, KEY_SIZE> key;
+            std::array<uint8_t, KEY_SIZE> plaintext;
+            std::reverse_copy(param, param + KEY_SIZE, key.begin());
+            std::reverse_copy(param + KEY_SIZE, param + KEY_SIZE * 2, plaintext.begin());
+            auto encrypted = Aes128Encrypt(key, plaintext);
+            std::vector<uint8_t> result = {HCI_SUCCESS};
+            result.insert(result.end(), encrypted.rbegin(), encrypted.rend());
+            SendCommandComplete(opcode, result);
+            return true;
+        }
+        case HCI_LE_RAND: {
+            static thread_local std::mt19937_64 generator {std::random_device()()};
+            std::vector<uint8_t> result = {HCI_SUCCESS};
+            for (size_t i = 0; i < RAND_SIZE; i++) {
+                result.push_back(static_cast<uint8_t>(generator()));
+            }
+            SendCommandComplete(opcode, result);
+            return true;
+        }
+        case HCI_LE_READ_LOCAL_P256_PUBLIC_KEY: {
+            SendCommandStatus(opcode, HCI_SUCCESS);
+            std::vector<uint8_t> result = {HCI_SUCCESS};
+            AppendArray(result, PublicKeyFromAddress(config_.address));
+            SendLeEvent(HCI_LE_READ_LOCAL_P256_PUBLIC_KEY_COMPLETE_EVENT, result);
+            return true;
+        }
+        case HCI_LE_GENERATE_DHKEY: {
+            SendCommandStatus(opcode, HCI_SUCCESS);
+            auto local = PublicKeyFromAddress(config_.address);
+            std::vector<uint8_t> result = {HCI_SUCCESS};
+            for (size_t i = 0; i < DHKEY_SIZE; i++) {
+                result.push_back(local[i] ^ local[i + DHKEY_SIZE] ^ param[i] ^ param[i + DHKEY_SIZE]);
+            }
+            SendLeEvent(HCI_LE_GENERATE_DHKEY_COMPLETE_EVENT, result);
+            return true;
+        }
+        default:
+            break;
+    }
+
+    // The remaining LE commands act on an existing LE connection.
+    std::vector<uint8_t> result = {HCI_SUCCESS};
+    AppendUint16(result, le_.handle);
+    switch (opcode) {
+        case HCI_LE_CONNECTION_UPDATE: {
+            if (connection == nullptr) {
+                SendCommandStatus(opcode, HCI_UNKNOWN_CONNECTION_IDENTIFIER);
+                return true;
+            }
+            SendCommandStatus(opcode, HCI_SUCCESS);
+            // Interval max, latency and supervision timeout.
+            std::vector<uint8_t> update(param + 4, param + 10);
+            SendAir(AIR_LE_CONNECTION_UPDATE, update);
+            result.insert(result.end(), update.begin(), update.end());
+            SendLeEvent(HCI_LE_CONNECTION_UPDATE_COMPLETE_EVENT, result);
+            return true;
+        }
+        case HCI_LE_READ_REMOTE_FEATURES:
+            if (connection == nullptr) {
+                SendCommandStatus(opcode, HCI_UNKNOWN_CONNECTION_IDENTIFIER);
+                return true;
+            }
+            SendCommandStatus(opcode, HCI_SUCCESS);
+            AppendArray(result, LE_FEATURES);
+            SendLeEvent(HCI_LE_READ_REMOTE_FEATURES_COMPLETE_EVENT, result);
+            return true;
+        case HCI_LE_START_ENCRYPTION:
+            if (connection == nullptr || connection->encryptionPending) {
+                SendCommandStatus(opcode,
+                    connection == nullptr ? HCI_UNKNOWN_CONNECTION_IDENTIFIER : HCI_COMMAND_DISALLOWED);
+                return true;
+            }
+            SendCommandStatus(opcode, HCI_SUCCESS);
+            connection->encryptionPending = true;
+            std::copy(param + 2 + RAND_SIZE + EDIV_SIZE, param + 2 + RAND_SIZE + EDIV_SIZE + KEY_SIZE,
+                connection->ltk.begin());
+            SendAir(AIR_LE_ENC_REQUEST, std::vector<uint8_t>(param + 2, param + 2 + RAND_SIZE + EDIV_SIZE));
+            return true;
+        case HCI_LE_LONG_TERM_KEY_REQUEST_REPLY:
+        case HCI_LE_LONG_TERM_KEY_REQUEST_NEGATIVE_REPLY: {
+            if (connection == nullptr) {
+                result[0] = HCI_UNKNOWN_CONNECTION_IDENTIFIER;
+                SendCommandComplete(opcode, result);
+                return true;
+            }
+            SendCommandComplete(opcode, result);
+            bool replied = opcode == HCI_LE_LONG_TERM_KEY_REQUEST_REPLY;
+            std::vector<uint8_t> reply = {static_cast<uint8_t>(replied)};
+            reply.insert(reply.end(), param + 2, param + 2 + KEY_SIZE);
+            SendAir(AIR_LE_ENC_RESULT, reply);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void VirtualController::OnLocalCommand(uint16_t opcode, const uint8_t *param, size_t length)
+{
+    std::vector<uint8_t> result = {HCI_SUCCESS};
+    switch (opcode) {
+        case HCI_RESET:
+            ResetState();
+            break;
+        case HCI_WRITE_LOCAL_NAME:
+            localName_.assign(reinterpret_cast<const char *>(param), strnlen(reinterpret_cast<const char *>(param),
+                std::min(length, NAME_SIZE)));
+            SendState();
+            break;
+        case HCI_READ_LOCAL_NAME:
+            AppendName(result, localName_);
+            break;
+        case HCI_WRITE_SCAN_ENABLE:
+            inquiryScan_ = (param[0] & SCAN_ENABLE_INQUIRY) != 0;
+            pageScan_ = (param[0] & SCAN_ENABLE_PAGE) != 0;
+            SendState();
+            break;
+        case HCI_READ_LOCAL_VERSION_INFORMATION:
+            result.push_back(HCI_VERSION_5_0);
+            AppendUint16(result, 0);
+            result.push_back(HCI_VERSION_5_0);
+            AppendUint16(result, MANUFACTURER_UNKNOWN);
+            AppendUint16(result, 0);
+            break;
+        case HCI_READ_LOCAL_SUPPORTED_COMMANDS:
+            result.insert(result.end(), SUPPORTED_COMMANDS_SIZE, 0xFF);
+            break;
+        case HCI_READ_LOCAL_SUPPORTED_FEATURES:
+            AppendArray(result, LMP_FEATURES);
+            break;
+        case HCI_READ_LOCAL_EXTENDED_FEATURES:
+            result.insert(result.end(), {param[0], 1});
+            AppendArray(result, param[0] == 0 ? LMP_FEATURES : LMP_HOST_FEATURES);
+            break;
+        case HCI_READ_BUFFER_SIZE:
+            AppendUint16(result, config_.aclDataPacketLength);
+            result.push_back(0);
+            AppendUint16(result, config_.totalNumAclDataPackets);
+            AppendUint16(result, 0);
+            break;
+        case HCI_READ_BD_ADDR:
+            AppendAddress(result, config_.address);
+            break;
+        case HCI_LE_READ_BUFFER_SIZE:
+            AppendUint16(result, config_.leAclDataPacketLength);
+            result.push_back(config_.totalNumLeAclDataPackets);
+            break;
+        case HCI_LE_READ_LOCAL_SUPPORTED_FEATURES:
+            AppendArray(result, LE_FEATURES);
+            break;
+        case HCI_LE_READ_ADVERTISING_CHANNEL_TX_POWER:
+            result.push_back(ADVERTISING_TX_POWER);
+            break;
+        case HCI_LE_READ_WHITE_LIST_SIZE:
+            result.push_back(WHITE_LIST_SIZE);
+            break;
+        case HCI_LE_READ_SUPPORTED_STATES:
+            result.insert(result.end(), FEATURES_SIZE, 0xFF);
+            break;
+        case HCI_LE_READ_SUGGESTED_DEFAULT_DATA_LENGTH:
+            AppendUint16(result, LE_DEFAULT_DATA_OCTETS);
+            AppendUint16(result, LE_DEFAULT_DATA_TIME);
+            break;
+        case HCI_LE_READ_RESOLVING_LIST_SIZE:
+            result.push_back(RESOLVING_LIST_SIZE);
+            break;
+        case HCI_LE_READ_MAXIMUM_DATA_LENGTH:
+            AppendUint16(result, LE_MAX_DATA_OCTETS);
+            AppendUint16(result, LE_MAX_DATA_TIME);
+            AppendUint16(result, LE_MAX_DATA_OCTETS);
+            AppendUint16(result, LE_MAX_DATA_TIME);
+            break;
+        default:
+            if ((opcode >> 10) == OGF_LINK_CONTROL) {
+                // Would otherwise leave the host waiting for an event that never comes.
+                SendCommandStatus(opcode, HCI_UNKNOWN_HCI_COMMAND);
+                return;
+            }
+            // Settings are accepted as is. Commands that return a handle take it as first parameter; echo it.
+            result.insert(result.end(), param, param + 2);
+            break;
+    }
+    SendCommandComplete(opcode, result);
+}
+
+void VirtualController::OnAclFromHost(const std::vector<uint8_t> &packet)
+{
+    if (packet.size() < ACL_HEADER_SIZE) {
+        return;
+    }
+    uint16_t handleAndFlags = ReadUint16(packet.data());
+    uint8_t flags = static_cast<uint8_t>(handleAndFlags >> HANDLE_FLAGS_SHIFT);
+    size_t length = std::min<size_t>(ReadUint16(packet.data() + 2), packet.size() - ACL_HEADER_SIZE);
+    bool le = false;
+    Connection *connection = FindConnection(handleAndFlags & HANDLE_MASK, le);
+    if (connection == nullptr) {
+        return;
+    }
+    int &credits = Credits(le);
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.aclPacketsSent++;
+        stats_.aclBytesSent += length;
+        if (credits <= 0) {
+            stats_.aclCreditViolations++;
+        }
+    }
+    credits--;
+    connection->inFlight++;
+
+    // The buffer is released once the packet went over the air, which takes its size over the link rate.
+    auto now = std::chrono::steady_clock::now();
+    uint32_t kbps = le ? config_.leAirKbps : config_.brEdrAirKbps;
+    auto start = std::max(now, connection->airBusyUntil);
+    uint64_t airTimeUs = (kbps == 0) ? 0 : (length * BITS_PER_BYTE * MICROSECONDS_PER_SECOND) / (kbps * BITS_PER_KBIT);
+    connection->airBusyUntil = start + std::chrono::microseconds(airTimeUs);
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.aclAirTimeUs += airTimeUs;
+    }
+
+    std::vector<uint8_t> payload = {static_cast<uint8_t>(le), flags};
+    payload.insert(payload.end(), packet.begin() + ACL_HEADER_SIZE, packet.begin() + ACL_HEADER_SIZE + length);
+    uint32_t epoch = connection->epoch;
+    PostAt(connection->airBusyUntil, [this, le, epoch, payload]() {
+        Connection &current = le ? le_ : brEdr_;
+        if (current.epoch != epoch || current.state != CONNECTED) {
+            return;
+        }
+        SendAir(AIR_ACL, payload);
+        current.inFlight--;
+        CompletePacket(current.handle);
+    });
+}
+
+void VirtualController::CompletePacket(uint16_t handle)
+{
+    completedPackets_[handle]++;
+    if (completedFlushPending_) {
+        return;
+    }
+    completedFlushPending_ = true;
+    if (config_.completedPacketsIntervalUs == 0) {
+        // Packets completed by the same tick still share one event.
+        Post([this]() { FlushCompletedPackets(); });
+    } else {
+        PostAt(std::chrono::steady_clock::now() + std::chrono::microseconds(config_.completedPacketsIntervalUs),
+            [this]() { FlushCompletedPackets(); });
+    }
+}
+
+void VirtualController::FlushCompletedPackets()
+{
+    completedFlushPending_ = false;
+    if (completedPackets_.empty()) {
+        return;
+    }
+    std::vector<uint8_t> param = {static_cast<uint8_t>(completedPackets_.size())};
+    for (const auto &[handle, count] : completedPackets_) {
+        AppendUint16(param, handle);
+        AppendUint16(param, count);
+        // Credits return when the host is told, so a host sending on a stale count is caught.
+        Credits(handle == le_.handle) += count;
+    }
+    completedPackets_.clear();
+    SendEvent(HCI_NUMBER_OF_COMPLETED_PACKETS_EVENT, param);
+}
+
+void VirtualController::ConnectionComplete(bool le, uint8_t status, uint8_t role)
+{
+    Connection &connection = le ? le_ : brEdr_;
+    std::vector<uint8_t> param = {status};
+    AppendUint16(param, connection.handle);
+    if (le) {
+        param.insert(param.end(), {role, ADDRESS_TYPE_PUBLIC});
+        AppendAddress(param, connection.address);
+        AppendUint16(param, LE_CONNECTION_INTERVAL);
+        AppendUint16(param, 0);
+        AppendUint16(param, LE_SUPERVISION_TIMEOUT);
+        param.push_back(0);
+    } else {
+        AppendAddress(param, connection.address);
+        param.insert(param.end(), {LINK_TYPE_ACL, 0});
+    }
+    if (status == HCI_SUCCESS) {
+        connection.state = CONNECTED;
+        connection.airBusyUntil = std::chrono::steady_clock::now();
+    } else {
+        uint32_t epoch = connection.epoch + 1;
+        uint16_t handle = connection.handle;
+        connection = Connection();
+        connection.epoch = epoch;
+        connection.handle = handle;
+    }
+    if (le) {
+        SendLeEvent(HCI_LE_CONNECTION_COMPLETE_EVENT, param);
+    } else {
+        SendEvent(HCI_CONNECTION_COMPLETE_EVENT, param);
+    }
+}
+
+void VirtualController::Disconnected(bool le, uint8_t reason)
+{
+    Connection &connection = le ? le_ : brEdr_;
+    if (connection.state == DISCONNECTED) {
+        return;
+    }
+    if (connection.state != CONNECTED) {
+        ConnectionComplete(le, reason, ROLE_MASTER);
+        return;
+    }
+
+    // The host drops its packets of this handle, so they no longer hold controller buffers.
+    int &credits = Credits(le);
+    credits += connection.inFlight;
+    auto completed = completedPackets_.find(connection.handle);
+    if (completed != completedPackets_.end()) {
+        credits += completed->second;
+        completedPackets_.erase(completed);
+    }
+    uint16_t handle = connection.handle;
+    uint32_t epoch = connection.epoch + 1;
+    connection = Connection();
+    connection.epoch = epoch;
+    connection.handle = handle;
+
+    std::vector<uint8_t> param = {HCI_SUCCESS};
+    AppendUint16(param, handle);
+    param.push_back(reason);
+    SendEvent(HCI_DISCONNECTION_COMPLETE_EVENT, param);
+}
+
+void VirtualController::EncryptionChange(bool le, uint8_t status)
+{
+    Connection &connection = le ? le_ : brEdr_;
+    if (connection.state != CONNECTED) {
+        return;
+    }
+    std::vector<uint8_t> param = {status};
+    AppendUint16(param, connection.handle);
+    if (status == HCI_SUCCESS && connection.encrypted) {
+        SendEvent(HCI_ENCRYPTION_KEY_REFRESH_COMPLETE_EVENT, param);
+        return;
+    }
+    connection.encrypted = connection.encrypted || status == HCI_SUCCESS;
+    param.push_back(static_cast<uint8_t>(connection.encrypted));
+    SendEvent(HCI_ENCRYPTION_CHANGE_EVENT, param);
+}
+
+void VirtualController::TryLeConnect()
+{
+    if (!leConnectPending_ || !peer_.known || !peer_.advertising) {
+        return;
+    }
+    if (!leConnectAnyPeer_ && peer_.address != leConnectAddress_) {
+        return;
+    }
+    leConnectPending_ = false;
+    le_.state = PAGING;
+    le_.address = peer_.address;
+    SendAir(AIR_LE_CONNECT, {});
+}
+
+void VirtualController::AdvertisingTick(uint64_t generation, std::chrono::steady_clock::time_point when)
+{
+    if (generation != scanGeneration_ || !scanning_) {
+        return;
+    }
+    SendAdvertisingReport(
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(when - scanStart_).count()));
+    // Next report is due one period after the previous one was, so the rate does not drift with latency.
+    auto next = when + std::chrono::microseconds(MICROSECONDS_PER_SECOND / config_.advertisingReportsPerSecond);
+    PostAt(next, [this, generation, next]() { AdvertisingTick(generation, next); });
+}
+
+void VirtualController::SendAdvertisingReport(uint64_t dueUs)
+{
+    size_t advertisers = config_.syntheticAdvertisers + ((peer_.known && peer_.advertising) ? 1 : 0);
+    if (advertisers == 0) {
+        return;
+    }
+    uint8_t index = static_cast<uint8_t>(syntheticIndex_++ % advertisers);
+    std::vector<uint8_t> report = {1, ADV_IND};
+    std::vector<uint8_t> data;
+    int8_t rssi = SYNTHETIC_RSSI;
+    if (index == config_.syntheticAdvertisers) {
+        report.push_back(ADDRESS_TYPE_PUBLIC);
+        AppendAddress(report, peer_.address);
+        data = peer_.advertisingData;
+    } else {
+        // Static random address: two most significant bits set.
+        report.push_back(ADDRESS_TYPE_RANDOM);
+        AppendAddress(report, {0xC0, 0x00, 0x00, 0x00, 0x00, index});
+        std::string name = "vdev-" + std::to_string(index);
+        data = {0x02, 0x01, 0x06, static_cast<uint8_t>(name.size() + 1), 0x09};
+        data.insert(data.end(), name.begin(), name.end());
+        rssi = static_cast<int8_t>(SYNTHETIC_RSSI - index);
+    }
+    report.push_back(static_cast<uint8_t>(data.size()));
+    report.insert(report.end(), data.begin(), data.end());
+    report.push_back(static_cast<uint8_t>(rssi));
+    SendLeEvent(HCI_LE_ADVERTISING_REPORT_EVENT, report);
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    stats_.advertisingReports++;
+    stats_.lastAdvertisingReportUs = dueUs;
+}
+
+void VirtualController::OnLinkLost()
+{
+    peer_ = PeerState();
+    Disconnected(false, HCI_CONNECTION_TIMEOUT);
+    Disconnected(true, HCI_CONNECTION_TIMEOUT);
+}
+
+void VirtualController::OnAir(const std::vector<uint8_t> &pdu)
+{
+    if (pdu.empty()) {
+        return;
+    }
+    const uint8_t *payload = pdu.data() + 1;
+    size_t length = pdu.size() - 1;
+    switch (pdu[0]) {
+        case AIR_STATE: {
+            if (length < ADDRESS_SIZE + 2) {
+                return;
+            }
+            peer_.known = true;
+            std::copy(payload, payload + ADDRESS_SIZE, peer_.address.begin());
+            uint8_t state = payload[ADDRESS_SIZE];
+            peer_.pageScan = (state & STATE_PAGE_SCAN) != 0;
+            peer_.inquiryScan = (state & STATE_INQUIRY_SCAN) != 0;
+            peer_.advertising = (state & STATE_ADVERTISING) != 0;
+            size_t offset = ADDRESS_SIZE + 1;
+            size_t nameLength = std::min<size_t>(payload[offset], length - offset - 1);
+            peer_.name.assign(reinterpret_cast<const char *>(payload + offset + 1), nameLength);
+            offset += 1 + nameLength;
+            if (offset < length) {
+                size_t dataLength = std::min<size_t>(payload[offset], length - offset - 1);
+                peer_.advertisingData.assign(payload + offset + 1, payload + offset + 1 + dataLength);
+            }
+            TryLeConnect();
+            break;
+        }
+        case AIR_PAGE:
+            if (brEdr_.state != DISCONNECTED || !pageScan_) {
+                SendAir(AIR_PAGE_REJECT,
+                    {brEdr_.state != DISCONNECTED ? HCI_REJECTED_LIMITED_RESOURCES : HCI_PAGE_TIMEOUT});
+                return;
+            }
+            brEdr_.state = INCOMING;
+            brEdr_.address = peer_.address;
+            {
+                std::vector<uint8_t> param;
+                AppendAddress(param, peer_.address);
+                AppendArray(param, CLASS_OF_DEVICE);
+                param.push_back(LINK_TYPE_ACL);
+                SendEvent(HCI_CONNECTION_REQUEST_EVENT, param);
+            }
+            break;
+        case AIR_PAGE_ACCEPT:
+            if (brEdr_.state == PAGING) {
+                ConnectionComplete(false, HCI_SUCCESS, ROLE_MASTER);
+            }
+            break;
+        case AIR_PAGE_REJECT:
+            if (brEdr_.state == PAGING && length > 0) {
+                Disconnected(false, payload[0]);
+            }
+            break;
+        case AIR_PAGE_CANCEL:
+            if (brEdr_.state == INCOMING) {
+                Disconnected(false, HCI_UNKNOWN_CONNECTION_IDENTIFIER);
+            }
+            break;
+        case AIR_LE_CONNECT:
+            if (!advertising_ || le_.state != DISCONNECTED) {
+                SendAir(AIR_LE_REJECT, {});
+                return;
+            }
+            // Connectable advertising ends with the connection.
+            advertising_ = false;
+            le_.address = peer_.address;
+            SendAir(AIR_LE_ACCEPT, {});
+            ConnectionComplete(true, HCI_SUCCESS, ROLE_SLAVE);
+            SendState();
+            break;
+        case AIR_LE_ACCEPT:
+            if (le_.state == PAGING) {
+                ConnectionComplete(true, HCI_SUCCESS, ROLE_MASTER);
+            }
+            break;
+        case AIR_LE_REJECT:
+            if (le_.state == PAGING) {
+                le_.state = DISCONNECTED;
+                leConnectPending_ = true;
+            }
+            break;
+        case AIR_ACL: {
+            if (length < 2) {
+                return;
+            }
+            Connection &connection = payload[0] ? le_ : brEdr_;
+            if (connection.state != CONNECTED) {
+                return;
+            }
+            uint8_t flags = payload[1];
+            if ((flags & PB_FLAG_MASK) == PB_FIRST_NON_FLUSHABLE) {
+                flags |= PB_FIRST_FLUSHABLE;
+            }
+            size_t dataLength = length - 2;
+            std::vector<uint8_t> packet;
+            packet.reserve(ACL_HEADER_SIZE + dataLength);
+            AppendUint16(packet, static_cast<uint16_t>(connection.handle | (flags << HANDLE_FLAGS_SHIFT)));
+            AppendUint16(packet, static_cast<uint16_t>(dataLength));
+            packet.insert(packet.end(), payload + 2, payload + length);
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                stats_.aclPacketsReceived++;
+                stats_.aclBytesReceived += dataLength;
+            }
+            receiver_(PACKET_TYPE_ACL, packet.data(), packet.size());
+            break;
+        }
+        case AIR_DISCONNECT:
+            if (length >= 2) {
+                Disconnected(payload[0] != 0, payload[1]);
+            }
+            break;
+        case AIR_ENCRYPT:
+            if (length >= 1 && brEdr_.state == CONNECTED) {
+                if (payload[0] != 0) {
+                    EncryptionChange(false, HCI_SUCCESS);
+                } else {
+                    brEdr_.encrypted = false;
+                    std::vector<uint8_t> param = {HCI_SUCCESS};
+                    AppendUint16(param, brEdr_.handle);
+                    param.push_back(0);
+                    SendEvent(HCI_ENCRYPTION_CHANGE_EVENT, param);
+                }
+            }
+            break;
+        case AIR_LE_ENC_REQUEST:
+            if (length >= RAND_SIZE + EDIV_SIZE && le_.state == CONNECTED) {
+                std::vector<uint8_t> param;
+                AppendUint16(param, le_.handle);
+                param.insert(param.end(), payload, payload + RAND_SIZE + EDIV_SIZE);
+                SendLeEvent(HCI_LE_LONG_TERM_KEY_REQUEST_EVENT, param);
+            }
+            break;
+        case AIR_LE_ENC_RESULT: {
+            if (length < 1 + KEY_SIZE || !le_.encryptionPending) {
+                return;
+            }
+            le_.encryptionPending = false;
+            bool replied = payload[0] != 0;
+            uint8_t status = HCI_PIN_OR_KEY_MISSING;
+            if (replied) {
+                // Different keys on both sides show up as a MIC failure of the first encrypted PDU.
+                status = std::equal(le_.ltk.begin(), le_.ltk.end(), payload + 1) ? HCI_SUCCESS : HCI_MIC_FAILURE;
+                SendAir(AIR_LE_ENC_DONE, {status});
+            }
+            EncryptionChange(true, status);
+            break;
+        }
+        case AIR_LE_ENC_DONE:
+            if (length >= 1) {
+                EncryptionChange(true, payload[0]);
+            }
+            break;
+        case AIR_LE_CONNECTION_UPDATE:
+            if (length >= 6 && le_.state == CONNECTED) {
+                std::vector<uint8_t> param = {HCI_SUCCESS};
+                AppendUint16(param, le_.handle);
+                param.insert(param.end(), payload, payload + 6);
+                SendLeEvent(HCI_LE_CONNECTION_UPDATE_COMPLETE_EVENT, param);
+            }
+            break;
+        default:
+            break;
+    }
+}
+}  // namespace bluetooth
+}  // namespace OHOS
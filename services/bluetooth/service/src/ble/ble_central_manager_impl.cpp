@@ -21,7 +21,9 @@
 #include "ble_feature.h"
 #include "ble_properties.h"
 #include "ble_utils.h"
+#include "bt_device_key.h"
 #include "common/adapter_manager.h"
+#include "flat_hash_map.h"
 #include "hisysevent.h"
 #include "ble_scan_filter/include/ble_scan_filter_lsf.h"
 #include "securec.h"
@@ -67,7 +69,7 @@ struct BleCentralManagerImpl::impl {
     BleScanParams scanParams_ {};
     /// Report delay timer
     std::unique_ptr<utility::Timer> timer_ = nullptr;
-    std::map<std::string, std::vector<uint8_t>> incompleteData_ {};
+    utility::FlatHashMap<utility::BtDeviceKey, std::vector<uint8_t>> incompleteData_ {};
     BleCentralManagerImpl *bleCentralManagerImpl_ = nullptr;
 
     std::map<uint8_t, BleScanFilterImpl> filters_;
@@ -178,8 +180,6 @@ BleCentralManagerImpl::BleCentralManagerImpl(
 
 #ifdef LSF_ENABLE
     bleScanFilter_ = new BleScanFilterLsf();
-#else
-    LoadBleScanFilterLib();
 #endif
 }
 
@@ -348,28 +348,30 @@ void BleCentralManagerImpl::AdvertisingReportTask(
     HandleGapEvent(BLE_GAP_SCAN_RESULT_EVT, 0);
 }
 
-bool BleCentralManagerImpl::ExtractIncompleteData(uint8_t advType, const std::string &advertisedAddress,
+bool BleCentralManagerImpl::ExtractIncompleteData(uint8_t advType, const BtAddr &advertisedAddress,
     const std::vector<uint8_t> &data, std::vector<uint8_t> &completeData) const
 {
     LOG_DEBUG("[BleCentralManagerImpl] %{public}s", __func__);
 
+    // Keyed by the typed address, a public and a random device with equal bytes reassemble apart.
+    utility::BtDeviceKey key = utility::BtDeviceKey::FromAddress(advertisedAddress.addr, advertisedAddress.type);
     if ((advType & BLE_EX_SCAN_DATE_STATUS_INCOMPLETE_MORE) == BLE_EX_SCAN_DATE_STATUS_INCOMPLETE_MORE) {
-        auto iter = pimpl->incompleteData_.find(advertisedAddress);
+        auto iter = pimpl->incompleteData_.find(key);
         if (iter == pimpl->incompleteData_.end()) {
-            pimpl->incompleteData_.insert(std::make_pair(advertisedAddress, data));
+            pimpl->incompleteData_.insert(std::make_pair(key, data));
         } else {
             iter->second.insert(iter->second.end(), data.begin(), data.end());
         }
         return true;
     } else if ((advType & BLE_EX_SCAN_DATE_STATUS_INCOMPLETE_NO_MORE) == 0 &&
                (advType & BLE_EX_SCAN_DATE_STATUS_INCOMPLETE_MORE) == 0) {
-        auto iter = pimpl->incompleteData_.find(advertisedAddress);
+        auto iter = pimpl->incompleteData_.find(key);
         if (iter != pimpl->incompleteData_.end()) {
             iter->second.insert(iter->second.end(), data.begin(), data.end());
             completeData = iter->second;
         }
     } else if ((advType & BLE_EX_SCAN_DATE_STATUS_INCOMPLETE_NO_MORE) == BLE_EX_SCAN_DATE_STATUS_INCOMPLETE_NO_MORE) {
-        auto iter = pimpl->incompleteData_.find(advertisedAddress);
+        auto iter = pimpl->incompleteData_.find(key);
         if (iter != pimpl->incompleteData_.end()) {
             iter->second.insert(iter->second.end(), data.begin(), data.end());
             completeData = iter->second;
@@ -402,7 +404,7 @@ void BleCentralManagerImpl::ExAdvertisingReportTask(uint8_t advType, const BtAdd
     HILOGI("peerAddr: %{public}s, peerCurrentAddr: %{public}s", GetEncryptAddr(advAddress.GetAddress()).c_str(),
         GetEncryptAddr(advCurrentAddress.GetAddress()).c_str());
     std::vector<uint8_t> incompleteData(data.begin(), data.end());
-    if (ExtractIncompleteData(advType, advCurrentAddress.GetAddress(), data, incompleteData)) {
+    if (ExtractIncompleteData(advType, peerCurrentAddr, data, incompleteData)) {
         return;
     }
 
@@ -1261,6 +1263,13 @@ int BleCentralManagerImpl::ConfigScanFilter(int32_t scannerId, const std::vector
 
 bool BleCentralManagerImpl::CheckScanFilterConfig(const std::vector<BleScanFilterImpl> &filters)
 {
+#ifndef LSF_ENABLE
+    // The vendor filter library is opened on the first filtered scan instead of during adapter start.
+    if ((bleScanFilter_ == nullptr) && !bleScanFilterLoadTried_) {
+        bleScanFilterLoadTried_ = true;
+        LoadBleScanFilterLib();
+    }
+#endif
     if (bleScanFilter_ == nullptr) {
         return false;
     }
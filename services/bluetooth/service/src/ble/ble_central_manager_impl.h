@@ -383,7 +383,7 @@ private:
     static void DirectedAdvertisingReport(uint8_t advType, const BtAddr *addr, GapDirectedAdvReportParam reportParam,
         const BtAddr *currentAddr, void *context);
     static void ScanTimeoutEvent(void *context);
-    bool ExtractIncompleteData(uint8_t advType, const std::string &advertisedAddress, const std::vector<uint8_t> &data,
+    bool ExtractIncompleteData(uint8_t advType, const BtAddr &advertisedAddress, const std::vector<uint8_t> &data,
         std::vector<uint8_t> &completeData) const;
 
     static void AddBleScanFilterResult(uint8_t result, void *context);
@@ -419,9 +419,10 @@ private:
     IAdapterBle *bleAdapter_ = nullptr;
     /// The dispatcher that is used to switch to the thread.
     utility::Dispatcher *dispatcher_ = nullptr;
-    std::map<std::string, std::vector<uint8_t>> incompleteData_{};
     IBleScanFilter* bleScanFilter_ = nullptr;
     void *bleScanFilterLib_ = nullptr;
+    /// A library that failed to load is not retried on every filter request.
+    bool bleScanFilterLoadTried_ = false;
 
     /// filter action
     static const uint8_t FILTER_ACTION_ADD = 0x00;
@@ -250,7 +250,7 @@ void ClassicAdapter::LoadPairedDeviceInfo()
         } else {
             std::shared_ptr<ClassicRemoteDevice> remote = adapterProperties_.GetPairedDevice(addr);
             if (remote != nullptr) {
-                devices_.insert(std::make_pair(addr, remote));
+                devices_.insert(std::make_pair(utility::BtDeviceKey::FromString(addr), remote));
             }
         }
     }
@@ -258,12 +258,29 @@ void ClassicAdapter::LoadPairedDeviceInfo()
 
 void ClassicAdapter::SavePairedDevices() const
 {
+    for (auto &device : GetSortedPairedDevices()) {
+        adapterProperties_.SavePairedDeviceInfo(device);
+    }
+    adapterProperties_.SaveConfigFile();
+}
+
+std::vector<std::shared_ptr<ClassicRemoteDevice>> ClassicAdapter::GetSortedPairedDevices() const
+{
+    std::vector<std::pair<utility::BtDeviceKey, std::shared_ptr<ClassicRemoteDevice>>> paired;
     for (auto &device : devices_) {
-        if (device.second->IsPaired()) {
-            adapterProperties_.SavePairedDeviceInfo(device.second);
+        if ((device.second != nullptr) && device.second->IsPaired()) {
+            paired.push_back(device);
         }
     }
-    adapterProperties_.SaveConfigFile();
+    std::sort(paired.begin(), paired.end(),
+        [](const auto &left, const auto &right) { return left.first < right.first; });
+
+    std::vector<std::shared_ptr<ClassicRemoteDevice>> sorted;
+    sorted.reserve(paired.size());
+    for (auto &device : paired) {
+        sorted.push_back(device.second);
+    }
+    return sorted;
 }
 
 bool ClassicAdapter::RegisterCallback()
@@ -1001,7 +1018,8 @@ void ClassicAdapter::HandleInquiryResult(
     discoveryState_ = DISCOVERYING;
 
     RawAddress device = RawAddress::ConvertToString(addr.addr);
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice =
+        FindRemoteDevice(device, utility::BtDeviceKey::FromAddress(addr.addr));
     int cod = (classOfDevice & CLASS_OF_DEVICE_RANGE);
     if (cod != remoteDevice->GetDeviceClass()) {
         remoteDevice->SetDeviceClass(cod);
@@ -1022,15 +1040,21 @@ void ClassicAdapter::HandleInquiryResult(
 }
 
 std::shared_ptr<ClassicRemoteDevice> ClassicAdapter::FindRemoteDevice(const RawAddress &device)
+{
+    return FindRemoteDevice(device, utility::BtDeviceKey::FromString(device.GetAddress()));
+}
+
+std::shared_ptr<ClassicRemoteDevice> ClassicAdapter::FindRemoteDevice(
+    const RawAddress &device, const utility::BtDeviceKey &key)
 {
     std::shared_ptr<ClassicRemoteDevice> remoteDevice;
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(key);
     if (it != devices_.end()) {
         remoteDevice = it->second;
     } else {
         remoteDevice = std::make_shared<ClassicRemoteDevice>(device.GetAddress());
-        devices_.insert(std::make_pair(device.GetAddress(), remoteDevice));
+        devices_.insert(std::make_pair(key, remoteDevice));
     }
 
     return remoteDevice;
@@ -1106,7 +1130,8 @@ void ClassicAdapter::ReceiveRemoteName(uint8_t status, const BtAddr &addr, const
         std::string deviceName(nameVec.begin(), nameVec.end());
         deviceName = deviceName.c_str();
         RawAddress device = RawAddress::ConvertToString(addr.addr);
-        std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+        std::shared_ptr<ClassicRemoteDevice> remoteDevice =
+            FindRemoteDevice(device, utility::BtDeviceKey::FromAddress(addr.addr));
         if (deviceName != remoteDevice->GetRemoteName()) {
             remoteDevice->SetRemoteName(deviceName);
             SendRemoteNameChanged(device, deviceName);
@@ -1173,14 +1198,15 @@ void ClassicAdapter::SSPConfirmReq(const BtAddr &addr, int reqType, int number,
     HILOGI("reqTyep: %{public}d", reqType);
 
     RawAddress device = RawAddress::ConvertToString(addr.addr);
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+    utility::BtDeviceKey key = utility::BtDeviceKey::FromAddress(addr.addr);
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device, key);
     remoteDevice->SetPairConfirmState(PAIR_CONFIRM_STATE_USER_CONFIRM);
     remoteDevice->SetPairConfirmType(reqType);
     int remoteIo = remoteDevice->GetIoCapability();
     if (remoteDevice->GetPairedStatus() == PAIR_CANCELING) {
-        UserConfirmAutoReply(device, reqType, false);
+        UserConfirmAutoReply(device, key, reqType, false);
     } else if (CheckAutoReply(remoteIo, localMitmRequired, remoteMitmRequired) == true) {
-        UserConfirmAutoReply(device, reqType, true);
+        UserConfirmAutoReply(device, key, reqType, true);
     } else {
         reqType = CheckSspConfirmType(remoteIo, reqType);
         SendPairConfirmed(device, reqType, number);
@@ -1192,7 +1218,8 @@ void ClassicAdapter::PinCodeReq(const BtAddr &addr)
     HILOGI("enter");
 
     RawAddress device = RawAddress::ConvertToString(addr.addr);
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+    utility::BtDeviceKey key = utility::BtDeviceKey::FromAddress(addr.addr);
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device, key);
     remoteDevice->SetPairConfirmState(PAIR_CONFIRM_STATE_USER_CONFIRM);
     remoteDevice->SetPairConfirmType(PAIR_CONFIRM_TYPE_PIN_CODE);
     pinMode_ = true;
@@ -1201,7 +1228,7 @@ void ClassicAdapter::PinCodeReq(const BtAddr &addr)
     }
 
     if (remoteDevice->GetPairedStatus() == PAIR_CANCELING) {
-        UserConfirmAutoReply(device, PAIR_CONFIRM_TYPE_PIN_CODE, false);
+        UserConfirmAutoReply(device, key, PAIR_CONFIRM_TYPE_PIN_CODE, false);
         return;
     }
 
@@ -1229,11 +1256,12 @@ void ClassicAdapter::SendPairConfirmed(const RawAddress &device, int reqType, in
     });
 }
 
-void ClassicAdapter::UserConfirmAutoReply(const RawAddress &device, int reqType, bool accept) const
+void ClassicAdapter::UserConfirmAutoReply(
+    const RawAddress &device, const utility::BtDeviceKey &key, int reqType, bool accept) const
 {
     HILOGI("address: %{public}s, accept: %{public}d", GetEncryptAddr(device.GetAddress()).c_str(), accept);
 
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(key);
     if (it != devices_.end()) {
         it->second->SetPairConfirmState(PAIR_CONFIRM_STATE_USER_CONFIRM_REPLY);
         it->second->SetPairConfirmType(PAIR_CONFIRM_TYPE_INVALID);
@@ -1526,7 +1554,8 @@ void ClassicAdapter::ReceiveLinkKeyNotification(
     }
 
     RawAddress device = RawAddress::ConvertToString(addr.addr);
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice =
+        FindRemoteDevice(device, utility::BtDeviceKey::FromAddress(addr.addr));
     if (remoteDevice->GetRemoteName().empty()) {
         GetRemoteName(addr);
     }
@@ -1555,7 +1584,8 @@ void ClassicAdapter::ReceiveSimplePairComplete(const BtAddr &addr, uint8_t statu
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     if (status != SUCCESS) {
         RawAddress device = RawAddress::ConvertToString(addr.addr);
-        std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+        std::shared_ptr<ClassicRemoteDevice> remoteDevice =
+            FindRemoteDevice(device, utility::BtDeviceKey::FromAddress(addr.addr));
         bool bondFromLocal = remoteDevice->IsBondedFromLocal();
         /// Passive pairing failed, delete the link key.
         if (bondFromLocal == false) {
@@ -1583,7 +1613,8 @@ void ClassicAdapter::ReceiveAuthenticationComplete(const BtAddr &addr, uint8_t s
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     RawAddress device = RawAddress::ConvertToString(addr.addr);
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice =
+        FindRemoteDevice(device, utility::BtDeviceKey::FromAddress(addr.addr));
     remoteDevice->SetPairConfirmState(PAIR_CONFIRM_STATE_INVALID);
     remoteDevice->SetPairConfirmType(PAIR_CONFIRM_TYPE_INVALID);
 
@@ -1613,7 +1644,8 @@ void ClassicAdapter::ReceiveEncryptionChange(const BtAddr &addr, uint8_t status)
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     RawAddress device = RawAddress::ConvertToString(addr.addr);
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice =
+        FindRemoteDevice(device, utility::BtDeviceKey::FromAddress(addr.addr));
     if (status == GAP_ENCRYPTION_ON) {
         remoteDevice->SetAclConnectState(CONNECTION_STATE_ENCRYPTED_BREDR);
     } else {
@@ -1640,7 +1672,7 @@ std::string ClassicAdapter::GetDeviceName(const RawAddress &device) const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     std::string remoteName = "";
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if (it != devices_.end()) {
         remoteName = it->second->GetRemoteName();
     }
@@ -1654,7 +1686,7 @@ std::vector<Uuid> ClassicAdapter::GetDeviceUuids(const RawAddress &device) const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     std::vector<Uuid> uuids;
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if (it != devices_.end()) {
         uuids = it->second->GetDeviceUuids();
     }
@@ -1703,19 +1735,21 @@ void ClassicAdapter::ServiceSearchAttributeCb(
     RawAddress device = RawAddress::ConvertToString(addr->addr);
     if (adapter->searchUuid_ == UUID_PROTOCOL_L2CAP) {
         adapter->GetDispatcher()->PostTask(
-            std::bind(&ClassicAdapter::SearchAttributeEnd, adapter, device, adapter->uuids_));
+            std::bind(&ClassicAdapter::SearchAttributeEnd, adapter, device,
+                utility::BtDeviceKey::FromAddress(addr->addr), adapter->uuids_));
     } else {
         adapter->GetDispatcher()->PostTask(
             std::bind(&ClassicAdapter::SearchRemoteUuids, adapter, device, UUID_PROTOCOL_L2CAP));
     }
 }
 
-void ClassicAdapter::SearchAttributeEnd(const RawAddress &device, const std::vector<Uuid> &uuids)
+void ClassicAdapter::SearchAttributeEnd(
+    const RawAddress &device, const utility::BtDeviceKey &key, const std::vector<Uuid> &uuids)
 {
     if (isDisable_) {
         return;
     }
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device, key);
     SaveRemoteDeviceUuids(remoteDevice, uuids);
     if (remoteDevice != nullptr) {
         adapterProperties_.SavePairedDeviceInfo(remoteDevice);
@@ -1748,7 +1782,7 @@ bool ClassicAdapter::IsAclConnected(const RawAddress &device) const
 {
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     bool isAclConnected = false;
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if (it != devices_.end()) {
         isAclConnected = it->second->IsAclConnected();
     }
@@ -1761,7 +1795,7 @@ bool ClassicAdapter::IsAclEncrypted(const RawAddress &device) const
 {
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     bool isAclEncrypted = false;
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if (it != devices_.end()) {
         isAclEncrypted = it->second->IsAclEncrypted();
     }
@@ -1779,7 +1813,7 @@ bool ClassicAdapter::IsBondedFromLocal(const RawAddress &device) const
 {
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     bool isBondedFromLocal = false;
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if (it != devices_.end()) {
         isBondedFromLocal = it->second->IsBondedFromLocal();
     }
@@ -1796,11 +1830,9 @@ std::vector<RawAddress> ClassicAdapter::GetPairedDevices() const
         HILOGE("GetPairedDevices devices_ is empty!");
         return pairedList;
     }
-    for (auto &device : devices_) {
-        if ((device.second != nullptr) && (device.second->IsPaired() == true)) {
-            RawAddress rawAddr(device.second->GetAddress());
-            pairedList.push_back(rawAddr);
-        }
+    for (auto &device : GetSortedPairedDevices()) {
+        RawAddress rawAddr(device->GetAddress());
+        pairedList.push_back(rawAddr);
     }
 
     return pairedList;
@@ -1841,7 +1873,7 @@ bool ClassicAdapter::CancelPairing(const RawAddress &device)
     HILOGI("enter");
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if (it == devices_.end() || (it->second->GetPairedStatus() != PAIR_PAIRING)) {
         HILOGE("failed, because of not in PAIR_PAIRING!");
         return false;
@@ -1859,7 +1891,7 @@ bool ClassicAdapter::CancelPairing(const RawAddress &device)
     if (pairConfirmState == PAIR_CONFIRM_STATE_USER_CONFIRM) {
         int pairConfirmType = it->second->GetPairConfirmType();
         RawAddress address(it->second->GetAddress());
-        UserConfirmAutoReply(address, pairConfirmType, false);
+        UserConfirmAutoReply(address, it->first, pairConfirmType, false);
     }
     return true;
 }
@@ -1869,7 +1901,7 @@ bool ClassicAdapter::RemovePair(const RawAddress &device)
     HILOGI("address %{public}s", GetEncryptAddr(device.GetAddress()).c_str());
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if ((it == devices_.end()) || (it->second->IsPaired() == false)) {
         HILOGW("RemovePair failed, because of not find the paired device!");
         return false;
@@ -1923,7 +1955,7 @@ int ClassicAdapter::GetPairState(const RawAddress &device) const
 {
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     int pairState = PAIR_NONE;
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if (it == devices_.end()) {
         return pairState;
     } else {
@@ -1940,7 +1972,7 @@ bool ClassicAdapter::SetDevicePairingConfirmation(const RawAddress &device, bool
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     bool ret = false;
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if ((it == devices_.end()) || (it->second->GetPairedStatus() == PAIR_PAIRED) ||
         (it->second->GetPairedStatus() == PAIR_NONE)) {
         HILOGE("failed, not in pairing state.");
@@ -1967,7 +1999,7 @@ bool ClassicAdapter::SetDevicePasskey(const RawAddress &device, int passkey, boo
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     bool ret = false;
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if ((it == devices_.end()) || (it->second->GetPairedStatus() == PAIR_NONE) ||
         (it->second->GetPairedStatus() == PAIR_PAIRED)) {
         HILOGE("failed, not in pairing state.");
@@ -1993,7 +2025,7 @@ bool ClassicAdapter::PairRequestReply(const RawAddress &device, bool accept) con
     HILOGI("accept = %{public}d", accept);
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if ((it == devices_.end()) || (it->second->GetPairedStatus() != PAIR_PAIRING)) {
         HILOGE("failed, not in pairing state.");
         return false;
@@ -2021,13 +2053,14 @@ void ClassicAdapter::ConnectionComplete(const BtmAclConnectCompleteParam *param,
             param->status,
             param->connectionHandle,
             device,
+            utility::BtDeviceKey::FromAddress(param->addr->addr),
             classOfDevice,
             param->encyptionEnabled));
     }
 }
 
 void ClassicAdapter::ReceiveConnectionComplete(uint8_t status, uint16_t connectionHandle, const RawAddress &device,
-    uint32_t classOfDevice, bool encyptionEnabled)
+    const utility::BtDeviceKey &key, uint32_t classOfDevice, bool encyptionEnabled)
 {
     if (status == BTM_ACL_CONNECT_PAGE_TIMEOUT) {
         HILOGE("ACL Connection failed. Reason: ACL Page Timeout!");
@@ -2038,7 +2071,7 @@ void ClassicAdapter::ReceiveConnectionComplete(uint8_t status, uint16_t connecti
     }
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device, key);
 
     /// For compatibility
     /// Passive pairing failed and pair mode is PinCode.
@@ -2144,7 +2177,8 @@ void ClassicAdapter::SetLinkKey(const BtAddr &addr)
     HILOGI("enter");
 
     RawAddress device = RawAddress::ConvertToString(addr.addr);
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice =
+        FindRemoteDevice(device, utility::BtDeviceKey::FromAddress(addr.addr));
 
     int keyType = remoteDevice->GetLinkKeyType();
     uint8_t key[PAIR_LINK_KEY_SIZE];
@@ -2177,7 +2211,8 @@ void ClassicAdapter::SetIoCapability(const BtAddr &addr)
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     RawAddress rawAddr = RawAddress::ConvertToString(addr.addr);
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(rawAddr);
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice =
+        FindRemoteDevice(rawAddr, utility::BtDeviceKey::FromAddress(addr.addr));
     if (remoteDevice->GetRemoteName().empty()) {
         GetRemoteName(addr);
     }
@@ -2208,7 +2243,8 @@ void ClassicAdapter::SaveRemoteIoCapability(const BtAddr &addr, uint8_t ioCapabi
 {
     HILOGI("enter");
     RawAddress device = RawAddress::ConvertToString(addr.addr);
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice =
+        FindRemoteDevice(device, utility::BtDeviceKey::FromAddress(addr.addr));
     remoteDevice->SetIoCapability(ioCapability);
 }
 
@@ -2216,7 +2252,7 @@ bool ClassicAdapter::SetDevicePin(const RawAddress &device, const std::string &p
 {
     HILOGI("pinCode:%{public}s", pinCode.c_str());
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if ((it == devices_.end()) || (it->second->GetPairedStatus() == PAIR_NONE) ||
         (it->second->GetPairedStatus() == PAIR_PAIRED)) {
         HILOGE("failed, not in pairing state.");
@@ -2269,7 +2305,7 @@ int ClassicAdapter::ClassicAdapter::GetDeviceType(const RawAddress &device) cons
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     int type = INVALID_TYPE;
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if (it != devices_.end()) {
         type = it->second->GetDeviceType();
     }
@@ -2283,7 +2319,7 @@ int ClassicAdapter::GetDeviceClass(const RawAddress &device) const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     int cod = INVALID_VALUE;
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if (it != devices_.end()) {
         cod = it->second->GetDeviceClass();
     }
@@ -2297,7 +2333,7 @@ std::string ClassicAdapter::GetAliasName(const RawAddress &device) const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     std::string alias = INVALID_NAME;
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if (it != devices_.end()) {
         alias = it->second->GetAliasName();
     }
@@ -2311,7 +2347,7 @@ bool ClassicAdapter::SetAliasName(const RawAddress &device, const std::string &n
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     bool ret = false;
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if (it != devices_.end()) {
         if (name != it->second->GetAliasName()) {
             ret = it->second->SetAliasName(name);
@@ -2399,7 +2435,7 @@ void ClassicAdapter::SetDeviceBatteryLevel(const RawAddress &device, int battery
     HILOGI("addr: %{public}s, batteryLevel: %{public}d", GetEncryptAddr(device.GetAddress()).c_str(), batteryLevel);
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
-    auto it = devices_.find(device.GetAddress());
+    auto it = devices_.find(utility::BtDeviceKey::FromString(device.GetAddress()));
     if (it != devices_.end()) {
         it->second->SetBatteryLevel(batteryLevel);
     }
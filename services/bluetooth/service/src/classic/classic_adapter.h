@@ -16,10 +16,10 @@
 #ifndef CLASSIC_ADAPTER_H
 #define CLASSIC_ADAPTER_H
 
-#include <map>
 #include <vector>
 
 #include "base_def.h"
+#include "bt_device_key.h"
 #include "bt_uuid.h"
 #include "btm.h"
 #include "classic_adapter_properties.h"
@@ -27,6 +27,7 @@
 #include "classic_bluetooth_data.h"
 #include "classic_remote_device.h"
 #include "context.h"
+#include "flat_hash_map.h"
 #include "gap_if.h"
 #include "interface_adapter_classic.h"
 #include "log.h"
@@ -734,6 +735,13 @@ private:
      */
     void SavePairedDevices() const;
 
+    /**
+     * @brief Get paired devices in address order, as they were kept before devices_ became a hash map.
+     *
+     * @return Returns paired devices sorted by address.
+     */
+    std::vector<std::shared_ptr<ClassicRemoteDevice>> GetSortedPairedDevices() const;
+
     /**
      * @brief Get service uuid from device uuid.
      *
@@ -928,10 +936,11 @@ private:
      * @param status Connection status.
      * @param connectionHandle Connection handle.
      * @param remoteAddr Device address.
+     * @param key Key of the remote device in devices_.
      * @param encyptionEnabled Encyption enable status.
      */
     void ReceiveConnectionComplete(uint8_t status, uint16_t connectionHandle, const RawAddress &device,
-        uint32_t classOfDevice, bool encyptionEnabled);
+        const utility::BtDeviceKey &key, uint32_t classOfDevice, bool encyptionEnabled);
 
     /**
      * @brief Receive acl disconnection complete.
@@ -946,10 +955,12 @@ private:
      * @brief User confirm auto reply.
      *
      * @param device Remote device.
+     * @param key Key of the remote device in devices_.
      * @param reqType Request type.
      * @param accept Request accept or not.
      */
-    void UserConfirmAutoReply(const RawAddress &device, int reqType, bool accept) const;
+    void UserConfirmAutoReply(
+        const RawAddress &device, const utility::BtDeviceKey &key, int reqType, bool accept) const;
 
     /**
      * @brief Set pin code.
@@ -988,6 +999,15 @@ private:
      */
     std::shared_ptr<ClassicRemoteDevice> FindRemoteDevice(const RawAddress &device);
 
+    /**
+     * @brief Find remote device by a key the caller already built, creating it if it is unknown.
+     *
+     * @param device Remote device address.
+     * @param key Key of the remote device in devices_.
+     * @return Returns remote device.
+     */
+    std::shared_ptr<ClassicRemoteDevice> FindRemoteDevice(const RawAddress &device, const utility::BtDeviceKey &key);
+
     /**
      * @brief Parser remote name from eir data.
      *
@@ -1062,7 +1082,8 @@ private:
     void DeleteLinkKey(std::shared_ptr<ClassicRemoteDevice> remoteDevice) const;
     BtAddr ConvertToBtAddr(const RawAddress &device) const;
     void DisablePairProcess();
-    void SearchAttributeEnd(const RawAddress &device, const std::vector<Uuid> &uuids);
+    void SearchAttributeEnd(
+        const RawAddress &device, const utility::BtDeviceKey &key, const std::vector<Uuid> &uuids);
     void PinCodeReq(const BtAddr &addr);
     ClassicAdapterProperties &adapterProperties_;
     std::unique_ptr<utility::Timer> timer_ {};
@@ -1079,7 +1100,7 @@ private:
     uint16_t searchUuid_ {};
     std::vector<Uuid> uuids_ {};
     std::string remoteNameAddr_ {INVALID_MAC_ADDRESS};
-    std::map<std::string, std::shared_ptr<ClassicRemoteDevice>> devices_ {};
+    utility::FlatHashMap<utility::BtDeviceKey, std::shared_ptr<ClassicRemoteDevice>> devices_ {};
     BtmAclCallbacks btmAclCbs_ {};
     ClassicBluetoothData eirData_ {};
     std::unique_ptr<ClassicBatteryObserverHf> batteryObserverHf_ {};
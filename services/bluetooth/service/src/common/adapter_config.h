@@ -43,6 +43,7 @@ const std::string SECTION_HID_HOST_SERVICE = "HidHostService";
 const std::string SECTION_OPP_SERVICE = "OppService";
 const std::string SECTION_DI_SERVICE = "DIService";
 const std::string SECTION_OUTPUT_SETTING = "OutputSetting";
+const std::string SECTION_STACK_THREAD_GROUP = "StackThreadGroup";
 
 // Output setting name
 const std::string PROPERTY_BTSNOOP_OUTPUT = "BtsnoopOutput";
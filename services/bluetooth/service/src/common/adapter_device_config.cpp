@@ -17,15 +17,15 @@
 
 #include <fstream>
 
+#include "config_store.h"
 #include "log.h"
-#include "xml_parse.h"
 
 namespace OHOS {
 namespace bluetooth {
 AdapterDeviceConfig *AdapterDeviceConfig::g_instance = nullptr;
 
 struct AdapterDeviceConfig::impl {
-    utility::XmlParse parse_ {};
+    utility::ConfigStore store_ {};
     std::string fileName_ {"bt_device_config.xml"};
     std::string filePath_ {BT_CONFIG_PATH + fileName_};
     std::string fileBasePath_ {BT_CONFIG_PATH_BASE + fileName_};
@@ -49,13 +49,13 @@ AdapterDeviceConfig::~AdapterDeviceConfig()
 bool AdapterDeviceConfig::Load()
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    if (pimpl->parse_.Load(pimpl->filePath_)) {
+    if (pimpl->store_.Load(pimpl->filePath_)) {
         return true;
     } else {
         if (!Reload()) {
             return false;
         }
-        return pimpl->parse_.Load(pimpl->filePath_);
+        return pimpl->store_.Load(pimpl->filePath_);
     }
 }
 
@@ -76,91 +76,91 @@ bool AdapterDeviceConfig::Reload()
 bool AdapterDeviceConfig::Save()
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.Save();
+    return pimpl->store_.Save();
 }
 
 bool AdapterDeviceConfig::SetValue(const std::string &section, const std::string &property, const int &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.SetValue(section, property, value);
+    return pimpl->store_.SetValue(section, property, value);
 }
 
 bool AdapterDeviceConfig::SetValue(const std::string &section, const std::string &property, const std::string &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.SetValue(section, property, value);
+    return pimpl->store_.SetValue(section, property, value);
 }
 
 bool AdapterDeviceConfig::GetValue(const std::string &section, const std::string &property, int &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.GetValue(section, property, value);
+    return pimpl->store_.GetValue(section, property, value);
 }
 
 bool AdapterDeviceConfig::GetValue(const std::string &section, const std::string &property, std::string &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
 
-    return pimpl->parse_.GetValue(section, property, value);
+    return pimpl->store_.GetValue(section, property, value);
 }
 
 bool AdapterDeviceConfig::GetValue(const std::string &section, const std::string &property, bool &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.GetValue(section, property, value);
+    return pimpl->store_.GetValue(section, property, value);
 }
 
 bool AdapterDeviceConfig::SetValue(
     const std::string &section, const std::string &subSection, const std::string &property, const int &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.SetValue(section, subSection, property, value);
+    return pimpl->store_.SetValue(section, subSection, property, value);
 }
 bool AdapterDeviceConfig::SetValue(
     const std::string &section, const std::string &subSection, const std::string &property, const std::string &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.SetValue(section, subSection, property, value);
+    return pimpl->store_.SetValue(section, subSection, property, value);
 }
 
 bool AdapterDeviceConfig::SetValue(
     const std::string &section, const std::string &subSection, const std::string &property, const bool &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.SetValue(section, subSection, property, value);
+    return pimpl->store_.SetValue(section, subSection, property, value);
 }
 
 bool AdapterDeviceConfig::GetValue(
     const std::string &section, const std::string &subSection, const std::string &property, int &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.GetValue(section, subSection, property, value);
+    return pimpl->store_.GetValue(section, subSection, property, value);
 }
 
 bool AdapterDeviceConfig::GetValue(
     const std::string &section, const std::string &subSection, const std::string &property, std::string &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.GetValue(section, subSection, property, value);
+    return pimpl->store_.GetValue(section, subSection, property, value);
 }
 
 bool AdapterDeviceConfig::GetValue(
     const std::string &section, const std::string &subSection, const std::string &property, bool &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.GetValue(section, subSection, property, value);
+    return pimpl->store_.GetValue(section, subSection, property, value);
 }
 
 bool AdapterDeviceConfig::GetSubSections(const std::string &section, std::vector<std::string> &subSections)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.GetSubSections(section, subSections);
+    return pimpl->store_.GetSubSections(section, subSections);
 }
 
 bool AdapterDeviceConfig::RemoveSection(const std::string &section, const std::string &subSection)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.RemoveSection(section, subSection);
+    return pimpl->store_.RemoveSection(section, subSection);
 }
 }  // namespace bluetooth
 }  // namespace OHOS
\ No newline at end of file
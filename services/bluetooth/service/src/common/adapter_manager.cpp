@@ -23,6 +23,7 @@
 #include "btstack.h"
 #include "log.h"
 #include "log_util.h"
+#include "phase_timer.h"
 
 #include "adapter_config.h"
 #include "adapter_device_config.h"
@@ -85,6 +86,7 @@ struct AdapterManager::impl {
     std::unique_ptr<AdapterInfo<BleAdapter>> bleAdapter_ = nullptr;
     SysStateMachine sysStateMachine_ = {};
     std::string sysState_ = SYS_STATE_STOPPED;
+    std::string startPhases_ = "";
     BtmCallbacks hciFailureCallbacks = {};
     BaseObserverList<IAdapterStateObserver> adapterObservers_ = {};
     BaseObserverList<ISystemStateObserver> systemObservers_ = {};
@@ -204,33 +206,47 @@ bool AdapterManager::Start()
         return false;
     }
 
+    utility::PhaseTimer timer;
     if (!AdapterConfig::GetInstance()->Load()) {
         LOG_ERROR("Load Config File Failed!!");
         return false;
     }
+    timer.Mark("adapter_config");
 
     if (!ProfileConfig::GetInstance()->Load()) {
         LOG_ERROR("Load Profile Config File Failed!!");
         return false;
     }
+    timer.Mark("profile_config");
 
+    StackThreadSetting();
     if (BTM_Initialize() != BT_SUCCESS) {
         LOG_ERROR("Bluetooth Stack Initialize Failed!!");
         return false;
     }
+    timer.Mark("stack");
 
     if (!OutputSetting()) {
         LOG_ERROR("Bluetooth output set Failed!!");
         return false;
     }
+    timer.Mark("output_setting");
 
     CreateAdapters();
+    timer.Mark("adapters");
 
     ProfileServiceManager::Initialize(*pimpl->dispatcher_);
+    timer.Mark("profile_services");
 
     IPowerManager::Initialize(*pimpl->dispatcher_);
 
     RegisterHciResetCallback();
+    timer.Mark("power_manager");
+    {
+        std::lock_guard<std::recursive_mutex> lock(pimpl->syncMutex_);
+        pimpl->startPhases_ = timer.ToString();
+    }
+    LOG_INFO("%{public}s phases %{public}s", __func__, timer.ToString().c_str());
 
     OnSysStateChange(SYS_STATE_STARTED);
 
@@ -297,6 +313,21 @@ bool AdapterManager::OutputSetting() const
     return true;
 }
 
+void AdapterManager::StackThreadSetting() const
+{
+    // Properties are stack module names, values their thread group. Missing modules stay on the stack thread.
+    static const std::array<const char *, 5> movableModules = {
+        MODULE_NAME_RFCOMM, MODULE_NAME_ATT, MODULE_NAME_AVCTP, MODULE_NAME_AVDTP, MODULE_NAME_SDP};
+    for (auto module : movableModules) {
+        int group = 0;
+        AdapterConfig::GetInstance()->GetValue(SECTION_STACK_THREAD_GROUP, module, group);
+        if (BTM_SetModuleThreadGroup(module, static_cast<uint8_t>(group)) != BT_SUCCESS) {
+            LOG_ERROR("%{public}s: invalid thread group %{public}d of %{public}s", __func__, group, module);
+            BTM_SetModuleThreadGroup(module, 0);
+        }
+    }
+}
+
 void AdapterManager::Stop() const
 {
     LOG_DEBUG("%{public}s start", __PRETTY_FUNCTION__);
@@ -577,6 +608,12 @@ std::string AdapterManager::GetSysState() const
     return pimpl->sysState_;
 }
 
+std::string AdapterManager::GetStartPhaseReport() const
+{
+    std::lock_guard<std::recursive_mutex> lock(pimpl->syncMutex_);
+    return pimpl->startPhases_;
+}
+
 void AdapterManager::OnSysStateExit(const std::string &state) const
 {
     LOG_DEBUG("%{public}s state is %{public}s", __PRETTY_FUNCTION__, state.c_str());
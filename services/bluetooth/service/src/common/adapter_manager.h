@@ -303,12 +303,21 @@ public:
     void OnPairDevicesRemoved(const BTTransport transport, const std::vector<RawAddress> &devices) const;
 
     void RestoreTurnOnState();
+
+    /**
+     * @brief Get the time each phase of Start took.
+     *
+     * @return Returns the phases and the total, as logged when Start returns; empty before Start.
+     * @since 6
+     */
+    std::string GetStartPhaseReport() const;
 private:
     AdapterManager();
     ~AdapterManager();
     void CreateAdapters() const;
     std::string GetSysState() const;
     bool OutputSetting() const;
+    void StackThreadSetting() const;
     void RegisterHciResetCallback();
     void DeregisterHciResetCallback() const;
     void RemoveDeviceProfileConfig(const BTTransport transport, const std::vector<RawAddress> &devices) const;
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "power_activity_tracker.h"
+#include <ctime>
+#include "log.h"
+#include "timer.h"
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+const uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+uint64_t HashAppend(uint64_t hash, const std::string &str)
+{
+    for (unsigned char ch : str) {
+        hash = (hash ^ ch) * FNV_PRIME;
+    }
+    return hash;
+}
+}  // namespace
+
+PowerActivityTracker::PowerActivityTracker(TransitionCallback onTransition, uint64_t quietMs)
+    : onTransition_(std::move(onTransition)), quietMs_(quietMs)
+{}
+
+bool PowerActivityTracker::Update(RequestStatus status, const std::string &profileName, const RawAddress &addr)
+{
+    uint64_t key = MakeKey(profileName, addr);
+    Slot *slot = Find(key);
+    if (slot == nullptr) {
+        slot = Claim(key, profileName, addr);
+        if (slot == nullptr) {
+            return false;
+        }
+    }
+
+    // Stored before the state so that Sample() never pairs a new report with an old timestamp.
+    slot->lastActivityMs.store(NowMs(), std::memory_order_relaxed);
+    uint64_t oldState = slot->state.load(std::memory_order_relaxed);
+    uint64_t newState;
+    do {
+        if (status == RequestStatus::BUSY) {
+            newState = (oldState + REPORT_ONE) | REPORTED_BUSY | BUSY | TRACKED;
+        } else {
+            newState = ((oldState + REPORT_ONE) & ~BUSY) | TRACKED;
+        }
+    } while (!slot->state.compare_exchange_weak(oldState, newState));
+
+    if (status == RequestStatus::BUSY && (oldState & REPORTED_BUSY) == 0) {
+        onTransition_(RequestStatus::BUSY, profileName, addr);
+    } else if (status == RequestStatus::IDLE && (oldState & TRACKED) == 0) {
+        // First report after another status took over: IDLE replaces it right away, as before.
+        onTransition_(RequestStatus::IDLE, profileName, addr);
+    }
+    return true;
+}
+
+void PowerActivityTracker::Reset(const std::string &profileName, const RawAddress &addr)
+{
+    Slot *slot = Find(MakeKey(profileName, addr));
+    if (slot != nullptr) {
+        slot->state.fetch_and(~(REPORTED_BUSY | BUSY | TRACKED));
+    }
+}
+
+bool PowerActivityTracker::Sample(uint64_t nowMs)
+{
+    bool anyBusy = false;
+    for (auto &slot : slots_) {
+        if (slot.key.load(std::memory_order_acquire) <= KEY_HELD) {
+            continue;
+        }
+        uint64_t state = slot.state.load();
+        if ((state & REPORTED_BUSY) == 0) {
+            continue;
+        }
+        uint64_t lastMs = slot.lastActivityMs.load(std::memory_order_relaxed);
+        bool quiet = (state & BUSY) == 0 && nowMs >= lastMs && nowMs - lastMs >= quietMs_;
+        // A report racing with the check changes the word and keeps the pair busy until the next sample.
+        if (!quiet || !slot.state.compare_exchange_strong(state, state & ~REPORTED_BUSY)) {
+            anyBusy = true;
+            continue;
+        }
+        onTransition_(RequestStatus::IDLE, slot.profileName, slot.addr);
+    }
+    return anyBusy;
+}
+
+void PowerActivityTracker::Remove(const RawAddress &addr)
+{
+    std::lock_guard<std::mutex> lock(claimMutex_);
+    for (auto &slot : slots_) {
+        if (slot.key.load(std::memory_order_relaxed) > KEY_HELD && slot.addr == addr) {
+            // A report still holding the slot may land on its next owner; that costs at most one extra sample.
+            slot.key.store(KEY_FREE, std::memory_order_release);
+            slot.state.store(0);
+        }
+    }
+}
+
+void PowerActivityTracker::Clear()
+{
+    std::lock_guard<std::mutex> lock(claimMutex_);
+    for (auto &slot : slots_) {
+        slot.key.store(KEY_FREE, std::memory_order_release);
+        slot.state.store(0);
+    }
+}
+
+uint64_t PowerActivityTracker::NowMs()
+{
+    struct timespec ts = {};
+    clock_gettime(CLOCK_BOOTTIME, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * MS_PER_SECOND + static_cast<uint64_t>(ts.tv_nsec) / NS_PER_MS;
+}
+
+uint64_t PowerActivityTracker::MakeKey(const std::string &profileName, const RawAddress &addr)
+{
+    uint64_t key = HashAppend(HashAppend(FNV_OFFSET_BASIS, addr.GetAddress()), profileName);
+    // 0 and 1 mark free and claiming slots.
+    return (key <= KEY_HELD) ? (key + KEY_HELD + 1) : key;
+}
+
+PowerActivityTracker::Slot *PowerActivityTracker::Find(uint64_t key)
+{
+    size_t start = key % MAX_SLOTS;
+    for (size_t i = 0; i < MAX_SLOTS; i++) {
+        Slot &slot = slots_[(start + i) % MAX_SLOTS];
+        if (slot.key.load(std::memory_order_acquire) == key) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+PowerActivityTracker::Slot *PowerActivityTracker::Claim(
+    uint64_t key, const std::string &profileName, const RawAddress &addr)
+{
+    std::lock_guard<std::mutex> lock(claimMutex_);
+    Slot *slot = Find(key);
+    if (slot != nullptr) {
+        return slot;
+    }
+    size_t start = key % MAX_SLOTS;
+    for (size_t i = 0; i < MAX_SLOTS; i++) {
+        Slot &candidate = slots_[(start + i) % MAX_SLOTS];
+        if (candidate.key.load(std::memory_order_relaxed) != KEY_FREE) {
+            continue;
+        }
+        candidate.key.store(KEY_HELD, std::memory_order_relaxed);
+        candidate.profileName = profileName;
+        candidate.addr = addr;
+        candidate.state.store(0, std::memory_order_relaxed);
+        candidate.lastActivityMs.store(0, std::memory_order_relaxed);
+        candidate.key.store(key, std::memory_order_release);
+        return &candidate;
+    }
+    LOG_DEBUG("PM_: %{public}s no free activity slot for %{public}s", __FUNCTION__, profileName.c_str());
+    return nullptr;
+}
+}  // namespace bluetooth
+}  // namespace OHOS
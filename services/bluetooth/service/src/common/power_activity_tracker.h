@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWER_ACTIVITY_TRACKER_H
+#define POWER_ACTIVITY_TRACKER_H
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include "power_manager.h"
+#include "raw_address.h"
+
+namespace OHOS {
+namespace bluetooth {
+/**
+ * @brief Coalesces BUSY/IDLE reports of each (device, profile) pair.
+ *
+ * Profiles report BUSY and IDLE around every packet they send. The tracker keeps one slot per pair with the
+ * activity in a single atomic word, so a report costs a slot lookup and a compare-and-swap. Only real transitions
+ * are passed on: idle -> busy straight from the reporting thread, busy -> idle from Sample() once the pair has
+ * been quiet for the quiet period.
+ *
+ * @since 6
+ */
+class PowerActivityTracker {
+public:
+    static const size_t MAX_SLOTS = 32;
+    static const uint64_t DEFAULT_QUIET_MS = 100;
+    using TransitionCallback =
+        std::function<void(RequestStatus status, const std::string &profileName, const RawAddress &addr)>;
+
+    /**
+     * @brief Construct PowerActivityTracker object.
+     *
+     * @param onTransition Called with BUSY or IDLE on each transition, from the reporting thread or Sample().
+     * @param quietMs Time without reports after which a busy pair is idle.
+     * @since 6
+     */
+    explicit PowerActivityTracker(TransitionCallback onTransition, uint64_t quietMs = DEFAULT_QUIET_MS);
+    ~PowerActivityTracker() = default;
+
+    /**
+     * @brief Record a BUSY or IDLE report. Lock free once the pair has a slot.
+     *
+     * @param status RequestStatus::BUSY or RequestStatus::IDLE.
+     * @param profileName Profile Name.
+     * @param addr Peer Address.
+     * @return Returns <b>false</b> if the pair has no slot and none is free, the caller reports it unchanged.
+     * @since 6
+     */
+    bool Update(RequestStatus status, const std::string &profileName, const RawAddress &addr);
+
+    /**
+     * @brief Forget the reported activity of a pair, after it reported another status that overrides it.
+     *
+     * @param profileName Profile Name.
+     * @param addr Peer Address.
+     * @since 6
+     */
+    void Reset(const std::string &profileName, const RawAddress &addr);
+
+    /**
+     * @brief Report busy pairs that have gone quiet as IDLE.
+     *
+     * @param nowMs Current CLOCK_BOOTTIME time, see NowMs().
+     * @return Returns <b>true</b> if some pair is still reported busy and sampling has to go on.
+     * @since 6
+     */
+    bool Sample(uint64_t nowMs);
+
+    /**
+     * @brief Release the slots of a device.
+     *
+     * @param addr Peer Address.
+     * @since 6
+     */
+    void Remove(const RawAddress &addr);
+
+    /**
+     * @brief Release all slots.
+     *
+     * @since 6
+     */
+    void Clear();
+
+    /**
+     * @brief Current CLOCK_BOOTTIME time in ms.
+     *
+     * @since 6
+     */
+    static uint64_t NowMs();
+
+private:
+    // Slot state bits, the rest of the word counts reports so Sample() can detect a report racing with it.
+    static const uint64_t REPORTED_BUSY = 0x1;
+    static const uint64_t BUSY = 0x2;
+    static const uint64_t TRACKED = 0x4;
+    static const uint64_t REPORT_ONE = 0x8;
+    static const uint64_t KEY_FREE = 0;
+    static const uint64_t KEY_HELD = 1;
+
+    struct Slot {
+        std::atomic<uint64_t> key {KEY_FREE};
+        std::atomic<uint64_t> state {0};
+        std::atomic<uint64_t> lastActivityMs {0};
+        // Written under claimMutex_ before the key is published.
+        std::string profileName {};
+        RawAddress addr {};
+    };
+
+    static uint64_t MakeKey(const std::string &profileName, const RawAddress &addr);
+    Slot *Find(uint64_t key);
+    Slot *Claim(uint64_t key, const std::string &profileName, const RawAddress &addr);
+
+    TransitionCallback onTransition_;
+    uint64_t quietMs_;
+    std::array<Slot, MAX_SLOTS> slots_ {};
+    std::mutex claimMutex_ {};
+
+    BT_DISALLOW_COPY_AND_ASSIGN(PowerActivityTracker);
+};
+}  // namespace bluetooth
+}  // namespace OHOS
+
+#endif  // POWER_ACTIVITY_TRACKER_H
@@ -16,13 +16,15 @@
 #include "power_manager.h"
 #include <cstring>
 #include <list>
-#include <map>
 #include <mutex>
 #include <string>
 #include "adapter_manager.h"
+#include "bt_device_key.h"
 #include "btm.h"
+#include "flat_hash_map.h"
 #include "log.h"
 #include "log_util.h"
+#include "power_activity_tracker.h"
 #include "power_device.h"
 #include "timer.h"
 
@@ -66,7 +68,11 @@ void PowerManager::Uninitialize()
 /// PowerManager class
 struct PowerManager::impl {
 public:
-    explicit impl(utility::Dispatcher &dispatcher) : dispatcher_(dispatcher)
+    explicit impl(utility::Dispatcher &dispatcher)
+        : dispatcher_(dispatcher),
+          activity_(std::bind(&PowerManager::impl::ActivityTransition, this, std::placeholders::_1,
+              std::placeholders::_2, std::placeholders::_3)),
+          activityTimer_(std::bind(&PowerManager::impl::ActivityTimeout, this))
     {
         LOG_DEBUG("PM_: impl %{public}s start, line: %{public}d\n", __FUNCTION__, __LINE__);
     };
@@ -77,12 +83,20 @@ public:
     BtmPmCallbacks btmPmCallbacks_ {};
     BtmAclCallbacks btmAclCallbacks_ {};
     utility::Dispatcher &dispatcher_;
-    std::map<RawAddress, std::shared_ptr<PowerDevice>> powerDevices_ {};
-    std::map<uint16_t, RawAddress> connectionHandles_ {};
+    utility::FlatHashMap<utility::BtDeviceKey, std::shared_ptr<PowerDevice>> powerDevices_ {};
+    utility::FlatHashMap<uint16_t, RawAddress> connectionHandles_ {};
+    PowerActivityTracker activity_;
+    utility::Timer activityTimer_;
+    std::atomic_bool isSampling_ = false;
 
     void PowerProcess(const RequestStatus status, const std::string &profileName, const RawAddress rawAddr);
     void UpdatePowerDevicesInfo(const RawAddress rawAddr, const std::string &profileName, const RequestStatus status);
 
+    void ActivityTransition(const RequestStatus status, const std::string &profileName, const RawAddress &rawAddr);
+    void ActivityTimeout();
+    void ActivitySampleProcess();
+    void StartActivitySampling();
+
     void ModeChangeCallBackProcess(uint8_t status, const RawAddress rawAddr, uint8_t currentMode, uint16_t interval);
     static void ModeChangeCallBack(
         uint8_t status, const BtAddr *btAddr, uint8_t currentMode, uint16_t interval, void *context);
@@ -128,6 +142,9 @@ void PowerManager::Disable()
 {
     LOG_DEBUG("PM_: %{public}s start, line: %{public}d\n", __FUNCTION__, __LINE__);
     pimpl->isEnabled_ = false;
+    pimpl->activityTimer_.Stop();
+    pimpl->isSampling_ = false;
+    pimpl->activity_.Clear();
     BTM_DeregisterPmCallbacks(&pimpl->btmPmCallbacks_);
     BTM_DeregisterAclCallbacks(&pimpl->btmAclCallbacks_);
     pimpl->powerDevices_.clear();
@@ -136,19 +153,27 @@ void PowerManager::Disable()
 void PowerManager::StatusUpdate(
     const RequestStatus status, const std::string &profileName, const RawAddress &addr) const
 {
+    if (!pimpl->isEnabled_) {
+        return;
+    }
+    // Profiles report BUSY and IDLE around every packet, only their transitions reach the dispatcher.
+    if (status == RequestStatus::BUSY || status == RequestStatus::IDLE) {
+        if (pimpl->activity_.Update(status, profileName, addr)) {
+            return;
+        }
+    } else {
+        pimpl->activity_.Reset(profileName, addr);
+    }
+
     HILOGI("profileName: %{public}s, status: %{public}u,  addr: %{public}s", profileName.c_str(), status,
         GetEncryptAddr(addr.GetAddress()).c_str());
-
-    if (pimpl->isEnabled_) {
-        pimpl->dispatcher_.PostTask(
-            std::bind(&PowerManager::impl::PowerProcess, pimpl.get(), status, profileName, addr));
-    }
+    pimpl->dispatcher_.PostTask(std::bind(&PowerManager::impl::PowerProcess, pimpl.get(), status, profileName, addr));
 }
 
 BTPowerMode PowerManager::GetPowerMode(const RawAddress &addr) const
 {
     std::unique_lock<std::mutex> lock(pimpl->mutex_);
-    auto iter = pimpl->powerDevices_.find(addr);
+    auto iter = pimpl->powerDevices_.find(utility::BtDeviceKey::FromString(addr.GetAddress()));
     if (iter != pimpl->powerDevices_.end()) {
         return iter->second->GetPowerMode();
     }
@@ -161,29 +186,61 @@ void PowerManager::impl::PowerProcess(
     HILOGI("status: %{public}u, profileName: %{public}s", status, profileName.c_str());
     std::unique_lock<std::mutex> lock(mutex_);
     UpdatePowerDevicesInfo(rawAddr, profileName, status);
-    auto iter = powerDevices_.find(rawAddr);
+    auto iter = powerDevices_.find(utility::BtDeviceKey::FromString(rawAddr.GetAddress()));
     if (iter != powerDevices_.end()) {
         iter->second->SetPowerMode();
     }
 }
 
+void PowerManager::impl::ActivityTransition(
+    const RequestStatus status, const std::string &profileName, const RawAddress &rawAddr)
+{
+    dispatcher_.PostTask(std::bind(&PowerManager::impl::PowerProcess, this, status, profileName, rawAddr));
+    if (status == RequestStatus::BUSY) {
+        StartActivitySampling();
+    }
+}
+
+void PowerManager::impl::StartActivitySampling()
+{
+    if (!isSampling_.exchange(true)) {
+        activityTimer_.Start(PowerActivityTracker::DEFAULT_QUIET_MS, true);
+    }
+}
+
+void PowerManager::impl::ActivityTimeout()
+{
+    dispatcher_.PostTask(std::bind(&PowerManager::impl::ActivitySampleProcess, this));
+}
+
+void PowerManager::impl::ActivitySampleProcess()
+{
+    if (!isEnabled_ || activity_.Sample(PowerActivityTracker::NowMs())) {
+        return;
+    }
+    activityTimer_.Stop();
+    isSampling_ = false;
+    // A pair that turned busy while the timer was stopping did not start it again.
+    if (activity_.Sample(PowerActivityTracker::NowMs())) {
+        StartActivitySampling();
+    }
+}
+
 void PowerManager::impl::UpdatePowerDevicesInfo(
     const RawAddress rawAddr, const std::string &profileName, const RequestStatus status)
 {
-    auto iter = powerDevices_.find(rawAddr);
+    utility::BtDeviceKey key = utility::BtDeviceKey::FromString(rawAddr.GetAddress());
+    auto iter = powerDevices_.find(key);
     if (iter == powerDevices_.end()) {
         LOG_DEBUG("PM_: UpdatePowerDevicesInfo(), create powerDevices\n");
-        powerDevices_[rawAddr] = std::make_shared<PowerDevice>(rawAddr, dispatcher_);
+        iter = powerDevices_.emplace(key, std::make_shared<PowerDevice>(rawAddr, dispatcher_)).first;
     }
 
     if (status == RequestStatus::CONNECT_OFF) {
-        auto its = powerDevices_.find(rawAddr);
-        if (its != powerDevices_.end()) {
-            its->second->DeleteRequestPower(profileName);
-        }
+        iter->second->DeleteRequestPower(profileName);
     } else {
         LOG_DEBUG("PM_:: UpdatePowerDevicesInfo(), execute SetRequesetPower()\n");
-        powerDevices_[rawAddr]->SetRequestPower(profileName, status);
+        iter->second->SetRequestPower(profileName, status);
     }
 }
 
@@ -197,16 +254,17 @@ void PowerManager::impl::ModeChangeCallBackProcess(
         interval,
         __LINE__);
     std::unique_lock<std::mutex> lock(mutex_);
-    auto iter = powerDevices_.find(rawAddr);
+    utility::BtDeviceKey key = utility::BtDeviceKey::FromString(rawAddr.GetAddress());
+    auto iter = powerDevices_.find(key);
     if (iter == powerDevices_.end()) {
         if (status != 0) {
             LOG_DEBUG("PM_: ModeChangeCallBackProcess(), no need to create powerDevices for error status\n");
             return;
         }
         LOG_DEBUG("PM_: ModeChangeCallBackProcess(), create powerDevices\n");
-        powerDevices_[rawAddr] = std::make_shared<PowerDevice>(rawAddr, dispatcher_);
+        iter = powerDevices_.emplace(key, std::make_shared<PowerDevice>(rawAddr, dispatcher_)).first;
     }
-    powerDevices_[rawAddr]->ModeChangeCallBack(status, currentMode, interval);
+    iter->second->ModeChangeCallBack(status, currentMode, interval);
 }
 
 void PowerManager::impl::ModeChangeCallBack(
@@ -226,7 +284,7 @@ void PowerManager::impl::SsrCompleteCallBackProcess(uint8_t status, const RawAdd
 {
     LOG_DEBUG("PM_: %{public}s start, status: %u, line: %{public}d\n", __FUNCTION__, status, __LINE__);
     std::unique_lock<std::mutex> lock(mutex_);
-    auto iter = powerDevices_.find(rawAddr);
+    auto iter = powerDevices_.find(utility::BtDeviceKey::FromString(rawAddr.GetAddress()));
     if (iter != powerDevices_.end()) {
         iter->second->SniffSubratingCompleteCallback(status);
     }
@@ -245,10 +303,10 @@ void PowerManager::impl::ConnectionCompleteCallBackProcess(const RawAddress rawA
     HILOGI("addr: %{public}s", GetEncryptAddr(rawAddr.GetAddress()).c_str());
     // construct
     std::unique_lock<std::mutex> lock(mutex_);
-    auto iter = powerDevices_.find(rawAddr);
-    if (iter == powerDevices_.end()) {
+    utility::BtDeviceKey key = utility::BtDeviceKey::FromString(rawAddr.GetAddress());
+    if (powerDevices_.find(key) == powerDevices_.end()) {
         LOG_DEBUG("PM_: ConnectionCompleteCallBackProcess(), create powerDevices\n");
-        powerDevices_[rawAddr] = std::make_shared<PowerDevice>(rawAddr, dispatcher_);
+        powerDevices_.emplace(key, std::make_shared<PowerDevice>(rawAddr, dispatcher_));
     }
     connectionHandles_[connectionHandle] = rawAddr;
 }
@@ -272,11 +330,9 @@ void PowerManager::impl::DisconnectionCompleteCallBackProcess(uint8_t status, ui
         std::unique_lock<std::mutex> lock(mutex_);
         auto iter = connectionHandles_.find(connectionHandle);
         if (iter != connectionHandles_.end()) {
-            auto its = powerDevices_.find(iter->second);
-            if (its != powerDevices_.end()) {
-                powerDevices_.erase(its);
-            }
+            powerDevices_.erase(utility::BtDeviceKey::FromString(iter->second.GetAddress()));
             HILOGI("delete powerDevices, addr: %{public}s", GetEncryptAddr(iter->second.GetAddress()).c_str());
+            activity_.Remove(iter->second);
             connectionHandles_.erase(iter);
         }
     }
@@ -18,12 +18,12 @@
 #include <fstream>
 #include <mutex>
 
-#include "xml_parse.h"
+#include "config_store.h"
 
 namespace OHOS {
 namespace bluetooth {
 struct ProfileConfig::impl {
-    utility::XmlParse parse_ = {};
+    utility::ConfigStore store_ = {};
     std::mutex mutex_ = {};
     std::string fileName_ = {"bt_profile_config.xml"};
     std::string filePath_ = {BT_CONFIG_PATH + fileName_};
@@ -43,13 +43,13 @@ ProfileConfig::~ProfileConfig(){};
 bool ProfileConfig::Load()
 {
     std::lock_guard<std::mutex> lock(pimpl->mutex_);
-    if (pimpl->parse_.Load(pimpl->filePath_)) {
+    if (pimpl->store_.Load(pimpl->filePath_)) {
         return true;
     } else {
         if (!Reload()) {
             return false;
         }
-        return pimpl->parse_.Load(pimpl->filePath_);
+        return pimpl->store_.Load(pimpl->filePath_);
     }
 }
 
@@ -71,58 +71,58 @@ bool ProfileConfig::GetValue(
     const std::string &addr, const std::string &section, const std::string &property, int &value)
 {
     std::lock_guard<std::mutex> lock(pimpl->mutex_);
-    return pimpl->parse_.GetValue(addr, section, property, value);
+    return pimpl->store_.GetValue(addr, section, property, value);
 }
 
 bool ProfileConfig::GetValue(
     const std::string &addr, const std::string &section, const std::string &property, bool &value)
 {
     std::lock_guard<std::mutex> lock(pimpl->mutex_);
-    return pimpl->parse_.GetValue(addr, section, property, value);
+    return pimpl->store_.GetValue(addr, section, property, value);
 }
 
 bool ProfileConfig::SetValue(
     const std::string &addr, const std::string &section, const std::string &property, int &value)
 {
     std::lock_guard<std::mutex> lock(pimpl->mutex_);
-    if (!pimpl->parse_.SetValue(addr, section, property, value)) {
+    if (!pimpl->store_.SetValue(addr, section, property, value)) {
         return false;
     }
-    return pimpl->parse_.Save();
+    return pimpl->store_.Save();
 }
 
 bool ProfileConfig::SetValue(
     const std::string &addr, const std::string &section, const std::string &property, bool &value)
 {
     std::lock_guard<std::mutex> lock(pimpl->mutex_);
-    if (!pimpl->parse_.SetValue(addr, section, property, value)) {
+    if (!pimpl->store_.SetValue(addr, section, property, value)) {
         return false;
     }
-    return pimpl->parse_.Save();
+    return pimpl->store_.Save();
 }
 
 bool ProfileConfig::RemoveAddr(const std::string &addr)
 {
     std::lock_guard<std::mutex> lock(pimpl->mutex_);
-    if (!pimpl->parse_.RemoveSection(addr)) {
+    if (!pimpl->store_.RemoveSection(addr)) {
         return false;
     }
-    return pimpl->parse_.Save();
+    return pimpl->store_.Save();
 }
 
 bool ProfileConfig::RemoveProperty(const std::string &addr, const std::string &section, const std::string &property)
 {
     std::lock_guard<std::mutex> lock(pimpl->mutex_);
-    if (!pimpl->parse_.RemoveProperty(addr, section, property)) {
+    if (!pimpl->store_.RemoveProperty(addr, section, property)) {
         return false;
     }
-    return pimpl->parse_.Save();
+    return pimpl->store_.Save();
 }
 
 bool ProfileConfig::HasSection(const std::string &addr, const std::string &section)
 {
     std::lock_guard<std::mutex> lock(pimpl->mutex_);
-    return pimpl->parse_.HasSection(addr, section);
+    return pimpl->store_.HasSection(addr, section);
 }
 }  // namespace bluetooth
 }  // namespace OHOS
\ No newline at end of file
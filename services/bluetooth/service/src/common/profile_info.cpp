@@ -37,7 +37,8 @@ const std::vector<ProfileInfo> SupportProfilesInfo::SUPPORT_FILES = {
     ProfileInfo(PROFILE_NAME_PBAP_PSE, PROFILE_ID_PBAP_PSE, BLUETOOTH_UUID_PBAP_PSE),
     ProfileInfo(PROFILE_NAME_SPP, PROFILE_ID_SPP, BLUETOOTH_UUID_SPP),
     ProfileInfo(PROFILE_NAME_DI, PROFILE_ID_DI, BLUETOOTH_UUID_PNP),
-    ProfileInfo(PROFILE_NAME_HID_HOST, PROFILE_ID_HID_HOST, BLUETOOTH_UUID_HID_HOST),
+    // HOGP reports come through the GATT client.
+    ProfileInfo(PROFILE_NAME_HID_HOST, PROFILE_ID_HID_HOST, BLUETOOTH_UUID_HID_HOST, {PROFILE_NAME_GATT_CLIENT}),
     ProfileInfo(PROFILE_NAME_PAN, PROFILE_ID_PAN, BLUETOOTH_UUID_PAN),
     ProfileInfo(PROFILE_NAME_OPP, PROFILE_ID_OPP, BLUETOOTH_UUID_OPP),
 };
@@ -58,6 +59,17 @@ std::string SupportProfilesInfo::IdToName(uint32_t id)
     }
 }
 
+std::vector<std::string> SupportProfilesInfo::GetDependencies(const std::string &name)
+{
+    auto it = std::find_if(SUPPORT_FILES.begin(), SUPPORT_FILES.end(),
+        [&name](const ProfileInfo &pInfo) -> bool { return name == pInfo.name_; });
+    if (it != SUPPORT_FILES.end()) {
+        return it->dependencies_;
+    } else {
+        return {};
+    }
+}
+
 const std::vector<ProfileInfo> SupportProfilesInfo::GetConfigSupportProfiles(BTTransport transport)
 {
     std::vector<ProfileInfo> retProfiles;
@@ -41,9 +41,12 @@ public:
      * @param name Profile service name.
      * @param id Profile service Id.
      * @param uuid Profile service uuid.
+     * @param dependencies Profile services to enable before this one.
      * @since 6
      */
-    ProfileInfo(const std::string &name, uint32_t id, const std::string &uuid) : name_(name), id_(id), uuid_(uuid){};
+    ProfileInfo(const std::string &name, uint32_t id, const std::string &uuid,
+        const std::vector<std::string> &dependencies = {})
+        : name_(name), id_(id), uuid_(uuid), dependencies_(dependencies){};
     /**
      * @brief A destructor used to delete the <b>ProfileInfo</b> instance.
      *
@@ -53,6 +56,7 @@ public:
     std::string name_ = {""};
     uint32_t id_ = {0};
     std::string uuid_ = {""};
+    std::vector<std::string> dependencies_ = {};
 };
 
 class SupportProfilesInfo {
@@ -84,6 +88,14 @@ public:
      * @since 6
      */
     static std::string IdToName(uint32_t id);
+    /**
+     * @brief Get the profiles to enable before a profile.
+     *
+     * @param name Profile name.
+     * @return Returns the dependency names, empty for an unknown profile.
+     * @since 6
+     */
+    static std::vector<std::string> GetDependencies(const std::string &name);
     /**
      * @brief Get supported profiles vector.
      *
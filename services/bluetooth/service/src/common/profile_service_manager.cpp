@@ -86,6 +86,7 @@ enum ServiceStateID {
     TURNING_OFF = BTStateID::STATE_TURNING_OFF,
     TURN_OFF = BTStateID::STATE_TURN_OFF,
     WAIT_TURN_ON,
+    WAIT_DEPENDENCY,
 };
 
 struct ProfileServiceManager::impl {
@@ -94,6 +95,7 @@ struct ProfileServiceManager::impl {
     utility::Dispatcher &dispatcher_;
     ProfilesList<IProfile *> startedProfiles_ = {};
     ProfilesList<ServiceStateID> profilesState_ = {};
+    std::map<BTTransport, ProfileStartupScheduler> startups_ = {};
     std::unique_ptr<ProfileServicesContextCallback> contextCallback_ = nullptr;
 
     BT_DISALLOW_COPY_AND_ASSIGN(impl);
@@ -257,40 +259,89 @@ bool ProfileServiceManager::IsAllEnabled(const BTTransport transport) const
 
 void ProfileServiceManager::EnableProfiles(const BTTransport transport) const
 {
+    // Profiles still turning from an earlier request go on as they are, the others wait for their dependencies.
+    std::vector<ProfileStartupNode> nodes;
+    std::vector<std::string> turning;
     FOR_EACH_LIST(it, pimpl->profilesState_, transport)
     {
-        std::string name = it.first;
-        BTTransport otherTransport =
-            (transport == BTTransport::ADAPTER_BREDR) ? BTTransport::ADAPTER_BLE : BTTransport::ADAPTER_BREDR;
-        ServiceStateID otherTransportState = ServiceStateID::TURN_OFF;
+        if (it.second == ServiceStateID::TURN_OFF) {
+            pimpl->profilesState_.SetProfile(transport, it.first, ServiceStateID::WAIT_DEPENDENCY);
+            nodes.push_back(ProfileStartupNode {it.first, SupportProfilesInfo::GetDependencies(it.first)});
+        } else {
+            turning.push_back(it.first);
+        }
+    }
 
-        if (pimpl->profilesState_.Find(otherTransport, name, otherTransportState)) {
-            switch (otherTransportState) {
-                case ServiceStateID::TURN_ON:
-                    LOG_DEBUG("%{public}s TURN_ON otherTransport %{public}d %{public}s", __PRETTY_FUNCTION__, otherTransport, name.c_str());
-                    pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURN_ON);
-                    break;
-                case ServiceStateID::TURNING_OFF:
-                    LOG_DEBUG("%{public}s TURNING_OFF otherTransport %{public}d %{public}s", __PRETTY_FUNCTION__, otherTransport, name.c_str());
-                    pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::WAIT_TURN_ON);
-                    break;
-                case ServiceStateID::TURNING_ON:
-                    LOG_DEBUG("%{public}s TURNING_ON otherTransport %{public}d %{public}s", __PRETTY_FUNCTION__, otherTransport, name.c_str());
-                    pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURNING_ON);
-                    break;
-                default:
-                    break;
-            }
+    for (auto &name : turning) {
+        StartProfile(transport, name);
+        // Its completion is still to come, profiles depending on it wait for that as well.
+        ServiceStateID state = pimpl->profilesState_.Get(transport, name);
+        if ((state == ServiceStateID::TURNING_ON) || (state == ServiceStateID::WAIT_TURN_ON)) {
+            nodes.push_back(ProfileStartupNode {name, SupportProfilesInfo::GetDependencies(name), true});
         }
+    }
+    AdvanceStartup(transport, pimpl->startups_[transport].Start(nodes));
+}
 
-        if (pimpl->profilesState_.Get(transport, name) == ServiceStateID::TURN_OFF) {
-            pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURNING_ON);
-            LOG_DEBUG("%{public}s transport %{public}d %{public}s enable", __PRETTY_FUNCTION__, transport, name.c_str());
-            IProfile *profile = nullptr;
-            if (pimpl->startedProfiles_.Find(transport, name, profile)) {
-                profile->GetContext()->Enable();
-            } else {
-                LOG_DEBUG("%{public}s startedProfiles_ is not find", __PRETTY_FUNCTION__);
+void ProfileServiceManager::StartProfile(const BTTransport transport, const std::string &name) const
+{
+    BTTransport otherTransport =
+        (transport == BTTransport::ADAPTER_BREDR) ? BTTransport::ADAPTER_BLE : BTTransport::ADAPTER_BREDR;
+    ServiceStateID otherTransportState = ServiceStateID::TURN_OFF;
+
+    if (pimpl->profilesState_.Find(otherTransport, name, otherTransportState)) {
+        switch (otherTransportState) {
+            case ServiceStateID::TURN_ON:
+                LOG_DEBUG("%{public}s TURN_ON otherTransport %{public}d %{public}s", __PRETTY_FUNCTION__, otherTransport, name.c_str());
+                pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURN_ON);
+                break;
+            case ServiceStateID::TURNING_OFF:
+                LOG_DEBUG("%{public}s TURNING_OFF otherTransport %{public}d %{public}s", __PRETTY_FUNCTION__, otherTransport, name.c_str());
+                pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::WAIT_TURN_ON);
+                break;
+            case ServiceStateID::TURNING_ON:
+                LOG_DEBUG("%{public}s TURNING_ON otherTransport %{public}d %{public}s", __PRETTY_FUNCTION__, otherTransport, name.c_str());
+                pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURNING_ON);
+                break;
+            default:
+                break;
+        }
+    }
+
+    ServiceStateID state = pimpl->profilesState_.Get(transport, name);
+    if ((state == ServiceStateID::TURN_OFF) || (state == ServiceStateID::WAIT_DEPENDENCY)) {
+        pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURNING_ON);
+        LOG_DEBUG("%{public}s transport %{public}d %{public}s enable", __PRETTY_FUNCTION__, transport, name.c_str());
+        IProfile *profile = nullptr;
+        if (pimpl->startedProfiles_.Find(transport, name, profile)) {
+            profile->GetContext()->Enable();
+        } else {
+            LOG_DEBUG("%{public}s startedProfiles_ is not find", __PRETTY_FUNCTION__);
+        }
+    }
+}
+
+void ProfileServiceManager::AdvanceStartup(const BTTransport transport, const ProfileStartupScheduler::Step &step) const
+{
+    // Every released profile is enabled at once, each on its own context dispatcher.
+    std::vector<ProfileStartupScheduler::Step> steps {step};
+    while (!steps.empty()) {
+        ProfileStartupScheduler::Step current = std::move(steps.back());
+        steps.pop_back();
+        for (auto &name : current.skipped) {
+            if (pimpl->profilesState_.Get(transport, name) == ServiceStateID::WAIT_DEPENDENCY) {
+                pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURN_OFF);
+            }
+        }
+        for (auto &name : current.ready) {
+            // Disabled or timed out while waiting, it is not to be enabled any more.
+            if (pimpl->profilesState_.Get(transport, name) != ServiceStateID::WAIT_DEPENDENCY) {
+                continue;
+            }
+            StartProfile(transport, name);
+            // Already on for the other transport, its dependents need not wait for a callback.
+            if (pimpl->profilesState_.Get(transport, name) == ServiceStateID::TURN_ON) {
+                steps.push_back(pimpl->startups_[transport].OnComplete(name, true));
             }
         }
     }
@@ -311,6 +362,8 @@ void ProfileServiceManager::EnableCompleteProcess(const std::string &name, bool
         (state == ServiceStateID::TURNING_ON)) {
         LOG_DEBUG("%{public}s BREDR %{public}s complete ret %{public}d", __PRETTY_FUNCTION__, profileName.c_str(), ret);
         pimpl->profilesState_.SetProfile(BTTransport::ADAPTER_BREDR, profileName, newState);
+        AdvanceStartup(BTTransport::ADAPTER_BREDR,
+            pimpl->startups_[BTTransport::ADAPTER_BREDR].OnComplete(profileName, ret));
         if (!IsProfilesTurning(BTTransport::ADAPTER_BREDR)) {
             EnableCompleteNotify(BTTransport::ADAPTER_BREDR);
         }
@@ -320,6 +373,8 @@ void ProfileServiceManager::EnableCompleteProcess(const std::string &name, bool
         (state == ServiceStateID::TURNING_ON)) {
         LOG_DEBUG("%{public}s BLE %{public}s complete ret %{public}d", __PRETTY_FUNCTION__, profileName.c_str(), ret);
         pimpl->profilesState_.SetProfile(BTTransport::ADAPTER_BLE, profileName, newState);
+        AdvanceStartup(BTTransport::ADAPTER_BLE,
+            pimpl->startups_[BTTransport::ADAPTER_BLE].OnComplete(profileName, ret));
         if (!IsProfilesTurning(BTTransport::ADAPTER_BLE)) {
             EnableCompleteNotify(BTTransport::ADAPTER_BLE);
         }
@@ -347,6 +402,8 @@ bool ProfileServiceManager::IsProfilesTurning(const BTTransport transport) const
 
 void ProfileServiceManager::EnableCompleteNotify(const BTTransport transport) const
 {
+    LOG_INFO("%{public}s transport %{public}d startup %{public}s",
+        __func__, transport, GetStartupReport(transport).c_str());
     int turnOnProfileCount = std::count_if(pimpl->profilesState_.GetProfiles(transport)->begin(),
         pimpl->profilesState_.GetProfiles(transport)->end(),
         [](const auto &temp) -> bool { return temp.second == ServiceStateID::TURN_ON; });
@@ -437,6 +494,9 @@ void ProfileServiceManager::DisableProfiles(const BTTransport transport) const
             }
         }
 
+        if (pimpl->profilesState_.Get(transport, name) == ServiceStateID::WAIT_DEPENDENCY) {
+            pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURN_OFF);
+        }
         if (pimpl->profilesState_.Get(transport, name) == ServiceStateID::TURN_ON) {
             pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURNING_OFF);
             LOG_DEBUG("%{public}s transport %{public}d %{public}s disable", __PRETTY_FUNCTION__, transport, name.c_str());
@@ -509,6 +569,15 @@ void ProfileServiceManager::CheckWaitEnableProfiles(const std::string &name, con
     }
 }
 
+std::string ProfileServiceManager::GetStartupReport(const BTTransport transport) const
+{
+    auto it = pimpl->startups_.find(transport);
+    if (it == pimpl->startups_.end()) {
+        return "";
+    }
+    return it->second.ToString();
+}
+
 void ProfileServiceManager::GetProfileServicesSupportedUuids(std::vector<std::string> &uuids) const
 {
     for (auto &sp : GET_SUPPORT_PROFILES()) {
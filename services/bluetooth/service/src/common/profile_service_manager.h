@@ -38,6 +38,7 @@
 
 #include "interface_profile.h"
 #include "interface_profile_manager.h"
+#include "profile_startup_scheduler.h"
 #include "util/dispatcher.h"
 
 namespace OHOS {
@@ -182,6 +183,15 @@ public:
      */
     void OnDisable(const std::string &name, bool ret) const;
 
+    /**
+     * @brief Get the timing of the last profile services enable.
+     *
+     * @param transport Adapter transport.
+     * @return Returns each profile's wait and enable time and the total, as logged on completion.
+     * @since 6
+     */
+    std::string GetStartupReport(const BTTransport transport) const;
+
     /**
      * @brief A constructor used to create an <b>ProfileServiceManager</b> instance.
      *
@@ -205,6 +215,8 @@ private:
     void CreateBleProfileServices() const;
 
     void EnableProfiles(const BTTransport transport) const;
+    void StartProfile(const BTTransport transport, const std::string &name) const;
+    void AdvanceStartup(const BTTransport transport, const ProfileStartupScheduler::Step &step) const;
     void DisableProfiles(const BTTransport transport) const;
     void EnableCompleteProcess(const std::string &name, bool ret) const;
     void DisableCompleteProcess(const std::string &name, bool ret) const;
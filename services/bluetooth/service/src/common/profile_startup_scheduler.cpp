@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profile_startup_scheduler.h"
+
+#include <algorithm>
+
+#include "log.h"
+
+namespace OHOS {
+namespace bluetooth {
+using utility::PhaseTimer;
+
+ProfileStartupScheduler::Step ProfileStartupScheduler::Start(const std::vector<ProfileStartupNode> &nodes)
+{
+    Reset();
+    start_ = PhaseTimer::Clock::now();
+    last_ = start_;
+
+    for (auto &node : nodes) {
+        if (index_.find(node.name) == index_.end()) {
+            index_[node.name] = nodes_.size();
+            nodes_.emplace_back();
+            nodes_.back().name = node.name;
+        }
+    }
+    for (auto &node : nodes) {
+        size_t index = index_[node.name];
+        if (node.running) {
+            nodes_[index].state = State::RELEASED;
+            nodes_[index].released = start_;
+            continue;
+        }
+        for (auto &dependency : node.dependencies) {
+            auto it = index_.find(dependency);
+            if ((it == index_.end()) || (it->second == index)) {
+                continue;
+            }
+            auto &dependents = nodes_[it->second].dependents;
+            if (std::find(dependents.begin(), dependents.end(), index) == dependents.end()) {
+                dependents.push_back(index);
+                nodes_[index].pending++;
+            }
+        }
+    }
+
+    Step step;
+    BreakCycles(step);
+    for (size_t i = 0; i < nodes_.size(); i++) {
+        if ((nodes_[i].state == State::WAITING) && (nodes_[i].pending == 0)) {
+            Release(i, step);
+        }
+    }
+    return step;
+}
+
+void ProfileStartupScheduler::BreakCycles(Step &step)
+{
+    std::vector<size_t> pending(nodes_.size());
+    std::vector<size_t> queue;
+    for (size_t i = 0; i < nodes_.size(); i++) {
+        pending[i] = nodes_[i].pending;
+        if (pending[i] == 0) {
+            queue.push_back(i);
+        }
+    }
+
+    while (true) {
+        while (!queue.empty()) {
+            size_t index = queue.back();
+            queue.pop_back();
+            for (size_t dependent : nodes_[index].dependents) {
+                if ((pending[dependent] > 0) && (--pending[dependent] == 0)) {
+                    queue.push_back(dependent);
+                }
+            }
+        }
+        auto it = std::find_if(pending.begin(), pending.end(), [](size_t count) { return count > 0; });
+        if (it == pending.end()) {
+            return;
+        }
+        // A profile waiting on itself through a cycle would never start: start it first, as it was before.
+        auto index = static_cast<size_t>(it - pending.begin());
+        LOG_ERROR("%{public}s dependency cycle through %{public}s", __func__, nodes_[index].name.c_str());
+        *it = 0;
+        queue.push_back(index);
+        Release(index, step);
+    }
+}
+
+void ProfileStartupScheduler::Release(size_t index, Step &step)
+{
+    nodes_[index].state = State::RELEASED;
+    nodes_[index].released = PhaseTimer::Clock::now();
+    step.ready.push_back(nodes_[index].name);
+}
+
+ProfileStartupScheduler::Step ProfileStartupScheduler::OnComplete(const std::string &name, bool ret)
+{
+    Step step;
+    auto it = index_.find(name);
+    if ((it == index_.end()) || (nodes_[it->second].state != State::RELEASED)) {
+        return step;
+    }
+
+    Node &node = nodes_[it->second];
+    node.completed = PhaseTimer::Clock::now();
+    node.state = ret ? State::SUCCEEDED : State::FAILED;
+    last_ = node.completed;
+
+    std::vector<size_t> failed;
+    for (size_t dependent : node.dependents) {
+        if (nodes_[dependent].state != State::WAITING) {
+            continue;
+        }
+        if (!ret) {
+            failed.push_back(dependent);
+        } else if ((nodes_[dependent].pending > 0) && (--nodes_[dependent].pending == 0)) {
+            Release(dependent, step);
+        }
+    }
+    while (!failed.empty()) {
+        size_t index = failed.back();
+        failed.pop_back();
+        if (nodes_[index].state != State::WAITING) {
+            continue;
+        }
+        LOG_ERROR("%{public}s %{public}s skipped, a dependency failed", __func__, nodes_[index].name.c_str());
+        nodes_[index].state = State::SKIPPED;
+        nodes_[index].completed = last_;
+        step.skipped.push_back(nodes_[index].name);
+        failed.insert(failed.end(), nodes_[index].dependents.begin(), nodes_[index].dependents.end());
+    }
+    return step;
+}
+
+bool ProfileStartupScheduler::IsFinished() const
+{
+    return std::none_of(nodes_.begin(), nodes_.end(),
+        [](const Node &node) { return (node.state == State::WAITING) || (node.state == State::RELEASED); });
+}
+
+void ProfileStartupScheduler::Reset()
+{
+    nodes_.clear();
+    index_.clear();
+    start_ = {};
+    last_ = {};
+}
+
+std::vector<ProfileStartupRecord> ProfileStartupScheduler::GetRecords() const
+{
+    std::vector<ProfileStartupRecord> records;
+    for (auto &node : nodes_) {
+        ProfileStartupRecord record;
+        record.name = node.name;
+        record.released = (node.state != State::WAITING) && (node.state != State::SKIPPED);
+        record.completed = (node.state == State::SUCCEEDED) || (node.state == State::FAILED);
+        record.result = (node.state == State::SUCCEEDED);
+        if (record.released) {
+            record.waitUs = PhaseTimer::ElapsedUs(start_, node.released);
+        }
+        if (record.completed) {
+            record.enableUs = PhaseTimer::ElapsedUs(node.released, node.completed);
+        }
+        records.push_back(record);
+    }
+    return records;
+}
+
+uint64_t ProfileStartupScheduler::GetTotalUs() const
+{
+    return PhaseTimer::ElapsedUs(start_, last_);
+}
+
+std::string ProfileStartupScheduler::ToString() const
+{
+    std::string out;
+    for (auto &record : GetRecords()) {
+        out += record.name + "=";
+        if (!record.released) {
+            out += "skipped ";
+            continue;
+        }
+        out += PhaseTimer::FormatMs(record.waitUs) + "+";
+        if (!record.completed) {
+            out += "pending ";
+        } else {
+            out += PhaseTimer::FormatMs(record.enableUs) + (record.result ? " " : "(failed) ");
+        }
+    }
+    return out + "total=" + PhaseTimer::FormatMs(GetTotalUs());
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROFILE_STARTUP_SCHEDULER_H
+#define PROFILE_STARTUP_SCHEDULER_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "phase_timer.h"
+
+namespace OHOS {
+namespace bluetooth {
+/**
+ * @brief A profile to enable and the profiles that have to be enabled before it.
+ *
+ * @since 6
+ */
+struct ProfileStartupNode {
+    std::string name;
+    std::vector<std::string> dependencies;
+    /// Already being enabled by an earlier request: its dependents wait for its completion, it is not released again.
+    bool running = false;
+};
+
+/**
+ * @brief Timing of one profile in a startup.
+ *
+ * @since 6
+ */
+struct ProfileStartupRecord {
+    std::string name;
+    /// From the start of the startup until its dependencies were met.
+    uint64_t waitUs = 0;
+    /// From the enable request until the profile reported completion.
+    uint64_t enableUs = 0;
+    bool released = false;
+    bool completed = false;
+    bool result = false;
+};
+
+/**
+ * @brief Orders the enabling of profile services after their dependencies.
+ *
+ * Every profile whose dependencies are met is released at once, each profile enables on its own context
+ * dispatcher, so independent profiles come up concurrently and a startup takes as long as its longest dependency
+ * chain. A profile whose dependency failed is not enabled. Dependencies outside the started set count as met, a
+ * dependency cycle is broken and logged. Not thread safe, the profile service manager calls it on its dispatcher.
+ *
+ * @since 6
+ */
+class ProfileStartupScheduler {
+public:
+    /**
+     * @brief Result of a scheduling step.
+     *
+     * @since 6
+     */
+    struct Step {
+        /// Profiles whose dependencies are met, to enable now.
+        std::vector<std::string> ready {};
+        /// Profiles given up because a dependency failed.
+        std::vector<std::string> skipped {};
+    };
+
+    /**
+     * @brief Begin a startup, dropping the state of the previous one.
+     *
+     * @param nodes Profiles to enable.
+     * @return Profiles to enable now.
+     * @since 6
+     */
+    Step Start(const std::vector<ProfileStartupNode> &nodes);
+
+    /**
+     * @brief Record the enable result of a profile.
+     *
+     * @param name Profile name.
+     * @param ret Enable result.
+     * @return Profiles released or given up by this result; empty for a profile this startup did not release.
+     * @since 6
+     */
+    Step OnComplete(const std::string &name, bool ret);
+
+    /**
+     * @brief Whether every profile of the startup has completed or has been given up.
+     *
+     * @since 6
+     */
+    bool IsFinished() const;
+
+    /**
+     * @brief Forget the current startup.
+     *
+     * @since 6
+     */
+    void Reset();
+
+    /**
+     * @brief Get the timing of each profile, in start order.
+     *
+     * @since 6
+     */
+    std::vector<ProfileStartupRecord> GetRecords() const;
+
+    /**
+     * @brief Get the time from Start until the last completion.
+     *
+     * @return Microseconds.
+     * @since 6
+     */
+    uint64_t GetTotalUs() const;
+
+    /**
+     * @brief Format the timing for logging, as "name=wait+enable ... total=".
+     *
+     * @since 6
+     */
+    std::string ToString() const;
+
+private:
+    enum class State { WAITING, RELEASED, SUCCEEDED, FAILED, SKIPPED };
+    struct Node {
+        std::string name {};
+        std::vector<size_t> dependents {};
+        size_t pending = 0;
+        State state = State::WAITING;
+        utility::PhaseTimer::Clock::time_point released {};
+        utility::PhaseTimer::Clock::time_point completed {};
+    };
+
+    void Release(size_t index, Step &step);
+    void BreakCycles(Step &step);
+
+    std::vector<Node> nodes_ {};
+    std::map<std::string, size_t> index_ {};
+    utility::PhaseTimer::Clock::time_point start_ {};
+    utility::PhaseTimer::Clock::time_point last_ {};
+};
+}  // namespace bluetooth
+}  // namespace OHOS
+
+#endif  // PROFILE_STARTUP_SCHEDULER_H
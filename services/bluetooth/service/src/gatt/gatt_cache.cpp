@@ -14,11 +14,22 @@
  */
 
 #include "gatt_cache.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "bt_def.h"
 #include "gatt_defines.h"
+#include "log.h"
+#include "securec.h"
 
 namespace OHOS {
 namespace bluetooth {
+namespace {
+constexpr uint32_t GATT_STORAGE_MAGIC = 0x43544147;  // "GATC"
+constexpr uint16_t GATT_STORAGE_VERSION = 2;
+}  // namespace
+
 using Descriptors = std::pair<std::map<uint16_t, GattCache::Descriptor> *, uint16_t>;
 
 void GattCache::AddService(const Service &service)
@@ -33,6 +44,9 @@ void GattCache::AddService(const Service &service)
 void GattCache::Clear()
 {
     services_.clear();
+    valueHandleMap_.clear();
+    characteristicMap_.clear();
+    hasDatabaseHash_ = false;
 }
 
 int GattCache::AddIncludeService(uint16_t serviceHandle, const IncludeService &includeService)
@@ -54,6 +68,7 @@ int GattCache::AddCharacteristic(uint16_t serviceHandle, const Characteristic &c
         auto result = it->second.characteristics_.emplace(characteristic.handle_, characteristic);
         if (result.second) {
             valueHandleMap_.emplace(characteristic.valueHandle_, std::make_pair(serviceHandle, characteristic.handle_));
+            characteristicMap_.emplace(characteristic.handle_, serviceHandle);
         } else {
             result.first->second.properties_ = characteristic.properties_;
             result.first->second.uuid_ = characteristic.uuid_;
@@ -65,16 +80,14 @@ int GattCache::AddCharacteristic(uint16_t serviceHandle, const Characteristic &c
 
 int GattCache::AddDescriptor(uint16_t cccHandle, const Descriptor &descriptor)
 {
-    for (auto &sIt : services_) {
-        auto cIt = sIt.second.characteristics_.find(cccHandle);
-        if (cIt != sIt.second.characteristics_.end()) {
-            cIt->second.descriptors_.emplace(descriptor.handle_, descriptor);
-            valueHandleMap_.emplace(descriptor.handle_, std::make_pair(sIt.second.handle_, cIt->second.handle_));
-            return GattStatus::GATT_SUCCESS;
-        }
+    auto descriptors = GetDescriptors(cccHandle);
+    if (descriptors.first == nullptr) {
+        return GattStatus::INVALID_PARAMETER;
     }
 
-    return GattStatus::INVALID_PARAMETER;
+    descriptors.first->emplace(descriptor.handle_, descriptor);
+    valueHandleMap_.emplace(descriptor.handle_, std::make_pair(descriptors.second, cccHandle));
+    return GattStatus::GATT_SUCCESS;
 }
 
 const GattCache::Characteristic *GattCache::GetCharacteristic(int16_t valueHandle)
@@ -107,7 +120,7 @@ const GattCache::Descriptor *GattCache::GetDescriptor(int16_t valueHandle)
         return nullptr;
     }
     auto descriptor = ccc->second.descriptors_.find(valueHandle);
-    if (descriptor != ccc->second.descriptors_.end()) {
+    if (descriptor == ccc->second.descriptors_.end()) {
         return nullptr;
     }
     return &descriptor->second;
@@ -157,13 +170,34 @@ std::map<uint16_t, GattCache::Characteristic> *GattCache::GetCharacteristics(uin
 
 Descriptors GattCache::GetDescriptors(uint16_t cccHandle)
 {
-    for (auto &service : services_) {
-        auto it = service.second.characteristics_.find(cccHandle);
-        if (it != service.second.characteristics_.end()) {
-            return std::make_pair(&it->second.descriptors_, service.second.handle_);
-        }
+    auto index = characteristicMap_.find(cccHandle);
+    if (index == characteristicMap_.end()) {
+        return std::make_pair(nullptr, 0);
+    }
+    auto service = services_.find(index->second);
+    if (service == services_.end()) {
+        return std::make_pair(nullptr, 0);
     }
-    return std::make_pair(nullptr, 0);
+    auto it = service->second.characteristics_.find(cccHandle);
+    if (it == service->second.characteristics_.end()) {
+        return std::make_pair(nullptr, 0);
+    }
+    return std::make_pair(&it->second.descriptors_, service->second.handle_);
+}
+
+void GattCache::SetDatabaseHash(const DatabaseHash &hash)
+{
+    databaseHash_ = hash;
+    hasDatabaseHash_ = true;
+}
+
+bool GattCache::GetDatabaseHash(DatabaseHash &hash) const
+{
+    if (!hasDatabaseHash_) {
+        return false;
+    }
+    hash = databaseHash_;
+    return true;
 }
 
 const std::string GattCache::GATT_STORAGE_PRIFIX = "gatt_storage_cache_";
@@ -172,39 +206,35 @@ int GattCache::StoredToFile(const GattDevice& address) const
 {
     std::vector<StorageBlob> storage;
 
+    auto makeBlob = [](uint16_t handle, uint8_t type, const Uuid &uuid) {
+        StorageBlob blob = {};
+        blob.handle_ = handle;
+        blob.type_ = type;
+        uuid.ConvertToBytesLE(blob.uuid_, sizeof(blob.uuid_));
+        return blob;
+    };
+
     for (auto &svc : services_) {
-        StorageBlob svcBlob = {};
-        svcBlob.handle_ = svc.second.handle_;
-        svcBlob.type_ = (svc.second.isPrimary_ ? Uuid::ConvertFrom16Bits(UUID_PRIMARY_SERVICE)
-                                               : Uuid::ConvertFrom16Bits(UUID_SECONDARY_SERVICE));
-        svcBlob.value_.service_.uuid_ = svc.second.uuid_;
-        svcBlob.value_.service_.endHandle_ = svc.second.endHandle_;
+        StorageBlob svcBlob = makeBlob(svc.second.handle_,
+            svc.second.isPrimary_ ? STORAGE_PRIMARY_SERVICE : STORAGE_SECONDARY_SERVICE, svc.second.uuid_);
+        svcBlob.value1_ = svc.second.endHandle_;
         storage.push_back(svcBlob);
 
         for (auto &isvc : svc.second.includeServices_) {
-            StorageBlob isvcBlob = {};
-            isvcBlob.handle_ = isvc.handle_;
-            isvcBlob.type_ = Uuid::ConvertFrom16Bits(UUID_INCLUDE_SERVICE);
-            isvcBlob.value_.includeService_.handle_ = isvc.startHandle_;
-            isvcBlob.value_.includeService_.endHandle_ = isvc.endHandle_;
-            isvcBlob.value_.includeService_.uuid_ = isvc.uuid_;
+            StorageBlob isvcBlob = makeBlob(isvc.handle_, STORAGE_INCLUDE_SERVICE, isvc.uuid_);
+            isvcBlob.value1_ = isvc.startHandle_;
+            isvcBlob.value2_ = isvc.endHandle_;
             storage.push_back(isvcBlob);
         }
 
         for (auto &ccc : svc.second.characteristics_) {
-            StorageBlob cccBlob = {};
-            cccBlob.handle_ = ccc.second.handle_;
-            cccBlob.type_ = Uuid::ConvertFrom16Bits(UUID_CHARACTERISTIC);
-            cccBlob.value_.characteristic_.properties_ = ccc.second.properties_;
-            cccBlob.value_.characteristic_.valueHandle_ = ccc.second.valueHandle_;
-            cccBlob.value_.characteristic_.uuid_ = ccc.second.uuid_;
+            StorageBlob cccBlob = makeBlob(ccc.second.handle_, STORAGE_CHARACTERISTIC, ccc.second.uuid_);
+            cccBlob.properties_ = ccc.second.properties_;
+            cccBlob.value1_ = ccc.second.valueHandle_;
             storage.push_back(cccBlob);
 
             for (auto &desc : ccc.second.descriptors_) {
-                StorageBlob descBlob = {};
-                descBlob.handle_ = desc.second.handle_;
-                descBlob.type_ = desc.second.uuid_;
-                storage.push_back(descBlob);
+                storage.push_back(makeBlob(desc.second.handle_, STORAGE_DESCRIPTOR, desc.second.uuid_));
             }
         }
     }
@@ -214,90 +244,137 @@ int GattCache::StoredToFile(const GattDevice& address) const
 
 int GattCache::LoadFromFile(const GattDevice& address)
 {
-    std::vector<StorageBlob> storage = ReadStorageBlobFromFile(address);
+    int fd = open(GenerateGattCacheFileName(address).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return GattStatus::REQUEST_NOT_SUPPORT;
+    }
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(StorageHeader)) {
+        close(fd);
+        return GattStatus::INTERNAL_ERROR;
+    }
+    // Every record is copied into the service maps anyway, so the file is read in one go rather than mapped.
+    std::vector<uint8_t> content(st.st_size);
+    size_t total = 0;
+    while (total < content.size()) {
+        ssize_t len = read(fd, content.data() + total, content.size() - total);
+        if (len < 0 && errno == EINTR) {
+            continue;
+        }
+        if (len <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(len);
+    }
+    close(fd);
+    if (total != content.size()) {
+        return GattStatus::INTERNAL_ERROR;
+    }
+
+    StorageHeader header = {};
+    (void)memcpy_s(&header, sizeof(header), content.data(), sizeof(header));
+    const uint8_t *records = content.data() + sizeof(StorageHeader);
+    size_t recordsLen = content.size() - sizeof(StorageHeader);
+    if (header.magic_ != GATT_STORAGE_MAGIC || header.version_ != GATT_STORAGE_VERSION ||
+        recordsLen != header.count_ * sizeof(StorageBlob) || Checksum(records, recordsLen) != header.crc_) {
+        LOG_ERROR("%{public}s: invalid gatt cache file", __FUNCTION__);
+        return GattStatus::INTERNAL_ERROR;
+    }
 
+    Clear();
     uint16_t currentSvcHandle = 0;
     uint16_t currentCccHandle = 0;
-    for (auto &item : storage) {
-        if (item.type_ == Uuid::ConvertFrom16Bits(UUID_PRIMARY_SERVICE) ||
-            item.type_ == Uuid::ConvertFrom16Bits(UUID_SECONDARY_SERVICE)) {
-            AddService(
-                GattCache::Service((item.type_ == Uuid::ConvertFrom16Bits(UUID_PRIMARY_SERVICE)) ? true : false,
-                    item.handle_,
-                    item.value_.service_.endHandle_,
-                    item.value_.service_.uuid_));
-            currentSvcHandle = item.handle_;
-        } else if (item.type_ == Uuid::ConvertFrom16Bits(UUID_INCLUDE_SERVICE)) {
-            AddIncludeService(currentSvcHandle,
-                GattCache::IncludeService(item.handle_,
-                    item.value_.includeService_.handle_,
-                    item.value_.includeService_.endHandle_,
-                    item.value_.includeService_.uuid_));
-        } else if (item.type_ == Uuid::ConvertFrom16Bits(UUID_CHARACTERISTIC)) {
-            AddCharacteristic(currentSvcHandle,
-                GattCache::Characteristic(item.handle_,
-                    item.value_.characteristic_.properties_,
-                    item.value_.characteristic_.valueHandle_,
-                    item.value_.characteristic_.uuid_));
-            currentCccHandle = item.handle_;
-        } else {
-            AddDescriptor(currentCccHandle, GattCache::Descriptor(item.handle_, item.type_));
-        }
+    for (uint16_t i = 0; i < header.count_; i++) {
+        StorageBlob item = {};
+        (void)memcpy_s(&item, sizeof(item), records + i * sizeof(StorageBlob), sizeof(StorageBlob));
+        AddStorageBlob(item, currentSvcHandle, currentCccHandle);
+    }
+    if (header.hasHash_) {
+        DatabaseHash hash = {};
+        (void)memcpy_s(hash.data(), hash.size(), header.hash_, sizeof(header.hash_));
+        SetDatabaseHash(hash);
     }
 
     return GattStatus::GATT_SUCCESS;
 }
 
+void GattCache::AddStorageBlob(const StorageBlob &item, uint16_t &currentSvcHandle, uint16_t &currentCccHandle)
+{
+    Uuid uuid = Uuid::ConvertFromBytesLE(item.uuid_, sizeof(item.uuid_));
+    switch (item.type_) {
+        case STORAGE_PRIMARY_SERVICE:
+        case STORAGE_SECONDARY_SERVICE:
+            AddService(GattCache::Service(item.type_ == STORAGE_PRIMARY_SERVICE, item.handle_, item.value1_, uuid));
+            currentSvcHandle = item.handle_;
+            break;
+        case STORAGE_INCLUDE_SERVICE:
+            AddIncludeService(
+                currentSvcHandle, GattCache::IncludeService(item.handle_, item.value1_, item.value2_, uuid));
+            break;
+        case STORAGE_CHARACTERISTIC:
+            AddCharacteristic(
+                currentSvcHandle, GattCache::Characteristic(item.handle_, item.properties_, item.value1_, uuid));
+            currentCccHandle = item.handle_;
+            break;
+        case STORAGE_DESCRIPTOR:
+            AddDescriptor(currentCccHandle, GattCache::Descriptor(item.handle_, uuid));
+            break;
+        default:
+            break;
+    }
+}
+
 std::string GattCache::GenerateGattCacheFileName(const GattDevice &address)
 {
-    return (GATT_STORAGE_PRIFIX + address.addr_.GetAddress() + "_" +
+    return (BT_CONFIG_PATH + GATT_STORAGE_PRIFIX + address.addr_.GetAddress() + "_" +
            ((address.transport_ == GATT_TRANSPORT_TYPE_CLASSIC) ? "CLASSIC" : "LE"));
 }
 
-int GattCache::WriteStorageBlobToFile(const GattDevice& address, std::vector<StorageBlob> &blob) const
+uint32_t GattCache::Checksum(const uint8_t *data, size_t len)
 {
-    FILE* fd = fopen(GenerateGattCacheFileName(address).c_str(), "wb");
-    if (fd == nullptr) {
-        return GattStatus::REQUEST_NOT_SUPPORT;
-    }
-
-    uint16_t blobSize = blob.size();
-    if (fwrite(&blobSize, sizeof(uint16_t), 1, fd) != 1) {
-        fclose(fd);
-        return GattStatus::INTERNAL_ERROR;
+    // FNV-1a, enough to reject truncated or foreign files.
+    uint32_t hash = 0x811C9DC5;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ data[i]) * 0x01000193;
     }
+    return hash;
+}
 
-    if (fwrite(blob.data(), sizeof(StorageBlob), blobSize, fd) != blobSize) {
-        fclose(fd);
+int GattCache::WriteStorageBlobToFile(const GattDevice& address, const std::vector<StorageBlob> &blob) const
+{
+    if (blob.size() > UINT16_MAX) {
         return GattStatus::INTERNAL_ERROR;
     }
 
-    fclose(fd);
-
-    return GattStatus::GATT_SUCCESS;
-}
-
-std::vector<GattCache::StorageBlob> GattCache::ReadStorageBlobFromFile(const GattDevice &address) const
-{
-    FILE* fd = fopen(GenerateGattCacheFileName(address).c_str(), "rb");
+    StorageHeader header = {};
+    header.magic_ = GATT_STORAGE_MAGIC;
+    header.version_ = GATT_STORAGE_VERSION;
+    header.count_ = blob.size();
+    header.hasHash_ = hasDatabaseHash_ ? 1 : 0;
+    (void)memcpy_s(header.hash_, sizeof(header.hash_), databaseHash_.data(), databaseHash_.size());
+    header.crc_ = Checksum(reinterpret_cast<const uint8_t *>(blob.data()), blob.size() * sizeof(StorageBlob));
+
+    std::string fileName = GenerateGattCacheFileName(address);
+    std::string tmpName = fileName + ".tmp";
+    FILE* fd = fopen(tmpName.c_str(), "wb");
     if (fd == nullptr) {
-        return std::vector<StorageBlob>();
+        return GattStatus::REQUEST_NOT_SUPPORT;
     }
 
-    uint16_t blobSize = 0;
-    if (fread(&blobSize, sizeof(uint16_t), 1, fd) != 1) {
+    if (fwrite(&header, sizeof(StorageHeader), 1, fd) != 1 ||
+        fwrite(blob.data(), sizeof(StorageBlob), blob.size(), fd) != blob.size()) {
         fclose(fd);
-        return std::vector<StorageBlob>();
+        remove(tmpName.c_str());
+        return GattStatus::INTERNAL_ERROR;
     }
 
-    std::vector<StorageBlob> blob(blobSize, {0, {}, {}});
-    if (fread(blob.data(), sizeof(StorageBlob), blobSize, fd) != blobSize) {
-        fclose(fd);
-        return std::vector<StorageBlob>();
+    fclose(fd);
+    if (rename(tmpName.c_str(), fileName.c_str()) != 0) {
+        remove(tmpName.c_str());
+        return GattStatus::INTERNAL_ERROR;
     }
 
-    fclose(fd);
-    return blob;
+    return GattStatus::GATT_SUCCESS;
 }
 }  // namespace bluetooth
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS
@@ -16,6 +16,7 @@
 #ifndef GATT_CACHE_H
 #define GATT_CACHE_H
 
+#include <array>
 #include <cstdint>
 #include <map>
 #include <string>
@@ -83,6 +84,8 @@ public:
         {}
     };
     using Descriptors = std::pair<std::map<uint16_t, GattCache::Descriptor> *, uint16_t>;
+    // Value of the peer's Database Hash characteristic (Core Spec Vol 3, Part G, 7.3).
+    using DatabaseHash = std::array<uint8_t, 16>;
 
     GattCache()
     {}
@@ -100,6 +103,8 @@ public:
     const GattCache::Characteristic *GetCharacteristic(int16_t valueHandle);
     const GattCache::Descriptor *GetDescriptor(int16_t valueHandle);
     uint16_t GetCharacteristicEndHandle(uint16_t serviceHandle, uint16_t cccHandle) const;
+    void SetDatabaseHash(const DatabaseHash &hash);
+    bool GetDatabaseHash(DatabaseHash &hash) const;
 
     int StoredToFile(const GattDevice& address) const;
     int LoadFromFile(const GattDevice& address);
@@ -108,29 +113,37 @@ public:
     GattCache &operator=(GattCache &&src) = default;
 
 private:
+    enum StorageType : uint8_t {
+        STORAGE_PRIMARY_SERVICE = 1,
+        STORAGE_SECONDARY_SERVICE,
+        STORAGE_INCLUDE_SERVICE,
+        STORAGE_CHARACTERISTIC,
+        STORAGE_DESCRIPTOR,
+    };
+
+#pragma pack(1)
+    struct StorageHeader {
+        uint32_t magic_;
+        uint16_t version_;
+        uint16_t count_;
+        uint8_t hasHash_;
+        uint8_t reserved_[3];
+        uint8_t hash_[16];
+        uint32_t crc_;
+    };
+
+    // One attribute, records are written in handle order.
     struct StorageBlob {
         uint16_t handle_;
-        Uuid type_;
-
-        union {
-            struct {
-                Uuid uuid_;
-                uint16_t endHandle_;
-            } service_;
-
-            struct {
-                uint16_t handle_;
-                uint16_t endHandle_;
-                Uuid uuid_;
-            } includeService_;
-
-            struct {
-                uint8_t properties_;
-                uint16_t valueHandle_;
-                Uuid uuid_;
-            } characteristic_;
-        } value_;
+        uint8_t type_;
+        uint8_t properties_;
+        // service: end handle. include service: start handle. characteristic: value handle.
+        uint16_t value1_;
+        // include service: end handle.
+        uint16_t value2_;
+        uint8_t uuid_[16];
     };
+#pragma pack()
 
     static const std::string GATT_STORAGE_PRIFIX;
 
@@ -140,10 +153,15 @@ private:
     // if value handle belong to descriptor, parent handle is characteristic handle witch descriptor belong to.
     // else parent handle is characteristic handle.
     std::map<uint16_t, std::pair<uint16_t, uint16_t>> valueHandleMap_ = {};
+    // characteristic handle <-> service handle
+    std::map<uint16_t, uint16_t> characteristicMap_ = {};
+    bool hasDatabaseHash_ = false;
+    DatabaseHash databaseHash_ = {};
 
     static std::string GenerateGattCacheFileName(const GattDevice &address);
-    int WriteStorageBlobToFile(const GattDevice& address, std::vector<StorageBlob> &blob) const;
-    std::vector<StorageBlob> ReadStorageBlobFromFile(const GattDevice &address) const;
+    static uint32_t Checksum(const uint8_t *data, size_t len);
+    int WriteStorageBlobToFile(const GattDevice& address, const std::vector<StorageBlob> &blob) const;
+    void AddStorageBlob(const StorageBlob &item, uint16_t &currentSvcHandle, uint16_t &currentCccHandle);
 
     BT_DISALLOW_COPY_AND_ASSIGN(GattCache);
 };
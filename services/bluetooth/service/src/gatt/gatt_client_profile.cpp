@@ -16,6 +16,7 @@
 #include "gatt_client_profile.h"
 #include "att.h"
 #include "bt_def.h"
+#include "btm.h"
 #include "gatt_connection_manager.h"
 #include "gatt_profile_defines.h"
 #include "gatt_service_base.h"
@@ -24,6 +25,26 @@
 
 namespace OHOS {
 namespace bluetooth {
+namespace {
+// A bonded LE peer may connect from a new resolvable private address each time; its cache file is named after
+// its identity address, which the stack resolves with the peer's IRK just as it does for the bond key.
+GattDevice GetCacheDevice(const GattDevice &device)
+{
+    GattDevice cacheDevice = device;
+    if (device.transport_ == GATT_TRANSPORT_TYPE_CLASSIC) {
+        return cacheDevice;
+    }
+    BtAddr addr = {};
+    device.addr_.ConvertToUint8(addr.addr, sizeof(addr.addr));
+    addr.type = device.addressType_;
+    BtAddr identity = {};
+    if (BTM_GetLeIdentityAddress(&addr, &identity) == BT_SUCCESS) {
+        cacheDevice.addr_ = RawAddress::ConvertToString(identity.addr);
+    }
+    return cacheDevice;
+}
+}  // namespace
+
 struct GattClientProfile::impl {
     class GattConnectionObserverImplement;
     GattClientProfileCallback *pClientCallBack_ = nullptr;
@@ -861,6 +882,36 @@ const GattCache::Descriptor *GattClientProfile::GetDescriptor(uint16_t connectHa
     }
     return nullptr;
 }
+/**
+ * @brief Get the Database Hash the cache of this connection was built for.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param hash Indicates database hash.
+ * @return Returns true if the cache is tagged with a database hash.
+ * @since 6.0
+ */
+bool GattClientProfile::GetDatabaseHash(uint16_t connectHandle, GattCache::DatabaseHash &hash) const
+{
+    auto cache = pimpl->cacheMap_.find(connectHandle);
+    if (cache != pimpl->cacheMap_.end()) {
+        return cache->second.GetDatabaseHash(hash);
+    }
+    return false;
+}
+/**
+ * @brief Tag the cache of this connection with the peer's Database Hash.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param hash Indicates database hash.
+ * @since 6.0
+ */
+void GattClientProfile::SetDatabaseHash(uint16_t connectHandle, const GattCache::DatabaseHash &hash) const
+{
+    auto cache = pimpl->cacheMap_.find(connectHandle);
+    if (cache != pimpl->cacheMap_.end()) {
+        cache->second.SetDatabaseHash(hash);
+    }
+}
 /**
  * @brief This sub-procedure is used by the client to process received data from att.
  *
@@ -2268,7 +2319,7 @@ void GattClientProfile::impl::CreateCache(uint16_t connectHandle, const GattDevi
 {
     auto cache = cacheMap_.emplace(connectHandle, std::move(GattCache()));
     if (device.isEncryption_ == true) {
-        cache.first->second.LoadFromFile(device);
+        cache.first->second.LoadFromFile(GetCacheDevice(device));
     }
 }
 /**
@@ -2283,7 +2334,7 @@ void GattClientProfile::impl::DeleteCache(uint16_t connectHandle, const GattDevi
     auto cache = cacheMap_.find(connectHandle);
     if (cache != cacheMap_.end()) {
         if (device.isEncryption_ == true) {
-            cache->second.StoredToFile(device);
+            cache->second.StoredToFile(GetCacheDevice(device));
         }
         cacheMap_.erase(cache);
         LOG_INFO("%{public}s, Device cache successfully deleted", __FUNCTION__);
@@ -91,6 +91,8 @@ public:
     const GattCache::Service *GetService(uint16_t connectHandle, int16_t handle) const;
     const GattCache::Characteristic *GetCharacteristic(uint16_t connectHandle, int16_t valueHandle) const;
     const GattCache::Descriptor *GetDescriptor(uint16_t connectHandle, int16_t valueHandle) const;
+    bool GetDatabaseHash(uint16_t connectHandle, GattCache::DatabaseHash &hash) const;
+    void SetDatabaseHash(uint16_t connectHandle, const GattCache::DatabaseHash &hash) const;
     BT_DISALLOW_COPY_AND_ASSIGN(GattClientProfile);
 
 private:
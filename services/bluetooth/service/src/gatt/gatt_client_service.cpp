@@ -32,6 +32,15 @@
 
 namespace OHOS {
 namespace bluetooth {
+namespace {
+// Application ids are positive; the Database Hash read goes out under the negated id so that its response is
+// never confused with a read the application issued while the cache was being validated.
+inline int HashReadRequestId(int appId)
+{
+    return -appId;
+}
+}  // namespace
+
 struct ClientApplication {
     struct Discover {
         struct Task {
@@ -42,6 +51,10 @@ struct ClientApplication {
         };
         std::queue<Task> tasks_ = {};
         std::set<uint16_t> discovered_ = {};
+        // Database Hash read issued before discovery to validate the persisted cache.
+        bool hashPending_ = false;
+        bool hashValid_ = false;
+        GattCache::DatabaseHash hash_ = {};
         ClientApplication &client_;
         GattClientProfile &profile_;
 
@@ -103,6 +116,9 @@ struct GattClientService::impl : public GattServiceBase {
     void Disconnect(int appId);
 
     void DiscoveryServices(int appId);
+    void StartFullDiscovery(int appId, ClientApplication &client);
+    void OnDatabaseHashRead(int appId, ClientApplication &client, const GattValue &value, size_t length, int ret);
+    void OnDiscoveryComplete(ClientApplication &client, int ret);
     void ReadCharacteristic(int appId, uint16_t handle);
     void ReadCharacteristicByUuid(int appId, const Uuid &uuid);
     void WriteCharacteristic(
@@ -672,22 +688,58 @@ void GattClientService::impl::DiscoveryServices(int appId)
             return;
         }
 
-        if (client.discover_.tasks_.size() != 0) {
+        if (client.discover_.tasks_.size() != 0 || client.discover_.hashPending_) {
             client.callback_.OnServicesDiscovered(GattStatus::REMOTE_DEVICE_BUSY);
             return;
         }
 
-        profile_->ClearCacheMap(client.connection_.GetHandle());
+        // A single Read By Type of the Database Hash decides between the cached database and rediscovery.
         client.discover_.Clear();
+        client.discover_.hashPending_ = true;
+        profile_->ReadUsingCharacteristicByUuid(HashReadRequestId(appId), client.connection_.GetHandle(),
+            Uuid::ConvertFrom16Bits(UUID_DATABASE_HASH));
+    }
+}
+
+void GattClientService::impl::StartFullDiscovery(int appId, ClientApplication &client)
+{
+    profile_->ClearCacheMap(client.connection_.GetHandle());
+
+    ClientApplication::Discover::Task task = {};
+    task.type_ = ClientApplication::Discover::Task::Type::SERVICE;
+    task.startHandle_ = MIN_ATTRIBUTE_HANDLE;
+    task.endHandle_ = MAX_ATTRIBUTE_HANDLE;
+    client.discover_.tasks_.push(task);
+
+    client.discover_.DiscoverNext(appId);
+}
+
+void GattClientService::impl::OnDatabaseHashRead(
+    int appId, ClientApplication &client, const GattValue &value, size_t length, int ret)
+{
+    client.discover_.hashPending_ = false;
+    if (ret == GattStatus::GATT_SUCCESS && value && *value && length == client.discover_.hash_.size()) {
+        (void)memcpy_s(client.discover_.hash_.data(), client.discover_.hash_.size(), value->get(), length);
+        client.discover_.hashValid_ = true;
 
-        ClientApplication::Discover::Task task = {};
-        task.type_ = ClientApplication::Discover::Task::Type::SERVICE;
-        task.startHandle_ = MIN_ATTRIBUTE_HANDLE;
-        task.endHandle_ = MAX_ATTRIBUTE_HANDLE;
-        client.discover_.tasks_.push(task);
+        GattCache::DatabaseHash cached = {};
+        if (profile_->GetDatabaseHash(client.connection_.GetHandle(), cached) && cached == client.discover_.hash_) {
+            LOG_INFO("%{public}s: database hash matches, use cached database", __FUNCTION__);
+            OnDiscoveryComplete(client, GattStatus::GATT_SUCCESS);
+            return;
+        }
+    }
 
-        client.discover_.DiscoverNext(appId);
+    StartFullDiscovery(appId, client);
+}
+
+void GattClientService::impl::OnDiscoveryComplete(ClientApplication &client, int ret)
+{
+    if (ret == GattStatus::GATT_SUCCESS && client.discover_.hashValid_) {
+        profile_->SetDatabaseHash(client.connection_.GetHandle(), client.discover_.hash_);
     }
+    client.discover_.Clear();
+    client.callback_.OnServicesDiscovered(ret);
 }
 
 void GattClientService::impl::ReadCharacteristic(int appId, uint16_t handle)
@@ -855,8 +907,7 @@ void GattClientService::impl::OnDiscoverAllPrimaryServicesEvent(
             }
         }
 
-        it.value()->second.discover_.Clear();
-        it.value()->second.callback_.OnServicesDiscovered(ret);
+        OnDiscoveryComplete(it.value()->second, ret);
     }
 }
 
@@ -883,8 +934,7 @@ void GattClientService::impl::OnFindIncludedServicesEvent(int requestId, int ret
             }
         }
 
-        it.value()->second.discover_.Clear();
-        it.value()->second.callback_.OnServicesDiscovered(ret);
+        OnDiscoveryComplete(it.value()->second, ret);
     }
 }
 
@@ -913,8 +963,7 @@ void GattClientService::impl::OnDiscoverAllCharacteristicOfServiceEvent(int requ
             }
         }
 
-        it.value()->second.discover_.Clear();
-        it.value()->second.callback_.OnServicesDiscovered(ret);
+        OnDiscoveryComplete(it.value()->second, ret);
     }
 }
 
@@ -933,20 +982,27 @@ void GattClientService::impl::OnDiscoverAllCharacteristicDescriptorsEvent(int re
             }
         }
 
-        it.value()->second.discover_.Clear();
-        it.value()->second.callback_.OnServicesDiscovered(ret);
+        OnDiscoveryComplete(it.value()->second, ret);
     }
 }
 
 void GattClientService::impl::OnReadCharacteristicValueEvent(
     int requestId, uint16_t valueHandle, GattValue &value, size_t length, int ret)
 {
-    auto it = GetValidApplication(requestId);
+    int appId = (requestId < 0) ? -requestId : requestId;
+    auto it = GetValidApplication(appId);
     if (it.has_value()) {
         if (it.value()->second.connection_.GetDevice().transport_ == GATT_TRANSPORT_TYPE_CLASSIC) {
             GattUpdatePowerStatus(it.value()->second.connection_.GetDevice().addr_);
         }
 
+        if (requestId < 0) {
+            if (it.value()->second.discover_.hashPending_) {
+                OnDatabaseHashRead(appId, it.value()->second, value, length, ret);
+            }
+            return;
+        }
+
         Characteristic gattCCC(valueHandle - 1);
         if (value) {
             gattCCC.value_ = std::move(*value);
@@ -1309,6 +1365,8 @@ void ClientApplication::Discover::Clear()
         tasks_.pop();
     }
     discovered_.clear();
+    hashPending_ = false;
+    hashValid_ = false;
 }
 
 void GattClientService::Enable()
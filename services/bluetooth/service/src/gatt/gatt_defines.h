@@ -71,6 +71,7 @@ constexpr uint16_t UUID_INCLUDE_SERVICE = 0x2802;
 constexpr uint16_t UUID_CHARACTERISTIC = 0x2803;
 
 constexpr uint16_t UUID_SERVICE_CHANGED = 0x2A05;
+constexpr uint16_t UUID_DATABASE_HASH = 0x2B2A;
 constexpr uint16_t UUID_CHARACTERISTIC_EXTENDED_PROPERTIES = 0x2900;
 constexpr uint16_t UUID_CHARACTERISTIC_USER_DESCRIPTION = 0x2901;
 constexpr uint16_t UUID_CLIENT_CHARACTERISTIC_CONFIGURATION = 0x2902;
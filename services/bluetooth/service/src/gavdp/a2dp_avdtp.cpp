@@ -904,7 +904,7 @@ uint8_t A2dpAvdtp::ParseAvdtpAbortCFM(const uint16_t handle, const BtAddr bdAddr
 }
 
 uint8_t A2dpAvdtp::ParseAvdtpWriteCFM(const uint16_t handle, const BtAddr bdAddr,
-    const uint8_t role, const A2dpAvdtMsg &msg, const AvdtCtrlData &data)
+    const uint8_t role, A2dpAvdtMsg &msg, const AvdtCtrlData &data)
 {
     LOG_INFO("[A2dpAvdtp] %{public}s role(%u)\n", __func__, role);
     A2dpProfile *profile = GetProfileInstance(role);
@@ -917,6 +917,8 @@ uint8_t A2dpAvdtp::ParseAvdtpWriteCFM(const uint16_t handle, const BtAddr bdAddr
         LOG_ERROR("[A2dpAvdtp] %{public}s Failed to get peer instance \n", __func__);
         return EVT_CONNECT_IND;
     }
+    msg.a2dpMsg.stream.addr = bdAddr;
+    msg.a2dpMsg.stream.handle = handle;
     return EVT_WRITE_CFM;
 }
 
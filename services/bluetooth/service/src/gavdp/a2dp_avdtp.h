@@ -606,7 +606,7 @@ private:
      * @since 6.0
      */
     static uint8_t ParseAvdtpWriteCFM(const uint16_t handle, const BtAddr bdAddr,
-        const uint8_t role, const A2dpAvdtMsg &msg, const AvdtCtrlData &data);
+        const uint8_t role, A2dpAvdtMsg &msg, const AvdtCtrlData &data);
     A2dpAvdtp() = delete;
     uint8_t peerRole_ = 0;
 };
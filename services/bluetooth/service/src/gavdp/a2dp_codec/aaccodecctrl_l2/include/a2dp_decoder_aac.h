@@ -26,6 +26,7 @@ public:
     A2dpAacDecoder(A2dpDecoderObserver *observer) : A2dpDecoder(observer)
     {}
     ~A2dpAacDecoder() = default;
+    using A2dpDecoder::DecodePacket;
     bool DecodePacket(uint8_t *data, uint16_t size)
     {
         return false;
@@ -23,7 +23,9 @@ namespace OHOS {
 namespace bluetooth {
 class A2dpAacEncoder : public A2dpEncoder {
 public:
-    A2dpAacEncoder(const A2dpEncoderInitPeerParams *peerParams, A2dpCodecConfig *config) : A2dpEncoder(config)
+    A2dpAacEncoder(const A2dpEncoderInitPeerParams *peerParams, A2dpCodecConfig *config,
+        A2dpEncoderObserver *observer)
+        : A2dpEncoder(config, observer)
     {}
     ~A2dpAacEncoder() = default;
     void ResetFeedingState(void) override
@@ -26,11 +26,33 @@
 
 namespace OHOS {
 namespace bluetooth {
+// A2dpEncoderObserver is responsible of feeding pcm data to a2dp encoder and
+// receiving the media packets it encoded
+class A2dpEncoderObserver {
+public:
+    virtual ~A2dpEncoderObserver() = default;
+    virtual uint32_t Read(uint8_t *buf, uint32_t size) = 0;
+    // The packet stays owned by the encoder; keep it with PacketRefMalloc.
+    virtual void EnqueuePacket(const Packet *packet, size_t frames, uint32_t bytes, uint32_t timeStamp) = 0;
+};
+
+// Transmit state of the peers fed by one encoder during the last tick; the most congested peer decides.
+struct A2dpLinkSample {
+    size_t queuedPackets = 0;          // Media packets waiting in the deepest peer queue.
+    size_t queueLength = 0;            // Media packets a peer queue holds before it drops the oldest.
+    uint32_t droppedPackets = 0;       // Media packets dropped from the peer queues since the last tick.
+    bool aclValid = false;             // The ACL fields below were read from the stack.
+    bool aclCreditsExhausted = false;  // The controller had no free ACL buffer.
+    uint32_t waitingAclPackets = 0;    // ACL packets of a peer waiting in the host for a controller buffer.
+    uint32_t inFlightAclPackets = 0;   // ACL packets of a peer the controller has not completed yet.
+    uint32_t completedAclPackets = 0;  // ACL packets the slowest peer completed since the last tick.
+};
+
 // A2dp encoder interface
 class A2dpEncoder {
 public:
-    explicit A2dpEncoder(A2dpCodecConfig *config)
-        : config_(config), transmitQueueLength_(0)
+    A2dpEncoder(A2dpCodecConfig *config, A2dpEncoderObserver *observer)
+        : config_(config), observer_(observer), transmitQueueLength_(0)
     {}
     virtual ~A2dpEncoder() = default;
     virtual void ResetFeedingState(void) = 0;
@@ -38,13 +60,20 @@ public:
     {
         transmitQueueLength_ = length;
     }
+    // timeStampUs is CLOCK_MONOTONIC; the PCM read follows the time passed since the last call.
     virtual void SendFrames(uint64_t timeStampUs) = 0;
+    // Called before SendFrames when the link is watched; encoders with a variable rate adapt to it.
+    virtual void AdaptToLink(const A2dpLinkSample &sample)
+    {
+        (void)sample;
+    }
     virtual void UpdateEncoderParam() = 0;
     virtual void GetRenderPosition(uint64_t &sendDataSize, uint32_t &timeStamp) = 0;
 
 protected:
     BT_DISALLOW_COPY_AND_ASSIGN(A2dpEncoder);
     A2dpCodecConfig *config_;
+    A2dpEncoderObserver *observer_;
     size_t transmitQueueLength_;
 };
 
@@ -63,6 +92,16 @@ public:
     {}
     virtual ~A2dpDecoder() = default;
     virtual bool DecodePacket(uint8_t *data, uint16_t size) = 0;
+    // Decodes from the packet's own payload; only a payload split over several buffers is joined first.
+    virtual bool DecodePacket(Packet *packet)
+    {
+        Buffer *payload = PacketContinuousPayload(packet);
+        if (payload == nullptr) {
+            return false;
+        }
+        return DecodePacket(
+            static_cast<uint8_t *>(BufferPtr(payload)), static_cast<uint16_t>(BufferGetSize(payload)));
+    }
 
 protected:
     BT_DISALLOW_COPY_AND_ASSIGN(A2dpDecoder);
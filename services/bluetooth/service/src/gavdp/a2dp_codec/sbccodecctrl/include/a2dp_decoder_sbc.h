@@ -27,8 +27,10 @@ class A2dpSbcDecoder : public A2dpDecoder {
 public:
     explicit A2dpSbcDecoder(A2dpDecoderObserver *observer);
     ~A2dpSbcDecoder();
+    using A2dpDecoder::DecodePacket;
     bool DecodePacket(uint8_t *data, uint16_t size) override;
 private:
+    std::unique_ptr<uint8_t[]> pcmFrames_ = nullptr;
     sbc::IDecoderBase* sbcDecoder_ = nullptr;
     std::unique_ptr<A2dpSBCDynamicLibCtrl> codecLib_ = nullptr;
     CODECSbcLib *codecSbcDecoderLib_ = nullptr;
@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <memory>
 #include <vector>
+#include "a2dp_sbc_bitpool_ctrl.h"
 #include "a2dp_sbc_dynamic_lib_ctrl.h"
 #include "../../include/a2dp_codec_config.h"
 #include "../../include/a2dp_codec_wrapper.h"
@@ -84,6 +85,8 @@ struct A2dpSbcFeedingState {
     uint32_t counter;
     uint32_t bytesPerTick;          // Pcm bytes read during each media task tick.
     uint64_t lastFrameTimestampNs;  // Last tick timestamp, values in ns.
+    uint64_t feedResidue;           // Samples * 1e9 left over from the last tick, so the ticks do not drift.
+    uint32_t bytesOwed;             // Pcm bytes due and not read yet, a late tick is caught up over the next ones.
 };
 
 struct SBCEncoderParams {
@@ -114,18 +117,25 @@ struct A2dpSbcEncoderCb {
 
 class A2dpSbcEncoder : public A2dpEncoder {
 public:
-    A2dpSbcEncoder(const A2dpEncoderInitPeerParams *peerParams, A2dpCodecConfig *config);
+    A2dpSbcEncoder(const A2dpEncoderInitPeerParams *peerParams, A2dpCodecConfig *config,
+        A2dpEncoderObserver *observer);
     ~A2dpSbcEncoder() override;
     void ResetFeedingState(void) override;
     void SendFrames(uint64_t timeStampUs) override;
+    void AdaptToLink(const A2dpLinkSample &sample) override;
     void UpdateEncoderParam() override;
     void GetRenderPosition(uint64_t &sendDataSize, uint32_t &timeStamp) override;
 
 private:
     sbc::IEncoderBase* sbcEncoder_ = nullptr;
+    // Per encoder, the encoders of several configurations run side by side.
+    sbc::CodecParam sbcEncode_ {};
     std::unique_ptr<A2dpSBCDynamicLibCtrl> codecLib_ = nullptr;
+    // Bitpool of the frames sent, between half the computed bitpool and the computed one.
+    A2dpSbcBitpoolController bitpoolCtrl_ {};
     CODECSbcLib *codecSbcEncoderLib_ = nullptr;
     void updateParam(void);
+    void A2dpSbcUpdateFeeding(uint64_t timeStampUs);
     bool A2dpSbcReadFeeding(uint32_t *bytesRead);
     void A2dpSbcCalculateEncBitPool(uint16_t samplingFreq, uint16_t minBitPool, uint16_t maxBitPool);
     void A2dpSbcEncodeFrames(void);
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef A2DP_SBC_BITPOOL_CTRL_H
+#define A2DP_SBC_BITPOOL_CTRL_H
+
+#include <cstdint>
+#include "../../include/a2dp_codec_wrapper.h"
+
+namespace OHOS {
+namespace bluetooth {
+struct A2dpSbcBitpoolStats {
+    uint32_t decreases = 0;
+    uint32_t increases = 0;
+    uint32_t congestedTicks = 0;
+};
+
+/**
+ * @brief Moves the SBC bitpool inside [min, max] after the transmit state of the link.
+ *        Drops cut the bitpool by a quarter at once; a deep media queue, ACL packets waiting for controller buffers
+ *        or exhausted buffers that complete nothing take it down a step, at most once per hold time so the smaller
+ *        frames get to drain the queue first. Only a link that stayed clear for the recover time gets it back up,
+ *        step by step, so a link at the edge does not flap between two rates.
+ */
+class A2dpSbcBitpoolController {
+public:
+    void Reset(uint8_t minBitpool, uint8_t maxBitpool);
+    uint8_t Update(const A2dpLinkSample &sample);
+    uint8_t GetBitpool() const
+    {
+        return bitpool_;
+    }
+    const A2dpSbcBitpoolStats &GetStats() const
+    {
+        return stats_;
+    }
+
+private:
+    static bool IsCongested(const A2dpLinkSample &sample);
+    static bool IsClear(const A2dpLinkSample &sample);
+    void Decrease(uint8_t step);
+
+    uint8_t minBitpool_ = 0;
+    uint8_t maxBitpool_ = 0;
+    uint8_t bitpool_ = 0;
+    uint32_t holdTicks_ = 0;
+    uint32_t clearTicks_ = 0;
+    A2dpSbcBitpoolStats stats_ {};
+};
+}  // namespace bluetooth
+}  // namespace OHOS
+
+#endif  // A2DP_SBC_BITPOOL_CTRL_H
@@ -20,7 +20,10 @@
 
 namespace OHOS {
 namespace bluetooth {
-const int CODEC_BUFFER_SIZE4K = 4096;
+// One header byte carrying the frame count, which is four bits wide.
+constexpr size_t SBC_MEDIA_PAYLOAD_HEADER = 1;
+constexpr size_t SBC_MAX_FRAMES_PER_PACKET = 15;
+constexpr size_t SBC_PCM_FRAMES_SIZE = SBC_MAX_FRAMES_PER_PACKET * SBC_MAX_PCM_BUFFER_SIZE * sizeof(int16_t);
 
 sbc::CodecParam g_sbcDecode = {};
 
@@ -28,6 +31,7 @@ A2dpSbcDecoder::A2dpSbcDecoder(A2dpDecoderObserver *observer) : A2dpDecoder(obse
 {
     LOG_INFO("[SbcDecoder] %{public}s\n", __func__);
     g_sbcDecode.endian = sbc::SBC_ENDIANESS_LE;
+    pcmFrames_ = std::make_unique<uint8_t[]>(SBC_PCM_FRAMES_SIZE);
     codecLib_ = std::make_unique<A2dpSBCDynamicLibCtrl>(false);
     codecSbcDecoderLib_ = codecLib_->LoadCodecSbcLib();
     if (codecSbcDecoderLib_ == nullptr) {
@@ -48,40 +52,26 @@ A2dpSbcDecoder::~A2dpSbcDecoder()
 
 bool A2dpSbcDecoder::DecodePacket(uint8_t *data, uint16_t size)
 {
-    uint8_t pcmData[CODEC_BUFFER_SIZE4K];
-    size_t len = 0;
-    int pos = 0x01;
-    int frameLen = 0;
-    uint16_t packetSize = size;
-    uint8_t buf[CODEC_BUFFER_SIZE4K] = {0};
-    (void)memcpy_s(buf, CODEC_BUFFER_SIZE4K, data, packetSize);
-    (void)memset_s(pcmData, CODEC_BUFFER_SIZE4K, 0, CODEC_BUFFER_SIZE4K);
-    int count = len;
-    while (true) {
-        if (count + len > CODEC_BUFFER_SIZE4K) {
-            LOG_INFO(" count > buf");
-            break;
-        }
-
-        if (pos >= packetSize) {
-            LOG_INFO("pos > packetSize");
-            break;
-        }
-
-        frameLen = sbcDecoder_->SBCDecode(g_sbcDecode, &buf[pos], packetSize - pos,
-            &pcmData[count], sizeof(pcmData) - count, &len);
-        pos += frameLen;
-        if (frameLen < 0) {
-            LOG_ERROR(" frame  length is err");
+    if ((sbcDecoder_ == nullptr) || (size <= SBC_MEDIA_PAYLOAD_HEADER)) {
+        return false;
+    }
+    // Frames are decoded where they lie in the media packet into PCM storage reused by every packet.
+    size_t count = 0;
+    size_t pos = SBC_MEDIA_PAYLOAD_HEADER;
+    while (pos < size) {
+        size_t len = 0;
+        ssize_t frameLen = sbcDecoder_->SBCDecode(g_sbcDecode, &data[pos], size - pos,
+            &pcmFrames_[count], SBC_PCM_FRAMES_SIZE - count, &len);
+        if (frameLen <= 0) {
+            LOG_ERROR("[SbcDecoder] %{public}s frame length is err %{public}zd", __func__, frameLen);
             break;
         }
+        pos += static_cast<size_t>(frameLen);
         count += len;
     }
-    LOG_INFO("[DataAvailable][packetSize:%hu][count:%{public}d][len:%{public}zu][frameLen:%{public}d]",
-        packetSize, count, len, frameLen);
 
     if (count > 0) {
-        observer_->DataAvailable(pcmData, count);
+        observer_->DataAvailable(pcmFrames_.get(), count);
     }
     return true;
 }
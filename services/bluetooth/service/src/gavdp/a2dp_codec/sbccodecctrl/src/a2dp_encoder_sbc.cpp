@@ -14,6 +14,7 @@
  */
 #include <cinttypes>
 #include "../include/a2dp_encoder_sbc.h"
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <mutex>
@@ -21,7 +22,6 @@
 #include "log.h"
 #include "packet.h"
 #include "securec.h"
-#include "../../../a2dp_service.h"
 
 namespace OHOS {
 namespace bluetooth {
@@ -42,13 +42,17 @@ const int BIT_POOL_SIXTEEN = 16;
 const int FRAGMENT_SIZE_TWO = 2;
 const int FRAGMENT_SIZE_THREE = 3;
 const int VALUE_TWO = 2;
-
-sbc::CodecParam g_sbcEncode = {};
-
+const uint64_t NS_PER_US = 1000;
+const uint64_t NS_PER_SECOND = 1000000000;
+// Ticks of PCM read at most at once when catching up, more frames would not fit three fragments of the MTU.
+const uint32_t MAX_FEED_TICKS = 2;
+// Ticks of PCM owed at most, a longer stall skips the audio instead of bursting it out.
+const uint32_t MAX_OWED_TICKS = 10;
 
 std::recursive_mutex g_sbcMutex {};
-A2dpSbcEncoder::A2dpSbcEncoder(
-    const A2dpEncoderInitPeerParams *peerParams, A2dpCodecConfig *config) : A2dpEncoder(config)
+A2dpSbcEncoder::A2dpSbcEncoder(const A2dpEncoderInitPeerParams *peerParams, A2dpCodecConfig *config,
+    A2dpEncoderObserver *observer)
+    : A2dpEncoder(config, observer)
 {
     LOG_INFO("[SbcEncoder] %{public}s\n", __func__);
     a2dpSbcEncoderCb_.isPeerEdr = peerParams->isPeerEdr;
@@ -104,9 +108,50 @@ void A2dpSbcEncoder::SendFrames(uint64_t timeStampUs)
 {
     LOG_INFO("[A2dpSbcEncoder] %{public}s\n", __func__);
     std::lock_guard<std::recursive_mutex> lock(g_sbcMutex);
+    A2dpSbcUpdateFeeding(timeStampUs);
     A2dpSbcEncodeFrames();
 }
 
+void A2dpSbcEncoder::AdaptToLink(const A2dpLinkSample &sample)
+{
+    std::lock_guard<std::recursive_mutex> lock(g_sbcMutex);
+    uint8_t bitpool = bitpoolCtrl_.Update(sample);
+    if (bitpool != sbcEncode_.bitpool) {
+        LOG_INFO("[A2dpSbcEncoder] %{public}s bitpool %{public}u -> %{public}u [queued:%{public}zu]"
+            "[dropped:%{public}u][aclWaiting:%{public}u]\n", __func__, sbcEncode_.bitpool, bitpool,
+            sample.queuedPackets, sample.droppedPackets, sample.waitingAclPackets);
+        sbcEncode_.bitpool = bitpool;
+    }
+}
+
+void A2dpSbcEncoder::A2dpSbcUpdateFeeding(uint64_t timeStampUs)
+{
+    A2dpSbcFeedingState &state = a2dpSbcEncoderCb_.feedingState;
+    uint64_t nowNs = timeStampUs * NS_PER_US;
+    if ((state.lastFrameTimestampNs == 0) || (nowNs < state.lastFrameTimestampNs)) {
+        state.lastFrameTimestampNs = nowNs;
+        state.feedResidue = 0;
+        state.bytesOwed = state.bytesPerTick;
+        return;
+    }
+
+    // Read the samples of the time really passed; the remainder carries over so timer jitter does not add up.
+    uint32_t frameBytes = a2dpSbcEncoderCb_.feedingParams.bitsPerSample / BIT_SBC_NUMBER_PER_SAMPLE *
+        a2dpSbcEncoderCb_.feedingParams.channelCount;
+    uint64_t scaled = (nowNs - state.lastFrameTimestampNs) * a2dpSbcEncoderCb_.feedingParams.sampleRate +
+        state.feedResidue;
+    state.lastFrameTimestampNs = nowNs;
+    state.feedResidue = scaled % NS_PER_SECOND;
+    uint64_t owed = state.bytesOwed + scaled / NS_PER_SECOND * frameBytes;
+    uint64_t maxOwed = static_cast<uint64_t>(state.bytesPerTick) * MAX_OWED_TICKS;
+    if (owed > maxOwed) {
+        LOG_WARN("[SbcEncoder] %{public}s stalled, skip %{public}" PRIu64 " bytes\n", __func__, owed - maxOwed);
+        owed = maxOwed;
+        state.feedResidue = 0;
+    }
+    state.bytesOwed = static_cast<uint32_t>(owed);
+}
+
 uint16_t A2dpSbcEncoder::A2dpSbcGetSampleRate(const uint8_t *codecInfo)
 {
     LOG_INFO("[SbcEncoder] %{public}s\n", __func__);
@@ -266,16 +311,16 @@ void A2dpSbcEncoder::SetSBCParam()
     ConvertBlockParamToSBCParam();
     ConvertAllocationParamToSBCParam();
     ConvertBitpoolParamToSBCParam();
-    g_sbcEncode.endian = sbc::SBC_ENDIANESS_LE;
+    sbcEncode_.endian = sbc::SBC_ENDIANESS_LE;
     sbcEncoder_ = codecSbcEncoderLib_->sbcEncoder.createSbcEncode();
     LOG_INFO("[SbcEncoder] %{public}s[freq:%u][mode:%u][sub:%u][block:%u][alc:%u][bitpool:%u]\n",
         __func__,
-        g_sbcEncode.frequency,
-        g_sbcEncode.channelMode,
-        g_sbcEncode.subbands,
-        g_sbcEncode.blocks,
-        g_sbcEncode.allocation,
-        g_sbcEncode.bitpool);
+        sbcEncode_.frequency,
+        sbcEncode_.channelMode,
+        sbcEncode_.subbands,
+        sbcEncode_.blocks,
+        sbcEncode_.allocation,
+        sbcEncode_.bitpool);
 }
 
 void A2dpSbcEncoder::updateParam(void)
@@ -315,6 +360,9 @@ void A2dpSbcEncoder::UpdateEncoderParam(void)
     }
 
     A2dpSbcCalculateEncBitPool(samplingFreq, minBitPool, maxBitPool);
+    int16_t bitPool = std::max<int16_t>(encParams->bitPool, 0);
+    bitpoolCtrl_.Reset(static_cast<uint8_t>(std::max<int>(minBitPool, bitPool / VALUE_TWO)),
+        static_cast<uint8_t>(bitPool));
     SetSBCParam();
     UpdateMtuSize();
 }
@@ -323,14 +371,20 @@ bool A2dpSbcEncoder::A2dpSbcReadFeeding(uint32_t *bytesRead)
 {
     LOG_INFO("[SbcEncoder] %{public}s\n", __func__);
 
-    uint32_t expectedReadPcmData = a2dpSbcEncoderCb_.feedingState.bytesPerTick;
-
-    if (expectedReadPcmData + a2dpSbcEncoderCb_.offsetPCM > FRAME_THREE * A2DP_SBC_MAX_PACKET_SIZE) {
-        LOG_ERROR("[Feeding] buffer no space");
+    A2dpSbcFeedingState &state = a2dpSbcEncoderCb_.feedingState;
+    uint32_t frameBytes = a2dpSbcEncoderCb_.feedingParams.bitsPerSample / BIT_SBC_NUMBER_PER_SAMPLE *
+        a2dpSbcEncoderCb_.feedingParams.channelCount;
+    uint32_t space = static_cast<uint32_t>(FRAME_THREE * A2DP_SBC_MAX_PACKET_SIZE - a2dpSbcEncoderCb_.offsetPCM);
+    uint32_t expectedReadPcmData = std::min({state.bytesOwed, state.bytesPerTick * MAX_FEED_TICKS, space});
+    if (frameBytes != 0) {
+        expectedReadPcmData -= expectedReadPcmData % frameBytes;
+    }
+    state.bytesOwed -= expectedReadPcmData;
+    if (expectedReadPcmData == 0) {
+        LOG_INFO("[Feeding] no pcm due");
         return false;
     }
-    A2dpProfile *profile = GetProfileInstance(A2DP_ROLE_SOURCE);
-    uint32_t actualReadPcmData = profile->GetPcmData(&a2dpSbcEncoderCb_.pcmBuffer[a2dpSbcEncoderCb_.offsetPCM],
+    uint32_t actualReadPcmData = observer_->Read(&a2dpSbcEncoderCb_.pcmBuffer[a2dpSbcEncoderCb_.offsetPCM],
         expectedReadPcmData);
     LOG_INFO("[ReadA2dpSharedBuffer][expectedReadPcmData:%u][actualReadPcmData:%u]",
         expectedReadPcmData, actualReadPcmData);
@@ -352,19 +406,19 @@ void A2dpSbcEncoder::ConvertFreqParamToSBCParam(void)
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
     switch (encParams->samplingFreq) {
         case SBC_SAMPLE_RATE_16000:
-            g_sbcEncode.frequency = sbc::SBC_FREQ_16000;
+            sbcEncode_.frequency = sbc::SBC_FREQ_16000;
             break;
         case SBC_SAMPLE_RATE_32000:
-            g_sbcEncode.frequency = sbc::SBC_FREQ_32000;
+            sbcEncode_.frequency = sbc::SBC_FREQ_32000;
             break;
         case SBC_SAMPLE_RATE_44100:
-            g_sbcEncode.frequency = sbc::SBC_FREQ_44100;
+            sbcEncode_.frequency = sbc::SBC_FREQ_44100;
             break;
         case SBC_SAMPLE_RATE_48000:
-            g_sbcEncode.frequency = sbc::SBC_FREQ_48000;
+            sbcEncode_.frequency = sbc::SBC_FREQ_48000;
             break;
         default:
-            g_sbcEncode.frequency = sbc::SBC_FREQ_44100;
+            sbcEncode_.frequency = sbc::SBC_FREQ_44100;
             break;
     }
 }
@@ -375,19 +429,19 @@ void A2dpSbcEncoder::ConvertModeParamToSBCParam(void)
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
     switch (encParams->channelMode) {
         case SBC_MONO:
-            g_sbcEncode.channelMode = sbc::SBC_CHANNEL_MODE_MONO;
+            sbcEncode_.channelMode = sbc::SBC_CHANNEL_MODE_MONO;
             break;
         case SBC_DUAL:
-            g_sbcEncode.channelMode = sbc::SBC_CHANNEL_MODE_DUAL_CHANNEL;
+            sbcEncode_.channelMode = sbc::SBC_CHANNEL_MODE_DUAL_CHANNEL;
             break;
         case SBC_STEREO:
-            g_sbcEncode.channelMode = sbc::SBC_CHANNEL_MODE_STEREO;
+            sbcEncode_.channelMode = sbc::SBC_CHANNEL_MODE_STEREO;
             break;
         case SBC_JOINT_STEREO:
-            g_sbcEncode.channelMode = sbc::SBC_CHANNEL_MODE_JOINT_STEREO;
+            sbcEncode_.channelMode = sbc::SBC_CHANNEL_MODE_JOINT_STEREO;
             break;
         default:
-            g_sbcEncode.channelMode = sbc::SBC_CHANNEL_MODE_STEREO;
+            sbcEncode_.channelMode = sbc::SBC_CHANNEL_MODE_STEREO;
             break;
     }
 }
@@ -398,13 +452,13 @@ void A2dpSbcEncoder::ConvertSubbandsParamToSBCParam(void)
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
     switch (encParams->subBands) {
         case SBC_SUBBAND_4:
-            g_sbcEncode.subbands = sbc::SBC_SUBBAND4;
+            sbcEncode_.subbands = sbc::SBC_SUBBAND4;
             break;
         case SBC_SUBBAND_8:
-            g_sbcEncode.subbands = sbc::SBC_SUBBAND8;
+            sbcEncode_.subbands = sbc::SBC_SUBBAND8;
             break;
         default:
-            g_sbcEncode.subbands = sbc::SBC_SUBBAND8;
+            sbcEncode_.subbands = sbc::SBC_SUBBAND8;
             break;
     }
 }
@@ -415,19 +469,19 @@ void A2dpSbcEncoder::ConvertBlockParamToSBCParam(void)
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
     switch (encParams->numOfBlocks) {
         case SBC_BLOCKS_4:
-            g_sbcEncode.blocks = sbc::SBC_BLOCK4;
+            sbcEncode_.blocks = sbc::SBC_BLOCK4;
             break;
         case SBC_BLOCKS_8:
-            g_sbcEncode.blocks = sbc::SBC_BLOCK8;
+            sbcEncode_.blocks = sbc::SBC_BLOCK8;
             break;
         case SBC_BLOCKS_12:
-            g_sbcEncode.blocks = sbc::SBC_BLOCK12;
+            sbcEncode_.blocks = sbc::SBC_BLOCK12;
             break;
         case SBC_BLOCKS_16:
-            g_sbcEncode.blocks = sbc::SBC_BLOCK16;
+            sbcEncode_.blocks = sbc::SBC_BLOCK16;
             break;
         default:
-            g_sbcEncode.blocks = sbc::SBC_BLOCK16;
+            sbcEncode_.blocks = sbc::SBC_BLOCK16;
             break;
     }
 }
@@ -438,13 +492,13 @@ void A2dpSbcEncoder::ConvertAllocationParamToSBCParam(void)
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
     switch (encParams->allocationMethod) {
         case SBC_LOUDNESS:
-            g_sbcEncode.allocation = sbc::SBC_ALLOCATION_LOUDNESS;
+            sbcEncode_.allocation = sbc::SBC_ALLOCATION_LOUDNESS;
             break;
         case SBC_SNR:
-            g_sbcEncode.allocation = sbc::SBC_ALLOCATION_SNR;
+            sbcEncode_.allocation = sbc::SBC_ALLOCATION_SNR;
             break;
         default:
-            g_sbcEncode.allocation = sbc::SBC_ALLOCATION_LOUDNESS;
+            sbcEncode_.allocation = sbc::SBC_ALLOCATION_LOUDNESS;
             break;
     }
 }
@@ -453,7 +507,7 @@ void A2dpSbcEncoder::ConvertBitpoolParamToSBCParam(void)
 {
     LOG_INFO("[SbcEncoder] %{public}s\n", __func__);
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
-    g_sbcEncode.bitpool = encParams->bitPool;
+    sbcEncode_.bitpool = encParams->bitPool;
 }
 
 void A2dpSbcEncoder::CalculateSbcPCMRemain(uint16_t codecSize, uint32_t bytesNum, uint8_t *numOfFrame)
@@ -479,9 +533,9 @@ void A2dpSbcEncoder::A2dpSbcEncodeFrames(void)
     size_t encoded = 0;
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
     uint16_t blocksXsubbands = encParams->subBands * encParams->numOfBlocks;
-    uint16_t channelMode = (g_sbcEncode.channelMode == sbc::SBC_CHANNEL_MODE_MONO) ? CHANNEL_ONE : CHANNEL_TWO;
-    uint16_t subbands = g_sbcEncode.subbands ? SUBBAND8 : SUBBAND4;
-    const uint16_t blocks = SUBBAND4 + (g_sbcEncode.blocks * SUBBAND4);
+    uint16_t channelMode = (sbcEncode_.channelMode == sbc::SBC_CHANNEL_MODE_MONO) ? CHANNEL_ONE : CHANNEL_TWO;
+    uint16_t subbands = sbcEncode_.subbands ? SUBBAND8 : SUBBAND4;
+    const uint16_t blocks = SUBBAND4 + (sbcEncode_.blocks * SUBBAND4);
     uint16_t codecSize = subbands * blocks * channelMode * VALUE_TWO;
     Packet *pkt = PacketMalloc(A2DP_SBC_FRAGMENT_HEADER, 0, 0);
     uint32_t bytesNum = 0;
@@ -492,7 +546,7 @@ void A2dpSbcEncoder::A2dpSbcEncodeFrames(void)
         uint16_t pcmOffset = 0;
         while (numOfFrame) {
             uint8_t outputBuf[A2DP_SBC_HQ_DUAL_BP_53_FRAME_SIZE] = {};
-            int16_t outputLen = sbcEncoder_->SBCEncode(g_sbcEncode, &a2dpSbcEncoderCb_.pcmBuffer[pcmOffset],
+            int16_t outputLen = sbcEncoder_->SBCEncode(sbcEncode_, &a2dpSbcEncoderCb_.pcmBuffer[pcmOffset],
                 blocksXsubbands * channelMode, outputBuf, sizeof(outputBuf), &encoded);
             LOG_INFO("[SbcEncoder] %{public}s encoded %{public}zu, pcmOffset%{public}u\n",
                 __func__, encoded, pcmOffset);
@@ -541,8 +595,7 @@ void A2dpSbcEncoder::EnqueuePacket(
         Buffer *header = PacketHead(pkt);
         uint8_t *p = static_cast<uint8_t*>(BufferPtr(header));
         *p = frames;
-        A2dpProfile *profile = GetProfileInstance(A2DP_ROLE_SOURCE);
-        profile->EnqueuePacket(pkt, frames, bytes, timeStamp);  // Enqueue Packet.
+        observer_->EnqueuePacket(pkt, frames, bytes, timeStamp);  // Enqueue Packet.
     } else {
         EnqueuePacketFragment(pkt, frames, bytes, timeStamp, frameSize);
     }
@@ -551,6 +604,7 @@ void A2dpSbcEncoder::EnqueuePacket(
 void A2dpSbcEncoder::EnqueuePacketFragment(
     Packet *pkt, size_t frames, const uint32_t bytes, uint32_t timeStamp, const uint16_t frameSize) const
 {
+    (void)bytes;
     LOG_INFO("[SbcEncoder] %{public}s\n", __func__);
     uint8_t count = 1;
     uint32_t pktLen = 0;
@@ -602,8 +656,8 @@ void A2dpSbcEncoder::EnqueuePacketFragment(
 
             uint16_t encodePacketSize = PacketSize(mediaPacket);
             LOG_ERROR("[EnqueuePacket] encodePacketSize is ");
-            A2dpProfile *profile = GetProfileInstance(A2DP_ROLE_SOURCE);
-            profile->EnqueuePacket(mediaPacket, frameNum, encodePacketSize, timeStamp + sentFrameNum * blocksXsubbands);
+            observer_->EnqueuePacket(
+                mediaPacket, frameNum, encodePacketSize, timeStamp + sentFrameNum * blocksXsubbands);
             // Enqueue Packet.
             sentFrameNum += frameNum;
             PacketFree(mediaPacket);
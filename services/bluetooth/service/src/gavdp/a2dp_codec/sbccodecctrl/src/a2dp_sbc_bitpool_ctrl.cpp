@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../include/a2dp_sbc_bitpool_ctrl.h"
+#include <algorithm>
+#include "log.h"
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+// In encoder ticks of 20 ms.
+constexpr uint32_t BITPOOL_HOLD_TICKS = 3;
+constexpr uint32_t BITPOOL_RECOVER_TICKS = 25;
+constexpr uint32_t BITPOOL_RAMP_TICKS = 5;
+constexpr uint8_t BITPOOL_STEP_DOWN = 4;
+constexpr uint8_t BITPOOL_STEP_UP = 2;
+constexpr uint8_t BITPOOL_DROP_DIVISOR = 4;
+constexpr size_t QUEUE_HIGH_DIVISOR = 2;
+constexpr size_t QUEUE_HIGH_MIN = 2;
+constexpr size_t QUEUE_LOW = 1;
+}  // namespace
+
+void A2dpSbcBitpoolController::Reset(uint8_t minBitpool, uint8_t maxBitpool)
+{
+    minBitpool_ = std::min(minBitpool, maxBitpool);
+    maxBitpool_ = maxBitpool;
+    bitpool_ = maxBitpool;
+    holdTicks_ = 0;
+    clearTicks_ = 0;
+    stats_ = {};
+}
+
+uint8_t A2dpSbcBitpoolController::Update(const A2dpLinkSample &sample)
+{
+    if (holdTicks_ > 0) {
+        holdTicks_--;
+    }
+
+    if (sample.droppedPackets > 0) {
+        stats_.congestedTicks++;
+        clearTicks_ = 0;
+        Decrease(std::max<uint8_t>(BITPOOL_STEP_DOWN, bitpool_ / BITPOOL_DROP_DIVISOR));
+    } else if (IsCongested(sample)) {
+        stats_.congestedTicks++;
+        clearTicks_ = 0;
+        if (holdTicks_ == 0) {
+            Decrease(BITPOOL_STEP_DOWN);
+        }
+    } else if (IsClear(sample)) {
+        clearTicks_++;
+        if ((bitpool_ < maxBitpool_) && (clearTicks_ >= BITPOOL_RECOVER_TICKS) &&
+            ((clearTicks_ - BITPOOL_RECOVER_TICKS) % BITPOOL_RAMP_TICKS == 0)) {
+            bitpool_ = static_cast<uint8_t>(std::min<uint32_t>(bitpool_ + BITPOOL_STEP_UP, maxBitpool_));
+            stats_.increases++;
+            LOG_DEBUG("[SbcBitpool] %{public}s up to %{public}u\n", __func__, bitpool_);
+        }
+    } else {
+        clearTicks_ = 0;
+    }
+    return bitpool_;
+}
+
+bool A2dpSbcBitpoolController::IsCongested(const A2dpLinkSample &sample)
+{
+    size_t high = std::max(sample.queueLength / QUEUE_HIGH_DIVISOR, QUEUE_HIGH_MIN);
+    if (sample.queuedPackets >= high) {
+        return true;
+    }
+    if (!sample.aclValid) {
+        return false;
+    }
+    return (sample.waitingAclPackets > 0) ||
+        (sample.aclCreditsExhausted && (sample.inFlightAclPackets > 0) && (sample.completedAclPackets == 0));
+}
+
+bool A2dpSbcBitpoolController::IsClear(const A2dpLinkSample &sample)
+{
+    if (sample.queuedPackets > QUEUE_LOW) {
+        return false;
+    }
+    return !sample.aclValid || ((sample.waitingAclPackets == 0) && !sample.aclCreditsExhausted);
+}
+
+void A2dpSbcBitpoolController::Decrease(uint8_t step)
+{
+    uint8_t bitpool = (bitpool_ > minBitpool_ + step) ? static_cast<uint8_t>(bitpool_ - step) : minBitpool_;
+    if (bitpool != bitpool_) {
+        bitpool_ = bitpool;
+        stats_.decreases++;
+        LOG_DEBUG("[SbcBitpool] %{public}s down to %{public}u\n", __func__, bitpool_);
+    }
+    holdTicks_ = BITPOOL_HOLD_TICKS;
+}
+}  // namespace bluetooth
+}  // namespace OHOS
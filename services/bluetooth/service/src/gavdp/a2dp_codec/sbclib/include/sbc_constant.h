@@ -27,6 +27,10 @@ namespace sbc {
 #define SBC_MAX_PCM_BUFFER_SIZE \
     (SBC_MAX_NUM_OF_BLOCKS * SBC_MAX_NUM_OF_SUBBANDS * SBC_MAX_NUM_OF_CHANNELS)
 
+// mSBC (HFP wideband speech) fixes 16 kHz mono, 15 blocks, 8 subbands, loudness and bitpool 26.
+#define MSBC_BLOCKS 15
+#define MSBC_BITPOOL 26
+
 // Codec param
 typedef struct {
     uint8_t frequency;
@@ -36,6 +40,8 @@ typedef struct {
     uint8_t allocation;
     uint8_t bitpool;
     uint8_t endian;
+    // Non-zero for mSBC frames, the other fields are then ignored by the encoder.
+    uint8_t msbc;
 } CodecParam;
 
 // Errors
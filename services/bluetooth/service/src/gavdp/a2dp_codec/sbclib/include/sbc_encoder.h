@@ -37,6 +37,7 @@ private:
     static size_t CalculateFrameLength(const CodecParam& codecParam);
     static size_t CalculateCodecSize(const CodecParam& codecParam);
     void UpdateCodecFormat(const CodecParam& codecParam);
+    void UpdateMsbcFormat();
     void Analyze4SubbandsInternal(int16_t *x, int32_t *outData, int increseValue);
     void Analyze8SubbandsInternal(int16_t *x, int32_t *outData, int increseValue);
     static void AnalyzeFourForPolyphaseFilter(int32_t *temp, const int16_t *inData, const int16_t *consts);
@@ -49,11 +50,11 @@ private:
     void AnalyzeEightFunction(const int16_t *inData, int32_t *outData, const int16_t *consts) const;
     int Analyze4Subbands(int position, int16_t x[2][BUFFER_SIZE], Frame& frame, int increment);
     int Analyze8Subbands(int position, int16_t x[2][BUFFER_SIZE], Frame& frame, int increment);
-    void Get8SubbandSamplingPointInternal(const uint8_t* pcm, int16_t(*x)[BUFFER_SIZE],
+    void Get8SubbandSamplingPointInternal(const uint8_t*& pcm, int16_t(*x)[BUFFER_SIZE],
                                           int *samples, int channels, int bigEndian);
-    void Get8SubbandSamplingPoint16(const uint8_t* pcm, int16_t(*x)[BUFFER_SIZE],
+    void Get8SubbandSamplingPoint16(const uint8_t*& pcm, int16_t(*x)[BUFFER_SIZE],
                                     int *samples, int channels, int bigEndian);
-    void Get8SubbandSamplingPoint8(const uint8_t* pcm, int16_t(*x)[BUFFER_SIZE],
+    void Get8SubbandSamplingPoint8(const uint8_t*& pcm, int16_t(*x)[BUFFER_SIZE],
                                    int *samples, int channels, int bigEndian);
     int Get8SubbandSamplingPoint(const uint8_t* pcm, int16_t(*x)[BUFFER_SIZE],
                                  int *samples, int channels, int bigEndian);
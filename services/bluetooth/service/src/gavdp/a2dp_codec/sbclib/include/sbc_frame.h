@@ -44,6 +44,7 @@ public:
     int32_t samples_[16][2][8] {};
     uint16_t codeSize_ {};
     uint16_t length_ {};
+    bool msbc_ {};
 
     Frame();
     bool IsValid() const;
@@ -51,6 +52,7 @@ public:
     ssize_t Pack(uint8_t* bufStream, const Frame& frame, int joint);
 
 private:
+    int UnpackMsbc(const uint8_t* bufStream, size_t size);
     ssize_t PackFrameInternal(const Frame& frame, uint8_t* bufStream, int subbands, int channels, int joint);
     int UnpackFrameStream(Frame& frame, const uint8_t* bufStream, size_t len);
     void SbcCalculateBits(const Frame& frame, int (*bits)[8]);
@@ -33,6 +33,9 @@ const int NOT_JOINT_STEREO = 0;
 const int JOINT_STEREO = 1;
 
 const int INCREMENT_VALUE = 4;
+const int MSBC_INCREMENT_VALUE = 1;
+const uint16_t MSBC_CODE_SIZE = 240;
+const uint16_t MSBC_FRAME_LENGTH = 57;
 const int SCALE_OUT_BITS = 15;
 
 const int VALUE_0 = 0;
@@ -88,7 +91,7 @@ extern "C" void DestroyEncode(Encoder *p)
 void Encoder::Init(const Frame &frame)
 {
     (void)memset_s(x_, sizeof(x_), VALUE_0, sizeof(x_));
-    increment_ = INCREMENT_VALUE;
+    increment_ = frame.msbc_ ? MSBC_INCREMENT_VALUE : INCREMENT_VALUE;
     position_ = (BUFFER_SIZE - frame.subbands_ * VALUE_9) & ~VALUE_7;
 }
 
@@ -118,8 +121,32 @@ size_t Encoder::CalculateCodecSize(const CodecParam &codecParam)
     return subbands * blocks * channels * VALUE_2;
 }
 
+void Encoder::UpdateMsbcFormat()
+{
+    frame_.msbc_ = true;
+    frame_.frequency_ = SBC_FREQ_16000;
+    frame_.channelMode_ = SBC_CHANNEL_MODE_MONO;
+    frame_.channels_ = CHANNEL_1;
+    frame_.allocation_ = SBC_ALLOCATION_LOUDNESS;
+    frame_.subbandMode_ = SBC_SUBBAND8;
+    frame_.subbands_ = SUBBAND_8;
+    frame_.blockMode_ = SBC_BLOCK4;
+    frame_.blocks_ = MSBC_BLOCKS;
+    frame_.bitpool_ = MSBC_BITPOOL;
+    frame_.codeSize_ = MSBC_CODE_SIZE;
+    frame_.length_ = MSBC_FRAME_LENGTH;
+}
+
 void Encoder::UpdateCodecFormat(const CodecParam &codecParam)
 {
+    if (codecParam.msbc) {
+        if (!initialized_) {
+            UpdateMsbcFormat();
+            Init(frame_);
+            initialized_ = true;
+        }
+        return;
+    }
     if (!initialized_) {
         frame_.frequency_ = codecParam.frequency;
         frame_.channelMode_ = codecParam.channelMode;
@@ -384,6 +411,14 @@ int Encoder::Analyze8Subbands(int position, int16_t x[CHANNEL_NUM][BUFFER_SIZE],
     for (int ch = VALUE_0; ch < frame.channels_; ch++) {
         eightBandBuff = &x[ch][position - SUBBAND_8 * increment + frame.blocks_ * SUBBAND_8];
          for (int blk = VALUE_0; blk < frame.blocks_; blk += increment) {
+            if (increment == MSBC_INCREMENT_VALUE) {
+                // One block at a time, the odd/even tables follow the block's place in the X buffer.
+                bool odd = ((eightBandBuff - &x[ch][VALUE_0]) % VALUE_16) == VALUE_8;
+                AnalyzeEightFunction(eightBandBuff, frame.audioSamples_[blk][ch],
+                                     odd ? ANALYSIS_CONSTS_BAND8_ODD_MODE : ANALYSIS_CONSTS_BAND8_EVEN_MODE);
+                eightBandBuff -= SUBBAND_8;
+                continue;
+            }
             Analyze8SubbandsInternal(eightBandBuff, frame.audioSamples_[blk][ch],
                                      frame.audioSamples_[blk + VALUE_1][ch] - frame.audioSamples_[blk][ch]);
             eightBandBuff -= SUBBAND_8 * increment;
@@ -446,7 +481,7 @@ int Encoder::Get4SubbandSamplingPoint(const uint8_t *pcm, int16_t x[CHANNEL_NUM]
     return position_;
 }
 
-void Encoder::Get8SubbandSamplingPointInternal(const uint8_t *pcm, int16_t (*x)[BUFFER_SIZE],
+void Encoder::Get8SubbandSamplingPointInternal(const uint8_t *&pcm, int16_t (*x)[BUFFER_SIZE],
                                               int *samples, int channels, int bigEndian)
 {
 #define PCM(i) (bigEndian ? UnalignedBigEndian(pcm + (i) * VALUE_2) : UnalignedLittleEndian(pcm + (i) * VALUE_2))
@@ -482,7 +517,7 @@ void Encoder::Get8SubbandSamplingPointInternal(const uint8_t *pcm, int16_t (*x)[
 #undef PCM
 }
 
-void Encoder::Get8SubbandSamplingPoint16(const uint8_t *pcm, int16_t (*x)[BUFFER_SIZE],
+void Encoder::Get8SubbandSamplingPoint16(const uint8_t *&pcm, int16_t (*x)[BUFFER_SIZE],
                                          int *samples, int channels, int bigEndian)
 {
 #define PCM(i) (bigEndian ? UnalignedBigEndian(pcm + (i) * VALUE_2) : UnalignedLittleEndian(pcm + (i) * VALUE_2))
@@ -533,16 +568,18 @@ void Encoder::Get8SubbandSamplingPoint16(const uint8_t *pcm, int16_t (*x)[BUFFER
 #undef PCM
 }
 
-void Encoder::Get8SubbandSamplingPoint8(const uint8_t *pcm, int16_t (*x)[BUFFER_SIZE],
+void Encoder::Get8SubbandSamplingPoint8(const uint8_t *&pcm, int16_t (*x)[BUFFER_SIZE],
                                        int *samples, int channels, int bigEndian)
 {
 #define PCM(i) (bigEndian ? UnalignedBigEndian(pcm + (i) * VALUE_2) : UnalignedLittleEndian(pcm + (i) * VALUE_2))
 
     if (*samples == VALUE_8) {
+        // This block and the leading block of the next frame fill one 16-sample group between them, so its
+        // first sample lands in slot 1 of that group, 7 before the new position.
         position_ -= VALUE_8;
         if (channels > VALUE_0) {
             int16_t *eightBandBuffer = &x[VALUE_0][position_];
-            eightBandBuffer[-VALUE_7] = PCM(VALUE_0 + VALUE_7 * channels);
+            *(eightBandBuffer - VALUE_7) = PCM(VALUE_0 + VALUE_7 * channels);
             eightBandBuffer[VALUE_1]  = PCM(VALUE_0 + VALUE_3 * channels);
             eightBandBuffer[VALUE_2]  = PCM(VALUE_0 + VALUE_6 * channels);
             eightBandBuffer[VALUE_3]  = PCM(VALUE_0 + VALUE_0 * channels);
@@ -553,7 +590,7 @@ void Encoder::Get8SubbandSamplingPoint8(const uint8_t *pcm, int16_t (*x)[BUFFER_
         }
         if (channels > VALUE_1) {
             int16_t *eightBandBuffer = &x[VALUE_1][position_];
-            eightBandBuffer[-VALUE_7] = PCM(VALUE_1 + VALUE_7 * channels);
+            *(eightBandBuffer - VALUE_7) = PCM(VALUE_1 + VALUE_7 * channels);
             eightBandBuffer[VALUE_1]  = PCM(VALUE_1 + VALUE_3 * channels);
             eightBandBuffer[VALUE_2]  = PCM(VALUE_1 + VALUE_6 * channels);
             eightBandBuffer[VALUE_3]  = PCM(VALUE_1 + VALUE_0 * channels);
@@ -467,9 +467,16 @@ Frame::Frame() {}
 
 int Frame::Unpack(const uint8_t* bufStream, size_t size)
 {
-    if (size < MIN__HEADER_SIZE || bufStream[0] != SBC_SYNCWORD) {
+    if (size < MIN__HEADER_SIZE) {
         return SBC_ERROR_INVALID_ARG;
     }
+    if (bufStream[0] == MSBC_SYNCWORD) {
+        return UnpackMsbc(bufStream, size);
+    }
+    if (bufStream[0] != SBC_SYNCWORD) {
+        return SBC_ERROR_INVALID_ARG;
+    }
+    msbc_ = false;
     auto frame = std::make_unique<Frame>();
     frequency_ = (bufStream[1] >> MOVE_BIT6) & VALUE3;
     blockMode_ = (bufStream[1] >> MOVE_BIT4) & VALUE3;
@@ -515,6 +522,25 @@ int Frame::Unpack(const uint8_t* bufStream, size_t size)
     return UnpackFrameStream(*this, bufStream, size);
 }
 
+int Frame::UnpackMsbc(const uint8_t* bufStream, size_t size)
+{
+    // The mSBC header carries no parameters, the two reserved bytes must be zero.
+    if (bufStream[1] != 0 || bufStream[VALUE_OF_TWO] != 0) {
+        return SBC_ERROR_INVALID_FRAME;
+    }
+    msbc_ = true;
+    frequency_ = SBC_FREQ_16000;
+    blockMode_ = SBC_BLOCK4;
+    blocks_ = MSBC_BLOCKS;
+    channelMode_ = SBC_CHANNEL_MODE_MONO;
+    channels_ = CHANNEL_ONE;
+    allocation_ = SBC_ALLOCATION_LOUDNESS;
+    subbandMode_ = SBC_SUBBAND8;
+    subbands_ = SUBBAND_EIGHT;
+    bitpool_ = MSBC_BITPOOL;
+    return UnpackFrameStream(*this, bufStream, size);
+}
+
 bool Frame::IsValid() const
 {
     if (((channelMode_ == SBC_CHANNEL_MODE_MONO) || (channelMode_ == SBC_CHANNEL_MODE_DUAL_CHANNEL)) &&
@@ -622,6 +648,12 @@ ssize_t Frame::PackFrameInternal(const Frame& frame, uint8_t* bufStream,
 
 ssize_t Frame::Pack(uint8_t* bufStream, const Frame& frame, int joint)
 {
+    if (frame.msbc_) {
+        bufStream[0] = MSBC_SYNCWORD;
+        bufStream[1] = 0;
+        bufStream[VALUE_OF_TWO] = 0;
+        return PackFrameInternal(frame, bufStream, SUBBAND_EIGHT, CHANNEL_ONE, joint);
+    }
     bufStream[0] = SBC_SYNCWORD;
     bufStream[1] = (frame.frequency_ & VALUE3) << MOVE_BIT6;
     bufStream[1] |= (frame.blockMode_ & VALUE3) << MOVE_BIT4;
@@ -14,7 +14,7 @@
  */
 
 #include "a2dp_codec_thread.h"
-#include <sys/time.h>
+#include <ctime>
 #include "a2dp_decoder_aac.h"
 #include "a2dp_encoder_aac.h"
 #include "a2dp_decoder_sbc.h"
@@ -27,21 +27,92 @@ namespace bluetooth {
 const int ENCODE_TIMER_SBC = 20;
 const int ENCODE_TIMER_AAC = 25;
 #define PCM_DATA_ENCODED_TIMER(isSbc) ((isSbc) ? ENCODE_TIMER_SBC : ENCODE_TIMER_AAC)
+const uint64_t US_PER_MS = 1000;
+const uint64_t US_PER_SECOND = 1000000;
+const uint64_t NS_PER_US = 1000;
+
+static uint64_t MonotonicNowUs()
+{
+    struct timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * US_PER_SECOND + static_cast<uint64_t>(ts.tv_nsec) / NS_PER_US;
+}
+
+static uint32_t SinkSampleRate(const A2dpCodecConfig &config)
+{
+    uint32_t sampleRate = config.GetCodecConfig().sampleRate_;
+    switch (config.GetCodecIndex()) {
+        case A2DP_SINK_CODEC_INDEX_SBC:
+        case A2DP_SOURCE_CODEC_INDEX_SBC:
+            if (sampleRate & A2DP_SBC_SAMPLE_RATE_48000) {
+                return 48000;
+            } else if (sampleRate & A2DP_SBC_SAMPLE_RATE_32000) {
+                return 32000;
+            } else if (sampleRate & A2DP_SBC_SAMPLE_RATE_16000) {
+                return 16000;
+            }
+            return 44100;
+        default:
+            return (sampleRate & A2DP_AAC_SAMPLE_RATE_OCTET2_48000) ? 48000 : 44100;
+    }
+}
+
+static std::unique_ptr<A2dpEncoder> CreateSourceEncoder(
+    const A2dpEncoderInitPeerParams &peerParams, A2dpCodecConfig &config, A2dpEncoderObserver &observer)
+{
+    switch (config.GetCodecIndex()) {
+        case A2DP_SINK_CODEC_INDEX_SBC:
+        case A2DP_SOURCE_CODEC_INDEX_SBC:
+            return std::make_unique<A2dpSbcEncoder>(&peerParams, &config, &observer);
+        case A2DP_SOURCE_CODEC_INDEX_AAC:
+        case A2DP_SINK_CODEC_INDEX_AAC:
+            return std::make_unique<A2dpAacEncoder>(&peerParams, &config, &observer);
+        default:
+            return nullptr;
+    }
+}
+
+static uint32_t ReadSourcePcm(uint8_t *buf, uint32_t size)
+{
+    A2dpProfile *profile = GetProfileInstance(A2DP_ROLE_SOURCE);
+    return (profile != nullptr) ? profile->GetPcmData(buf, size) : 0;
+}
+
+static bool ReadSourceAclFlow(const BtAddr &addr, BtmAclFlowStatus &status)
+{
+    return BTM_GetAclFlowStatus(&addr, &status) == BT_SUCCESS;
+}
+
+static bool IsSourceStreaming(const BtAddr &addr)
+{
+    A2dpProfile *profile = GetProfileInstance(A2DP_ROLE_SOURCE);
+    A2dpProfilePeer *peer = (profile != nullptr) ? profile->FindPeerByAddress(addr) : nullptr;
+    return (peer != nullptr) && (peer->GetStateMachine()->GetStateName() == A2DP_PROFILE_STREAMING);
+}
 A2dpCodecThread *A2dpCodecThread::g_instance = nullptr;
 std::recursive_mutex g_codecMutex {};
 A2dpCodecThread::A2dpCodecThread(const std::string &name) : name_(name)
 {
     LOG_INFO("[A2dpCodecThread]%{public}s\n", __func__);
     dispatcher_ = std::make_unique<Dispatcher>(name);
+    sourceFanout_ = std::make_unique<A2dpSourceFanout>(
+        CreateSourceEncoder, ReadSourcePcm, MAX_PCM_FRAME_NUM_PER_TICK * FRAME_THREE);
+    sourceFanout_->SetLinkMonitor(ReadSourceAclFlow);
     auto callbackFunc = std::bind(&A2dpCodecThread::SignalingTimeoutCallback, this);
     signalingTimer_ = std::make_unique<utility::Timer>(callbackFunc);
+    sinkPlayoutTimer_ = std::make_unique<utility::Timer>([this]() {
+        utility::Message msg(A2DP_SINK_PLAYOUT, 0, nullptr);
+        A2dpEncoderInitPeerParams peerParams = {};
+        PostMessage(msg, peerParams, nullptr, nullptr);
+    });
 }
 
 A2dpCodecThread::~A2dpCodecThread()
 {
-    encoder_ = nullptr;
+    sourceFanout_ = nullptr;
     decoder_ = nullptr;
     signalingTimer_ = nullptr;
+    sinkPlayoutTimer_ = nullptr;
     dispatcher_ = nullptr;
     g_instance = nullptr;
     isSbc_ = false;
@@ -58,7 +129,7 @@ bool A2dpCodecThread::PostMessage(const utility::Message msg, const A2dpEncoderI
 
 A2dpCodecThread *A2dpCodecThread::GetInstance()
 {
-    LOG_INFO("[A2dpCodecThread]%{public}s\n", __func__);
+    LOG_DEBUG("[A2dpCodecThread]%{public}s\n", __func__);
     std::lock_guard<std::recursive_mutex> lock(g_codecMutex);
     if (g_instance == nullptr) {
         auto instance = std::make_unique<A2dpCodecThread>("a2dpCodec");
@@ -83,45 +154,45 @@ void A2dpCodecThread::StopA2dpCodecThread()
     if (signalingTimer_ != nullptr) {
         signalingTimer_->Stop();
     }
+    if (sinkPlayoutTimer_ != nullptr) {
+        sinkPlayoutTimer_->Stop();
+    }
     threadInit = false;
 }
 
 void A2dpCodecThread::ProcessMessage(utility::Message msg, const A2dpEncoderInitPeerParams &peerParams,
     A2dpCodecConfig *config, A2dpDecoderObserver *decObserver)
 {
-    LOG_INFO("[A2dpCodecThread]%{public}s msg is %{public}d\n", __func__, msg.what_);
-    struct timeval tv = {};
-    struct timezone tz = {};
-    gettimeofday(&tv, &tz);
+    LOG_DEBUG("[A2dpCodecThread]%{public}s msg is %{public}d\n", __func__, msg.what_);
     std::lock_guard<std::recursive_mutex> lock(g_codecMutex);
     switch (msg.what_) {
         case A2DP_AUDIO_RECONFIGURE:
-            if (encoder_ != nullptr) {
-                encoder_->UpdateEncoderParam();
-            }
+            sourceFanout_->Regroup();
             break;
         case A2DP_PCM_PUSH:
-            if (encoder_ != nullptr) {
-                encoder_->SendFrames(tv.tv_usec);
-            }
+            // The encoders read the PCM of the time really passed, the timer only sets the pace.
+            sourceFanout_->SendFrames(MonotonicNowUs());
+            break;
+        case A2DP_PCM_STOPPED:
+            SourceStopped();
             break;
         case A2DP_FRAME_READY:
             if (msg.arg2_ != nullptr && decoder_ != nullptr) {
-                decoder_->DecodePacket((uint8_t *)msg.arg2_, msg.arg1_);
-            }
-            if (msg.arg2_ != nullptr) {
-                free((uint8_t *)msg.arg2_);
+                sinkJitterBuffer_.Push(
+                    static_cast<Packet *>(msg.arg2_), static_cast<uint32_t>(msg.arg1_), MonotonicNowUs());
+                SinkPlayout();
+            } else if (msg.arg2_ != nullptr) {
+                PacketFree(static_cast<Packet *>(msg.arg2_));
             }
             break;
+        case A2DP_SINK_PLAYOUT:
+            SinkPlayout();
+            break;
         case A2DP_PCM_ENCODED:
-            if (config == nullptr) {
+            if ((config == nullptr) || (msg.arg2_ == nullptr)) {
                 return;
             }
-            if (encoder_ != nullptr) {
-                A2dpEncoder* encoder = encoder_.release();
-                delete encoder;
-            }
-            SourceEncode(peerParams, *config);
+            SourceEncode(*static_cast<BtAddr *>(msg.arg2_), peerParams, *config);
             break;
         case A2DP_FRAME_DECODED:
             if (config == nullptr) {
@@ -152,9 +223,7 @@ void A2dpCodecThread::StopTimer() const
     if (signalingTimer_ != nullptr) {
         signalingTimer_->Stop();
     }
-    if (encoder_ != nullptr) {
-        encoder_->ResetFeedingState();
-    }
+    sourceFanout_->ResetFeedingState();
 }
 
 bool A2dpCodecThread::GetInitStatus() const
@@ -166,38 +235,47 @@ bool A2dpCodecThread::GetInitStatus() const
 void A2dpCodecThread::GetRenderPosition(uint64_t &sendDataSize, uint32_t &timeStamp) const
 {
     LOG_INFO("[A2dpCodecThread]%{public}s\n", __func__);
-    if (encoder_ != nullptr) {
-        encoder_->GetRenderPosition(sendDataSize, timeStamp);
-    }
+    sourceFanout_->GetRenderPosition(sendDataSize, timeStamp);
+}
+
+A2dpSourceFanout *A2dpCodecThread::GetSourceFanout() const
+{
+    return sourceFanout_.get();
 }
 
 void A2dpCodecThread::SourceEncode(
-    const A2dpEncoderInitPeerParams &peerParams, const A2dpCodecConfig &config)
+    const BtAddr &addr, const A2dpEncoderInitPeerParams &peerParams, A2dpCodecConfig &config)
 {
     LOG_INFO("[A2dpCodecThread]%{public}s index:%u\n", __func__, config.GetCodecIndex());
     switch (config.GetCodecIndex()) {
         case A2DP_SINK_CODEC_INDEX_SBC:
         case A2DP_SOURCE_CODEC_INDEX_SBC:
             isSbc_ = true;
-            encoder_ = std::make_unique<A2dpSbcEncoder>(&const_cast<A2dpEncoderInitPeerParams &>(peerParams),
-                &const_cast<A2dpCodecConfig &>(config));
-            if (signalingTimer_ != nullptr) {
-                signalingTimer_->Stop();
-                signalingTimer_->Start(PCM_DATA_ENCODED_TIMER(isSbc_), true);
-            }
             break;
         case A2DP_SOURCE_CODEC_INDEX_AAC:
         case A2DP_SINK_CODEC_INDEX_AAC:
             isSbc_ = false;
-            encoder_ = std::make_unique<A2dpAacEncoder>(&const_cast<A2dpEncoderInitPeerParams &>(peerParams),
-                &const_cast<A2dpCodecConfig &>(config));
-            if (signalingTimer_ != nullptr) {
-                signalingTimer_->Stop();
-                signalingTimer_->Start(PCM_DATA_ENCODED_TIMER(isSbc_), true);
-            }
             break;
         default:
-            break;
+            return;
+    }
+    // Peers with the configuration of one already streaming share its encoder.
+    sourceFanout_->AddPeer(addr, peerParams, config);
+    if (signalingTimer_ != nullptr) {
+        signalingTimer_->Stop();
+        signalingTimer_->Start(PCM_DATA_ENCODED_TIMER(isSbc_), true);
+    }
+}
+
+void A2dpCodecThread::SourceStopped()
+{
+    for (const BtAddr &addr : sourceFanout_->GetPeers()) {
+        if (!IsSourceStreaming(addr)) {
+            sourceFanout_->RemovePeer(addr);
+        }
+    }
+    if (sourceFanout_->GetPeers().empty()) {
+        StopTimer();
     }
 }
 
@@ -211,6 +289,29 @@ void A2dpCodecThread::SignalingTimeoutCallback() const
     PostMessage(msg, peerParams, nullptr, nullptr);
 }
 
+void A2dpCodecThread::SinkPlayout()
+{
+    uint64_t nowUs = MonotonicNowUs();
+    Packet *packet = nullptr;
+    while ((packet = sinkJitterBuffer_.Pop(nowUs)) != nullptr) {
+        if (decoder_ != nullptr) {
+            decoder_->DecodePacket(packet);
+        }
+        PacketFree(packet);
+    }
+    uint64_t dueUs = sinkJitterBuffer_.NextDueUs();
+    if ((dueUs != UINT64_MAX) && (sinkPlayoutTimer_ != nullptr)) {
+        uint64_t waitMs = (dueUs > nowUs) ? (dueUs - nowUs + US_PER_MS - 1) / US_PER_MS : 1;
+        sinkPlayoutTimer_->Start(static_cast<int>(waitMs), false);
+    }
+}
+
+A2dpSinkJitterStats A2dpCodecThread::GetSinkJitterStats() const
+{
+    std::lock_guard<std::recursive_mutex> lock(g_codecMutex);
+    return sinkJitterBuffer_.GetStats();
+}
+
 void A2dpCodecThread::SinkDecode(const A2dpCodecConfig &config, A2dpDecoderObserver &observer)
 {
     LOG_INFO("[A2dpCodecThread]%{public}s index:%u\n", __func__, config.GetCodecIndex());
@@ -221,12 +322,14 @@ void A2dpCodecThread::SinkDecode(const A2dpCodecConfig &config, A2dpDecoderObser
             if (decoder_ == nullptr) {
                 decoder_ = std::make_unique<A2dpSbcDecoder>(&observer);
             }
+            sinkJitterBuffer_.Reset(SinkSampleRate(config));
             break;
         case A2DP_SOURCE_CODEC_INDEX_AAC:
         case A2DP_SINK_CODEC_INDEX_AAC:
             if (decoder_ == nullptr) {
                 decoder_ = std::make_unique<A2dpAacDecoder>(&observer);
             }
+            sinkJitterBuffer_.Reset(SinkSampleRate(config));
 
             break;
         default:
@@ -25,6 +25,8 @@
 #include "a2dp_codec/include/a2dp_codec_config.h"
 #include "a2dp_codec/include/a2dp_codec_constant.h"
 #include "a2dp_profile_peer.h"
+#include "a2dp_sink_jitter_buffer.h"
+#include "a2dp_source_fanout.h"
 #include "base_def.h"
 #include "dispatcher.h"
 #include "message.h"
@@ -39,6 +41,8 @@ constexpr int A2DP_PCM_ENCODED = 2;
 constexpr int A2DP_FRAME_DECODED = 3;
 constexpr int A2DP_FRAME_READY = 4;
 constexpr int A2DP_PCM_PUSH = 5;
+constexpr int A2DP_SINK_PLAYOUT = 6;
+constexpr int A2DP_PCM_STOPPED = 7;
 
 class A2dpCodecThread {
 public:
@@ -140,13 +144,34 @@ public:
      */
     void GetRenderPosition(uint64_t &sendDataSize, uint32_t &timeStamp) const;
 
+    /**
+     * @brief Get the counters of the sink jitter buffer.
+     * @return Packets received and played, underruns, overruns, late packets and the current delays.
+     * @since 6.0
+     */
+    A2dpSinkJitterStats GetSinkJitterStats() const;
+
+    /**
+     * @brief Get the encoders and packet queues of the streaming source peers.
+     * @return The fan-out, it locks itself.
+     * @since 6.0
+     */
+    A2dpSourceFanout *GetSourceFanout() const;
+
 private:
     /**
      * @brief Source side  encode
      *
      * @since 6.0
      */
-    void SourceEncode(const A2dpEncoderInitPeerParams &peerParams, const A2dpCodecConfig &config);
+    void SourceEncode(const BtAddr &addr, const A2dpEncoderInitPeerParams &peerParams, A2dpCodecConfig &config);
+
+    /**
+     * @brief Drop the source peers that left streaming, stop the timer when none is left
+     *
+     * @since 6.0
+     */
+    void SourceStopped();
 
     /**
      * @brief Source side  encode
@@ -162,11 +187,20 @@ private:
      */
     void SignalingTimeoutCallback() const;
 
+    /**
+     * @brief Decode every sink packet that is due and arm the timer for the next one
+     *
+     * @since 6.0
+     */
+    void SinkPlayout();
+
     std::string name_ {};
     std::unique_ptr<Dispatcher> dispatcher_ {};
-    std::unique_ptr<A2dpEncoder> encoder_ = nullptr;
+    std::unique_ptr<A2dpSourceFanout> sourceFanout_ = nullptr;
     std::unique_ptr<A2dpDecoder> decoder_ = nullptr;
     std::unique_ptr<utility::Timer> signalingTimer_ = nullptr;
+    std::unique_ptr<utility::Timer> sinkPlayoutTimer_ = nullptr;
+    A2dpSinkJitterBuffer sinkJitterBuffer_ {};
     static A2dpCodecThread *g_instance;
     bool threadInit = false;
     bool isSbc_ = false;
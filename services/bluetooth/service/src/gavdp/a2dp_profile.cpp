@@ -67,7 +67,6 @@ A2dpProfile::A2dpProfile(const uint8_t role)
     role_ = role;
     sdpInstance_.SetProfileRole(role_);
 
-    packetQueue_ = QueueCreate(MAX_PCM_FRAME_NUM_PER_TICK * FRAME_THREE);
     buffer_ = new A2dpSharedBuffer();
 }
 
@@ -78,10 +77,6 @@ A2dpProfile::~A2dpProfile()
     for (const auto &it : peers_) {
         delete it.second;
     }
-    if (packetQueue_ != nullptr) {
-        QueueDelete(packetQueue_, CleanPacketData);
-        packetQueue_ = nullptr;
-    }
     if (buffer_ != nullptr) {
         delete buffer_;
         buffer_ = nullptr;
@@ -202,12 +197,15 @@ void A2dpProfile::ConnectStateChangedNotify(const BtAddr &addr, const int state,
         case STREAM_CONNECT_FAILED:
         case STREAM_DISCONNECT:
             ResetDelayValue(addr);
+            // The encoder of the peer reads its codec config, drop it before the peer.
+            A2dpCodecThread::GetInstance()->GetSourceFanout()->RemovePeer(addr);
             DeletePeer(addr);
             if (IsActiveDevice(addr)) {
                 ClearActiveDevice();
             }
-            QueueFlush(packetQueue_, CleanPacketData);
-            buffer_->Reset();
+            if (A2dpCodecThread::GetInstance()->GetSourceFanout()->GetPeers().empty()) {
+                buffer_->Reset();
+            }
             break;
         case STREAM_CONNECT:
             SetActivePeer(addr);
@@ -372,52 +370,26 @@ void A2dpProfile::GetRenderPosition(uint32_t &delayValue, uint64_t &sendDataSize
 void A2dpProfile::DequeuePacket()
 {
     LOG_INFO("[A2dpProfile] %{public}s \n", __func__);
-    A2dpProfilePeer *peer = FindOrCreatePeer(activePeer_, A2DP_ROLE_SOURCE);
-    if (peer != nullptr) {
-        int32_t count = QueueGetSize(packetQueue_);
-        LOG_INFO("[A2dpProfile] %{public}s QueueTryDequeue starts, count %{public}d \n", __func__, count);
-        PacketData *packetData = (PacketData *)QueueTryDequeue(packetQueue_);
-        if (packetData == nullptr) {
-            LOG_ERROR("[A2dpProfile] %{public}s no data\n", __func__);
-            return;
-        }
-        count = QueueGetSize(packetQueue_);
-        LOG_INFO("[A2dpProfile] %{public}s  packetData is not null, QueueTryDequeue ends, count %{public}d\n",
-            __func__, count);
-        peer->SendPacket(packetData->packet, packetData->frames, packetData->bytes, packetData->pktTimeStamp);
-        PacketFree(packetData->packet);
-        free(packetData);
-        packetData = nullptr;
-    } else {
-        LOG_ERROR("[A2dpProfile] %{public}s no peer\n", __func__);
+    for (const BtAddr &addr : A2dpCodecThread::GetInstance()->GetSourceFanout()->GetPeers()) {
+        DequeuePacket(addr);
     }
 }
 
-void A2dpProfile::EnqueuePacket(const Packet *packet, size_t frames, uint32_t bytes, uint32_t pktTimeStamp)
+void A2dpProfile::DequeuePacket(const BtAddr &addr)
 {
-    Packet *refpkt = nullptr;
-    PacketData *packetData = nullptr;
-    int32_t count = QueueGetSize(packetQueue_);
-    LOG_INFO("[A2dpProfile] %{public}s, frame %{public}u, count %{public}d \n", __func__, bytes, count);
-    if (count >= MAX_PCM_FRAME_NUM_PER_TICK * FRAME_THREE) {
-        QueueFlush(packetQueue_, CleanPacketData);
-    }
-    count = QueueGetSize(packetQueue_);
-    LOG_INFO("[A2dpProfile] %{public}s, after flush count %{public}d \n", __func__, count);
-    refpkt = PacketRefMalloc((Packet *)packet);
-    packetData = (PacketData *)malloc(sizeof(PacketData));
-    if (packetData == nullptr) {
-        LOG_ERROR("[A2dpProfile] %{public}s, packetData is NULL\n", __func__);
+    A2dpProfilePeer *peer = FindPeerByAddress(addr);
+    if ((peer == nullptr) ||
+        (strcmp(A2DP_PROFILE_STREAMING.c_str(), peer->GetStateMachine()->GetStateName().c_str()) != 0)) {
+        LOG_ERROR("[A2dpProfile] %{public}s no streaming peer\n", __func__);
         return;
     }
-    packetData->packet = refpkt;
-    packetData->frames = frames;
-    packetData->bytes = bytes;
-    packetData->pktTimeStamp = pktTimeStamp;
-
-    QueueEnqueue(packetQueue_, (void *)packetData);
-    count = QueueGetSize(packetQueue_);
-    LOG_INFO("[A2dpProfile] %{public}s ends count %{public}d \n", __func__, count);
+    A2dpSourcePacket packet = {};
+    if (!A2dpCodecThread::GetInstance()->GetSourceFanout()->DequeuePacket(addr, packet)) {
+        LOG_ERROR("[A2dpProfile] %{public}s no data\n", __func__);
+        return;
+    }
+    peer->SendPacket(packet.packet, packet.frames, packet.bytes, packet.timeStamp);
+    PacketFree(packet.packet);
 }
 
 void A2dpProfile::CreateSEPConfigureInfo(uint8_t role)
@@ -559,7 +531,7 @@ void A2dpProfile::Disable()
     GetSDPInstance().UnregisterService();
     ClearNumberPeerDevice();
 
-    QueueFlush(packetQueue_, CleanPacketData);
+    A2dpCodecThread::GetInstance()->GetSourceFanout()->RemovePeers([](const BtAddr &) { return true; });
     buffer_->Reset();
 }
 
@@ -695,8 +667,10 @@ int A2dpProfile::Stop(const uint16_t handle, const bool suspend)
         ret = AVDT_ERR_UNSUPPORTED_COMMAND;
     }
 
-    QueueFlush(packetQueue_, CleanPacketData);
-    buffer_->Reset();
+    A2dpCodecThread::GetInstance()->GetSourceFanout()->RemovePeer(peer->GetPeerAddress());
+    if (A2dpCodecThread::GetInstance()->GetSourceFanout()->GetPeers().empty()) {
+        buffer_->Reset();
+    }
     return ret;
 }
 
@@ -1104,7 +1078,7 @@ void A2dpProfile::ProcessSignalingTimeoutCallback(const BtAddr &addr) const
 
 void ProcessSinkStream(uint16_t handle, Packet *pkt, uint32_t timeStamp, uint8_t pt, uint16_t streamHandle)
 {
-    LOG_INFO("[A2dpProfile]%{public}s  \n", __func__);
+    LOG_DEBUG("[A2dpProfile]%{public}s  \n", __func__);
 
     A2dpProfile *profile = GetProfileInstance(A2DP_ROLE_SINK);
     if (profile == nullptr) {
@@ -1127,25 +1101,14 @@ void ProcessSinkStream(uint16_t handle, Packet *pkt, uint32_t timeStamp, uint8_t
         return;
     }
 
-    uint16_t packetSize = PacketSize(pkt);
-    if (packetSize == 0) {
+    if (PacketSize(pkt) == 0) {
         return;
     }
-    auto frameData = (uint8_t *)malloc(packetSize);
-    if (frameData != nullptr) {
-        (void)memset_s(frameData, packetSize, 0, packetSize);
-        PacketRead(pkt, frameData, 0, packetSize);
-        A2dpEncoderInitPeerParams peerParams = {};
-        utility::Message msg(A2DP_FRAME_READY, packetSize, frameData);
-        codecThread->PostMessage(msg, peerParams, nullptr, nullptr);
-    }
-}
-
-void CleanPacketData(void *data)
-{
-    PacketData *packetData = (PacketData *)data;
-    PacketFree(packetData->packet);
-    free(packetData);
+    // The codec thread keeps a reference to the received buffers instead of a copy.
+    Packet *frame = PacketRefMalloc(pkt);
+    A2dpEncoderInitPeerParams peerParams = {};
+    utility::Message msg(A2DP_FRAME_READY, static_cast<int>(timeStamp), frame);
+    codecThread->PostMessage(msg, peerParams, nullptr, nullptr);
 }
 }  // namespace bluetooth
 }  // namespace OHOS
@@ -38,7 +38,6 @@
 #include "interface_profile_a2dp_src.h"
 #include "message.h"
 #include "a2dp_shared_buffer.h"
-#include "../../../stack/platform/include/queue.h"
 
 namespace OHOS {
 namespace bluetooth {
@@ -494,20 +493,17 @@ public:
     void GetRenderPosition(uint32_t &delayValue, uint64_t &sendDataSize, uint32_t &timeStamp);
 
     /**
-     * @brief Enqueue the frame packet to the packet queue.
-     * @param[in] packet Pointer of the packet
-     * @param[in] frames Number of frames
-     * @param[in] bytes Size of bytes
-     * @param[in] pktTimeStamp The current time stamp
+     * @brief Dequeue the next frame packet of every streaming peer to the peer.
      * @since 6.0
      */
-    void EnqueuePacket(const Packet *packet, size_t frames, uint32_t bytes, uint32_t pktTimeStamp);
+    void DequeuePacket();
 
     /**
-     * @brief Dequeue the frame packet to the peer.
+     * @brief Dequeue the next frame packet of a streaming peer to the peer.
+     * @param[in] addr The address of the peer
      * @since 6.0
      */
-    void DequeuePacket();
+    void DequeuePacket(const BtAddr &addr);
 
     /**
      * @brief Set the pcm data to the shared buffer.
@@ -623,7 +619,6 @@ private:
     ConfigureStream configureStream_ = {};
     A2dpSdpManager sdpInstance_ {};
     A2dpProfileObserver *a2dpSvcCBack_ {nullptr};
-    Queue *packetQueue_ = nullptr; // queue of packets to be sent
     A2dpSharedBuffer *buffer_ = nullptr;
     bool isDoDisable_ = false;
     uint16_t delayValue_ = 0;
@@ -639,20 +634,6 @@ private:
  * @since 6.0
  */
 void ProcessSinkStream(uint16_t handle, Packet *pkt, uint32_t timeStamp, uint8_t pt, uint16_t streamHandle);
-/**
- * @brief A function to clean packet data.
- *
- * @param[in] data The packet data to be deleted
- * @since 6.0
- */
-void CleanPacketData(void *data);
-
-struct PacketData {
-    Packet *packet;
-    size_t frames;
-    uint32_t bytes;
-    uint32_t pktTimeStamp;
-};
 }  // namespace bluetooth
 }  // namespace OHOS
 #endif  // A2DP_PROFILE_H
\ No newline at end of file
@@ -826,7 +826,7 @@ void A2dpProfilePeer::NotifyEncoder()
 {
     LOG_INFO("[A2dpProfilePeer]%{public}s \n", __func__);
     A2dpCodecThread *codecThread = A2dpCodecThread::GetInstance();
-    utility::Message msg(A2DP_PCM_ENCODED, localRole_, nullptr);
+    utility::Message msg(A2DP_PCM_ENCODED, localRole_, &peerAddress_);
     A2dpEncoderInitPeerParams peerParams = {};
     A2dpCodecConfig *config = nullptr;
 
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "a2dp_sink_jitter_buffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include "log.h"
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr uint64_t US_PER_SECOND = 1000000;
+constexpr uint64_t MIN_TARGET_DELAY_US = 40000;
+constexpr uint64_t MAX_TARGET_DELAY_US = 250000;
+constexpr double JITTER_GAIN = 1.0 / 16;
+constexpr double JITTER_TARGET_FACTOR = 4.0;
+constexpr size_t MAX_PACKETS = 128;
+constexpr uint32_t DEFAULT_SAMPLE_RATE = 44100;
+}  // namespace
+
+A2dpSinkJitterBuffer::A2dpSinkJitterBuffer()
+{
+    Reset(DEFAULT_SAMPLE_RATE);
+}
+
+A2dpSinkJitterBuffer::~A2dpSinkJitterBuffer()
+{
+    Clear();
+}
+
+void A2dpSinkJitterBuffer::Reset(uint32_t sampleRate)
+{
+    Clear();
+    sampleRate_ = (sampleRate != 0) ? sampleRate : DEFAULT_SAMPLE_RATE;
+    playing_ = false;
+    haveReference_ = false;
+    haveTransit_ = false;
+    jitterUs_ = 0;
+    packetSamples_ = 0;
+    stats_ = {};
+}
+
+void A2dpSinkJitterBuffer::Push(Packet *packet, uint32_t timeStamp, uint64_t nowUs)
+{
+    stats_.received++;
+    int64_t previous = referenceExtended_;
+    bool havePrevious = haveReference_;
+    int64_t extended = ExtendTimeStamp(timeStamp);
+
+    // RFC 3550 interarrival jitter, in microseconds rather than timestamp units.
+    int64_t transitUs = static_cast<int64_t>(nowUs) - static_cast<int64_t>(SamplesToUs(extended));
+    if (haveTransit_) {
+        double delta = std::fabs(static_cast<double>(transitUs - lastTransitUs_));
+        jitterUs_ += (delta - jitterUs_) * JITTER_GAIN;
+    }
+    haveTransit_ = true;
+    lastTransitUs_ = transitUs;
+    if (havePrevious && (extended > previous) && (extended - previous < static_cast<int64_t>(sampleRate_))) {
+        packetSamples_ = extended - previous;
+    }
+
+    if (playing_ && (extended < nextTimeStamp_)) {
+        stats_.late++;
+        PacketFree(packet);
+        return;
+    }
+    auto it = entries_.end();
+    while ((it != entries_.begin()) && (std::prev(it)->timeStamp > extended)) {
+        --it;
+    }
+    if ((it != entries_.begin()) && (std::prev(it)->timeStamp == extended)) {
+        stats_.late++;
+        PacketFree(packet);
+        return;
+    }
+    entries_.insert(it, Entry {packet, extended});
+
+    uint64_t limitUs = TargetDelayUs() * 2;
+    while ((entries_.size() > MAX_PACKETS) || ((entries_.size() > 1) && (DepthUs() > limitUs))) {
+        DropOldest();
+    }
+}
+
+Packet *A2dpSinkJitterBuffer::Pop(uint64_t nowUs)
+{
+    if (!playing_) {
+        if (entries_.empty() || (DepthUs() < TargetDelayUs())) {
+            return nullptr;
+        }
+        playing_ = true;
+        anchorUs_ = nowUs;
+        anchorTimeStamp_ = entries_.front().timeStamp;
+        nextTimeStamp_ = anchorTimeStamp_;
+    }
+    if (entries_.empty()) {
+        if (nowUs >= DueUs(nextTimeStamp_)) {
+            stats_.underruns++;
+            playing_ = false;
+            LOG_DEBUG("[A2dpSinkJitterBuffer]%{public}s underrun, jitter %{public}u us", __func__,
+                static_cast<uint32_t>(jitterUs_));
+        }
+        return nullptr;
+    }
+    const Entry &front = entries_.front();
+    if (DueUs(front.timeStamp) > nowUs) {
+        return nullptr;
+    }
+    Packet *packet = front.packet;
+    nextTimeStamp_ = front.timeStamp + packetSamples_;
+    entries_.pop_front();
+    stats_.played++;
+    return packet;
+}
+
+uint64_t A2dpSinkJitterBuffer::NextDueUs() const
+{
+    if (!playing_) {
+        return UINT64_MAX;
+    }
+    return entries_.empty() ? DueUs(nextTimeStamp_) : DueUs(entries_.front().timeStamp);
+}
+
+A2dpSinkJitterStats A2dpSinkJitterBuffer::GetStats() const
+{
+    A2dpSinkJitterStats stats = stats_;
+    stats.jitterUs = static_cast<uint32_t>(jitterUs_);
+    stats.targetDelayUs = static_cast<uint32_t>(TargetDelayUs());
+    stats.depthUs = static_cast<uint32_t>(DepthUs());
+    return stats;
+}
+
+int64_t A2dpSinkJitterBuffer::ExtendTimeStamp(uint32_t timeStamp)
+{
+    if (!haveReference_) {
+        haveReference_ = true;
+        referenceTimeStamp_ = timeStamp;
+        referenceExtended_ = timeStamp;
+        return referenceExtended_;
+    }
+    int64_t extended = referenceExtended_ + static_cast<int32_t>(timeStamp - referenceTimeStamp_);
+    if (extended > referenceExtended_) {
+        referenceTimeStamp_ = timeStamp;
+        referenceExtended_ = extended;
+    }
+    return extended;
+}
+
+uint64_t A2dpSinkJitterBuffer::SamplesToUs(int64_t samples) const
+{
+    return (samples <= 0) ? 0 : static_cast<uint64_t>(samples) * US_PER_SECOND / sampleRate_;
+}
+
+uint64_t A2dpSinkJitterBuffer::DueUs(int64_t timeStamp) const
+{
+    return anchorUs_ + SamplesToUs(timeStamp - anchorTimeStamp_);
+}
+
+uint64_t A2dpSinkJitterBuffer::DepthUs() const
+{
+    if (entries_.empty()) {
+        return 0;
+    }
+    return SamplesToUs(entries_.back().timeStamp - entries_.front().timeStamp + packetSamples_);
+}
+
+uint64_t A2dpSinkJitterBuffer::TargetDelayUs() const
+{
+    uint64_t target = static_cast<uint64_t>(jitterUs_ * JITTER_TARGET_FACTOR) + SamplesToUs(packetSamples_);
+    return std::clamp(target, MIN_TARGET_DELAY_US, MAX_TARGET_DELAY_US);
+}
+
+void A2dpSinkJitterBuffer::DropOldest()
+{
+    Entry oldest = entries_.front();
+    entries_.pop_front();
+    PacketFree(oldest.packet);
+    stats_.overruns++;
+    if (playing_) {
+        // The next packet takes the dropped one's slot, so the delay shrinks by what was dropped.
+        uint64_t dueUs = DueUs(std::max(oldest.timeStamp, nextTimeStamp_));
+        anchorUs_ = dueUs;
+        anchorTimeStamp_ = entries_.front().timeStamp;
+        nextTimeStamp_ = anchorTimeStamp_;
+    }
+}
+
+void A2dpSinkJitterBuffer::Clear()
+{
+    for (auto &entry : entries_) {
+        PacketFree(entry.packet);
+    }
+    entries_.clear();
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef A2DP_SINK_JITTER_BUFFER_H
+#define A2DP_SINK_JITTER_BUFFER_H
+#include <cstdint>
+#include <deque>
+#include "base_def.h"
+#include "packet.h"
+
+namespace OHOS {
+namespace bluetooth {
+struct A2dpSinkJitterStats {
+    uint64_t received = 0;
+    uint64_t played = 0;
+    uint64_t underruns = 0;
+    uint64_t overruns = 0;
+    uint64_t late = 0;
+    uint32_t jitterUs = 0;
+    uint32_t targetDelayUs = 0;
+    uint32_t depthUs = 0;
+};
+
+/**
+ * @brief Holds received media packets until their RTP timestamp is due.
+ *        Playout starts once the buffered audio covers the target delay. The target follows the interarrival
+ *        jitter estimate of RFC 3550, so a bursty link buffers more and a steady one less. A packet missing when it
+ *        is due is an underrun and playout buffers again; audio piling up past twice the target is an overrun and
+ *        the oldest packet is dropped.
+ */
+class A2dpSinkJitterBuffer {
+public:
+    A2dpSinkJitterBuffer();
+    ~A2dpSinkJitterBuffer();
+    void Reset(uint32_t sampleRate);
+    void Push(Packet *packet, uint32_t timeStamp, uint64_t nowUs);
+    Packet *Pop(uint64_t nowUs);
+    uint64_t NextDueUs() const;
+    A2dpSinkJitterStats GetStats() const;
+
+private:
+    struct Entry {
+        Packet *packet;
+        int64_t timeStamp;
+    };
+
+    int64_t ExtendTimeStamp(uint32_t timeStamp);
+    uint64_t SamplesToUs(int64_t samples) const;
+    uint64_t DueUs(int64_t timeStamp) const;
+    uint64_t DepthUs() const;
+    uint64_t TargetDelayUs() const;
+    void DropOldest();
+    void Clear();
+
+    std::deque<Entry> entries_ {};
+    uint32_t sampleRate_ = 0;
+    bool playing_ = false;
+    bool haveReference_ = false;
+    uint32_t referenceTimeStamp_ = 0;
+    int64_t referenceExtended_ = 0;
+    bool haveTransit_ = false;
+    int64_t lastTransitUs_ = 0;
+    double jitterUs_ = 0;
+    int64_t packetSamples_ = 0;
+    uint64_t anchorUs_ = 0;
+    int64_t anchorTimeStamp_ = 0;
+    int64_t nextTimeStamp_ = 0;
+    A2dpSinkJitterStats stats_ {};
+
+    BT_DISALLOW_COPY_AND_ASSIGN(A2dpSinkJitterBuffer);
+};
+}  // namespace bluetooth
+}  // namespace OHOS
+
+#endif  // A2DP_SINK_JITTER_BUFFER_H
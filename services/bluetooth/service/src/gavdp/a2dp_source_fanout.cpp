@@ -0,0 +1,329 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "a2dp_source_fanout.h"
+#include <algorithm>
+#include <cstring>
+#include "log.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr int BYTE_BITS = 8;
+
+bool SameAddress(const BtAddr &left, const BtAddr &right)
+{
+    return memcmp(left.addr, right.addr, sizeof(left.addr)) == 0;
+}
+}  // namespace
+
+uint32_t A2dpSourceFanout::Group::Read(uint8_t *buf, uint32_t size)
+{
+    return fanout.ReadPcm(buf, size);
+}
+
+void A2dpSourceFanout::Group::EnqueuePacket(const Packet *packet, size_t frames, uint32_t bytes, uint32_t timeStamp)
+{
+    for (Peer *peer : members) {
+        if (peer->queue.size() >= fanout.queueLength_) {
+            PacketFree(peer->queue.front().packet);
+            peer->queue.pop_front();
+            peer->stats.dropped++;
+        }
+        Packet *ref = PacketRefMalloc(packet);
+        if (ref == nullptr) {
+            peer->stats.dropped++;
+            continue;
+        }
+        peer->queue.push_back({ref, frames, bytes, timeStamp});
+        peer->stats.queued++;
+    }
+}
+
+A2dpSourceFanout::A2dpSourceFanout(EncoderFactory factory, PcmSource pcmSource, size_t queueLength)
+    : factory_(std::move(factory)), pcmSource_(std::move(pcmSource)), queueLength_(std::max<size_t>(queueLength, 1))
+{}
+
+A2dpSourceFanout::~A2dpSourceFanout()
+{
+    for (auto &peer : peers_) {
+        Flush(*peer);
+    }
+}
+
+void A2dpSourceFanout::SetLinkMonitor(LinkMonitor linkMonitor)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    linkMonitor_ = std::move(linkMonitor);
+}
+
+void A2dpSourceFanout::SetLinkAdaptation(bool enable)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    linkAdaptation_ = enable;
+}
+
+void A2dpSourceFanout::AddPeer(
+    const BtAddr &addr, const A2dpEncoderInitPeerParams &peerParams, A2dpCodecConfig &config)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Peer *peer = FindPeer(addr);
+    if (peer == nullptr) {
+        peers_.push_back(std::make_unique<Peer>());
+        peer = peers_.back().get();
+        peer->addr = addr;
+        peer->group = nullptr;
+        peer->lastDropped = 0;
+        peer->lastCompleted = 0;
+        peer->completedValid = false;
+    } else {
+        Leave(*peer);
+    }
+    peer->params = peerParams;
+    peer->config = &config;
+    Join(*peer);
+    LOG_INFO("[A2dpSourceFanout]%{public}s peers(%{public}zu) groups(%{public}zu)\n",
+        __func__, peers_.size(), groups_.size());
+}
+
+void A2dpSourceFanout::RemovePeer(const BtAddr &addr)
+{
+    RemovePeers([&addr](const BtAddr &peerAddr) { return SameAddress(peerAddr, addr); });
+}
+
+void A2dpSourceFanout::RemovePeers(const std::function<bool(const BtAddr &addr)> &match)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = peers_.begin(); it != peers_.end();) {
+        if (!match((*it)->addr)) {
+            it++;
+            continue;
+        }
+        Leave(**it);
+        Flush(**it);
+        it = peers_.erase(it);
+    }
+    LOG_INFO("[A2dpSourceFanout]%{public}s peers(%{public}zu) groups(%{public}zu)\n",
+        __func__, peers_.size(), groups_.size());
+}
+
+void A2dpSourceFanout::Regroup()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    groups_.clear();
+    for (auto &peer : peers_) {
+        peer->group = nullptr;
+    }
+    for (auto &peer : peers_) {
+        Join(*peer);
+    }
+}
+
+void A2dpSourceFanout::SendFrames(uint64_t timeStampUs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pcmLen_ = 0;
+    for (auto &group : groups_) {
+        if (linkAdaptation_) {
+            group->encoder->AdaptToLink(SampleLink(*group));
+        }
+        group->encoder->SendFrames(timeStampUs);
+    }
+}
+
+void A2dpSourceFanout::ResetFeedingState()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &group : groups_) {
+        group->encoder->ResetFeedingState();
+    }
+}
+
+bool A2dpSourceFanout::DequeuePacket(const BtAddr &addr, A2dpSourcePacket &packet)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Peer *peer = FindPeer(addr);
+    if ((peer == nullptr) || peer->queue.empty()) {
+        return false;
+    }
+    packet = peer->queue.front();
+    peer->queue.pop_front();
+    peer->stats.sent++;
+    return true;
+}
+
+std::vector<BtAddr> A2dpSourceFanout::GetPeers() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<BtAddr> addrs;
+    for (auto &peer : peers_) {
+        addrs.push_back(peer->addr);
+    }
+    return addrs;
+}
+
+size_t A2dpSourceFanout::GetGroupCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return groups_.size();
+}
+
+void A2dpSourceFanout::GetRenderPosition(uint64_t &sendDataSize, uint32_t &timeStamp) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!groups_.empty()) {
+        groups_.front()->encoder->GetRenderPosition(sendDataSize, timeStamp);
+    }
+}
+
+A2dpSourcePeerStats A2dpSourceFanout::GetPeerStats(const BtAddr &addr) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Peer *peer = FindPeer(addr);
+    return (peer != nullptr) ? peer->stats : A2dpSourcePeerStats {};
+}
+
+std::vector<uint8_t> A2dpSourceFanout::GroupKey(
+    const A2dpEncoderInitPeerParams &peerParams, const A2dpCodecConfig &config)
+{
+    uint8_t codecInfo[A2DP_CODEC_SIZE] = {};
+    (void)config.CopyOutOtaCodecConfig(codecInfo);
+    uint32_t bitsPerSample = config.GetAudioBitsPerSample();
+    std::vector<uint8_t> key(std::begin(codecInfo), std::end(codecInfo));
+    key.push_back(static_cast<uint8_t>(config.GetCodecIndex()));
+    key.push_back(static_cast<uint8_t>(bitsPerSample));
+    key.push_back(static_cast<uint8_t>(peerParams.isPeerEdr));
+    key.push_back(static_cast<uint8_t>(peerParams.peerSupports3mbps));
+    key.push_back(static_cast<uint8_t>(peerParams.peermtu));
+    key.push_back(static_cast<uint8_t>(peerParams.peermtu >> BYTE_BITS));
+    return key;
+}
+
+A2dpSourceFanout::Peer *A2dpSourceFanout::FindPeer(const BtAddr &addr) const
+{
+    for (auto &peer : peers_) {
+        if (SameAddress(peer->addr, addr)) {
+            return peer.get();
+        }
+    }
+    return nullptr;
+}
+
+void A2dpSourceFanout::Join(Peer &peer)
+{
+    std::vector<uint8_t> key = GroupKey(peer.params, *peer.config);
+    for (auto &group : groups_) {
+        if (group->key == key) {
+            group->members.push_back(&peer);
+            peer.group = group.get();
+            return;
+        }
+    }
+
+    auto group = std::make_unique<Group>(*this, key);
+    group->encoder = factory_(peer.params, *peer.config, *group);
+    if (group->encoder == nullptr) {
+        LOG_ERROR("[A2dpSourceFanout]%{public}s no encoder for codec(%{public}u)\n",
+            __func__, peer.config->GetCodecIndex());
+        return;
+    }
+    group->members.push_back(&peer);
+    peer.group = group.get();
+    groups_.push_back(std::move(group));
+}
+
+void A2dpSourceFanout::Leave(Peer &peer)
+{
+    Group *group = peer.group;
+    peer.group = nullptr;
+    if (group == nullptr) {
+        return;
+    }
+    bool owner = (group->members.front() == &peer);
+    group->members.erase(std::remove(group->members.begin(), group->members.end(), &peer), group->members.end());
+    if (group->members.empty()) {
+        groups_.erase(std::find_if(groups_.begin(), groups_.end(),
+            [group](const std::unique_ptr<Group> &item) { return item.get() == group; }));
+    } else if (owner) {
+        // The encoder holds the leaving peer's config, the next member's is the same configuration.
+        Peer *next = group->members.front();
+        group->encoder = factory_(next->params, *next->config, *group);
+        if (group->encoder == nullptr) {
+            for (Peer *member : group->members) {
+                member->group = nullptr;
+            }
+            groups_.erase(std::find_if(groups_.begin(), groups_.end(),
+                [group](const std::unique_ptr<Group> &item) { return item.get() == group; }));
+        }
+    }
+}
+
+void A2dpSourceFanout::Flush(Peer &peer) const
+{
+    for (auto &packet : peer.queue) {
+        PacketFree(packet.packet);
+    }
+    peer.queue.clear();
+}
+
+A2dpLinkSample A2dpSourceFanout::SampleLink(const Group &group)
+{
+    A2dpLinkSample sample {};
+    sample.queueLength = queueLength_;
+    bool firstCompleted = true;
+    for (Peer *peer : group.members) {
+        sample.queuedPackets = std::max(sample.queuedPackets, peer->queue.size());
+        sample.droppedPackets += static_cast<uint32_t>(peer->stats.dropped - peer->lastDropped);
+        peer->lastDropped = peer->stats.dropped;
+
+        BtmAclFlowStatus acl {};
+        if (!linkMonitor_ || !linkMonitor_(peer->addr, acl)) {
+            peer->completedValid = false;
+            continue;
+        }
+        sample.aclValid = true;
+        sample.waitingAclPackets = std::max<uint32_t>(sample.waitingAclPackets, acl.waitingPackets);
+        if (peer->completedValid) {
+            // Exhausted buffers only count with the completions of a whole tick to weigh them against.
+            uint32_t completed = acl.completedPackets - peer->lastCompleted;
+            sample.completedAclPackets =
+                firstCompleted ? completed : std::min(sample.completedAclPackets, completed);
+            sample.inFlightAclPackets = std::max<uint32_t>(sample.inFlightAclPackets, acl.inFlightPackets);
+            sample.aclCreditsExhausted = sample.aclCreditsExhausted || (acl.freePackets == 0);
+            firstCompleted = false;
+        }
+        peer->lastCompleted = acl.completedPackets;
+        peer->completedValid = true;
+    }
+    return sample;
+}
+
+uint32_t A2dpSourceFanout::ReadPcm(uint8_t *buf, uint32_t size)
+{
+    if (size > pcmLen_) {
+        if (pcm_.size() < size) {
+            pcm_.resize(size);
+        }
+        pcmLen_ += pcmSource_(pcm_.data() + pcmLen_, size - pcmLen_);
+    }
+    uint32_t len = std::min(size, pcmLen_);
+    if ((len > 0) && (memcpy_s(buf, size, pcm_.data(), len) != EOK)) {
+        return 0;
+    }
+    return len;
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef A2DP_SOURCE_FANOUT_H
+#define A2DP_SOURCE_FANOUT_H
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "a2dp_codec/include/a2dp_codec_config.h"
+#include "a2dp_codec/include/a2dp_codec_constant.h"
+#include "a2dp_codec/include/a2dp_codec_wrapper.h"
+#include "base_def.h"
+#include "btm.h"
+#include "btstack.h"
+#include "packet.h"
+
+namespace OHOS {
+namespace bluetooth {
+struct A2dpSourcePacket {
+    Packet *packet;
+    size_t frames;
+    uint32_t bytes;
+    uint32_t timeStamp;
+};
+
+struct A2dpSourcePeerStats {
+    uint64_t queued = 0;
+    uint64_t sent = 0;
+    uint64_t dropped = 0;
+};
+
+/**
+ * @brief Encodes the source PCM once for every negotiated configuration and hands the frames to each sink using it.
+ *        Streaming peers are grouped by codec configuration, bits per sample and link (EDR, 3 Mbps, MTU), as those
+ *        decide the encoded packets. Each group owns one encoder; its packets are shared into the queues of the
+ *        group's peers with PacketRefMalloc, so AVDTP adds every peer's own RTP header around the same payload.
+ *        Each peer drains its queue at its own pace, a full queue drops that peer's oldest packet only.
+ *        All groups of one tick read the same PCM; a group asking for more than another reads on from it.
+ *        Before each tick every encoder gets the transmit state of its most congested peer: queue depth, drops and,
+ *        from the link monitor, the ACL buffers of the connection.
+ */
+class A2dpSourceFanout {
+public:
+    using EncoderFactory = std::function<std::unique_ptr<A2dpEncoder>(
+        const A2dpEncoderInitPeerParams &peerParams, A2dpCodecConfig &config, A2dpEncoderObserver &observer)>;
+    using PcmSource = std::function<uint32_t(uint8_t *buf, uint32_t size)>;
+    using LinkMonitor = std::function<bool(const BtAddr &addr, BtmAclFlowStatus &status)>;
+
+    A2dpSourceFanout(EncoderFactory factory, PcmSource pcmSource, size_t queueLength);
+    ~A2dpSourceFanout();
+    void SetLinkMonitor(LinkMonitor linkMonitor);
+    // With adaptation off the encoders keep the rate they were configured with.
+    void SetLinkAdaptation(bool enable);
+    void AddPeer(const BtAddr &addr, const A2dpEncoderInitPeerParams &peerParams, A2dpCodecConfig &config);
+    void RemovePeer(const BtAddr &addr);
+    void RemovePeers(const std::function<bool(const BtAddr &addr)> &match);
+    void Regroup();
+    void SendFrames(uint64_t timeStampUs);
+    void ResetFeedingState();
+    bool DequeuePacket(const BtAddr &addr, A2dpSourcePacket &packet);
+    std::vector<BtAddr> GetPeers() const;
+    size_t GetGroupCount() const;
+    void GetRenderPosition(uint64_t &sendDataSize, uint32_t &timeStamp) const;
+    A2dpSourcePeerStats GetPeerStats(const BtAddr &addr) const;
+
+private:
+    struct Group;
+
+    struct Peer {
+        BtAddr addr;
+        A2dpEncoderInitPeerParams params;
+        A2dpCodecConfig *config;
+        Group *group;
+        std::deque<A2dpSourcePacket> queue;
+        A2dpSourcePeerStats stats;
+        // Counters seen at the last tick, the link sample carries what changed since.
+        uint64_t lastDropped;
+        uint32_t lastCompleted;
+        bool completedValid;
+    };
+
+    struct Group : public A2dpEncoderObserver {
+        Group(A2dpSourceFanout &fanout, const std::vector<uint8_t> &key) : fanout(fanout), key(key)
+        {}
+        uint32_t Read(uint8_t *buf, uint32_t size) override;
+        void EnqueuePacket(const Packet *packet, size_t frames, uint32_t bytes, uint32_t timeStamp) override;
+
+        A2dpSourceFanout &fanout;
+        std::vector<uint8_t> key;
+        // The encoder reads the config of the first member.
+        std::unique_ptr<A2dpEncoder> encoder;
+        std::vector<Peer *> members;
+    };
+
+    static std::vector<uint8_t> GroupKey(const A2dpEncoderInitPeerParams &peerParams, const A2dpCodecConfig &config);
+    Peer *FindPeer(const BtAddr &addr) const;
+    void Join(Peer &peer);
+    void Leave(Peer &peer);
+    void Flush(Peer &peer) const;
+    A2dpLinkSample SampleLink(const Group &group);
+    uint32_t ReadPcm(uint8_t *buf, uint32_t size);
+
+    EncoderFactory factory_;
+    PcmSource pcmSource_;
+    LinkMonitor linkMonitor_ {};
+    bool linkAdaptation_ = true;
+    size_t queueLength_ = 0;
+    std::vector<std::unique_ptr<Peer>> peers_ {};
+    std::vector<std::unique_ptr<Group>> groups_ {};
+    // PCM of the current tick, read from the source once and given to every group.
+    std::vector<uint8_t> pcm_ {};
+    uint32_t pcmLen_ = 0;
+    mutable std::mutex mutex_ {};
+
+    BT_DISALLOW_COPY_AND_ASSIGN(A2dpSourceFanout);
+};
+}  // namespace bluetooth
+}  // namespace OHOS
+
+#endif  // A2DP_SOURCE_FANOUT_H
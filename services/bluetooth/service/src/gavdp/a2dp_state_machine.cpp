@@ -902,7 +902,10 @@ void A2dpStateStreaming::Exit()
     LOG_INFO("[A2dpStateStreaming]%{public}s\n", __func__);
     A2dpCodecThread *codecThread = A2dpCodecThread::GetInstance();
     if (codecThread->GetInitStatus()) {
-        codecThread->StopTimer();
+        // Other peers may stream on; the codec thread checks once this transition is done.
+        utility::Message msg(A2DP_PCM_STOPPED, 0, nullptr);
+        A2dpEncoderInitPeerParams peerParams = {};
+        codecThread->PostMessage(msg, peerParams, nullptr, nullptr);
     }
 }
 
@@ -1094,7 +1097,7 @@ void A2dpStateStreaming::ProcessWriteCfm(A2dpAvdtMsgData msgData, uint8_t role)
 {
     LOG_INFO("[A2dpStateStreaming]%{public}s\n", __func__);
     A2dpProfile *profile = GetProfileInstance(A2DP_ROLE_SOURCE);
-    profile->DequeuePacket();
+    profile->DequeuePacket(msgData.stream.addr);
 }
 
 void A2dpStateStreaming::ProcessDisconnectReq(BtAddr addr, uint8_t role)
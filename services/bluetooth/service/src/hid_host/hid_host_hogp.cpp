@@ -15,6 +15,7 @@
 
 #include "hid_host_hogp.h"
 #include "hid_host_service.h"
+#include "hid_host_uhid.h"
 
 namespace OHOS {
 namespace bluetooth {
@@ -29,6 +30,7 @@ HidHostHogp::HidHostHogp(const std::string &address) : address_(address)
 
 HidHostHogp::~HidHostHogp()
 {
+    SetUhid(nullptr);
     DeregisterGattClientApplication();
     dispatcher_->Uninitialize();
     dispatcher_ = nullptr;
@@ -666,6 +668,12 @@ void HidHostHogp::SetInputReportNotification()
     }
 }
 
+void HidHostHogp::SetUhid(HidHostUhid *uhid)
+{
+    std::lock_guard<std::mutex> lock(uhidMutex_);
+    uhid_ = uhid;
+}
+
 void HidHostHogp::ProcessEvent(const HidHostMessage &event)
 {
     LOG_DEBUG("[HOGP]%{public}s(): event %{public}s[%{public}d]",
@@ -758,6 +766,19 @@ void HidHostHogp::HogpGattClientCallback::OnCharacteristicChanged(const Characte
     }
 
     if ((characteristic.value_ != nullptr) && (characteristic.length_ != 0)) {
+        // Input reports go from the GATT callback to the uhid writer thread without a service thread hop.
+        if ((hogp_->uhid_ != nullptr) && (characteristic.length_ + 1 <= HID_HOST_INPUT_REPORT_MAX)) {
+            // Holding the mutex keeps the uhid device from being cleared and destroyed under the push.
+            std::lock_guard<std::mutex> lock(hogp_->uhidMutex_);
+            HidHostUhid *uhid = hogp_->uhid_;
+            if (uhid != nullptr) {
+                if (uhid->SendInputReport(reportId, characteristic.value_.get(), characteristic.length_) !=
+                    HID_HOST_SUCCESS) {
+                    LOG_WARN("[HOGP]%{public}s():input report dropped", __FUNCTION__);
+                }
+                return;
+            }
+        }
         HidHostMessage event(HID_HOST_INT_DATA_EVT);
         event.dev_ = hogp_->address_;
         int offset = 0;
@@ -16,6 +16,7 @@
 #ifndef HID_HOST_HOGP_H
 #define HID_HOST_HOGP_H
 
+#include <atomic>
 #include <map>
 
 #include "dispatcher.h"
@@ -30,6 +31,7 @@
 namespace OHOS {
 namespace bluetooth {
 using utility::Dispatcher;
+class HidHostUhid;
 
 class HidHostHogp {
 public:
@@ -50,6 +52,13 @@ public:
     PnpInformation& GetRemotePnpInfo();
     HidInformation& GetRemoteHidInfo();
     void ProcessEvent(const HidHostMessage &event);
+    /**
+     * @brief Send input report notifications straight to this uhid device instead of the service thread.
+     *        Passing nullptr returns only once no report is being pushed to the previous device, so the caller
+     *        may then close and destroy it.
+     *
+     */
+    void SetUhid(HidHostUhid *uhid);
     static std::string GetEventName(int what);
 
 private:
@@ -84,6 +93,9 @@ private:
     std::unique_ptr<Descriptor> descriptorTemp_ = nullptr;
     std::map<uint16_t, std::unique_ptr<HogpReport>> reports_ {};
     std::unique_ptr<Dispatcher> dispatcher_ {};
+    // Written on the service thread, read on the GATT callback thread under uhidMutex_.
+    std::atomic<HidHostUhid *> uhid_ {nullptr};
+    std::mutex uhidMutex_ {};
 
     IProfileGattClient *GetGattClientService();
     int DiscoverStart();
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hid_host_input_writer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+#include "log.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace bluetooth {
+static_assert(offsetof(struct uhid_event, u.input2.data) == sizeof(uint32_t) + sizeof(uint16_t),
+    "InputFrame must match the UHID_INPUT2 layout of struct uhid_event");
+
+HidHostInputWriter::HidHostInputWriter() : ring_(HID_HOST_INPUT_RING_SIZE)
+{}
+
+HidHostInputWriter::~HidHostInputWriter()
+{
+    Stop();
+}
+
+int HidHostInputWriter::Start(int fd)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return fd == fd_ ? 0 : -1;
+    }
+    ring_.Clear();
+    fd_ = fd;
+    ready_ = false;
+    running_ = true;
+    thread_ = std::make_unique<std::thread>(&HidHostInputWriter::WriterThread, this);
+    return 0;
+}
+
+void HidHostInputWriter::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+        ready_ = false;
+    }
+    cv_.notify_all();
+    thread_->join();
+    thread_ = nullptr;
+    ring_.Clear();
+    fd_ = -1;
+}
+
+void HidHostInputWriter::SetReady(bool ready)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready_ = ready;
+    }
+    cv_.notify_all();
+}
+
+bool HidHostInputWriter::WaitReady(int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return ready_ || !running_; }) &&
+        ready_;
+}
+
+int HidHostInputWriter::Push(uint8_t reportId, const uint8_t *data, size_t length)
+{
+    size_t offset = (reportId != 0) ? 1 : 0;
+    if (!running_ || (length + offset > HID_HOST_INPUT_REPORT_MAX)) {
+        dropped_++;
+        return -1;
+    }
+    InputSlot *slot = ring_.Claim();
+    if (slot == nullptr) {
+        dropped_++;
+        return -1;
+    }
+    slot->frame.type = UHID_INPUT2;
+    slot->frame.size = static_cast<uint16_t>(length + offset);
+    slot->frame.data[0] = reportId;
+    if (memcpy_s(slot->frame.data + offset, sizeof(slot->frame.data) - offset, data, length) != EOK) {
+        dropped_++;
+        return -1;
+    }
+    slot->enqueueNs = NowNs();
+    ring_.Publish();
+
+    // Taking the mutex orders the publish against the writer's check before it sleeps.
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    cv_.notify_one();
+    return 0;
+}
+
+HidHostInputLatency HidHostInputWriter::GetLatency()
+{
+    HidHostInputLatency latency;
+    std::vector<uint32_t> samples;
+    {
+        std::lock_guard<std::mutex> lock(latencyMutex_);
+        latency.reports = reports_;
+        size_t count = std::min<uint64_t>(reports_, HID_HOST_INPUT_LATENCY_SAMPLES);
+        samples.assign(latencyUs_, latencyUs_ + count);
+    }
+    latency.dropped = dropped_;
+    if (samples.empty()) {
+        return latency;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](size_t percent) { return samples[(samples.size() - 1) * percent / 100]; };
+    latency.p50Us = percentile(50);
+    latency.p90Us = percentile(90);
+    latency.p99Us = percentile(99);
+    latency.maxUs = samples.back();
+    return latency;
+}
+
+void HidHostInputWriter::WriterThread()
+{
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return !running_ || (ready_ && ring_.Peek() != nullptr); });
+            if (!running_) {
+                return;
+            }
+        }
+        InputSlot *slot = nullptr;
+        while (ready_ && ((slot = ring_.Peek()) != nullptr)) {
+            WriteFrame(*slot);
+            ring_.Release();
+        }
+    }
+}
+
+void HidHostInputWriter::WriteFrame(const InputSlot &slot)
+{
+    uint64_t waitedNs = NowNs() - slot.enqueueNs;
+    if (waitedNs > HID_HOST_INPUT_STALE_NS) {
+        dropped_++;
+        LOG_WARN("[UHID]%{public}s(): drop report queued %{public}llu us", __FUNCTION__,
+            static_cast<unsigned long long>(waitedNs / 1000));
+        return;
+    }
+
+    size_t length = offsetof(InputFrame, data) + slot.frame.size;
+    ssize_t ret;
+    do {
+    } while ((ret = write(fd_, &slot.frame, length)) == -1 && errno == EINTR);
+    if (ret != static_cast<ssize_t>(length)) {
+        dropped_++;
+        LOG_ERROR("[UHID]%{public}s(): Cannot write to uhid:%{public}s", __FUNCTION__, strerror(errno));
+        return;
+    }
+
+    uint64_t latencyUs = (NowNs() - slot.enqueueNs) / 1000;
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    latencyUs_[reports_ % HID_HOST_INPUT_LATENCY_SAMPLES] =
+        static_cast<uint32_t>(std::min<uint64_t>(latencyUs, UINT32_MAX));
+    reports_++;
+}
+
+uint64_t HidHostInputWriter::NowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+}  // namespace bluetooth
+}  // namespace OHOS
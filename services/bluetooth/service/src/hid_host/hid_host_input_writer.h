@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HID_HOST_INPUT_WRITER_H
+#define HID_HOST_INPUT_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <linux/uhid.h>
+#include "base_def.h"
+#include "spsc_ring.h"
+
+namespace OHOS {
+namespace bluetooth {
+// Largest GATT attribute value plus the report id byte.
+static constexpr uint16_t HID_HOST_INPUT_REPORT_MAX = 513;
+static constexpr size_t HID_HOST_INPUT_RING_SIZE = 64;
+static constexpr size_t HID_HOST_INPUT_LATENCY_SAMPLES = 1024;
+// Reports still waiting for uhid to become ready after this long are dropped, as the old polling wait did.
+static constexpr uint64_t HID_HOST_INPUT_STALE_NS = 50 * 1000 * 1000;
+
+/**
+ * @brief Report-to-uhid latency of the input reports written so far, in microseconds.
+ */
+struct HidHostInputLatency {
+    uint64_t reports = 0;
+    uint64_t dropped = 0;
+    uint32_t p50Us = 0;
+    uint32_t p90Us = 0;
+    uint32_t p99Us = 0;
+    uint32_t maxUs = 0;
+};
+
+/**
+ * @brief Writes input reports to uhid on its own thread.
+ *        One thread pushes reports into a preallocated ring, already laid out as UHID_INPUT2 events, and the
+ *        writer thread sends each one with a write trimmed to the report length.
+ */
+class HidHostInputWriter {
+public:
+    HidHostInputWriter();
+    ~HidHostInputWriter();
+
+    int Start(int fd);
+    void Stop();
+    void SetReady(bool ready);
+    bool WaitReady(int timeoutMs);
+    int Push(uint8_t reportId, const uint8_t *data, size_t length);
+    HidHostInputLatency GetLatency();
+
+private:
+    // Same layout as the type and u.input2 members of struct uhid_event.
+    struct __attribute__((packed)) InputFrame {
+        uint32_t type;
+        uint16_t size;
+        uint8_t data[HID_HOST_INPUT_REPORT_MAX];
+    };
+    struct InputSlot {
+        uint64_t enqueueNs;
+        InputFrame frame;
+    };
+
+    void WriterThread();
+    void WriteFrame(const InputSlot &slot);
+    static uint64_t NowNs();
+
+    int fd_ = -1;
+    std::atomic<bool> running_ {false};
+    std::atomic<bool> ready_ {false};
+    std::mutex mutex_ {};
+    std::condition_variable cv_ {};
+    std::unique_ptr<std::thread> thread_ {};
+    utility::SpscRing<InputSlot> ring_;
+    std::atomic<uint64_t> dropped_ {0};
+
+    std::mutex latencyMutex_ {};
+    uint64_t reports_ = 0;
+    uint32_t latencyUs_[HID_HOST_INPUT_LATENCY_SAMPLES] = {};
+
+    BT_DISALLOW_COPY_AND_ASSIGN(HidHostInputWriter);
+};
+}  // namespace bluetooth
+}  // namespace OHOS
+#endif  // HID_HOST_INPUT_WRITER_H
@@ -643,6 +643,9 @@ void HidHostStateMachine::ProcessBleCloseDeviceReq(const HidHostMessage &msg)
 
 void HidHostStateMachine::ProcessBleCloseDevice(const HidHostMessage &msg)
 {
+    if (hogp_ != nullptr) {
+        hogp_->SetUhid(nullptr);
+    }
     uhid_.Close();
     uhid_.Destroy();
 }
@@ -686,7 +689,9 @@ void HidHostStateMachine::ProcessBleOpenComplete(const HidHostMessage &msg)
         __FUNCTION__, cachedName, pnpInf.vendorId, pnpInf.productId);
     LOG_INFO("[HIDH Machine]%{public}s():version[%{public}d],ctryCode[%{public}d],descLength[%{public}d]",
         __FUNCTION__, pnpInf.version, hidInf.ctryCode, hidInf.descLength);
-    uhid_.SendHidInfo(cachedName, pnpInf, hidInf);
+    if (uhid_.SendHidInfo(cachedName, pnpInf, hidInf) == HID_HOST_SUCCESS) {
+        hogp_->SetUhid(&uhid_);
+    }
 }
 
 int HidHostStateMachine::GetDeviceStateInt() const
@@ -25,7 +25,6 @@ HidHostUhid::HidHostUhid(std::string address)
     pollThreadId_ = -1;
     fd_ = -1;
     keepPolling_ = false;
-    readyForData_ = false;
     task_id_ = 0;
 }
 
@@ -56,6 +55,7 @@ int HidHostUhid::Open()
             return HID_HOST_FAILURE;
         } else {
             pollThreadId_ = threadId;
+            inputWriter_.Start(fd_);
             return HID_HOST_SUCCESS;
         }
     }
@@ -72,37 +72,35 @@ int HidHostUhid::Close()
 
 int HidHostUhid::SendData(uint8_t* pRpt, uint16_t len)
 {
-    LOG_INFO("[UHID]%{public}s", __FUNCTION__);
-    if (fd_ >= 0) {
-        uint32_t polling_attempts = 0;
-        while (!readyForData_ && polling_attempts < MAX_POLLING_ATTEMPTS) {
-            usleep(POLLING_SLEEP_DURATION_US);
-            polling_attempts++;
-        }
-    }
+    LOG_DEBUG("[UHID]%{public}s", __FUNCTION__);
+    bool readyForData = (fd_ >= 0) && inputWriter_.WaitReady(READY_WAIT_TIMEOUT_MS);
     // Send the HID data to the kernel.
-    if ((fd_ >= 0) && readyForData_) {
+    if (readyForData) {
         WritePackUhid(fd_, pRpt, len);
     } else {
-        LOG_ERROR("[UHID]%{public}s failed, fd_:%{public}d, readyForData_:%{public}d, len:%{public}d",
-            __FUNCTION__, fd_, readyForData_, len);
+        LOG_ERROR("[UHID]%{public}s failed, fd_:%{public}d, readyForData:%{public}d, len:%{public}d",
+            __FUNCTION__, fd_, readyForData, len);
         return HID_HOST_FAILURE;
     }
     return HID_HOST_SUCCESS;
 }
 
+int HidHostUhid::SendInputReport(uint8_t reportId, const uint8_t* data, size_t len)
+{
+    return (inputWriter_.Push(reportId, data, len) == 0) ? HID_HOST_SUCCESS : HID_HOST_FAILURE;
+}
+
+HidHostInputLatency HidHostUhid::GetInputLatency()
+{
+    return inputWriter_.GetLatency();
+}
+
 int HidHostUhid::SendControlData(uint8_t* pRpt, uint16_t len)
 {
     LOG_INFO("[UHID]%{public}s", __FUNCTION__);
-    if (fd_ >= 0) {
-        uint32_t polling_attempts = 0;
-        while (!readyForData_ && polling_attempts < MAX_POLLING_ATTEMPTS) {
-            usleep(POLLING_SLEEP_DURATION_US);
-            polling_attempts++;
-        }
-    }
+    bool readyForData = (fd_ >= 0) && inputWriter_.WaitReady(READY_WAIT_TIMEOUT_MS);
     // Send the HID control data to the kernel.
-    if ((fd_ >= 0) && readyForData_) {
+    if (readyForData) {
         if (task_type_ == HID_HOST_DATA_TYPE_GET_REPORT) {
             SendGetReportReplyUhid(fd_, task_id_, HID_HOST_SUCCESS, pRpt, len);
         } else if (task_type_ == HID_HOST_DATA_TYPE_SET_REPORT) {
@@ -113,8 +111,8 @@ int HidHostUhid::SendControlData(uint8_t* pRpt, uint16_t len)
         task_id_ = 0;
         task_type_ = -1;
     } else {
-        LOG_ERROR("[UHID]%{public}s failed, fd_:%{public}d, readyForData_:%{public}d, len:%{public}d",
-            __FUNCTION__, fd_, readyForData_, len);
+        LOG_ERROR("[UHID]%{public}s failed, fd_:%{public}d, readyForData:%{public}d, len:%{public}d",
+            __FUNCTION__, fd_, readyForData, len);
         return HID_HOST_FAILURE;
     }
     return HID_HOST_SUCCESS;
@@ -123,15 +121,9 @@ int HidHostUhid::SendControlData(uint8_t* pRpt, uint16_t len)
 int HidHostUhid::SendHandshake(uint16_t err)
 {
     LOG_INFO("[UHID]%{public}s, err:%{public}d", __FUNCTION__, err);
-    if (fd_ >= 0) {
-        uint32_t polling_attempts = 0;
-        while (!readyForData_ && polling_attempts < MAX_POLLING_ATTEMPTS) {
-            usleep(POLLING_SLEEP_DURATION_US);
-            polling_attempts++;
-        }
-    }
+    bool readyForData = (fd_ >= 0) && inputWriter_.WaitReady(READY_WAIT_TIMEOUT_MS);
     // Send the HID handshake to the kernel.
-    if ((fd_ >= 0) && readyForData_) {
+    if (readyForData) {
         if (task_type_ == HID_HOST_DATA_TYPE_GET_REPORT) {
             SendGetReportReplyUhid(fd_, task_id_, err, nullptr, 0);
         } else if (task_type_ == HID_HOST_DATA_TYPE_SET_REPORT) {
@@ -142,8 +134,8 @@ int HidHostUhid::SendHandshake(uint16_t err)
         task_id_ = 0;
         task_type_ = -1;
     } else {
-        LOG_ERROR("[UHID]%{public}s failed, fd_:%{public}d, readyForData_:%{public}d",
-            __FUNCTION__, fd_, readyForData_);
+        LOG_ERROR("[UHID]%{public}s failed, fd_:%{public}d, readyForData:%{public}d",
+            __FUNCTION__, fd_, readyForData);
         return HID_HOST_FAILURE;
     }
     return HID_HOST_SUCCESS;
@@ -215,6 +207,7 @@ int HidHostUhid::SendHidInfo(const char* devName, PnpInformation& pnpInf, HidInf
     if (ret) {
         LOG_ERROR("[UHID]%{public}s(): Error: failed to send DSCP, result = %{public}d", __FUNCTION__, ret);
         /* The HID report descriptor is corrupted. Close the driver. */
+        inputWriter_.Stop();
         close(fd_);
         fd_ = -1;
         return HID_HOST_FAILURE;
@@ -225,6 +218,7 @@ int HidHostUhid::SendHidInfo(const char* devName, PnpInformation& pnpInf, HidInf
 
 int HidHostUhid::Destroy()
 {
+    inputWriter_.Stop();
     if (fd_ >= 0) {
         struct uhid_event ev;
         memset_s(&ev, sizeof(ev), 0, sizeof(ev));
@@ -258,29 +252,38 @@ int HidHostUhid::WriteUhid(int fd, const struct uhid_event* ev)
 int HidHostUhid::WritePackUhid(int fd, uint8_t* rpt, uint16_t len)
 {
     struct uhid_event ev;
-    memset_s(&ev, sizeof(ev), 0, sizeof(ev));
-    ev.type = UHID_INPUT;
-    ev.u.input.size = len;
-    if (len > sizeof(ev.u.input.data)) {
+    ev.type = UHID_INPUT2;
+    ev.u.input2.size = len;
+    if (len > sizeof(ev.u.input2.data)) {
         LOG_WARN("[UHID]%{public}s(): Report size greater than allowed size", __FUNCTION__);
         return HID_HOST_FAILURE;
     }
-    if (memcpy_s(ev.u.input.data, sizeof(ev.u.input.data), rpt, len) != EOK) {
+    if (memcpy_s(ev.u.input2.data, sizeof(ev.u.input2.data), rpt, len) != EOK) {
         LOG_ERROR("[UHID]%{public}s(): memcpy error", __FUNCTION__);
         return HID_HOST_FAILURE;
     }
-    return WriteUhid(fd, &ev);
+    // uhid takes an input event trimmed to the report, so only the bytes used are copied into the kernel.
+    size_t size = offsetof(struct uhid_event, u.input2.data) + len;
+    ssize_t ret;
+    do {
+    } while ((ret = write(fd, &ev, size)) == -1 && errno == EINTR);
+    if (ret != static_cast<ssize_t>(size)) {
+        LOG_ERROR("[UHID]%{public}s(): Cannot write to uhid:%{public}s", __FUNCTION__, strerror(errno));
+        return HID_HOST_FAILURE;
+    }
+    return HID_HOST_SUCCESS;
 }
 
 int HidHostUhid::ClosePollThread()
 {
     LOG_INFO("[UHID]%{public}s():", __FUNCTION__);
-    readyForData_ = false;
+    inputWriter_.SetReady(false);
     if (keepPolling_) {
         keepPolling_ = false;
         pthread_join(pollThreadId_, nullptr);
     }
     pollThreadId_ = -1;
+    inputWriter_.Stop();
     return HID_HOST_SUCCESS;
 }
 
@@ -376,19 +379,19 @@ int HidHostUhid::ReadUhidEvent()
     switch (ev.type) {
         case UHID_START:
             LOG_INFO("[UHID]%{public}s():UHID_START from uhid-dev", __FUNCTION__);
-            readyForData_ = true;
+            inputWriter_.SetReady(true);
             break;
         case UHID_STOP:
             LOG_INFO("[UHID]%{public}s():UHID_STOP from uhid-dev", __FUNCTION__);
-            readyForData_ = false;
+            inputWriter_.SetReady(false);
             break;
         case UHID_OPEN:
             LOG_INFO("[UHID]%{public}s():UHID_OPEN from uhid-dev", __FUNCTION__);
-            readyForData_ = true;
+            inputWriter_.SetReady(true);
             break;
         case UHID_CLOSE:
             LOG_INFO("[UHID]%{public}s():UHID_CLOSE from uhid-dev", __FUNCTION__);
-            readyForData_ = false;
+            inputWriter_.SetReady(false);
             break;
         case UHID_OUTPUT:
             ReadUhidOutPut(ev);
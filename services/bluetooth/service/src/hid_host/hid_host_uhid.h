@@ -23,13 +23,13 @@
 #include <string>
 #include <linux/uhid.h>
 #include "hid_host_defines.h"
+#include "hid_host_input_writer.h"
 #include "base_def.h"
 #include "raw_address.h"
 
 namespace OHOS {
 namespace bluetooth {
-static constexpr int MAX_POLLING_ATTEMPTS = 10;
-static constexpr int POLLING_SLEEP_DURATION_US = 5000;
+static constexpr int READY_WAIT_TIMEOUT_MS = 50;
 static constexpr int POLL_TIMEOUT = 50;
 
 /**
@@ -43,6 +43,8 @@ public:
     int Destroy();
     int SendHidInfo(const char* devName, PnpInformation& pnpInf, HidInformation& hidInf);
     int SendData(uint8_t* pRpt, uint16_t len);
+    int SendInputReport(uint8_t reportId, const uint8_t* data, size_t len);
+    HidHostInputLatency GetInputLatency();
     int SendControlData(uint8_t* pRpt, uint16_t len);
     int SendHandshake(uint16_t err);
     int Close();
@@ -67,7 +69,7 @@ private:
     pthread_t pollThreadId_ = -1;
     int fd_ = -1;
     bool keepPolling_ = false;
-    bool readyForData_ = false;
+    HidHostInputWriter inputWriter_;
     std::string address_;
     int task_id_ = 0;
     int task_type_ = -1;
@@ -14,10 +14,14 @@
  */
 
 #include "obex_body.h"
+#include <cerrno>
 #include <cstring>
+#include <fcntl.h>
 #include <memory>
+#include <unistd.h>
 #include "log.h"
 #include "obex_types.h"
+#include "securec.h"
 
 namespace OHOS {
 namespace bluetooth {
@@ -37,8 +41,9 @@ size_t ObexArrayBodyObject::Read(uint8_t *buf, size_t bufLen)
     if (remainSize < readSize) {
         readSize = remainSize;
     }
-    for (size_t i = 0; i < readSize; i++) {
-        buf[i] = body_[index_++];
+    if (readSize > 0) {
+        (void)memcpy_s(buf, bufLen, &body_[index_], readSize);
+        index_ += readSize;
     }
     OBEX_LOG_DEBUG("ObexArrayBodyObject::Read: %zu / %zu", index_, body_.size());
     return readSize;
@@ -61,5 +66,76 @@ int ObexArrayBodyObject::Close()
     std::lock_guard<std::mutex> lock(mutex_);
     return 0;
 }
+
+ObexFileBodyObject::ObexFileBodyObject(int fd) : fd_(fd)
+{
+    if (fd_ < 0) {
+        OBEX_LOG_ERROR("%{public}s, invalid fd", __PRETTY_FUNCTION__);
+        return;
+    }
+    (void)posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+}
+
+ObexFileBodyObject::ObexFileBodyObject(const std::string &file)
+    : ObexFileBodyObject(open(file.c_str(), O_RDONLY | O_CLOEXEC))
+{}
+
+ObexFileBodyObject::~ObexFileBodyObject()
+{
+    Close();
+}
+
+size_t ObexFileBodyObject::Read(uint8_t *buf, size_t bufLen)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t readSize = 0;
+    while (fd_ >= 0 && readSize < bufLen) {
+        ssize_t ret = pread(fd_, buf + readSize, bufLen - readSize, readOffset_);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret < 0) {
+            OBEX_LOG_ERROR("ObexFileBodyObject::Read: errno=%{public}d", errno);
+            break;
+        }
+        if (ret == 0) {
+            break;
+        }
+        readSize += static_cast<size_t>(ret);
+        readOffset_ += ret;
+    }
+    OBEX_LOG_DEBUG("ObexFileBodyObject::Read: %zu at %{public}lld", readSize, static_cast<long long>(readOffset_));
+    return readSize;
+}
+
+size_t ObexFileBodyObject::Write(const uint8_t *buf, size_t bufLen)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t writeSize = 0;
+    while (fd_ >= 0 && writeSize < bufLen) {
+        ssize_t ret = pwrite(fd_, buf + writeSize, bufLen - writeSize, writeOffset_);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            OBEX_LOG_ERROR("ObexFileBodyObject::Write: errno=%{public}d", errno);
+            break;
+        }
+        writeSize += static_cast<size_t>(ret);
+        writeOffset_ += ret;
+    }
+    return writeSize;
+}
+
+int ObexFileBodyObject::Close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) {
+        return 0;
+    }
+    int ret = close(fd_);
+    fd_ = -1;
+    return ret;
+}
 }  // namespace bluetooth
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS
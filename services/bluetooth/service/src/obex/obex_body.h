@@ -19,6 +19,8 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <sys/types.h>
 #include <vector>
 
 namespace OHOS {
@@ -46,6 +48,26 @@ private:
     size_t index_ = 0;
     std::mutex mutex_ {};
 };
+
+// Body backed by a file descriptor. Reads and writes go through pread/pwrite at the object's own offsets, so the
+// file is never staged in memory and each outgoing body chunk is copied once, straight into the packet buffer.
+class ObexFileBodyObject : public ObexBodyObject {
+public:
+    // Takes ownership of fd.
+    explicit ObexFileBodyObject(int fd);
+    // Opens file for reading.
+    explicit ObexFileBodyObject(const std::string &file);
+    virtual ~ObexFileBodyObject();
+    size_t Read(uint8_t *buf, size_t bufLen) override;
+    size_t Write(const uint8_t *buf, size_t bufLen) override;
+    int Close() override;
+
+private:
+    int fd_ = -1;
+    off_t readOffset_ = 0;
+    off_t writeOffset_ = 0;
+    std::mutex mutex_ {};
+};
 }  // namespace bluetooth
 }  // namespace OHOS
 #endif  // OBEX_BODY_H
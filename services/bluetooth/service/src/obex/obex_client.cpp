@@ -234,6 +234,7 @@ ObexClient::ObexClient(const ObexClientConfig &config, ObexClientObserver &obser
     option.isGoepL2capPSM_ = config.isGoepL2capPSM_;
     clientTransport_ = std::make_unique<ObexClientSocketTransport>(option, *transportObserver_, dispatcher);
     isSupportSrm_ = config.isSupportSrm_;  // srm mode
+    srmWindow_ = config.srmWindow_;
     isSupportReliableSession_ = config.isSupportReliableSession_;
     clientSession_ = std::make_unique<ObexClientSession>(RawAddress::ConvertToString(config.addr_.addr));
     clientSession_->SetMaxPacketLength(config.mtu_);
@@ -49,6 +49,7 @@ struct ObexClientConfig {
     bool isSupportSrm_ = false;              // Using Single Response Mode
     bool isSupportReliableSession_ = false;  // Using reliable session
     BtUuid serviceUUID_ {};                  // Service's UUID128
+    uint8_t srmWindow_ = ObexSrmPump::DEFAULT_WINDOW;  // Packets prepared ahead of the transport in SRM
 };
 
 struct ObexConnectParams {
@@ -314,6 +315,7 @@ protected:
     bool isSupportSrm_ = false;
     bool isSupportReliableSession_ = false;
     bool isProcessing_ = false;
+    uint8_t srmWindow_ = ObexSrmPump::DEFAULT_WINDOW;
     std::string clientId_ = "";
     utility::Dispatcher &dispatcher_;
     BT_DISALLOW_COPY_AND_ASSIGN(ObexClient);
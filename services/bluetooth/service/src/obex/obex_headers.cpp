@@ -457,6 +457,12 @@ void ObexHeader::AppendBytes(const uint8_t headerId, const uint8_t *byteBuf, con
     Append(header);
 }
 
+void ObexHeader::AppendSegment(const uint8_t headerId, Buffer *segment, const uint16_t size)
+{
+    std::unique_ptr<ObexOptionalHeader> header = std::make_unique<ObexOptionalBodyHeader>(headerId, segment, size);
+    Append(header);
+}
+
 void ObexHeader::AppendWord(const uint8_t headerId, const uint32_t word)
 {
     std::unique_ptr<ObexOptionalHeader> header = std::make_unique<ObexOptionalWordHeader>(headerId, word);
@@ -524,6 +530,16 @@ void ObexHeader::AppendItemEndBody(const uint8_t *endBody, const uint16_t length
     AppendBytes(ObexHeader::END_OF_BODY, endBody, length);
 }
 
+void ObexHeader::AppendItemBody(Buffer *body, const uint16_t length)
+{
+    AppendSegment(ObexHeader::BODY, body, length);
+}
+
+void ObexHeader::AppendItemEndBody(Buffer *endBody, const uint16_t length)
+{
+    AppendSegment(ObexHeader::END_OF_BODY, endBody, length);
+}
+
 void ObexHeader::AppendItemWho(const uint8_t *who, const uint16_t length)
 {
     AppendBytes(ObexHeader::WHO, who, length);
@@ -814,9 +830,29 @@ bool ObexHeader::GetItemSrmp() const
 
 std::unique_ptr<ObexPacket> ObexHeader::Build() const
 {
-    auto obexPacket = std::make_unique<ObexPacket>(packetLength_);
-    uint8_t *packetBuf = obexPacket->GetBuffer();
+    uint16_t segmentSize = 0;
+    for (auto &headerItem : optionalHeaders_) {
+        if (headerItem->GetSegment() != nullptr) {
+            segmentSize += headerItem->GetHeaderDataSize();
+        }
+    }
+    if (segmentSize == 0) {
+        auto obexPacket = std::make_unique<ObexPacket>(packetLength_);
+        BuildTo(obexPacket->GetBuffer(), packetLength_, nullptr, nullptr);
+        return obexPacket;
+    }
+    // Only the header bytes around the body are serialized; body segments are shared with the packet.
+    Buffer *staging = BufferMalloc(packetLength_ - segmentSize);
+    Packet *packet = PacketMalloc(0, 0, 0);
+    BuildTo(static_cast<uint8_t *>(BufferPtr(staging)), packetLength_ - segmentSize, staging, packet);
+    BufferFree(staging);
+    return std::make_unique<ObexPacket>(*packet);
+}
+
+void ObexHeader::BuildTo(uint8_t *packetBuf, uint16_t bufLen, const Buffer *staging, const Packet *packet) const
+{
     uint16_t pos = 0;
+    uint16_t flushed = 0;
     packetBuf[pos++] = code_;
     bool isBigEndian = ObexUtils::SysIsBigEndian();
     ObexUtils::SetBufData16(packetBuf, pos, packetLength_);
@@ -840,14 +876,26 @@ std::unique_ptr<ObexPacket> ObexHeader::Build() const
             ObexUtils::SetBufData16(packetBuf, pos, headerItem->GetHeaderTotalSize());
             pos += UINT16_LENGTH;
         }
-        (void)memcpy_s(
-            &packetBuf[pos], packetLength_ - pos, headerItem->GetBytes().get(), headerItem->GetHeaderDataSize());
+        const Buffer *segment = headerItem->GetSegment();
+        if (segment != nullptr) {
+            Buffer *slice = BufferSliceMalloc(staging, flushed, pos - flushed);
+            PacketPayloadAddLast(packet, slice);
+            BufferFree(slice);
+            PacketPayloadAddLast(packet, segment);
+            flushed = pos;
+            continue;
+        }
+        (void)memcpy_s(&packetBuf[pos], bufLen - pos, headerItem->GetBytes().get(), headerItem->GetHeaderDataSize());
         if (!isBigEndian && headerItem->GetHeaderUnitLen() > 1) {
             ObexUtils::DataReverse(&packetBuf[pos], headerItem->GetHeaderDataSize(), headerItem->GetHeaderUnitLen());
         }
         pos += headerItem->GetHeaderDataSize();
     }
-    return obexPacket;
+    if (packet != nullptr && pos > flushed) {
+        Buffer *slice = BufferSliceMalloc(staging, flushed, pos - flushed);
+        PacketPayloadAddLast(packet, slice);
+        BufferFree(slice);
+    }
 }
 
 const std::shared_ptr<ObexBodyObject> &ObexHeader::GetExtendBodyObject() const
@@ -979,6 +1027,63 @@ uint8_t ObexOptionalHeader::GetHeaderUnitLen() const
     return unitLen_;
 }
 
+const Buffer *ObexOptionalHeader::GetSegment() const
+{
+    return nullptr;
+}
+
+// ObexOptionalBodyHeader
+ObexOptionalBodyHeader::ObexOptionalBodyHeader(const uint8_t headerId, Buffer *body, const uint16_t dataSize)
+    : ObexOptionalHeader(headerId)
+{
+    if (body == nullptr || dataSize == 0 || dataSize > BufferGetSize(body)) {
+        BufferFree(body);
+        return;
+    }
+    dataSize_ = dataSize;
+    body_ = (dataSize < BufferGetSize(body)) ? BufferResize(body, 0, dataSize) : body;
+}
+
+ObexOptionalBodyHeader::~ObexOptionalBodyHeader()
+{
+    BufferFree(body_);
+}
+
+std::unique_ptr<uint8_t[]> ObexOptionalBodyHeader::GetBytes() const
+{
+    if (body_ == nullptr) {
+        return nullptr;
+    }
+    auto buf = std::make_unique<uint8_t[]>(dataSize_);
+    (void)memcpy_s(buf.get(), dataSize_, BufferPtr(body_), dataSize_);
+    return buf;
+}
+
+const Buffer *ObexOptionalBodyHeader::GetSegment() const
+{
+    return body_;
+}
+
+bool ObexOptionalBodyHeader::HasLengthField() const
+{
+    return true;
+}
+
+ObexHeaderDataType ObexOptionalBodyHeader::GetHeaderClassType() const
+{
+    return ObexHeaderDataType::BYTES;
+}
+
+std::string ObexOptionalBodyHeader::GetHeaderClassTypeName() const
+{
+    return "ObexOptionalBodyHeader";
+}
+
+std::unique_ptr<ObexOptionalHeader> ObexOptionalBodyHeader::Clone() const
+{
+    return std::make_unique<ObexOptionalBodyHeader>(GetHeaderId(), BufferRefMalloc(body_), dataSize_);
+}
+
 // ObexOptionalBytesHeader
 ObexOptionalBytesHeader::ObexOptionalBytesHeader(
     const uint8_t headerId, const uint8_t *data, const uint16_t dataSize, const uint16_t unitLen)
@@ -237,6 +237,8 @@ public:
     virtual ObexHeaderDataType GetHeaderClassType() const = 0;
     virtual std::string GetHeaderClassTypeName() const = 0;
     virtual std::unique_ptr<uint8_t[]> GetBytes() const = 0;
+    // Payload buffer linked into the built packet by reference instead of copied, nullptr for inline headers
+    virtual const Buffer *GetSegment() const;
 
 protected:
     ObexOptionalHeader(uint8_t headerId);
@@ -260,6 +262,23 @@ protected:
     std::vector<uint8_t> data_ {};
 };
 
+// Body / End of Body header that keeps its data in a stack Buffer, so Build() links it into the packet as is.
+class ObexOptionalBodyHeader : public ObexOptionalHeader {
+public:
+    // Takes ownership of body and trims it to dataSize.
+    ObexOptionalBodyHeader(const uint8_t headerId, Buffer *body, const uint16_t dataSize);
+    ~ObexOptionalBodyHeader() override;
+    std::unique_ptr<uint8_t[]> GetBytes() const override;
+    const Buffer *GetSegment() const override;
+    bool HasLengthField() const override;
+    ObexHeaderDataType GetHeaderClassType() const override;
+    std::string GetHeaderClassTypeName() const override;
+    std::unique_ptr<ObexOptionalHeader> Clone() const override;
+
+private:
+    Buffer *body_ = nullptr;
+};
+
 class ObexOptionalByteHeader : public ObexOptionalBytesHeader {
 public:
     ObexOptionalByteHeader(const uint8_t headerId, const uint8_t byte);
@@ -432,6 +451,9 @@ public:
     void AppendItemHttp(const uint8_t *http, const uint16_t length);
     void AppendItemBody(const uint8_t *body, const uint16_t length);
     void AppendItemEndBody(const uint8_t *endBody, const uint16_t length);
+    // Body chunks read straight into a Buffer; the header takes ownership and Build() sends it without copying.
+    void AppendItemBody(Buffer *body, const uint16_t length);
+    void AppendItemEndBody(Buffer *endBody, const uint16_t length);
     void AppendItemWho(const uint8_t *who, const uint16_t length);
     void AppendItemObjectClass(const uint8_t *objectClass, const uint16_t length);
 
@@ -536,6 +558,8 @@ private:
     void AppendWord(const uint8_t headerId, const uint32_t word);
     void AppendString(const uint8_t headerId, const std::string &str);
     void AppendTlvTriplets(const uint8_t headerId, ObexTlvParamters &tlvParamters);
+    void AppendSegment(const uint8_t headerId, Buffer *segment, const uint16_t size);
+    void BuildTo(uint8_t *packetBuf, uint16_t bufLen, const Buffer *staging, const Packet *packet) const;
 
     void ParseBytes(const uint8_t &headerId, const uint8_t *buf, uint16_t &pos);
     void ParseUnicodeText(const uint8_t &headerId, const uint8_t *buf, uint16_t &pos);
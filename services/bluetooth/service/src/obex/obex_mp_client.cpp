@@ -47,6 +47,7 @@ int ObexMpClient::Put(const ObexHeader &req, std::shared_ptr<ObexBodyObject> rea
     OBEX_LOG_DEBUG("Create ObexClientSendObject mtu=%{public}d", int(mtu));
 
     auto &sendObject = clientSession_->CreateSendObject(req, reader, mtu);
+    sendObject->GetSrmPump().SetWindow(srmWindow_);
     auto sendReq = sendObject->GetNextReqHeader(isSupportSrm_);
     if (sendReq == nullptr) {
         clientSession_->FreeSendObject();
@@ -188,32 +189,35 @@ int ObexMpClient::ProcessSendPutWithSrm()
         return -1;
     }
     sendObject->SetSrmSending();
-    if (sendObject->IsBusy()) {
-        OBEX_LOG_DEBUG("ProcessSendPutWithSrm: Transport is busy, waiting...");
-        return 0;
-    }
-    auto nexReqHdr = sendObject->GetNextReqHeader();
-    if (nexReqHdr == nullptr) {
-        if (!sendObject->IsDone()) {
+    auto next = [&sendObject](bool &isFinal) {
+        auto nexReqHdr = sendObject->GetNextReqHeader();
+        isFinal = sendObject->IsDone();
+        return nexReqHdr;
+    };
+    auto write = [this](ObexHeader &req) {
+        isProcessing_ = false;
+        return SendRequest(req);
+    };
+    auto isBusy = [&sendObject]() { return sendObject->IsBusy(); };
+    auto &pump = sendObject->GetSrmPump();
+    switch (pump.Pump(next, write, isBusy)) {
+        case ObexSrmPump::State::BUSY:
+            OBEX_LOG_DEBUG("ProcessSendPutWithSrm: Transport is busy, waiting...");
+            return 0;
+        case ObexSrmPump::State::WINDOW_SENT:
+            OBEX_LOG_DEBUG("ProcessSendPutWithSrm: CONTINUE");
+            dispatcher_.PostTask(std::bind(&ObexMpClient::ProcessSendPutWithSrm, this));
+            return 0;
+        case ObexSrmPump::State::FAILED: {
+            int ret = pump.GetError();
             clientSession_->FreeSendObject();
-            clientObserver_.OnTransportFailed(*this, -1);
+            clientObserver_.OnTransportFailed(*this, ret);
+            return ret;
         }
-        return -1;
-    }
-    isProcessing_ = false;
-    int ret = SendRequest(*nexReqHdr);
-    if (ret != 0) {
-        clientSession_->FreeSendObject();
-        clientObserver_.OnTransportFailed(*this, ret);
-        return ret;
-    }
-    if (sendObject->IsDone()) {
-        OBEX_LOG_DEBUG("ProcessSendPutWithSrm: DONE!");
-        return 0;
+        default:
+            OBEX_LOG_DEBUG("ProcessSendPutWithSrm: DONE!");
+            return 0;
     }
-    OBEX_LOG_DEBUG("ProcessSendPutWithSrm: CONTINUE");
-    dispatcher_.PostTask(std::bind(&ObexMpClient ::ProcessSendPutWithSrm, this));
-    return 0;
 }
 
 void ObexMpClient::GetDataAvailable(const ObexHeader &resp)
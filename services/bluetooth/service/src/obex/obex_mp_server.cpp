@@ -41,6 +41,7 @@ ObexMpServer::ObexMpServer(const std::string &serviceName, const ObexServerConfi
         option.mtu_ = config.l2capMtu_;
         option.isSupportSrm_ = config.isSupportSrm_;
         option.isSupportReliableSession_ = config.isSupportReliableSession_;
+        option.srmWindow_ = config.srmWindow_;
         l2capServer_ = std::make_unique<ObexPrivateMpServer>(option, observer, dispatcher);
     }
 }
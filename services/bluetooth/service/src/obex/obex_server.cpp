@@ -43,6 +43,7 @@ ObexServer::ObexServer(const std::string &serviceName, const ObexServerConfig &c
         option.mtu_ = config.l2capMtu_;
         option.isSupportSrm_ = config.isSupportSrm_;
         option.isSupportReliableSession_ = config.isSupportReliableSession_;
+        option.srmWindow_ = config.srmWindow_;
         l2capServer_ = std::make_unique<ObexPrivateServer>(option, observer, dispatcher);
     }
 }
@@ -181,7 +182,8 @@ void ObexPrivateServer::ObexServerTransportObserver::OnTransportConnected(ObexTr
         obexServer_.isSupportSrm_,
         obexServer_.dispatcher_,
         std::bind(&ObexPrivateServer::RemoveSession, &obexServer_, std::placeholders::_1),
-        std::bind(&ObexPrivateServer::SetBusy, &obexServer_, std::placeholders::_1, std::placeholders::_2));
+        std::bind(&ObexPrivateServer::SetBusy, &obexServer_, std::placeholders::_1, std::placeholders::_2),
+        obexServer_.srmWindow_);
     std::string btAddrStr = session->GetRemoteAddr().GetAddress();
     session->SetMaxPacketLength(obexServer_.initMtu_);
 
@@ -315,6 +317,7 @@ ObexPrivateServer::ObexPrivateServer(
 
     isSupportSrm_ = config.isSupportSrm_;
     isSupportReliableSession_ = config.isSupportReliableSession_;
+    srmWindow_ = config.srmWindow_;
     serverTransport_ = std::make_unique<ObexServerSocketTransport>(option, *transportObserver_, dispatcher);
 }
 
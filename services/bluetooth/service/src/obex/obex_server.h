@@ -40,6 +40,7 @@ struct ObexServerConfig {
     uint16_t l2capMtu_ = 0;                  // The maximum size of data received at a time with l2cap
     bool isSupportSrm_ = false;              // Is Support Single Request Mode
     bool isSupportReliableSession_ = false;  // Is Use Reliable Session
+    uint8_t srmWindow_ = ObexSrmPump::DEFAULT_WINDOW;  // Packets prepared ahead of the transport in SRM
 };
 class ObexServerSession;
 class ObexIncomingConnect;
@@ -74,6 +75,7 @@ public:
         bool isGoepL2capPSM_ = false;            // l2cap : true , rfcomm : false
         bool isSupportSrm_ = false;              // Is Support Single Request Mode
         bool isSupportReliableSession_ = false;  // Is Use Reliable Session
+        uint8_t srmWindow_ = ObexSrmPump::DEFAULT_WINDOW;  // Packets prepared ahead of the transport in SRM
     };
     explicit ObexPrivateServer(
         const ObexPrivateServerConfig &config, ObexServerObserver &observer, utility::Dispatcher &dispatcher);
@@ -114,6 +116,7 @@ protected:
     uint16_t initMtu_ = 0;
     bool isSupportSrm_ = false;              // Is Support Single Request Mode
     bool isSupportReliableSession_ = false;  // Is Use Reliable Session
+    uint8_t srmWindow_ = ObexSrmPump::DEFAULT_WINDOW;
     ObexServerObserver &observer_;
     std::unique_ptr<ObexServerTransportObserver> transportObserver_ = nullptr;
     std::unique_ptr<ObexServerTransport> serverTransport_ = nullptr;
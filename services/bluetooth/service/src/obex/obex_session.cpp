@@ -22,13 +22,15 @@
 namespace OHOS {
 namespace bluetooth {
 ObexServerSession::ObexServerSession(ObexTransport &transport, bool isSupportSrm, utility::Dispatcher &dispatcher,
-    std::function<int(ObexServerSession &)> removeFun, std::function<void(ObexServerSession &, bool)> setBusyFun)
+    std::function<int(ObexServerSession &)> removeFun, std::function<void(ObexServerSession &, bool)> setBusyFun,
+    size_t srmWindow)
     : ObexSession(transport.GetRemoteAddress()),
       transport_(transport),
       isSupportSrm_(isSupportSrm),
       dispatcher_(dispatcher),
       removeFun_(std::move(removeFun)),
-      setBusyFun_(std::move(setBusyFun))
+      setBusyFun_(std::move(setBusyFun)),
+      srmWindow_(srmWindow)
 {}
 
 int ObexServerSession::Disconnect()
@@ -91,6 +93,7 @@ int ObexServerSession::SendGetResponse(const ObexHeader &req, ObexHeader &resp,
         return SendResponse(resp);
     }
     sendObject_ = std::make_unique<ObexServerSendObject>(req, resp, reader, maxPacketLength_, isSupportSrm_);
+    sendObject_->GetSrmPump().SetWindow(srmWindow_);
 
     sendObject_->SetStartBodyResp(req.GetFieldCode() == static_cast<uint8_t>(ObexOpeId::GET_FINAL));
     auto resp2 = sendObject_->GetNextRespHeader();
@@ -126,36 +129,43 @@ int ObexServerSession::ProcessSendSrmResponse()
         return -1;
     }
     sendObject_->SetSrmSending();
-    if (sendObject_->IsBusy()) {
-        OBEX_LOG_DEBUG("ProcessSendSrmResponse: Transport is busy, waiting...");
-        return 0;
-    }
-    auto nextReqHdr = sendObject_->GetNextRespHeader();
-    if (nextReqHdr == nullptr) {
-        OBEX_LOG_ERROR("ProcessSendSrmResponse: nextReqHdr is null!");
-        if (!sendObject_->IsDone()) {
+    auto next = [this](bool &isFinal) {
+        auto nextRespHdr = sendObject_->GetNextRespHeader();
+        if (nextRespHdr == nullptr) {
+            OBEX_LOG_ERROR("ProcessSendSrmResponse: nextRespHdr is null!");
+            nextRespHdr = ObexHeader::CreateResponse(ObexRspCode::INTERNAL_SERVER_ERROR);
+        }
+        isFinal = nextRespHdr->GetFieldCode() != static_cast<uint8_t>(ObexRspCode::CONTINUE);
+        return nextRespHdr;
+    };
+    auto write = [this](ObexHeader &resp) { return SendResponse(resp); };
+    auto isBusy = [this]() { return sendObject_->IsBusy(); };
+    auto &pump = sendObject_->GetSrmPump();
+    switch (pump.Pump(next, write, isBusy)) {
+        case ObexSrmPump::State::BUSY:
+            OBEX_LOG_DEBUG("ProcessSendSrmResponse: Transport is busy, waiting...");
+            return 0;
+        case ObexSrmPump::State::WINDOW_SENT:
+            OBEX_LOG_DEBUG("ProcessSendSrmResponse: CONTINUE");
+            dispatcher_.PostTask(std::bind(&ObexServerSession::ProcessSendSrmResponse, this));
+            return 0;
+        case ObexSrmPump::State::FAILED: {
+            int ret = pump.GetError();
             sendObject_ = nullptr;
+            return ret;
         }
-        nextReqHdr = ObexHeader::CreateResponse(ObexRspCode::INTERNAL_SERVER_ERROR);
+        default:
+            break;
     }
-    int ret = SendResponse(*nextReqHdr);
-    if (ret != 0) {
-        sendObject_ = nullptr;
-        return ret;
-    }
-    if (nextReqHdr->GetFieldCode() == static_cast<uint8_t>(ObexRspCode::CONTINUE)) {
-        OBEX_LOG_DEBUG("ProcessSendSrmResponse: CONTINUE");
-        dispatcher_.PostTask(std::bind(&ObexServerSession::ProcessSendSrmResponse, this));
-    } else if (nextReqHdr->GetFieldCode() == static_cast<uint8_t>(ObexRspCode::SUCCESS)) {
-        sendObject_ = nullptr;
+    uint8_t lastCode = pump.GetLastCode();
+    sendObject_ = nullptr;
+    if (lastCode == static_cast<uint8_t>(ObexRspCode::SUCCESS)) {
         OBEX_LOG_DEBUG("ProcessSendSrmResponse: Server send with SRM MODE END");
-        setBusyFun_(*this, false);
     } else {
-        sendObject_ = nullptr;
-        OBEX_LOG_ERROR("ProcessSendSrmResponse: SRM MODE END WITH RESPCODE 0x%02X", nextReqHdr->GetFieldCode());
-        setBusyFun_(*this, false);
+        OBEX_LOG_ERROR("ProcessSendSrmResponse: SRM MODE END WITH RESPCODE 0x%02X", lastCode);
     }
-    return ret;
+    setBusyFun_(*this, false);
+    return 0;
 }
 
 int ObexServerSession::SendSrmResponse()
@@ -211,9 +221,14 @@ ObexClientSendObject::ObexClientSendObject(
 
 bool ObexClientSendObject::SetBodyToHeader(ObexHeader &header, const uint16_t &remainLength)
 {
-    auto buf = std::make_unique<uint8_t[]>(remainLength);
-    int cnt = bodyReader_->Read(buf.get(), remainLength);
+    // The body is read straight into the buffer that the built packet will carry.
+    Buffer *buf = BufferMalloc(remainLength);
+    if (buf == nullptr && remainLength > 0) {
+        return false;
+    }
+    int cnt = bodyReader_->Read(static_cast<uint8_t *>(BufferPtr(buf)), remainLength);
     if (cnt < 0) {
+        BufferFree(buf);
         return false;
     }
     if (cnt < remainLength) {
@@ -222,11 +237,11 @@ bool ObexClientSendObject::SetBodyToHeader(ObexHeader &header, const uint16_t &r
     if (isDone_) {
         OBEX_LOG_DEBUG("GetNextReqHeader Add End-Body count %{public}d", cnt);
         header.SetFinalBit(true);
-        header.AppendItemEndBody(buf.get(), cnt);
+        header.AppendItemEndBody(buf, cnt);
     } else {
         OBEX_LOG_DEBUG("GetNextReqHeader Add Body count %{public}d", cnt);
         header.SetFinalBit(false);
-        header.AppendItemBody(buf.get(), cnt);
+        header.AppendItemBody(buf, cnt);
     }
     return true;
 }
@@ -320,6 +335,11 @@ bool ObexClientSendObject::IsBusy() const
     return isBusy_;
 }
 
+ObexSrmPump &ObexClientSendObject::GetSrmPump()
+{
+    return srmPump_;
+}
+
 // ObexClientReceivedObject
 ObexClientReceivedObject::ObexClientReceivedObject(
     const ObexHeader &firstReq, std::shared_ptr<ObexBodyObject> writer, bool supportSrm, int srmpCount)
@@ -539,9 +559,14 @@ void ObexServerSendObject::SetSrmParam(ObexHeader &header)
 
 bool ObexServerSendObject::SetBodyToHeader(ObexHeader &header, const uint16_t &remainLength)
 {
-    auto buf = std::make_unique<uint8_t[]>(remainLength);
-    int cnt = bodyReader_->Read(buf.get(), remainLength);
+    // The body is read straight into the buffer that the built packet will carry.
+    Buffer *buf = BufferMalloc(remainLength);
+    if (buf == nullptr && remainLength > 0) {
+        return false;
+    }
+    int cnt = bodyReader_->Read(static_cast<uint8_t *>(BufferPtr(buf)), remainLength);
     if (cnt < 0) {
+        BufferFree(buf);
         return false;
     }
     if (cnt < remainLength) {
@@ -550,11 +575,11 @@ bool ObexServerSendObject::SetBodyToHeader(ObexHeader &header, const uint16_t &r
     if (isDone_) {
         OBEX_LOG_DEBUG("GetNextRespHeader Add End-Body count %{public}d", cnt);
         header.SetRespCode(static_cast<uint8_t>(ObexRspCode::SUCCESS));
-        header.AppendItemEndBody(buf.get(), cnt);
+        header.AppendItemEndBody(buf, cnt);
     } else {
         OBEX_LOG_DEBUG("GetNextRespHeader Add Body count %{public}d", cnt);
         header.SetRespCode(static_cast<uint8_t>(ObexRspCode::CONTINUE));
-        header.AppendItemBody(buf.get(), cnt);
+        header.AppendItemBody(buf, cnt);
     }
     return true;
 }
@@ -655,6 +680,11 @@ bool ObexServerSendObject::IsSupportSrmMode() const
     return supportSrmMode_;
 }
 
+ObexSrmPump &ObexServerSendObject::GetSrmPump()
+{
+    return srmPump_;
+}
+
 ObexSession::ObexSession(const RawAddress &remoteAddr) : remoteAddr_(remoteAddr)
 {}
 
@@ -21,6 +21,7 @@
 #include "dispatcher.h"
 #include "obex_body.h"
 #include "obex_headers.h"
+#include "obex_srm_pump.h"
 #include "obex_transport.h"
 
 namespace OHOS {
@@ -164,6 +165,7 @@ public:
     bool IsSrmSending() const;
     void SetBusy(bool isBusy);
     bool IsBusy() const;
+    ObexSrmPump &GetSrmPump();
 
 private:
     bool SetBodyToHeader(ObexHeader &header, const uint16_t &remainLength);
@@ -176,6 +178,7 @@ private:
     uint16_t mtu_ = 0;
     std::unique_ptr<ObexHeader> firstReq_ = nullptr;
     std::shared_ptr<ObexBodyObject> bodyReader_ = nullptr;
+    ObexSrmPump srmPump_ {};
 };
 
 class ObexClientReceivedObject {
@@ -332,6 +335,7 @@ public:
     void SetBusy(bool isBusy);
     bool IsBusy() const;
     bool IsSupportSrmMode() const;
+    ObexSrmPump &GetSrmPump();
 
 private:
     void SetSrmParam(ObexHeader &header);
@@ -348,12 +352,14 @@ private:
     std::unique_ptr<ObexHeader> firstReq_ = nullptr;
     std::shared_ptr<ObexBodyObject> bodyReader_ = nullptr;
     std::unique_ptr<ObexHeader> firstResp_ = nullptr;
+    ObexSrmPump srmPump_ {};
     BT_DISALLOW_COPY_AND_ASSIGN(ObexServerSendObject);
 };
 class ObexServerSession : public ObexSession {
 public:
     ObexServerSession(ObexTransport &transport, bool isSupportSrm, utility::Dispatcher &dispatcher,
-        std::function<int(ObexServerSession &)> removeFun, std::function<void(ObexServerSession &, bool)> setBusyFun);
+        std::function<int(ObexServerSession &)> removeFun, std::function<void(ObexServerSession &, bool)> setBusyFun,
+        size_t srmWindow = ObexSrmPump::DEFAULT_WINDOW);
     ~ObexServerSession() override = default;
     int Disconnect();
     int SendResponse(ObexHeader &resp) const;
@@ -401,6 +407,7 @@ private:
     utility::Dispatcher &dispatcher_;
     std::function<int(ObexServerSession &)> removeFun_ {};
     std::function<void(ObexServerSession &, bool)> setBusyFun_ {};
+    size_t srmWindow_ = ObexSrmPump::DEFAULT_WINDOW;
     bool invalid_ = false;
     BT_DISALLOW_COPY_AND_ASSIGN(ObexServerSession);
 };
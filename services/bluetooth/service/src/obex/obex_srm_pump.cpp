@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "obex_srm_pump.h"
+#include "log.h"
+#include "obex_types.h"
+
+namespace OHOS {
+namespace bluetooth {
+ObexSrmPump::ObexSrmPump(size_t window)
+{
+    SetWindow(window);
+}
+
+ObexSrmPump::State ObexSrmPump::Pump(const Producer &next, const Writer &write, const std::function<bool()> &isBusy)
+{
+    size_t written = 0;
+    while (true) {
+        Prepare(next);
+        if (prepared_.empty()) {
+            return failed_ ? State::FAILED : State::DONE;
+        }
+        if (isBusy()) {
+            return State::BUSY;
+        }
+        if (written == window_) {
+            return State::WINDOW_SENT;
+        }
+        Frame frame = std::move(prepared_.front());
+        prepared_.pop_front();
+        int ret = write(*frame.header);
+        if (ret != 0) {
+            OBEX_LOG_ERROR("ObexSrmPump: write failed ret=%{public}d after %zu packets", ret, written);
+            prepared_.clear();
+            failed_ = true;
+            error_ = ret;
+            return State::FAILED;
+        }
+        lastCode_ = frame.header->GetFieldCode();
+        written++;
+        if (frame.isFinal) {
+            OBEX_LOG_DEBUG("ObexSrmPump: final packet sent, code 0x%02X", lastCode_);
+            return State::DONE;
+        }
+    }
+}
+
+void ObexSrmPump::Prepare(const Producer &next)
+{
+    while (!finalPrepared_ && !failed_ && prepared_.size() < window_) {
+        bool isFinal = false;
+        auto header = next(isFinal);
+        if (header == nullptr) {
+            // Packets prepared before the error still go out first.
+            failed_ = true;
+            error_ = -1;
+            break;
+        }
+        finalPrepared_ = isFinal;
+        prepared_.push_back({std::move(header), isFinal});
+    }
+}
+
+void ObexSrmPump::SetWindow(size_t window)
+{
+    window_ = (window == 0) ? 1 : window;
+}
+
+size_t ObexSrmPump::GetWindow() const
+{
+    return window_;
+}
+
+size_t ObexSrmPump::GetPreparedCount() const
+{
+    return prepared_.size();
+}
+
+uint8_t ObexSrmPump::GetLastCode() const
+{
+    return lastCode_;
+}
+
+int ObexSrmPump::GetError() const
+{
+    return error_;
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OBEX_SRM_PUMP_H
+#define OBEX_SRM_PUMP_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include "obex_headers.h"
+
+namespace OHOS {
+namespace bluetooth {
+/**
+ * @brief Single Response Mode sender.
+ *
+ * Keeps up to a window of OBEX packets prepared ahead of the transport and writes them back to back. Transport busy
+ * notifications reach OBEX through the dispatcher, so a burst is capped at one window: the caller posts one task per
+ * window instead of one per packet, and resumes straight from the busy -> idle notification.
+ */
+class ObexSrmPump {
+public:
+    static const size_t DEFAULT_WINDOW = 8;
+    enum class State : uint8_t {
+        WINDOW_SENT,  // a full window went out, post the next burst
+        BUSY,         // transport is busy, resume when it reports idle
+        DONE,         // the final packet went out
+        FAILED        // a packet could not be prepared or written, see GetError()
+    };
+    // Prepares the next packet of the object and tells whether it is the final one, nullptr on error.
+    using Producer = std::function<std::unique_ptr<ObexHeader>(bool &isFinal)>;
+    // Writes one packet, 0 on success.
+    using Writer = std::function<int(ObexHeader &header)>;
+
+    explicit ObexSrmPump(size_t window = DEFAULT_WINDOW);
+    virtual ~ObexSrmPump() = default;
+    State Pump(const Producer &next, const Writer &write, const std::function<bool()> &isBusy);
+    void SetWindow(size_t window);
+    size_t GetWindow() const;
+    size_t GetPreparedCount() const;
+    uint8_t GetLastCode() const;
+    int GetError() const;
+
+private:
+    struct Frame {
+        std::unique_ptr<ObexHeader> header;
+        bool isFinal;
+    };
+    void Prepare(const Producer &next);
+    std::deque<Frame> prepared_ {};
+    size_t window_ = DEFAULT_WINDOW;
+    bool finalPrepared_ = false;
+    bool failed_ = false;
+    int error_ = 0;
+    uint8_t lastCode_ = 0;
+};
+}  // namespace bluetooth
+}  // namespace OHOS
+#endif  // OBEX_SRM_PUMP_H
@@ -66,6 +66,14 @@ PanBnep::PanBnep(std::string address)
     connFlags_ = 0;
     id_ = 0;
     isBusy_ = false;
+
+    uint8_t bluetoothAddr[BT_ADDRESS_LENGTH];
+    RawAddress(address_).ConvertToUint8(bluetoothAddr);
+    PanService::ReverseAddress(bluetoothAddr, remoteEthernetAddr_);
+    RawAddress(PanService::GetLocalAddress()).ConvertToUint8(bluetoothAddr);
+    PanService::ReverseAddress(bluetoothAddr, localEthernetAddr_);
+    // The network device uses the unicast form of the local address.
+    localEthernetAddr_[0] &= ~0x01;
 }
 
 PanBnep::~PanBnep()
@@ -232,57 +240,44 @@ int PanBnep::Disconnect()
     return BT_SUCCESS;
 }
 
-int PanBnep::SendData(EthernetHeader ethernetHeader, uint8_t* pkt, int length)
+int PanBnep::SendData(EthernetHeader ethernetHeader, Buffer *payload)
 {
-    if (!CheckBnepEthernetDataFilter(ethernetHeader, pkt, length)) {
+    int length = static_cast<int>(BufferGetSize(payload));
+    if (!CheckBnepEthernetDataFilter(ethernetHeader, static_cast<uint8_t *>(BufferPtr(payload)), length)) {
         return BT_SUCCESS;
     }
-    uint8_t bluetoothDestAddr[BT_ADDRESS_LENGTH];
-    uint8_t bluetoothSrcAddr[BT_ADDRESS_LENGTH];
-    PanService::ReverseAddress(ethernetHeader.destAddr, bluetoothDestAddr);
-    PanService::ReverseAddress(ethernetHeader.srcAddr, bluetoothSrcAddr);
-    std::string destAddr = RawAddress::ConvertToString(bluetoothDestAddr).GetAddress();
-    BtAddr localAddr;
-    RawAddress(PanService::GetLocalAddress()).ConvertToUint8(localAddr.addr);
-    Packet *packet = nullptr;
-    uint8_t *buf = nullptr;
-    int offset = 0;
-    int ret;
-    uint8_t type = BNEP_COMPRESSED_ETHERNET;
-    int packetLength = length;
-    if (localAddr.addr[BT_ADDRESS_LENGTH - 1] & 0x01) {
-        LOG_DEBUG("[PAN BNEP]%{public}s():use unicast MAC address", __FUNCTION__);
-        localAddr.addr[BT_ADDRESS_LENGTH - 1] &= ~0x01;
-    }
-    if (memcmp(bluetoothSrcAddr, localAddr.addr, BT_ADDRESS_LENGTH) == 0) {
-        if (destAddr == address_) {
+    uint8_t type;
+    int headLength;
+    bool isFromLocal = (memcmp(ethernetHeader.srcAddr, localEthernetAddr_, BT_ADDRESS_LENGTH) == 0);
+    bool isToRemote = (memcmp(ethernetHeader.destAddr, remoteEthernetAddr_, BT_ADDRESS_LENGTH) == 0);
+    if (isFromLocal) {
+        if (isToRemote) {
             type = BNEP_COMPRESSED_ETHERNET;
-            packetLength += BNEP_COMPRESSED_ETHERNET_HEAD_LENGTH;
+            headLength = BNEP_COMPRESSED_ETHERNET_HEAD_LENGTH;
         } else {
             type = BNEP_COMPRESSED_ETHERNET_DEST_ONLY;
-            packetLength += BNEP_COMPRESSED_ETHERNET_DEST_ONLY_HEAD_LENGTH;
+            headLength = BNEP_COMPRESSED_ETHERNET_DEST_ONLY_HEAD_LENGTH;
         }
     } else {
-        if (destAddr == address_) {
+        if (isToRemote) {
             type = BNEP_COMPRESSED_ETHERNET_SRC_ONLY;
-            packetLength += BNEP_COMPRESSED_ETHERNET_SRC_ONLY_HEAD_LENGTH;
+            headLength = BNEP_COMPRESSED_ETHERNET_SRC_ONLY_HEAD_LENGTH;
         } else {
             type = BNEP_GENERAL_ETHERNET;
-            packetLength += BNEP_GENERAL_ETHERNET_HEAD_LENGTH;
+            headLength = BNEP_GENERAL_ETHERNET_HEAD_LENGTH;
         }
     }
-    packet = PacketMalloc(packetLength, 0, 0);
-    buf = (uint8_t *)BufferPtr(PacketHead(packet));
-    ret = BnepBuildEthernetPacketHeader(type, ethernetHeader, buf);
-    if (ret <= 0) {
+    // The header goes into the packet head, the payload stays in the buffer it was read into.
+    Packet *packet = PacketMalloc(headLength, 0, 0);
+    if (packet == nullptr) {
         return PAN_FAILURE;
     }
-    offset += ret;
-    if ((length > 0) && (pkt != nullptr)) {
-        if (memcpy_s(buf + offset, length, pkt, length) != EOK) {
-            LOG_ERROR("[PAN BNEP]%{public}s(): memcpy source Address error", __FUNCTION__);
-            return PAN_FAILURE;
-        }
+    if (BnepBuildEthernetPacketHeader(type, ethernetHeader, (uint8_t *)BufferPtr(PacketHead(packet))) <= 0) {
+        PacketFree(packet);
+        return PAN_FAILURE;
+    }
+    if (length > 0) {
+        PacketPayloadAddLast(packet, payload);
     }
     AddPacketToWaitingSendDataList(packet);
     return BT_SUCCESS;
@@ -809,12 +804,14 @@ void PanBnep::BnepDisconnectAbnormalCallbackTask(
     }
 }
 
-void PanBnep::BnepRecvDataCallbackTask(uint16_t lcid, uint8_t *data, int dataLength)
+void PanBnep::BnepRecvDataCallbackTask(
+    uint16_t lcid, const std::shared_ptr<std::unique_ptr<uint8_t[]>> &recvData, int dataLength)
 {
-    if ((data == nullptr) || (dataLength < 1)) {
+    if ((recvData == nullptr) || (recvData->get() == nullptr) || (dataLength < 1)) {
         LOG_ERROR("[PAN BNEP]%{public}s data is null!", __func__);
         return;
     }
+    uint8_t *data = recvData->get();
     int offset = 0, ret = 0;
 
     bool hasExtension = ((data[offset] & 0x80) != 0);
@@ -851,23 +848,21 @@ void PanBnep::BnepRecvDataCallbackTask(uint16_t lcid, uint8_t *data, int dataLen
     }
 
     if (isEthernetData) {
-        SendBnepDataEvent(ethernetHeader, dataLength, offset, data);
+        SendBnepDataEvent(ethernetHeader, dataLength, offset, recvData);
     }
 }
 
-void PanBnep::SendBnepDataEvent(EthernetHeader ethernetHeader, int dataLength, int offset, uint8_t *data)
+void PanBnep::SendBnepDataEvent(EthernetHeader ethernetHeader, int dataLength, int offset,
+    const std::shared_ptr<std::unique_ptr<uint8_t[]>> &recvData)
 {
     PanMessage event(PAN_INT_DATA_EVT);
     event.dev_ = address_;
     event.ethernetHeader_ = ethernetHeader;
     if ((dataLength - offset) > 0) {
+        // The payload is passed on in the received buffer, behind the BNEP headers.
         event.dataLength_ = dataLength - offset;
-        std::unique_ptr<uint8_t[]> buff = std::make_unique<uint8_t[]>(event.dataLength_);
-        if (memcpy_s(buff.get(), event.dataLength_, data + offset, event.dataLength_) != EOK) {
-            LOG_ERROR("[PAN BNEP]%{public}s(): memcpy error", __FUNCTION__);
-            return;
-        }
-        event.data_ = std::make_shared<std::unique_ptr<uint8_t[]>>(std::move(buff));
+        event.dataOffset_ = offset;
+        event.data_ = recvData;
     }
     PanService::GetService()->PostEvent(event);
 }
@@ -1293,13 +1288,7 @@ int PanBnep::ProcessBnepEthernetPacketHeader(uint8_t type, EthernetHeader &ether
         }
         offset += BT_ADDRESS_LENGTH;
     } else {
-        uint8_t bluetoothDestAddr[BT_ADDRESS_LENGTH];
-        RawAddress(PanService::GetLocalAddress()).ConvertToUint8(bluetoothDestAddr);
-        PanService::ReverseAddress(bluetoothDestAddr, ethernetHeader.destAddr);
-        if (ethernetHeader.destAddr[0] & 0x01) {
-            LOG_DEBUG("[PAN BNEP]%{public}s():ethernetHeader.destAddr use unicast MAC address", __FUNCTION__);
-            ethernetHeader.destAddr[0] &= ~0x01;
-        }
+        (void)memcpy_s(ethernetHeader.destAddr, BT_ADDRESS_LENGTH, localEthernetAddr_, BT_ADDRESS_LENGTH);
     }
 
     if ((type == BNEP_COMPRESSED_ETHERNET_SRC_ONLY) || (type == BNEP_GENERAL_ETHERNET)) {
@@ -1314,9 +1303,7 @@ int PanBnep::ProcessBnepEthernetPacketHeader(uint8_t type, EthernetHeader &ether
         }
         offset += BT_ADDRESS_LENGTH;
     } else {
-        uint8_t bluetoothSrcAddr[BT_ADDRESS_LENGTH];
-        RawAddress(address_).ConvertToUint8(bluetoothSrcAddr);
-        PanService::ReverseAddress(bluetoothSrcAddr, ethernetHeader.srcAddr);
+        (void)memcpy_s(ethernetHeader.srcAddr, BT_ADDRESS_LENGTH, remoteEthernetAddr_, BT_ADDRESS_LENGTH);
     }
 
     if (dataLength < (BNEP_UINT16_SIZE + offset)) {
@@ -1357,11 +1344,7 @@ void PanBnep::ProcessEvent(const PanMessage &event)
             BnepDisconnectAbnormalCallbackTask(event.l2capInfo_.lcid, event.l2capInfo_.reason);
             break;
         case BNEP_L2CAP_DATA_EVT:
-            if (event.data_ != nullptr) {
-                BnepRecvDataCallbackTask(event.l2capInfo_.lcid, event.data_->get(), event.dataLength_);
-            } else {
-                BnepRecvDataCallbackTask(event.l2capInfo_.lcid, nullptr, 0);
-            }
+            BnepRecvDataCallbackTask(event.l2capInfo_.lcid, event.data_, event.dataLength_);
             break;
         case BNEP_L2CAP_REMOTE_BUSY_EVT:
             BnepRemoteBusyCallbackTask(event.l2capInfo_.lcid, event.l2capInfo_.isBusy);
@@ -69,12 +69,11 @@ public:
     /**
      * @brief This function used to send data to remote device.
      * @param ethernetHeader The ethernet information.
-     * @param length The data length.
-     * @param pkt The send data.
+     * @param payload The send data, taken as the packet payload without copying. May be null.
      *
      * @return Returns the result.
      */
-    int SendData(EthernetHeader ethernetHeader, uint8_t* pkt, int length);
+    int SendData(EthernetHeader ethernetHeader, Buffer *payload);
 
     /**
      * @brief This function used to get the local cid.
@@ -228,7 +227,8 @@ private:
     void BnepRecvDisconnectionReqCallbackTask(uint16_t lcid, uint8_t id);
     void BnepRecvDisconnectionRspCallbackTask(uint16_t lcid);
     void BnepDisconnectAbnormalCallbackTask(uint16_t lcid, uint8_t reason);
-    void BnepRecvDataCallbackTask(uint16_t lcid, uint8_t *data, int dataLength);
+    void BnepRecvDataCallbackTask(
+        uint16_t lcid, const std::shared_ptr<std::unique_ptr<uint8_t[]>> &recvData, int dataLength);
     void BnepRemoteBusyCallbackTask(uint16_t lcid, uint8_t isBusy);
     int SendGapRequestSecurity(bool isIncoming, uint16_t lcid, uint8_t id);
 
@@ -251,7 +251,8 @@ private:
     int BnepBuildEthernetPacketHeader(uint8_t type, EthernetHeader ethernetHeader, uint8_t *buf);
     bool CheckBnepEthernetDataFilter(EthernetHeader ethernetHeader, uint8_t* pkt, int length);
     void AddPacketToWaitingSendDataList(Packet *addPacket);
-    void SendBnepDataEvent(EthernetHeader ethernetHeader, int dataLength, int offset, uint8_t *data);
+    void SendBnepDataEvent(EthernetHeader ethernetHeader, int dataLength, int offset,
+        const std::shared_ptr<std::unique_ptr<uint8_t[]>> &recvData);
 
     // Regist l2cap callback
     static constexpr L2capService BNEP_CALLBACK = {
@@ -267,6 +268,9 @@ private:
     };
 
     std::string address_;
+    // local and remote address as ethernet addresses, to pick compressed headers without conversions.
+    uint8_t localEthernetAddr_[BT_ADDRESS_LENGTH] = {0};
+    uint8_t remoteEthernetAddr_[BT_ADDRESS_LENGTH] = {0};
     uint8_t state_;      /* Device state */
     uint16_t lcid_;
     uint16_t id_;
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pan_frame_io.h"
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include "securec.h"
+
+namespace OHOS {
+namespace bluetooth {
+PanFrameIo::~PanFrameIo()
+{
+    BufferFree(pool_);
+}
+
+int PanFrameIo::ReadFrames(int fd, std::vector<PanFrame> &frames)
+{
+    int count = 0;
+    while (count < static_cast<int>(MAX_FRAMES_PER_READ)) {
+        if ((pool_ == nullptr) || (BufferGetSize(pool_) - poolUsed_ < PAN_MAX_NETWORK_PACKET_SIZE)) {
+            // Payloads still queued for BNEP keep the old buffer alive through their slices.
+            BufferFree(pool_);
+            pool_ = BufferMalloc(PAN_MAX_NETWORK_PACKET_SIZE * POOL_FRAMES);
+            poolUsed_ = 0;
+            if (pool_ == nullptr) {
+                LOG_ERROR("[Pan Network]%{public}s(): no memory for frames", __FUNCTION__);
+                return (count > 0) ? count : -1;
+            }
+        }
+
+        uint8_t *frame = static_cast<uint8_t *>(BufferPtr(pool_)) + poolUsed_;
+        ssize_t frameSize;
+        do {
+        } while ((frameSize = read(fd, frame, PAN_MAX_NETWORK_PACKET_SIZE)) == -1 && errno == EINTR);
+        if (frameSize < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (frameSize <= 0) {
+            LOG_ERROR("[Pan Network]%{public}s():read err", __FUNCTION__);
+            return (count > 0) ? count : -1;
+        }
+        count++;
+        // Frames that are dropped leave their space in the pool to the next one.
+        if (frameSize <= static_cast<ssize_t>(sizeof(EthernetHeader))) {
+            continue;
+        }
+        PanFrame panFrame;
+        if (memcpy_s(&panFrame.head, sizeof(panFrame.head), frame, sizeof(panFrame.head)) != EOK) {
+            LOG_ERROR("[Pan Network]%{public}s(): memcpy error", __FUNCTION__);
+            continue;
+        }
+        uint16_t protocol = ntohs(panFrame.head.protocol);
+        if ((protocol != ETH_P_IP) && (protocol != ETH_P_ARP) && (protocol != ETH_P_IPV6)) {
+            LOG_ERROR("[Pan Network]%{public}s(): unknown protocol 0x%{public}x", __FUNCTION__, protocol);
+            continue;
+        }
+        panFrame.head.protocol = protocol;
+        panFrame.payload = SharePayload(BufferSliceMalloc(
+            pool_, poolUsed_ + sizeof(EthernetHeader), static_cast<uint32_t>(frameSize) - sizeof(EthernetHeader)));
+        if (panFrame.payload == nullptr) {
+            continue;
+        }
+        poolUsed_ += static_cast<uint32_t>(frameSize);
+        frames.push_back(std::move(panFrame));
+    }
+    return count;
+}
+
+int PanFrameIo::WriteFrame(int fd, EthernetHeader head, const uint8_t *data, size_t len)
+{
+    if (len > (PAN_MAX_NETWORK_PACKET_SIZE - sizeof(head))) {
+        LOG_ERROR("[Pan Network]%{public}s(): data length is exceeded limit", __FUNCTION__);
+        return PAN_FAILURE;
+    }
+    head.protocol = htons(head.protocol);
+    struct iovec iov[] = {
+        {&head, sizeof(head)},
+        {const_cast<uint8_t *>(data), (data != nullptr) ? len : 0},
+    };
+    ssize_t ret;
+    do {
+    } while ((ret = writev(fd, iov, sizeof(iov) / sizeof(iov[0]))) == -1 && errno == EINTR);
+    if (ret < 0) {
+        int rtn = errno;
+        LOG_ERROR("[Pan Network]%{public}s(): Cannot write to :%{public}s", __FUNCTION__, strerror(errno));
+        return rtn;
+    }
+    return PAN_SUCCESS;
+}
+
+std::shared_ptr<Buffer> PanFrameIo::CopyPayload(const uint8_t *data, size_t len)
+{
+    if ((data == nullptr) || (len == 0)) {
+        return nullptr;
+    }
+    Buffer *buf = BufferMalloc(static_cast<uint32_t>(len));
+    if (buf == nullptr) {
+        return nullptr;
+    }
+    if (memcpy_s(BufferPtr(buf), len, data, len) != EOK) {
+        BufferFree(buf);
+        return nullptr;
+    }
+    return SharePayload(buf);
+}
+
+std::shared_ptr<Buffer> PanFrameIo::SharePayload(Buffer *buf)
+{
+    if (buf == nullptr) {
+        return nullptr;
+    }
+    return std::shared_ptr<Buffer>(buf, BufferFree);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
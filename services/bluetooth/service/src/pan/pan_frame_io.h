@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PAN_FRAME_IO_H
+#define PAN_FRAME_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "base_def.h"
+#include "buffer.h"
+#include "pan_defines.h"
+
+namespace OHOS {
+namespace bluetooth {
+/**
+ * @brief An Ethernet frame read from the network, the payload is shared and not copied.
+ */
+struct PanFrame {
+    EthernetHeader head {};
+    std::shared_ptr<Buffer> payload {nullptr};
+};
+
+/**
+ * @brief Frame I/O on the PAN network device.
+ *
+ * Frames are read straight into a pooled buffer, each payload is a slice of it that the BNEP packet takes as its
+ * payload. Frames are written with writev() from the header and the received payload.
+ */
+class PanFrameIo {
+public:
+    // Frames taken from the device per poll wakeup, below BNEP_MAX_WAITING_SEND_DATA_LIST_NUMBER.
+    static const size_t MAX_FRAMES_PER_READ = 16;
+    // Frames of PAN_MAX_NETWORK_PACKET_SIZE that fit into one pooled buffer.
+    static const size_t POOL_FRAMES = 32;
+
+    PanFrameIo() = default;
+    ~PanFrameIo();
+
+    /**
+     * @brief Read the frames ready on the device without blocking.
+     *
+     * @param fd Network device, non-blocking.
+     * @param frames Frames with a known protocol and a payload are appended.
+     * @return Number of frames read, including dropped ones. -1 if the device failed before any frame was read.
+     */
+    int ReadFrames(int fd, std::vector<PanFrame> &frames);
+
+    /**
+     * @brief Write one frame to the device.
+     *
+     * @param fd Network device.
+     * @param head Ethernet header, protocol in host order.
+     * @param data Frame payload.
+     * @param len Payload length.
+     * @return PAN_SUCCESS, or errno if the write failed.
+     */
+    static int WriteFrame(int fd, EthernetHeader head, const uint8_t *data, size_t len);
+
+    /**
+     * @brief Wrap a copy of data as a frame payload.
+     *
+     * @param data Payload.
+     * @param len Payload length.
+     * @return Shared payload, nullptr if len is 0.
+     */
+    static std::shared_ptr<Buffer> CopyPayload(const uint8_t *data, size_t len);
+
+private:
+    static std::shared_ptr<Buffer> SharePayload(Buffer *buf);
+
+    // pooled read buffer, frame payloads hold slices of it.
+    Buffer *pool_ {nullptr};
+    uint32_t poolUsed_ {0};
+
+    BT_DISALLOW_COPY_AND_ASSIGN(PanFrameIo);
+};
+}  // namespace bluetooth
+}  // namespace OHOS
+
+#endif  // PAN_FRAME_IO_H
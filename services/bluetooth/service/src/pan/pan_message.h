@@ -21,6 +21,7 @@
 #include "message.h"
 #include "securec.h"
 #include "pan_defines.h"
+#include "pan_frame_io.h"
 
 namespace OHOS {
 namespace bluetooth {
@@ -33,7 +34,9 @@ public:
         ethernetHeader_(src.ethernetHeader_),
         l2capInfo_(src.l2capInfo_),
         data_(src.data_),
-        dataLength_(src.dataLength_)
+        dataLength_(src.dataLength_),
+        dataOffset_(src.dataOffset_),
+        frames_(src.frames_)
     {
     }
     ~PanMessage() = default;
@@ -42,6 +45,10 @@ public:
     PanL2capConnectionInfo l2capInfo_ {};
     std::shared_ptr<std::unique_ptr<uint8_t[]>> data_ = nullptr;
     int dataLength_ = 0;
+    // offset of dataLength_ bytes in data_, so that a payload shares the received data.
+    int dataOffset_ = 0;
+    // frames read from the network, sent to the device as a batch.
+    std::shared_ptr<std::vector<PanFrame>> frames_ = nullptr;
 
     PanMessage operator=(const PanMessage &src)
     {
@@ -51,6 +58,8 @@ public:
             l2capInfo_ = src.l2capInfo_;
             data_ = src.data_;
             dataLength_ = src.dataLength_;
+            dataOffset_ = src.dataOffset_;
+            frames_ = src.frames_;
         }
         return *this;
     }
@@ -297,34 +297,14 @@ int PanNetwork::ReceiveRemoteBusy(bool isBusy)
 
 int PanNetwork::WriteData(EthernetHeader head, uint8_t *data, int len)
 {
-    LOG_DEBUG("[Pan Network]%{public}s(): len=%{public}d", __FUNCTION__, len);
     if (fd_ < 0) {
         LOG_ERROR("[Pan Network]%{public}s(): fd is not open", __FUNCTION__);
         return PAN_FAILURE;
     }
-    ssize_t ret;
-    uint8_t packet[PAN_MAX_NETWORK_PACKET_SIZE] = {0};
-    head.protocol = htons(head.protocol);
-    if (memcpy_s(packet, PAN_MAX_NETWORK_PACKET_SIZE, &head, sizeof(head)) != EOK) {
-        LOG_ERROR("[Pan Network]%{public}s(): memcpy error", __FUNCTION__);
-        return PAN_FAILURE;
-    }
-    if (len > (PAN_MAX_NETWORK_PACKET_SIZE - sizeof(head))) {
-        LOG_ERROR("[Pan Network]%{public}s(): data length is exceeded limit", __FUNCTION__);
+    if (len < 0) {
         return PAN_FAILURE;
     }
-    if (memcpy_s(packet + sizeof(head), PAN_MAX_NETWORK_PACKET_SIZE - sizeof(head), data, len) != EOK) {
-        LOG_ERROR("[Pan Network]%{public}s(): memcpy error", __FUNCTION__);
-        return PAN_FAILURE;
-    }
-    do {
-    } while ((ret = write(fd_, packet, len + sizeof(head))) == -1 && errno == EINTR);
-    if (ret < 0) {
-        int rtn = errno;
-        LOG_ERROR("[Pan Network]%{public}s(): Cannot write to :%{public}s", __FUNCTION__, strerror(errno));
-        return rtn;
-    }
-    return PAN_SUCCESS;
+    return PanFrameIo::WriteFrame(fd_, head, data, static_cast<size_t>(len));
 }
 
 pthread_t PanNetwork::CreateThread(void* (*startRoutine)(void*), void* arg)
@@ -378,7 +358,6 @@ void PanNetwork::PollEventThread_()
             break;
         }
         if (pfds[0].revents & POLLIN) {
-            LOG_DEBUG("[Pan Network]%{public}s(): POLLIN", __FUNCTION__);
             ReadPanNetworkEvent();
         }
     }
@@ -406,35 +385,12 @@ void PanNetwork::SetPanNetworkNonBlocking(int fd)
 
 int PanNetwork::ReadPanNetworkEvent()
 {
-    uint8_t packet[PAN_MAX_NETWORK_PACKET_SIZE] = {0};
-    ssize_t packetSize;
-
-    do {
-    } while ((packetSize = read(fd_, &packet, sizeof(packet))) == -1 && errno == EINTR);
-
-    if (packetSize <= 0) {
-        LOG_ERROR("[Pan Network]%{public}s():read err", __FUNCTION__);
-        return PAN_FAILURE;
-    }
-    if (packetSize > PAN_MAX_NETWORK_PACKET_SIZE) {
-        LOG_ERROR("[Pan Network]%{public}s():packet size is too large packetSize=%{public}zu",
-            __FUNCTION__, packetSize);
+    std::vector<PanFrame> frames;
+    if (frameIo_.ReadFrames(fd_, frames) < 0) {
         return PAN_FAILURE;
     }
-    if (packetSize > sizeof(EthernetHeader)) {
-        EthernetHeader head;
-        if (memcpy_s(&head, sizeof(head), &packet, sizeof(head)) != EOK) {
-            LOG_ERROR("[Pan Network]%{public}s(): memcpy error", __FUNCTION__);
-            return PAN_FAILURE;
-        }
-        uint16_t protocol = ntohs(head.protocol);
-        if ((protocol != ETH_P_IP) && (protocol != ETH_P_ARP) && (protocol != ETH_P_IPV6)) {
-            LOG_ERROR("[Pan Network]%{public}s(): unknown protocol 0x%{public}x", __FUNCTION__, protocol);
-            return PAN_FAILURE;
-        }
-        head.protocol = protocol;
-
-        PanService::GetService()->PanSendData(head, packet + sizeof(head), packetSize - sizeof(head));
+    if (!frames.empty()) {
+        PanService::GetService()->PanSendData(frames);
     }
     return PAN_SUCCESS;
 }
@@ -25,6 +25,7 @@
 #include <string>
 #include "base_def.h"
 #include "pan_defines.h"
+#include "pan_frame_io.h"
 #include "raw_address.h"
 
 namespace OHOS {
@@ -63,6 +64,7 @@ private:
     bool isRemoteDeviceBusy_ = false;
     std::mutex mutexBusyChanged_;
     std::condition_variable cvWaitBusyChanged_;
+    PanFrameIo frameIo_;
 
     BT_DISALLOW_COPY_AND_ASSIGN(PanNetwork);
 };
@@ -264,22 +264,29 @@ void PanService::WriteNetworkData(std::string address, EthernetHeader head, uint
     panNetwork_->WriteData(head, data, len);
 }
 
-int PanService::PanSendData(EthernetHeader head, uint8_t *data, int len)
+int PanService::PanSendData(std::vector<PanFrame> &frames)
 {
-    int isBroadcast = head.destAddr[0] & 1;
-    uint8_t bluetoothDestAddr[BT_ADDRESS_LENGTH];
-    uint8_t bluetoothSrcAddr[BT_ADDRESS_LENGTH];
-    ReverseAddress(head.destAddr, bluetoothDestAddr);
-    ReverseAddress(head.srcAddr, bluetoothSrcAddr);
-    std::string destAddr = RawAddress::ConvertToString(bluetoothDestAddr).GetAddress();
-    std::string srcAddr = RawAddress::ConvertToString(bluetoothSrcAddr).GetAddress();
+    // One event per device for all frames of a network wakeup.
+    std::map<std::string, std::vector<PanFrame>> deviceFrames;
+    for (auto &frame : frames) {
+        int isBroadcast = frame.head.destAddr[0] & 1;
+        uint8_t bluetoothDestAddr[BT_ADDRESS_LENGTH];
+        uint8_t bluetoothSrcAddr[BT_ADDRESS_LENGTH];
+        ReverseAddress(frame.head.destAddr, bluetoothDestAddr);
+        ReverseAddress(frame.head.srcAddr, bluetoothSrcAddr);
+        std::string destAddr = RawAddress::ConvertToString(bluetoothDestAddr).GetAddress();
+        std::string srcAddr = RawAddress::ConvertToString(bluetoothSrcAddr).GetAddress();
 
-    for (auto it = stateMachines_.begin(); it != stateMachines_.end(); it++) {
-        if ((it->second->GetDeviceStateInt() == PAN_STATE_CONNECTED) &&
-            (isBroadcast || (destAddr == it->first) || (srcAddr == it->first))) {
-            PanSendData(it->first, head, data, len);
+        for (auto it = stateMachines_.begin(); it != stateMachines_.end(); it++) {
+            if ((it->second->GetDeviceStateInt() == PAN_STATE_CONNECTED) &&
+                (isBroadcast || (destAddr == it->first) || (srcAddr == it->first))) {
+                deviceFrames[it->first].push_back(frame);
+            }
         }
     }
+    for (auto &device : deviceFrames) {
+        PanSendFrames(device.first, std::move(device.second));
+    }
     return PAN_SUCCESS;
 }
 
@@ -292,18 +299,23 @@ void PanService::ReverseAddress(uint8_t *oldAddr, uint8_t *newAddr)
 
 void PanService::PanSendData(std::string address, EthernetHeader head, uint8_t *data, int len)
 {
-    PanMessage event(PAN_API_WRITE_DATA_EVT);
-    event.dev_ = address;
-    event.ethernetHeader_ = head;
+    PanFrame frame;
+    frame.head = head;
     if ((len > 0) && (data != nullptr)) {
-        event.dataLength_ = len;
-        std::unique_ptr<uint8_t[]> buff = std::make_unique<uint8_t[]>(event.dataLength_);
-        if (memcpy_s(buff.get(), len, data, len) != EOK) {
+        frame.payload = PanFrameIo::CopyPayload(data, len);
+        if (frame.payload == nullptr) {
             LOG_ERROR("[PAN Service]%{public}s(): memcpy error", __FUNCTION__);
             return;
         }
-        event.data_ = std::make_shared<std::unique_ptr<uint8_t[]>>(std::move(buff));
     }
+    PanSendFrames(address, std::vector<PanFrame> {frame});
+}
+
+void PanService::PanSendFrames(const std::string &address, std::vector<PanFrame> frames)
+{
+    PanMessage event(PAN_API_WRITE_DATA_EVT);
+    event.dev_ = address;
+    event.frames_ = std::make_shared<std::vector<PanFrame>>(std::move(frames));
     PostEvent(event);
 }
 
@@ -442,7 +454,11 @@ void PanService::ProcessEvent(const PanMessage &event)
 {
     std::lock_guard<std::recursive_mutex> lk(mutex_);
     std::string address = event.dev_;
-    HILOGE("[PAN Service] address[%{public}s] event_no[%{public}d]", GetEncryptAddr(address).c_str(), event.what_);
+    if ((event.what_ != PAN_API_WRITE_DATA_EVT) && (event.what_ != PAN_INT_DATA_EVT) &&
+        (event.what_ != BNEP_L2CAP_DATA_EVT)) {
+        HILOGE("[PAN Service] address[%{public}s] event_no[%{public}d]", GetEncryptAddr(address).c_str(),
+            event.what_);
+    }
     switch (event.what_) {
         case PAN_SERVICE_STARTUP_EVT:
             StartUp();
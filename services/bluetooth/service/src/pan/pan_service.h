@@ -95,7 +95,7 @@ public:
     void CloseNetwork(std::string device);
     void WriteNetworkData(std::string address, EthernetHeader head, uint8_t *data, int len);
     int ReceiveRemoteBusy(bool isBusy);
-    int PanSendData(EthernetHeader head, uint8_t *data, int len);
+    int PanSendData(std::vector<PanFrame> &frames);
 
     static void ReverseAddress(uint8_t *oldAddr, uint8_t *newAddr);
 
@@ -123,6 +123,7 @@ private:
     void ProcessDefaultEvent(const PanMessage &event) const;
     void ProcessRemoveStateMachine(const std::string &address);
     void PanSendData(std::string address, EthernetHeader head, uint8_t *data, int len);
+    void PanSendFrames(const std::string &address, std::vector<PanFrame> frames);
     //  service status
     bool isStarted_ {false};
     //  service status
@@ -247,7 +247,7 @@ void PanStateMachine::ProcessReciveData(const PanMessage &msg)
     uint8_t* data = nullptr;
     int dataLength = 0;
     if (msg.data_ != nullptr) {
-        data = msg.data_->get();
+        data = msg.data_->get() + msg.dataOffset_;
         dataLength = msg.dataLength_;
     }
     PanService::GetService()->WriteNetworkData(address_, msg.ethernetHeader_, data, dataLength);
@@ -255,13 +255,12 @@ void PanStateMachine::ProcessReciveData(const PanMessage &msg)
 
 void PanStateMachine::ProcessSendData(const PanMessage &msg)
 {
-    uint8_t* data = nullptr;
-    int dataLength = 0;
-    if (msg.data_ != nullptr) {
-        data = msg.data_->get();
-        dataLength = msg.dataLength_;
+    if (msg.frames_ == nullptr) {
+        return;
+    }
+    for (auto &frame : *msg.frames_) {
+        panBnep_.SendData(frame.head, frame.payload.get());
     }
-    panBnep_.SendData(msg.ethernetHeader_, data, dataLength);
 }
 
 void PanStateMachine::ProcessOpenComplete(const PanMessage &msg)
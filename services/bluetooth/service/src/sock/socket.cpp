@@ -14,7 +14,6 @@
  */
 
 #include "socket.h"
-#include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
@@ -199,12 +198,6 @@ void Socket::impl::OnDisconnectSuccessNative(Socket &socket, DataTransport *tran
 
 void Socket::impl::OnDataAvailableNative(Socket &socket, DataTransport *transport)
 {
-    LOG_INFO("[sock]%{public}s", __func__);
-
-    Packet *pkt = nullptr;
-    uint8_t *pData = nullptr;
-    Buffer *buf = nullptr;
-
     Socket *socketTmp = nullptr;
     if (socket.IsServer()) {
         if (socket.socketMap_.find(transport) != socket.socketMap_.end()) {
@@ -222,35 +215,7 @@ void Socket::impl::OnDataAvailableNative(Socket &socket, DataTransport *transpor
         return;
     }
 
-    if (socketTmp->isNewSocket_) {
-        if (socketTmp->newSockTransport_ != nullptr) {
-            socketTmp->newSockTransport_->Read(&pkt);
-        } else {
-            LOG_DEBUG("[sock]%{public}s newSockTransport is null", __func__);
-            return;
-        }
-    } else {
-        socketTmp->sockTransport_->Read(&pkt);
-    }
-
-    if (pkt == nullptr) {
-        LOG_ERROR("[sock]%{public}s pkt is null", __func__);
-        return;
-    }
-
-    size_t len = PacketPayloadSize(pkt);
-    buf = PacketContinuousPayload(pkt);
-    if (buf == nullptr) {
-        LOG_ERROR("[sock]%{public}s pkt buf is null", __func__);
-        return;
-    }
-    pData = (uint8_t *)BufferPtr(buf);
-
-    socketTmp->WriteDataToAPP(pData, len);
-
-    if (pkt != nullptr) {
-        PacketFree(pkt);
-    }
+    socketTmp->ReadData();
 }
 
 void Socket::impl::OnTransportErrorNative(Socket &socket, DataTransport *transport, int errType)
@@ -314,7 +279,7 @@ void Socket::impl::SockRfcDisconnectFail(Socket &socket, DataTransport *transpor
 
 void Socket::impl::SockRfcFcOn(Socket &socket, DataTransport *transport)
 {
-    LOG_INFO("[sock]%{public}s", __func__);
+    LOG_DEBUG("[sock]%{public}s", __func__);
 
     Socket *socketTmp = nullptr;
     if (socket.IsServer()) {
@@ -330,33 +295,10 @@ void Socket::impl::SockRfcFcOn(Socket &socket, DataTransport *transport)
         return;
     }
     std::lock_guard<std::recursive_mutex> lk(socketTmp->writeMutex_);
-    if (socketTmp->sendBufLen_ > 0) {
-        Packet *wPkt = PacketMalloc(0, 0, socketTmp->sendBufLen_);
-        Buffer *wPayloadBuf = PacketContinuousPayload(wPkt);
-        void *buffer = BufferPtr(wPayloadBuf);
-        (void)memcpy_s(buffer, socketTmp->sendBufLen_, socketTmp->sendDataBuf_, socketTmp->sendBufLen_);
-        if (wPayloadBuf == nullptr) {
-            if (wPkt != nullptr) {
-                PacketFree(wPkt);
-            }
-            return;
-        }
-        int ret = socketTmp->TransportWrite(wPkt);
-        if (ret < 0) {
-            LOG_ERROR("%{public}s stack write failed", __func__);
-        } else {
-            (void)memset_s(socketTmp->sendDataBuf_, socketTmp->sendBufLen_, 0x00, socketTmp->sendBufLen_);
-            socketTmp->sendBufLen_ = 0;
-            socketTmp->isCanWrite_ = true;
-            socketTmp->WriteData();
-        }
-        if (wPkt != nullptr) {
-            PacketFree(wPkt);
-        }
-    } else {
-        socketTmp->isCanWrite_ = true;
-        socketTmp->WriteData();
-    }
+    socketTmp->isCanWrite_ = true;
+    SocketThread::GetInstance().SetReadPaused(*socketTmp, false);
+    // Packets the stack refused are still queued and go first.
+    socketTmp->WriteData();
 }
 
 int Socket::impl::GetMaxConnectionDevicesNum()
@@ -671,7 +613,6 @@ void Socket::OnSocketReadReady(Socket &sock)
 
     std::lock_guard<std::recursive_mutex> lck(sock.writeMutex_);
     if (sock.isCanWrite_) {
-        LOG_INFO("[sock]%{public}s socket write data", __func__);
         sock.WriteData();
     }
 }
@@ -696,105 +637,49 @@ void Socket::OnSocketWriteReady(Socket &sock)
 
 void Socket::OnSocketWriteReadyNative(Socket &sock)
 {
-    LOG_INFO("[sock]%{public}s", __func__);
+    LOG_DEBUG("[sock]%{public}s", __func__);
 
     sock.isCanRead_ = true;
-
-    if (sock.recvBufLen_ == 0) {
-        LOG_INFO("[sock]%{public}s recvbuf has been send", __func__);
+    if (sock.SendQueuedToApp()) {
         sock.ReadData();
-        return;
-    }
-
-    SocketSendRet sendRet = SendDataToApp(sock.transportFd_, sock.recvDataBuf_, sock.recvBufLen_);
-    switch (sendRet) {
-        case SOCKET_SEND_NONE:
-        case SOCKET_SEND_PARTIAL:
-            sock.isCanRead_ = false;
-            SocketThread::GetInstance().AddSocket(
-                sock.transportFd_, 1, sock);
-            break;
-        case SOCKET_SEND_ERROR:
-            sock.isCanRead_ = false;
-            LOG_INFO("[sock]%{public}s close socket", __func__);
-            SocketThread::GetInstance().DeleteSocket(sock);
-            sock.CloseSocket(false);
-            break;
-        case SOCKET_SEND_ALL:
-            sock.isCanRead_ = true;
-            (void)memset_s(sock.recvDataBuf_, SOCK_DEF_RFC_MTU, 0, SOCK_DEF_RFC_MTU);
-            sock.ReadData();
-            LOG_INFO("[sock]%{public}s send data success", __func__);
-            break;
-        default:
-            break;
     }
 }
 
 void Socket::ReadData()
 {
-    Packet *pkt = nullptr;
-    uint8_t *pData = nullptr;
-    Buffer *buf = nullptr;
-
-    while (true) {
-        if (!this->isCanRead_) {
-            LOG_DEBUG("[sock]%{public}s can not read.", __func__);
+    while (this->isCanRead_) {
+        DataTransport *transport = this->isNewSocket_ ? this->newSockTransport_ : this->sockTransport_.get();
+        if (transport == nullptr) {
+            LOG_DEBUG("[sock]%{public}s transport is null", __func__);
             return;
         }
-
-        if (this->isNewSocket_) {
-            if (this->newSockTransport_ == nullptr) {
-                LOG_DEBUG("[sock]%{public}s newSockTransport is null", __func__);
-                return;
-            }
-            if (this->newSockTransport_->Read(&pkt) != 0) {
-                break;
-            }
-        } else {
-            if (this->sockTransport_->Read(&pkt) != 0) {
+        // Bounded, so that Rfcomm stops being read and holds the remote back while the app is slow.
+        while (this->bridge_.GetAppQueueSize() < SocketBridge::MAX_APP_PACKETS) {
+            Packet *pkt = nullptr;
+            if (transport->Read(&pkt) != 0 || pkt == nullptr) {
                 break;
             }
+            this->bridge_.QueueToApp(pkt);
         }
-
-        if (pkt == nullptr) {
-            LOG_ERROR("[sock]%{public}s pkt is null", __func__);
+        if (this->bridge_.GetAppQueueSize() == 0) {
             return;
         }
-
-        size_t len = PacketPayloadSize(pkt);
-        if (len == 0) {
-            break;
-        }
-        buf = PacketContinuousPayload(pkt);
-        if (buf != nullptr) {
-            pData = (uint8_t *)BufferPtr(buf);
-        }
-        if (pData == nullptr) {
+        if (!this->SendQueuedToApp()) {
             return;
         }
-
-        this->WriteDataToAPP(pData, len);
-
-        if (pkt != nullptr) {
-            PacketFree(pkt);
-            pkt = nullptr;
-        }
     }
 }
 
-void Socket::WriteDataToAPP(const uint8_t *buffer, size_t len)
+bool Socket::SendQueuedToApp()
 {
-    LOG_INFO("[sock]%{public}s", __func__);
-
-    SocketSendRet sendRet = SendDataToApp(this->transportFd_, buffer, len);
+    SocketSendRet sendRet = this->bridge_.SendToApp(this->transportFd_);
     switch (sendRet) {
+        case SOCKET_SEND_ALL:
+            return true;
         case SOCKET_SEND_NONE:
         case SOCKET_SEND_PARTIAL:
-            LOG_INFO("[sock]%{public}s SOCKET_SEND_PARTIAL", __func__);
+            // The rest stays queued until the poll thread reports the app socket writable.
             this->isCanRead_ = false;
-            (void)memcpy_s(this->recvDataBuf_, SOCK_DEF_RFC_MTU, buffer, len);
-            this->recvBufLen_ = len;
             SocketThread::GetInstance().AddSocket(this->transportFd_, 1, *this);
             break;
         case SOCKET_SEND_ERROR:
@@ -803,76 +688,45 @@ void Socket::WriteDataToAPP(const uint8_t *buffer, size_t len)
             SocketThread::GetInstance().DeleteSocket(*this);
             this->CloseSocket(false);
             break;
-        case SOCKET_SEND_ALL:
-            this->isCanRead_ = true;
-            LOG_INFO("[sock]%{public}s send data success", __func__);
-            break;
         default:
             break;
     }
+    return false;
 }
 
 void Socket::WriteData()
 {
-    LOG_INFO("[sock]%{public}s", __func__);
-
-    int totalSize = 0;
-
-    {
-        std::lock_guard<std::mutex> lock(fdMutex_);
-        if (ioctl(this->transportFd_, FIONREAD, &totalSize) != 0) {
-            LOG_ERROR("[sock]%{public}s ioctl read fd error", __func__);
+    if (this->bridge_.FrontToStack() == nullptr) {
+        ssize_t received;
+        {
+            std::lock_guard<std::mutex> lock(fdMutex_);
+            received = this->bridge_.ReadFromApp(this->transportFd_, this->sendMTU_);
+        }
+        if (received <= 0) {
+            // A closed app socket is reported by the poll thread.
             return;
         }
     }
 
-    if (totalSize == 0) {
-        LOG_DEBUG("[sock]%{public}s recv buffer has no data", __func__);
-        return;
-    }
-
-    LOG_INFO("[sock]%{public}s totalSize:%{public}d", __func__, totalSize);
-
-    while (totalSize > 0) {
-        if (this->isCanWrite_) {
-            int mallocSize = (totalSize > this->sendMTU_) ? this->sendMTU_ : totalSize;
-
-            Packet *wPkt = PacketMalloc(0, 0, mallocSize);
-            if (wPkt == nullptr) {
-                LOG_INFO("[sock]pkt is null");
-                return;
-            }
-            Buffer *wPayloadBuf = PacketContinuousPayload(wPkt);
-            void *buffer = BufferPtr(wPayloadBuf);
-
-            int wbytes = read(this->transportFd_, buffer, mallocSize);
-            LOG_INFO("[sock]%{public}s wbytes:%{public}d", __func__, wbytes);
-            if (wbytes <= 0) {
-                LOG_DEBUG("[sock]%{public}s socket fd exception", __func__);
-                PacketFree(wPkt);
-                return;
-            }
-            int ret = TransportWrite(wPkt);
-            if (ret < 0) {
-                LOG_DEBUG("[sock]%{public}s stack write failed", __func__);
-                (void)memcpy_s(this->sendDataBuf_, wbytes, buffer, wbytes);
-                this->sendBufLen_ = wbytes;
-                this->isCanWrite_ = false;
-                PacketFree(wPkt);
-                return;
-            }
-            totalSize -= wbytes;
-            PacketFree(wPkt);
-        } else {
+    while (this->isCanWrite_) {
+        Packet *pkt = this->bridge_.FrontToStack();
+        if (pkt == nullptr) {
+            // More data wakes the poll thread again.
+            return;
+        }
+        if (TransportWrite(pkt) < 0) {
+            LOG_DEBUG("[sock]%{public}s stack write failed", __func__);
+            // Kept queued until RFCOMM_EV_FC_ON, the app socket is not polled meanwhile.
+            this->isCanWrite_ = false;
+            SocketThread::GetInstance().SetReadPaused(*this, true);
             return;
         }
+        this->bridge_.PopToStack();
     }
 }
 
 int Socket::TransportWrite(Packet *subPkt)
 {
-    LOG_INFO("[sock]%{public}s", __func__);
-
     RawAddress rawAddr = RawAddress::ConvertToString(this->remoteAddr_.addr);
     IPowerManager::GetInstance().StatusUpdate(RequestStatus::BUSY, PROFILE_NAME_SPP, rawAddr);
 
@@ -938,33 +792,6 @@ void Socket::FreeServiceId(GAP_Service serviceId)
     }
 }
 
-SocketSendRet Socket::SendDataToApp(int fd, const uint8_t *buf, size_t len)
-{
-    LOG_INFO("[sock]%{public}s", __func__);
-
-#ifdef DARWIN_PLATFORM
-    auto sendRet = send(fd, buf, len, MSG_DONTWAIT);
-#else
-    auto sendRet = send(fd, buf, len, MSG_NOSIGNAL);
-#endif
-    if (sendRet < 0) {
-        if ((errno == EAGAIN || errno == EWOULDBLOCK)) {
-            return SOCKET_SEND_NONE;
-        }
-        return SOCKET_SEND_ERROR;
-    }
-
-    if (sendRet == 0) {
-        return SOCKET_SEND_ERROR;
-    }
-
-    if (sendRet == ssize_t(len)) {
-        return SOCKET_SEND_ALL;
-    }
-
-    return SOCKET_SEND_PARTIAL;
-}
-
 void Socket::NotifyServiceDeleteSocket(Socket &sock)
 {
     LOG_INFO("[sock]%{public}s", __func__);
@@ -25,6 +25,7 @@
 #include "transport/transport_factory.h"
 #include "transport/transport_rfcomm.h"
 
+#include "socket_bridge.h"
 #include "socket_def.h"
 #include "socket_gap_client.h"
 #include "socket_gap_server.h"
@@ -33,14 +34,6 @@
 
 namespace OHOS {
 namespace bluetooth {
-// result of sending data to app
-typedef enum {
-    SOCKET_SEND_NONE = 0,
-    SOCKET_SEND_ERROR,
-    SOCKET_SEND_PARTIAL,
-    SOCKET_SEND_ALL,
-} SocketSendRet;
-
 /**
  * @brief This Socket class provides a set of methods that client initiates the connection and
  *        server listen and accept the connection.
@@ -168,14 +161,8 @@ private:
     bool isCanWrite_ {true};
     // is or not new socket
     bool isNewSocket_ {false};
-    // length of data that send to app failed.
-    size_t recvBufLen_ {0};
-    // length of data that send to stack failed.
-    size_t sendBufLen_ {0};
-    // save data that sent to app failed.
-    uint8_t recvDataBuf_[SOCK_DEF_RFC_MTU] = {0};
-    // save data that sent to stack failed.
-    uint8_t sendDataBuf_[SOCK_DEF_RFC_MTU] = {0};
+    // data received from Rfcomm not yet taken by app, and data from app not yet taken by Rfcomm.
+    SocketBridge bridge_ {};
     std::mutex mutex_ {};
     std::mutex fdMutex_ {};
     std::recursive_mutex writeMutex_ {};
@@ -275,16 +262,6 @@ private:
      */
     static void FreeServiceId(GAP_Service serviceId);
 
-    /**
-     * @brief Send data to app.
-     *
-     * @param fd socket fd.
-     * @param buf data to send.
-     * @param len the size of the data to send.
-     * @return SocketSendRet
-     */
-    static SocketSendRet SendDataToApp(int fd, const uint8_t *buf, size_t len);
-
     /**
      * @brief Read data from Rfcomm.
      *
@@ -318,11 +295,11 @@ private:
     static void EraseSocket(Socket &socket);
 
     /**
-     * @brief write data to app
+     * @brief Send the data queued for app, wait for the app socket if it is full.
      *
-     * @param socket
+     * @return Returns <b>true</b> if all queued data has been sent.
      */
-    void WriteDataToAPP(const uint8_t *buffer, size_t len);
+    bool SendQueuedToApp();
 
     /**
      * @brief process disconnect
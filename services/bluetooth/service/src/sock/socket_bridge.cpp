@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "socket_bridge.h"
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <cerrno>
+#include "log.h"
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+#ifdef DARWIN_PLATFORM
+const int SEND_FLAGS = MSG_DONTWAIT;
+#else
+const int SEND_FLAGS = MSG_NOSIGNAL | MSG_DONTWAIT;
+#endif
+}  // namespace
+
+SocketBridge::~SocketBridge()
+{
+    Clear();
+}
+
+void SocketBridge::QueueToApp(Packet *pkt)
+{
+    if (pkt == nullptr) {
+        return;
+    }
+    if (PacketPayloadSize(pkt) == 0) {
+        PacketFree(pkt);
+        return;
+    }
+    toApp_.push_back(pkt);
+}
+
+SocketSendRet SocketBridge::SendToApp(int fd)
+{
+    while (!toApp_.empty()) {
+        struct iovec iov[MAX_IOV];
+        Buffer *segments[MAX_IOV];
+        size_t iovCount = 0;
+        size_t total = 0;
+        size_t skip = toAppOffset_;
+        for (auto it = toApp_.begin(); it != toApp_.end() && iovCount < MAX_IOV; ++it) {
+            uint32_t count = PacketPayloadSegments(*it, segments, MAX_IOV - iovCount);
+            if (count > MAX_IOV) {
+                // Only ever seen with heavily fragmented packets, join them so each fits one call.
+                (void)PacketContinuousPayload(*it);
+                count = PacketPayloadSegments(*it, segments, MAX_IOV - iovCount);
+            }
+            if (count > MAX_IOV - iovCount) {
+                break;
+            }
+            for (uint32_t i = 0; i < count; i++) {
+                size_t size = BufferGetSize(segments[i]);
+                if (skip >= size) {
+                    skip -= size;
+                    continue;
+                }
+                iov[iovCount].iov_base = static_cast<uint8_t *>(BufferPtr(segments[i])) + skip;
+                iov[iovCount].iov_len = size - skip;
+                total += size - skip;
+                skip = 0;
+                iovCount++;
+            }
+        }
+
+        struct msghdr msg = {};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = iovCount;
+        ssize_t sent = sendmsg(fd, &msg, SEND_FLAGS);
+        if (sent < 0) {
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? SOCKET_SEND_NONE : SOCKET_SEND_ERROR;
+        }
+        if (sent == 0) {
+            return SOCKET_SEND_ERROR;
+        }
+
+        size_t left = static_cast<size_t>(sent);
+        while (left > 0) {
+            size_t remain = PacketPayloadSize(toApp_.front()) - toAppOffset_;
+            if (left < remain) {
+                toAppOffset_ += left;
+                break;
+            }
+            left -= remain;
+            PacketFree(toApp_.front());
+            toApp_.pop_front();
+            toAppOffset_ = 0;
+        }
+        if (static_cast<size_t>(sent) < total) {
+            return SOCKET_SEND_PARTIAL;
+        }
+    }
+    return SOCKET_SEND_ALL;
+}
+
+size_t SocketBridge::GetAppQueueSize() const
+{
+    return toApp_.size();
+}
+
+ssize_t SocketBridge::ReadFromApp(int fd, uint16_t mtu)
+{
+    if (mtu == 0) {
+        return -1;
+    }
+    uint32_t capacity = static_cast<uint32_t>(mtu) * READ_BATCH;
+    if (backlog_ == nullptr || BufferGetSize(backlog_) < capacity ||
+        BufferGetSize(backlog_) - backlogUsed_ < mtu) {
+        // Packets still in the stack keep the old buffer alive through their slices.
+        BufferFree(backlog_);
+        backlog_ = BufferMalloc(capacity);
+        backlogUsed_ = 0;
+        if (backlog_ == nullptr) {
+            LOG_ERROR("[sock]%{public}s no memory for %{public}u bytes", __func__, capacity);
+            return -1;
+        }
+    }
+
+    uint8_t *dst = static_cast<uint8_t *>(BufferPtr(backlog_)) + backlogUsed_;
+    ssize_t received = recv(fd, dst, BufferGetSize(backlog_) - backlogUsed_, MSG_DONTWAIT);
+    if (received < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+    if (received == 0) {
+        return -1;
+    }
+
+    for (ssize_t offset = 0; offset < received; offset += mtu) {
+        uint32_t size = static_cast<uint32_t>((received - offset < mtu) ? (received - offset) : mtu);
+        Buffer *slice = BufferSliceMalloc(backlog_, backlogUsed_ + offset, size);
+        Packet *pkt = PacketMalloc(0, 0, 0);
+        if (slice == nullptr || pkt == nullptr) {
+            LOG_ERROR("[sock]%{public}s no memory, %{public}zd bytes dropped", __func__, received - offset);
+            BufferFree(slice);
+            PacketFree(pkt);
+            break;
+        }
+        PacketPayloadAddLast(pkt, slice);
+        BufferFree(slice);
+        toStack_.push_back(pkt);
+    }
+    backlogUsed_ += static_cast<uint32_t>(received);
+    return received;
+}
+
+Packet *SocketBridge::FrontToStack() const
+{
+    return toStack_.empty() ? nullptr : toStack_.front();
+}
+
+void SocketBridge::PopToStack()
+{
+    if (!toStack_.empty()) {
+        PacketFree(toStack_.front());
+        toStack_.pop_front();
+    }
+}
+
+void SocketBridge::Clear()
+{
+    for (Packet *pkt : toApp_) {
+        PacketFree(pkt);
+    }
+    toApp_.clear();
+    toAppOffset_ = 0;
+    for (Packet *pkt : toStack_) {
+        PacketFree(pkt);
+    }
+    toStack_.clear();
+    BufferFree(backlog_);
+    backlog_ = nullptr;
+    backlogUsed_ = 0;
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SOCKET_BRIDGE_H
+#define SOCKET_BRIDGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include "base_def.h"
+#include "buffer.h"
+#include "packet.h"
+#include "socket_def.h"
+
+namespace OHOS {
+namespace bluetooth {
+/**
+ * @brief Moves SPP data between the app socket and stack packets without flattening it.
+ *
+ * Towards the app, received packets are queued and their payload segments are handed to sendmsg() as one iovec,
+ * a partial send leaves the rest queued. Towards the stack, the socket backlog is received in one call into a
+ * pooled buffer that is sliced into MTU-sized packets, which stay queued until the stack accepts them.
+ * The two directions share no state and may be driven from different threads.
+ */
+class SocketBridge {
+public:
+    // Received packets taken from the stack before they are sent to the app.
+    static const size_t MAX_APP_PACKETS = 16;
+    // MTU-sized packets received from the app with one call.
+    static const size_t READ_BATCH = 8;
+
+    SocketBridge() = default;
+    ~SocketBridge();
+
+    /**
+     * @brief Queue a packet received from the stack for the app, the bridge takes ownership.
+     *
+     * @param pkt Received packet.
+     */
+    void QueueToApp(Packet *pkt);
+
+    /**
+     * @brief Send as much of the queued data as the app socket takes, without blocking.
+     *
+     * @param fd Transport side of the app socket pair.
+     * @return SOCKET_SEND_ALL when the queue is empty, SOCKET_SEND_NONE or SOCKET_SEND_PARTIAL when the socket is
+     *         full, SOCKET_SEND_ERROR when it failed.
+     */
+    SocketSendRet SendToApp(int fd);
+
+    /**
+     * @brief Number of packets waiting for the app.
+     */
+    size_t GetAppQueueSize() const;
+
+    /**
+     * @brief Receive the app socket backlog, up to READ_BATCH packets, without blocking.
+     *
+     * @param fd Transport side of the app socket pair.
+     * @param mtu Payload size of each packet.
+     * @return Bytes received, 0 if the socket had no data, -1 if it is closed or failed.
+     */
+    ssize_t ReadFromApp(int fd, uint16_t mtu);
+
+    /**
+     * @brief Oldest packet received from the app and not yet taken by the stack, nullptr if there is none.
+     */
+    Packet *FrontToStack() const;
+
+    /**
+     * @brief Drop the packet returned by FrontToStack(), after the stack took it.
+     */
+    void PopToStack();
+
+    /**
+     * @brief Release everything queued in both directions.
+     */
+    void Clear();
+
+private:
+    // iovec entries passed to one sendmsg().
+    static const size_t MAX_IOV = 64;
+
+    std::deque<Packet *> toApp_ {};
+    // bytes of toApp_.front() already sent.
+    size_t toAppOffset_ {0};
+    std::deque<Packet *> toStack_ {};
+    // pooled receive buffer, packets hold slices of it.
+    Buffer *backlog_ {nullptr};
+    uint32_t backlogUsed_ {0};
+
+    BT_DISALLOW_COPY_AND_ASSIGN(SocketBridge);
+};
+}  // namespace bluetooth
+}  // namespace OHOS
+
+#endif  // SOCKET_BRIDGE_H
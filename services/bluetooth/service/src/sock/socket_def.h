@@ -89,6 +89,14 @@ typedef struct {
     uint16_t txMtu;  // send mtu (L2CAP only)
     uint16_t rxMtu;  // recv mtu (L2CAP only)
 } __attribute__((packed)) SocketConnectInfo;
+
+// result of sending data to app
+typedef enum {
+    SOCKET_SEND_NONE = 0,
+    SOCKET_SEND_ERROR,
+    SOCKET_SEND_PARTIAL,
+    SOCKET_SEND_ALL,
+} SocketSendRet;
 }  // namespace bluetooth
 }  // namespace OHOS
 
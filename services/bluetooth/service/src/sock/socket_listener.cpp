@@ -87,17 +87,21 @@ bool SocketThread::AddSocket(int fd, int flag, Socket &sock)
     {
         std::lock_guard<std::mutex> lock(mutex_);
         fdMap_[&sock] = fd;
+        if (flag == 1) {
+            writeWaiting_.insert(&sock);
+        }
     }
 
     int ret;
     struct epoll_event event = {};
     event.data.ptr = &sock;
     if (flag == 1) {
-        event.events = EPOLLRDHUP | EPOLLERR | EPOLLIN | EPOLLOUT | EPOLLONESHOT;
+        std::lock_guard<std::mutex> lock(epollFdMutex_);
+        event.events = SocketEvents(sock);
         ret = epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &event);
     } else {
         count_++;
-        event.events = EPOLLRDHUP | EPOLLERR | EPOLLIN;
+        event.events = SocketEvents(sock);
         ret = epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event);
     }
 
@@ -134,15 +138,16 @@ void SocketThread::OnListenEvents(void)
             }
             std::lock_guard<std::mutex> lock(epollFdMutex_);
             int fd = FindFd(sock);
+            bool oneShot;
+            {
+                std::lock_guard<std::mutex> lk(mutex_);
+                oneShot = (writeWaiting_.count(&sock) != 0);
+                if (events[i].events & EPOLLOUT) {
+                    writeWaiting_.erase(&sock);
+                }
+            }
             if (events[i].events & EPOLLOUT) {
                 writeCallback_(sock);
-
-                struct epoll_event event = {};
-                event.data.ptr = &sock;
-                event.events = EPOLLRDHUP | EPOLLERR | EPOLLIN;
-                epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &event);
-                LOG_DEBUG("[SocketListener]: epollFd: %{public}d, fd:%{public}d, errno:%{public}d",
-                    epollFd_, fd, errno);
             }
             if (events[i].events & (EPOLLRDHUP | EPOLLERR)) {
                 LOG_INFO("[SocketListener]: remove fd:%{public}d", fd);
@@ -151,11 +156,61 @@ void SocketThread::OnListenEvents(void)
                 count_--;
                 LOG_INFO("[SocketListener]: exceptCallback");
                 exceptCallback_(sock);
+            } else if (oneShot && fd != -1) {
+                // Any event disarms a one-shot fd, arm it again for what the socket waits for now.
+                struct epoll_event event = {};
+                event.data.ptr = &sock;
+                event.events = SocketEvents(sock);
+                epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &event);
+                LOG_DEBUG("[SocketListener]: epollFd: %{public}d, fd:%{public}d, errno:%{public}d",
+                    epollFd_, fd, errno);
             }
         }
     }
 }
 
+uint32_t SocketThread::SocketEvents(Socket &sock)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t events = EPOLLRDHUP | EPOLLERR;
+    if (readPaused_.count(&sock) == 0) {
+        events |= EPOLLIN;
+    }
+    if (writeWaiting_.count(&sock) != 0) {
+        events |= EPOLLOUT | EPOLLONESHOT;
+    }
+    return events;
+}
+
+bool SocketThread::SetReadPaused(Socket &sock, bool paused)
+{
+    int fd = FindFd(sock);
+    std::lock_guard<std::mutex> lock(epollFdMutex_);
+    if ((fd == -1) || (epollFd_ == -1)) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if ((readPaused_.count(&sock) != 0) == paused) {
+            return true;
+        }
+        if (paused) {
+            readPaused_.insert(&sock);
+        } else {
+            readPaused_.erase(&sock);
+        }
+    }
+
+    struct epoll_event event = {};
+    event.data.ptr = &sock;
+    event.events = SocketEvents(sock);
+    if (epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &event) == -1) {
+        LOG_DEBUG("SocketThread: SetReadPaused errno:%{public}d", errno);
+        return false;
+    }
+    return true;
+}
+
 int SocketThread::FindFd(Socket &sock)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -172,6 +227,8 @@ void SocketThread::DeleteFd(Socket &sock)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     fdMap_.erase(&sock);
+    writeWaiting_.erase(&sock);
+    readPaused_.erase(&sock);
 }
 
 bool SocketThread::DeleteSocket(Socket &sock)
@@ -18,6 +18,7 @@
 
 #include <map>
 #include <mutex>
+#include <set>
 #include <thread>
 #include "sock/socket.h"
 
@@ -58,6 +59,15 @@ public:
      * @return bool
      */
     bool DeleteSocket(Socket &sock);
+    /**
+     * @brief Stop or resume reporting readable data of a socket.
+     * @details Used while the stack cannot take more data, so that a full
+     *          socket does not wake the thread again and again.
+     * @param sock Socket object.
+     * @param paused Stop reporting if true, resume if false.
+     * @return bool
+     */
+    bool SetReadPaused(Socket &sock, bool paused);
 
 private:
     static const int MAX_EPOLL = 66;
@@ -78,6 +88,12 @@ private:
      * @return unsigned int
      */
     uint32_t FlagsChangeEvents(int flags);
+    /**
+     * @brief Poll events for the current state of a socket.
+     * @param sock Socket object.
+     * @return unsigned int
+     */
+    uint32_t SocketEvents(Socket &sock);
     /**
      * @brief Find fd from fdMap_.
      * @param sock Socket object.
@@ -100,6 +116,10 @@ private:
     std::unique_ptr<std::thread> thread_ {};
 
     std::map<Socket *, int> fdMap_ {};
+    // sockets waiting for the app to read, polled for EPOLLOUT once.
+    std::set<Socket *> writeWaiting_ {};
+    // sockets whose readable data is not reported.
+    std::set<Socket *> readPaused_ {};
 
     SocketOptionCallback readCallback_ {Socket::OnSocketReadReady};
     SocketOptionCallback writeCallback_ {Socket::OnSocketWriteReady};
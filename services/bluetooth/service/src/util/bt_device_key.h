@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BT_DEVICE_KEY_H
+#define BT_DEVICE_KEY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace utility {
+/**
+ * @brief Device address packed into one integer, for keying per-device tables.
+ *        Bits 0-47 hold the address with addr[0] lowest, the same byte order as BtAddr, bits 48-55 the address type.
+ *        Keys built from an address string carry TYPE_ANY, so a table keyed by strings before keeps its meaning;
+ *        LE tables key by the typed BtAddr so a public and a random address with equal bytes stay apart.
+ */
+class BtDeviceKey {
+public:
+    static constexpr size_t ADDRESS_LEN = 6;
+    static constexpr uint8_t TYPE_ANY = 0xFF;
+
+    constexpr BtDeviceKey() = default;
+
+    /**
+     * @brief Build a key from address bytes in BtAddr order.
+     *
+     * @param addr Six address bytes, addr[0] is the last byte of the string form.
+     * @param type Address type, TYPE_ANY when the table does not tell types apart.
+     * @return Key of the address.
+     * @since 6
+     */
+    static BtDeviceKey FromAddress(const uint8_t *addr, uint8_t type = TYPE_ANY)
+    {
+        uint64_t value = 0;
+        for (size_t i = ADDRESS_LEN; i > 0; i--) {
+            value = (value << BITS_PER_BYTE) | addr[i - 1];
+        }
+        return BtDeviceKey(value | (static_cast<uint64_t>(type) << TYPE_SHIFT));
+    }
+
+    /**
+     * @brief Build a key from the "AA:BB:CC:DD:EE:FF" form of RawAddress, in either case.
+     *
+     * @param address Address string.
+     * @return Key of the address, an invalid key when the string is not an address.
+     * @since 6
+     */
+    static BtDeviceKey FromString(const std::string &address)
+    {
+        if (address.size() != STRING_LEN) {
+            return BtDeviceKey(INVALID_VALUE);
+        }
+        uint64_t value = 0;
+        for (size_t i = 0; i < STRING_LEN; i++) {
+            if (i % STRING_STRIDE == STRING_STRIDE - 1) {
+                if (address[i] != ':') {
+                    return BtDeviceKey(INVALID_VALUE);
+                }
+                continue;
+            }
+            int digit = HexDigit(address[i]);
+            if (digit < 0) {
+                return BtDeviceKey(INVALID_VALUE);
+            }
+            value = (value << BITS_PER_DIGIT) | static_cast<uint64_t>(digit);
+        }
+        return BtDeviceKey(value | (static_cast<uint64_t>(TYPE_ANY) << TYPE_SHIFT));
+    }
+
+    /**
+     * @brief Copy the address bytes out in BtAddr order.
+     *
+     * @param addr Six bytes to fill.
+     * @since 6
+     */
+    void ToAddress(uint8_t *addr) const
+    {
+        for (size_t i = 0; i < ADDRESS_LEN; i++) {
+            addr[i] = static_cast<uint8_t>(value_ >> (i * BITS_PER_BYTE));
+        }
+    }
+
+    /**
+     * @brief Get the upper case string form, as RawAddress prints it.
+     *
+     * @return Address string.
+     * @since 6
+     */
+    std::string ToString() const
+    {
+        static const char digits[] = "0123456789ABCDEF";
+        std::string address(STRING_LEN, ':');
+        for (size_t i = 0; i < ADDRESS_LEN; i++) {
+            auto byte = static_cast<uint8_t>(value_ >> ((ADDRESS_LEN - 1 - i) * BITS_PER_BYTE));
+            address[i * STRING_STRIDE] = digits[byte >> BITS_PER_DIGIT];
+            address[i * STRING_STRIDE + 1] = digits[byte & DIGIT_MASK];
+        }
+        return address;
+    }
+
+    uint8_t GetType() const
+    {
+        return static_cast<uint8_t>(value_ >> TYPE_SHIFT);
+    }
+
+    bool IsValid() const
+    {
+        return value_ != INVALID_VALUE;
+    }
+
+    uint64_t GetValue() const
+    {
+        return value_;
+    }
+
+    bool operator==(const BtDeviceKey &other) const
+    {
+        return value_ == other.value_;
+    }
+
+    bool operator!=(const BtDeviceKey &other) const
+    {
+        return value_ != other.value_;
+    }
+
+    bool operator<(const BtDeviceKey &other) const
+    {
+        return value_ < other.value_;
+    }
+
+    /// Addresses of one vendor share the upper bytes, so every bit of the value is mixed into the low bits.
+    struct Hash {
+        size_t operator()(const BtDeviceKey &key) const
+        {
+            uint64_t value = key.value_;
+            value ^= value >> 33;
+            value *= 0xFF51AFD7ED558CCDULL;
+            value ^= value >> 33;
+            value *= 0xC4CEB9FE1A85EC53ULL;
+            value ^= value >> 33;
+            return static_cast<size_t>(value);
+        }
+    };
+
+private:
+    static constexpr size_t STRING_LEN = 17;
+    static constexpr size_t STRING_STRIDE = 3;
+    static constexpr uint32_t BITS_PER_BYTE = 8;
+    static constexpr uint32_t BITS_PER_DIGIT = 4;
+    static constexpr uint8_t DIGIT_MASK = 0x0F;
+    static constexpr uint32_t TYPE_SHIFT = 48;
+    static constexpr uint64_t INVALID_VALUE = UINT64_MAX;
+
+    explicit constexpr BtDeviceKey(uint64_t value) : value_(value)
+    {}
+
+    static int HexDigit(char c)
+    {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 0xA;
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 0xA;
+        }
+        return -1;
+    }
+
+    uint64_t value_ {0};
+};
+}  // namespace utility
+
+namespace std {
+template<>
+struct hash<utility::BtDeviceKey> : utility::BtDeviceKey::Hash {};
+}  // namespace std
+
+#endif  // BT_DEVICE_KEY_H
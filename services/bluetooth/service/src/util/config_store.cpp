@@ -0,0 +1,894 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config_store.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fcntl.h>
+#include <libgen.h>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "log.h"
+#include "securec.h"
+#include "xml_parse.h"
+
+namespace utility {
+namespace {
+constexpr uint32_t JOURNAL_MAGIC = 0x4A435442;   // "BTCJ"
+constexpr uint32_t SNAPSHOT_MAGIC = 0x53435442;  // "BTCS"
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+constexpr uint32_t MAX_RECORD_LEN = 1024 * 1024;
+const std::string JOURNAL_SUFFIX = ".journal";
+const std::string SNAPSHOT_SUFFIX = ".snap";
+const std::string PREVIOUS_SUFFIX = ".prev";
+const std::string CORRUPT_SUFFIX = ".corrupt";
+const std::string SNAPSHOT_TMP_SUFFIX = ".snap.tmp";
+
+enum RecordOp : uint8_t {
+    OP_SET = 1,
+    OP_REMOVE_PROPERTY,
+    OP_REMOVE_SECTION,
+    OP_ADD_SECTION,
+};
+
+#pragma pack(1)
+struct JournalHeader {
+    uint32_t magic;
+    uint32_t length;
+    uint32_t crc;
+    uint64_t seq;
+};
+
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t seq;
+    uint32_t length;
+    uint32_t crc;
+};
+#pragma pack()
+
+uint32_t Crc32(uint32_t crc, const uint8_t *data, size_t len)
+{
+    static const auto table = [] {
+        std::array<uint32_t, 256> t {};
+        for (uint32_t i = 0; i < t.size(); i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void PutString(std::vector<uint8_t> &buf, const std::string &str)
+{
+    uint32_t len = str.size();
+    const uint8_t *lenBytes = reinterpret_cast<const uint8_t *>(&len);
+    buf.insert(buf.end(), lenBytes, lenBytes + sizeof(len));
+    buf.insert(buf.end(), str.begin(), str.end());
+}
+
+bool GetString(const uint8_t *&pos, const uint8_t *end, std::string &str)
+{
+    uint32_t len = 0;
+    if (end - pos < static_cast<ptrdiff_t>(sizeof(len))) {
+        return false;
+    }
+    (void)memcpy_s(&len, sizeof(len), pos, sizeof(len));
+    pos += sizeof(len);
+    if (end - pos < static_cast<ptrdiff_t>(len)) {
+        return false;
+    }
+    str.assign(reinterpret_cast<const char *>(pos), len);
+    pos += len;
+    return true;
+}
+
+std::string IntToString(int value)
+{
+    std::stringstream ss;
+    ss << std::hex << value;
+    std::string convertVal = ss.str();
+    std::transform(convertVal.begin(), convertVal.end(), convertVal.begin(), ::toupper);
+    return "0x" + convertVal;
+}
+
+bool ReadFile(const std::string &path, std::vector<uint8_t> &data)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    data.resize(st.st_size);
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t ret = read(fd, data.data() + done, data.size() - done);
+        if (ret <= 0) {
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        done += ret;
+    }
+    data.resize(done);
+    close(fd);
+    return true;
+}
+
+void SyncDir(const std::string &path)
+{
+    std::string dir = path;
+    int dirFd = open(dirname(&dir[0]), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd >= 0) {
+        fsync(dirFd);
+        close(dirFd);
+    }
+}
+}  // namespace
+
+struct ConfigStore::impl {
+    using Properties = std::map<std::string, std::string>;
+    struct Section {
+        Properties properties_ {};
+        std::map<std::string, Properties> subSections_ {};
+    };
+
+    impl(int flushDelayMs, size_t compactThreshold)
+        : flushDelay_(flushDelayMs), compactThreshold_(compactThreshold)
+    {}
+
+    std::map<std::string, Section> tree_ {};
+    std::mutex mutex_ {};
+    std::condition_variable cond_ {};
+    std::condition_variable flushedCond_ {};
+    std::unique_ptr<std::thread> flusher_ {nullptr};
+    bool loaded_ {false};
+    bool stop_ {false};
+    bool urgent_ {false};
+    bool crashed_ {false};
+
+    std::string journalPath_ {""};
+    std::string journalPrevPath_ {""};
+    std::string snapshotPath_ {""};
+    std::string snapshotPrevPath_ {""};
+    std::string snapshotTmpPath_ {""};
+    int journalFd_ {-1};
+    size_t journalSize_ {0};
+
+    std::vector<uint8_t> pending_ {};
+    std::chrono::steady_clock::time_point firstPending_ {};
+    uint64_t seq_ {0};
+    uint64_t committedSeq_ {0};
+    uint64_t failedSeq_ {0};
+    bool forceCompact_ {false};
+
+    std::chrono::milliseconds flushDelay_;
+    size_t compactThreshold_;
+    WriteHook hook_ {};
+
+    const Properties *FindProperties(const std::string &section, const std::string &subSection) const;
+    bool Find(const std::string &section, const std::string &subSection, const std::string &property,
+        std::string &value) const;
+    bool Apply(uint8_t op, const std::string &section, const std::string &subSection, const std::string &property,
+        const std::string &value);
+    void Mutate(uint8_t op, const std::string &section, const std::string &subSection, const std::string &property,
+        const std::string &value);
+    std::vector<uint8_t> EncodeTree() const;
+    bool ApplyPayload(const uint8_t *pos, const uint8_t *end);
+
+    bool LoadSnapshot(const std::string &path, uint64_t &snapSeq, bool &corrupted);
+    bool LoadJournal(const std::string &path, uint64_t snapSeq, bool current);
+    bool ImportXml(const std::string &path);
+
+    bool Step(WriteStep step);
+    bool WriteAll(int fd, const uint8_t *data, size_t len, WriteStep step);
+    bool AppendJournal(const std::vector<uint8_t> &batch);
+    bool RotateJournal();
+    bool WriteSnapshot(const std::vector<uint8_t> &payload, uint64_t seq);
+    bool Commit(std::unique_lock<std::mutex> &lock);
+    void FlushLoop();
+    void Shutdown();
+};
+
+const ConfigStore::impl::Properties *ConfigStore::impl::FindProperties(
+    const std::string &section, const std::string &subSection) const
+{
+    auto sectionIt = tree_.find(section);
+    if (sectionIt == tree_.end()) {
+        return nullptr;
+    }
+    if (subSection.empty()) {
+        return &sectionIt->second.properties_;
+    }
+    auto subSectionIt = sectionIt->second.subSections_.find(subSection);
+    if (subSectionIt == sectionIt->second.subSections_.end()) {
+        return nullptr;
+    }
+    return &subSectionIt->second;
+}
+
+bool ConfigStore::impl::Find(
+    const std::string &section, const std::string &subSection, const std::string &property, std::string &value) const
+{
+    const Properties *properties = FindProperties(section, subSection);
+    if (properties == nullptr) {
+        return false;
+    }
+    auto it = properties->find(property);
+    if (it == properties->end()) {
+        return false;
+    }
+    value = it->second;
+    return true;
+}
+
+bool ConfigStore::impl::Apply(uint8_t op, const std::string &section, const std::string &subSection,
+    const std::string &property, const std::string &value)
+{
+    switch (op) {
+        case OP_SET: {
+            Section &node = tree_[section];
+            Properties &properties = subSection.empty() ? node.properties_ : node.subSections_[subSection];
+            properties[property] = value;
+            return true;
+        }
+        case OP_REMOVE_PROPERTY: {
+            Properties *properties = const_cast<Properties *>(FindProperties(section, subSection));
+            return (properties != nullptr) && (properties->erase(property) != 0);
+        }
+        case OP_REMOVE_SECTION: {
+            if (subSection.empty()) {
+                return tree_.erase(section) != 0;
+            }
+            auto sectionIt = tree_.find(section);
+            return (sectionIt != tree_.end()) && (sectionIt->second.subSections_.erase(subSection) != 0);
+        }
+        case OP_ADD_SECTION: {
+            Section &node = tree_[section];
+            if (!subSection.empty()) {
+                node.subSections_[subSection];
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void ConfigStore::impl::Mutate(uint8_t op, const std::string &section, const std::string &subSection,
+    const std::string &property, const std::string &value)
+{
+    std::vector<uint8_t> payload;
+    payload.push_back(op);
+    PutString(payload, section);
+    PutString(payload, subSection);
+    PutString(payload, property);
+    PutString(payload, value);
+
+    JournalHeader header = {JOURNAL_MAGIC, static_cast<uint32_t>(payload.size()), 0, ++seq_};
+    header.crc = Crc32(0, reinterpret_cast<const uint8_t *>(&header.seq), sizeof(header.seq));
+    header.crc = Crc32(header.crc, payload.data(), payload.size());
+
+    if (pending_.empty()) {
+        firstPending_ = std::chrono::steady_clock::now();
+    }
+    const uint8_t *headerBytes = reinterpret_cast<const uint8_t *>(&header);
+    pending_.insert(pending_.end(), headerBytes, headerBytes + sizeof(header));
+    pending_.insert(pending_.end(), payload.begin(), payload.end());
+    cond_.notify_one();
+}
+
+std::vector<uint8_t> ConfigStore::impl::EncodeTree() const
+{
+    std::vector<uint8_t> payload;
+    auto encode = [&payload](const std::string &section, const std::string &subSection, const Properties &props) {
+        // Sections without properties exist as well, HasSection() has to find them after a reload.
+        if (props.empty()) {
+            payload.push_back(OP_ADD_SECTION);
+            PutString(payload, section);
+            PutString(payload, subSection);
+            PutString(payload, "");
+            PutString(payload, "");
+        }
+        for (auto &property : props) {
+            payload.push_back(OP_SET);
+            PutString(payload, section);
+            PutString(payload, subSection);
+            PutString(payload, property.first);
+            PutString(payload, property.second);
+        }
+    };
+    for (auto &section : tree_) {
+        encode(section.first, "", section.second.properties_);
+        for (auto &subSection : section.second.subSections_) {
+            encode(section.first, subSection.first, subSection.second);
+        }
+    }
+    return payload;
+}
+
+bool ConfigStore::impl::ApplyPayload(const uint8_t *pos, const uint8_t *end)
+{
+    while (pos < end) {
+        uint8_t op = *pos++;
+        std::string section;
+        std::string subSection;
+        std::string property;
+        std::string value;
+        if (!GetString(pos, end, section) || !GetString(pos, end, subSection) || !GetString(pos, end, property) ||
+            !GetString(pos, end, value)) {
+            return false;
+        }
+        Apply(op, section, subSection, property, value);
+    }
+    return true;
+}
+
+bool ConfigStore::impl::LoadSnapshot(const std::string &path, uint64_t &snapSeq, bool &corrupted)
+{
+    corrupted = false;
+    std::vector<uint8_t> data;
+    if (!ReadFile(path, data)) {
+        return false;
+    }
+    corrupted = true;
+    SnapshotHeader header {};
+    if (data.size() < sizeof(header)) {
+        LOG_ERROR("[ConfigStore]:%{public}s %{public}s truncated", __func__, path.c_str());
+        return false;
+    }
+    (void)memcpy_s(&header, sizeof(header), data.data(), sizeof(header));
+    const uint8_t *payload = data.data() + sizeof(header);
+    if ((header.magic != SNAPSHOT_MAGIC) || (header.version != SNAPSHOT_VERSION) ||
+        (header.length != data.size() - sizeof(header)) || (Crc32(0, payload, header.length) != header.crc)) {
+        LOG_ERROR("[ConfigStore]:%{public}s %{public}s corrupted", __func__, path.c_str());
+        return false;
+    }
+    tree_.clear();
+    if (!ApplyPayload(payload, payload + header.length)) {
+        tree_.clear();
+        return false;
+    }
+    corrupted = false;
+    snapSeq = header.seq;
+    return true;
+}
+
+bool ConfigStore::impl::LoadJournal(const std::string &path, uint64_t snapSeq, bool current)
+{
+    std::vector<uint8_t> data;
+    if (!ReadFile(path, data)) {
+        return false;
+    }
+    size_t offset = 0;
+    while (data.size() - offset >= sizeof(JournalHeader)) {
+        JournalHeader header {};
+        (void)memcpy_s(&header, sizeof(header), data.data() + offset, sizeof(header));
+        const uint8_t *payload = data.data() + offset + sizeof(header);
+        if ((header.magic != JOURNAL_MAGIC) || (header.length > MAX_RECORD_LEN) ||
+            (header.length > data.size() - offset - sizeof(header))) {
+            break;
+        }
+        uint32_t crc = Crc32(0, reinterpret_cast<const uint8_t *>(&header.seq), sizeof(header.seq));
+        if (Crc32(crc, payload, header.length) != header.crc) {
+            break;
+        }
+        if (header.seq > snapSeq) {
+            ApplyPayload(payload, payload + header.length);
+        }
+        seq_ = std::max(seq_, header.seq);
+        offset += sizeof(header) + header.length;
+    }
+    if (!current) {
+        return true;
+    }
+    if (offset != data.size()) {
+        // Torn tail from an interrupted commit, drop it so later appends stay parseable.
+        LOG_WARN("[ConfigStore]:%{public}s discard %{public}zu bytes of journal tail", __func__, data.size() - offset);
+        if (truncate(path.c_str(), offset) != 0) {
+            LOG_ERROR("[ConfigStore]:%{public}s truncate failed, errno: %{public}d", __func__, errno);
+        }
+    }
+    journalSize_ = offset;
+    return true;
+}
+
+bool ConfigStore::impl::ImportXml(const std::string &path)
+{
+    XmlParse parse;
+    if (!parse.Load(path)) {
+        return false;
+    }
+    return parse.Traverse([this](const std::string &section, const std::string &subSection,
+                              const std::string &property, const std::string &value) {
+        Apply(property.empty() ? OP_ADD_SECTION : OP_SET, section, subSection, property, value);
+    });
+}
+
+bool ConfigStore::impl::Step(WriteStep step)
+{
+    if (crashed_) {
+        return false;
+    }
+    if (hook_ && !hook_(step)) {
+        crashed_ = true;
+        return false;
+    }
+    return true;
+}
+
+bool ConfigStore::impl::WriteAll(int fd, const uint8_t *data, size_t len, WriteStep step)
+{
+    if (crashed_) {
+        return false;
+    }
+    bool crash = !Step(step);
+    if (crash) {
+        len /= 2;
+    }
+    size_t done = 0;
+    while (done < len) {
+        ssize_t ret = write(fd, data + done, len - done);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_ERROR("[ConfigStore]:%{public}s write failed, errno: %{public}d", __func__, errno);
+            return false;
+        }
+        done += ret;
+    }
+    return !crash;
+}
+
+bool ConfigStore::impl::AppendJournal(const std::vector<uint8_t> &batch)
+{
+    if (WriteAll(journalFd_, batch.data(), batch.size(), JOURNAL_WRITE) && Step(JOURNAL_SYNC) &&
+        (fdatasync(journalFd_) == 0)) {
+        journalSize_ += batch.size();
+        return true;
+    }
+    // Cut a partial record off again, records appended after it would be unreachable on load.
+    if (!crashed_ && (ftruncate(journalFd_, journalSize_) != 0)) {
+        LOG_ERROR("[ConfigStore]:%{public}s truncate failed, errno: %{public}d", __func__, errno);
+    }
+    return false;
+}
+
+bool ConfigStore::impl::RotateJournal()
+{
+    close(journalFd_);
+    bool ret = (rename(journalPath_.c_str(), journalPrevPath_.c_str()) == 0);
+    if (!ret) {
+        LOG_ERROR("[ConfigStore]:%{public}s rename failed, errno: %{public}d", __func__, errno);
+    }
+    journalFd_ = open(journalPath_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (journalFd_ < 0) {
+        LOG_ERROR("[ConfigStore]:%{public}s open failed, errno: %{public}d", __func__, errno);
+        return false;
+    }
+    if (ret) {
+        journalSize_ = 0;
+    }
+    return ret;
+}
+
+bool ConfigStore::impl::WriteSnapshot(const std::vector<uint8_t> &payload, uint64_t seq)
+{
+    SnapshotHeader header = {SNAPSHOT_MAGIC, SNAPSHOT_VERSION, seq, static_cast<uint32_t>(payload.size()), 0};
+    header.crc = Crc32(0, payload.data(), payload.size());
+
+    int fd = open(snapshotTmpPath_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        LOG_ERROR("[ConfigStore]:%{public}s open failed, errno: %{public}d", __func__, errno);
+        return false;
+    }
+    std::vector<uint8_t> data(reinterpret_cast<const uint8_t *>(&header),
+        reinterpret_cast<const uint8_t *>(&header) + sizeof(header));
+    data.insert(data.end(), payload.begin(), payload.end());
+    bool ret = WriteAll(fd, data.data(), data.size(), SNAPSHOT_WRITE) && Step(SNAPSHOT_SYNC) && (fsync(fd) == 0);
+    close(fd);
+    if (!ret) {
+        return false;
+    }
+
+    // The replaced snapshot and the journal on top of it stay as the previous generation, Load() falls back
+    // to them when the new snapshot is missing or corrupted.
+    bool rotate = (rename(snapshotPath_.c_str(), snapshotPrevPath_.c_str()) == 0);
+    if (!rotate && (errno != ENOENT)) {
+        LOG_ERROR("[ConfigStore]:%{public}s rename previous failed, errno: %{public}d", __func__, errno);
+        return false;
+    }
+    if (!Step(SNAPSHOT_RENAME)) {
+        return false;
+    }
+    if (rename(snapshotTmpPath_.c_str(), snapshotPath_.c_str()) != 0) {
+        LOG_ERROR("[ConfigStore]:%{public}s rename failed, errno: %{public}d", __func__, errno);
+        return false;
+    }
+    SyncDir(snapshotPath_);
+    if (!rotate) {
+        // Nothing to fall back to yet, records the snapshot covers are skipped on load by their sequence number.
+        return true;
+    }
+
+    // The journal already holds every record the snapshot covers, it becomes the previous journal.
+    if (!Step(JOURNAL_RESET) || !RotateJournal()) {
+        return false;
+    }
+    SyncDir(journalPath_);
+    return true;
+}
+
+bool ConfigStore::impl::Commit(std::unique_lock<std::mutex> &lock)
+{
+    if (pending_.empty() || crashed_) {
+        urgent_ = false;
+        return !crashed_;
+    }
+    std::vector<uint8_t> batch;
+    batch.swap(pending_);
+    uint64_t seq = seq_;
+    std::vector<uint8_t> snapshot;
+    bool compact = forceCompact_ || (journalSize_ + batch.size() > compactThreshold_);
+    if (compact) {
+        snapshot = EncodeTree();
+    }
+    urgent_ = false;
+
+    lock.unlock();
+    // A compacted batch goes to the journal too, the previous snapshot generation plus the journals is complete.
+    bool ret = AppendJournal(batch) && (!compact || WriteSnapshot(snapshot, seq));
+    lock.lock();
+
+    if (ret) {
+        committedSeq_ = seq;
+        forceCompact_ = false;
+    } else {
+        // The journal may now end in a partial record; rewrite everything through a snapshot next time.
+        failedSeq_ = seq;
+        forceCompact_ = true;
+        LOG_ERROR("[ConfigStore]:%{public}s commit up to %{public}llu failed", __func__, (unsigned long long)seq);
+    }
+    flushedCond_.notify_all();
+    return ret;
+}
+
+void ConfigStore::impl::FlushLoop()
+{
+    pthread_setname_np(pthread_self(), "bt-config-store");
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cond_.wait(lock, [this] { return stop_ || urgent_ || !pending_.empty(); });
+        if (!stop_ && !urgent_) {
+            // Bounded delay: gather further mutations into the same commit.
+            cond_.wait_until(lock, firstPending_ + flushDelay_, [this] { return stop_ || urgent_; });
+        }
+        Commit(lock);
+        if (stop_) {
+            break;
+        }
+    }
+}
+
+void ConfigStore::impl::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        cond_.notify_one();
+    }
+    if (flusher_ && flusher_->joinable()) {
+        flusher_->join();
+    }
+    flusher_ = nullptr;
+    if (journalFd_ >= 0) {
+        close(journalFd_);
+        journalFd_ = -1;
+    }
+    loaded_ = false;
+}
+
+ConfigStore::ConfigStore(int flushDelayMs, size_t compactThreshold)
+    : pimpl(std::make_unique<impl>(flushDelayMs, compactThreshold))
+{}
+
+ConfigStore::~ConfigStore()
+{
+    pimpl->Shutdown();
+}
+
+void ConfigStore::SetWriteHook(const WriteHook &hook)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex_);
+    pimpl->hook_ = hook;
+}
+
+bool ConfigStore::Load(const std::string &path)
+{
+    pimpl->Shutdown();
+
+    std::lock_guard<std::mutex> lock(pimpl->mutex_);
+    pimpl->tree_.clear();
+    pimpl->pending_.clear();
+    pimpl->seq_ = 0;
+    pimpl->journalSize_ = 0;
+    pimpl->failedSeq_ = 0;
+    pimpl->forceCompact_ = false;
+    pimpl->stop_ = false;
+    pimpl->urgent_ = false;
+    pimpl->crashed_ = false;
+    pimpl->journalPath_ = path + JOURNAL_SUFFIX;
+    pimpl->journalPrevPath_ = pimpl->journalPath_ + PREVIOUS_SUFFIX;
+    pimpl->snapshotPath_ = path + SNAPSHOT_SUFFIX;
+    pimpl->snapshotPrevPath_ = pimpl->snapshotPath_ + PREVIOUS_SUFFIX;
+    pimpl->snapshotTmpPath_ = path + SNAPSHOT_TMP_SUFFIX;
+
+    uint64_t snapSeq = 0;
+    bool corrupted = false;
+    bool hasSnapshot = pimpl->LoadSnapshot(pimpl->snapshotPath_, snapSeq, corrupted);
+    bool hasPrevious = false;
+    if (!hasSnapshot) {
+        // Missing after a crash inside a compaction, or corrupted: the previous generation and both journals
+        // hold the same state. The XML document is stale since the migration and is never used for this.
+        bool prevCorrupted = false;
+        hasPrevious = pimpl->LoadSnapshot(pimpl->snapshotPrevPath_, snapSeq, prevCorrupted);
+        if ((corrupted || prevCorrupted) && !hasPrevious) {
+            LOG_ERROR("[ConfigStore]:%{public}s no valid snapshot generation for %{public}s, files are kept",
+                __func__, path.c_str());
+            return false;
+        }
+        if (corrupted) {
+            // Kept for inspection, and out of the way so the next snapshot does not rotate it into the
+            // previous generation.
+            LOG_ERROR("[ConfigStore]:%{public}s snapshot corrupted, recovered from the previous generation",
+                __func__);
+            if (rename(pimpl->snapshotPath_.c_str(), (pimpl->snapshotPath_ + CORRUPT_SUFFIX).c_str()) != 0) {
+                LOG_ERROR("[ConfigStore]:%{public}s rename failed, errno: %{public}d", __func__, errno);
+                return false;
+            }
+        }
+    }
+    pimpl->seq_ = snapSeq;
+    bool hasPrevJournal = pimpl->LoadJournal(pimpl->journalPrevPath_, snapSeq, false);
+    bool hasJournal = pimpl->LoadJournal(pimpl->journalPath_, snapSeq, true);
+    if (!hasSnapshot && !hasPrevious && !hasPrevJournal && !hasJournal) {
+        if (!pimpl->ImportXml(path)) {
+            return false;
+        }
+        LOG_INFO("[ConfigStore]:%{public}s import %{public}s", __func__, path.c_str());
+    }
+
+    pimpl->journalFd_ =
+        open(pimpl->journalPath_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (pimpl->journalFd_ < 0) {
+        LOG_ERROR("[ConfigStore]:%{public}s open journal failed, errno: %{public}d", __func__, errno);
+        return false;
+    }
+    if (!hasSnapshot && !pimpl->WriteSnapshot(pimpl->EncodeTree(), pimpl->seq_)) {
+        LOG_ERROR("[ConfigStore]:%{public}s write initial snapshot failed", __func__);
+    }
+    pimpl->committedSeq_ = pimpl->seq_;
+    pimpl->flusher_ = std::make_unique<std::thread>(&ConfigStore::impl::FlushLoop, pimpl.get());
+    pimpl->loaded_ = true;
+    return true;
+}
+
+bool ConfigStore::Save()
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex_);
+    return pimpl->loaded_ && !pimpl->crashed_;
+}
+
+bool ConfigStore::Flush()
+{
+    std::unique_lock<std::mutex> lock(pimpl->mutex_);
+    if (!pimpl->loaded_) {
+        return false;
+    }
+    uint64_t target = pimpl->seq_;
+    pimpl->urgent_ = true;
+    pimpl->cond_.notify_one();
+    pimpl->flushedCond_.wait(lock, [this, target] {
+        return (pimpl->committedSeq_ >= target) || (pimpl->failedSeq_ >= target) || pimpl->crashed_;
+    });
+    return pimpl->committedSeq_ >= target;
+}
+
+bool ConfigStore::GetValue(
+    const std::string &section, const std::string &subSection, const std::string &property, int &value)
+{
+    std::string sValue;
+    if (!GetValue(section, subSection, property, sValue) || (sValue.size() <= SIZEOF_0X)) {
+        return false;
+    }
+    value = std::stol(sValue.substr(SIZEOF_0X), nullptr, BASE_16);
+    return true;
+}
+
+bool ConfigStore::GetValue(
+    const std::string &section, const std::string &subSection, const std::string &property, std::string &value)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex_);
+    return pimpl->Find(section, subSection, property, value);
+}
+
+bool ConfigStore::GetValue(
+    const std::string &section, const std::string &subSection, const std::string &property, bool &value)
+{
+    std::string sValue;
+    if (!GetValue(section, subSection, property, sValue)) {
+        return false;
+    }
+    if (sValue == "true") {
+        value = true;
+    } else if (sValue == "false") {
+        value = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool ConfigStore::SetValue(
+    const std::string &section, const std::string &subSection, const std::string &property, const int &value)
+{
+    return SetValue(section, subSection, property, IntToString(value));
+}
+
+bool ConfigStore::SetValue(
+    const std::string &section, const std::string &subSection, const std::string &property, const std::string &value)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex_);
+    std::string current;
+    if (pimpl->Find(section, subSection, property, current) && (current == value)) {
+        return true;
+    }
+    pimpl->Apply(OP_SET, section, subSection, property, value);
+    pimpl->Mutate(OP_SET, section, subSection, property, value);
+    return true;
+}
+
+bool ConfigStore::SetValue(
+    const std::string &section, const std::string &subSection, const std::string &property, const bool &value)
+{
+    return SetValue(section, subSection, property, std::string(value ? "true" : "false"));
+}
+
+bool ConfigStore::HasSection(const std::string &section, const std::string &subSection)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex_);
+    return !subSection.empty() && (pimpl->FindProperties(section, subSection) != nullptr);
+}
+
+bool ConfigStore::GetSubSections(const std::string &section, std::vector<std::string> &subSections)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex_);
+    auto sectionIt = pimpl->tree_.find(section);
+    if (sectionIt == pimpl->tree_.end()) {
+        return false;
+    }
+    for (auto &subSection : sectionIt->second.subSections_) {
+        subSections.push_back(subSection.first);
+    }
+    return !subSections.empty();
+}
+
+bool ConfigStore::HasProperty(const std::string &section, const std::string &subSection, const std::string &property)
+{
+    std::string value;
+    return GetValue(section, subSection, property, value);
+}
+
+bool ConfigStore::RemoveSection(const std::string &section, const std::string &subSection)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex_);
+    if (subSection.empty() || !pimpl->Apply(OP_REMOVE_SECTION, section, subSection, "", "")) {
+        return false;
+    }
+    pimpl->Mutate(OP_REMOVE_SECTION, section, subSection, "", "");
+    return true;
+}
+
+bool ConfigStore::RemoveProperty(
+    const std::string &section, const std::string &subSection, const std::string &property)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex_);
+    if (!pimpl->Apply(OP_REMOVE_PROPERTY, section, subSection, property, "")) {
+        return false;
+    }
+    pimpl->Mutate(OP_REMOVE_PROPERTY, section, subSection, property, "");
+    return true;
+}
+
+bool ConfigStore::GetValue(const std::string &section, const std::string &property, int &value)
+{
+    return GetValue(section, "", property, value);
+}
+
+bool ConfigStore::GetValue(const std::string &section, const std::string &property, std::string &value)
+{
+    return GetValue(section, "", property, value);
+}
+
+bool ConfigStore::GetValue(const std::string &section, const std::string &property, bool &value)
+{
+    return GetValue(section, "", property, value);
+}
+
+bool ConfigStore::SetValue(const std::string &section, const std::string &property, const int &value)
+{
+    return SetValue(section, "", property, value);
+}
+
+bool ConfigStore::SetValue(const std::string &section, const std::string &property, const std::string &value)
+{
+    return SetValue(section, "", property, value);
+}
+
+bool ConfigStore::SetValue(const std::string &section, const std::string &property, const bool &value)
+{
+    return SetValue(section, "", property, value);
+}
+
+bool ConfigStore::HasSection(const std::string &section)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex_);
+    return pimpl->tree_.find(section) != pimpl->tree_.end();
+}
+
+bool ConfigStore::HasProperty(const std::string &section, const std::string &property)
+{
+    return HasProperty(section, "", property);
+}
+
+bool ConfigStore::RemoveSection(const std::string &section)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex_);
+    if (!pimpl->Apply(OP_REMOVE_SECTION, section, "", "", "")) {
+        return false;
+    }
+    pimpl->Mutate(OP_REMOVE_SECTION, section, "", "", "");
+    return true;
+}
+
+bool ConfigStore::RemoveProperty(const std::string &section, const std::string &property)
+{
+    return RemoveProperty(section, "", property);
+}
+}  // namespace utility
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "base_def.h"
+
+namespace utility {
+/**
+ * @brief Persistent section/subSection/property store.
+ *
+ * Values live in an in-memory indexed tree. Every mutation is appended as a
+ * checksummed record to a binary journal, which a background flusher
+ * group-commits at most flushDelayMs after the first pending record. The
+ * journal is periodically compacted into a snapshot written through a
+ * temporary file and rename(), so a crash at any point leaves either the old
+ * or the new state on disk. The replaced snapshot and its journal are kept as
+ * the previous generation to recover from a corrupted snapshot. Values keep
+ * the textual encoding of XmlParse.
+ */
+class ConfigStore {
+public:
+    /**
+     * @brief Write steps reported to the fault hook, in the order they happen.
+     */
+    enum WriteStep : int {
+        JOURNAL_WRITE = 0,
+        JOURNAL_SYNC,
+        SNAPSHOT_WRITE,
+        SNAPSHOT_SYNC,
+        SNAPSHOT_RENAME,
+        JOURNAL_RESET,
+        WRITE_STEP_MAX,
+    };
+
+    /**
+     * @brief Fault hook for testing. Returning false simulates a crash at that step: a write step writes
+     *        only part of its data, and the store performs no further file I/O.
+     */
+    using WriteHook = std::function<bool(WriteStep step)>;
+
+    /**
+     * @brief Construct a new Config Store object
+     *
+     * @param flushDelayMs Upper bound on how long a mutation stays pending before it is group-committed.
+     * @param compactThreshold Journal size in bytes that triggers compaction into a snapshot.
+     * @since 6
+     */
+    explicit ConfigStore(int flushDelayMs = 100, size_t compactThreshold = 256 * 1024);
+
+    /**
+     * @brief Destroy the Config Store object. Pending mutations are committed first.
+     *
+     * @since 6
+     */
+    ~ConfigStore();
+
+    /**
+     * @brief Load the store belonging to the XML document at path.
+     *        Snapshots and journals live next to it; the XML document is imported only if none of them exists.
+     *        A corrupted snapshot is kept aside and the previous generation loaded instead.
+     *
+     * @param path XML document path.
+     * @return Success load store return true, else return false, also when no snapshot generation is valid.
+     * @since 6
+     */
+    bool Load(const std::string &path);
+
+    /**
+     * @brief Kept for XmlParse callers. Every mutation is already queued for the next group commit, which the
+     *        flusher thread writes within the flush delay, so this neither wakes it nor blocks on file I/O.
+     *
+     * @return Store is loaded and its mutations can still become durable return true, else return false.
+     * @since 6
+     */
+    bool Save();
+
+    /**
+     * @brief Commit all pending mutations synchronously.
+     *
+     * @return Success commit return true, else return false.
+     * @since 6
+     */
+    bool Flush();
+
+    /**
+     * @brief Accessors below have the same semantics and value encoding as their XmlParse counterparts.
+     *        Mutations take effect in memory immediately and become durable with the next group commit.
+     */
+    bool GetValue(const std::string &section, const std::string &subSection, const std::string &property, int &value);
+    bool GetValue(
+        const std::string &section, const std::string &subSection, const std::string &property, std::string &value);
+    bool GetValue(const std::string &section, const std::string &subSection, const std::string &property, bool &value);
+    bool SetValue(
+        const std::string &section, const std::string &subSection, const std::string &property, const int &value);
+    bool SetValue(const std::string &section, const std::string &subSection, const std::string &property,
+        const std::string &value);
+    bool SetValue(
+        const std::string &section, const std::string &subSection, const std::string &property, const bool &value);
+    bool HasSection(const std::string &section, const std::string &subSection);
+    bool GetSubSections(const std::string &section, std::vector<std::string> &subSections);
+    bool HasProperty(const std::string &section, const std::string &subSection, const std::string &property);
+    bool RemoveSection(const std::string &section, const std::string &subSection);
+    bool RemoveProperty(const std::string &section, const std::string &subSection, const std::string &property);
+
+    bool GetValue(const std::string &section, const std::string &property, int &value);
+    bool GetValue(const std::string &section, const std::string &property, std::string &value);
+    bool GetValue(const std::string &section, const std::string &property, bool &value);
+    bool SetValue(const std::string &section, const std::string &property, const int &value);
+    bool SetValue(const std::string &section, const std::string &property, const std::string &value);
+    bool SetValue(const std::string &section, const std::string &property, const bool &value);
+    bool HasSection(const std::string &section);
+    bool HasProperty(const std::string &section, const std::string &property);
+    bool RemoveSection(const std::string &section);
+    bool RemoveProperty(const std::string &section, const std::string &property);
+
+    /**
+     * @brief Install a fault hook, see WriteHook. Must be called before Load().
+     *
+     * @param hook Fault hook.
+     * @since 6
+     */
+    void SetWriteHook(const WriteHook &hook);
+
+private:
+    DECLARE_IMPL();
+
+    BT_DISALLOW_COPY_AND_ASSIGN(ConfigStore);
+};
+}  // namespace utility
+
+#endif  // CONFIG_STORE_H
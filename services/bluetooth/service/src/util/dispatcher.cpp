@@ -17,9 +17,6 @@
 #include "log.h"
 
 namespace utility {
-static void EmptyTask()
-{}
-
 Dispatcher::Dispatcher(const std::string &name) : name_(name), taskQueue_(128)
 {}
 
@@ -42,8 +39,11 @@ void Dispatcher::Uninitialize()
 {
     std::lock_guard<std::mutex> lock(mutex_);
     if (start_) {
-        start_ = false;
-        taskQueue_.Push(std::bind(EmptyTask));
+        {
+            std::lock_guard<std::mutex> wakeLock(wakeMutex_);
+            start_ = false;
+        }
+        wakeCond_.notify_one();
         if (thread_ && thread_->joinable()) {
             thread_->join();
             thread_ = nullptr;
@@ -51,11 +51,18 @@ void Dispatcher::Uninitialize()
     }
 }
 
-void Dispatcher::PostTask(const std::function<void()> &task)
+void Dispatcher::PostTask(Task &&task)
 {
     if (start_) {
         if (!taskQueue_.TryPush(std::move(task))) {
             LOG_ERROR("%{public}s Dispatcher::PostTask failed!", name_.c_str());
+            return;
+        }
+        if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            {
+                std::lock_guard<std::mutex> wakeLock(wakeMutex_);
+            }
+            wakeCond_.notify_one();
         }
     }
 }
@@ -71,9 +78,20 @@ void Dispatcher::Run(std::promise<void> promise)
     promise.set_value();
 
     while (start_) {
-        std::function<void()> task;
-        taskQueue_.Pop(task);
-        task();
+        {
+            std::unique_lock<std::mutex> wakeLock(wakeMutex_);
+            wakeCond_.wait(wakeLock, [this] { return pending_.load(std::memory_order_acquire) > 0 || !start_; });
+        }
+        while (start_ && pending_.load(std::memory_order_acquire) > 0) {
+            Task task;
+            if (!taskQueue_.TryPop(task)) {
+                // A producer has claimed the next slot but not finished writing it.
+                std::this_thread::yield();
+                continue;
+            }
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+            task();
+        }
     }
 
     // If there are tasks in the queue. will not execute them.
@@ -17,12 +17,15 @@
 #define DISPATCHER_H
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
-#include "fixed_queue.h"
+#include "mpsc_queue.h"
+#include "task.h"
 
 namespace utility {
 class Dispatcher {
@@ -58,11 +61,12 @@ public:
 
     /**
      * @brief PostTask to dispatcher.
+     *        Lambdas and binds convert to Task in place, so captures are moved rather than copied.
      *
      * @param task
      * @since 6
      */
-    void PostTask(const std::function<void()> &task);
+    void PostTask(Task &&task);
 
     /**
      * @brief Get Dispatcher name.
@@ -85,7 +89,11 @@ private:
     std::mutex mutex_ {};
     std::unique_ptr<std::thread> thread_ {nullptr};
     std::atomic_bool start_ = ATOMIC_FLAG_INIT;
-    utility::FixedQueue<std::function<void()>> taskQueue_ {};
+    utility::MpscQueue<Task> taskQueue_;
+    // Tasks pushed and not yet popped; the worker is only woken when this leaves zero.
+    std::atomic<size_t> pending_ {0};
+    std::mutex wakeMutex_ {};
+    std::condition_variable wakeCond_ {};
 
     BT_DISALLOW_COPY_AND_ASSIGN(Dispatcher);
 };
@@ -0,0 +1,384 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace utility {
+/**
+ * @brief Open addressing hash map for small trivially copyable keys such as BtDeviceKey.
+ *        Entries lie in one array probed linearly, so a lookup hashes once and reads neighbouring slots instead of
+ *        chasing tree nodes. Erase shifts the following entries back instead of leaving tombstones.
+ *        Follows the std::map interface the service tables use; inserting may move every entry, erasing may move
+ *        the entries after the erased one, so iterators and references are only stable while the map is unchanged.
+ *        Iteration order is unspecified.
+ */
+template<class K, class V, class Hash = std::hash<K>>
+class FlatHashMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using size_type = size_t;
+
+    template<bool IS_CONST>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IS_CONST, const value_type *, value_type *>;
+        using reference = std::conditional_t<IS_CONST, const value_type &, value_type &>;
+        using Owner = std::conditional_t<IS_CONST, const FlatHashMap *, FlatHashMap *>;
+
+        Iterator() = default;
+        Iterator(Owner map, size_t index) : map_(map), index_(index)
+        {
+            Skip();
+        }
+        template<bool OTHER_CONST, class = std::enable_if_t<IS_CONST && !OTHER_CONST>>
+        Iterator(const Iterator<OTHER_CONST> &other) : map_(other.map_), index_(other.index_)
+        {}
+
+        reference operator*() const
+        {
+            return map_->slots_[index_];
+        }
+        pointer operator->() const
+        {
+            return &map_->slots_[index_];
+        }
+        Iterator &operator++()
+        {
+            index_++;
+            Skip();
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const Iterator &other) const
+        {
+            return index_ == other.index_;
+        }
+        bool operator!=(const Iterator &other) const
+        {
+            return index_ != other.index_;
+        }
+
+    private:
+        friend class FlatHashMap;
+        template<bool>
+        friend class Iterator;
+
+        void Skip()
+        {
+            while ((index_ < map_->capacity_) && !map_->used_[index_]) {
+                index_++;
+            }
+        }
+
+        Owner map_ {nullptr};
+        size_t index_ {0};
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    /**
+     * @brief Construct a new Flat Hash Map object
+     *
+     * @param capacity Number of entries to hold without growing.
+     * @since 6
+     */
+    explicit FlatHashMap(size_t capacity = 0)
+    {
+        if (capacity > 0) {
+            reserve(capacity);
+        }
+    }
+
+    FlatHashMap(const FlatHashMap &other)
+    {
+        reserve(other.size_);
+        for (const auto &entry : other) {
+            InsertUnique(entry.first, entry.second);
+        }
+    }
+
+    FlatHashMap(FlatHashMap &&other) noexcept
+    {
+        Swap(other);
+    }
+
+    FlatHashMap &operator=(FlatHashMap other) noexcept
+    {
+        Swap(other);
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the Flat Hash Map object
+     *
+     * @since 6
+     */
+    ~FlatHashMap()
+    {
+        clear();
+        std::allocator<value_type>().deallocate(slots_, capacity_);
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+    iterator end()
+    {
+        return iterator(this, capacity_);
+    }
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const
+    {
+        return const_iterator(this, capacity_);
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    iterator find(const K &key)
+    {
+        return iterator(this, FindIndex(key));
+    }
+    const_iterator find(const K &key) const
+    {
+        return const_iterator(this, FindIndex(key));
+    }
+    size_t count(const K &key) const
+    {
+        return (FindIndex(key) != capacity_) ? 1 : 0;
+    }
+
+    /**
+     * @brief Insert the entry unless the key is present.
+     *
+     * @return Entry of the key, and whether it was inserted.
+     * @since 6
+     */
+    std::pair<iterator, bool> insert(const value_type &entry)
+    {
+        return emplace(entry.first, entry.second);
+    }
+    template<class P>
+    std::pair<iterator, bool> insert(P &&entry)
+    {
+        return emplace(std::forward<P>(entry).first, std::forward<P>(entry).second);
+    }
+    template<class... Args>
+    std::pair<iterator, bool> emplace(const K &key, Args &&...args)
+    {
+        size_t index = FindIndex(key);
+        if (index != capacity_) {
+            return std::make_pair(iterator(this, index), false);
+        }
+        return std::make_pair(iterator(this, InsertUnique(key, std::forward<Args>(args)...)), true);
+    }
+
+    V &operator[](const K &key)
+    {
+        size_t index = FindIndex(key);
+        if (index == capacity_) {
+            index = InsertUnique(key);
+        }
+        return slots_[index].second;
+    }
+
+    size_t erase(const K &key)
+    {
+        size_t index = FindIndex(key);
+        if (index == capacity_) {
+            return 0;
+        }
+        EraseIndex(index);
+        return 1;
+    }
+
+    /**
+     * @brief Erase the entry at pos.
+     *
+     * @return Iterator to continue a loop with: it may point at pos again, where a following entry moved to.
+     *         Such a loop reaches every remaining entry, one that wrapped around the end of the array maybe twice.
+     * @since 6
+     */
+    iterator erase(const_iterator pos)
+    {
+        size_t index = pos.index_;
+        EraseIndex(index);
+        return iterator(this, index);
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < capacity_; i++) {
+            if (used_[i]) {
+                slots_[i].~value_type();
+                used_[i] = false;
+            }
+        }
+        size_ = 0;
+    }
+
+    /**
+     * @brief Grow so that count entries fit without another rehash.
+     *
+     * @since 6
+     */
+    void reserve(size_t count)
+    {
+        size_t capacity = MIN_CAPACITY;
+        while (capacity * MAX_LOAD_NUM < count * MAX_LOAD_DEN) {
+            capacity <<= 1;
+        }
+        if (capacity > capacity_) {
+            Rehash(capacity);
+        }
+    }
+
+private:
+    static constexpr size_t MIN_CAPACITY = 8;
+    // Linear probing stays short below three quarters full.
+    static constexpr size_t MAX_LOAD_NUM = 3;
+    static constexpr size_t MAX_LOAD_DEN = 4;
+
+    void Swap(FlatHashMap &other) noexcept
+    {
+        std::swap(slots_, other.slots_);
+        std::swap(used_, other.used_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+    }
+
+    size_t HomeIndex(const K &key) const
+    {
+        return Hash()(key) & (capacity_ - 1);
+    }
+
+    size_t FindIndex(const K &key) const
+    {
+        if (size_ == 0) {
+            return capacity_;
+        }
+        size_t mask = capacity_ - 1;
+        for (size_t index = HomeIndex(key);; index = (index + 1) & mask) {
+            if (!used_[index]) {
+                return capacity_;
+            }
+            if (slots_[index].first == key) {
+                return index;
+            }
+        }
+    }
+
+    template<class... Args>
+    size_t InsertUnique(const K &key, Args &&...args)
+    {
+        if ((size_ + 1) * MAX_LOAD_DEN > capacity_ * MAX_LOAD_NUM) {
+            Rehash((capacity_ == 0) ? MIN_CAPACITY : (capacity_ << 1));
+        }
+        size_t mask = capacity_ - 1;
+        size_t index = HomeIndex(key);
+        while (used_[index]) {
+            index = (index + 1) & mask;
+        }
+        new (&slots_[index]) value_type(std::piecewise_construct,
+            std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+        used_[index] = true;
+        size_++;
+        return index;
+    }
+
+    void EraseIndex(size_t index)
+    {
+        size_t mask = capacity_ - 1;
+        slots_[index].~value_type();
+        used_[index] = false;
+        size_--;
+        // Pull back every following entry of the run whose home slot does not lie between the hole and itself.
+        size_t hole = index;
+        for (size_t next = (index + 1) & mask; used_[next]; next = (next + 1) & mask) {
+            size_t home = HomeIndex(slots_[next].first);
+            if (((next - home) & mask) < ((next - hole) & mask)) {
+                continue;
+            }
+            new (&slots_[hole]) value_type(std::move(slots_[next]));
+            used_[hole] = true;
+            slots_[next].~value_type();
+            used_[next] = false;
+            hole = next;
+        }
+    }
+
+    void Rehash(size_t capacity)
+    {
+        value_type *oldSlots = slots_;
+        std::unique_ptr<bool[]> oldUsed = std::move(used_);
+        size_t oldCapacity = capacity_;
+
+        slots_ = std::allocator<value_type>().allocate(capacity);
+        used_ = std::make_unique<bool[]>(capacity);
+        capacity_ = capacity;
+        size_ = 0;
+        for (size_t i = 0; i < oldCapacity; i++) {
+            if (oldUsed[i]) {
+                size_t mask = capacity_ - 1;
+                size_t index = HomeIndex(oldSlots[i].first);
+                while (used_[index]) {
+                    index = (index + 1) & mask;
+                }
+                new (&slots_[index]) value_type(std::move(oldSlots[i]));
+                used_[index] = true;
+                size_++;
+                oldSlots[i].~value_type();
+            }
+        }
+        std::allocator<value_type>().deallocate(oldSlots, oldCapacity);
+    }
+
+    value_type *slots_ {nullptr};
+    std::unique_ptr<bool[]> used_ {};
+    size_t capacity_ {0};
+    size_t size_ {0};
+};
+}  // namespace utility
+
+#endif  // FLAT_HASH_MAP_H
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "base_def.h"
+
+namespace utility {
+/**
+ * @brief Bounded lock-free queue for many producers and a single consumer.
+ *        Every slot carries a sequence number, so producers only contend on one atomic increment and the
+ *        consumer never takes a lock.
+ */
+template<class T>
+class MpscQueue {
+public:
+    /**
+     * @brief Construct a new Mpsc Queue object
+     *
+     * @param capacity Queue's capacity, rounded up to a power of two.
+     * @since 6
+     */
+    explicit MpscQueue(size_t capacity);
+
+    /**
+     * @brief Destroy the Mpsc Queue object
+     *
+     * @since 6
+     */
+    ~MpscQueue() = default;
+
+    /**
+     * @brief Try push one record into MpscQueue. Safe to call from any thread.
+     *
+     * @param record Push record, moved from only on success.
+     * @return Success push record return true, queue full return false.
+     * @since 6
+     */
+    bool TryPush(T &&record);
+
+    /**
+     * @brief Try pop one record from MpscQueue. Only the consumer thread may call it.
+     *
+     * @param record Pop record object result.
+     * @return Success pop record return true, else return false.
+     *         A record whose producer is still writing it is reported as absent.
+     * @since 6
+     */
+    bool TryPop(T &record);
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence_ {0};
+        T data_ {};
+    };
+
+    static size_t RoundUp(size_t capacity);
+
+    size_t mask_ {0};
+    std::unique_ptr<Cell[]> cells_ {};
+    alignas(64) std::atomic<size_t> tail_ {0};
+    alignas(64) size_t head_ {0};
+
+    BT_DISALLOW_COPY_AND_ASSIGN(MpscQueue);
+};
+
+template<class T>
+size_t MpscQueue<T>::RoundUp(size_t capacity)
+{
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    return size;
+}
+
+template<class T>
+MpscQueue<T>::MpscQueue(size_t capacity)
+    : mask_(RoundUp(capacity) - 1), cells_(std::make_unique<Cell[]>(mask_ + 1))
+{
+    for (size_t i = 0; i <= mask_; i++) {
+        cells_[i].sequence_.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<class T>
+bool MpscQueue<T>::TryPush(T &&record)
+{
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    for (;;) {
+        cell = &cells_[pos & mask_];
+        size_t seq = cell->sequence_.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+    cell->data_ = std::move(record);
+    cell->sequence_.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<class T>
+bool MpscQueue<T>::TryPop(T &record)
+{
+    Cell &cell = cells_[head_ & mask_];
+    if (cell.sequence_.load(std::memory_order_acquire) != head_ + 1) {
+        return false;
+    }
+    record = std::move(cell.data_);
+    cell.data_ = T();
+    cell.sequence_.store(head_ + mask_ + 1, std::memory_order_release);
+    head_++;
+    return true;
+}
+}  // namespace utility
+
+#endif  // MPSC_QUEUE_H
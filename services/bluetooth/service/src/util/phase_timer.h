@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PHASE_TIMER_H
+#define PHASE_TIMER_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace utility {
+/**
+ * @brief Splits a sequence of steps into named phases on the monotonic clock, for startup time breakdowns.
+ */
+class PhaseTimer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    PhaseTimer() : start_(Clock::now()), last_(start_)
+    {}
+
+    /**
+     * @brief Close the phase running since the previous mark, or since construction.
+     *
+     * @param phase Phase name.
+     * @since 6
+     */
+    void Mark(const std::string &phase)
+    {
+        Clock::time_point now = Clock::now();
+        phases_.emplace_back(phase, ElapsedUs(last_, now));
+        last_ = now;
+    }
+
+    /**
+     * @brief Get the closed phases.
+     *
+     * @return Phase names with their durations in microseconds, in marking order.
+     * @since 6
+     */
+    const std::vector<std::pair<std::string, uint64_t>> &GetPhases() const
+    {
+        return phases_;
+    }
+
+    /**
+     * @brief Get the time from construction to the last mark.
+     *
+     * @return Microseconds.
+     * @since 6
+     */
+    uint64_t GetTotalUs() const
+    {
+        return ElapsedUs(start_, last_);
+    }
+
+    /**
+     * @brief Format the phases for logging, as "name=1.234ms ... total=5.678ms".
+     *
+     * @return Breakdown string.
+     * @since 6
+     */
+    std::string ToString() const
+    {
+        std::string out;
+        for (auto &phase : phases_) {
+            out += phase.first + "=" + FormatMs(phase.second) + " ";
+        }
+        return out + "total=" + FormatMs(GetTotalUs());
+    }
+
+    static uint64_t ElapsedUs(Clock::time_point from, Clock::time_point to)
+    {
+        return (to > from) ? std::chrono::duration_cast<std::chrono::microseconds>(to - from).count() : 0;
+    }
+
+    static std::string FormatMs(uint64_t us)
+    {
+        const uint64_t usPerMs = 1000;
+        char buf[32] = {};
+        (void)snprintf(buf, sizeof(buf), "%llu.%03llums", static_cast<unsigned long long>(us / usPerMs),
+            static_cast<unsigned long long>(us % usPerMs));
+        return buf;
+    }
+
+private:
+    Clock::time_point start_;
+    Clock::time_point last_;
+    std::vector<std::pair<std::string, uint64_t>> phases_ {};
+};
+}  // namespace utility
+
+#endif  // PHASE_TIMER_H
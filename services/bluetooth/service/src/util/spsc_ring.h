@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "base_def.h"
+
+namespace utility {
+/**
+ * @brief Bounded lock-free ring for one producer thread and one consumer thread.
+ *        Slots are allocated once and filled in place, so a record is written once by the producer and read where
+ *        it lies by the consumer.
+ */
+template<class T>
+class SpscRing {
+public:
+    /**
+     * @brief Construct a new Spsc Ring object
+     *
+     * @param capacity Ring's capacity, rounded up to a power of two.
+     * @since 6
+     */
+    explicit SpscRing(size_t capacity);
+
+    /**
+     * @brief Destroy the Spsc Ring object
+     *
+     * @since 6
+     */
+    ~SpscRing() = default;
+
+    /**
+     * @brief Get the free slot at the tail. Only the producer thread may call it.
+     *
+     * @return Slot to fill before Publish, nullptr when the ring is full.
+     * @since 6
+     */
+    T *Claim();
+
+    /**
+     * @brief Hand the slot returned by Claim to the consumer.
+     *
+     * @since 6
+     */
+    void Publish();
+
+    /**
+     * @brief Get the oldest published slot. Only the consumer thread may call it.
+     *
+     * @return Slot to read before Release, nullptr when the ring is empty.
+     * @since 6
+     */
+    T *Peek();
+
+    /**
+     * @brief Give the slot returned by Peek back to the producer.
+     *
+     * @since 6
+     */
+    void Release();
+
+    /**
+     * @brief Drop every published slot. Only the consumer thread, or any thread once the producer has stopped.
+     *
+     * @since 6
+     */
+    void Clear();
+
+    /**
+     * @brief Get the ring's capacity.
+     *
+     * @return Number of slots.
+     * @since 6
+     */
+    size_t Capacity() const;
+
+private:
+    static size_t RoundUp(size_t capacity);
+
+    size_t mask_ {0};
+    std::unique_ptr<T[]> slots_ {};
+    alignas(64) std::atomic<size_t> tail_ {0};
+    alignas(64) std::atomic<size_t> head_ {0};
+
+    BT_DISALLOW_COPY_AND_ASSIGN(SpscRing);
+};
+
+template<class T>
+size_t SpscRing<T>::RoundUp(size_t capacity)
+{
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    return size;
+}
+
+template<class T>
+SpscRing<T>::SpscRing(size_t capacity) : mask_(RoundUp(capacity) - 1), slots_(std::make_unique<T[]>(mask_ + 1))
+{}
+
+template<class T>
+T *SpscRing<T>::Claim()
+{
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) > mask_) {
+        return nullptr;
+    }
+    return &slots_[tail & mask_];
+}
+
+template<class T>
+void SpscRing<T>::Publish()
+{
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template<class T>
+T *SpscRing<T>::Peek()
+{
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return &slots_[head & mask_];
+}
+
+template<class T>
+void SpscRing<T>::Release()
+{
+    head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template<class T>
+void SpscRing<T>::Clear()
+{
+    head_.store(tail_.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+template<class T>
+size_t SpscRing<T>::Capacity() const
+{
+    return mask_ + 1;
+}
+}  // namespace utility
+
+#endif  // SPSC_RING_H
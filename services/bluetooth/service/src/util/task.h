@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TASK_H
+#define TASK_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "base_def.h"
+
+namespace utility {
+/**
+ * @brief Move-only void() callable.
+ *        Callables up to INLINE_SIZE bytes are stored in place, larger ones are heap allocated once.
+ */
+class Task {
+public:
+    static constexpr size_t INLINE_SIZE = 64;
+
+    /**
+     * @brief Construct an empty Task object.
+     *
+     * @since 6
+     */
+    Task() noexcept = default;
+
+    /**
+     * @brief Construct a new Task object from a callable, moving it when passed as rvalue.
+     *
+     * @param func Callable invoked as func().
+     * @since 6
+     */
+    template<class F, class Fn = typename std::decay<F>::type,
+        class = typename std::enable_if<!std::is_same<Fn, Task>::value>::type>
+    Task(F &&func)
+    {
+        if (IsEmpty(func)) {
+            return;
+        }
+        if constexpr (IsInline<Fn>()) {
+            new (&storage_) Fn(std::forward<F>(func));
+            ops_ = &INLINE_OPS<Fn>;
+        } else {
+            *reinterpret_cast<Fn **>(&storage_) = new Fn(std::forward<F>(func));
+            ops_ = &HEAP_OPS<Fn>;
+        }
+    }
+
+    Task(Task &&src) noexcept
+    {
+        MoveFrom(src);
+    }
+
+    Task &operator=(Task &&src) noexcept
+    {
+        if (this != &src) {
+            Reset();
+            MoveFrom(src);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the Task object
+     *
+     * @since 6
+     */
+    ~Task()
+    {
+        Reset();
+    }
+
+    /**
+     * @brief Invoke the stored callable. Must not be called on an empty Task.
+     *
+     * @since 6
+     */
+    void operator()()
+    {
+        ops_->invoke(&storage_);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return ops_ != nullptr;
+    }
+
+    /**
+     * @brief Check whether a callable of type Fn is stored without heap allocation.
+     *
+     * @since 6
+     */
+    template<class Fn>
+    static constexpr bool IsInline()
+    {
+        return sizeof(Fn) <= INLINE_SIZE && alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Fn>::value;
+    }
+
+private:
+    using Storage = typename std::aligned_storage<INLINE_SIZE, alignof(std::max_align_t)>::type;
+
+    struct Ops {
+        void (*invoke)(void *storage);
+        // Move-construct into dst from src and destroy src.
+        void (*relocate)(void *dst, void *src);
+        void (*destroy)(void *storage);
+    };
+
+    template<class Fn>
+    static void InlineInvoke(void *storage)
+    {
+        (*static_cast<Fn *>(storage))();
+    }
+
+    template<class Fn>
+    static void InlineRelocate(void *dst, void *src)
+    {
+        new (dst) Fn(std::move(*static_cast<Fn *>(src)));
+        static_cast<Fn *>(src)->~Fn();
+    }
+
+    template<class Fn>
+    static void InlineDestroy(void *storage)
+    {
+        static_cast<Fn *>(storage)->~Fn();
+    }
+
+    template<class Fn>
+    static void HeapInvoke(void *storage)
+    {
+        (**static_cast<Fn **>(storage))();
+    }
+
+    static void HeapRelocate(void *dst, void *src)
+    {
+        *static_cast<void **>(dst) = *static_cast<void **>(src);
+    }
+
+    template<class Fn>
+    static void HeapDestroy(void *storage)
+    {
+        delete *static_cast<Fn **>(storage);
+    }
+
+    template<class Fn>
+    static constexpr Ops INLINE_OPS = {&InlineInvoke<Fn>, &InlineRelocate<Fn>, &InlineDestroy<Fn>};
+
+    template<class Fn>
+    static constexpr Ops HEAP_OPS = {&HeapInvoke<Fn>, &HeapRelocate, &HeapDestroy<Fn>};
+
+    template<class F>
+    static bool IsEmpty(const F &func)
+    {
+        if constexpr (std::is_pointer<F>::value || std::is_member_pointer<F>::value ||
+                      std::is_constructible<bool, const F &>::value) {
+            return !func;
+        } else {
+            return false;
+        }
+    }
+
+    void MoveFrom(Task &src) noexcept
+    {
+        if (src.ops_ != nullptr) {
+            src.ops_->relocate(&storage_, &src.storage_);
+            ops_ = src.ops_;
+            src.ops_ = nullptr;
+        }
+    }
+
+    void Reset() noexcept
+    {
+        if (ops_ != nullptr) {
+            ops_->destroy(&storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    const Ops *ops_ {nullptr};
+    Storage storage_;
+
+    BT_DISALLOW_COPY_AND_ASSIGN(Task);
+};
+}  // namespace utility
+
+#endif  // TASK_H
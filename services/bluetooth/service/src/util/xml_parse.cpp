@@ -32,6 +32,8 @@ struct XmlParse::impl {
     bool GetValue(xmlNodePtr node, bool &value);
     bool HasProperty(xmlNodePtr node, const std::string &property);
     bool RemoveProperty(xmlNodePtr node, const std::string &property);
+    void TraverseProperties(xmlNodePtr node, const std::string &section, const std::string &subSection,
+        const PropertyVisitor &visitor);
 };
 
 xmlNodePtr XmlParse::impl::IntHasSection(const std::string &section, const std::string &subSection)
@@ -243,6 +245,29 @@ bool XmlParse::impl::RemoveProperty(xmlNodePtr node, const std::string &property
     return true;
 }
 
+void XmlParse::impl::TraverseProperties(xmlNodePtr node, const std::string &section,
+    const std::string &subSection, const PropertyVisitor &visitor)
+{
+    for (xmlNodePtr childNode = node->children; childNode; childNode = childNode->next) {
+        xmlChar *propertyNodeProp = xmlGetProp(childNode, BAD_CAST "property");
+        if (propertyNodeProp != NULL) {
+            std::string value;
+            GetValue(childNode, value);
+            visitor(section, subSection, (char *)propertyNodeProp, value);
+            xmlFree(propertyNodeProp);
+            continue;
+        }
+        xmlChar *subSectionNodeProp = xmlGetProp(childNode, BAD_CAST "section");
+        if (subSectionNodeProp != NULL) {
+            if (subSection == "") {
+                visitor(section, (char *)subSectionNodeProp, "", "");
+                TraverseProperties(childNode, section, (char *)subSectionNodeProp, visitor);
+            }
+            xmlFree(subSectionNodeProp);
+        }
+    }
+}
+
 XmlParse::XmlParse() : pimpl()
 {
     pimpl = std::make_unique<impl>();
@@ -557,4 +582,21 @@ bool XmlParse::RemoveProperty(const std::string &section, const std::string &pro
     xmlNodePtr sectionNode = pimpl->IntHasSection(section, "");
     return pimpl->RemoveProperty(sectionNode, property);
 }
-}  // namespace utility
\ No newline at end of file
+bool XmlParse::Traverse(const PropertyVisitor &visitor)
+{
+    xmlNodePtr rootNode = xmlDocGetRootElement(pimpl->doc_);
+    if (rootNode == NULL) {
+        return false;
+    }
+    for (xmlNodePtr btSectionNode = rootNode->children; btSectionNode; btSectionNode = btSectionNode->next) {
+        xmlChar *btSectionNodeProp = xmlGetProp(btSectionNode, BAD_CAST "section");
+        if (btSectionNodeProp == NULL) {
+            continue;
+        }
+        visitor((char *)btSectionNodeProp, "", "", "");
+        pimpl->TraverseProperties(btSectionNode, (char *)btSectionNodeProp, "", visitor);
+        xmlFree(btSectionNodeProp);
+    }
+    return true;
+}
+}  // namespace utility
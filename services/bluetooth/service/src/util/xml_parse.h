@@ -16,6 +16,7 @@
 #ifndef XML_PARSE_H
 #define XML_PARSE_H
 
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -26,6 +27,12 @@ namespace utility {
 #define BASE_16 16
 class XmlParse {
 public:
+    /**
+     * @brief Visitor of one property: section, subSection (empty if none), property and raw text value.
+     */
+    using PropertyVisitor = std::function<void(const std::string &section, const std::string &subSection,
+        const std::string &property, const std::string &value)>;
+
     /**
      * @brief Construct a new Xml Parse object
      *
@@ -301,6 +308,16 @@ public:
      */
     bool RemoveProperty(const std::string &section, const std::string &property);
 
+    /**
+     * @brief Visit every section and property of the XML document in document order.
+     *
+     * @param visitor Called once per section and sub-section with an empty property, before their properties,
+     *                and once per property with its raw text value.
+     * @return Success traverse XML document return true, else return false.
+     * @since 6
+     */
+    bool Traverse(const PropertyVisitor &visitor);
+
 private:
     std::string filePath_ {""};
 
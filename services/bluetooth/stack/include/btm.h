@@ -46,6 +46,16 @@ int BTSTACK_API BTM_Initialize();
  */
 int BTSTACK_API BTM_Close();
 
+/**
+ * @brief Run the processing queue of a stack module on another thread. Only RFCOMM, ATT, AVCTP, AVDTP and SDP
+ *        can leave the stack thread (group 0). Must be called before <b>BTM_Initialize</b>.
+ *
+ * @param moduleName Module name, for example <b>MODULE_NAME_AVDTP</b>.
+ * @param group Thread group, 0 to 3. Modules of the same group share one thread.
+ * @return Returns <b>BT_SUCCESS</b> if the operation is successful; returns others if the operation fails.
+ */
+int BTSTACK_API BTM_SetModuleThreadGroup(const char *moduleName, uint8_t group);
+
 #define BREDR_CONTROLLER 1
 #define LE_CONTROLLER 2
 
@@ -316,6 +326,23 @@ int BTSTACK_API BTM_SetLinkPolicySettings(const BtAddr *addr, uint16_t linkPolic
  */
 int BTSTACK_API BTM_ChangeConnectionPacketType(const BtAddr *addr, uint16_t packetType);
 
+typedef struct {
+    uint16_t totalPackets;      // ACL data packets the controller buffers.
+    uint16_t freePackets;       // Controller buffers free for any connection.
+    uint16_t inFlightPackets;   // Packets of this connection given to the controller and not completed yet.
+    uint16_t waitingPackets;    // Packets of this connection waiting in the host for a controller buffer.
+    uint32_t completedPackets;  // Packets of this connection the controller reported completed so far.
+} BtmAclFlowStatus;
+
+/**
+ * @brief Get the controller buffer credits and the transmit progress of a BR/EDR connection.
+ *
+ * @param addr Point to the remote address struct.
+ * @param status Point to the status struct to fill.
+ * @return Returns <b>BT_SUCCESS</b> if the operation is successful; returns others if the operation fails.
+ */
+int BTSTACK_API BTM_GetAclFlowStatus(const BtAddr *addr, BtmAclFlowStatus *status);
+
 /**
  * Controller
  */
@@ -579,6 +606,16 @@ void BTSTACK_API BTM_AddLePairedDevice(const BtmLePairedDevice *device);
  */
 void BTSTACK_API BTM_RemoveLePairedDevice(const BtAddr *addr);
 
+/**
+ * @brief Get the identity address of a LE Paired Device from any address it uses: the paired address, the
+ *        identity address or a resolvable private address that resolves with its Identity Resolving Key.
+ *
+ * @param addr The device address.
+ * @param identityAddress The identity address, or the paired address if the device has no identity address.
+ * @return Returns <b>BT_SUCCESS</b> if the device is paired; returns others if the operation fails.
+ */
+int BTSTACK_API BTM_GetLeIdentityAddress(const BtAddr *addr, BtAddr *identityAddress);
+
 #define OWN_ADDRESS_TYPE_PUBLIC 0x00
 #define OWN_ADDRESS_TYPE_RANDOM 0x01
 
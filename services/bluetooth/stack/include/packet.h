@@ -35,6 +35,7 @@ extern "C" {
 
 typedef struct Packet Packet;
 typedef uint16_t (*CalCrc16)(uint8_t data, uint16_t preCrc);
+typedef uint16_t (*CalCrc16Block)(const uint8_t *data, uint32_t length, uint16_t preCrc);
 
 /**
  * @brief Create new specified size(headsize, tailsize, payloadsize) packet.
@@ -159,6 +160,18 @@ BTSTACK_API uint32_t PacketPayloadWrite(const Packet *pkt, const uint8_t *src, u
  */
 BTSTACK_API void PacketPayloadAddLast(const Packet *pkt, const Buffer *buf);
 
+/**
+ * @brief Get Packet's payload segments without joining them into one buffer.
+ *        Empty segments are skipped, the buffers stay owned by the packet.
+ *
+ * @param pkt Packet pointer.
+ * @param segments Filled with up to maxCount payload buffers, in order.
+ * @param maxCount Size of segments.
+ * @return Number of payload segments, may be more than maxCount.
+ * @since 6
+ */
+BTSTACK_API uint32_t PacketPayloadSegments(const Packet *pkt, Buffer **segments, uint32_t maxCount);
+
 /**
  * @brief Get Packet size.
  *
@@ -254,6 +267,17 @@ BTSTACK_API uint16_t PacketCalCrc16(const Packet *pkt, CalCrc16 calCrc16);
  */
 BTSTACK_API int32_t PacketVerCrc16(const Packet *pkt, CalCrc16 calCrc16, uint16_t crcVal);
 
+/**
+ * @brief Packet calculate crc16 one payload segment at a time.
+ *        Head and payload segments are passed to calCrc16Block in order; the tail is not included.
+ *
+ * @param calCrc16Block CalCrc16Block algorithm.
+ * @param preCrc Crc of data preceding the packet, 0 to start a new frame.
+ * @return Computing result, can be passed as preCrc to continue over a following packet.
+ * @since 6
+ */
+BTSTACK_API uint16_t PacketCalCrc16Block(const Packet *pkt, CalCrc16Block calCrc16Block, uint16_t preCrc);
+
 #ifdef __cplusplus
 }
 #endif
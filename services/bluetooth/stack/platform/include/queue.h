@@ -80,6 +80,15 @@ void *QueueDequeue(Queue *queue);
  */
 void *QueueTryDequeue(Queue *queue);
 
+/**
+ * @brief Get the first data of the Queue without removing it.
+ *
+ * @param queue Queue's pointer.
+ * @return Succeed return data, queue empty return NULL.
+ * @since 6
+ */
+void *QueuePeek(Queue *queue);
+
 /**
  * @brief Get Queue EnqueueFd.
  *
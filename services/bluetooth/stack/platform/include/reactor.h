@@ -28,6 +28,10 @@ typedef struct ReactorItem ReactorItem;
 
 typedef enum { REACTOR_STATUS_STOP, REACTOR_STATUS_ERROR, REACTOR_STATUS_DONE } ReactorStatus;
 
+#ifndef REACTOR_DEFAULT_EVENT_BATCH_SIZE
+#define REACTOR_DEFAULT_EVENT_BATCH_SIZE 64
+#endif
+
 /**
  * @brief Perform instantiation of the Reactor.
  *        Succeed return Reactor instantiation, failed return NULL.
@@ -72,6 +76,15 @@ void ReactorStop(const Reactor *reactor);
  */
 void ReactorSetThreadId(Reactor *reactor, unsigned long threadId);
 
+/**
+ * @brief Set how many ready events the reactor fetches per wakeup. Must be called before ReactorStart.
+ *
+ * @param reactor Reactor pointer.
+ * @param batchSize Events per epoll_wait, default is REACTOR_DEFAULT_EVENT_BATCH_SIZE.
+ * @since 6
+ */
+void ReactorSetEventBatchSize(Reactor *reactor, int32_t batchSize);
+
 /**
  * @brief Register item into reactor
  *
@@ -88,6 +101,8 @@ ReactorItem *ReactorRegister(Reactor *reactor, int32_t fd, void *context, void (
 
 /**
  * @brief UnRegist item from reactor. As well as delete it.
+ *        When called from another thread, it returns only after any running callback of the item has finished.
+ *        No callback of the item runs after it returns.
  *
  * @param item ReactorItem pointer.
  * @since 6
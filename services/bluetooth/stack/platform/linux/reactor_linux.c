@@ -14,48 +14,67 @@
  */
 
 #include "platform/include/reactor.h"
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <pthread.h>
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
 #include "platform/include/mutex.h"
-#include "platform/include/list.h"
-#include "platform/include/semaphore.h"
 #include "platform/include/platform_def.h"
 
-typedef struct Reactor {
-    int epollFd;
-    int stopFd;
-    bool isRunning;
-    bool itemRemoved;
-    pthread_t threadId;
-    List *movedItems;
-    Mutex *apiMutex;
-} ReactorInternal;
+#define REACTOR_CHUNK_SHIFT 6
+#define REACTOR_CHUNK_SIZE (1 << REACTOR_CHUNK_SHIFT)
+#define REACTOR_MAX_CHUNKS 64
+#define REACTOR_NO_ITEM 0
+#define REACTOR_STOP_KEY UINT64_MAX
+#define REACTOR_GENERATION_SHIFT 32
 
+/*
+ * Items live in slots that are never freed while the reactor exists. Each epoll event carries the slot index
+ * and the slot generation at registration time; unregistering bumps the generation, so events that were
+ * already fetched for a removed item are recognised as stale without taking a lock.
+ */
 typedef struct ReactorItem {
+    atomic_uint_least32_t generation;
+    uint32_t index;
     int fd;
-    Mutex *lock;
     Reactor *reactor;
     void *context;
     void (*onReadReady)(void *context);
     void (*onWriteReady)(void *context);
+    struct ReactorItem *nextFree;
 } ReactorItemInternal;
 
-const int MAXEPOLLEVENTS = 64;
+typedef struct Reactor {
+    int epollFd;
+    int stopFd;
+    bool isRunning;
+    pthread_t threadId;
+    int32_t eventBatchSize;
+    // Index + 1 of the item whose callbacks are running, REACTOR_NO_ITEM when idle.
+    atomic_uint_least32_t dispatching;
+    // Threads blocked in ReactorUnregister until the callbacks of their item return.
+    atomic_uint_least32_t unregisterWaiters;
+    pthread_mutex_t dispatchMutex;
+    pthread_cond_t dispatchDone;
+    _Atomic(ReactorItem *) chunks[REACTOR_MAX_CHUNKS];
+    uint32_t chunkNum;
+    ReactorItem *freeItems;
+    Mutex *apiMutex;
+} ReactorInternal;
 
-static inline bool DataCmp(void *data1, void *data2)
+void ReactorSetThreadId(Reactor *reactor, unsigned long threadId)
 {
-    if (data1 != data2) {
-        return false;
-    }
-    return true;
+    reactor->threadId = (pthread_t)threadId;
 }
 
-void ReactorSetThreadId(Reactor *reactor, unsigned long threadId)
+void ReactorSetEventBatchSize(Reactor *reactor, int32_t batchSize)
 {
-    reactor->threadId = (pthread_t)threadId;
+    ASSERT(reactor);
+    if (batchSize > 0) {
+        reactor->eventBatchSize = batchSize;
+    }
 }
 
 Reactor *ReactorCreate()
@@ -63,21 +82,26 @@ Reactor *ReactorCreate()
     Reactor *reactor = (Reactor *)calloc(1, sizeof(Reactor));
     reactor->epollFd = -1;
     reactor->stopFd = -1;
+    reactor->eventBatchSize = REACTOR_DEFAULT_EVENT_BATCH_SIZE;
+    pthread_mutex_init(&reactor->dispatchMutex, NULL);
+    pthread_cond_init(&reactor->dispatchDone, NULL);
 
     int epollFd = epoll_create1(EPOLL_CLOEXEC);
     if (epollFd == -1) {
         LOG_ERROR("ReatorCreate: epoll create failed, error no: %{public}d.", errno);
         goto ERROR;
     }
+    reactor->epollFd = epollFd;
 
     int stopFd = eventfd(0, 0);
     if (stopFd == -1) {
         LOG_ERROR("ReatorCreate: eventfd failed, error no: %{public}d.", errno);
         goto ERROR;
     }
+    reactor->stopFd = stopFd;
 
     struct epoll_event event = {0};
-    event.data.ptr = NULL;
+    event.data.u64 = REACTOR_STOP_KEY;
     event.events = EPOLLIN;
 
     if (epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &event) == -1) {
@@ -85,16 +109,10 @@ Reactor *ReactorCreate()
         goto ERROR;
     }
 
-    reactor->movedItems = ListCreate(NULL);
-    if (reactor->movedItems == NULL) {
-        goto ERROR;
-    }
     reactor->apiMutex = MutexCreate();
     if (reactor->apiMutex == NULL) {
         goto ERROR;
     }
-    reactor->epollFd = epollFd;
-    reactor->stopFd = stopFd;
 
     return reactor;
 
@@ -109,66 +127,94 @@ void ReactorDelete(Reactor *reactor)
         return;
     }
 
+    for (uint32_t i = 0; i < reactor->chunkNum; i++) {
+        free(atomic_load_explicit(&reactor->chunks[i], memory_order_relaxed));
+    }
     MutexDelete(reactor->apiMutex);
-    ListDelete(reactor->movedItems);
+    pthread_cond_destroy(&reactor->dispatchDone);
+    pthread_mutex_destroy(&reactor->dispatchMutex);
     close(reactor->stopFd);
     close(reactor->epollFd);
     free(reactor);
 }
 
+static inline ReactorItem *ReactorGetItem(Reactor *reactor, uint32_t index)
+{
+    if ((index >> REACTOR_CHUNK_SHIFT) >= REACTOR_MAX_CHUNKS) {
+        return NULL;
+    }
+    ReactorItem *chunk = atomic_load_explicit(&reactor->chunks[index >> REACTOR_CHUNK_SHIFT], memory_order_acquire);
+    if (chunk == NULL) {
+        return NULL;
+    }
+    return &chunk[index & (REACTOR_CHUNK_SIZE - 1)];
+}
+
+static void ReactorDispatch(Reactor *reactor, const struct epoll_event *event)
+{
+    uint32_t index = (uint32_t)event->data.u64;
+    uint32_t generation = (uint32_t)(event->data.u64 >> REACTOR_GENERATION_SHIFT);
+    ReactorItem *item = ReactorGetItem(reactor, index);
+    if (item == NULL) {
+        return;
+    }
+
+    // Publish the slot before checking its generation; ReactorUnregister does the reverse, so either the
+    // event is seen as stale here or the unregistering thread waits for the callbacks below to return.
+    atomic_store(&reactor->dispatching, index + 1);
+    if (atomic_load(&item->generation) == generation) {
+        if ((event->events & (EPOLLIN | EPOLLRDHUP)) && (item->onReadReady != NULL)) {
+            item->onReadReady(item->context);
+        }
+        if ((event->events & EPOLLOUT) && (item->onWriteReady != NULL) &&
+            (atomic_load(&item->generation) == generation)) {
+            item->onWriteReady(item->context);
+        }
+    }
+    // Clear the slot before counting waiters; ReactorUnregister counts itself before checking the slot, so a
+    // waiter either sees the slot cleared or is woken here.
+    atomic_store(&reactor->dispatching, REACTOR_NO_ITEM);
+    if (atomic_load(&reactor->unregisterWaiters) != 0) {
+        pthread_mutex_lock(&reactor->dispatchMutex);
+        pthread_cond_broadcast(&reactor->dispatchDone);
+        pthread_mutex_unlock(&reactor->dispatchMutex);
+    }
+}
+
 int32_t ReactorStart(Reactor *reactor)
 {
     ASSERT(reactor);
 
+    struct epoll_event *events = (struct epoll_event *)malloc(sizeof(struct epoll_event) * reactor->eventBatchSize);
+    if (events == NULL) {
+        return -1;
+    }
     reactor->isRunning = true;
 
-    struct epoll_event events[MAXEPOLLEVENTS];
+    int timeout = -1;
     for (;;) {
-        MutexLock(reactor->apiMutex);
-        ListClear(reactor->movedItems);
-        MutexUnlock(reactor->apiMutex);
-
         int nfds;
-        CHECK_EXCEPT_INTR(nfds = epoll_wait(reactor->epollFd, events, MAXEPOLLEVENTS, -1));
+        CHECK_EXCEPT_INTR(nfds = epoll_wait(reactor->epollFd, events, reactor->eventBatchSize, timeout));
         if (nfds == -1) {
             reactor->isRunning = false;
             LOG_ERROR("ReactorStart: epoll_wait failed, error no: %{public}d.", errno);
+            free(events);
             return -1;
         }
 
         for (int i = 0; i < nfds; ++i) {
-            if (events[i].data.ptr == NULL) {
+            if (events[i].data.u64 == REACTOR_STOP_KEY) {
                 eventfd_t val;
                 eventfd_read(reactor->stopFd, &val);
                 reactor->isRunning = false;
+                free(events);
                 return 0;
             }
-
-            ReactorItem *item = (ReactorItem *)events[i].data.ptr;
-
-            MutexLock(reactor->apiMutex);
-            if (ListForEachData(reactor->movedItems, DataCmp, item) != NULL) {
-                MutexUnlock(reactor->apiMutex);
-                continue;
-            }
-
-            MutexLock(item->lock);
-            MutexUnlock(reactor->apiMutex);
-            reactor->itemRemoved = false;
-            if ((events[i].events & (EPOLLIN | EPOLLRDHUP)) && (item->onReadReady != NULL)) {
-                item->onReadReady(item->context);
-            }
-            if ((events[i].events & EPOLLOUT) && (item->onWriteReady != NULL) && (!reactor->itemRemoved)) {
-                item->onWriteReady(item->context);
-            }
-
-            MutexUnlock(item->lock);
-
-            if (reactor->itemRemoved) {
-                free(item->lock);
-                free(item);
-            }
+            ReactorDispatch(reactor, &events[i]);
         }
+
+        // A full batch may have left ready fds behind, collect them before blocking again.
+        timeout = (nfds == reactor->eventBatchSize) ? 0 : -1;
     }
 }
 
@@ -178,26 +224,61 @@ void ReactorStop(const Reactor *reactor)
     eventfd_write(reactor->stopFd, 1);
 }
 
+static ReactorItem *ReactorAllocItem(Reactor *reactor)
+{
+    if (reactor->freeItems == NULL) {
+        if (reactor->chunkNum >= REACTOR_MAX_CHUNKS) {
+            return NULL;
+        }
+        ReactorItem *chunk = (ReactorItem *)calloc(REACTOR_CHUNK_SIZE, sizeof(ReactorItem));
+        if (chunk == NULL) {
+            return NULL;
+        }
+        for (int i = REACTOR_CHUNK_SIZE - 1; i >= 0; i--) {
+            chunk[i].index = (reactor->chunkNum << REACTOR_CHUNK_SHIFT) + (uint32_t)i;
+            chunk[i].reactor = reactor;
+            chunk[i].nextFree = reactor->freeItems;
+            reactor->freeItems = &chunk[i];
+        }
+        atomic_store_explicit(&reactor->chunks[reactor->chunkNum], chunk, memory_order_release);
+        reactor->chunkNum++;
+    }
+
+    ReactorItem *item = reactor->freeItems;
+    reactor->freeItems = item->nextFree;
+    item->nextFree = NULL;
+    return item;
+}
+
+static void ReactorFreeItem(Reactor *reactor, ReactorItem *item)
+{
+    item->context = NULL;
+    item->onReadReady = NULL;
+    item->onWriteReady = NULL;
+    item->nextFree = reactor->freeItems;
+    reactor->freeItems = item;
+}
+
 ReactorItem *ReactorRegister(
     Reactor *reactor, int fd, void *context, void (*onReadReady)(void *context), void (*onWriteReady)(void *context))
 {
     ASSERT(reactor);
 
-    ReactorItem *item = (ReactorItem *)calloc(1, (sizeof(ReactorItem)));
-
-    item->lock = MutexCreate();
-    if (item->lock == NULL) {
-        goto ERROR;
+    MutexLock(reactor->apiMutex);
+    ReactorItem *item = ReactorAllocItem(reactor);
+    if (item == NULL) {
+        MutexUnlock(reactor->apiMutex);
+        LOG_ERROR("ReactorRegister: no free item.");
+        return NULL;
     }
 
     item->fd = fd;
     item->context = context;
-    item->reactor = reactor;
     item->onReadReady = onReadReady;
     item->onWriteReady = onWriteReady;
 
     struct epoll_event event = {0};
-    event.data.ptr = item;
+    event.data.u64 = ((uint64_t)atomic_load(&item->generation) << REACTOR_GENERATION_SHIFT) | item->index;
     if (onReadReady != NULL) {
         event.events |= (EPOLLIN | EPOLLRDHUP);
     }
@@ -206,36 +287,40 @@ ReactorItem *ReactorRegister(
     }
 
     if (epoll_ctl(reactor->epollFd, EPOLL_CTL_ADD, item->fd, &event) == -1) {
-        goto ERROR;
+        LOG_ERROR("ReactorRegister: epoll_ctl add-option failed, error no: %{public}d.", errno);
+        ReactorFreeItem(reactor, item);
+        MutexUnlock(reactor->apiMutex);
+        return NULL;
     }
+    MutexUnlock(reactor->apiMutex);
 
     return item;
-
-ERROR:
-    if (item != NULL) {
-        MutexDelete(item->lock);
-        free(item);
-    }
-
-    return NULL;
 }
 
 void ReactorUnregister(ReactorItem *item)
 {
     ASSERT(item);
+    Reactor *reactor = item->reactor;
 
     struct epoll_event event = {0};
-    if (epoll_ctl(item->reactor->epollFd, EPOLL_CTL_DEL, item->fd, &event) != 0) {
+    if (epoll_ctl(reactor->epollFd, EPOLL_CTL_DEL, item->fd, &event) != 0) {
         LOG_ERROR("ReactorUnregister: epoll_ctl delete-option failed, error no: %{public}d.", errno);
     }
 
-    if (pthread_equal(item->reactor->threadId, pthread_self())) {
-        if (item->reactor->isRunning) {
-            item->reactor->itemRemoved = true;
-            return;
+    atomic_fetch_add(&item->generation, 1);
+    // On the reactor thread the item is unregistering itself from its own callback, nothing to wait for.
+    if (!pthread_equal(reactor->threadId, pthread_self())) {
+        // Callbacks of this item may be running on the reactor thread right now.
+        atomic_fetch_add(&reactor->unregisterWaiters, 1);
+        pthread_mutex_lock(&reactor->dispatchMutex);
+        while (atomic_load(&reactor->dispatching) == item->index + 1) {
+            pthread_cond_wait(&reactor->dispatchDone, &reactor->dispatchMutex);
         }
+        pthread_mutex_unlock(&reactor->dispatchMutex);
+        atomic_fetch_sub(&reactor->unregisterWaiters, 1);
     }
 
-    free(item->lock);
-    free(item);
-}
\ No newline at end of file
+    MutexLock(reactor->apiMutex);
+    ReactorFreeItem(reactor, item);
+    MutexUnlock(reactor->apiMutex);
+}
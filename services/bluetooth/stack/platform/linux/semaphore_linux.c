@@ -14,7 +14,9 @@
  */
 
 #include "platform/include/semaphore.h"
+#include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/eventfd.h>
@@ -78,8 +80,12 @@ void SemaphoreWait(const Semaphore *sem)
 {
     ASSERT(sem);
 
+    // A concurrent SemaphoreTryWait/SemaphoreTryPost briefly makes the fd non-blocking, wait for a count then.
     eventfd_t val;
-    eventfd_read(sem->fd, &val);
+    while (eventfd_read(sem->fd, &val) == -1 && (errno == EAGAIN || errno == EINTR)) {
+        struct pollfd pfd = {.fd = sem->fd, .events = POLLIN, .revents = 0};
+        (void)poll(&pfd, 1, -1);
+    }
 }
 
 int32_t SemaphoreTryWait(Semaphore *sem)
@@ -97,16 +103,15 @@ int32_t SemaphoreTryWait(Semaphore *sem)
     }
 
     eventfd_t val;
-    if (eventfd_read(sem->fd, &val) == -1) {
-        goto ERROR;
-    }
+    int32_t result = (eventfd_read(sem->fd, &val) == -1) ? -1 : 0;
 
+    // Restore blocking mode even when nothing was read, SemaphoreWait relies on it.
     if (fcntl(sem->fd, F_SETFL, flags) == -1) {
         goto ERROR;
     }
 
     MutexUnlock(sem->mutex);
-    return 0;
+    return result;
 
 ERROR:
     MutexUnlock(sem->mutex);
@@ -134,16 +139,14 @@ int32_t SemaphoreTryPost(Semaphore *sem)
         goto ERROR;
     }
 
-    if (eventfd_write(sem->fd, 1) == -1) {
-        goto ERROR;
-    }
+    int32_t result = (eventfd_write(sem->fd, 1) == -1) ? -1 : 0;
 
     if (fcntl(sem->fd, F_SETFL, flags) == -1) {
         goto ERROR;
     }
 
     MutexUnlock(sem->mutex);
-    return 0;
+    return result;
 
 ERROR:
     MutexUnlock(sem->mutex);
@@ -160,6 +160,23 @@ void PacketPayloadAddLast(const Packet *pkt, const Buffer *buf)
     }
 }
 
+uint32_t PacketPayloadSegments(const Packet *pkt, Buffer **segments, uint32_t maxCount)
+{
+    ASSERT(pkt);
+    uint32_t count = 0;
+    Payload *node = pkt->payload;
+    while (node != pkt->tail) {
+        if (BufferGetSize(node->buf) != 0) {
+            if ((segments != NULL) && (count < maxCount)) {
+                segments[count] = node->buf;
+            }
+            count++;
+        }
+        node = node->next;
+    }
+    return count;
+}
+
 void PacketFree(Packet *pkt)
 {
     if (pkt == NULL) {
@@ -547,6 +564,19 @@ uint16_t PacketCalCrc16(const Packet *pkt, CalCrc16 calCrc16)
     return retVal;
 }
 
+uint16_t PacketCalCrc16Block(const Packet *pkt, CalCrc16Block calCrc16Block, uint16_t preCrc)
+{
+    uint16_t retVal = preCrc;
+    Payload *iter = pkt->head;
+    while (iter != pkt->tail) {
+        Buffer *buf = iter->buf;
+        retVal = calCrc16Block(BufferPtr(buf), BufferGetSize(buf), retVal);
+        iter = iter->next;
+    }
+
+    return retVal;
+}
+
 int32_t PacketVerCrc16(const Packet *pkt, CalCrc16 calCrc16, uint16_t crcVal)
 {
     uint16_t calVal = 0;
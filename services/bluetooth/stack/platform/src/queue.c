@@ -159,6 +159,21 @@ void *QueueTryDequeue(Queue *queue)
     return data;
 }
 
+void *QueuePeek(Queue *queue)
+{
+    ASSERT(queue);
+    void *data = NULL;
+
+    MutexLock(queue->mutex);
+    ListNode *listNode = ListGetFirstNode(queue->list);
+    if (listNode != NULL) {
+        data = ListGetNodeData(listNode);
+    }
+    MutexUnlock(queue->mutex);
+
+    return data;
+}
+
 int32_t QueueGetEnqueueFd(const Queue *queue)
 {
     ASSERT(queue);
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file att_async_context.c
+ *
+ * @brief implement per connection storage of async contexts.
+ *
+ */
+
+#include "att_async_context.h"
+
+#include <stdatomic.h>
+
+#include "platform/include/allocator.h"
+
+#define ATT_ASYNC_CONTEXT_FULL 0xFFFFFFFFu
+
+typedef union {
+    uint8_t data[ATT_ASYNC_CONTEXT_SIZE];
+    void *alignPtr;
+    uint64_t alignU64;
+} AttAsyncContextBlock;
+
+typedef struct {
+    AttAsyncContextBlock block[ATT_ASYNC_CONTEXT_NUM];
+    _Atomic uint32_t used;
+} AttAsyncContextSlab;
+
+// Contexts are allocated on the caller thread and released on the ATT thread, so slots are claimed lock-free.
+static AttAsyncContextSlab g_asyncContextSlab[ATT_ASYNC_SLAB_NUM];
+
+void *AttAsyncContextAlloc(uint16_t connectHandle, size_t size)
+{
+    if ((size > ATT_ASYNC_CONTEXT_SIZE) || (connectHandle == 0) || (connectHandle > ATT_ASYNC_SLAB_NUM)) {
+        return MEM_MALLOC.alloc(size);
+    }
+
+    AttAsyncContextSlab *slab = &g_asyncContextSlab[connectHandle - 1];
+    uint32_t used = atomic_load_explicit(&slab->used, memory_order_relaxed);
+    while (used != ATT_ASYNC_CONTEXT_FULL) {
+        int slot = __builtin_ctz(~used);
+        if (atomic_compare_exchange_weak_explicit(
+            &slab->used, &used, used | (1u << slot), memory_order_acquire, memory_order_relaxed)) {
+            return slab->block[slot].data;
+        }
+    }
+
+    return MEM_MALLOC.alloc(size);
+}
+
+void AttAsyncContextFree(void *context)
+{
+    uintptr_t addr = (uintptr_t)context;
+    uintptr_t begin = (uintptr_t)&g_asyncContextSlab[0];
+    uintptr_t end = (uintptr_t)&g_asyncContextSlab[ATT_ASYNC_SLAB_NUM];
+
+    if ((addr < begin) || (addr >= end)) {
+        MEM_MALLOC.free(context);
+        return;
+    }
+
+    AttAsyncContextSlab *slab = &g_asyncContextSlab[(addr - begin) / sizeof(AttAsyncContextSlab)];
+    uint32_t slot = (uint32_t)((addr - (uintptr_t)slab->block) / sizeof(AttAsyncContextBlock));
+    atomic_fetch_and_explicit(&slab->used, ~(1u << slot), memory_order_release);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file att_async_context.h
+ *
+ * @brief declare per connection storage of async contexts.
+ *
+ */
+
+#ifndef ATT_ASYNC_CONTEXT_H
+#define ATT_ASYNC_CONTEXT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// One slab per connect handle 1..ATT_ASYNC_SLAB_NUM, must cover MAXCONNECT.
+#define ATT_ASYNC_SLAB_NUM 22
+#define ATT_ASYNC_CONTEXT_NUM 32
+#define ATT_ASYNC_CONTEXT_SIZE 32
+
+/**
+ * @brief alloc an async context for an ATT request on connectHandle, may be called from any thread.
+ *        Contexts up to ATT_ASYNC_CONTEXT_SIZE bytes come from the slab of the connection, others and
+ *        overflow come from the heap.
+ *
+ * @param1 connectHandle Indicates the connect handle.
+ * @param2 size Indicates the context size.
+ * @return Returns the pointer to context, NULL if out of memory.
+ */
+void *AttAsyncContextAlloc(uint16_t connectHandle, size_t size);
+
+/**
+ * @brief free an async context allocated by AttAsyncContextAlloc, may be called from any thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+void AttAsyncContextFree(void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // ATT_ASYNC_CONTEXT_H
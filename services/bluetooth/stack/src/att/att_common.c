@@ -21,7 +21,9 @@
  */
 
 #include "att_common.h"
+#include "att_async_context.h"
 #include "att_connect.h"
+#include "att_connect_index.h"
 
 #include <stdlib.h>
 
@@ -32,7 +34,14 @@
 
 #include "../btm/btm_thread.h"
 
+#if (MAXCONNECT > ATT_CONNECT_INDEX_SLOTS) || (MAXCONNECT > ATT_ASYNC_SLAB_NUM)
+#error "MAXCONNECT exceeds the connect index or async context slabs"
+#endif
+
 static AttConnectInfo g_connectInfo[MAXCONNECT] = {0};
+// Occupied g_connectInfo slots by aclHandle, and BR/EDR slots by cid; received PDUs are resolved through these.
+static AttConnectIndex g_aclHandleIndex = {0};
+static AttConnectIndex g_bredrCidIndex = {0};
 static AttConnectingInfo g_connecting[MAXCONNECT] = {0};
 static AttClientDataCallback g_attClientCallback;
 static AttServerDataCallback g_attServerCallback;
@@ -54,6 +63,7 @@ typedef struct BREDRRecvSendDataCallbackAsyncContext {
 
 typedef struct TransactionTimeOutContext {
     uint16_t connectHandle;
+    bool indication;
 } TransactionTimeOutContext;
 
 typedef struct AttRecvDataAsyncContext {
@@ -73,6 +83,7 @@ typedef struct AttConnectRegisterContext {
 } AttConnectRegisterContext;
 
 static void AttTransactionTimeOut(const void *parameter);
+static void AttIndicationTimeOut(const void *parameter);
 
 static void AttClientDataRegisterAsync(const void *context);
 static void AttClientDataRegisterAsyncDestroy(const void *context);
@@ -112,6 +123,7 @@ static void AttBREDRSendRespCallback(uint16_t lcid, int result);
 static void AttLeSendRespCallbackAsync(const void *context);
 static void AttLeSendRespCallbackAsyncDestroy(const void *context);
 static void AttLeSendRespCallback(uint16_t aclHandle, int result);
+static int AttServerSendData(const AttConnectInfo *connect, const Packet *packet);
 
 static void AttTransactionTimeOutAsync(const void *context)
 {
@@ -131,7 +143,7 @@ static void AttTransactionTimeOutAsync(const void *context)
         goto ATTTRANSACTIONTIMEOUT_END;
     }
 
-    if (!connect->serverSendFlag) {
+    if (!transTimeOutPtr->indication) {
         attClientDataCallback = AttGetATTClientCallback();
         if ((attClientDataCallback == NULL) || (attClientDataCallback->attClientCallback == NULL)) {
             LOG_WARN("%{public}s attClientDataCallback or attClientDataCallback->attClientCallback is NULL",
@@ -141,7 +153,6 @@ static void AttTransactionTimeOutAsync(const void *context)
                 connect->retGattConnectHandle, ATT_TRANSACTION_TIME_OUT_ID, NULL, NULL, attClientDataCallback->context);
         }
     } else {
-        connect->serverSendFlag = false;
         attServerDataCallback = AttGetATTServerCallback();
         if ((attServerDataCallback == NULL) || (attServerDataCallback->attServerCallback == NULL)) {
             LOG_WARN("%{public}s attServerDataCallback or attServerDataCallback->attServerCallback is NULL",
@@ -153,9 +164,14 @@ static void AttTransactionTimeOutAsync(const void *context)
     }
 
     InitiativeDisconnect(transTimeOutPtr->connectHandle);
-    listSize = ListGetSize(connect->instruct);
-    for (; listSize > 0; --listSize) {
-        ListRemoveLast(connect->instruct);
+    // Only the queue of the expired transaction is dropped, the other one is left to the disconnection.
+    if (!transTimeOutPtr->indication) {
+        listSize = ListGetSize(connect->instruct);
+        for (; listSize > 0; --listSize) {
+            ListRemoveLast(connect->instruct);
+        }
+    } else {
+        ListClear(connect->indication);
     }
 
 ATTTRANSACTIONTIMEOUT_END:
@@ -175,27 +191,54 @@ static void AttTransactionTimeOutAsyncDestroy(const void *context)
 }
 
 /**
- * @brief att transaction timeout.
+ * @brief post a transaction timeout to the att thread.
  *
- * @param parameter Indicates the pointer to parameter.
+ * @param1 connect Indicates the pointer to AttConnectInfo.
+ * @param2 indication Indicates whether the server indication or the client request timed out.
  */
-static void AttTransactionTimeOut(const void *parameter)
+static void AttPostTransactionTimeOut(const AttConnectInfo *connect, bool indication)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
-
-    AttConnectInfo *connect = (AttConnectInfo *)parameter;
     TransactionTimeOutContext *transTimeOutPtr = MEM_MALLOC.alloc(sizeof(TransactionTimeOutContext));
     if (transTimeOutPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
     }
     transTimeOutPtr->connectHandle = connect->retGattConnectHandle;
+    transTimeOutPtr->indication = indication;
 
     AttAsyncProcess(AttTransactionTimeOutAsync, AttTransactionTimeOutAsyncDestroy, transTimeOutPtr);
 
     return;
 }
 
+/**
+ * @brief att transaction timeout.
+ *
+ * @param parameter Indicates the pointer to parameter.
+ */
+static void AttTransactionTimeOut(const void *parameter)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttPostTransactionTimeOut((const AttConnectInfo *)parameter, false);
+
+    return;
+}
+
+/**
+ * @brief att indication timeout.
+ *
+ * @param parameter Indicates the pointer to parameter.
+ */
+static void AttIndicationTimeOut(const void *parameter)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttPostTransactionTimeOut((const AttConnectInfo *)parameter, true);
+
+    return;
+}
+
 /**
  * @brief get AttConnectInfo information.
  *
@@ -220,9 +263,16 @@ void AttGetConnectInfoIndexByAclHandle(uint16_t aclHandle, AttConnectInfo **conn
 
     uint16_t index = 0;
 
-    for (; index < MAXCONNECT; ++index) {
-        if (g_connectInfo[index].aclHandle == aclHandle) {
-            break;
+    if (aclHandle == 0) {
+        for (; index < MAXCONNECT; ++index) {
+            if (g_connectInfo[index].aclHandle == aclHandle) {
+                break;
+            }
+        }
+    } else {
+        index = AttConnectIndexFind(&g_aclHandleIndex, aclHandle);
+        if (index == ATT_CONNECT_INDEX_NONE) {
+            index = MAXCONNECT;
         }
     }
 
@@ -246,18 +296,26 @@ void AttGetConnectInfoIndexByCid(uint16_t cid, AttConnectInfo **connect)
 {
     LOG_INFO("%{public}s enter, cid = %hu", __FUNCTION__, cid);
 
-    uint16_t index = 0;
+    uint16_t index = MAXCONNECT;
+    uint16_t leIndex;
 
-    for (; index < MAXCONNECT; ++index) {
-        if (g_connectInfo[index].transportType == BT_TRANSPORT_BR_EDR) {
-            if (g_connectInfo[index].AttConnectID.bredrcid == cid) {
+    if (cid == 0) {
+        for (index = 0; index < MAXCONNECT; ++index) {
+            if (((g_connectInfo[index].transportType == BT_TRANSPORT_BR_EDR) &&
+                    (g_connectInfo[index].AttConnectID.bredrcid == cid)) ||
+                ((g_connectInfo[index].transportType == BT_TRANSPORT_LE) && (g_connectInfo[index].aclHandle == cid))) {
                 break;
             }
         }
-        if (g_connectInfo[index].transportType == BT_TRANSPORT_LE) {
-            if (g_connectInfo[index].aclHandle == cid) {
-                break;
-            }
+    } else {
+        // LE connections are addressed by aclHandle in place of the cid.
+        index = AttConnectIndexFind(&g_bredrCidIndex, cid);
+        leIndex = AttConnectIndexFind(&g_aclHandleIndex, cid);
+        if ((leIndex < index) && (g_connectInfo[leIndex].transportType == BT_TRANSPORT_LE)) {
+            index = leIndex;
+        }
+        if (index == ATT_CONNECT_INDEX_NONE) {
+            index = MAXCONNECT;
         }
     }
 
@@ -284,9 +342,16 @@ void AttGetConnectInfoIndexByCidOutIndex(uint16_t cid, uint16_t *index, AttConne
 
     uint16_t indexNumber = 0;
 
-    for (; indexNumber < MAXCONNECT; ++indexNumber) {
-        if (g_connectInfo[indexNumber].AttConnectID.bredrcid == cid) {
-            break;
+    if (cid == 0) {
+        for (; indexNumber < MAXCONNECT; ++indexNumber) {
+            if (g_connectInfo[indexNumber].AttConnectID.bredrcid == cid) {
+                break;
+            }
+        }
+    } else {
+        indexNumber = AttConnectIndexFind(&g_bredrCidIndex, cid);
+        if (indexNumber == ATT_CONNECT_INDEX_NONE) {
+            indexNumber = MAXCONNECT;
         }
     }
 
@@ -315,10 +380,18 @@ void AttGetConnectInfoIndexByConnectHandle(uint16_t connectHandle, uint16_t *ind
 
     uint16_t inindex = 0;
 
-    for (; inindex < MAXCONNECT; ++inindex) {
-        if (g_connectInfo[inindex].retGattConnectHandle == connectHandle) {
-            break;
+    if (connectHandle == 0) {
+        for (; inindex < MAXCONNECT; ++inindex) {
+            if (g_connectInfo[inindex].retGattConnectHandle == connectHandle) {
+                break;
+            }
         }
+    } else if ((connectHandle <= MAXCONNECT) &&
+               (g_connectInfo[connectHandle - 1].retGattConnectHandle == connectHandle)) {
+        // retGattConnectHandle is assigned as slot + 1.
+        inindex = connectHandle - 1;
+    } else {
+        inindex = MAXCONNECT;
     }
 
     *index = inindex;
@@ -338,6 +411,40 @@ ATTGETCONNECTINFOINDEXBYCONNECTHANDLE_END:
     return;
 }
 
+/**
+ * @brief index AttConnectInfo by its aclHandle and cid, after they are assigned.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+void AttConnectInfoIndexAdd(const AttConnectInfo *connect)
+{
+    uint16_t slot = (uint16_t)(connect - g_connectInfo);
+
+    AttConnectIndexInsert(&g_aclHandleIndex, connect->aclHandle, slot);
+    if (connect->transportType == BT_TRANSPORT_BR_EDR) {
+        AttConnectIndexInsert(&g_bredrCidIndex, connect->AttConnectID.bredrcid, slot);
+    } else {
+        AttConnectIndexRemove(&g_bredrCidIndex, slot);
+    }
+
+    return;
+}
+
+/**
+ * @brief remove AttConnectInfo from the aclHandle and cid index, before it is cleared.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+void AttConnectInfoIndexRemove(const AttConnectInfo *connect)
+{
+    uint16_t slot = (uint16_t)(connect - g_connectInfo);
+
+    AttConnectIndexRemove(&g_aclHandleIndex, slot);
+    AttConnectIndexRemove(&g_bredrCidIndex, slot);
+
+    return;
+}
+
 /**
  * @brief gatt register client data to att in self thread..
  *
@@ -564,9 +671,9 @@ AttServerDataCallback *AttGetATTServerCallback()
  * @param connect Indicates the pointer to AttConnectInfo.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-int AttSendSequenceScheduling(const AttConnectInfo *connect)
+int AttSendSequenceScheduling(AttConnectInfo *connect)
 {
-    LOG_INFO("%{public}s enter, listsize = %u", __FUNCTION__, ListGetSize(connect->instruct));
+    LOG_DEBUG("%{public}s enter, listsize = %u", __FUNCTION__, ListGetSize(connect->instruct));
 
     int ret = BT_SUCCESS;
 
@@ -587,6 +694,7 @@ int AttSendSequenceScheduling(const AttConnectInfo *connect)
         if (ret != BT_SUCCESS) {
             LOG_INFO("%{public}s call l2cap interface return not success", __FUNCTION__);
         } else {
+            connect->sequencedPduCount++;
             AlarmSet(
                 connect->alarm, (uint64_t)INSTRUCTIONTIMEOUT, (void (*)(void *))AttTransactionTimeOut, (void *)connect);
         }
@@ -601,9 +709,9 @@ ATTSENDSEQUENCESCHEDULING_END:
  *
  * @param connect Indicates the pointer to AttConnectInfo.
  */
-void AttReceiveSequenceScheduling(const AttConnectInfo *connect)
+void AttReceiveSequenceScheduling(AttConnectInfo *connect)
 {
-    LOG_INFO("%{public}s enter, listsize = %u, transportType = %hhu",
+    LOG_DEBUG("%{public}s enter, listsize = %u, transportType = %hhu",
         __FUNCTION__,
         ListGetSize(connect->instruct),
         connect->transportType);
@@ -627,6 +735,7 @@ void AttReceiveSequenceScheduling(const AttConnectInfo *connect)
         if (ret != BT_SUCCESS) {
             LOG_INFO("%{public}s call l2cap interface return not success", __FUNCTION__);
         } else {
+            connect->sequencedPduCount++;
             AlarmSet(connect->alarm,
                 (uint64_t)INSTRUCTIONTIMEOUT,
                 (void (*)(void *))AttTransactionTimeOut,
@@ -638,6 +747,43 @@ ATTRECEIVESEQUENCESCHEDULING_END:
     return;
 }
 
+/**
+ * @brief send the indication at the head of the indication queue, dropping it if l2cap refuses it.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
+ */
+int AttIndicationSequenceScheduling(AttConnectInfo *connect)
+{
+    LOG_DEBUG("%{public}s enter, listsize = %u", __FUNCTION__, ListGetSize(connect->indication));
+
+    int ret = BT_SUCCESS;
+
+    if (ListGetSize(connect->indication) > 0) {
+        ListNode *listNodePtr = ListGetFirstNode(connect->indication);
+        if (listNodePtr == NULL) {
+            LOG_INFO("%{public}s listNodePtr == NULL", __FUNCTION__);
+            ret = BT_OPERATION_FAILED;
+            goto ATTINDICATIONSEQUENCESCHEDULING_END;
+        }
+        Packet *packet = ListGetNodeData(listNodePtr);
+        ret = AttServerSendData(connect, packet);
+        if (ret != BT_SUCCESS) {
+            LOG_INFO("%{public}s call l2cap interface return not success", __FUNCTION__);
+            ListRemoveFirst(connect->indication);
+        } else {
+            connect->sequencedPduCount++;
+            AlarmSet(connect->indicationAlarm,
+                (uint64_t)INSTRUCTIONTIMEOUT,
+                (void (*)(void *))AttIndicationTimeOut,
+                (void *)connect);
+        }
+    }
+
+ATTINDICATIONSEQUENCESCHEDULING_END:
+    return ret;
+}
+
 /**
  * @brief get AttConnectingInfo information.
  *
@@ -919,7 +1065,7 @@ void AttServerCallBackCopyToCommon(attSendDataCallback attSendDataCB, const void
  */
 static void LeRecvSendDataCallbackAsync(const void *context)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
+    LOG_DEBUG("%{public}s enter", __FUNCTION__);
 
     LeRecvSendDataCallbackAsyncContext *leRecvSendDataCallPtr = (LeRecvSendDataCallbackAsyncContext *)context;
     AttConnectInfo *connect = NULL;
@@ -970,7 +1116,7 @@ static void LeRecvSendDataCallbackAsyncDestroy(const void *context)
  */
 void LeRecvSendDataCallback(uint16_t aclHandle, int result)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
+    LOG_DEBUG("%{public}s enter", __FUNCTION__);
 
     LeRecvSendDataCallbackAsyncContext *leRecvSendDataCallPtr =
         MEM_MALLOC.alloc(sizeof(LeRecvSendDataCallbackAsyncContext));
@@ -994,7 +1140,7 @@ void LeRecvSendDataCallback(uint16_t aclHandle, int result)
  */
 static void BREDRRecvSendDataCallbackAsync(const void *context)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
+    LOG_DEBUG("%{public}s enter", __FUNCTION__);
 
     BREDRRecvSendDataCallbackAsyncContext *bredrRecvSendDataCallPtr = (BREDRRecvSendDataCallbackAsyncContext *)context;
     AttConnectInfo *connect = NULL;
@@ -1046,7 +1192,7 @@ static void BREDRRecvSendDataCallbackAsyncDestroy(const void *context)
  */
 void BREDRRecvSendDataCallback(uint16_t lcid, int result)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
+    LOG_DEBUG("%{public}s enter", __FUNCTION__);
 
     BREDRRecvSendDataCallbackAsyncContext *bredrSendDataCallPtr =
         MEM_MALLOC.alloc(sizeof(BREDRRecvSendDataCallbackAsyncContext));
@@ -1087,7 +1233,7 @@ void AttCallBackDelectCopyToCommon()
 void AttAsyncProcess(
     void (*callback)(const void *context), void (*destroyCallback)(const void *context), const void *context)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
+    LOG_DEBUG("%{public}s enter", __FUNCTION__);
 
     int ret;
 
@@ -1110,6 +1256,7 @@ void AttShutDownClearConnectInfo(AttConnectInfo *connectInfo)
 {
     LOG_INFO("%{public}s enter", __FUNCTION__);
 
+    AttConnectInfoIndexRemove(connectInfo);
     connectInfo->aclHandle = 0;
     (void)memset_s(&connectInfo->AttConnectID, sizeof(connectInfo->AttConnectID), 0, sizeof(connectInfo->AttConnectID));
     connectInfo->retGattConnectHandle = 0;
@@ -1120,7 +1267,8 @@ void AttShutDownClearConnectInfo(AttConnectInfo *connectInfo)
     connectInfo->receiveMtu = 0;
     connectInfo->mtuFlag = false;
     connectInfo->initPassConnFlag = 0;
-    connectInfo->serverSendFlag = false;
+    connectInfo->sequencedPduCount = 0;
+    connectInfo->directPduCount = 0;
 
     g_attClientCallback.attClientCallback = NULL;
     g_attServerCallback.attServerCallback = NULL;
@@ -1479,7 +1627,7 @@ void ATT_ConnectDeregister()
 
 static void AttBREDRSendRespCallbackAsync(const void *context)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
+    LOG_DEBUG("%{public}s enter", __FUNCTION__);
 
     BREDRRecvSendDataCallbackAsyncContext *attBredrSendRspPtr = (BREDRRecvSendDataCallbackAsyncContext *)context;
     AttConnectInfo *connect = NULL;
@@ -1524,7 +1672,7 @@ static void AttBREDRSendRespCallbackAsyncDestroy(const void *context)
  */
 static void AttBREDRSendRespCallback(uint16_t lcid, int result)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
+    LOG_DEBUG("%{public}s enter", __FUNCTION__);
 
     BREDRRecvSendDataCallbackAsyncContext *attBredrSendRspPtr =
         MEM_MALLOC.alloc(sizeof(BREDRRecvSendDataCallbackAsyncContext));
@@ -1543,7 +1691,7 @@ static void AttBREDRSendRespCallback(uint16_t lcid, int result)
 
 static void AttLeSendRespCallbackAsync(const void *context)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
+    LOG_DEBUG("%{public}s enter", __FUNCTION__);
 
     LeRecvSendDataCallbackAsyncContext *attLeSendRspPtr = (LeRecvSendDataCallbackAsyncContext *)context;
     AttConnectInfo *connect = NULL;
@@ -1582,7 +1730,7 @@ static void AttLeSendRespCallbackAsyncDestroy(const void *context)
 
 static void AttLeSendRespCallback(uint16_t aclHandle, int result)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
+    LOG_DEBUG("%{public}s enter", __FUNCTION__);
 
     LeRecvSendDataCallbackAsyncContext *attLeSendRspPtr = MEM_MALLOC.alloc(sizeof(LeRecvSendDataCallbackAsyncContext));
     if (attLeSendRspPtr == NULL) {
@@ -1599,29 +1747,48 @@ static void AttLeSendRespCallback(uint16_t aclHandle, int result)
 }
 
 /**
- * @brief call l2cap interface to send data.
+ * @brief send server pdu to l2cap.
  *
  * @param1 connect Indicates the pointer to const AttConnectInfo.
  * @param2 packet Indicates the pointer to Packet.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-int AttResponseSendData(const AttConnectInfo *connect, const Packet *packet)
+static int AttServerSendData(const AttConnectInfo *connect, const Packet *packet)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
-
     int ret = BT_OPERATION_FAILED;
 
+    if (connect->transportType == BT_TRANSPORT_BR_EDR) {
+        ret = L2CIF_SendData(connect->AttConnectID.bredrcid, (Packet *)packet, AttBREDRSendRespCallback);
+    }
+    if (connect->transportType == BT_TRANSPORT_LE) {
+        ret = L2CIF_LeSendFixChannelData(connect->aclHandle, (uint16_t)LE_CID, (Packet *)packet, AttLeSendRespCallback);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief send pdu that needs no sequencing (response, command, notification, confirmation) to l2cap.
+ *
+ * @param1 connect Indicates the pointer to AttConnectInfo.
+ * @param2 packet Indicates the pointer to Packet.
+ * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
+ */
+int AttResponseSendData(AttConnectInfo *connect, const Packet *packet)
+{
+    LOG_DEBUG("%{public}s enter", __FUNCTION__);
+
+    int ret;
+
     if (connect == NULL) {
         LOG_INFO("%{public}s connect == NULL", __FUNCTION__);
         ret = BT_BAD_PARAM;
         return ret;
     }
 
-    if (connect->transportType == BT_TRANSPORT_BR_EDR) {
-        ret = L2CIF_SendData(connect->AttConnectID.bredrcid, (Packet *)packet, AttBREDRSendRespCallback);
-    }
-    if (connect->transportType == BT_TRANSPORT_LE) {
-        ret = L2CIF_LeSendFixChannelData(connect->aclHandle, (uint16_t)LE_CID, (Packet *)packet, AttLeSendRespCallback);
+    ret = AttServerSendData(connect, packet);
+    if (ret == BT_SUCCESS) {
+        connect->directPduCount++;
     }
 
     return ret;
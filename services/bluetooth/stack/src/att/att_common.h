@@ -110,7 +110,10 @@ typedef struct AttConnectInfo {
     uint8_t initPassConnFlag;
     List *instruct;
     Alarm *alarm;
-    bool serverSendFlag;
+    List *indication;
+    Alarm *indicationAlarm;
+    uint32_t sequencedPduCount;
+    uint32_t directPduCount;
 } AttConnectInfo;
 
 typedef struct AttConnectingInfo {
@@ -289,6 +292,20 @@ void AttGetConnectInfoIndexByCidOutIndex(uint16_t cid, uint16_t *index, AttConne
  */
 void AttGetConnectInfoIndexByConnectHandle(uint16_t connectHandle, uint16_t *index, AttConnectInfo **connect);
 
+/**
+ * @brief index AttConnectInfo by its aclHandle and cid, after they are assigned.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+void AttConnectInfoIndexAdd(const AttConnectInfo *connect);
+
+/**
+ * @brief remove AttConnectInfo from the aclHandle and cid index, before it is cleared.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+void AttConnectInfoIndexRemove(const AttConnectInfo *connect);
+
 /**
  * @brief get AttConnectingInfo information.
  *
@@ -379,14 +396,22 @@ AttServerDataCallback *AttGetATTServerCallback();
  * @param connect Indicates the pointer to AttConnectInfo.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-int AttSendSequenceScheduling(const AttConnectInfo *connect);
+int AttSendSequenceScheduling(AttConnectInfo *connect);
 
 /**
  * @brief execut instructions by Scheduling after receiving response.
  *
  * @param connect Indicates the pointer to AttConnectInfo.
  */
-void AttReceiveSequenceScheduling(const AttConnectInfo *connect);
+void AttReceiveSequenceScheduling(AttConnectInfo *connect);
+
+/**
+ * @brief send the indication at the head of the indication queue, dropping it if l2cap refuses it.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
+ */
+int AttIndicationSequenceScheduling(AttConnectInfo *connect);
 
 /**
  * @brief client call back copy.
@@ -492,7 +517,7 @@ void AttRecvLeData(uint16_t aclHandle, const Packet *packet);
 
 AttConnectedCallback *AttGetATTConnectCallback();
 
-int AttResponseSendData(const AttConnectInfo *connect, const Packet *packet);
+int AttResponseSendData(AttConnectInfo *connect, const Packet *packet);
 
 /**
  * @brief received error opcode.
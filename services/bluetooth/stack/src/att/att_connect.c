@@ -390,6 +390,7 @@ static void AttClearConnectInfo(AttConnectInfo *connect)
 {
     LOG_INFO("%{public}s enter", __FUNCTION__);
 
+    AttConnectInfoIndexRemove(connect);
     connect->aclHandle = 0;
     connect->AttConnectID.bredrcid = 0;
     connect->AttConnectID.lecid = 0;
@@ -400,12 +401,19 @@ static void AttClearConnectInfo(AttConnectInfo *connect)
     connect->initPassConnFlag = 0;
     connect->sendMtu = 0;
     connect->receiveMtu = 0;
-    connect->serverSendFlag = false;
+    connect->sequencedPduCount = 0;
+    connect->directPduCount = 0;
     (void)memset_s(&connect->addr, sizeof(connect->addr), 0, sizeof(BtAddr));
 
     if (connect->alarm != NULL) {
         AlarmCancel(connect->alarm);
     }
+    if (connect->indicationAlarm != NULL) {
+        AlarmCancel(connect->indicationAlarm);
+    }
+    if (connect->indication != NULL) {
+        ListClear(connect->indication);
+    }
 
     return;
 }
@@ -802,6 +810,7 @@ static void AttCopyToConnectInfo(const AttConnectingInfo *connecting, AttConnect
     (*connect)->addr.type = connecting->addr.type;
     (void)memcpy_s((*connect)->addr.addr, ADDRESSLEN, connecting->addr.addr, ADDRESSLEN);
     (*connect)->mtu = connecting->mtu;
+    AttConnectInfoIndexAdd(*connect);
 
 ATTCOPYTOCONNECTINFO_END:
     return;
@@ -835,6 +844,7 @@ static void AttConnectInfoAddLe(
     (*connect)->mtu = DEFAULTLEATTMTU;
     (*connect)->initPassConnFlag = initPassConnFlag;
     (void)memcpy_s((*connect)->addr.addr, ADDRESSLEN, addr->addr, ADDRESSLEN);
+    AttConnectInfoIndexAdd(*connect);
 
 ATTCONNECTINFOADDLE_END:
     return;
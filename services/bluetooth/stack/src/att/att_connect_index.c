@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file att_connect_index.c
+ *
+ * @brief implement key to connect info slot index.
+ *
+ */
+
+#include "att_connect_index.h"
+
+#include "securec.h"
+
+#define ATT_CONNECT_INDEX_HASH_MUL 0x9E37
+#define ATT_CONNECT_INDEX_HASH_SHIFT 10
+
+static uint16_t AttConnectIndexBucket(uint16_t key)
+{
+    // Handles and cids are allocated sequentially; multiplicative hashing spreads them over the buckets.
+    return (uint16_t)((uint16_t)(key * ATT_CONNECT_INDEX_HASH_MUL) >> ATT_CONNECT_INDEX_HASH_SHIFT) &
+           (ATT_CONNECT_INDEX_BUCKETS - 1);
+}
+
+void AttConnectIndexClear(AttConnectIndex *index)
+{
+    (void)memset_s(index, sizeof(AttConnectIndex), 0, sizeof(AttConnectIndex));
+}
+
+void AttConnectIndexRemove(AttConnectIndex *index, uint16_t slot)
+{
+    if ((slot >= ATT_CONNECT_INDEX_SLOTS) || !(index->used & (1u << slot))) {
+        return;
+    }
+
+    uint8_t *link = &index->bucket[AttConnectIndexBucket(index->key[slot])];
+    while (*link != 0) {
+        if (*link == slot + 1) {
+            *link = index->next[slot];
+            break;
+        }
+        link = &index->next[*link - 1];
+    }
+
+    index->next[slot] = 0;
+    index->used &= ~(1u << slot);
+}
+
+void AttConnectIndexInsert(AttConnectIndex *index, uint16_t key, uint16_t slot)
+{
+    if (slot >= ATT_CONNECT_INDEX_SLOTS) {
+        return;
+    }
+
+    AttConnectIndexRemove(index, slot);
+
+    uint16_t bucket = AttConnectIndexBucket(key);
+    index->key[slot] = key;
+    index->next[slot] = index->bucket[bucket];
+    index->bucket[bucket] = (uint8_t)(slot + 1);
+    index->used |= 1u << slot;
+}
+
+uint16_t AttConnectIndexFind(const AttConnectIndex *index, uint16_t key)
+{
+    uint16_t found = ATT_CONNECT_INDEX_NONE;
+    uint8_t entry = index->bucket[AttConnectIndexBucket(key)];
+
+    while (entry != 0) {
+        uint16_t slot = entry - 1;
+        if ((index->key[slot] == key) && (slot < found)) {
+            found = slot;
+        }
+        entry = index->next[slot];
+    }
+
+    return found;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file att_connect_index.h
+ *
+ * @brief declare key to connect info slot index.
+ *
+ */
+
+#ifndef ATT_CONNECT_INDEX_H
+#define ATT_CONNECT_INDEX_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ATT_CONNECT_INDEX_SLOTS 32
+#define ATT_CONNECT_INDEX_BUCKETS 64
+#define ATT_CONNECT_INDEX_NONE 0xFFFF
+
+/**
+ * @brief chained hash from a 16 bit key (acl handle or cid) to a connect info slot, one entry per slot.
+ */
+typedef struct {
+    uint8_t bucket[ATT_CONNECT_INDEX_BUCKETS];  // first slot + 1 of the chain, 0 when empty
+    uint8_t next[ATT_CONNECT_INDEX_SLOTS];      // next slot + 1 in the same chain
+    uint16_t key[ATT_CONNECT_INDEX_SLOTS];
+    uint32_t used;
+} AttConnectIndex;
+
+/**
+ * @brief remove all entries.
+ *
+ * @param index Indicates the pointer to AttConnectIndex.
+ */
+void AttConnectIndexClear(AttConnectIndex *index);
+
+/**
+ * @brief map key to slot, replacing the previous key of the slot.
+ *
+ * @param1 index Indicates the pointer to AttConnectIndex.
+ * @param2 key Indicates the key.
+ * @param3 slot Indicates the slot, less than ATT_CONNECT_INDEX_SLOTS.
+ */
+void AttConnectIndexInsert(AttConnectIndex *index, uint16_t key, uint16_t slot);
+
+/**
+ * @brief remove the entry of slot if any.
+ *
+ * @param1 index Indicates the pointer to AttConnectIndex.
+ * @param2 slot Indicates the slot.
+ */
+void AttConnectIndexRemove(AttConnectIndex *index, uint16_t slot);
+
+/**
+ * @brief lookup slot by key.
+ *
+ * @param1 index Indicates the pointer to AttConnectIndex.
+ * @param2 key Indicates the key.
+ * @return Returns the lowest slot mapped from key, ATT_CONNECT_INDEX_NONE if there is none.
+ */
+uint16_t AttConnectIndexFind(const AttConnectIndex *index, uint16_t key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // ATT_CONNECT_INDEX_H
@@ -70,6 +70,7 @@ static void AttInstructListInit()
 
     for (; index < MAXCONNECT; ++index) {
         connectInfoPtr[index].instruct = ListCreate((void *)AttListDataFree);
+        connectInfoPtr[index].indication = ListCreate((void *)AttListDataFree);
     }
 
     return;
@@ -121,6 +122,12 @@ static void AttAlarmListInit()
         connectingInfo[index].leAlarm = AlarmCreate((char *)&increaseIndex, 0);
     }
 
+    for (increaseIndex = STEP_THREE * MAXCONNECT, index = 0;
+         (increaseIndex < STEP_FOUR * MAXCONNECT) && (index < MAXCONNECT);
+         ++increaseIndex, ++index) {
+        connectInfo[index].indicationAlarm = AlarmCreate((char *)&increaseIndex, 0);
+    }
+
     return;
 }
 
@@ -206,9 +213,13 @@ static void ATT_ShutDownAsync(const void *context)
     for (; index < MAXCONNECT; ++index) {
         AttShutDownClearConnectInfo(&connectInfo[index]);
         ListClear(connectInfo[index].instruct);
+        ListClear(connectInfo[index].indication);
         if (connectInfo[index].alarm) {
             AlarmCancel(connectInfo[index].alarm);
         }
+        if (connectInfo[index].indicationAlarm) {
+            AlarmCancel(connectInfo[index].indicationAlarm);
+        }
         if (connectingInfo[index].bredrAlarm) {
             AlarmCancel(connectingInfo[index].bredrAlarm);
         }
@@ -305,10 +316,16 @@ static void AttDelete(AttConnectInfo *connectInfo, AttConnectingInfo *connecting
     for (; index < MAXCONNECT; ++index) {
         ListDelete(connectInfo[index].instruct);
         connectInfo[index].instruct = NULL;
+        ListDelete(connectInfo[index].indication);
+        connectInfo[index].indication = NULL;
         if (connectInfo[index].alarm) {
             AlarmDelete(connectInfo[index].alarm);
             connectInfo[index].alarm = NULL;
         }
+        if (connectInfo[index].indicationAlarm) {
+            AlarmDelete(connectInfo[index].indicationAlarm);
+            connectInfo[index].indicationAlarm = NULL;
+        }
         if (connectingInfo[index].bredrAlarm) {
             AlarmDelete(connectingInfo[index].bredrAlarm);
             connectingInfo[index].bredrAlarm = NULL;
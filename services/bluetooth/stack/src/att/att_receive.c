@@ -1843,9 +1843,12 @@ void AttHandleValueConfirmation(AttConnectInfo *connect, const Buffer *buffer)
 
     AttServerDataCallback *attServerDataCallback = NULL;
     AttWrite attWrite;
+    int ret;
     attWrite.confirmation.attHandle = 0x0000;
 
-    AlarmCancel(connect->alarm);
+    // A confirmation only completes the outstanding indication; the client request queue is left alone.
+    AlarmCancel(connect->indicationAlarm);
+    ListRemoveFirst(connect->indication);
 
     if (buffer == NULL) {
         LOG_WARN("%{public}s:buffer == NULL", __FUNCTION__);
@@ -1858,10 +1861,6 @@ void AttHandleValueConfirmation(AttConnectInfo *connect, const Buffer *buffer)
         goto ATTHANDLEVALUECONFIRMATION_END;
     }
 
-    if (connect->serverSendFlag) {
-        connect->serverSendFlag = false;
-    }
-
     attServerDataCallback->attServerCallback(connect->retGattConnectHandle,
         ATT_HANDLE_VALUE_CONFIRMATION_ID,
         &attWrite,
@@ -1870,8 +1869,13 @@ void AttHandleValueConfirmation(AttConnectInfo *connect, const Buffer *buffer)
 
 ATTHANDLEVALUECONFIRMATION_END:
     LOG_INFO("%{public}s return connect != NULL, connectHandle = %hu", __FUNCTION__, connect->retGattConnectHandle);
-    ListRemoveFirst(connect->instruct);
-    AttReceiveSequenceScheduling(connect);
+    while (ListGetSize(connect->indication) > 0) {
+        ret = AttIndicationSequenceScheduling(connect);
+        if (ret == BT_SUCCESS) {
+            break;
+        }
+        ServerCallbackReturnValue(ret, connect);
+    }
     return;
 }
 
@@ -22,6 +22,7 @@
 
 #include "att_common.h"
 #include "att_receive.h"
+#include "att_async_context.h"
 
 #include <memory.h>
 
@@ -221,7 +222,7 @@ static void AttExchangeMTURequestAsync(const void *context)
     ClientCallbackReturnValue(ret, connect);
 
 ATTEXCHANGEMTUREQUEST_END:
-    MEM_MALLOC.free(exchangeMtuReqPtr);
+    AttAsyncContextFree(exchangeMtuReqPtr);
     return;
 }
 
@@ -236,7 +237,7 @@ static void AttExchangeMTURequestAsyncDestroy(const void *context)
 
     ExchangeMTUAsync *exchangeMtuReqPtr = (ExchangeMTUAsync *)context;
 
-    MEM_MALLOC.free(exchangeMtuReqPtr);
+    AttAsyncContextFree(exchangeMtuReqPtr);
 
     return;
 }
@@ -252,7 +253,7 @@ void ATT_ExchangeMTURequest(uint16_t connectHandle, uint16_t clientRxMTU)
 {
     LOG_INFO("%{public}s enter, connectHandle = %hu, clientRxMTU = %hu", __FUNCTION__, connectHandle, clientRxMTU);
 
-    ExchangeMTUAsync *exchangeMtuReqPtr = MEM_MALLOC.alloc(sizeof(ExchangeMTUAsync));
+    ExchangeMTUAsync *exchangeMtuReqPtr = AttAsyncContextAlloc(connectHandle, sizeof(ExchangeMTUAsync));
     if (exchangeMtuReqPtr == NULL) {
         if (g_attClientSendDataCB.attSendDataCB != NULL) {
             g_attClientSendDataCB.attSendDataCB(connectHandle, BT_NO_MEMORY, g_attClientSendDataCB.context);
@@ -307,7 +308,7 @@ static void AttFindInformationRequestAsync(const void *context)
     ClientCallbackReturnValue(ret, connect);
 
 ATTFINDINFORMATIONREQUEST_END:
-    MEM_MALLOC.free(findInformReqPtr);
+    AttAsyncContextFree(findInformReqPtr);
     return;
 }
 
@@ -322,7 +323,7 @@ static void AttFindInformationRequestAsyncDestroy(const void *context)
 
     FindInformationRequestAsync *findInformReqPtr = (FindInformationRequestAsync *)context;
 
-    MEM_MALLOC.free(findInformReqPtr);
+    AttAsyncContextFree(findInformReqPtr);
 
     return;
 }
@@ -343,7 +344,7 @@ void ATT_FindInformationRequest(uint16_t connectHandle, uint16_t startHandle, ui
         startHandle,
         endHandle);
 
-    FindInformationRequestAsync *findInformReqPtr = MEM_MALLOC.alloc(sizeof(FindInformationRequestAsync));
+    FindInformationRequestAsync *findInformReqPtr = AttAsyncContextAlloc(connectHandle, sizeof(FindInformationRequestAsync));
     if (findInformReqPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -622,7 +623,7 @@ static void AttReadRequestAsync(const void *context)
     ClientCallbackReturnValue(ret, connect);
 
 ATT_READREQUEST_END:
-    MEM_MALLOC.free(readReqAsyncPtr);
+    AttAsyncContextFree(readReqAsyncPtr);
 
     return;
 }
@@ -638,7 +639,7 @@ static void AttReadRequestAsyncDestroy(const void *context)
 
     ReadRequestAsync *readReqAsyncPtr = (ReadRequestAsync *)context;
 
-    MEM_MALLOC.free(readReqAsyncPtr);
+    AttAsyncContextFree(readReqAsyncPtr);
 
     return;
 }
@@ -654,7 +655,7 @@ void ATT_ReadRequest(uint16_t connectHandle, uint16_t attHandle)
 {
     LOG_INFO("%{public}s enter,connectHandle = %hu,attHandle=%{public}d", __FUNCTION__, connectHandle, attHandle);
 
-    ReadRequestAsync *readReqAsyncPtr = MEM_MALLOC.alloc(sizeof(ReadRequestAsync));
+    ReadRequestAsync *readReqAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(ReadRequestAsync));
     if (readReqAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -708,7 +709,7 @@ static void AttReadBlobRequestAsync(const void *context)
     ClientCallbackReturnValue(ret, connect);
 
 ATT_READBLOBREQUEST_END:
-    MEM_MALLOC.free(readBlobReqAsyncPtr);
+    AttAsyncContextFree(readBlobReqAsyncPtr);
     return;
 }
 
@@ -723,7 +724,7 @@ static void AttReadBlobRequestAsyncDestroy(const void *context)
 
     ReadBlobRequestAsync *readBlobReqAsyncPtr = (ReadBlobRequestAsync *)context;
 
-    MEM_MALLOC.free(readBlobReqAsyncPtr);
+    AttAsyncContextFree(readBlobReqAsyncPtr);
 
     return;
 }
@@ -741,7 +742,7 @@ void ATT_ReadBlobRequest(uint16_t connectHandle, uint16_t attHandle, uint16_t of
     LOG_INFO("%{public}s enter,connectHandle = %hu,attHandle = %{public}d,offset=%{public}d",
         __FUNCTION__, connectHandle, attHandle, offset);
 
-    ReadBlobRequestAsync *readBlobReqAsyncPtr = MEM_MALLOC.alloc(sizeof(ReadBlobRequestAsync));
+    ReadBlobRequestAsync *readBlobReqAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(ReadBlobRequestAsync));
     if (readBlobReqAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -799,7 +800,7 @@ static void AttReadMultipleRequestAsync(const void *context)
 
 ATTREADMULTIPLEREQUEST_END:
     BufferFree(readMultipleReqAsyncPtr->attValue);
-    MEM_MALLOC.free(readMultipleReqAsyncPtr);
+    AttAsyncContextFree(readMultipleReqAsyncPtr);
     return;
 }
 
@@ -815,7 +816,7 @@ static void AttReadMultipleRequestAsyncDestroy(const void *context)
     ReadResponseAsync *readMultipleReqAsyncPtr = (ReadResponseAsync *)context;
 
     BufferFree(readMultipleReqAsyncPtr->attValue);
-    MEM_MALLOC.free(readMultipleReqAsyncPtr);
+    AttAsyncContextFree(readMultipleReqAsyncPtr);
 
     return;
 }
@@ -835,7 +836,7 @@ void ATT_ReadMultipleRequest(uint16_t connectHandle, const Buffer *handleList)
     ReadResponseAsync *readMultipleReqAsyncPtr = NULL;
 
     bufferPtr = BufferRefMalloc(handleList);
-    readMultipleReqAsyncPtr = MEM_MALLOC.alloc(sizeof(ReadResponseAsync));
+    readMultipleReqAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(ReadResponseAsync));
     if (readMultipleReqAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -1051,7 +1052,7 @@ static void AttWriteRequestAsync(const void *context)
 
 ATTWRITEREQUEST_END:
     BufferFree(writeReqAsyncPtr->attValue);
-    MEM_MALLOC.free(writeReqAsyncPtr);
+    AttAsyncContextFree(writeReqAsyncPtr);
     return;
 }
 
@@ -1067,7 +1068,7 @@ static void AttWriteRequestAsyncDestroy(const void *context)
     WriteAsync *writeReqAsyncPtr = (WriteAsync *)context;
 
     BufferFree(writeReqAsyncPtr->attValue);
-    MEM_MALLOC.free(writeReqAsyncPtr);
+    AttAsyncContextFree(writeReqAsyncPtr);
 
     return;
 }
@@ -1088,7 +1089,7 @@ void ATT_WriteRequest(uint16_t connectHandle, uint16_t attHandle, const Buffer *
     WriteAsync *writeRequestAsyncPtr = NULL;
 
     bufferPtr = BufferRefMalloc(attValue);
-    writeRequestAsyncPtr = MEM_MALLOC.alloc(sizeof(WriteAsync));
+    writeRequestAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(WriteAsync));
     if (writeRequestAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -1109,7 +1110,7 @@ void ATT_WriteRequest(uint16_t connectHandle, uint16_t attHandle, const Buffer *
  */
 static void AttWriteCommandAsync(const void *context)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
+    LOG_DEBUG("%{public}s enter", __FUNCTION__);
 
     uint16_t index = 0;
     int ret;
@@ -1151,7 +1152,7 @@ static void AttWriteCommandAsync(const void *context)
 
 ATTWRITECOMMAND_END:
     BufferFree(writeCommandAsyncPtr->attValue);
-    MEM_MALLOC.free(writeCommandAsyncPtr);
+    AttAsyncContextFree(writeCommandAsyncPtr);
     return;
 }
 
@@ -1167,7 +1168,7 @@ static void AttWriteCommandAsyncDestroy(const void *context)
     WriteAsync *writeCommandAsyncPtr = (WriteAsync *)context;
 
     BufferFree(writeCommandAsyncPtr->attValue);
-    MEM_MALLOC.free(writeCommandAsyncPtr);
+    AttAsyncContextFree(writeCommandAsyncPtr);
 
     return;
 }
@@ -1182,13 +1183,13 @@ static void AttWriteCommandAsyncDestroy(const void *context)
  */
 void ATT_WriteCommand(uint16_t connectHandle, uint16_t attHandle, const Buffer *attValue)
 {
-    LOG_INFO("%{public}s enter, connectHandle = %hu, attHandle=%{public}d", __FUNCTION__, connectHandle, attHandle);
+    LOG_DEBUG("%{public}s enter, connectHandle = %hu, attHandle=%{public}d", __FUNCTION__, connectHandle, attHandle);
 
     Buffer *bufferPtr = NULL;
     WriteAsync *writeCommandAsyncPtr = NULL;
 
     bufferPtr = BufferRefMalloc(attValue);
-    writeCommandAsyncPtr = MEM_MALLOC.alloc(sizeof(WriteAsync));
+    writeCommandAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(WriteAsync));
     if (writeCommandAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -1297,7 +1298,7 @@ static void AttSignedWriteCommandAsync(const void *context)
 
 ATTSIGNEDWRITECOMMAND_END:
     BufferFree(signedWriteCommandAsyncPtr->attValue);
-    MEM_MALLOC.free(signedWriteCommandAsyncPtr);
+    AttAsyncContextFree(signedWriteCommandAsyncPtr);
     return;
 }
 
@@ -1313,7 +1314,7 @@ static void AttSignedWriteCommandAsyncDestroy(const void *context)
     WriteAsync *signedWriteCommandAsyncPtr = (WriteAsync *)context;
 
     BufferFree(signedWriteCommandAsyncPtr->attValue);
-    MEM_MALLOC.free(signedWriteCommandAsyncPtr);
+    AttAsyncContextFree(signedWriteCommandAsyncPtr);
 
     return;
 }
@@ -1334,7 +1335,7 @@ void ATT_SignedWriteCommand(uint16_t connectHandle, uint16_t attHandle, const Bu
     WriteAsync *signedWriteCommandAsyncPtr = NULL;
 
     bufferPtr = BufferRefMalloc(attValue);
-    signedWriteCommandAsyncPtr = MEM_MALLOC.alloc(sizeof(WriteAsync));
+    signedWriteCommandAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(WriteAsync));
     if (signedWriteCommandAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -1398,7 +1399,7 @@ static void AttPrepareWriteRequestAsync(const void *context)
 
 ATTPREPAREWRITEREQUEST_END:
     BufferFree(prepareWriteReqAsyncPtr->attValue);
-    MEM_MALLOC.free(prepareWriteReqAsyncPtr);
+    AttAsyncContextFree(prepareWriteReqAsyncPtr);
     return;
 }
 
@@ -1414,7 +1415,7 @@ static void AttPrepareWriteRequestAsyncDestroy(const void *context)
     PrepareWriteAsync *prepareWriteReqAsyncPtr = (PrepareWriteAsync *)context;
 
     BufferFree(prepareWriteReqAsyncPtr->attValue);
-    MEM_MALLOC.free(prepareWriteReqAsyncPtr);
+    AttAsyncContextFree(prepareWriteReqAsyncPtr);
 
     return;
 }
@@ -1440,7 +1441,7 @@ void ATT_PrepareWriteRequest(
     PrepareWriteAsync *prepareWriteReqAsyncPtr = NULL;
 
     bufferPtr = BufferRefMalloc(attValue);
-    prepareWriteReqAsyncPtr = MEM_MALLOC.alloc(sizeof(PrepareWriteAsync));
+    prepareWriteReqAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(PrepareWriteAsync));
     if (prepareWriteReqAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -1499,7 +1500,7 @@ static void AttExecuteWriteRequestAsync(const void *context)
     ClientCallbackReturnValue(ret, connect);
 
 ATT_EXECUTEWRITEREQUEST_END:
-    MEM_MALLOC.free(executeWriteReqAsyncPtr);
+    AttAsyncContextFree(executeWriteReqAsyncPtr);
     return;
 }
 
@@ -1514,7 +1515,7 @@ static void AttExecuteWriteRequestAsyncDestroy(const void *context)
 
     ExecuteWriteRequestAsync *executeWriteReqAsyncPtr = (ExecuteWriteRequestAsync *)context;
 
-    MEM_MALLOC.free(executeWriteReqAsyncPtr);
+    AttAsyncContextFree(executeWriteReqAsyncPtr);
 
     return;
 }
@@ -1530,7 +1531,7 @@ void ATT_ExecuteWriteRequest(uint16_t connectHandle, uint8_t flag)
 {
     LOG_INFO("%{public}s enter, connectHandle = %hu, flag=%{public}d", __FUNCTION__, connectHandle, flag);
 
-    ExecuteWriteRequestAsync *executeWriteReqAsyncPtr = MEM_MALLOC.alloc(sizeof(ExecuteWriteRequestAsync));
+    ExecuteWriteRequestAsync *executeWriteReqAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(ExecuteWriteRequestAsync));
     if (executeWriteReqAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -1581,7 +1582,7 @@ static void AttHandleValueConfirmationAsync(const void *context)
     PacketFree(packet);
 
 ATT_HANDLEVALUECONFIRMATION_END:
-    MEM_MALLOC.free(handleConfirmationAsyncPtr);
+    AttAsyncContextFree(handleConfirmationAsyncPtr);
     return;
 }
 
@@ -1596,7 +1597,7 @@ static void AttHandleValueConfirmationAsyncDestroy(const void *context)
 
     WriteResponseAsync *handleConfirmationAsyncPtr = (WriteResponseAsync *)context;
 
-    MEM_MALLOC.free(handleConfirmationAsyncPtr);
+    AttAsyncContextFree(handleConfirmationAsyncPtr);
 
     return;
 }
@@ -1611,7 +1612,7 @@ void ATT_HandleValueConfirmation(uint16_t connectHandle)
 {
     LOG_INFO("%{public}s enter, connectHandle = %hu", __FUNCTION__, connectHandle);
 
-    WriteResponseAsync *handleConfirmationAsyncPtr = MEM_MALLOC.alloc(sizeof(WriteResponseAsync));
+    WriteResponseAsync *handleConfirmationAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(WriteResponseAsync));
     if (handleConfirmationAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -22,6 +22,7 @@
 
 #include "att_common.h"
 #include "att_receive.h"
+#include "att_async_context.h"
 
 #include <memory.h>
 
@@ -153,8 +154,8 @@ static void AttErrorResponseAsync(const void *context)
     PacketFree(packet);
 
 ATT_ERRORRESPONSE_END:
-    MEM_MALLOC.free(errorResAsyncPtr->ATTErrorPtr);
-    MEM_MALLOC.free(errorResAsyncPtr);
+    AttAsyncContextFree(errorResAsyncPtr->ATTErrorPtr);
+    AttAsyncContextFree(errorResAsyncPtr);
     return;
 }
 
@@ -169,8 +170,8 @@ static void AttErrorResponseAsyncDestroy(const void *context)
 
     ErrorResponseAsync *errorResAsyncPtr = (ErrorResponseAsync *)context;
 
-    MEM_MALLOC.free(errorResAsyncPtr->ATTErrorPtr);
-    MEM_MALLOC.free(errorResAsyncPtr);
+    AttAsyncContextFree(errorResAsyncPtr->ATTErrorPtr);
+    AttAsyncContextFree(errorResAsyncPtr);
 
     return;
 }
@@ -195,7 +196,7 @@ void ATT_ErrorResponse(uint16_t connectHandle, const AttError *attErrorPtr)
     AttError *attErrorAsyncPtr = NULL;
     ErrorResponseAsync *errorResAsyncPtr = NULL;
 
-    attErrorAsyncPtr = MEM_MALLOC.alloc(sizeof(AttError));
+    attErrorAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(AttError));
     if (attErrorAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -204,7 +205,7 @@ void ATT_ErrorResponse(uint16_t connectHandle, const AttError *attErrorPtr)
     attErrorAsyncPtr->attHandleInError = attErrorPtr->attHandleInError;
     attErrorAsyncPtr->errorCode = attErrorPtr->errorCode;
 
-    errorResAsyncPtr = MEM_MALLOC.alloc(sizeof(ErrorResponseAsync));
+    errorResAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(ErrorResponseAsync));
     if (errorResAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -256,7 +257,7 @@ static void AttExchangeMTUResponseAsync(const void *context)
     PacketFree(packet);
 
 ATTEXCHANGEMTURESPONSE_END:
-    MEM_MALLOC.free(exchangeMtuResPtr);
+    AttAsyncContextFree(exchangeMtuResPtr);
     return;
 }
 
@@ -271,7 +272,7 @@ static void AttExchangeMTUResponseAsyncDestroy(const void *context)
 
     ExchangeMTUAsync *exchangeMtuResPtr = (ExchangeMTUAsync *)context;
 
-    MEM_MALLOC.free(exchangeMtuResPtr);
+    AttAsyncContextFree(exchangeMtuResPtr);
 
     return;
 }
@@ -287,7 +288,7 @@ void ATT_ExchangeMTUResponse(uint16_t connectHandle, uint16_t serverRxMTU)
 {
     LOG_INFO("%{public}s enter, connectHandle = %hu, serverRxMTU = %hu", __FUNCTION__, connectHandle, serverRxMTU);
 
-    ExchangeMTUAsync *exchangeMtuResPtr = MEM_MALLOC.alloc(sizeof(ExchangeMTUAsync));
+    ExchangeMTUAsync *exchangeMtuResPtr = AttAsyncContextAlloc(connectHandle, sizeof(ExchangeMTUAsync));
     if (exchangeMtuResPtr == NULL) {
         if (g_attServerSendDataCB.attSendDataCB != NULL) {
             g_attServerSendDataCB.attSendDataCB(connectHandle, BT_NO_MEMORY, g_attServerSendDataCB.context);
@@ -771,7 +772,7 @@ static void AttReadResponseAsync(const void *context)
 
 ATT_READRESPONSE_END:
     BufferFree(readResAsyncPtr->attValue);
-    MEM_MALLOC.free(readResAsyncPtr);
+    AttAsyncContextFree(readResAsyncPtr);
     return;
 }
 
@@ -787,7 +788,7 @@ static void AttReadResponseAsyncDestroy(const void *context)
     ReadResponseAsync *readResAsyncPtr = (ReadResponseAsync *)context;
 
     BufferFree(readResAsyncPtr->attValue);
-    MEM_MALLOC.free(readResAsyncPtr);
+    AttAsyncContextFree(readResAsyncPtr);
 
     return;
 }
@@ -807,7 +808,7 @@ void ATT_ReadResponse(uint16_t connectHandle, const Buffer *attValue)
     ReadResponseAsync *readResAsyncPtr = NULL;
 
     bufferPtr = BufferRefMalloc(attValue);
-    readResAsyncPtr = MEM_MALLOC.alloc(sizeof(ReadResponseAsync));
+    readResAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(ReadResponseAsync));
     if (readResAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -872,7 +873,7 @@ static void AttReadBlobResponseAsync(const void *context)
 
 ATT_READBLOBRESPONSE_END:
     BufferFree(readBlobResAsyncPtr->attValue);
-    MEM_MALLOC.free(readBlobResAsyncPtr);
+    AttAsyncContextFree(readBlobResAsyncPtr);
     return;
 }
 
@@ -888,7 +889,7 @@ static void AttReadBlobResponseAsyncDestroy(const void *context)
     ReadResponseAsync *readBlobResAsyncPtr = (ReadResponseAsync *)context;
 
     BufferFree(readBlobResAsyncPtr->attValue);
-    MEM_MALLOC.free(readBlobResAsyncPtr);
+    AttAsyncContextFree(readBlobResAsyncPtr);
 
     return;
 }
@@ -908,7 +909,7 @@ void ATT_ReadBlobResponse(uint16_t connectHandle, const Buffer *attReadBlobResOb
     ReadResponseAsync *readBlobResAsyncPtr = NULL;
 
     bufferPtr = BufferRefMalloc(attReadBlobResObj);
-    readBlobResAsyncPtr = MEM_MALLOC.alloc(sizeof(ReadResponseAsync));
+    readBlobResAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(ReadResponseAsync));
     if (readBlobResAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -974,7 +975,7 @@ static void AttReadMultipleResponseAsync(const void *context)
 
 ATT_READMULTIPLERESPONSE_END:
     BufferFree(readMultipleResponseAsyncPtr->attValue);
-    MEM_MALLOC.free(readMultipleResponseAsyncPtr);
+    AttAsyncContextFree(readMultipleResponseAsyncPtr);
     return;
 }
 
@@ -990,7 +991,7 @@ static void AttReadMultipleResponseAsyncDestroy(const void *context)
     ReadResponseAsync *readMultipleResponseAsyncPtr = (ReadResponseAsync *)context;
 
     BufferFree(readMultipleResponseAsyncPtr->attValue);
-    MEM_MALLOC.free(readMultipleResponseAsyncPtr);
+    AttAsyncContextFree(readMultipleResponseAsyncPtr);
 
     return;
 }
@@ -1010,7 +1011,7 @@ void ATT_ReadMultipleResponse(uint16_t connectHandle, const Buffer *valueList)
     ReadResponseAsync *readMultipleResAsyncPtr = NULL;
 
     bufferPtr = BufferRefMalloc(valueList);
-    readMultipleResAsyncPtr = MEM_MALLOC.alloc(sizeof(ReadResponseAsync));
+    readMultipleResAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(ReadResponseAsync));
     if (readMultipleResAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -1210,7 +1211,7 @@ static void AttWriteResponseAsync(const void *context)
     PacketFree(packet);
 
 ATTWRITERESPONSE_END:
-    MEM_MALLOC.free(writeResponseAsyncPtr);
+    AttAsyncContextFree(writeResponseAsyncPtr);
     return;
 }
 
@@ -1225,7 +1226,7 @@ static void AttWriteResponseAsyncDestroy(const void *context)
 
     WriteResponseAsync *writeResponseAsyncPtr = (WriteResponseAsync *)context;
 
-    MEM_MALLOC.free(writeResponseAsyncPtr);
+    AttAsyncContextFree(writeResponseAsyncPtr);
 
     return;
 }
@@ -1240,7 +1241,7 @@ void ATT_WriteResponse(uint16_t connectHandle)
 {
     LOG_INFO("%{public}s enter, connectHandle = %hu", __FUNCTION__, connectHandle);
 
-    WriteResponseAsync *writeResAsyncPtr = MEM_MALLOC.alloc(sizeof(WriteResponseAsync));
+    WriteResponseAsync *writeResAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(WriteResponseAsync));
     if (writeResAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -1308,7 +1309,7 @@ static void AttPrepareWriteResponseAsync(const void *context)
 
 ATTPREPAREWRITERESPONSE_END:
     BufferFree(prepareWriteResAsyncPtr->attValue);
-    MEM_MALLOC.free(prepareWriteResAsyncPtr);
+    AttAsyncContextFree(prepareWriteResAsyncPtr);
     return;
 }
 
@@ -1324,7 +1325,7 @@ static void AttPrepareWriteResponseAsyncDestroy(const void *context)
     PrepareWriteAsync *prepareWriteResAsyncPtr = (PrepareWriteAsync *)context;
 
     BufferFree(prepareWriteResAsyncPtr->attValue);
-    MEM_MALLOC.free(prepareWriteResAsyncPtr);
+    AttAsyncContextFree(prepareWriteResAsyncPtr);
 
     return;
 }
@@ -1350,7 +1351,7 @@ void ATT_PrepareWriteResponse(
     PrepareWriteAsync *prepareWriteResAsyncPtr = NULL;
 
     bufferPtr = BufferRefMalloc(attValue);
-    prepareWriteResAsyncPtr = MEM_MALLOC.alloc(sizeof(PrepareWriteAsync));
+    prepareWriteResAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(PrepareWriteAsync));
     if (prepareWriteResAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -1404,7 +1405,7 @@ static void AttExecuteWriteResponseAsync(const void *context)
     PacketFree(packet);
 
 ATTEXECUTEWRITERESPONSE_END:
-    MEM_MALLOC.free(executeWriteResAsyncPtr);
+    AttAsyncContextFree(executeWriteResAsyncPtr);
     return;
 }
 
@@ -1419,7 +1420,7 @@ static void AttExecuteWriteResponseAsyncDestroy(const void *context)
 
     WriteResponseAsync *executeWriteResAsyncPtr = (WriteResponseAsync *)context;
 
-    MEM_MALLOC.free(executeWriteResAsyncPtr);
+    AttAsyncContextFree(executeWriteResAsyncPtr);
 
     return;
 }
@@ -1434,7 +1435,7 @@ void ATT_ExecuteWriteResponse(uint16_t connectHandle)
 {
     LOG_INFO("%{public}s enter,connectHandle = %hu", __FUNCTION__, connectHandle);
 
-    WriteResponseAsync *executeWriteResAsyncPtr = MEM_MALLOC.alloc(sizeof(WriteResponseAsync));
+    WriteResponseAsync *executeWriteResAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(WriteResponseAsync));
     if (executeWriteResAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -1453,7 +1454,7 @@ void ATT_ExecuteWriteResponse(uint16_t connectHandle)
  */
 static void AttHandleValueNotificationAsync(const void *context)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
+    LOG_DEBUG("%{public}s enter", __FUNCTION__);
 
     uint16_t index = 0;
     int ret;
@@ -1498,7 +1499,7 @@ static void AttHandleValueNotificationAsync(const void *context)
 
 ATT_HANDLEVALUENOTIFICATION_END:
     BufferFree(handleNotificationAsyncPtr->attValue);
-    MEM_MALLOC.free(handleNotificationAsyncPtr);
+    AttAsyncContextFree(handleNotificationAsyncPtr);
     return;
 }
 
@@ -1514,7 +1515,7 @@ static void AttHandleValueNotificationAsyncDestroy(const void *context)
     WriteAsync *handleNotificationAsyncPtr = (WriteAsync *)context;
 
     BufferFree(handleNotificationAsyncPtr->attValue);
-    MEM_MALLOC.free(handleNotificationAsyncPtr);
+    AttAsyncContextFree(handleNotificationAsyncPtr);
 
     return;
 }
@@ -1529,13 +1530,13 @@ static void AttHandleValueNotificationAsyncDestroy(const void *context)
  */
 void ATT_HandleValueNotification(uint16_t connectHandle, uint16_t attHandle, const Buffer *attValue)
 {
-    LOG_INFO("%{public}s enter, connectHandle = %hu, attHandle=%{public}d", __FUNCTION__, connectHandle, attHandle);
+    LOG_DEBUG("%{public}s enter, connectHandle = %hu, attHandle=%{public}d", __FUNCTION__, connectHandle, attHandle);
 
     Buffer *bufferPtr = NULL;
     WriteAsync *handleNotificationAsyncPtr = NULL;
 
     bufferPtr = BufferRefMalloc(attValue);
-    handleNotificationAsyncPtr = MEM_MALLOC.alloc(sizeof(WriteAsync));
+    handleNotificationAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(WriteAsync));
     if (handleNotificationAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -1578,7 +1579,6 @@ static void AttHandleValueIndicationAsync(const void *context)
         goto ATTHANDLEVALUEINDICATION_END;
     }
 
-    connect->serverSendFlag = true;
     bufferSize = BufferGetSize(handleIndicationAsyncPtr->attValue);
     packet = PacketMalloc(0, 0, sizeof(uint8_t) + sizeof(handleIndicationAsyncPtr->attHandle));
     if (packet == NULL) {
@@ -1597,13 +1597,17 @@ static void AttHandleValueIndicationAsync(const void *context)
         BufferFree(bufferNew);
     }
 
-    ret = AttResponseSendData(connect, packet);
+    // Only one indication may be outstanding; later ones wait for the confirmation in the indication queue.
+    ListAddLast(connect->indication, packet);
+    ret = BT_SUCCESS;
+    if (ListGetSize(connect->indication) == 1) {
+        ret = AttIndicationSequenceScheduling(connect);
+    }
     ServerCallbackReturnValue(ret, connect);
-    PacketFree(packet);
 
 ATTHANDLEVALUEINDICATION_END:
     BufferFree(handleIndicationAsyncPtr->attValue);
-    MEM_MALLOC.free(handleIndicationAsyncPtr);
+    AttAsyncContextFree(handleIndicationAsyncPtr);
     return;
 }
 
@@ -1619,7 +1623,7 @@ static void AttHandleValueIndicationAsyncDestroy(const void *context)
     WriteAsync *handleIndicationAsyncPtr = (WriteAsync *)context;
 
     BufferFree(handleIndicationAsyncPtr->attValue);
-    MEM_MALLOC.free(handleIndicationAsyncPtr);
+    AttAsyncContextFree(handleIndicationAsyncPtr);
 
     return;
 }
@@ -1640,7 +1644,7 @@ void ATT_HandleValueIndication(uint16_t connectHandle, uint16_t attHandle, const
     WriteAsync *handleIndicationAsyncPtr = NULL;
 
     bufferPtr = BufferRefMalloc(attValue);
-    handleIndicationAsyncPtr = MEM_MALLOC.alloc(sizeof(WriteAsync));
+    handleIndicationAsyncPtr = AttAsyncContextAlloc(connectHandle, sizeof(WriteAsync));
     if (handleIndicationAsyncPtr == NULL) {
         LOG_ERROR("point to NULL");
         return;
@@ -16,6 +16,7 @@
 #include "btm.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "btstack.h"
 #include "hci/hci.h"
@@ -100,6 +101,23 @@ static const char *g_leAndSharedModules[] = {
 static const int G_COUNT_OF_LE_MODULES = 0;
 static const char *g_leModules[] = {};
 
+typedef struct {
+    const char *name;
+    uint8_t queueId;
+} BtmModuleQueue;
+
+static const BtmModuleQueue g_moduleQueues[] = {
+    {MODULE_NAME_HCI, PROCESSING_QUEUE_ID_HCI},
+    {MODULE_NAME_L2CAP, PROCESSING_QUEUE_ID_LA2CAP},
+    {MODULE_NAME_GAP, PROCESSING_QUEUE_ID_GAP},
+    {MODULE_NAME_SMP, PROCESSING_QUEUE_ID_SMP},
+    {MODULE_NAME_SDP, PROCESSING_QUEUE_ID_SDP},
+    {MODULE_NAME_AVCTP, PROCESSING_QUEUE_ID_AVCTP},
+    {MODULE_NAME_AVDTP, PROCESSING_QUEUE_ID_AVDTP},
+    {MODULE_NAME_RFCOMM, PROCESSING_QUEUE_ID_RFCOMM},
+    {MODULE_NAME_ATT, PROCESSING_QUEUE_ID_ATT},
+};
+
 static List *g_btmCallbackList = NULL;
 static Mutex *g_btmCallbackListLock = NULL;
 static uint8_t g_status = STATUS_NONE;
@@ -199,6 +217,23 @@ int BTM_Initialize()
     return result;
 }
 
+int BTM_SetModuleThreadGroup(const char *moduleName, uint8_t group)
+{
+    if (moduleName == NULL) {
+        return BT_BAD_PARAM;
+    }
+    if (IS_INITIALIZED()) {
+        return BT_BAD_STATUS;
+    }
+
+    for (size_t i = 0; i < sizeof(g_moduleQueues) / sizeof(g_moduleQueues[0]); i++) {
+        if (strcmp(g_moduleQueues[i].name, moduleName) == 0) {
+            return BTM_SetProcessingQueueThreadGroup(g_moduleQueues[i].queueId, group);
+        }
+    }
+    return BT_BAD_PARAM;
+}
+
 NO_SANITIZE("cfi") int BTM_Close()
 {
     LOG_DEBUG("%{public}s start", __FUNCTION__);
@@ -2400,6 +2400,43 @@ int BTM_ChangeConnectionPacketType(const BtAddr *addr, uint16_t packetType)
     return HCI_ChangeConnectionPacketType(&param);
 }
 
+int BTM_GetAclFlowStatus(const BtAddr *addr, BtmAclFlowStatus *status)
+{
+    if (!IS_INITIALIZED()) {
+        return BT_BAD_STATUS;
+    }
+
+    if (addr == NULL || status == NULL) {
+        return BT_BAD_PARAM;
+    }
+
+    uint16_t connectionHandle = 0xffff;
+
+    MutexLock(g_aclListLock);
+    BtmAclConnection *connection = BtmAclFindConnectionByAddr(addr);
+    if (connection != NULL && connection->state == CONNECTED) {
+        connectionHandle = connection->connectionHandle;
+    }
+    MutexUnlock(g_aclListLock);
+
+    if (connectionHandle == 0xffff) {
+        return BT_BAD_STATUS;
+    }
+
+    HciAclFlowStatus hciStatus = {0};
+    int result = HCI_GetAclFlowStatus(connectionHandle, &hciStatus);
+    if (result != BT_SUCCESS) {
+        return result;
+    }
+
+    status->totalPackets = hciStatus.totalPackets;
+    status->freePackets = hciStatus.freePackets;
+    status->inFlightPackets = hciStatus.inFlightPackets;
+    status->waitingPackets = hciStatus.waitingPackets;
+    status->completedPackets = hciStatus.completedPackets;
+    return BT_SUCCESS;
+}
+
 static HciEventCallbacks g_hciEventCallbacks = {
     .connectionComplete = BtmOnConnectionComplete,
     .connectionRequest = BtmOnConnectionrequest,
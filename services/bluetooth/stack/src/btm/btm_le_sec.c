@@ -705,6 +705,43 @@ int BTM_ConvertToPairedAddress(const BtAddr *addr, BtAddr *pairedAddress)
     return result;
 }
 
+int BTM_GetLeIdentityAddress(const BtAddr *addr, BtAddr *identityAddress)
+{
+    if (addr == NULL || identityAddress == NULL) {
+        return BT_BAD_PARAM;
+    }
+
+    if (!IS_INITIALIZED()) {
+        return BT_BAD_STATUS;
+    }
+
+    int result = BT_BAD_STATUS;
+
+    MutexLock(g_lePairedDevicesLock);
+
+    BtmLePairedDeviceBlock *block = NULL;
+
+    ListNode *node = ListGetFirstNode(g_lePairedDevices);
+    while (node != NULL) {
+        block = ListGetNodeData(node);
+        if (IsSameBtAddr(&block->pairedInfo.addr, addr) || IsSameBtAddr(&block->currentAddr, addr) ||
+            IsSameBtAddr(&block->pairedInfo.remoteIdentityAddress, addr) ||
+            SMP_ResolveRPA(addr->addr, block->pairedInfo.remoteIdentityResolvingKey.key) ==
+                SMP_RESOLVE_RPA_RESULT_YES) {
+            *identityAddress = IsZeroAddress(block->pairedInfo.remoteIdentityAddress.addr) ?
+                block->pairedInfo.addr : block->pairedInfo.remoteIdentityAddress;
+            result = BT_SUCCESS;
+            break;
+        }
+
+        node = ListGetNextNode(node);
+    }
+
+    MutexUnlock(g_lePairedDevicesLock);
+
+    return result;
+}
+
 int BTM_SetLeRandomAddress(const BtAddr *addr)
 {
     if (addr == NULL) {
@@ -15,38 +15,91 @@
 
 #include "btm_thread.h"
 
+#include <poll.h>
+#include <stdatomic.h>
 #include <stddef.h>
+#include <time.h>
 
 #include "btstack.h"
 #include "platform/include/allocator.h"
-#include "platform/include/list.h"
 #include "platform/include/mutex.h"
 #include "platform/include/queue.h"
 #include "platform/include/semaphore.h"
 #include "platform/include/thread.h"
 #include "log.h"
+#include "securec.h"
+
+#define BTM_TASK_BUDGET_PER_WAKEUP 16
+#define US_PER_SECOND 1000000
+#define NS_PER_US 1000
 
 typedef struct {
     void (*task)(void *context);
     void *context;
+    uint64_t postTimeUs;
+    // Position among all tasks posted to the queues of the same thread group.
+    uint64_t sequence;
 } BtmTask;
 
 typedef struct {
     uint8_t id;
+    uint8_t group;
     Queue *queue;
+    Thread *thread;
     ReactorItem *reactorItem;
+    // Owner thread only: RunTask is on the stack, and a task of this queue deleted the queue.
+    bool running;
+    bool deleted;
+    // Guarded by g_processingQueueLock: posters waiting for space, the queue is not freed while there are any.
+    uint32_t posters;
+    Semaphore *postersDone;
+    atomic_uint_fast64_t enqueued;
+    atomic_uint_fast64_t executed;
+    atomic_uint_fast32_t depth;
+    atomic_uint_fast32_t maxDepth;
+    atomic_uint_fast64_t totalLatencyUs;
+    atomic_uint_fast64_t maxLatencyUs;
 } BtmProcessingQueue;
 
-static Thread *g_processingThread = NULL;
-static List *g_processingQueueList = NULL;
+static const char *const THREAD_GROUP_NAMES[BTM_THREAD_GROUP_MAX] = {"Stack", "Stack1", "Stack2", "Stack3"};
+
+static Thread *g_processingThreads[BTM_THREAD_GROUP_MAX] = {NULL};
+static BtmProcessingQueue *g_processingQueues[PROCESSING_QUEUE_ID_MAX] = {NULL};
+static uint8_t g_processingQueueGroups[PROCESSING_QUEUE_ID_MAX] = {BTM_THREAD_GROUP_STACK};
+// Guarded by g_processingQueueLock: sequence of the next task posted to a queue of the group.
+static uint64_t g_groupSequences[BTM_THREAD_GROUP_MAX] = {0};
 static Mutex *g_processingQueueLock = NULL;
 
+static uint64_t BtmGetTimeUs()
+{
+    struct timespec ts = {0};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * US_PER_SECOND + (uint64_t)ts.tv_nsec / NS_PER_US;
+}
+
+static void BtmAtomicMax32(atomic_uint_fast32_t *target, uint32_t value)
+{
+    uint_fast32_t current = atomic_load_explicit(target, memory_order_relaxed);
+    while (current < value &&
+           !atomic_compare_exchange_weak_explicit(target, &current, value, memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+static void BtmAtomicMax64(atomic_uint_fast64_t *target, uint64_t value)
+{
+    uint_fast64_t current = atomic_load_explicit(target, memory_order_relaxed);
+    while (current < value &&
+           !atomic_compare_exchange_weak_explicit(target, &current, value, memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
 static BtmTask *AllocTask(void (*task)(void *context), void *context)
 {
     BtmTask *block = MEM_MALLOC.alloc(sizeof(BtmTask));
     if (block != NULL) {
         block->task = task;
         block->context = context;
+        block->postTimeUs = BtmGetTimeUs();
     }
     return block;
 }
@@ -56,32 +109,103 @@ static void FreeTask(void *task)
     MEM_MALLOC.free(task);
 }
 
-NO_SANITIZE("cfi") static void RunTask(void *context)
+// The task may delete its own queue, so block is not touched once the task has started.
+NO_SANITIZE("cfi") static void ExecuteTask(BtmProcessingQueue *block, BtmTask *task)
 {
-    BtmTask *task = QueueTryDequeue((Queue *)context);
-    if (task != NULL) {
-        task->task(task->context);
+    atomic_fetch_sub_explicit(&block->depth, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&block->executed, 1, memory_order_relaxed);
+    uint64_t latencyUs = BtmGetTimeUs() - task->postTimeUs;
+    atomic_fetch_add_explicit(&block->totalLatencyUs, latencyUs, memory_order_relaxed);
+    BtmAtomicMax64(&block->maxLatencyUs, latencyUs);
+
+    task->task(task->context);
+    FreeTask(task);
+}
+
+static void FreeProcessingQueue(BtmProcessingQueue *block);
 
-        FreeTask(task);
+// Under g_processingQueueLock: take the oldest task of all queues in the group, by posting order.
+static BtmTask *DequeueGroupTask(uint8_t group, BtmProcessingQueue **owner)
+{
+    BtmProcessingQueue *oldest = NULL;
+    BtmTask *oldestTask = NULL;
+    for (uint8_t id = 0; id < PROCESSING_QUEUE_ID_MAX; id++) {
+        BtmProcessingQueue *block = g_processingQueues[id];
+        if (block == NULL || block->group != group) {
+            continue;
+        }
+        BtmTask *task = QueuePeek(block->queue);
+        if (task != NULL && (oldestTask == NULL || task->sequence < oldestTask->sequence)) {
+            oldest = block;
+            oldestTask = task;
+        }
+    }
+    if (oldest == NULL) {
+        return NULL;
+    }
+    *owner = oldest;
+    return QueueTryDequeue(oldest->queue);
+}
+
+static void RunTask(void *context)
+{
+    // Any task may delete any queue of the group, including the one that woke us, so only its group is kept.
+    uint8_t group = ((BtmProcessingQueue *)context)->group;
+
+    // Run a bounded batch per wakeup so that the queues cannot starve other fds of the same thread.
+    for (int i = 0; i < BTM_TASK_BUDGET_PER_WAKEUP; i++) {
+        BtmProcessingQueue *block = NULL;
+        MutexLock(g_processingQueueLock);
+        BtmTask *task = DequeueGroupTask(group, &block);
+        if (task != NULL) {
+            block->running = true;
+        }
+        MutexUnlock(g_processingQueueLock);
+        if (task == NULL) {
+            break;
+        }
+        ExecuteTask(block, task);
+        if (block->deleted) {
+            FreeProcessingQueue(block);
+        } else {
+            block->running = false;
+        }
     }
 }
 
+static Thread *GetGroupThread(uint8_t group)
+{
+    if (g_processingThreads[group] == NULL) {
+        g_processingThreads[group] = ThreadCreate(THREAD_GROUP_NAMES[group]);
+    }
+    return g_processingThreads[group];
+}
+
 static BtmProcessingQueue *AllocProcessingQueue(uint8_t id, uint32_t size)
 {
     BtmProcessingQueue *block = MEM_MALLOC.alloc(sizeof(BtmProcessingQueue));
-    if (block != NULL) {
-        block->id = id;
-        block->queue = QueueCreate(size);
-        if (block->queue != NULL) {
-            Reactor *reactor = ThreadGetReactor(g_processingThread);
-            block->reactorItem = ReactorRegister(reactor, QueueGetDequeueFd(block->queue), block->queue, RunTask, NULL);
-        }
+    if (block == NULL) {
+        return NULL;
+    }
+    (void)memset_s(block, sizeof(BtmProcessingQueue), 0, sizeof(BtmProcessingQueue));
+    block->id = id;
+    block->group = g_processingQueueGroups[id];
+    block->thread = GetGroupThread(block->group);
+    block->queue = QueueCreate(size);
+    block->postersDone = SemaphoreCreate(0);
+    if (block->thread == NULL || block->queue == NULL || block->postersDone == NULL) {
+        QueueDelete(block->queue, FreeTask);
+        SemaphoreDelete(block->postersDone);
+        MEM_MALLOC.free(block);
+        return NULL;
     }
+    Reactor *reactor = ThreadGetReactor(block->thread);
+    block->reactorItem = ReactorRegister(reactor, QueueGetDequeueFd(block->queue), block, RunTask, NULL);
     return block;
 }
 
 typedef struct {
-    Queue *queue;
+    BtmProcessingQueue *block;
     Semaphore *semaphore;
 } RunAllTaskContext;
 
@@ -89,13 +213,10 @@ static void RunAllTaskInQueueTask(void *param)
 {
     RunAllTaskContext *context = (RunAllTaskContext *)param;
 
-    BtmTask *task = QueueTryDequeue(context->queue);
+    BtmTask *task = QueueTryDequeue(context->block->queue);
     while (task != NULL) {
-        task->task(task->context);
-
-        FreeTask(task);
-
-        task = QueueTryDequeue(context->queue);
+        ExecuteTask(context->block, task);
+        task = QueueTryDequeue(context->block->queue);
     }
 
     if (context->semaphore != NULL) {
@@ -103,26 +224,25 @@ static void RunAllTaskInQueueTask(void *param)
     }
 }
 
-static void RunAllTaskInQueue(Queue *queue)
+static void RunAllTaskInQueue(BtmProcessingQueue *block)
 {
     RunAllTaskContext context = {
-        .queue = queue,
+        .block = block,
         .semaphore = NULL,
     };
 
-    if (ThreadIsSelf(g_processingThread) == 0) {
+    if (ThreadIsSelf(block->thread) == 0) {
         RunAllTaskInQueueTask(&context);
     } else {
         context.semaphore = SemaphoreCreate(0);
-        ThreadPostTask(g_processingThread, RunAllTaskInQueueTask, &context);
+        ThreadPostTask(block->thread, RunAllTaskInQueueTask, &context);
         SemaphoreWait(context.semaphore);
         SemaphoreDelete(context.semaphore);
     }
 }
 
-static void FreeProcessingQueue(void *queue)
+static void FreeProcessingQueue(BtmProcessingQueue *block)
 {
-    BtmProcessingQueue *block = (BtmProcessingQueue *)queue;
     if (block->reactorItem != NULL) {
         ReactorUnregister(block->reactorItem);
         block->reactorItem = NULL;
@@ -131,45 +251,45 @@ static void FreeProcessingQueue(void *queue)
         QueueDelete(block->queue, FreeTask);
         block->queue = NULL;
     }
-    MEM_MALLOC.free(queue);
+    if (block->postersDone != NULL) {
+        SemaphoreDelete(block->postersDone);
+        block->postersDone = NULL;
+    }
+    MEM_MALLOC.free(block);
 }
 
 static BtmProcessingQueue *FindProcessingQueueById(uint8_t queueId)
 {
-    BtmProcessingQueue *queue = NULL;
-
-    ListNode *node = NULL;
-    node = ListGetFirstNode(g_processingQueueList);
-    while (node != NULL) {
-        queue = ListGetNodeData(node);
-        if (queue->id == queueId) {
-            break;
-        } else {
-            queue = NULL;
-        }
-        node = ListGetNextNode(node);
+    if (queueId >= PROCESSING_QUEUE_ID_MAX) {
+        return NULL;
     }
-
-    return queue;
+    return g_processingQueues[queueId];
 }
 
 void BtmInitThread()
 {
-    g_processingThread = ThreadCreate("Stack");
-    g_processingQueueList = ListCreate(FreeProcessingQueue);
+    g_processingThreads[BTM_THREAD_GROUP_STACK] = ThreadCreate(THREAD_GROUP_NAMES[BTM_THREAD_GROUP_STACK]);
     g_processingQueueLock = MutexCreate();
 }
 
 void BtmCloseThread()
 {
-    if (g_processingQueueList != NULL) {
-        ListDelete(g_processingQueueList);
-        g_processingQueueList = NULL;
+    for (uint8_t id = 0; id < PROCESSING_QUEUE_ID_MAX; id++) {
+        if (g_processingQueues[id] != NULL) {
+            FreeProcessingQueue(g_processingQueues[id]);
+            g_processingQueues[id] = NULL;
+        }
+        g_processingQueueGroups[id] = BTM_THREAD_GROUP_STACK;
+    }
+    for (uint8_t group = 0; group < BTM_THREAD_GROUP_MAX; group++) {
+        g_groupSequences[group] = 0;
     }
 
-    if (g_processingThread != NULL) {
-        ThreadDelete(g_processingThread);
-        g_processingThread = NULL;
+    for (uint8_t group = 0; group < BTM_THREAD_GROUP_MAX; group++) {
+        if (g_processingThreads[group] != NULL) {
+            ThreadDelete(g_processingThreads[group]);
+            g_processingThreads[group] = NULL;
+        }
     }
 
     if (g_processingQueueLock != NULL) {
@@ -180,20 +300,86 @@ void BtmCloseThread()
 
 Thread *BTM_GetProcessingThread()
 {
-    return g_processingThread;
+    return g_processingThreads[BTM_THREAD_GROUP_STACK];
 }
 
-int BTM_CreateProcessingQueue(uint8_t queueId, uint16_t size)
+static bool IsPinnedToStackThread(uint8_t queueId)
 {
+    switch (queueId) {
+        case PROCESSING_QUEUE_ID_BTM:
+        case PROCESSING_QUEUE_ID_HCI:
+        case PROCESSING_QUEUE_ID_LA2CAP:
+        case PROCESSING_QUEUE_ID_GAP:
+        case PROCESSING_QUEUE_ID_SMP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+int BTM_SetProcessingQueueThreadGroup(uint8_t queueId, uint8_t group)
+{
+    if (queueId >= PROCESSING_QUEUE_ID_MAX || group >= BTM_THREAD_GROUP_MAX) {
+        return BT_BAD_PARAM;
+    }
+    if (group != BTM_THREAD_GROUP_STACK && IsPinnedToStackThread(queueId)) {
+        return BT_BAD_STATUS;
+    }
+
     int result = BT_SUCCESS;
-    MutexLock(g_processingQueueLock);
+    if (g_processingQueueLock != NULL) {
+        MutexLock(g_processingQueueLock);
+    }
+    if (g_processingQueues[queueId] != NULL) {
+        result = BT_BAD_STATUS;
+    } else {
+        g_processingQueueGroups[queueId] = group;
+    }
+    if (g_processingQueueLock != NULL) {
+        MutexUnlock(g_processingQueueLock);
+    }
+    return result;
+}
 
+int BTM_GetProcessingQueueStats(uint8_t queueId, BtmProcessingQueueStats *stats)
+{
+    if (stats == NULL) {
+        return BT_BAD_PARAM;
+    }
+
+    int result = BT_SUCCESS;
+    MutexLock(g_processingQueueLock);
     BtmProcessingQueue *queue = FindProcessingQueueById(queueId);
     if (queue != NULL) {
+        stats->enqueued = atomic_load_explicit(&queue->enqueued, memory_order_relaxed);
+        stats->executed = atomic_load_explicit(&queue->executed, memory_order_relaxed);
+        stats->depth = atomic_load_explicit(&queue->depth, memory_order_relaxed);
+        stats->maxDepth = atomic_load_explicit(&queue->maxDepth, memory_order_relaxed);
+        stats->totalLatencyUs = atomic_load_explicit(&queue->totalLatencyUs, memory_order_relaxed);
+        stats->maxLatencyUs = atomic_load_explicit(&queue->maxLatencyUs, memory_order_relaxed);
+    } else {
+        result = BT_BAD_STATUS;
+    }
+    MutexUnlock(g_processingQueueLock);
+    return result;
+}
+
+int BTM_CreateProcessingQueue(uint8_t queueId, uint16_t size)
+{
+    if (queueId >= PROCESSING_QUEUE_ID_MAX) {
+        return BT_BAD_PARAM;
+    }
+
+    int result = BT_SUCCESS;
+    MutexLock(g_processingQueueLock);
+
+    if (g_processingQueues[queueId] != NULL) {
         result = BT_BAD_STATUS;
     } else {
-        queue = AllocProcessingQueue(queueId, size);
-        ListAddLast(g_processingQueueList, queue);
+        g_processingQueues[queueId] = AllocProcessingQueue(queueId, size);
+        if (g_processingQueues[queueId] == NULL) {
+            result = BT_NO_MEMORY;
+        }
     }
 
     MutexUnlock(g_processingQueueLock);
@@ -204,45 +390,102 @@ int BTM_DeleteProcessingQueue(uint8_t queueId)
 {
     int result = BT_SUCCESS;
 
-    Queue *taskQueue = NULL;
-
     MutexLock(g_processingQueueLock);
     BtmProcessingQueue *queue = FindProcessingQueueById(queueId);
     if (queue != NULL) {
-        taskQueue = queue->queue;
-        queue->queue = NULL;
-        ListRemoveNode(g_processingQueueList, queue);
+        g_processingQueues[queueId] = NULL;
     } else {
         result = BT_BAD_STATUS;
     }
     MutexUnlock(g_processingQueueLock);
 
-    if (taskQueue != NULL) {
-        RunAllTaskInQueue(taskQueue);
-        QueueDelete(taskQueue, FreeTask);
-        taskQueue = NULL;
+    if (queue != NULL) {
+        if (queue->reactorItem != NULL) {
+            ReactorUnregister(queue->reactorItem);
+            queue->reactorItem = NULL;
+        }
+        // Posters blocked on a full queue still hold it, their tasks run here once they got in. A poster counted
+        // before draining has not enqueued yet and posts postersDone once it has.
+        for (;;) {
+            MutexLock(g_processingQueueLock);
+            uint32_t posters = queue->posters;
+            MutexUnlock(g_processingQueueLock);
+            RunAllTaskInQueue(queue);
+            if (posters == 0) {
+                break;
+            }
+            SemaphoreWait(queue->postersDone);
+        }
+        if (queue->running && ThreadIsSelf(queue->thread) == 0) {
+            // Deleted by one of its own tasks, RunTask frees it once that task returns.
+            queue->deleted = true;
+        } else {
+            FreeProcessingQueue(queue);
+        }
     }
 
     return result;
 }
 
+// Under g_processingQueueLock, so the sequence of the group follows the order in which posts got in.
+static bool EnqueueTask(BtmProcessingQueue *queue, BtmTask *task)
+{
+    task->sequence = g_groupSequences[queue->group];
+    if (!QueueTryEnqueue(queue->queue, task)) {
+        return false;
+    }
+    g_groupSequences[queue->group]++;
+    return true;
+}
+
+static void WaitForRoom(BtmProcessingQueue *queue)
+{
+    struct pollfd pfd = {.fd = QueueGetEnqueueFd(queue->queue), .events = POLLIN, .revents = 0};
+    (void)poll(&pfd, 1, -1);
+}
+
 int BTM_RunTaskInProcessingQueue(uint8_t queueId, void (*task)(void *context), void *context)
 {
     HILOGD("%{public}d ,start process queueId is ", queueId);
-    int result = BT_SUCCESS;
+    BtmTask *block = AllocTask(task, context);
+    if (block == NULL) {
+        return BT_NO_MEMORY;
+    }
+
     MutexLock(g_processingQueueLock);
     BtmProcessingQueue *queue = FindProcessingQueueById(queueId);
-    if (queue != NULL) {
-        BtmTask *block = AllocTask(task, context);
-        if (task != NULL) {
-            QueueEnqueue(queue->queue, block);
-        } else {
-            result = BT_NO_MEMORY;
+    if (queue == NULL) {
+        MutexUnlock(g_processingQueueLock);
+        FreeTask(block);
+        return BT_BAD_STATUS;
+    }
+    uint32_t depth = atomic_fetch_add_explicit(&queue->depth, 1, memory_order_relaxed) + 1;
+    if (!EnqueueTask(queue, block)) {
+        if (ThreadIsSelf(queue->thread) == 0) {
+            // Only this thread can make room, waiting here would never return.
+            atomic_fetch_sub_explicit(&queue->depth, 1, memory_order_relaxed);
+            MutexUnlock(g_processingQueueLock);
+            FreeTask(block);
+            LOG_ERROR("%{public}s: queue %{public}d is full", __FUNCTION__, queueId);
+            return BT_NO_MEMORY;
+        }
+        // Never wait for space while holding the lock: the consumer may live on another thread that is
+        // itself posting a task right now. The task still gets in under the lock to keep the group order.
+        queue->posters++;
+        do {
+            MutexUnlock(g_processingQueueLock);
+            WaitForRoom(queue);
+            MutexLock(g_processingQueueLock);
+        } while (!EnqueueTask(queue, block));
+        queue->posters--;
+        if (g_processingQueues[queueId] != queue) {
+            // Deleted meanwhile, BTM_DeleteProcessingQueue waits for the last poster.
+            SemaphorePost(queue->postersDone);
         }
-    } else {
-        result = BT_BAD_STATUS;
     }
+    atomic_fetch_add_explicit(&queue->enqueued, 1, memory_order_relaxed);
+    BtmAtomicMax32(&queue->maxDepth, depth);
     MutexUnlock(g_processingQueueLock);
     HILOGD("%{public}d ,end process queueId is ", queueId);
-    return result;
+    return BT_SUCCESS;
 }
@@ -39,11 +39,66 @@ Thread *BTM_GetProcessingThread();
 #define PROCESSING_QUEUE_ID_AVDTP 7
 #define PROCESSING_QUEUE_ID_SDP 8
 #define PROCESSING_QUEUE_ID_SMP 9
+#define PROCESSING_QUEUE_ID_MAX 10
+
+/*
+ * Thread groups. Every processing queue runs on the thread of its group; by default all queues are in
+ * BTM_THREAD_GROUP_STACK, the "Stack" thread that also receives HCI events.
+ *
+ * Ordering: the tasks posted to the queues of one group run in the order their posts got in, across queues and
+ * whichever thread posted them. So AVDTP on its own group posting to L2CAP and then to HCI, or an L2CAP task
+ * posting to HCI, sees that work run in posting order. Tasks of different groups run concurrently: a module
+ * that needs its work to follow work running on another group has to wait for that module's callback. One
+ * wakeup of a thread runs up to 16 tasks before it serves its other fds. Tasks still queued when their queue is
+ * deleted run at once, out of group order.
+ * BTM, HCI, L2CAP, GAP and SMP are entered directly from HCI event handling and cannot leave
+ * BTM_THREAD_GROUP_STACK.
+ */
+#define BTM_THREAD_GROUP_STACK 0
+#define BTM_THREAD_GROUP_MAX 4
+
+/**
+ * @brief Move a processing queue to a thread group. Must be called before the queue is created.
+ *
+ * @param queueId Processing queue ID.
+ * @param group Thread group, less than BTM_THREAD_GROUP_MAX.
+ * @return Success return BT_SUCCESS, queue pinned to the stack thread or already created return BT_BAD_STATUS.
+ */
+int BTM_SetProcessingQueueThreadGroup(uint8_t queueId, uint8_t group);
+
+typedef struct {
+    uint64_t enqueued;
+    uint64_t executed;
+    uint32_t depth;
+    uint32_t maxDepth;
+    // Time from posting a task to its start, in microseconds.
+    uint64_t totalLatencyUs;
+    uint64_t maxLatencyUs;
+} BtmProcessingQueueStats;
+
+/**
+ * @brief Get depth and latency statistics of a processing queue since it was created.
+ *
+ * @param queueId Processing queue ID.
+ * @param stats Statistics result.
+ * @return Success return BT_SUCCESS, queue not created return BT_BAD_STATUS.
+ */
+int BTM_GetProcessingQueueStats(uint8_t queueId, BtmProcessingQueueStats *stats);
 
 int BTM_CreateProcessingQueue(uint8_t queueId, uint16_t size);
 
 int BTM_DeleteProcessingQueue(uint8_t queueId);
 
+/**
+ * @brief Post a task to a processing queue. Blocks while the queue is full, unless called on the thread of the
+ *        queue, which is the only one able to make room.
+ *
+ * @param queueId Processing queue ID.
+ * @param task Task to run on the thread of the queue.
+ * @param context Task context.
+ * @return Success return BT_SUCCESS, queue not created return BT_BAD_STATUS, queue full while called on its own
+ *         thread or out of memory return BT_NO_MEMORY.
+ */
 int BTM_RunTaskInProcessingQueue(uint8_t queueId, void (*task)(void *context), void *context);
 
 #ifdef __cplusplus
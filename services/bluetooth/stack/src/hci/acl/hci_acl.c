@@ -52,6 +52,7 @@ typedef struct {
 typedef struct {
     uint16_t connectionHandle;
     uint16_t count;
+    uint32_t completed;
 } HciTxPackets;
 
 static uint16_t g_aclDataPacketLength = 0;
@@ -282,6 +283,7 @@ static void HciOnAclPacketComplete(uint16_t connectionHandle, uint16_t count)
     HciTxPackets *entity = FindTxPacketsEntityByConnectionHandle(connectionHandle);
     if (entity != NULL) {
         entity->count -= count;
+        entity->completed += count;
     }
 }
 
@@ -587,6 +589,49 @@ int HCI_SendAclData(uint16_t handle, uint8_t flushable, Packet *packet)
     return result;
 }
 
+static uint16_t HciCountCachedAclPackets(uint16_t connectionHandle)
+{
+    uint16_t count = 0;
+
+    MutexLock(g_aclDataCacheLock);
+
+    ListNode *node = ListGetFirstNode(g_aclDataCache);
+    while (node != NULL) {
+        if (HciGetAclHandleFromPacket(ListGetNodeData(node)) == connectionHandle) {
+            count++;
+        }
+        node = ListGetNextNode(node);
+    }
+
+    MutexUnlock(g_aclDataCacheLock);
+
+    return count;
+}
+
+int HCI_GetAclFlowStatus(uint16_t handle, HciAclFlowStatus *status)
+{
+    if (status == NULL) {
+        return BT_BAD_PARAM;
+    }
+
+    if (HciAclGetTransport(handle) != TRANSPORT_BREDR) {
+        return BT_BAD_STATUS;
+    }
+
+    MutexLock(g_numOfAclDataPacketsLock);
+
+    status->totalPackets = g_totalNumAclDataPackets;
+    status->freePackets = g_numOfAclDataPackets;
+    HciTxPackets *entity = FindTxPacketsEntityByConnectionHandle(handle);
+    status->inFlightPackets = (entity != NULL) ? entity->count : 0;
+    status->completedPackets = (entity != NULL) ? entity->completed : 0;
+    status->waitingPackets = HciCountCachedAclPackets(handle);
+
+    MutexUnlock(g_numOfAclDataPacketsLock);
+
+    return BT_SUCCESS;
+}
+
 void HciOnAclData(Packet *packet)
 {
     HciAclDataHeader header;
@@ -15,6 +15,8 @@
 
 #include "hci_cmd.h"
 
+#include <time.h>
+
 #include <securec.h>
 
 #include "btm/btm_thread.h"
@@ -24,7 +26,6 @@
 #include "platform/include/bt_endian.h"
 #include "platform/include/list.h"
 #include "platform/include/mutex.h"
-#include "platform/include/queue.h"
 
 #include "hci/acl/hci_acl.h"
 #include "hci/hci.h"
@@ -35,10 +36,16 @@
 
 #include "hci_cmd_failure.h"
 
-#define MAX_QUEUE_SIZE 32
-
 #define CMD_TIMEOUT (10 * 1000)
 
+// Connection handles are 12 bits; commands without parameters carry none.
+#define CMD_CONNECTION_HANDLE_MASK 0x0FFF
+#define CMD_NO_CONNECTION_HANDLE 0xFFFF
+
+#define CMD_BUCKET_COUNT 32
+// Folds the OGF into the OCF bits so commands of different groups spread over the buckets.
+#define CMD_BUCKET(opCode) (((opCode) ^ ((opCode) >> 10)) & (CMD_BUCKET_COUNT - 1))
+
 #pragma pack(1)
 typedef struct {
     uint16_t opCode;
@@ -49,26 +56,43 @@ typedef struct {
 static uint8_t g_numberOfHciCmd = 1;
 static Mutex *g_lockNumberOfHciCmd = NULL;
 
-static Queue *g_cmdCache = NULL;
+// Commands waiting for a credit, one FIFO per priority class. Guarded by g_lockNumberOfHciCmd.
+static List *g_cmdCache[HCI_CMD_PRIORITY_COUNT] = {NULL};
 
-static List *g_processingCmds = NULL;
+// Commands sent to the controller: chained per opcode bucket in send order for Command Complete/Status
+// matching, and linked in deadline order for the single timeout alarm. Guarded by g_lockProcessingCmds.
+static HciCmd *g_processingCmds[CMD_BUCKET_COUNT] = {NULL};
+static HciCmd *g_timeoutHead = NULL;
+static HciCmd *g_timeoutTail = NULL;
+static Alarm *g_timeoutAlarm = NULL;
+static uint64_t g_timeoutArmedDeadline = 0;
 static Mutex *g_lockProcessingCmds = NULL;
 
 // Function declare
 static void HciFreeCmd(void *cmd);
+static void HciCmdOnCmdTimeout(void *parameter);
 
 void HciInitCmd()
 {
-    g_cmdCache = QueueCreate(MAX_QUEUE_SIZE);
-    g_processingCmds = ListCreate(HciFreeCmd);
+    for (int i = 0; i < HCI_CMD_PRIORITY_COUNT; i++) {
+        g_cmdCache[i] = ListCreate(NULL);
+    }
 
     g_numberOfHciCmd = 1;
     g_lockNumberOfHciCmd = MutexCreate();
     g_lockProcessingCmds = MutexCreate();
+    g_timeoutAlarm = AlarmCreate("HciCmdTimeout", false);
+    g_timeoutArmedDeadline = 0;
 }
 
 void HciCloseCmd()
 {
+    if (g_timeoutAlarm != NULL) {
+        AlarmCancel(g_timeoutAlarm);
+        AlarmDelete(g_timeoutAlarm);
+        g_timeoutAlarm = NULL;
+    }
+
     if (g_lockProcessingCmds != NULL) {
         MutexDelete(g_lockProcessingCmds);
         g_lockProcessingCmds = NULL;
@@ -79,15 +103,105 @@ void HciCloseCmd()
         g_lockNumberOfHciCmd = NULL;
     }
 
-    if (g_cmdCache != NULL) {
-        QueueDelete(g_cmdCache, HciFreeCmd);
-        g_cmdCache = NULL;
+    for (int i = 0; i < HCI_CMD_PRIORITY_COUNT; i++) {
+        if (g_cmdCache[i] != NULL) {
+            ListNode *node = ListGetFirstNode(g_cmdCache[i]);
+            while (node != NULL) {
+                HciFreeCmd(ListGetNodeData(node));
+                node = ListGetNextNode(node);
+            }
+            ListDelete(g_cmdCache[i]);
+            g_cmdCache[i] = NULL;
+        }
+    }
+
+    HciCmd *cmd = g_timeoutHead;
+    while (cmd != NULL) {
+        HciCmd *next = cmd->timeoutNext;
+        HciFreeCmd(cmd);
+        cmd = next;
+    }
+    g_timeoutHead = NULL;
+    g_timeoutTail = NULL;
+    (void)memset_s(g_processingCmds, sizeof(g_processingCmds), 0, sizeof(g_processingCmds));
+}
+
+static uint64_t HciCmdGetTime()
+{
+    struct timespec ts = {0};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * MS_PER_SECOND + (uint64_t)ts.tv_nsec / NS_PER_MS;
+}
+
+// Link-critical commands overtake queued commands of the normal class. Most are replies to a controller request,
+// which the controller is waiting on and which no earlier host command can be a prerequisite of. The others
+// (disconnect, encryption start) address a connection handle, see HciCmdIsHandleAddressed.
+static uint8_t HciCmdGetPriority(uint16_t opCode)
+{
+    switch (opCode) {
+        case HCI_DISCONNECT:
+        case HCI_ACCEPT_CONNECTION_REQUEST:
+        case HCI_REJECT_CONNECTION_REQUEST:
+        case HCI_LINK_KEY_REQUEST_REPLY:
+        case HCI_LINK_KEY_REQUEST_NEGATIVE_REPLY:
+        case HCI_PIN_CODE_REQUEST_REPLY:
+        case HCI_PIN_CODE_REQUEST_NEGATIVE_REPLY:
+        case HCI_SET_CONNECTION_ENCRYPTION:
+        case HCI_ACCEPT_SYNCHRONOUS_CONNECTION_REQUEST:
+        case HCI_REJECT_SYNCHRONOUS_CONNECTION_REQUEST:
+        case HCI_ENHANCED_ACCEPT_SYNCHRONOUS_CONNECTION_REQUEST:
+        case HCI_IO_CAPABILITY_REQUEST_REPLY:
+        case HCI_IO_CAPABILITY_REQUEST_NEGATIVE_REPLY:
+        case HCI_USER_CONFIRMATION_REQUEST_REPLY:
+        case HCI_USER_CONFIRMATION_REQUEST_NEGATIVE_REPLY:
+        case HCI_USER_PASSKEY_REQUEST_REPLY:
+        case HCI_USER_PASSKEY_REQUEST_NEGATIVE_REPLY:
+        case HCI_LE_START_ENCRYPTION:
+        case HCI_LE_LONG_TERM_KEY_REQUEST_REPLY:
+        case HCI_LE_LONG_TERM_KEY_REQUEST_NEGATIVE_REPLY:
+        case HCI_LE_REMOTE_CONNECTION_PARAMETER_REQUEST_REPLY:
+        case HCI_LE_REMOTE_CONNECTION_PARAMETER_REQUEST_NEGATIVE_REPLY:
+            return HCI_CMD_PRIORITY_LINK;
+        default:
+            return HCI_CMD_PRIORITY_NORMAL;
+    }
+}
+
+// Link-critical commands whose first parameter is a connection handle. They never overtake a queued command for
+// the same handle, so e.g. Set Connection Encryption still follows an Authentication Requested for that link.
+static bool HciCmdIsHandleAddressed(uint16_t opCode)
+{
+    switch (opCode) {
+        case HCI_DISCONNECT:
+        case HCI_SET_CONNECTION_ENCRYPTION:
+        case HCI_LE_START_ENCRYPTION:
+        case HCI_LE_LONG_TERM_KEY_REQUEST_REPLY:
+        case HCI_LE_LONG_TERM_KEY_REQUEST_NEGATIVE_REPLY:
+        case HCI_LE_REMOTE_CONNECTION_PARAMETER_REQUEST_REPLY:
+        case HCI_LE_REMOTE_CONNECTION_PARAMETER_REQUEST_NEGATIVE_REPLY:
+            return true;
+        default:
+            return false;
     }
+}
 
-    if (g_processingCmds != NULL) {
-        ListDelete(g_processingCmds);
-        g_processingCmds = NULL;
+// Queue class of a command waiting for a credit. Called with g_lockNumberOfHciCmd held.
+static uint8_t HciCmdGetQueue(const HciCmd *cmd)
+{
+    if ((cmd->priority != HCI_CMD_PRIORITY_LINK) || !HciCmdIsHandleAddressed(cmd->opCode) ||
+        (cmd->connectionHandle == CMD_NO_CONNECTION_HANDLE)) {
+        return cmd->priority;
+    }
+    // Most connection commands lead with the handle; a queued command that only looks alike merely stays in order.
+    ListNode *node = ListGetFirstNode(g_cmdCache[HCI_CMD_PRIORITY_NORMAL]);
+    while (node != NULL) {
+        const HciCmd *queued = ListGetNodeData(node);
+        if (queued->connectionHandle == cmd->connectionHandle) {
+            return HCI_CMD_PRIORITY_NORMAL;
+        }
+        node = ListGetNextNode(node);
     }
+    return HCI_CMD_PRIORITY_LINK;
 }
 
 static int HciCmdPushToTxQueue(HciCmd *cmd)
@@ -107,38 +221,136 @@ static int HciCmdPushToTxQueue(HciCmd *cmd)
 
 static void HciCmdTimeoutTask(void *context)
 {
-    HciCmd *pCmd = NULL;
-    uint16_t opCode = 0;
-
-    MutexLock(g_lockProcessingCmds);
-    ListNode *node = ListGetFirstNode(g_processingCmds);
-    while (node != NULL) {
-        pCmd = ListGetNodeData(node);
-        if (pCmd == context) {
-            opCode = pCmd->opCode;
-            break;
-        } else {
-            pCmd = NULL;
+    (void)context;
+    for (;;) {
+        uint16_t opCode = 0;
+
+        MutexLock(g_lockProcessingCmds);
+        g_timeoutArmedDeadline = 0;
+        uint64_t now = HciCmdGetTime();
+        if (g_timeoutHead != NULL) {
+            if (g_timeoutHead->deadline <= now) {
+                opCode = g_timeoutHead->opCode;
+            } else {
+                g_timeoutArmedDeadline = g_timeoutHead->deadline;
+                AlarmSet(g_timeoutAlarm, g_timeoutArmedDeadline - now, HciCmdOnCmdTimeout, NULL);
+            }
         }
-        node = ListGetNextNode(node);
-    }
-    MutexUnlock(g_lockProcessingCmds);
+        MutexUnlock(g_lockProcessingCmds);
 
-    if (opCode == 0) {
-        return;
-    }
+        if (opCode == 0) {
+            return;
+        }
 
-    HciCmdOnCommandStatus(opCode, HCI_TIMEOUT);
+        // The oldest command of an opcode is also its first to expire, so this retires g_timeoutHead.
+        HciCmdOnCommandStatus(opCode, HCI_TIMEOUT);
 
-    HciOnCmdTimeout();
+        HciOnCmdTimeout();
+    }
 }
 
 static void HciCmdOnCmdTimeout(void *parameter)
 {
+    (void)parameter;
     Thread *thread = BTM_GetProcessingThread();
     if (thread != NULL) {
-        ThreadPostTask(thread, HciCmdTimeoutTask, parameter);
+        ThreadPostTask(thread, HciCmdTimeoutTask, NULL);
+    }
+}
+
+// Called with g_lockProcessingCmds held.
+static void HciCmdAddProcessing(HciCmd *cmd)
+{
+    uint64_t now = HciCmdGetTime();
+    cmd->deadline = now + CMD_TIMEOUT;
+
+    cmd->bucketNext = NULL;
+    HciCmd **link = &g_processingCmds[CMD_BUCKET(cmd->opCode)];
+    while (*link != NULL) {
+        link = &(*link)->bucketNext;
+    }
+    *link = cmd;
+
+    HciCmd *prev = g_timeoutTail;
+    while (prev != NULL && prev->deadline > cmd->deadline) {
+        prev = prev->timeoutPrev;
+    }
+    cmd->timeoutPrev = prev;
+    cmd->timeoutNext = (prev != NULL) ? prev->timeoutNext : g_timeoutHead;
+    if (cmd->timeoutNext != NULL) {
+        cmd->timeoutNext->timeoutPrev = cmd;
+    } else {
+        g_timeoutTail = cmd;
+    }
+    if (prev != NULL) {
+        prev->timeoutNext = cmd;
+    } else {
+        g_timeoutHead = cmd;
+    }
+
+    // Removal never re-arms: an alarm that fires early for a retired command just re-arms for the new head.
+    if (g_timeoutArmedDeadline == 0 || cmd->deadline < g_timeoutArmedDeadline) {
+        g_timeoutArmedDeadline = cmd->deadline;
+        AlarmSet(g_timeoutAlarm, CMD_TIMEOUT, HciCmdOnCmdTimeout, NULL);
+    }
+}
+
+// Unlinks the oldest in-flight command with opCode. Called with g_lockProcessingCmds held.
+static HciCmd *HciCmdRemoveProcessing(uint16_t opCode)
+{
+    HciCmd **link = &g_processingCmds[CMD_BUCKET(opCode)];
+    while (*link != NULL && (*link)->opCode != opCode) {
+        link = &(*link)->bucketNext;
+    }
+
+    HciCmd *cmd = *link;
+    if (cmd == NULL) {
+        return NULL;
+    }
+    *link = cmd->bucketNext;
+
+    if (cmd->timeoutPrev != NULL) {
+        cmd->timeoutPrev->timeoutNext = cmd->timeoutNext;
+    } else {
+        g_timeoutHead = cmd->timeoutNext;
+    }
+    if (cmd->timeoutNext != NULL) {
+        cmd->timeoutNext->timeoutPrev = cmd->timeoutPrev;
+    } else {
+        g_timeoutTail = cmd->timeoutPrev;
+    }
+    cmd->bucketNext = NULL;
+    cmd->timeoutPrev = NULL;
+    cmd->timeoutNext = NULL;
+    return cmd;
+}
+
+// Called with g_lockNumberOfHciCmd held.
+static HciCmd *HciCmdTakeCached()
+{
+    for (int i = 0; i < HCI_CMD_PRIORITY_COUNT; i++) {
+        ListNode *node = ListGetFirstNode(g_cmdCache[i]);
+        if (node != NULL) {
+            HciCmd *cmd = ListGetNodeData(node);
+            ListRemoveFirst(g_cmdCache[i]);
+            return cmd;
+        }
+    }
+    return NULL;
+}
+
+// Sends cmd and starts tracking it. Called with g_lockNumberOfHciCmd held and a credit available.
+static int HciCmdSend(HciCmd *cmd)
+{
+    int result = HciCmdPushToTxQueue(cmd);
+    if (result == BT_SUCCESS) {
+        g_numberOfHciCmd--;
+
+        MutexLock(g_lockProcessingCmds);
+        HciCmdAddProcessing(cmd);
+        MutexUnlock(g_lockProcessingCmds);
     }
+    return result;
 }
 
 void HciSetNumberOfHciCmd(uint8_t numberOfHciCmd)
@@ -147,26 +359,15 @@ void HciSetNumberOfHciCmd(uint8_t numberOfHciCmd)
 
     g_numberOfHciCmd = numberOfHciCmd;
 
-    HciCmd *cmd = NULL;
-
     while (g_numberOfHciCmd > 0) {
-        cmd = QueueTryDequeue(g_cmdCache);
-        if (cmd != NULL) {
-            int result = HciCmdPushToTxQueue(cmd);
-            if (result == BT_SUCCESS) {
-                g_numberOfHciCmd--;
-
-                MutexLock(g_lockProcessingCmds);
-                AlarmSet(cmd->alarm, CMD_TIMEOUT, HciCmdOnCmdTimeout, cmd);
-                ListAddLast(g_processingCmds, cmd);
-                MutexUnlock(g_lockProcessingCmds);
-            } else {
-                HciFreeCmd(cmd);
-            }
-        } else {
+        HciCmd *cmd = HciCmdTakeCached();
+        if (cmd == NULL) {
             // No more cmd
             break;
         }
+        if (HciCmdSend(cmd) != BT_SUCCESS) {
+            HciFreeCmd(cmd);
+        }
     }
 
     MutexUnlock(g_lockNumberOfHciCmd);
@@ -202,18 +403,25 @@ HciCmd *HciAllocCmd(uint16_t opCode, const void *param, size_t paramLength)
 {
     HciCmd *cmd = MEM_MALLOC.alloc(sizeof(HciCmd));
     if (cmd != NULL) {
+        (void)memset_s(cmd, sizeof(HciCmd), 0, sizeof(HciCmd));
         cmd->opCode = opCode;
+        cmd->priority = HciCmdGetPriority(opCode);
+        cmd->connectionHandle = CMD_NO_CONNECTION_HANDLE;
         if (param != NULL && paramLength > 0) {
             cmd->param = MEM_MALLOC.alloc(paramLength);
             if (cmd->param != NULL) {
                 (void)memcpy_s(cmd->param, paramLength, param, paramLength);
             }
+            if (paramLength >= sizeof(uint16_t)) {
+                uint16_t handle = 0;
+                (void)memcpy_s(&handle, sizeof(handle), param, sizeof(handle));
+                cmd->connectionHandle = handle & CMD_CONNECTION_HANDLE_MASK;
+            }
             cmd->packet = HciCreateCmdPacketWithParam(opCode, param, paramLength);
         } else {
             cmd->packet = HciCreateCmdPacket(opCode);
             cmd->param = NULL;
         }
-        cmd->alarm = AlarmCreate(NULL, false);
     }
     return cmd;
 }
@@ -222,10 +430,6 @@ static void HciFreeCmd(void *cmd)
 {
     HciCmd *hciCmd = (HciCmd *)cmd;
     if (hciCmd != NULL) {
-        if (hciCmd->alarm != NULL) {
-            AlarmCancel(hciCmd->alarm);
-            AlarmDelete(hciCmd->alarm);
-        }
         if (hciCmd->param != NULL) {
             MEM_MALLOC.free(hciCmd->param);
             hciCmd->param = NULL;
@@ -244,17 +448,9 @@ int HciSendCmd(HciCmd *cmd)
     MutexLock(g_lockNumberOfHciCmd);
 
     if (g_numberOfHciCmd > 0) {
-        result = HciCmdPushToTxQueue(cmd);
-        if (result == BT_SUCCESS) {
-            g_numberOfHciCmd--;
-
-            MutexLock(g_lockProcessingCmds);
-            AlarmSet(cmd->alarm, CMD_TIMEOUT, HciCmdOnCmdTimeout, cmd);
-            ListAddLast(g_processingCmds, cmd);
-            MutexUnlock(g_lockProcessingCmds);
-        }
+        result = HciCmdSend(cmd);
     } else {
-        QueueEnqueue(g_cmdCache, cmd);
+        ListAddLast(g_cmdCache[HciCmdGetQueue(cmd)], cmd);
     }
 
     MutexUnlock(g_lockNumberOfHciCmd);
@@ -264,42 +460,24 @@ int HciSendCmd(HciCmd *cmd)
 
 void HciCmdOnCommandStatus(uint16_t opCode, uint8_t status)
 {
-    HciCmd *cmd = NULL;
-
     MutexLock(g_lockProcessingCmds);
+    HciCmd *cmd = HciCmdRemoveProcessing(opCode);
+    MutexUnlock(g_lockProcessingCmds);
 
-    ListNode *node = ListGetFirstNode(g_processingCmds);
-    while (node != NULL) {
-        cmd = ListGetNodeData(node);
-        if (cmd != NULL) {
-            if (opCode == cmd->opCode) {
-                break;
-            }
-            cmd = NULL;
-        }
-
-        node = ListGetNextNode(node);
-    }
-
-    void *param = NULL;
-
-    if (cmd != NULL) {
-        AlarmCancel(cmd->alarm);
-
-        param = cmd->param;
-        cmd->param = NULL;
-
-        ListRemoveNode(g_processingCmds, cmd);
+    if (cmd == NULL) {
+        return;
     }
 
-    MutexUnlock(g_lockProcessingCmds);
+    void *param = cmd->param;
+    cmd->param = NULL;
+    HciFreeCmd(cmd);
 
-    if (cmd != NULL && opCode == HCI_DISCONNECT && status == HCI_SUCCESS) {
+    if (opCode == HCI_DISCONNECT && status == HCI_SUCCESS) {
         HciDisconnectParam *discParam = (HciDisconnectParam *)param;
         HciAclOnDisconnectStatus(discParam->connectionHandle);
     }
 
-    if (cmd != NULL && status != HCI_SUCCESS) {
+    if (status != HCI_SUCCESS) {
         HciOnCmdFailed(opCode, status, param);
     }
 
@@ -311,27 +489,11 @@ void HciCmdOnCommandStatus(uint16_t opCode, uint8_t status)
 
 void HciCmdOnCommandComplete(uint16_t opCode)
 {
-    HciCmd *cmd = NULL;
-
     MutexLock(g_lockProcessingCmds);
-
-    ListNode *node = ListGetFirstNode(g_processingCmds);
-    while (node != NULL) {
-        cmd = ListGetNodeData(node);
-        if (cmd != NULL) {
-            if (opCode == cmd->opCode) {
-                break;
-            }
-            cmd = NULL;
-        }
-
-        node = ListGetNextNode(node);
-    }
+    HciCmd *cmd = HciCmdRemoveProcessing(opCode);
+    MutexUnlock(g_lockProcessingCmds);
 
     if (cmd != NULL) {
-        AlarmCancel(cmd->alarm);
-        ListRemoveNode(g_processingCmds, cmd);
+        HciFreeCmd(cmd);
     }
-
-    MutexUnlock(g_lockProcessingCmds);
 }
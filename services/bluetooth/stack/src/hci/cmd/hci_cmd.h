@@ -19,17 +19,29 @@
 #include <stdint.h>
 
 #include "packet.h"
-#include "platform/include/alarm.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-typedef struct {
+// Link-critical commands leave the pending queue ahead of bulk configuration traffic, but never ahead of a queued
+// command for the same connection handle.
+#define HCI_CMD_PRIORITY_LINK 0
+#define HCI_CMD_PRIORITY_NORMAL 1
+#define HCI_CMD_PRIORITY_COUNT 2
+
+typedef struct HciCmd {
     uint16_t opCode;
+    uint8_t priority;
+    // First parameter read as a connection handle, to keep commands for one link in order.
+    uint16_t connectionHandle;
     void *param;
     Packet *packet;
-    Alarm *alarm;
+    // In-flight bookkeeping: monotonic deadline in ms, the opcode bucket chain and the deadline ordered list.
+    uint64_t deadline;
+    struct HciCmd *bucketNext;
+    struct HciCmd *timeoutPrev;
+    struct HciCmd *timeoutNext;
 } HciCmd;
 
 void HciInitCmd();
@@ -30,12 +30,7 @@ static void HciCmdOnSetEventMaskFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setEventMaskComplete != NULL) {
-        callbacks->setEventMaskComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setEventMaskComplete, &returnParam);
 }
 
 static void HciCmdOnResetFailed(uint8_t status, const void *param)
@@ -44,12 +39,7 @@ static void HciCmdOnResetFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->resetComplete != NULL) {
-        callbacks->resetComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(resetComplete, &returnParam);
 }
 
 static void HciCmdOnSetEventFilterFailed(uint8_t status, const void *param)
@@ -58,12 +48,7 @@ static void HciCmdOnSetEventFilterFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setEventFilterComplete != NULL) {
-        callbacks->setEventFilterComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setEventFilterComplete, &returnParam);
 }
 
 static void HciCmdOnFlushFailed(uint8_t status, const void *param)
@@ -72,12 +57,7 @@ static void HciCmdOnFlushFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->flushComplete != NULL) {
-        callbacks->flushComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(flushComplete, &returnParam);
 }
 
 static void HciCmdOnReadPinTypeFailed(uint8_t status, const void *param)
@@ -86,12 +66,7 @@ static void HciCmdOnReadPinTypeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readPinTypeComplete != NULL) {
-        callbacks->readPinTypeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readPinTypeComplete, &returnParam);
 }
 
 static void HciCmdOnWritePinTypeFailed(uint8_t status, const void *param)
@@ -100,12 +75,7 @@ static void HciCmdOnWritePinTypeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writePinTypeComplete != NULL) {
-        callbacks->writePinTypeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writePinTypeComplete, &returnParam);
 }
 
 static void HciCmdOnCreateNewUnitKeyFailed(uint8_t status, const void *param)
@@ -114,12 +84,7 @@ static void HciCmdOnCreateNewUnitKeyFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->createNewUnitKeyComplete != NULL) {
-        callbacks->createNewUnitKeyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(createNewUnitKeyComplete, &returnParam);
 }
 
 static void HciCmdOnReadStoredLinkKeyFailed(uint8_t status, const void *param)
@@ -128,12 +93,7 @@ static void HciCmdOnReadStoredLinkKeyFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readStoredLinkKeyComplete != NULL) {
-        callbacks->readStoredLinkKeyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readStoredLinkKeyComplete, &returnParam);
 }
 
 static void HciCmdOnDeleteStoredLinkKeyFailed(uint8_t status, const void *param)
@@ -142,12 +102,7 @@ static void HciCmdOnDeleteStoredLinkKeyFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->deleteStoredLinkKeyComplete != NULL) {
-        callbacks->deleteStoredLinkKeyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(deleteStoredLinkKeyComplete, &returnParam);
 }
 
 static void HciCmdOnWriteLocalNameFailed(uint8_t status, const void *param)
@@ -156,12 +111,7 @@ static void HciCmdOnWriteLocalNameFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeLocalNameComplete != NULL) {
-        callbacks->writeLocalNameComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeLocalNameComplete, &returnParam);
 }
 
 static void HciCmdOnReadLocalNameFailed(uint8_t status, const void *param)
@@ -170,12 +120,7 @@ static void HciCmdOnReadLocalNameFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalNameComplete != NULL) {
-        callbacks->readLocalNameComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalNameComplete, &returnParam);
 }
 
 static void HciCmdOnReadConnectionAcceptTimeoutFailed(uint8_t status, const void *param)
@@ -184,12 +129,7 @@ static void HciCmdOnReadConnectionAcceptTimeoutFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readConnectionAcceptTimeoutComplete != NULL) {
-        callbacks->readConnectionAcceptTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readConnectionAcceptTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnWriteConnectionAcceptTimeoutFailed(uint8_t status, const void *param)
@@ -198,12 +138,7 @@ static void HciCmdOnWriteConnectionAcceptTimeoutFailed(uint8_t status, const voi
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeConnectionAcceptTimeoutComplete != NULL) {
-        callbacks->writeConnectionAcceptTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeConnectionAcceptTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnReadPageTimeoutFailed(uint8_t status, const void *param)
@@ -212,12 +147,7 @@ static void HciCmdOnReadPageTimeoutFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readPageTimeoutComplete != NULL) {
-        callbacks->readPageTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readPageTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnWritePageTimeoutFailed(uint8_t status, const void *param)
@@ -226,12 +156,7 @@ static void HciCmdOnWritePageTimeoutFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writePageTimeoutComplete != NULL) {
-        callbacks->writePageTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writePageTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnReadScanEnableFailed(uint8_t status, const void *param)
@@ -240,12 +165,7 @@ static void HciCmdOnReadScanEnableFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readScanEnableComplete != NULL) {
-        callbacks->readScanEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readScanEnableComplete, &returnParam);
 }
 
 static void HciCmdOnWriteScanEnableFailed(uint8_t status, const void *param)
@@ -254,12 +174,7 @@ static void HciCmdOnWriteScanEnableFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeScanEnableComplete != NULL) {
-        callbacks->writeScanEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeScanEnableComplete, &returnParam);
 }
 
 static void HciCmdOnReadPageScanActivityFailed(uint8_t status, const void *param)
@@ -268,12 +183,7 @@ static void HciCmdOnReadPageScanActivityFailed(uint8_t status, const void *param
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readPageScanActivityComplete != NULL) {
-        callbacks->readPageScanActivityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readPageScanActivityComplete, &returnParam);
 }
 
 static void HciCmdOnWritePageScanActivityFailed(uint8_t status, const void *param)
@@ -282,12 +192,7 @@ static void HciCmdOnWritePageScanActivityFailed(uint8_t status, const void *para
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writePageScanActivityComplete != NULL) {
-        callbacks->writePageScanActivityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writePageScanActivityComplete, &returnParam);
 }
 
 static void HciCmdOnReadInquiryScanActivityFailed(uint8_t status, const void *param)
@@ -296,12 +201,7 @@ static void HciCmdOnReadInquiryScanActivityFailed(uint8_t status, const void *pa
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readInquiryScanActivityComplete != NULL) {
-        callbacks->readInquiryScanActivityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readInquiryScanActivityComplete, &returnParam);
 }
 
 static void HciCmdOnWriteInquiryScanActivityFailed(uint8_t status, const void *param)
@@ -310,12 +210,7 @@ static void HciCmdOnWriteInquiryScanActivityFailed(uint8_t status, const void *p
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeInquiryScanActivityComplete != NULL) {
-        callbacks->writeInquiryScanActivityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeInquiryScanActivityComplete, &returnParam);
 }
 
 static void HciCmdOnReadAuthenticationEnableFailed(uint8_t status, const void *param)
@@ -324,12 +219,7 @@ static void HciCmdOnReadAuthenticationEnableFailed(uint8_t status, const void *p
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readAuthenticationEnableComplete != NULL) {
-        callbacks->readAuthenticationEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readAuthenticationEnableComplete, &returnParam);
 }
 
 static void HciCmdOnWriteAuthenticationEnableFailed(uint8_t status, const void *param)
@@ -338,12 +228,7 @@ static void HciCmdOnWriteAuthenticationEnableFailed(uint8_t status, const void *
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeAuthenticationEnableComplete != NULL) {
-        callbacks->writeAuthenticationEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeAuthenticationEnableComplete, &returnParam);
 }
 
 static void HciCmdOnReadClassofDeviceFailed(uint8_t status, const void *param)
@@ -352,12 +237,7 @@ static void HciCmdOnReadClassofDeviceFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readClassofDeviceComplete != NULL) {
-        callbacks->readClassofDeviceComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readClassofDeviceComplete, &returnParam);
 }
 
 static void HciCmdOnWriteClassofDeviceFailed(uint8_t status, const void *param)
@@ -366,12 +246,7 @@ static void HciCmdOnWriteClassofDeviceFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeClassofDeviceComplete != NULL) {
-        callbacks->writeClassofDeviceComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeClassofDeviceComplete, &returnParam);
 }
 
 static void HciCmdOnReadVoiceSettingFailed(uint8_t status, const void *param)
@@ -380,12 +255,7 @@ static void HciCmdOnReadVoiceSettingFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readVoiceSettingComplete != NULL) {
-        callbacks->readVoiceSettingComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readVoiceSettingComplete, &returnParam);
 }
 
 static void HciCmdOnWriteVoiceSettingFailed(uint8_t status, const void *param)
@@ -394,12 +264,7 @@ static void HciCmdOnWriteVoiceSettingFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeVoiceSettingComplete != NULL) {
-        callbacks->writeVoiceSettingComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeVoiceSettingComplete, &returnParam);
 }
 
 static void HciCmdOnReadAutomaticFlushTimeoutFailed(uint8_t status, const void *param)
@@ -409,12 +274,7 @@ static void HciCmdOnReadAutomaticFlushTimeoutFailed(uint8_t status, const void *
         .connectionHandle = ((HciReadAutomaticFlushTimeoutReturnParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readAutomaticFlushTimeoutComplete != NULL) {
-        callbacks->readAutomaticFlushTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readAutomaticFlushTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnWriteAutomaticFlushTimeoutFailed(uint8_t status, const void *param)
@@ -424,12 +284,7 @@ static void HciCmdOnWriteAutomaticFlushTimeoutFailed(uint8_t status, const void
         .connectionHandle = ((HciWriteAutomaticFlushTimeoutReturnParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeAutomaticFlushTimeoutComplete != NULL) {
-        callbacks->writeAutomaticFlushTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeAutomaticFlushTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnReadNumBroadcastRetransmissionsFailed(uint8_t status, const void *param)
@@ -438,12 +293,7 @@ static void HciCmdOnReadNumBroadcastRetransmissionsFailed(uint8_t status, const
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readNumBroadcastRetransmissionsComplete != NULL) {
-        callbacks->readNumBroadcastRetransmissionsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readNumBroadcastRetransmissionsComplete, &returnParam);
 }
 
 static void HciCmdOnWriteNumBroadcastRetransmissionsFailed(uint8_t status, const void *param)
@@ -452,12 +302,7 @@ static void HciCmdOnWriteNumBroadcastRetransmissionsFailed(uint8_t status, const
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeNumBroadcastRetransmissionsComplete != NULL) {
-        callbacks->writeNumBroadcastRetransmissionsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeNumBroadcastRetransmissionsComplete, &returnParam);
 }
 
 static void HciCmdOnReadHoldModeActivityFailed(uint8_t status, const void *param)
@@ -466,12 +311,7 @@ static void HciCmdOnReadHoldModeActivityFailed(uint8_t status, const void *param
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readHoldModeActivityComplete != NULL) {
-        callbacks->readHoldModeActivityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readHoldModeActivityComplete, &returnParam);
 }
 
 static void HciCmdOnWriteHoldModeActivityFailed(uint8_t status, const void *param)
@@ -480,12 +320,7 @@ static void HciCmdOnWriteHoldModeActivityFailed(uint8_t status, const void *para
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeHoldModeActivityComplete != NULL) {
-        callbacks->writeHoldModeActivityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeHoldModeActivityComplete, &returnParam);
 }
 
 static void HciCmdOnReadTransmitPowerLevelFailed(uint8_t status, const void *param)
@@ -494,12 +329,7 @@ static void HciCmdOnReadTransmitPowerLevelFailed(uint8_t status, const void *par
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readTransmitPowerLevelComplete != NULL) {
-        callbacks->readTransmitPowerLevelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readTransmitPowerLevelComplete, &returnParam);
 }
 
 static void HciCmdOnReadSynchronousFlowControlEnableFailed(uint8_t status, const void *param)
@@ -508,12 +338,7 @@ static void HciCmdOnReadSynchronousFlowControlEnableFailed(uint8_t status, const
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readSynchronousFlowControlEnableComplete != NULL) {
-        callbacks->readSynchronousFlowControlEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readSynchronousFlowControlEnableComplete, &returnParam);
 }
 
 static void HciCmdOnWriteSynchronousFlowControlEnableFailed(uint8_t status, const void *param)
@@ -522,12 +347,7 @@ static void HciCmdOnWriteSynchronousFlowControlEnableFailed(uint8_t status, cons
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeSynchronousFlowControlEnableComplete != NULL) {
-        callbacks->writeSynchronousFlowControlEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeSynchronousFlowControlEnableComplete, &returnParam);
 }
 
 static void HciCmdOnSetControllerToHostFlowControlFailed(uint8_t status, const void *param)
@@ -536,12 +356,7 @@ static void HciCmdOnSetControllerToHostFlowControlFailed(uint8_t status, const v
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setControllerToHostFlowControlComplete != NULL) {
-        callbacks->setControllerToHostFlowControlComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setControllerToHostFlowControlComplete, &returnParam);
 }
 
 static void HciCmdOnHostBufferSizeFailed(uint8_t status, const void *param)
@@ -550,12 +365,7 @@ static void HciCmdOnHostBufferSizeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->hostBufferSizeComplete != NULL) {
-        callbacks->hostBufferSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(hostBufferSizeComplete, &returnParam);
 }
 
 static void HciCmdOnReadLinkSupervisionTimeoutFailed(uint8_t status, const void *param)
@@ -565,12 +375,7 @@ static void HciCmdOnReadLinkSupervisionTimeoutFailed(uint8_t status, const void
         .handle = ((HciReadLinkSupervisionTimeoutReturnParam *)param)->handle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLinkSupervisionTimeoutComplete != NULL) {
-        callbacks->readLinkSupervisionTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLinkSupervisionTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnWriteLinkSupervisionTimeoutFailed(uint8_t status, const void *param)
@@ -580,12 +385,7 @@ static void HciCmdOnWriteLinkSupervisionTimeoutFailed(uint8_t status, const void
         .handle = ((HciWriteLinkSupervisionTimeoutReturnParam *)param)->handle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeLinkSupervisionTimeoutComplete != NULL) {
-        callbacks->writeLinkSupervisionTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeLinkSupervisionTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnReadNumberOfSupportedIACFailed(uint8_t status, const void *param)
@@ -594,12 +394,7 @@ static void HciCmdOnReadNumberOfSupportedIACFailed(uint8_t status, const void *p
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readNumberOfSupportedIacComplete != NULL) {
-        callbacks->readNumberOfSupportedIacComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readNumberOfSupportedIacComplete, &returnParam);
 }
 
 static void HciCmdOnReadCurrentIacLapFailed(uint8_t status, const void *param)
@@ -608,12 +403,7 @@ static void HciCmdOnReadCurrentIacLapFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readCurrentIacLapComplete != NULL) {
-        callbacks->readCurrentIacLapComplete(&returParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readCurrentIacLapComplete, &returParam);
 }
 
 static void HciCmdOnWriteCurrentIacLapFailed(uint8_t status, const void *param)
@@ -622,12 +412,7 @@ static void HciCmdOnWriteCurrentIacLapFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeCurrentIacLapComplete != NULL) {
-        callbacks->writeCurrentIacLapComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeCurrentIacLapComplete, &returnParam);
 }
 
 static void HciCmdOnSetAfhHostChannelClassificationFailed(uint8_t status, const void *param)
@@ -636,12 +421,7 @@ static void HciCmdOnSetAfhHostChannelClassificationFailed(uint8_t status, const
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setAfhHostChannelClassificationComplete != NULL) {
-        callbacks->setAfhHostChannelClassificationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setAfhHostChannelClassificationComplete, &returnParam);
 }
 
 static void HciCmdOnReadInquiryScanTypeFailed(uint8_t status, const void *param)
@@ -650,12 +430,7 @@ static void HciCmdOnReadInquiryScanTypeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readInquiryScanTypeComplete != NULL) {
-        callbacks->readInquiryScanTypeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readInquiryScanTypeComplete, &returnParam);
 }
 
 static void HciCmdOnWriteInquiryScanTypeFailed(uint8_t status, const void *param)
@@ -664,12 +439,7 @@ static void HciCmdOnWriteInquiryScanTypeFailed(uint8_t status, const void *param
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeInquiryScanTypeComplete != NULL) {
-        callbacks->writeInquiryScanTypeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeInquiryScanTypeComplete, &returnParam);
 }
 
 static void HciCmdOnReadInquiryModeFailed(uint8_t status, const void *param)
@@ -678,12 +448,7 @@ static void HciCmdOnReadInquiryModeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readInquiryModeComplete != NULL) {
-        callbacks->readInquiryModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readInquiryModeComplete, &returnParam);
 }
 
 static void HciCmdOnWriteInquiryModeFailed(uint8_t status, const void *param)
@@ -692,12 +457,7 @@ static void HciCmdOnWriteInquiryModeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeInquiryModeComplete != NULL) {
-        callbacks->writeInquiryModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeInquiryModeComplete, &returnParam);
 }
 
 static void HciCmdOnReadPageScanTypeFailed(uint8_t status, const void *param)
@@ -706,12 +466,7 @@ static void HciCmdOnReadPageScanTypeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readPageScanTypeComplete != NULL) {
-        callbacks->readPageScanTypeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readPageScanTypeComplete, &returnParam);
 }
 
 static void HciCmdOnWritePageScanTypeFailed(uint8_t status, const void *pararm)
@@ -720,12 +475,7 @@ static void HciCmdOnWritePageScanTypeFailed(uint8_t status, const void *pararm)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writePageScanTypeComplete != NULL) {
-        callbacks->writePageScanTypeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writePageScanTypeComplete, &returnParam);
 }
 
 static void HciCmdOnReadAfhChannelAssessmentModeFailed(uint8_t status, const void *pararm)
@@ -734,12 +484,7 @@ static void HciCmdOnReadAfhChannelAssessmentModeFailed(uint8_t status, const voi
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readAfhChannelAssessmentModeComplete != NULL) {
-        callbacks->readAfhChannelAssessmentModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readAfhChannelAssessmentModeComplete, &returnParam);
 }
 
 static void HciCmdOnWriteAfhChannelAssessmentModeFailed(uint8_t status, const void *pararm)
@@ -748,12 +493,7 @@ static void HciCmdOnWriteAfhChannelAssessmentModeFailed(uint8_t status, const vo
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeAfhChannelAssessmentModeComplete != NULL) {
-        callbacks->writeAfhChannelAssessmentModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeAfhChannelAssessmentModeComplete, &returnParam);
 }
 
 static void HciCmdOnReadExtendedInquiryResponseFailed(uint8_t status, const void *pararm)
@@ -762,12 +502,7 @@ static void HciCmdOnReadExtendedInquiryResponseFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readExtendedInquiryResponseComplete != NULL) {
-        callbacks->readExtendedInquiryResponseComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readExtendedInquiryResponseComplete, &returnParam);
 }
 
 static void HciCmdOnWriteExtendedInquiryResponseFailed(uint8_t status, const void *param)
@@ -776,12 +511,7 @@ static void HciCmdOnWriteExtendedInquiryResponseFailed(uint8_t status, const voi
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeExtendedInquiryResponseComplete != NULL) {
-        callbacks->writeExtendedInquiryResponseComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeExtendedInquiryResponseComplete, &returnParam);
 }
 
 static void HciCmdOnReadSimplePairingModeFailed(uint8_t status, const void *param)
@@ -790,12 +520,7 @@ static void HciCmdOnReadSimplePairingModeFailed(uint8_t status, const void *para
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readSimplePairingModeComplete != NULL) {
-        callbacks->readSimplePairingModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readSimplePairingModeComplete, &returnParam);
 }
 
 static void HciCmdOnWriteSimplePairingModeFailed(uint8_t status, const void *param)
@@ -804,12 +529,7 @@ static void HciCmdOnWriteSimplePairingModeFailed(uint8_t status, const void *par
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeSimplePairingModeComplete != NULL) {
-        callbacks->writeSimplePairingModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeSimplePairingModeComplete, &returnParam);
 }
 
 static void HciCmdOnReadLocalOobDataFailed(uint8_t status, const void *param)
@@ -818,12 +538,7 @@ static void HciCmdOnReadLocalOobDataFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalOOBDataComplete != NULL) {
-        callbacks->readLocalOOBDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalOOBDataComplete, &returnParam);
 }
 
 static void HciCmdOnReadInquiryResponseTransmitPowerLevelFailed(uint8_t status, const void *param)
@@ -832,12 +547,7 @@ static void HciCmdOnReadInquiryResponseTransmitPowerLevelFailed(uint8_t status,
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readInquiryResponseTransmitPowerLevelComplete != NULL) {
-        callbacks->readInquiryResponseTransmitPowerLevelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readInquiryResponseTransmitPowerLevelComplete, &returnParam);
 }
 
 static void HciCmdOnWriteInquiryTransmitPowerLevelFailed(uint8_t status, const void *param)
@@ -846,12 +556,7 @@ static void HciCmdOnWriteInquiryTransmitPowerLevelFailed(uint8_t status, const v
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeInquiryTransmitPowerLevelComplete != NULL) {
-        callbacks->writeInquiryTransmitPowerLevelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeInquiryTransmitPowerLevelComplete, &returnParam);
 }
 
 static void HciCmdOnSendKeypressNotificationFailed(uint8_t status, const void *param)
@@ -861,12 +566,7 @@ static void HciCmdOnSendKeypressNotificationFailed(uint8_t status, const void *p
         .bdAddr = ((HciSendKeypressNotificationParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->sendKeypressNotificationComplete != NULL) {
-        callbacks->sendKeypressNotificationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(sendKeypressNotificationComplete, &returnParam);
 }
 
 static void HciCmdOnReadDefaultErroneousDataReportingFailed(uint8_t status, const void *param)
@@ -875,12 +575,7 @@ static void HciCmdOnReadDefaultErroneousDataReportingFailed(uint8_t status, cons
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readDefaultErroneousDataReportingComplete != NULL) {
-        callbacks->readDefaultErroneousDataReportingComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readDefaultErroneousDataReportingComplete, &returnParam);
 }
 
 static void HciCmdOnWriteDefaultErroneousDataReportingFailed(uint8_t status, const void *param)
@@ -889,12 +584,7 @@ static void HciCmdOnWriteDefaultErroneousDataReportingFailed(uint8_t status, con
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeDefaultErroneousDataReportingComplete != NULL) {
-        callbacks->writeDefaultErroneousDataReportingComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeDefaultErroneousDataReportingComplete, &returnParam);
 }
 
 static void HciCmdOnReadLogicalLinkAcceptTimeoutFailed(uint8_t status, const void *param)
@@ -903,12 +593,7 @@ static void HciCmdOnReadLogicalLinkAcceptTimeoutFailed(uint8_t status, const voi
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLogicalLinkAcceptTimeoutComplete != NULL) {
-        callbacks->readLogicalLinkAcceptTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLogicalLinkAcceptTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnWriteLogicalLinkAcceptTimeoutFailed(uint8_t status, const void *param)
@@ -917,12 +602,7 @@ static void HciCmdOnWriteLogicalLinkAcceptTimeoutFailed(uint8_t status, const vo
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeLogicalLinkAcceptTimeoutComplete != NULL) {
-        callbacks->writeLogicalLinkAcceptTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeLogicalLinkAcceptTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnSetEventMaskPage2Failed(uint8_t status, const void *param)
@@ -931,12 +611,7 @@ static void HciCmdOnSetEventMaskPage2Failed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setEventMaskPage2Complete != NULL) {
-        callbacks->setEventMaskPage2Complete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setEventMaskPage2Complete, &returnParam);
 }
 
 static void HciCmdOnReadLocationDataFailed(uint8_t status, const void *param)
@@ -945,12 +620,7 @@ static void HciCmdOnReadLocationDataFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocationDataComplete != NULL) {
-        callbacks->readLocationDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocationDataComplete, &returnParam);
 }
 
 static void HciCmdOnWriteLocationDataFailed(uint8_t status, const void *param)
@@ -959,12 +629,7 @@ static void HciCmdOnWriteLocationDataFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeLocationDataComplete != NULL) {
-        callbacks->writeLocationDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeLocationDataComplete, &returnParam);
 }
 
 static void HciCmdOnReadFlowControlModeFailed(uint8_t status, const void *param)
@@ -973,12 +638,7 @@ static void HciCmdOnReadFlowControlModeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readFlowControlModeComplete != NULL) {
-        callbacks->readFlowControlModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readFlowControlModeComplete, &returnParam);
 }
 
 static void HciCmdOnWriteFlowControlModeFailed(uint8_t status, const void *param)
@@ -987,12 +647,7 @@ static void HciCmdOnWriteFlowControlModeFailed(uint8_t status, const void *param
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeFlowControlModeComplete != NULL) {
-        callbacks->writeFlowControlModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeFlowControlModeComplete, &returnParam);
 }
 
 static void HciCmdOnReadEnhancedTransmitPowerLevelFailed(uint8_t status, const void *param)
@@ -1002,12 +657,7 @@ static void HciCmdOnReadEnhancedTransmitPowerLevelFailed(uint8_t status, const v
         .connectionHandle = ((HciReadEnhancedTransmitPowerLevelReturnParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readEnhancedTransmitPowerLevelComplete != NULL) {
-        callbacks->readEnhancedTransmitPowerLevelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readEnhancedTransmitPowerLevelComplete, &returnParam);
 }
 
 static void HciCmdOnReadBestEffortFlushTimeoutFailed(uint8_t status, const void *param)
@@ -1016,12 +666,7 @@ static void HciCmdOnReadBestEffortFlushTimeoutFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readBestEffortFlushTimeoutComplete != NULL) {
-        callbacks->readBestEffortFlushTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readBestEffortFlushTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnWriteBestEffortFlushTimeoutFailed(uint8_t status, const void *param)
@@ -1030,12 +675,7 @@ static void HciCmdOnWriteBestEffortFlushTimeoutFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeBestEffortFlushTimeoutComplete != NULL) {
-        callbacks->writeBestEffortFlushTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeBestEffortFlushTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnReadLeHostSupportFailed(uint8_t status, const void *param)
@@ -1044,12 +684,7 @@ static void HciCmdOnReadLeHostSupportFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLeHostSupportComplete != NULL) {
-        callbacks->readLeHostSupportComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLeHostSupportComplete, &returnParam);
 }
 
 static void HciCmdOnWriteLeHostSupportFailed(uint8_t status, const void *param)
@@ -1058,12 +693,7 @@ static void HciCmdOnWriteLeHostSupportFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeLeHostSupportComplete != NULL) {
-        callbacks->writeLeHostSupportComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeLeHostSupportComplete, &returnParam);
 }
 
 static void HciCmdOnSetMwsChannelParametersFailed(uint8_t status, const void *param)
@@ -1072,12 +702,7 @@ static void HciCmdOnSetMwsChannelParametersFailed(uint8_t status, const void *pa
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setMwsChannelParametersComplete != NULL) {
-        callbacks->setMwsChannelParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setMwsChannelParametersComplete, &returnParam);
 }
 
 static void HciCmdOnSetMwsSignalingFailed(uint8_t status, const void *param)
@@ -1086,12 +711,7 @@ static void HciCmdOnSetMwsSignalingFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setMwsSignalingComplete != NULL) {
-        callbacks->setMwsSignalingComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setMwsSignalingComplete, &returnParam);
 }
 
 static void HciCmdOnSetMwsTransportLayerFailed(uint8_t status, const void *param)
@@ -1100,12 +720,7 @@ static void HciCmdOnSetMwsTransportLayerFailed(uint8_t status, const void *param
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setMwsTransportLayerComplete != NULL) {
-        callbacks->setMwsTransportLayerComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setMwsTransportLayerComplete, &returnParam);
 }
 
 static void HciCmdOnSetReservedLtAddrFailed(uint8_t status, const void *param)
@@ -1114,12 +729,7 @@ static void HciCmdOnSetReservedLtAddrFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setReservedLtAddrComplete != NULL) {
-        callbacks->setReservedLtAddrComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setReservedLtAddrComplete, &returnParam);
 }
 
 static void HciCmdOnDeleteReservedLtAddrFailed(uint8_t status, const void *param)
@@ -1128,12 +738,7 @@ static void HciCmdOnDeleteReservedLtAddrFailed(uint8_t status, const void *param
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->deleteReservedLtAddrComplete != NULL) {
-        callbacks->deleteReservedLtAddrComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(deleteReservedLtAddrComplete, &returnParam);
 }
 
 static void HciCmdOnReadSynchronizationTrainParametersFailed(uint8_t status, const void *param)
@@ -1142,12 +747,7 @@ static void HciCmdOnReadSynchronizationTrainParametersFailed(uint8_t status, con
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readSynchronizationTrainParametersComplete != NULL) {
-        callbacks->readSynchronizationTrainParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readSynchronizationTrainParametersComplete, &returnParam);
 }
 
 static void HciCmdOnWriteSynchronizationTrainParametersFailed(uint8_t status, const void *param)
@@ -1156,12 +756,7 @@ static void HciCmdOnWriteSynchronizationTrainParametersFailed(uint8_t status, co
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeSynchronizationTrainParametersComplete != NULL) {
-        callbacks->writeSynchronizationTrainParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeSynchronizationTrainParametersComplete, &returnParam);
 }
 
 static void HciCmdOnReadSecureConnectionsHostSupportFailed(uint8_t status, const void *param)
@@ -1170,12 +765,7 @@ static void HciCmdOnReadSecureConnectionsHostSupportFailed(uint8_t status, const
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readSecureConnectionsHostSupportComplete != NULL) {
-        callbacks->readSecureConnectionsHostSupportComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readSecureConnectionsHostSupportComplete, &returnParam);
 }
 
 static void HciCmdOnWriteSecureConnectionsHostSupportFailed(uint8_t status, const void *param)
@@ -1184,12 +774,7 @@ static void HciCmdOnWriteSecureConnectionsHostSupportFailed(uint8_t status, cons
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeSecureConnectionsHostSupportComplete != NULL) {
-        callbacks->writeSecureConnectionsHostSupportComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeSecureConnectionsHostSupportComplete, &returnParam);
 }
 
 static void HciCmdOnReadAuthenticatedPayloadTimeoutFailed(uint8_t status, const void *param)
@@ -1199,12 +784,7 @@ static void HciCmdOnReadAuthenticatedPayloadTimeoutFailed(uint8_t status, const
         .connectionHandle = ((HciReadAuthenticatedPayloadTimeoutReturnParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readAuthenticatedPayloadTimeoutComplete != NULL) {
-        callbacks->readAuthenticatedPayloadTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readAuthenticatedPayloadTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnWriteAuthenticatedPayloadTimeoutFailed(uint8_t status, const void *param)
@@ -1214,12 +794,7 @@ static void HciCmdOnWriteAuthenticatedPayloadTimeoutFailed(uint8_t status, const
         .connectionHandle = ((HciWriteAuthenticatedPayloadTimeoutParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeAuthenticatedPayloadTimeoutComplete != NULL) {
-        callbacks->writeAuthenticatedPayloadTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeAuthenticatedPayloadTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnReadLocalOobExtendedDataFailed(uint8_t status, const void *param)
@@ -1228,12 +803,7 @@ static void HciCmdOnReadLocalOobExtendedDataFailed(uint8_t status, const void *p
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalOOBExtendedDataComplete != NULL) {
-        callbacks->readLocalOOBExtendedDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalOOBExtendedDataComplete, &returnParam);
 }
 
 static void HciCmdOnReadExtendedPageTimeoutFailed(uint8_t status, const void *param)
@@ -1242,12 +812,7 @@ static void HciCmdOnReadExtendedPageTimeoutFailed(uint8_t status, const void *pa
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readExtendedPageTimeoutComplete != NULL) {
-        callbacks->readExtendedPageTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readExtendedPageTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnWriteExtendedPageTimeoutFailed(uint8_t status, const void *param)
@@ -1256,12 +821,7 @@ static void HciCmdOnWriteExtendedPageTimeoutFailed(uint8_t status, const void *p
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeExtendedPageTimeoutComplete != NULL) {
-        callbacks->writeExtendedPageTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeExtendedPageTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnReadExtendedInquiryLengthFailed(uint8_t status, const void *param)
@@ -1270,12 +830,7 @@ static void HciCmdOnReadExtendedInquiryLengthFailed(uint8_t status, const void *
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readExtendedInquiryLengthComplete != NULL) {
-        callbacks->readExtendedInquiryLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readExtendedInquiryLengthComplete, &returnParam);
 }
 
 static void HciCmdOnWriteExtendedInquiryLengthFailed(uint8_t status, const void *param)
@@ -1284,12 +839,7 @@ static void HciCmdOnWriteExtendedInquiryLengthFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeExtendedInquiryLengthComplete != NULL) {
-        callbacks->writeExtendedInquiryLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeExtendedInquiryLengthComplete, &returnParam);
 }
 
 static HciCmdOnFailedFunc g_funcMap[] = {
@@ -31,12 +31,7 @@ static void HciCmdOnReadLocalVersionInformationFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalVersionInformationComplete != NULL) {
-        callbacks->readLocalVersionInformationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalVersionInformationComplete, &returnParam);
 }
 
 static void HciCmdOnReadLocalSupportedCommandsFailed(uint8_t status, const void *param)
@@ -45,12 +40,7 @@ static void HciCmdOnReadLocalSupportedCommandsFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalSupportedCommandsComplete != NULL) {
-        callbacks->readLocalSupportedCommandsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalSupportedCommandsComplete, &returnParam);
 }
 
 static void HciCmdOnReadLocalSupportedFeaturesFailed(uint8_t status, const void *param)
@@ -59,12 +49,7 @@ static void HciCmdOnReadLocalSupportedFeaturesFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalSupportedFeaturesComplete != NULL) {
-        callbacks->readLocalSupportedFeaturesComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalSupportedFeaturesComplete, &returnParam);
 }
 
 static void HciCmdOnReadLocalExtendedFeaturesFailed(uint8_t status, const void *param)
@@ -74,12 +59,7 @@ static void HciCmdOnReadLocalExtendedFeaturesFailed(uint8_t status, const void *
         .pageNumber = ((HciReadLocalExtendedFeaturesParam *)param)->pageNumber,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalExtendedFeaturesComplete != NULL) {
-        callbacks->readLocalExtendedFeaturesComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalExtendedFeaturesComplete, &returnParam);
 }
 
 static void HciCmdOnReadBufferSizeFailed(uint8_t status, const void *param)
@@ -88,12 +68,7 @@ static void HciCmdOnReadBufferSizeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readBufferSizeComplete != NULL) {
-        callbacks->readBufferSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readBufferSizeComplete, &returnParam);
 }
 
 static void HciCmdOnReadBdAddrFailed(uint8_t status, const void *param)
@@ -102,12 +77,7 @@ static void HciCmdOnReadBdAddrFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readBdAddrComplete != NULL) {
-        callbacks->readBdAddrComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readBdAddrComplete, &returnParam);
 }
 
 static void HciCmdOnReadDataBlockSizeFailed(uint8_t status, const void *param)
@@ -116,12 +86,7 @@ static void HciCmdOnReadDataBlockSizeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readDataBlockSizeComplete != NULL) {
-        callbacks->readDataBlockSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readDataBlockSizeComplete, &returnParam);
 }
 
 static void HciCmdOnReadLocalSupportedCodecsFailed(uint8_t status, const void *param)
@@ -130,12 +95,7 @@ static void HciCmdOnReadLocalSupportedCodecsFailed(uint8_t status, const void *p
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalSupportedCodecsComplete != NULL) {
-        callbacks->readLocalSupportedCodecsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalSupportedCodecsComplete, &returnParam);
 }
 
 static HciCmdOnFailedFunc g_funcMap[] = {
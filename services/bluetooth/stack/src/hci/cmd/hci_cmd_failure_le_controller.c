@@ -30,12 +30,7 @@ static void HciCmdOnLeSetEventMaskFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetEventMaskComplete != NULL) {
-        callbacks->leSetEventMaskComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetEventMaskComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadBufferSizeFailed(uint8_t status, const void *param)
@@ -44,12 +39,7 @@ static void HciCmdOnLeReadBufferSizeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadBufferSizeComplete != NULL) {
-        callbacks->leReadBufferSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadBufferSizeComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadLocalSupportedFeaturesFailed(uint8_t status, const void *param)
@@ -58,12 +48,7 @@ static void HciCmdOnLeReadLocalSupportedFeaturesFailed(uint8_t status, const voi
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadLocalSupportedFeaturesComplete != NULL) {
-        callbacks->leReadLocalSupportedFeaturesComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadLocalSupportedFeaturesComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetRandomAddressFailed(uint8_t status, const void *param)
@@ -72,12 +57,7 @@ static void HciCmdOnLeSetRandomAddressFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetRandomAddressComplete != NULL) {
-        callbacks->leSetRandomAddressComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetRandomAddressComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetAdvertisingParametersFailed(uint8_t status, const void *param)
@@ -86,12 +66,7 @@ static void HciCmdOnLeSetAdvertisingParametersFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetAdvertisingParametersComplete != NULL) {
-        callbacks->leSetAdvertisingParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetAdvertisingParametersComplete, &returnParam);
 }
 
 static void HciCmdOnReadAdvertisingChannelTxPowerFailed(uint8_t status, const void *param)
@@ -100,12 +75,7 @@ static void HciCmdOnReadAdvertisingChannelTxPowerFailed(uint8_t status, const vo
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadAdvertisingChannelTxPowerComplete != NULL) {
-        callbacks->leReadAdvertisingChannelTxPowerComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadAdvertisingChannelTxPowerComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetAdvertisingDataFailed(uint8_t status, const void *param)
@@ -114,12 +84,7 @@ static void HciCmdOnLeSetAdvertisingDataFailed(uint8_t status, const void *param
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetAdvertisingDataComplete != NULL) {
-        callbacks->leSetAdvertisingDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetAdvertisingDataComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetScanResponseDataFailed(uint8_t status, const void *param)
@@ -128,12 +93,7 @@ static void HciCmdOnLeSetScanResponseDataFailed(uint8_t status, const void *para
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetScanResponseDataComplete != NULL) {
-        callbacks->leSetScanResponseDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetScanResponseDataComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetAdvertisingEnableFailed(uint8_t status, const void *param)
@@ -142,12 +102,7 @@ static void HciCmdOnLeSetAdvertisingEnableFailed(uint8_t status, const void *par
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetAdvertisingEnableComplete != NULL) {
-        callbacks->leSetAdvertisingEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetAdvertisingEnableComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetScanParametersFailed(uint8_t status, const void *param)
@@ -156,12 +111,7 @@ static void HciCmdOnLeSetScanParametersFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetScanParametersComplete != NULL) {
-        callbacks->leSetScanParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetScanParametersComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetScanEnableFailed(uint8_t status, const void *param)
@@ -170,12 +120,7 @@ static void HciCmdOnLeSetScanEnableFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetScanEnableComplete != NULL) {
-        callbacks->leSetScanEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetScanEnableComplete, &returnParam);
 }
 
 static void HciCmdOnLeCreateConnectionFailed(uint8_t status, const void *param)
@@ -186,12 +131,7 @@ static void HciCmdOnLeCreateConnectionFailed(uint8_t status, const void *param)
         .peerAddressType = ((HciLeCreateConnectionParam *)param)->peerAddressType,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leConnectionComplete != NULL) {
-        callbacks->leConnectionComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leConnectionComplete, &eventParam);
 }
 
 static void HciCmdOnLeCreateConnectionCancelFailed(uint8_t status, const void *param)
@@ -200,12 +140,7 @@ static void HciCmdOnLeCreateConnectionCancelFailed(uint8_t status, const void *p
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leCreateConnectionCancelComplete != NULL) {
-        callbacks->leCreateConnectionCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leCreateConnectionCancelComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadWhiteListSizeFailed(uint8_t status, const void *param)
@@ -214,12 +149,7 @@ static void HciCmdOnLeReadWhiteListSizeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadWhiteListSizeComplete != NULL) {
-        callbacks->leReadWhiteListSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadWhiteListSizeComplete, &returnParam);
 }
 
 static void HciCmdOnLeClearWhiteListFailed(uint8_t status, const void *param)
@@ -228,12 +158,7 @@ static void HciCmdOnLeClearWhiteListFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leClearWhiteListComplete != NULL) {
-        callbacks->leClearWhiteListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leClearWhiteListComplete, &returnParam);
 }
 
 static void HciCmdOnLeAddDeviceToWhiteListFailed(uint8_t status, const void *param)
@@ -242,12 +167,7 @@ static void HciCmdOnLeAddDeviceToWhiteListFailed(uint8_t status, const void *par
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leAddDeviceToWhiteListComplete != NULL) {
-        callbacks->leAddDeviceToWhiteListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leAddDeviceToWhiteListComplete, &returnParam);
 }
 
 static void HciCmdOnLeRemoveDeviceFromWhiteListFailed(uint8_t status, const void *param)
@@ -256,12 +176,7 @@ static void HciCmdOnLeRemoveDeviceFromWhiteListFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoveDeviceFromWhiteListComplete != NULL) {
-        callbacks->leRemoveDeviceFromWhiteListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoveDeviceFromWhiteListComplete, &returnParam);
 }
 
 static void HciCmdOnLeConnectionUpdateFailed(uint8_t status, const void *param)
@@ -273,12 +188,7 @@ static void HciCmdOnLeConnectionUpdateFailed(uint8_t status, const void *param)
         .supervisionTimeout = ((HciLeConnectionUpdateParam *)param)->supervisionTimeout,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leConnectionUpdateComplete != NULL) {
-        callbacks->leConnectionUpdateComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leConnectionUpdateComplete, &eventParam);
 }
 
 static void HciCmdOnLeSetHostChannelClassificationFailed(uint8_t status, const void *param)
@@ -287,12 +197,7 @@ static void HciCmdOnLeSetHostChannelClassificationFailed(uint8_t status, const v
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetHostChannelClassificationComplete != NULL) {
-        callbacks->leSetHostChannelClassificationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetHostChannelClassificationComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadChannelMapFailed(uint8_t status, const void *param)
@@ -302,12 +207,7 @@ static void HciCmdOnLeReadChannelMapFailed(uint8_t status, const void *param)
         .connectionHandle = ((HciLeReadChannelMapParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadChannelMapComplete != NULL) {
-        callbacks->leReadChannelMapComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadChannelMapComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadRemoteFeaturesFailed(uint8_t status, const void *param)
@@ -317,12 +217,7 @@ static void HciCmdOnLeReadRemoteFeaturesFailed(uint8_t status, const void *param
         .connectionHandle = ((HciLeReadRemoteFeaturesParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadRemoteFeaturesComplete != NULL) {
-        callbacks->leReadRemoteFeaturesComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadRemoteFeaturesComplete, &eventParam);
 }
 
 static void HciCmdOnLeEncryptFailed(uint8_t status, const void *param)
@@ -331,12 +226,7 @@ static void HciCmdOnLeEncryptFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leEncryptComplete != NULL) {
-        callbacks->leEncryptComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leEncryptComplete, &returnParam);
 }
 
 static void HciCmdOnLeRandFailed(uint8_t status, const void *param)
@@ -345,12 +235,7 @@ static void HciCmdOnLeRandFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRandComplete != NULL) {
-        callbacks->leRandComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRandComplete, &returnParam);
 }
 
 static void HciCmdOnLeStartEncryptionFailed(uint8_t status, const void *param)
@@ -360,12 +245,7 @@ static void HciCmdOnLeStartEncryptionFailed(uint8_t status, const void *param)
         .connectionHandle = ((HciLeStartEncryptionParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->encryptionKeyRefreshComplete != NULL) {
-        callbacks->encryptionKeyRefreshComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(encryptionKeyRefreshComplete, &eventParam);
 }
 
 static void HciCmdOnLeLongTermKeyRequestReplyFailed(uint8_t status, const void *param)
@@ -375,12 +255,7 @@ static void HciCmdOnLeLongTermKeyRequestReplyFailed(uint8_t status, const void *
         .connectionHandle = ((HciLeLongTermKeyRequestReplyParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leLongTermKeyRequestReplyComplete != NULL) {
-        callbacks->leLongTermKeyRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leLongTermKeyRequestReplyComplete, &returnParam);
 }
 
 static void HciCmdOnLeLongTermKeyRequestNegativeReplyFailed(uint8_t status, const void *param)
@@ -390,12 +265,7 @@ static void HciCmdOnLeLongTermKeyRequestNegativeReplyFailed(uint8_t status, cons
         .connectionHandle = ((HciLeLongTermKeyRequestNegativeReplyParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leLongTermKeyRequestNegativeReplyComplete != NULL) {
-        callbacks->leLongTermKeyRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leLongTermKeyRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadSupportedStatesFailed(uint8_t status, const void *param)
@@ -404,12 +274,7 @@ static void HciCmdOnLeReadSupportedStatesFailed(uint8_t status, const void *para
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadSupportedStatesComplete != NULL) {
-        callbacks->leReadSupportedStatesComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadSupportedStatesComplete, &returnParam);
 }
 
 static void HciCmdOnLeReceiverTestFailed(uint8_t status, const void *param)
@@ -418,12 +283,7 @@ static void HciCmdOnLeReceiverTestFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReceiverTestComplete != NULL) {
-        callbacks->leReceiverTestComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReceiverTestComplete, &returnParam);
 }
 
 static void HciCmdOnLeTransmitterTestFailed(uint8_t status, const void *param)
@@ -432,12 +292,7 @@ static void HciCmdOnLeTransmitterTestFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leTransmitterTestComplete != NULL) {
-        callbacks->leTransmitterTestComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leTransmitterTestComplete, &returnParam);
 }
 
 static void HciCmdOnLeTestEndFailed(uint8_t status, const void *param)
@@ -446,12 +301,7 @@ static void HciCmdOnLeTestEndFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leTestEndComplete != NULL) {
-        callbacks->leTestEndComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leTestEndComplete, &returnParam);
 }
 
 static void HciCmdOnLeRemoteConnectionParameterRequestFailed(uint8_t status, const void *param)
@@ -461,12 +311,7 @@ static void HciCmdOnLeRemoteConnectionParameterRequestFailed(uint8_t status, con
         .connectionHandle = ((HciLeRemoteConnectionParameterRequestReplyParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoteConnectionParameterRequestReplyComplete != NULL) {
-        callbacks->leRemoteConnectionParameterRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoteConnectionParameterRequestReplyComplete, &returnParam);
 }
 
 static void HciCmdOnLeRemoteConnectionParameterRequestNegativeReplyFailed(uint8_t status, const void *param)
@@ -476,12 +321,7 @@ static void HciCmdOnLeRemoteConnectionParameterRequestNegativeReplyFailed(uint8_
         .connectionHandle = ((HciLeRemoteConnectionParameterRequestNegativeReplyParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoteConnectionParameterRequestNegativeReplyComplete != NULL) {
-        callbacks->leRemoteConnectionParameterRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoteConnectionParameterRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetDataLengthFailed(uint8_t status, const void *param)
@@ -491,14 +331,7 @@ static void HciCmdOnLeSetDataLengthFailed(uint8_t status, const void *param)
         .connectionHandle = ((HciLeSetDataLengthReturnParam *)param)->connectionHandle,
     };
 
-    MutexUnlock(HciGetEventCallbackListLock());
-
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetDataLengthComplete != NULL) {
-        callbacks->leSetDataLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetDataLengthComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadSuggestedDefaultDataLengthFailed(uint8_t status, const void *param)
@@ -507,12 +340,7 @@ static void HciCmdOnLeReadSuggestedDefaultDataLengthFailed(uint8_t status, const
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadSuggestedDefaultDataLengthComplete != NULL) {
-        callbacks->leReadSuggestedDefaultDataLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadSuggestedDefaultDataLengthComplete, &returnParam);
 }
 
 static void HciCmdOnLeWriteSuggestedDefaultDataLengthFailed(uint8_t status, const void *param)
@@ -521,12 +349,7 @@ static void HciCmdOnLeWriteSuggestedDefaultDataLengthFailed(uint8_t status, cons
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leWriteSuggestedDefaultDataLengthComplete != NULL) {
-        callbacks->leWriteSuggestedDefaultDataLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leWriteSuggestedDefaultDataLengthComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadLocalP256PublicKeyFailed(uint8_t status, const void *param)
@@ -535,12 +358,7 @@ static void HciCmdOnLeReadLocalP256PublicKeyFailed(uint8_t status, const void *p
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadLocalP256PublicKeyComplete != NULL) {
-        callbacks->leReadLocalP256PublicKeyComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadLocalP256PublicKeyComplete, &eventParam);
 }
 
 static void HciCmdOnLeGenerateDhKeyFailed(uint8_t status, const void *param)
@@ -549,12 +367,7 @@ static void HciCmdOnLeGenerateDhKeyFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leGenerateDHKeyComplete != NULL) {
-        callbacks->leGenerateDHKeyComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leGenerateDHKeyComplete, &eventParam);
 }
 
 static void HciCmdOnLeAddDeviceToResolvingListFailed(uint8_t status, const void *param)
@@ -563,12 +376,7 @@ static void HciCmdOnLeAddDeviceToResolvingListFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leAddDeviceToResolvingListComplete != NULL) {
-        callbacks->leAddDeviceToResolvingListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leAddDeviceToResolvingListComplete, &returnParam);
 }
 
 static void HciCmdOnLeRemoveDeviceFromResolvingListFailed(uint8_t status, const void *param)
@@ -577,12 +385,7 @@ static void HciCmdOnLeRemoveDeviceFromResolvingListFailed(uint8_t status, const
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoveDeviceFromResolvingListComplete != NULL) {
-        callbacks->leRemoveDeviceFromResolvingListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoveDeviceFromResolvingListComplete, &returnParam);
 }
 
 static void HciCmdOnLeClearResolvingListFailed(uint8_t status, const void *param)
@@ -591,12 +394,7 @@ static void HciCmdOnLeClearResolvingListFailed(uint8_t status, const void *param
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leClearResolvingListComplete != NULL) {
-        callbacks->leClearResolvingListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leClearResolvingListComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadResolvingListSizeFailed(uint8_t status, const void *param)
@@ -605,12 +403,7 @@ static void HciCmdOnLeReadResolvingListSizeFailed(uint8_t status, const void *pa
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadResolvingListSizeComplete != NULL) {
-        callbacks->leReadResolvingListSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadResolvingListSizeComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadPeerResolvableAddressFailed(uint8_t status, const void *param)
@@ -619,12 +412,7 @@ static void HciCmdOnLeReadPeerResolvableAddressFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadPeerResolvableAddressComplete != NULL) {
-        callbacks->leReadPeerResolvableAddressComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadPeerResolvableAddressComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadLocalResolvableAddressFailed(uint8_t status, const void *param)
@@ -633,12 +421,7 @@ static void HciCmdOnLeReadLocalResolvableAddressFailed(uint8_t status, const voi
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadLocalResolvableAddressComplete != NULL) {
-        callbacks->leReadLocalResolvableAddressComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadLocalResolvableAddressComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetAddressResolutionEnableFailed(uint8_t status, const void *param)
@@ -647,12 +430,7 @@ static void HciCmdOnLeSetAddressResolutionEnableFailed(uint8_t status, const voi
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetAddressResolutionEnableComplete != NULL) {
-        callbacks->leSetAddressResolutionEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetAddressResolutionEnableComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetResolvablePrivateAddressTimeoutFailed(uint8_t status, const void *param)
@@ -661,12 +439,7 @@ static void HciCmdOnLeSetResolvablePrivateAddressTimeoutFailed(uint8_t status, c
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetResolvablePrivateAddressTimeoutComplete != NULL) {
-        callbacks->leSetResolvablePrivateAddressTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetResolvablePrivateAddressTimeoutComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadMaximumDataLengthFailed(uint8_t status, const void *param)
@@ -675,12 +448,7 @@ static void HciCmdOnLeReadMaximumDataLengthFailed(uint8_t status, const void *pa
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadMaximumDataLengthComplete != NULL) {
-        callbacks->leReadMaximumDataLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadMaximumDataLengthComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadPhyFailed(uint8_t status, const void *param)
@@ -690,14 +458,7 @@ static void HciCmdOnLeReadPhyFailed(uint8_t status, const void *param)
         .connectionHandle = ((HciLeReadPhyReturnParam *)param)->connectionHandle,
     };
 
-    MutexUnlock(HciGetEventCallbackListLock());
-
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadPhyComplete != NULL) {
-        callbacks->leReadPhyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadPhyComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetDefaultPhyFailed(uint8_t status, const void *param)
@@ -706,12 +467,7 @@ static void HciCmdOnLeSetDefaultPhyFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetDefaultPhyComplete != NULL) {
-        callbacks->leSetDefaultPhyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetDefaultPhyComplete, &returnParam);
 }
 
 static void HciCmdOnLeEnhancedReceiverTestFailed(uint8_t status, const void *param)
@@ -720,12 +476,7 @@ static void HciCmdOnLeEnhancedReceiverTestFailed(uint8_t status, const void *par
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leEnhancedReceiverTestComplete != NULL) {
-        callbacks->leEnhancedReceiverTestComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leEnhancedReceiverTestComplete, &returnParam);
 }
 
 static void HciCmdOnLeEnhancedTransmitterTestFailed(uint8_t status, const void *param)
@@ -734,12 +485,7 @@ static void HciCmdOnLeEnhancedTransmitterTestFailed(uint8_t status, const void *
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leEnhancedTransmitterTestComplete != NULL) {
-        callbacks->leEnhancedTransmitterTestComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leEnhancedTransmitterTestComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetAdvertisingSetRandomAddressFailed(uint8_t status, const void *param)
@@ -748,12 +494,7 @@ static void HciCmdOnLeSetAdvertisingSetRandomAddressFailed(uint8_t status, const
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetAdvertisingSetRandomAddressComplete != NULL) {
-        callbacks->leSetAdvertisingSetRandomAddressComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetAdvertisingSetRandomAddressComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetExtendedAdvertisingParametersFailed(uint8_t status, const void *param)
@@ -762,12 +503,7 @@ static void HciCmdOnLeSetExtendedAdvertisingParametersFailed(uint8_t status, con
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetExtendedAdvertisingParametersComplete != NULL) {
-        callbacks->leSetExtendedAdvertisingParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetExtendedAdvertisingParametersComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetExtendedAdvertisingDataFailed(uint8_t status, const void *param)
@@ -776,12 +512,7 @@ static void HciCmdOnLeSetExtendedAdvertisingDataFailed(uint8_t status, const voi
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetExtendedAdvertisingDataComplete != NULL) {
-        callbacks->leSetExtendedAdvertisingDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetExtendedAdvertisingDataComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetExtendedScanResponseDataFailed(uint8_t status, const void *param)
@@ -790,12 +521,7 @@ static void HciCmdOnLeSetExtendedScanResponseDataFailed(uint8_t status, const vo
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetExtendedScanResponseDataComplete != NULL) {
-        callbacks->leSetExtendedScanResponseDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetExtendedScanResponseDataComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetExtendedAdvertisingEnableFailed(uint8_t status, const void *param)
@@ -804,12 +530,7 @@ static void HciCmdOnLeSetExtendedAdvertisingEnableFailed(uint8_t status, const v
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetExtendedAdvertisingEnableComplete != NULL) {
-        callbacks->leSetExtendedAdvertisingEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetExtendedAdvertisingEnableComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadMaximumAdvertisingDataLengthFailed(uint8_t status, const void *param)
@@ -818,12 +539,7 @@ static void HciCmdOnLeReadMaximumAdvertisingDataLengthFailed(uint8_t status, con
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadMaximumAdvertisingDataLengthComplete != NULL) {
-        callbacks->leReadMaximumAdvertisingDataLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadMaximumAdvertisingDataLengthComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadNumberofSupportedAdvertisingSetsFailed(uint8_t status, const void *param)
@@ -832,12 +548,7 @@ static void HciCmdOnLeReadNumberofSupportedAdvertisingSetsFailed(uint8_t status,
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadNumberofSupportedAdvertisingSetsComplete != NULL) {
-        callbacks->leReadNumberofSupportedAdvertisingSetsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadNumberofSupportedAdvertisingSetsComplete, &returnParam);
 }
 
 static void HciCmdOnLeRemoveAdvertisingSetFailed(uint8_t status, const void *param)
@@ -846,12 +557,7 @@ static void HciCmdOnLeRemoveAdvertisingSetFailed(uint8_t status, const void *par
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoveAdvertisingSetComplete != NULL) {
-        callbacks->leRemoveAdvertisingSetComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoveAdvertisingSetComplete, &returnParam);
 }
 
 static void HciCmdOnLeClearAdvertisingSetsFailed(uint8_t status, const void *param)
@@ -860,12 +566,7 @@ static void HciCmdOnLeClearAdvertisingSetsFailed(uint8_t status, const void *par
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leClearAdvertisingSetsComplete != NULL) {
-        callbacks->leClearAdvertisingSetsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leClearAdvertisingSetsComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetPeriodicAdvertisingParametersFailed(uint8_t status, const void *param)
@@ -874,12 +575,7 @@ static void HciCmdOnLeSetPeriodicAdvertisingParametersFailed(uint8_t status, con
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetPeriodicAdvertisingParametersComplete != NULL) {
-        callbacks->leSetPeriodicAdvertisingParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetPeriodicAdvertisingParametersComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetPeriodicAdvertisingDataFailed(uint8_t status, const void *param)
@@ -888,12 +584,7 @@ static void HciCmdOnLeSetPeriodicAdvertisingDataFailed(uint8_t status, const voi
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetPeriodicAdvertisingDataComplete != NULL) {
-        callbacks->leSetPeriodicAdvertisingDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetPeriodicAdvertisingDataComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetPeriodicAdvertisingEnableFailed(uint8_t status, const void *param)
@@ -902,12 +593,7 @@ static void HciCmdOnLeSetPeriodicAdvertisingEnableFailed(uint8_t status, const v
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetPeriodicAdvertisingEnableComplete != NULL) {
-        callbacks->leSetPeriodicAdvertisingEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetPeriodicAdvertisingEnableComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetExtendedScanParametersFailed(uint8_t status, const void *param)
@@ -916,12 +602,7 @@ static void HciCmdOnLeSetExtendedScanParametersFailed(uint8_t status, const void
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetExtendedScanParametersComplete != NULL) {
-        callbacks->leSetExtendedScanParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetExtendedScanParametersComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetExtendedScanEnableFailed(uint8_t status, const void *param)
@@ -930,12 +611,7 @@ static void HciCmdOnLeSetExtendedScanEnableFailed(uint8_t status, const void *pa
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetExtendedScanEnableComplete != NULL) {
-        callbacks->leSetExtendedScanEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetExtendedScanEnableComplete, &returnParam);
 }
 
 static void HciCmdOnLeExtendedCreateConnectionFailed(uint8_t status, const void *param)
@@ -948,12 +624,7 @@ static void HciCmdOnLeExtendedCreateConnectionFailed(uint8_t status, const void
         .peerAddress = cmdParam->peerAddress,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leEnhancedConnectionComplete != NULL) {
-        callbacks->leEnhancedConnectionComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leEnhancedConnectionComplete, &eventParam);
 }
 
 static void HciCmdOnLePeriodicAdvertisingCreateSyncCancelFailed(uint8_t status, const void *param)
@@ -962,12 +633,7 @@ static void HciCmdOnLePeriodicAdvertisingCreateSyncCancelFailed(uint8_t status,
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->lePeriodicAdvertisingCreateSyncCancelComplete != NULL) {
-        callbacks->lePeriodicAdvertisingCreateSyncCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(lePeriodicAdvertisingCreateSyncCancelComplete, &returnParam);
 }
 
 static void HciCmdOnLePeriodicAdvertisingTerminateSyncFailed(uint8_t status, const void *param)
@@ -976,12 +642,7 @@ static void HciCmdOnLePeriodicAdvertisingTerminateSyncFailed(uint8_t status, con
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->lePeriodicAdvertisingTerminateSyncComplete != NULL) {
-        callbacks->lePeriodicAdvertisingTerminateSyncComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(lePeriodicAdvertisingTerminateSyncComplete, &returnParam);
 }
 
 static void HciCmdOnLeAddDeviceToPeriodicAdvertiserListFailed(uint8_t status, const void *param)
@@ -990,12 +651,7 @@ static void HciCmdOnLeAddDeviceToPeriodicAdvertiserListFailed(uint8_t status, co
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leAddDeviceToPeriodicAdvertiserListComplete != NULL) {
-        callbacks->leAddDeviceToPeriodicAdvertiserListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leAddDeviceToPeriodicAdvertiserListComplete, &returnParam);
 }
 
 static void HciCmdOnLeRemoveDeviceFromPeriodicAdvertiserListFailed(uint8_t status, const void *param)
@@ -1004,12 +660,7 @@ static void HciCmdOnLeRemoveDeviceFromPeriodicAdvertiserListFailed(uint8_t statu
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoveDeviceFromPeriodicAdvertiserListComplete != NULL) {
-        callbacks->leRemoveDeviceFromPeriodicAdvertiserListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoveDeviceFromPeriodicAdvertiserListComplete, &returnParam);
 }
 
 static void HciCmdOnLeClearPeriodicAdvertiserListFailed(uint8_t status, const void *param)
@@ -1018,12 +669,7 @@ static void HciCmdOnLeClearPeriodicAdvertiserListFailed(uint8_t status, const vo
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leClearPeriodicAdvertiserListComplete != NULL) {
-        callbacks->leClearPeriodicAdvertiserListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leClearPeriodicAdvertiserListComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadPeriodicAdvertiserListSizeFailed(uint8_t status, const void *param)
@@ -1032,12 +678,7 @@ static void HciCmdOnLeReadPeriodicAdvertiserListSizeFailed(uint8_t status, const
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadPeriodicAdvertiserListSizeComplete != NULL) {
-        callbacks->leReadPeriodicAdvertiserListSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadPeriodicAdvertiserListSizeComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadTransmitPowerFailed(uint8_t status, const void *param)
@@ -1046,12 +687,7 @@ static void HciCmdOnLeReadTransmitPowerFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadTransmitPowerComplete != NULL) {
-        callbacks->leReadTransmitPowerComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadTransmitPowerComplete, &returnParam);
 }
 
 static void HciCmdOnLeReadRfPathCompensationFailed(uint8_t status, const void *param)
@@ -1060,12 +696,7 @@ static void HciCmdOnLeReadRfPathCompensationFailed(uint8_t status, const void *p
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadRfPathCompensationComplete != NULL) {
-        callbacks->leReadRfPathCompensationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadRfPathCompensationComplete, &returnParam);
 }
 
 static void HciCmdOnLeWriteRfPathCompensationParamFailed(uint8_t status, const void *param)
@@ -1074,12 +705,7 @@ static void HciCmdOnLeWriteRfPathCompensationParamFailed(uint8_t status, const v
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leWriteRfPathCompensationComplete != NULL) {
-        callbacks->leWriteRfPathCompensationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leWriteRfPathCompensationComplete, &returnParam);
 }
 
 static void HciCmdOnLeSetPrivacyModeFailed(uint8_t status, const void *param)
@@ -1088,12 +714,7 @@ static void HciCmdOnLeSetPrivacyModeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetPrivacyModeComplete != NULL) {
-        callbacks->leSetPrivacyModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetPrivacyModeComplete, &returnParam);
 }
 
 static HciCmdOnFailedFunc g_funcMap[] = {
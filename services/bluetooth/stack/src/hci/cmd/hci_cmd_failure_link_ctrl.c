@@ -33,12 +33,7 @@ static void HciCmdOnInquiryFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->inquiryComplete != NULL) {
-        callbacks->inquiryComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(inquiryComplete, &eventParam);
 }
 
 static void HciCmdOnInquiryCancelFailed(uint8_t status, const void *param)
@@ -47,12 +42,7 @@ static void HciCmdOnInquiryCancelFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->inquiryCancelComplete != NULL) {
-        callbacks->inquiryCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(inquiryCancelComplete, &returnParam);
 }
 
 static void HciCmdOnPeriodicInquiryModeFailed(uint8_t status, const void *param)
@@ -61,12 +51,7 @@ static void HciCmdOnPeriodicInquiryModeFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->periodicInquiryModeComplete != NULL) {
-        callbacks->periodicInquiryModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(periodicInquiryModeComplete, &returnParam);
 }
 
 static void HciCmdOnExitPeriodicInquiryModeFailed(uint8_t status, const void *param)
@@ -75,12 +60,7 @@ static void HciCmdOnExitPeriodicInquiryModeFailed(uint8_t status, const void *pa
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->exitPeriodicInquiryModeComplete != NULL) {
-        callbacks->exitPeriodicInquiryModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(exitPeriodicInquiryModeComplete, &returnParam);
 }
 
 static void HciCmdOnCreateConnectionFailed(uint8_t status, const void *param)
@@ -93,12 +73,7 @@ static void HciCmdOnCreateConnectionFailed(uint8_t status, const void *param)
         .encryptionEnabled = 0,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->connectionComplete != NULL) {
-        callbacks->connectionComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(connectionComplete, &returnParam);
 }
 
 static void HciCmdOnDisconnectFailed(uint8_t status, const void *param)
@@ -109,12 +84,7 @@ static void HciCmdOnDisconnectFailed(uint8_t status, const void *param)
         .reason = ((HciDisconnectParam *)param)->reason,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->disconnectComplete != NULL) {
-        callbacks->disconnectComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(disconnectComplete, &eventParam);
 }
 
 static void HciCmdOnCreateConnectionCancelFailed(uint8_t status, const void *param)
@@ -124,12 +94,7 @@ static void HciCmdOnCreateConnectionCancelFailed(uint8_t status, const void *par
         .bdAddr = ((HciCreateConnectionCancelParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->createConnectionCancelComplete != NULL) {
-        callbacks->createConnectionCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(createConnectionCancelComplete, &returnParam);
 }
 
 static void HciCmdOnAcceptConnectionRequestFailed(uint8_t status, const void *param)
@@ -139,12 +104,7 @@ static void HciCmdOnAcceptConnectionRequestFailed(uint8_t status, const void *pa
         .bdAddr = ((HciAcceptConnectionReqestParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->connectionComplete != NULL) {
-        callbacks->connectionComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(connectionComplete, &returnParam);
 }
 
 static void HciCmdOnRejectConnectionRequestFailed(uint8_t status, const void *param)
@@ -154,12 +114,7 @@ static void HciCmdOnRejectConnectionRequestFailed(uint8_t status, const void *pa
         .bdAddr = ((HciRejectConnectionRequestParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->connectionComplete != NULL) {
-        callbacks->connectionComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(connectionComplete, &returnParam);
 }
 
 static void HciCmdOnLinkKeyRequestReplyFailed(uint8_t status, const void *param)
@@ -169,12 +124,7 @@ static void HciCmdOnLinkKeyRequestReplyFailed(uint8_t status, const void *param)
         .bdAddr = ((HciLinkKeyRequestReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->linkKeyRequestReplyComplete != NULL) {
-        callbacks->linkKeyRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(linkKeyRequestReplyComplete, &returnParam);
 }
 
 static void HciCmdOnLinkKeyRequestNegativeReplyFailed(uint8_t status, const void *param)
@@ -184,12 +134,7 @@ static void HciCmdOnLinkKeyRequestNegativeReplyFailed(uint8_t status, const void
         .bdAddr = ((HciLinkKeyRequestNegativeReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->linkKeyRequestNegativeReplyComplete != NULL) {
-        callbacks->linkKeyRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(linkKeyRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciCmdOnPinCodeRequestReplyFailed(uint8_t status, const void *param)
@@ -199,12 +144,7 @@ static void HciCmdOnPinCodeRequestReplyFailed(uint8_t status, const void *param)
         .bdAddr = ((HciPinCodeRequestReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->pinCodeRequestReplyComplete != NULL) {
-        callbacks->pinCodeRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(pinCodeRequestReplyComplete, &returnParam);
 }
 
 static void HciCmdOnPinCodeRequestNegativeReplyFailed(uint8_t status, const void *param)
@@ -214,12 +154,7 @@ static void HciCmdOnPinCodeRequestNegativeReplyFailed(uint8_t status, const void
         .bdAddr = ((HciPinCodeRequestNegativeReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->pinCodeRequestNegativeReplyComplete != NULL) {
-        callbacks->pinCodeRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(pinCodeRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciCmdOnAuthenticationRequestedFailed(uint8_t status, const void *param)
@@ -229,12 +164,7 @@ static void HciCmdOnAuthenticationRequestedFailed(uint8_t status, const void *pa
         .connectionHandle = ((HciAuthenticationRequestedParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->authenticationComplete != NULL) {
-        callbacks->authenticationComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(authenticationComplete, &eventParam);
 }
 
 static void HciCmdOnSetConnectionEncryptionFailed(uint8_t status, const void *param)
@@ -244,12 +174,7 @@ static void HciCmdOnSetConnectionEncryptionFailed(uint8_t status, const void *pa
         .connectionHandle = ((HciSetConnectionEncryptionParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->encryptionChange != NULL) {
-        callbacks->encryptionChange(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(encryptionChange, &eventParam);
 }
 
 static void HciCmdOnRemoteNameRequestFailed(uint8_t status, const void *param)
@@ -259,12 +184,7 @@ static void HciCmdOnRemoteNameRequestFailed(uint8_t status, const void *param)
         .bdAddr = ((HciRemoteNameRequestParam *)param)->addr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->remoteNameRequestComplete != NULL) {
-        callbacks->remoteNameRequestComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(remoteNameRequestComplete, &eventParam);
 }
 
 static void HciCmdOnRemoteNameRequestCancelFailed(uint8_t status, const void *param)
@@ -274,12 +194,7 @@ static void HciCmdOnRemoteNameRequestCancelFailed(uint8_t status, const void *pa
         .addr = ((HciRemoteNameRequestCancelParam *)param)->addr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->remoteNameRequestCancelComplete != NULL) {
-        callbacks->remoteNameRequestCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(remoteNameRequestCancelComplete, &returnParam);
 }
 
 static void HciCmdOnReadRemoteSupportedFeaturesFailed(uint8_t status, const void *param)
@@ -289,12 +204,7 @@ static void HciCmdOnReadRemoteSupportedFeaturesFailed(uint8_t status, const void
         .connectionHandle = ((HciReadRemoteSupportedFeaturesParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readRemoteSupportedFeaturesComplete != NULL) {
-        callbacks->readRemoteSupportedFeaturesComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readRemoteSupportedFeaturesComplete, &eventParam);
 }
 
 static void HciCmdOnReadRemoteExtendedFeaturesFailed(uint8_t status, const void *param)
@@ -305,12 +215,7 @@ static void HciCmdOnReadRemoteExtendedFeaturesFailed(uint8_t status, const void
         .pageNumber = ((HciReadRemoteExtendedFeaturesParam *)param)->pageNumber,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readRemoteExtendedFeaturesComplete != NULL) {
-        callbacks->readRemoteExtendedFeaturesComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readRemoteExtendedFeaturesComplete, &eventParam);
 }
 
 static void HciCmdOnReadRemoteVersionInformationFailed(uint8_t status, const void *param)
@@ -320,12 +225,7 @@ static void HciCmdOnReadRemoteVersionInformationFailed(uint8_t status, const voi
         .connectionHandle = ((HciReadRemoteVersionInformationParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readRemoteVersionInformationComplete != NULL) {
-        callbacks->readRemoteVersionInformationComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readRemoteVersionInformationComplete, &eventParam);
 }
 
 static void HciCmdOnReadLmpHandleFailed(uint8_t status, const void *param)
@@ -335,12 +235,7 @@ static void HciCmdOnReadLmpHandleFailed(uint8_t status, const void *param)
         .connectionHandle = ((HciReadLmpHandleReturnParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLmpHandleComplete != NULL) {
-        callbacks->readLmpHandleComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLmpHandleComplete, &returnParam);
 }
 
 static void HciCmdOnSetupSynchronousConnectionFailed(uint8_t status, const void *param)
@@ -354,12 +249,7 @@ static void HciCmdOnSetupSynchronousConnectionFailed(uint8_t status, const void
     };
     (void)memcpy_s(eventParam.bdAddr.raw, BT_ADDRESS_SIZE, addr.addr, BT_ADDRESS_SIZE);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->synchronousConnectionComplete != NULL) {
-        callbacks->synchronousConnectionComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(synchronousConnectionComplete, &eventParam);
 }
 
 static void HciCmdOnAcceptSynchronousConnectionRequestFailed(uint8_t status, const void *param)
@@ -369,12 +259,7 @@ static void HciCmdOnAcceptSynchronousConnectionRequestFailed(uint8_t status, con
         .bdAddr = ((HciAcceptSynchronousConnectionRequestParam *)param)->addr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->synchronousConnectionComplete != NULL) {
-        callbacks->synchronousConnectionComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(synchronousConnectionComplete, &returnParam);
 }
 
 static void HciCmdOnRejectSynchronousConnectionRequestFailed(uint8_t status, const void *param)
@@ -384,12 +269,7 @@ static void HciCmdOnRejectSynchronousConnectionRequestFailed(uint8_t status, con
         .bdAddr = ((HciRejectSynchronousConnectionRequestParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->synchronousConnectionComplete != NULL) {
-        callbacks->synchronousConnectionComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(synchronousConnectionComplete, &eventParam);
 }
 
 static void HciCmdOnIoCapabilityRequestReplyFailed(uint8_t status, const void *param)
@@ -399,12 +279,7 @@ static void HciCmdOnIoCapabilityRequestReplyFailed(uint8_t status, const void *p
         .bdAddr = ((HciIOCapabilityRequestReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->ioCapabilityRequestReplyComplete != NULL) {
-        callbacks->ioCapabilityRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(ioCapabilityRequestReplyComplete, &returnParam);
 }
 
 static void HciCmdOnUserConfirmationRequestReplyFailed(uint8_t status, const void *param)
@@ -414,12 +289,7 @@ static void HciCmdOnUserConfirmationRequestReplyFailed(uint8_t status, const voi
         .bdAddr = ((HciUserConfirmationRequestReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->userConfirmationRequestReplyComplete != NULL) {
-        callbacks->userConfirmationRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(userConfirmationRequestReplyComplete, &returnParam);
 }
 
 static void HciCmdOnUserPasskeyRequestReplyFailed(uint8_t status, const void *param)
@@ -429,12 +299,7 @@ static void HciCmdOnUserPasskeyRequestReplyFailed(uint8_t status, const void *pa
         .bdAddr = ((HciUserPasskeyRequestReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->userPasskeyRequestReplyComplete != NULL) {
-        callbacks->userPasskeyRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(userPasskeyRequestReplyComplete, &returnParam);
 }
 
 static void HciCmdOnUserPasskeyRequestNegativeReplyFailed(uint8_t status, const void *param)
@@ -444,12 +309,7 @@ static void HciCmdOnUserPasskeyRequestNegativeReplyFailed(uint8_t status, const
         .bdAddr = ((HciUserPasskeyRequestNegativeReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->userPasskeyRequestNegativeReplyComplete != NULL) {
-        callbacks->userPasskeyRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(userPasskeyRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciCmdOnRemoteOobDataRequestReplyFailed(uint8_t status, const void *param)
@@ -459,12 +319,7 @@ static void HciCmdOnRemoteOobDataRequestReplyFailed(uint8_t status, const void *
         .bdAddr = ((HciRemoteOobDataRequestReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->remoteOOBDataRequestReplyComplete != NULL) {
-        callbacks->remoteOOBDataRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(remoteOOBDataRequestReplyComplete, &returnParam);
 }
 
 static void HciCmdOnRemoteOobDataRequestNegativeReplyFailed(uint8_t status, const void *param)
@@ -474,12 +329,7 @@ static void HciCmdOnRemoteOobDataRequestNegativeReplyFailed(uint8_t status, cons
         .bdAddr = ((HciRemoteOobDataRequestNegativeReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->remoteOOBDataRequestNegativeReplyComplete != NULL) {
-        callbacks->remoteOOBDataRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(remoteOOBDataRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciCmdOnIoCapabilityRequestNegativeReplyFailed(uint8_t status, const void *param)
@@ -489,12 +339,7 @@ static void HciCmdOnIoCapabilityRequestNegativeReplyFailed(uint8_t status, const
         .bdAddr = ((HciIoCapabilityRequestNegativeReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->iOCapabilityRequestNegativeReplyComplete != NULL) {
-        callbacks->iOCapabilityRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(iOCapabilityRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciCmdOnLogicalLinkCancelFailed(uint8_t status, const void *param)
@@ -503,12 +348,7 @@ static void HciCmdOnLogicalLinkCancelFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->logicalLinkCancelComplete != NULL) {
-        callbacks->logicalLinkCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(logicalLinkCancelComplete, &returnParam);
 }
 
 static void HciCmdOnUserConfirmationRequestNegativeReplyFailed(uint8_t status, const void *param)
@@ -518,12 +358,7 @@ static void HciCmdOnUserConfirmationRequestNegativeReplyFailed(uint8_t status, c
         .bdAddr = ((HciUserConfirmationRequestNegativeReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->userConfirmationRequestNegativeReplyComplete != NULL) {
-        callbacks->userConfirmationRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(userConfirmationRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciCmdOnEnhancedSetupSynchronousConnectionFailed(uint8_t status, const void *param)
@@ -537,12 +372,7 @@ static void HciCmdOnEnhancedSetupSynchronousConnectionFailed(uint8_t status, con
     };
     (void)memcpy_s(eventParam.bdAddr.raw, BT_ADDRESS_SIZE, addr.addr, BT_ADDRESS_SIZE);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->synchronousConnectionComplete != NULL) {
-        callbacks->synchronousConnectionComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(synchronousConnectionComplete, &eventParam);
 }
 
 static void HciCmdOnEnhancedAcceptSynchronousConnectionRequestFailed(uint8_t status, const void *param)
@@ -552,12 +382,7 @@ static void HciCmdOnEnhancedAcceptSynchronousConnectionRequestFailed(uint8_t sta
         .bdAddr = ((HciEnhancedAcceptSynchronousConnectionRequestParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->synchronousConnectionComplete != NULL) {
-        callbacks->synchronousConnectionComplete(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(synchronousConnectionComplete, &eventParam);
 }
 
 static void HciCmdOnRemoteOobExtendedDataRequestReplyFailed(uint8_t status, const void *param)
@@ -567,12 +392,7 @@ static void HciCmdOnRemoteOobExtendedDataRequestReplyFailed(uint8_t status, cons
         .bdAddr = ((HciRemoteOobExtendedDataRequestReplyParam *)param)->bdAddr,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->remoteOOBExtendedDataRequestReplyComplete != NULL) {
-        callbacks->remoteOOBExtendedDataRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(remoteOOBExtendedDataRequestReplyComplete, &returnParam);
 }
 
 static HciCmdOnFailedFunc g_funcMap[] = {
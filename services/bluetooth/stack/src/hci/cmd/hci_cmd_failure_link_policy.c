@@ -31,12 +31,7 @@ static void HciCmdOnSniffModeFailed(uint8_t status, const void *param)
         .connectionHandle = ((HciSniffModeParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->modeChange != NULL) {
-        callbacks->modeChange(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(modeChange, &eventParam);
 }
 
 static void HciCmdOnExitSnifModeFailed(uint8_t status, const void *param)
@@ -46,12 +41,7 @@ static void HciCmdOnExitSnifModeFailed(uint8_t status, const void *param)
         .connectionHandle = ((HciExitSniffModeParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->modeChange != NULL) {
-        callbacks->modeChange(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(modeChange, &eventParam);
 }
 
 static void HciCmdOnSniffSubratingFailed(uint8_t status, const void *param)
@@ -61,12 +51,7 @@ static void HciCmdOnSniffSubratingFailed(uint8_t status, const void *param)
         .connectionHandle = ((HciSniffSubratingParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->sniffSubratingComplete != NULL) {
-        callbacks->sniffSubratingComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(sniffSubratingComplete, &returnParam);
 }
 
 static void HciCmdOnWriteLinkPolicySettingsFailed(uint8_t status, const void *param)
@@ -76,12 +61,7 @@ static void HciCmdOnWriteLinkPolicySettingsFailed(uint8_t status, const void *pa
         .connectionHandle = ((HciWriteLinkPolicySettingsReturnParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeLinkPolicySettingsComplete != NULL) {
-        callbacks->writeLinkPolicySettingsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeLinkPolicySettingsComplete, &returnParam);
 }
 
 static void HciCmdOnWriteDefaultLinkPolicySettingsFailed(uint8_t status, const void *param)
@@ -90,12 +70,7 @@ static void HciCmdOnWriteDefaultLinkPolicySettingsFailed(uint8_t status, const v
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeDefaultLinkPolicySettingsComplete != NULL) {
-        callbacks->writeDefaultLinkPolicySettingsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeDefaultLinkPolicySettingsComplete, &returnParam);
 }
 
 static HciCmdOnFailedFunc g_funcMap[] = {
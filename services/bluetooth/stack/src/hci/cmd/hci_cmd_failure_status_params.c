@@ -31,12 +31,7 @@ static void HciCmdOnReadFailedContactCounterFailed(uint8_t status, const void *p
         .handle = ((HciReadFailedContactCounterReturnParam *)param)->handle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readFailedContactCounterComplete != NULL) {
-        callbacks->readFailedContactCounterComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readFailedContactCounterComplete, &returnParam);
 }
 
 static void HciCmdOnResetFailedContactCounterFailed(uint8_t status, const void *param)
@@ -46,12 +41,7 @@ static void HciCmdOnResetFailedContactCounterFailed(uint8_t status, const void *
         .handle = ((HciResetFailedContactCounterReturnParam *)param)->handle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->resetFailedContactCounterComplete != NULL) {
-        callbacks->resetFailedContactCounterComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(resetFailedContactCounterComplete, &returnParam);
 }
 
 static void HciCmdOnReadLinkQualityFailed(uint8_t status, const void *param)
@@ -61,12 +51,7 @@ static void HciCmdOnReadLinkQualityFailed(uint8_t status, const void *param)
         .handle = ((HciReadLinkQualityReturnParam *)param)->handle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLinkQualityComplete != NULL) {
-        callbacks->readLinkQualityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLinkQualityComplete, &returnParam);
 }
 
 static void HciCmdOnReadRssiFailed(uint8_t status, const void *param)
@@ -76,12 +61,7 @@ static void HciCmdOnReadRssiFailed(uint8_t status, const void *param)
         .handle = ((HciReadRssiParam *)param)->handle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readRssiComplete != NULL) {
-        callbacks->readRssiComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readRssiComplete, &returnParam);
 }
 
 static void HciCmdOnReadAfhChannelMapFailed(uint8_t status, const void *param)
@@ -91,12 +71,7 @@ static void HciCmdOnReadAfhChannelMapFailed(uint8_t status, const void *param)
         .connectionHandle = ((HciReadAfhChannelMapReturnParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readAfhChannelMapComplete != NULL) {
-        callbacks->readAfhChannelMapComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readAfhChannelMapComplete, &returnParam);
 }
 
 static void HciCmdOnReadClockFailed(uint8_t status, const void *param)
@@ -106,12 +81,7 @@ static void HciCmdOnReadClockFailed(uint8_t status, const void *param)
         .connectionHandle = ((HciReadClockReturnParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readClockComplete != NULL) {
-        callbacks->readClockComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readClockComplete, &returnParam);
 }
 
 static void HciCmdOnReadEncryptionKeySizeFailed(uint8_t status, const void *param)
@@ -121,12 +91,7 @@ static void HciCmdOnReadEncryptionKeySizeFailed(uint8_t status, const void *para
         .connectionHandle = ((HciReadEncryptionKeySizeReturnParam *)param)->connectionHandle,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readEncryptionKeySizeComplete != NULL) {
-        callbacks->readEncryptionKeySizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readEncryptionKeySizeComplete, &returnParam);
 }
 
 static void HciCmdOnReadLocalAmpInfoFailed(uint8_t status, const void *param)
@@ -135,12 +100,7 @@ static void HciCmdOnReadLocalAmpInfoFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalAmpInfoComplete != NULL) {
-        callbacks->readLocalAmpInfoComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalAmpInfoComplete, &returnParam);
 }
 
 static void HciCmdOnReadLocalAmpAssocFailed(uint8_t status, const void *param)
@@ -149,12 +109,7 @@ static void HciCmdOnReadLocalAmpAssocFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalAmpAssocComplete != NULL) {
-        callbacks->readLocalAmpAssocComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalAmpAssocComplete, &returnParam);
 }
 
 static void HciCmdOnWriteRemoteAmpAssocFailed(uint8_t status, const void *param)
@@ -163,12 +118,7 @@ static void HciCmdOnWriteRemoteAmpAssocFailed(uint8_t status, const void *param)
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeRemoteAmpAssocComplete != NULL) {
-        callbacks->writeRemoteAmpAssocComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeRemoteAmpAssocComplete, &returnParam);
 }
 
 static void HciCmdOnSetTriggeredClockCaptureFailed(uint8_t status, const void *param)
@@ -177,12 +127,7 @@ static void HciCmdOnSetTriggeredClockCaptureFailed(uint8_t status, const void *p
         .status = status,
     };
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setTriggeredClockCaptureComplete != NULL) {
-        callbacks->setTriggeredClockCaptureComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setTriggeredClockCaptureComplete, &returnParam);
 }
 
 static HciCmdOnFailedFunc g_funcMap[] = {
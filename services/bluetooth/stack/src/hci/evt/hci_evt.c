@@ -15,6 +15,10 @@
 
 #include "hci_evt.h"
 
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+
 #include <securec.h>
 
 #include "btstack.h"
@@ -29,6 +33,7 @@
 
 #include "hci_evt_cmd_complete.h"
 #include "hci_evt_le.h"
+#include "hci_evt_statistics.h"
 
 #define COD_SIZE 3
 
@@ -41,17 +46,51 @@ typedef struct {
 
 typedef void (*HciEventFunc)(Packet *packet);
 
+#define NS_PER_SECOND 1000000000ULL
+#define NS_PER_MICROSECOND 1000ULL
+
+// Registered HciEventCallbacks in registration order. Only touched by register/deregister under the lock.
 static List *g_eventCallbackList = NULL;
 static Mutex *g_lockCallbackList = NULL;
+// Snapshot read lock-free by the dispatch path.
+static _Atomic(HciEventSubscriberTable *) g_subscriberTable = NULL;
+// Superseded snapshots in retirement order. A dispatch may still be walking one, so each is kept until a
+// HciWaitForDispatches() that started after its retirement has returned. Counters are guarded by the lock.
+static List *g_retiredSubscriberTables = NULL;
+static uint64_t g_retiredCount = 0;
+static uint64_t g_reclaimedCount = 0;
+// Never published table with room for every published subscriber, so that a deregistration never needs memory.
+static HciEventSubscriberTable *g_spareSubscriberTable = NULL;
+static size_t g_spareSubscriberCount = 0;
+
+// Dispatches in progress on each side of the epoch. A deregistration waits for both sides to drain, flipping the
+// epoch first so that new dispatches go to the other side, so that no dispatch that loaded the previous table is
+// still running when it returns.
+static _Atomic uint32_t g_dispatchEpoch = 0;
+static _Atomic uint32_t g_activeDispatches[2] = {0};
+// Dispatches of the calling thread, which a deregistration from within an event callback cannot wait for.
+static _Thread_local uint32_t g_ownDispatches[2] = {0};
 
 void HciInitEvent()
 {
     g_eventCallbackList = ListCreate(NULL);
+    g_retiredSubscriberTables = ListCreate(NULL);
     g_lockCallbackList = MutexCreate();
+    atomic_store_explicit(&g_subscriberTable, NULL, memory_order_release);
+    HCI_ResetEventStatistics();
 }
 
 void HciCloseEvent()
 {
+    HciEventSubscriberTable *table = atomic_exchange_explicit(&g_subscriberTable, NULL, memory_order_acq_rel);
+    if (table != NULL) {
+        MEM_MALLOC.free(table);
+    }
+
+    MEM_MALLOC.free(g_spareSubscriberTable);
+    g_spareSubscriberTable = NULL;
+    g_spareSubscriberCount = 0;
+
     if (g_lockCallbackList != NULL) {
         MutexDelete(g_lockCallbackList);
         g_lockCallbackList = NULL;
@@ -61,6 +100,18 @@ void HciCloseEvent()
         ListDelete(g_eventCallbackList);
         g_eventCallbackList = NULL;
     }
+
+    if (g_retiredSubscriberTables != NULL) {
+        ListNode *node = ListGetFirstNode(g_retiredSubscriberTables);
+        while (node != NULL) {
+            MEM_MALLOC.free(ListGetNodeData(node));
+            node = ListGetNextNode(node);
+        }
+        ListDelete(g_retiredSubscriberTables);
+        g_retiredSubscriberTables = NULL;
+    }
+    g_retiredCount = 0;
+    g_reclaimedCount = 0;
 }
 
 static void HciEventOnInquiryCompleteEvent(Packet *packet)
@@ -74,12 +125,7 @@ static void HciEventOnInquiryCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->inquiryComplete != NULL) {
-        callbacks->inquiryComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(inquiryComplete, param);
 }
 
 static void HciEventOnInquiryResultEvent(Packet *packet)
@@ -131,12 +177,7 @@ static void HciEventOnInquiryResultEvent(Packet *packet)
         eventParam.responses = responses;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->inquiryResult != NULL) {
-        callbacks->inquiryResult(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(inquiryResult, &eventParam);
 
     if (responses != NULL) {
         MEM_MALLOC.free(responses);
@@ -163,12 +204,7 @@ static void HciEventOnCommandStatusEvent(Packet *packet)
     HciSetNumberOfHciCmd(param->numHciCommandPackets);
     HciCmdOnCommandStatus(param->commandOpcode, param->status);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->commandStatus != NULL) {
-        callbacks->commandStatus(param->status, param->commandOpcode);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(commandStatus, param->status, param->commandOpcode);
 }
 
 static void HciEventOnConnectionCompleteEvent(Packet *packet)
@@ -190,12 +226,7 @@ static void HciEventOnConnectionCompleteEvent(Packet *packet)
         HciAclOnConnectionComplete(param->connectionHandle, TRANSPORT_BREDR);
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->connectionComplete != NULL) {
-        callbacks->connectionComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(connectionComplete, param);
 }
 
 static void HciEventOnConnectionRequestEvent(Packet *packet)
@@ -213,12 +244,7 @@ static void HciEventOnConnectionRequestEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->connectionRequest != NULL) {
-        callbacks->connectionRequest(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(connectionRequest, param);
 }
 
 static void HciEventOnRemoteNameRequestCompleteEvent(Packet *packet)
@@ -236,12 +262,7 @@ static void HciEventOnRemoteNameRequestCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->remoteNameRequestComplete != NULL) {
-        callbacks->remoteNameRequestComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(remoteNameRequestComplete, param);
 }
 
 static void HciEventOnEncryptionChangeEvent(Packet *packet)
@@ -259,12 +280,7 @@ static void HciEventOnEncryptionChangeEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->encryptionChange != NULL) {
-        callbacks->encryptionChange(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(encryptionChange, param);
 }
 
 static void HciEventOnReadRemoteSupportedFeaturesCompleteEvent(Packet *packet)
@@ -283,12 +299,7 @@ static void HciEventOnReadRemoteSupportedFeaturesCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readRemoteSupportedFeaturesComplete != NULL) {
-        callbacks->readRemoteSupportedFeaturesComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readRemoteSupportedFeaturesComplete, param);
 }
 
 static void HciEventOnReadRemoteVersionInformationCompleteEvent(Packet *packet)
@@ -307,12 +318,7 @@ static void HciEventOnReadRemoteVersionInformationCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readRemoteVersionInformationComplete != NULL) {
-        callbacks->readRemoteVersionInformationComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readRemoteVersionInformationComplete, param);
 }
 
 static void HciEventOnRemoteHostSupportedFeaturesNotificationEvent(Packet *packet)
@@ -331,12 +337,7 @@ static void HciEventOnRemoteHostSupportedFeaturesNotificationEvent(Packet *packe
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->remoteHostSupportedFeaturesNotification != NULL) {
-        callbacks->remoteHostSupportedFeaturesNotification(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(remoteHostSupportedFeaturesNotification, param);
 }
 
 static void HciEventOnNumberOfCompletedPacketsEvent(Packet *packet)
@@ -394,12 +395,7 @@ static void HciEventOnModeChangeEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->modeChange != NULL) {
-        callbacks->modeChange(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(modeChange, param);
 }
 
 static void HciEventOnPINCodeRequestEvent(Packet *packet)
@@ -418,12 +414,7 @@ static void HciEventOnPINCodeRequestEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->pinCodeRequest != NULL) {
-        callbacks->pinCodeRequest(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(pinCodeRequest, param);
 }
 
 static void HciEventOnLinkKeyRequestEvent(Packet *packet)
@@ -441,12 +432,7 @@ static void HciEventOnLinkKeyRequestEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->linkKeyRequest != NULL) {
-        callbacks->linkKeyRequest(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(linkKeyRequest, param);
 }
 
 static void HciEventOnLinkKeyNotificationEvent(Packet *packet)
@@ -464,12 +450,7 @@ static void HciEventOnLinkKeyNotificationEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->linkKeyNotification != NULL) {
-        callbacks->linkKeyNotification(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(linkKeyNotification, param);
 }
 
 static void HciEventOnSynchronousConnectionCompleteEvent(Packet *packet)
@@ -488,12 +469,7 @@ static void HciEventOnSynchronousConnectionCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->synchronousConnectionComplete != NULL) {
-        callbacks->synchronousConnectionComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(synchronousConnectionComplete, param);
 }
 
 static void HciEventOnSynchronousConnectionChangedEvent(Packet *packet)
@@ -512,12 +488,7 @@ static void HciEventOnSynchronousConnectionChangedEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->synchronousConnectionChanged != NULL) {
-        callbacks->synchronousConnectionChanged(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(synchronousConnectionChanged, param);
 }
 
 static void HciEventOnDisconnectCompeteEvent(Packet *packet)
@@ -539,12 +510,7 @@ static void HciEventOnDisconnectCompeteEvent(Packet *packet)
         HciAclOnDisconnectComplete(param->connectionHandle);
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->disconnectComplete != NULL) {
-        callbacks->disconnectComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(disconnectComplete, param);
 }
 
 static void HciEventOnAuthencationCompleteEvent(Packet *packet)
@@ -562,12 +528,7 @@ static void HciEventOnAuthencationCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->authenticationComplete != NULL) {
-        callbacks->authenticationComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(authenticationComplete, param);
 }
 
 static void HciEventOnInquiryResultWithRSSIEvent(Packet *packet)
@@ -619,12 +580,7 @@ static void HciEventOnInquiryResultWithRSSIEvent(Packet *packet)
         eventParam.responses = responses;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->inquiryResultWithRSSI != NULL) {
-        callbacks->inquiryResultWithRSSI(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(inquiryResultWithRSSI, &eventParam);
 
     if (responses != NULL) {
         MEM_MALLOC.free(responses);
@@ -647,12 +603,7 @@ static void HciEventOnReadRemoteExtendedFeaturesCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readRemoteExtendedFeaturesComplete != NULL) {
-        callbacks->readRemoteExtendedFeaturesComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readRemoteExtendedFeaturesComplete, param);
 }
 
 static void HciEventOnExtendedInquiryResultEvent(Packet *packet)
@@ -671,12 +622,7 @@ static void HciEventOnExtendedInquiryResultEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->extendedInquiryResult != NULL) {
-        callbacks->extendedInquiryResult(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(extendedInquiryResult, param);
 }
 
 static void HciEventOnEncryptionKeyRefreshCompleteEvent(Packet *packet)
@@ -696,12 +642,7 @@ static void HciEventOnEncryptionKeyRefreshCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->encryptionKeyRefreshComplete != NULL) {
-        callbacks->encryptionKeyRefreshComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(encryptionKeyRefreshComplete, param);
 }
 
 static void HciEventOnIOCapabilityRequestEvent(Packet *packet)
@@ -720,12 +661,7 @@ static void HciEventOnIOCapabilityRequestEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->ioCapabilityRequest != NULL) {
-        callbacks->ioCapabilityRequest(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(ioCapabilityRequest, param);
 }
 
 static void HciEventOnIOCapabilityResponseEvent(Packet *packet)
@@ -744,12 +680,7 @@ static void HciEventOnIOCapabilityResponseEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->ioCapabilityResponse != NULL) {
-        callbacks->ioCapabilityResponse(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(ioCapabilityResponse, param);
 }
 
 static void HciEventOnUserConfirmationRequestEvent(Packet *packet)
@@ -768,12 +699,7 @@ static void HciEventOnUserConfirmationRequestEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->userConfirmationRequest != NULL) {
-        callbacks->userConfirmationRequest(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(userConfirmationRequest, param);
 }
 
 static void HciEventOnUserPasskeyRequestEvent(Packet *packet)
@@ -792,12 +718,7 @@ static void HciEventOnUserPasskeyRequestEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->userPasskeyRequest != NULL) {
-        callbacks->userPasskeyRequest(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(userPasskeyRequest, param);
 }
 
 static void HciEventOnRemoteOOBDataRequestEvent(Packet *packet)
@@ -816,12 +737,7 @@ static void HciEventOnRemoteOOBDataRequestEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->remoteOOBDataRequest != NULL) {
-        callbacks->remoteOOBDataRequest(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(remoteOOBDataRequest, param);
 }
 
 static void HciEventOnSimplePairingCompleteEvent(Packet *packet)
@@ -840,12 +756,7 @@ static void HciEventOnSimplePairingCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->simplePairingComplete != NULL) {
-        callbacks->simplePairingComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(simplePairingComplete, param);
 }
 
 static void HciEventOnUserPasskeyNotificationEvent(Packet *packet)
@@ -864,12 +775,7 @@ static void HciEventOnUserPasskeyNotificationEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->userPasskeyNotification != NULL) {
-        callbacks->userPasskeyNotification(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(userPasskeyNotification, param);
 }
 
 static void HciEventOnKeypressNotificationEvent(Packet *packet)
@@ -888,12 +794,7 @@ static void HciEventOnKeypressNotificationEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->keypressNotification != NULL) {
-        callbacks->keypressNotification(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(keypressNotification, param);
 }
 
 static void HciEventOnAuthenticatedPayloadTimeoutExpiredEvent(Packet *packet)
@@ -912,12 +813,7 @@ static void HciEventOnAuthenticatedPayloadTimeoutExpiredEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->authenticatedPayloadTimeoutExpired != NULL) {
-        callbacks->authenticatedPayloadTimeoutExpired(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(authenticatedPayloadTimeoutExpired, param);
 }
 
 static void HciEventOnChangeConnectionLinkKeyCompleteEvent(Packet *packet)
@@ -937,12 +833,7 @@ static void HciEventOnChangeConnectionLinkKeyCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->changeConnectionLinkKeyComplete != NULL) {
-        callbacks->changeConnectionLinkKeyComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(changeConnectionLinkKeyComplete, param);
 }
 
 static void HciEventOnMasterLinkKeyCompleteEvent(Packet *packet)
@@ -961,12 +852,7 @@ static void HciEventOnMasterLinkKeyCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->masterLinkKeyComplete != NULL) {
-        callbacks->masterLinkKeyComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(masterLinkKeyComplete, param);
 }
 
 static void HciEventOnQoSSetupCompleteEvent(Packet *packet)
@@ -985,12 +871,7 @@ static void HciEventOnQoSSetupCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->qosSetupComplete != NULL) {
-        callbacks->qosSetupComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(qosSetupComplete, param);
 }
 
 static void HciEventOnHardwareErrorEvent(Packet *packet)
@@ -1009,12 +890,7 @@ static void HciEventOnHardwareErrorEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->hardwareError != NULL) {
-        callbacks->hardwareError(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(hardwareError, param);
 }
 
 static void HciEventOnFlushOccurredEvent(Packet *packet)
@@ -1033,12 +909,7 @@ static void HciEventOnFlushOccurredEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->flushOccurred != NULL) {
-        callbacks->flushOccurred(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(flushOccurred, param);
 }
 
 static void HciEventOnRoleChangeEvent(Packet *packet)
@@ -1057,12 +928,7 @@ static void HciEventOnRoleChangeEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->roleChange != NULL) {
-        callbacks->roleChange(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(roleChange, param);
 }
 
 static void HciEventOnReturnLinkKeysEvent(Packet *packet)
@@ -1081,12 +947,7 @@ static void HciEventOnReturnLinkKeysEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->returnLinkKeys != NULL) {
-        callbacks->returnLinkKeys(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(returnLinkKeys, param);
 }
 
 static void HciEventOnDataBufferOverflowEvent(Packet *packet)
@@ -1105,12 +966,7 @@ static void HciEventOnDataBufferOverflowEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->dataBufferOverflow != NULL) {
-        callbacks->dataBufferOverflow(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(dataBufferOverflow, param);
 }
 
 static void HciEventOnMaxSlotsChangeEvent(Packet *packet)
@@ -1129,12 +985,7 @@ static void HciEventOnMaxSlotsChangeEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->maxSlotsChange != NULL) {
-        callbacks->maxSlotsChange(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(maxSlotsChange, param);
 }
 
 static void HciEventOnReadClockOffsetCompleteEvent(Packet *packet)
@@ -1153,12 +1004,7 @@ static void HciEventOnReadClockOffsetCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readClockOffsetComplete != NULL) {
-        callbacks->readClockOffsetComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readClockOffsetComplete, param);
 }
 
 static void HciEventOnConnectionPacketTypeChangedEvent(Packet *packet)
@@ -1178,12 +1024,7 @@ static void HciEventOnConnectionPacketTypeChangedEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->connectionPacketTypeChanged != NULL) {
-        callbacks->connectionPacketTypeChanged(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(connectionPacketTypeChanged, param);
 }
 
 static void HciEventOnQoSViolationEvent(Packet *packet)
@@ -1202,12 +1043,7 @@ static void HciEventOnQoSViolationEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->qoSViolation != NULL) {
-        callbacks->qoSViolation(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(qoSViolation, param);
 }
 
 static void HciEventOnPageScanRepetitionModeChangeEvent(Packet *packet)
@@ -1227,12 +1063,7 @@ static void HciEventOnPageScanRepetitionModeChangeEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->pageScanRepetitionModeChange != NULL) {
-        callbacks->pageScanRepetitionModeChange(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(pageScanRepetitionModeChange, param);
 }
 
 static void HciEventOnFlowSpecificationCompleteEvent(Packet *packet)
@@ -1251,12 +1082,7 @@ static void HciEventOnFlowSpecificationCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->flowSpecificationComplete != NULL) {
-        callbacks->flowSpecificationComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(flowSpecificationComplete, param);
 }
 
 static void HciEventOnSniffSubratingEvent(Packet *packet)
@@ -1275,12 +1101,7 @@ static void HciEventOnSniffSubratingEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->sniffSubrating != NULL) {
-        callbacks->sniffSubrating(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(sniffSubrating, param);
 }
 
 static void HciEventOnLinkSupervisionTimeoutChangedEvent(Packet *packet)
@@ -1300,12 +1121,7 @@ static void HciEventOnLinkSupervisionTimeoutChangedEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->linkSupervisionTimeoutChanged != NULL) {
-        callbacks->linkSupervisionTimeoutChanged(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(linkSupervisionTimeoutChanged, param);
 }
 
 static void HciEventOnEnhancedFlushCompleteEvent(Packet *packet)
@@ -1324,12 +1140,7 @@ static void HciEventOnEnhancedFlushCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->enhancedFlushComplete != NULL) {
-        callbacks->enhancedFlushComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(enhancedFlushComplete, param);
 }
 
 static void HciEventOnPhysicalLinkCompleteEvent(Packet *packet)
@@ -1348,12 +1159,7 @@ static void HciEventOnPhysicalLinkCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->physicalLinkComplete != NULL) {
-        callbacks->physicalLinkComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(physicalLinkComplete, param);
 }
 
 static void HciEventOnChannelSelectedEvent(Packet *packet)
@@ -1372,12 +1178,7 @@ static void HciEventOnChannelSelectedEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->channelSelected != NULL) {
-        callbacks->channelSelected(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(channelSelected, param);
 }
 
 static void HciEventOnDisconnectionPhysicalLinkCompleteEvent(Packet *packet)
@@ -1397,12 +1198,7 @@ static void HciEventOnDisconnectionPhysicalLinkCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->disconnectionPhysicalLinkComplete != NULL) {
-        callbacks->disconnectionPhysicalLinkComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(disconnectionPhysicalLinkComplete, param);
 }
 
 static void HciEventOnPhysicalLinkLossEarlyWarningEvent(Packet *packet)
@@ -1422,12 +1218,7 @@ static void HciEventOnPhysicalLinkLossEarlyWarningEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->physicalLinkLossEarlyWarning != NULL) {
-        callbacks->physicalLinkLossEarlyWarning(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(physicalLinkLossEarlyWarning, param);
 }
 
 static void HciEventOnPhysicalLinkRecoveryEvent(Packet *packet)
@@ -1446,12 +1237,7 @@ static void HciEventOnPhysicalLinkRecoveryEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->physicalLinkRecovery != NULL) {
-        callbacks->physicalLinkRecovery(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(physicalLinkRecovery, param);
 }
 
 static void HciEventOnLogicalLinkCompleteEvent(Packet *packet)
@@ -1470,12 +1256,7 @@ static void HciEventOnLogicalLinkCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->logicalLinkComplete != NULL) {
-        callbacks->logicalLinkComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(logicalLinkComplete, param);
 }
 
 static void HciEventOnDisconnectionLogicalLinkCompleteEvent(Packet *packet)
@@ -1495,12 +1276,7 @@ static void HciEventOnDisconnectionLogicalLinkCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->disconnectionLogicalLinkComplete != NULL) {
-        callbacks->disconnectionLogicalLinkComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(disconnectionLogicalLinkComplete, param);
 }
 
 static void HciEventOnFlowSpecModifyCompleteEvent(Packet *packet)
@@ -1519,12 +1295,7 @@ static void HciEventOnFlowSpecModifyCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->flowSpecModifyComplete != NULL) {
-        callbacks->flowSpecModifyComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(flowSpecModifyComplete, param);
 }
 
 static void HciEventOnNumberOfCompletedDataBlocksEvent(Packet *packet)
@@ -1544,12 +1315,7 @@ static void HciEventOnNumberOfCompletedDataBlocksEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->numberOfCompletedDataBlocks != NULL) {
-        callbacks->numberOfCompletedDataBlocks(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(numberOfCompletedDataBlocks, param);
 }
 
 static void HciEventOnShortRangeModeChangeCompleteEvent(Packet *packet)
@@ -1569,12 +1335,7 @@ static void HciEventOnShortRangeModeChangeCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->shortRangeModeChangeComplete != NULL) {
-        callbacks->shortRangeModeChangeComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(shortRangeModeChangeComplete, param);
 }
 
 static void HciEventOnAMPStatusChangeEvent(Packet *packet)
@@ -1593,12 +1354,7 @@ static void HciEventOnAMPStatusChangeEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->ampStatusChange != NULL) {
-        callbacks->ampStatusChange(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(ampStatusChange, param);
 }
 
 static void HciEventOnAMPStartTestEvent(Packet *packet)
@@ -1617,12 +1373,7 @@ static void HciEventOnAMPStartTestEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->ampStartTest != NULL) {
-        callbacks->ampStartTest(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(ampStartTest, param);
 }
 
 static void HciEventOnAMPTestEndEvent(Packet *packet)
@@ -1641,12 +1392,7 @@ static void HciEventOnAMPTestEndEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->ampTestEnd != NULL) {
-        callbacks->ampTestEnd(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(ampTestEnd, param);
 }
 
 static void HciEventOnAMPReceiverReportEvent(Packet *packet)
@@ -1665,12 +1411,7 @@ static void HciEventOnAMPReceiverReportEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->ampReceiverReport != NULL) {
-        callbacks->ampReceiverReport(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(ampReceiverReport, param);
 }
 
 static void HciEventOnTriggeredClockCaptureEvent(Packet *packet)
@@ -1689,12 +1430,7 @@ static void HciEventOnTriggeredClockCaptureEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->triggeredClockCapture != NULL) {
-        callbacks->triggeredClockCapture(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(triggeredClockCapture, param);
 }
 
 static void HciEventOnSynchronizationTrainCompleteEvent(Packet *packet)
@@ -1714,12 +1450,7 @@ static void HciEventOnSynchronizationTrainCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->synchronizationTrainComplete != NULL) {
-        callbacks->synchronizationTrainComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(synchronizationTrainComplete, param);
 }
 
 static void HciEventOnSynchronizationTrainReceivedEvent(Packet *packet)
@@ -1739,12 +1470,7 @@ static void HciEventOnSynchronizationTrainReceivedEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->synchronizationTrainReceived != NULL) {
-        callbacks->synchronizationTrainReceived(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(synchronizationTrainReceived, param);
 }
 
 static void HciEventOnConnectionlessSlaveBroadcastReceiveEvent(Packet *packet)
@@ -1764,12 +1490,7 @@ static void HciEventOnConnectionlessSlaveBroadcastReceiveEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->connectionlessSlaveBroadcastReceive != NULL) {
-        callbacks->connectionlessSlaveBroadcastReceive(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(connectionlessSlaveBroadcastReceive, param);
 }
 
 static void HciEventOnConnectionlessSlaveBroadcastTimeoutEvent(Packet *packet)
@@ -1789,12 +1510,7 @@ static void HciEventOnConnectionlessSlaveBroadcastTimeoutEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->connectionlessSlaveBroadcastTimeout != NULL) {
-        callbacks->connectionlessSlaveBroadcastTimeout(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(connectionlessSlaveBroadcastTimeout, param);
 }
 
 static void HciEventOnTruncatedPageCompleteEvent(Packet *packet)
@@ -1813,12 +1529,7 @@ static void HciEventOnTruncatedPageCompleteEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->truncatedPageComplete != NULL) {
-        callbacks->truncatedPageComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(truncatedPageComplete, param);
 }
 
 static void HciEventOnConnectionlessSlaveBroadcastChannelMapChangeEvent(Packet *packet)
@@ -1838,12 +1549,7 @@ static void HciEventOnConnectionlessSlaveBroadcastChannelMapChangeEvent(Packet *
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->connectionlessSlaveBroadcastChannelMapChange != NULL) {
-        callbacks->connectionlessSlaveBroadcastChannelMapChange(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(connectionlessSlaveBroadcastChannelMapChange, param);
 }
 
 static void HciEventOnInquiryResponseNotificationEvent(Packet *packet)
@@ -1863,12 +1569,7 @@ static void HciEventOnInquiryResponseNotificationEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->inquiryResponseNotification != NULL) {
-        callbacks->inquiryResponseNotification(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(inquiryResponseNotification, param);
 }
 
 static void HciEventOnSAMStatusChangeEvent(Packet *packet)
@@ -1887,12 +1588,7 @@ static void HciEventOnSAMStatusChangeEvent(Packet *packet)
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->samStatusChange != NULL) {
-        callbacks->samStatusChange(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(samStatusChange, param);
 }
 
 static HciEventFunc g_eventFuncMap[] = {
@@ -1989,6 +1685,55 @@ static HciEventFunc g_eventFuncMap[] = {
 
 #define EVENTCODE_MAX 0x58
 
+static HciEventStatisticsCounters g_eventStatistics[EVENTCODE_MAX + 1];
+
+uint64_t HciEventGetTimestamp()
+{
+    struct timespec ts = {0};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NS_PER_SECOND + (uint64_t)ts.tv_nsec;
+}
+
+void HciEventUpdateStatistics(HciEventStatisticsCounters *counters, uint64_t beginNs)
+{
+    uint64_t elapsedNs = HciEventGetTimestamp() - beginNs;
+    atomic_fetch_add_explicit(&counters->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&counters->totalNs, elapsedNs, memory_order_relaxed);
+    uint_fast64_t maxNs = atomic_load_explicit(&counters->maxNs, memory_order_relaxed);
+    while (elapsedNs > maxNs && !atomic_compare_exchange_weak_explicit(
+        &counters->maxNs, &maxNs, elapsedNs, memory_order_relaxed, memory_order_relaxed)) {
+    }
+
+    uint64_t elapsedUs = elapsedNs / NS_PER_MICROSECOND;
+    uint8_t bucket = 0;
+    while (bucket < (HCI_EVENT_LATENCY_BUCKETS - 1) && elapsedUs >= (1ULL << bucket)) {
+        bucket++;
+    }
+    atomic_fetch_add_explicit(&counters->latencyHistogram[bucket], 1, memory_order_relaxed);
+}
+
+void HciEventLoadStatistics(const HciEventStatisticsCounters *counters, HciEventStatistics *statistics)
+{
+    statistics->count = atomic_load_explicit(&counters->count, memory_order_relaxed);
+    statistics->totalNs = atomic_load_explicit(&counters->totalNs, memory_order_relaxed);
+    statistics->maxNs = atomic_load_explicit(&counters->maxNs, memory_order_relaxed);
+    for (size_t i = 0; i < HCI_EVENT_LATENCY_BUCKETS; i++) {
+        statistics->latencyHistogram[i] = atomic_load_explicit(&counters->latencyHistogram[i], memory_order_relaxed);
+    }
+}
+
+void HciEventResetStatistics(HciEventStatisticsCounters *counters, size_t num)
+{
+    for (size_t n = 0; n < num; n++) {
+        atomic_store_explicit(&counters[n].count, 0, memory_order_relaxed);
+        atomic_store_explicit(&counters[n].totalNs, 0, memory_order_relaxed);
+        atomic_store_explicit(&counters[n].maxNs, 0, memory_order_relaxed);
+        for (size_t i = 0; i < HCI_EVENT_LATENCY_BUCKETS; i++) {
+            atomic_store_explicit(&counters[n].latencyHistogram[i], 0, memory_order_relaxed);
+        }
+    }
+}
+
 void HciOnEvent(Packet *packet)
 {
     HciEventHeader header;
@@ -2001,9 +1746,123 @@ void HciOnEvent(Packet *packet)
 
         HciEventFunc func = g_eventFuncMap[header.eventCode];
         if (func != NULL) {
+            uint64_t beginNs = HciEventGetTimestamp();
             func(packet);
+            HciEventUpdateStatistics(&g_eventStatistics[header.eventCode], beginNs);
+        }
+    }
+}
+
+static bool HciEventCallbacksHasSlot(const HciEventCallbacks *callbacks, size_t slot)
+{
+    HciEventCallbackSlot func = NULL;
+    (void)memcpy_s(&func, sizeof(func), (const uint8_t *)callbacks + slot * sizeof(HciEventCallbackSlot),
+        sizeof(HciEventCallbackSlot));
+    return func != NULL;
+}
+
+// Counts the subscriptions of g_eventCallbackList. Called with g_lockCallbackList held.
+static size_t HciCountSubscribers()
+{
+    size_t total = 0;
+    ListNode *node = ListGetFirstNode(g_eventCallbackList);
+    while (node != NULL) {
+        const HciEventCallbacks *callbacks = ListGetNodeData(node);
+        for (size_t slot = 0; slot < HCI_EVENT_CALLBACK_SLOTS; slot++) {
+            total += HciEventCallbacksHasSlot(callbacks, slot) ? 1 : 0;
+        }
+        node = ListGetNextNode(node);
+    }
+    return total;
+}
+
+static HciEventSubscriberTable *HciAllocSubscriberTable(size_t total)
+{
+    if (total > UINT16_MAX) {
+        return NULL;
+    }
+    return MEM_MALLOC.alloc(sizeof(HciEventSubscriberTable) + total * sizeof(const HciEventCallbacks *));
+}
+
+// Fills the per-member subscriber table from g_eventCallbackList and publishes it. The table must have room for
+// HciCountSubscribers() entries. The superseded table is queued in g_retiredSubscriberTables.
+// Called with g_lockCallbackList held.
+static void HciPublishSubscriberTable(HciEventSubscriberTable *table)
+{
+    uint16_t index = 0;
+    for (size_t slot = 0; slot < HCI_EVENT_CALLBACK_SLOTS; slot++) {
+        table->begin[slot] = index;
+        ListNode *node = ListGetFirstNode(g_eventCallbackList);
+        while (node != NULL) {
+            const HciEventCallbacks *callbacks = ListGetNodeData(node);
+            if (HciEventCallbacksHasSlot(callbacks, slot)) {
+                table->subscribers[index++] = callbacks;
+            }
+            node = ListGetNextNode(node);
         }
     }
+    table->begin[HCI_EVENT_CALLBACK_SLOTS] = index;
+
+    HciEventSubscriberTable *previous = atomic_exchange(&g_subscriberTable, table);
+    if (previous != NULL) {
+        ListAddLast(g_retiredSubscriberTables, previous);
+        g_retiredCount++;
+    }
+}
+
+// Returns once every dispatch that may have loaded a table published before the call has finished, except those
+// of the calling thread. Holds no lock, so event callbacks may deregister on the dispatching thread.
+static void HciWaitForDispatchSide(uint32_t side)
+{
+    while (atomic_load(&g_activeDispatches[side]) > g_ownDispatches[side]) {
+        sched_yield();
+    }
+}
+
+static void HciWaitForDispatches()
+{
+    uint32_t side = atomic_fetch_add(&g_dispatchEpoch, 1) & 0x01;
+    HciWaitForDispatchSide(side);
+    (void)atomic_fetch_add(&g_dispatchEpoch, 1);
+    HciWaitForDispatchSide(side ^ 0x01);
+}
+
+// Releases the tables retired before the retiredCount-th one, once a HciWaitForDispatches() started after that
+// retirement has returned. The first one that fits the subscribers stands in as the spare if there is none. A
+// caller inside an event callback may itself be walking any of them and leaves them to a later call.
+// Called with g_lockCallbackList held.
+static void HciReclaimRetiredTables(uint64_t retiredCount)
+{
+    if ((g_ownDispatches[0] != 0) || (g_ownDispatches[1] != 0)) {
+        return;
+    }
+    size_t total = HciCountSubscribers();
+    while (g_reclaimedCount < retiredCount) {
+        HciEventSubscriberTable *table = ListGetNodeData(ListGetFirstNode(g_retiredSubscriberTables));
+        ListRemoveFirst(g_retiredSubscriberTables);
+        g_reclaimedCount++;
+        if ((g_spareSubscriberTable == NULL) && (table->begin[HCI_EVENT_CALLBACK_SLOTS] >= total)) {
+            g_spareSubscriberTable = table;
+            g_spareSubscriberCount = table->begin[HCI_EVENT_CALLBACK_SLOTS];
+        } else {
+            MEM_MALLOC.free(table);
+        }
+    }
+}
+
+uint8_t HciEventDispatchBegin(const HciEventSubscriberTable **table)
+{
+    uint8_t side = (uint8_t)(atomic_load(&g_dispatchEpoch) & 0x01);
+    atomic_fetch_add(&g_activeDispatches[side], 1);
+    g_ownDispatches[side]++;
+    *table = atomic_load(&g_subscriberTable);
+    return side;
+}
+
+void HciEventDispatchEnd(uint8_t reader)
+{
+    g_ownDispatches[reader]--;
+    atomic_fetch_sub(&g_activeDispatches[reader], 1);
 }
 
 int HCI_RegisterEventCallbacks(const HciEventCallbacks *callbacks)
@@ -2011,7 +1870,34 @@ int HCI_RegisterEventCallbacks(const HciEventCallbacks *callbacks)
     MutexLock(g_lockCallbackList);
 
     ListAddLast(g_eventCallbackList, (void *)callbacks);
+    size_t total = HciCountSubscribers();
+    HciEventSubscriberTable *table = HciAllocSubscriberTable(total);
+    if ((table != NULL) && (total > g_spareSubscriberCount)) {
+        HciEventSubscriberTable *spare = HciAllocSubscriberTable(total);
+        if (spare == NULL) {
+            MEM_MALLOC.free(table);
+            table = NULL;
+        } else {
+            MEM_MALLOC.free(g_spareSubscriberTable);
+            g_spareSubscriberTable = spare;
+            g_spareSubscriberCount = total;
+        }
+    }
 
+    if (table == NULL) {
+        ListRemoveNode(g_eventCallbackList, (void *)callbacks);
+        MutexUnlock(g_lockCallbackList);
+        return BT_NO_MEMORY;
+    }
+    HciPublishSubscriberTable(table);
+    uint64_t retiredCount = g_retiredCount;
+
+    MutexUnlock(g_lockCallbackList);
+
+    HciWaitForDispatches();
+
+    MutexLock(g_lockCallbackList);
+    HciReclaimRetiredTables(retiredCount);
     MutexUnlock(g_lockCallbackList);
     return BT_SUCCESS;
 }
@@ -2021,17 +1907,53 @@ int HCI_DeregisterEventCallbacks(const HciEventCallbacks *callbacks)
     MutexLock(g_lockCallbackList);
 
     ListRemoveNode(g_eventCallbackList, (void *)callbacks);
+    HciEventSubscriberTable *table = HciAllocSubscriberTable(HciCountSubscribers());
+    if (table == NULL) {
+        table = g_spareSubscriberTable;
+        g_spareSubscriberTable = NULL;
+        g_spareSubscriberCount = 0;
+    }
+    if (table == NULL) {
+        // Only when an earlier deregistration from within an event callback took the spare under the same shortage.
+        ListAddLast(g_eventCallbackList, (void *)callbacks);
+        MutexUnlock(g_lockCallbackList);
+        return BT_NO_MEMORY;
+    }
+    HciPublishSubscriberTable(table);
+    uint64_t retiredCount = g_retiredCount;
 
+    MutexUnlock(g_lockCallbackList);
+
+    HciWaitForDispatches();
+
+    MutexLock(g_lockCallbackList);
+    HciReclaimRetiredTables(retiredCount);
+    if (g_spareSubscriberTable == NULL) {
+        size_t total = HciCountSubscribers();
+        g_spareSubscriberTable = HciAllocSubscriberTable(total);
+        g_spareSubscriberCount = (g_spareSubscriberTable != NULL) ? total : 0;
+    }
     MutexUnlock(g_lockCallbackList);
     return BT_SUCCESS;
 }
 
-List *HciGetEventCallbackList()
+const HciEventSubscriberTable *HciGetEventSubscriberTable()
 {
-    return g_eventCallbackList;
+    return atomic_load_explicit(&g_subscriberTable, memory_order_acquire);
+}
+
+int HCI_GetEventStatistics(uint8_t eventCode, HciEventStatistics *statistics)
+{
+    if (eventCode > EVENTCODE_MAX || statistics == NULL) {
+        return BT_BAD_PARAM;
+    }
+
+    HciEventLoadStatistics(&g_eventStatistics[eventCode], statistics);
+    return BT_SUCCESS;
 }
 
-Mutex *HciGetEventCallbackListLock()
+void HCI_ResetEventStatistics()
 {
-    return g_lockCallbackList;
+    HciEventResetStatistics(g_eventStatistics, EVENTCODE_MAX + 1);
+    HciEventResetLeStatistics();
 }
@@ -16,26 +16,42 @@
 #ifndef HCI_EVT_H
 #define HCI_EVT_H
 
+#include <stddef.h>
+
 #include "packet.h"
-#include "platform/include/list.h"
-#include "platform/include/mutex.h"
+
+#include "hci/hci.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#define HCI_FOREACH_EVT_CALLBACKS_START(x)                         \
-    MutexLock(HciGetEventCallbackListLock());                      \
-    ListNode *node_ = ListGetFirstNode(HciGetEventCallbackList()); \
-    while (node_ != NULL) {                                        \
-        x = ListGetNodeData(node_);                                \
-        if ((x) != NULL) {
+// Every member of HciEventCallbacks is a function pointer, so a member is addressed by its slot index.
+typedef void (*HciEventCallbackSlot)(void);
+
+#define HCI_EVENT_CALLBACK_SLOTS (sizeof(HciEventCallbacks) / sizeof(HciEventCallbackSlot))
+#define HCI_EVENT_CALLBACK_SLOT(member) (offsetof(HciEventCallbacks, member) / sizeof(HciEventCallbackSlot))
+
+// Subscribers of slot i are subscribers[begin[i]] .. subscribers[begin[i + 1] - 1], in registration order.
+// A table is immutable once published. Deregistration publishes a new one and returns only once no dispatch walks
+// the old one any more; HciEventDispatchBegin/HciEventDispatchEnd bracket every dispatch for that purpose.
+typedef struct {
+    uint16_t begin[HCI_EVENT_CALLBACK_SLOTS + 1];
+    const HciEventCallbacks *subscribers[];
+} HciEventSubscriberTable;
 
-#define HCI_FOREACH_EVT_CALLBACKS_END \
-    }                                 \
-    node_ = ListGetNextNode(node_);   \
-    }                                 \
-    MutexUnlock(HciGetEventCallbackListLock());
+#define HCI_EVT_CALLBACKS_DISPATCH(member, ...)                                             \
+    do {                                                                                    \
+        const HciEventSubscriberTable *table_ = NULL;                                       \
+        const uint8_t reader_ = HciEventDispatchBegin(&table_);                             \
+        if (table_ != NULL) {                                                               \
+            const uint16_t slot_ = HCI_EVENT_CALLBACK_SLOT(member);                         \
+            for (uint16_t i_ = table_->begin[slot_]; i_ < table_->begin[slot_ + 1]; i_++) { \
+                table_->subscribers[i_]->member(__VA_ARGS__);                               \
+            }                                                                               \
+        }                                                                                   \
+        HciEventDispatchEnd(reader_);                                                       \
+    } while (0)
 
 void HciInitEvent();
 
@@ -43,8 +59,16 @@ void HciOnEvent(Packet *packet);
 
 void HciCloseEvent();
 
-List *HciGetEventCallbackList();
-Mutex *HciGetEventCallbackListLock();
+const HciEventSubscriberTable *HciGetEventSubscriberTable();
+
+/**
+ * @brief Loads the current subscriber table for a dispatch. Pair every call with HciEventDispatchEnd.
+ *
+ * @param table Receives the current table, NULL if nothing is registered.
+ * @return Token to pass to HciEventDispatchEnd.
+ */
+uint8_t HciEventDispatchBegin(const HciEventSubscriberTable **table);
+void HciEventDispatchEnd(uint8_t reader);
 
 #ifdef __cplusplus
 }
@@ -34,12 +34,7 @@ static void HciEventOnSetEventMaskCompete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setEventMaskComplete != NULL) {
-        callbacks->setEventMaskComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setEventMaskComplete, &returnParam);
 }
 
 static void HciEventOnResetComplete(const void *param, uint8_t length)
@@ -48,12 +43,7 @@ static void HciEventOnResetComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->resetComplete != NULL) {
-        callbacks->resetComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(resetComplete, &returnParam);
 }
 
 static void HciEventOnWriteLocalNameComplete(const void *param, uint8_t length)
@@ -62,12 +52,7 @@ static void HciEventOnWriteLocalNameComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeLocalNameComplete != NULL) {
-        callbacks->writeLocalNameComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeLocalNameComplete, &returnParam);
 }
 
 static void HciEventOnReadLocalNameComplete(const void *param, uint8_t length)
@@ -76,12 +61,7 @@ static void HciEventOnReadLocalNameComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalNameComplete != NULL) {
-        callbacks->readLocalNameComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalNameComplete, &returnParam);
 }
 
 static void HciEventOnReadScanEnableComplete(const void *param, uint8_t length)
@@ -90,12 +70,7 @@ static void HciEventOnReadScanEnableComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readScanEnableComplete != NULL) {
-        callbacks->readScanEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readScanEnableComplete, &returnParam);
 }
 
 static void HciEventOnWriteScanEnableComplete(const void *param, uint8_t length)
@@ -104,12 +79,7 @@ static void HciEventOnWriteScanEnableComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeScanEnableComplete != NULL) {
-        callbacks->writeScanEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeScanEnableComplete, &returnParam);
 }
 
 static void HciEventOnReadPageScanActivityComplete(const void *param, uint8_t length)
@@ -118,12 +88,7 @@ static void HciEventOnReadPageScanActivityComplete(const void *param, uint8_t le
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readPageScanActivityComplete != NULL) {
-        callbacks->readPageScanActivityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readPageScanActivityComplete, &returnParam);
 }
 
 static void HciEventOnWritePageScanActivityComplete(const void *param, uint8_t length)
@@ -132,12 +97,7 @@ static void HciEventOnWritePageScanActivityComplete(const void *param, uint8_t l
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writePageScanActivityComplete != NULL) {
-        callbacks->writePageScanActivityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writePageScanActivityComplete, &returnParam);
 }
 
 static void HciEventOnReadInquiryScanActivityComplete(const void *param, uint8_t length)
@@ -146,12 +106,7 @@ static void HciEventOnReadInquiryScanActivityComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readInquiryScanActivityComplete != NULL) {
-        callbacks->readInquiryScanActivityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readInquiryScanActivityComplete, &returnParam);
 }
 
 static void HciEventOnWriteInquiryScanActivityComplete(const void *param, uint8_t length)
@@ -160,12 +115,7 @@ static void HciEventOnWriteInquiryScanActivityComplete(const void *param, uint8_
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeInquiryScanActivityComplete != NULL) {
-        callbacks->writeInquiryScanActivityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeInquiryScanActivityComplete, &returnParam);
 }
 
 static void HciEventOnReadClassofDeviceComplete(const void *param, uint8_t length)
@@ -174,12 +124,7 @@ static void HciEventOnReadClassofDeviceComplete(const void *param, uint8_t lengt
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readClassofDeviceComplete != NULL) {
-        callbacks->readClassofDeviceComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readClassofDeviceComplete, &returnParam);
 }
 
 static void HciEventOnWriteClassofDeviceComplete(const void *param, uint8_t length)
@@ -188,12 +133,7 @@ static void HciEventOnWriteClassofDeviceComplete(const void *param, uint8_t leng
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeClassofDeviceComplete != NULL) {
-        callbacks->writeClassofDeviceComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeClassofDeviceComplete, &returnParam);
 }
 
 static void HciEventOnWriteVoiceSettingComplete(const void *param, uint8_t length)
@@ -202,12 +142,7 @@ static void HciEventOnWriteVoiceSettingComplete(const void *param, uint8_t lengt
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeVoiceSettingComplete != NULL) {
-        callbacks->writeVoiceSettingComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeVoiceSettingComplete, &returnParam);
 }
 
 static void HciEventOnHostBufferSizeComplete(const void *param, uint8_t length)
@@ -216,12 +151,7 @@ static void HciEventOnHostBufferSizeComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->hostBufferSizeComplete != NULL) {
-        callbacks->hostBufferSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(hostBufferSizeComplete, &returnParam);
 }
 
 static void HciEventOnReadCurrentIacLapComplete(const void *param, uint8_t length)
@@ -230,12 +160,7 @@ static void HciEventOnReadCurrentIacLapComplete(const void *param, uint8_t lengt
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readCurrentIacLapComplete != NULL) {
-        callbacks->readCurrentIacLapComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readCurrentIacLapComplete, &returnParam);
 }
 
 static void HciEventOnWriteCurrentIacLapComplete(const void *param, uint8_t length)
@@ -244,12 +169,7 @@ static void HciEventOnWriteCurrentIacLapComplete(const void *param, uint8_t leng
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeCurrentIacLapComplete != NULL) {
-        callbacks->writeCurrentIacLapComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeCurrentIacLapComplete, &returnParam);
 }
 
 static void HciEventOnReadInquiryScanTypeComplete(const void *param, uint8_t length)
@@ -258,12 +178,7 @@ static void HciEventOnReadInquiryScanTypeComplete(const void *param, uint8_t len
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readInquiryScanTypeComplete != NULL) {
-        callbacks->readInquiryScanTypeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readInquiryScanTypeComplete, &returnParam);
 }
 
 static void HciEventOnWriteInquiryScanTypeComplete(const void *param, uint8_t length)
@@ -272,12 +187,7 @@ static void HciEventOnWriteInquiryScanTypeComplete(const void *param, uint8_t le
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeInquiryScanTypeComplete != NULL) {
-        callbacks->writeInquiryScanTypeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeInquiryScanTypeComplete, &returnParam);
 }
 
 static void HciEventOnReadInquiryModeComplete(const void *param, uint8_t length)
@@ -286,12 +196,7 @@ static void HciEventOnReadInquiryModeComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readInquiryModeComplete != NULL) {
-        callbacks->readInquiryModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readInquiryModeComplete, &returnParam);
 }
 
 static void HciEventOnWriteInquiryModeComplete(const void *param, uint8_t length)
@@ -300,12 +205,7 @@ static void HciEventOnWriteInquiryModeComplete(const void *param, uint8_t length
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeInquiryModeComplete != NULL) {
-        callbacks->writeInquiryModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeInquiryModeComplete, &returnParam);
 }
 
 static void HciEventOnReadPageScanTypeCommandComplete(const void *param, uint8_t length)
@@ -314,12 +214,7 @@ static void HciEventOnReadPageScanTypeCommandComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readPageScanTypeComplete != NULL) {
-        callbacks->readPageScanTypeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readPageScanTypeComplete, &returnParam);
 }
 
 static void HciEventOnWritePageScanTypeCommandComplete(const void *param, uint8_t length)
@@ -328,12 +223,7 @@ static void HciEventOnWritePageScanTypeCommandComplete(const void *param, uint8_
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writePageScanTypeComplete != NULL) {
-        callbacks->writePageScanTypeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writePageScanTypeComplete, &returnParam);
 }
 
 static void HciEventOnWriteExtendedInquiryResponseComplete(const void *param, uint8_t length)
@@ -342,12 +232,7 @@ static void HciEventOnWriteExtendedInquiryResponseComplete(const void *param, ui
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeExtendedInquiryResponseComplete != NULL) {
-        callbacks->writeExtendedInquiryResponseComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeExtendedInquiryResponseComplete, &returnParam);
 }
 
 static void HciEventOnWriteSimplePairingModeComplete(const void *param, uint8_t length)
@@ -356,12 +241,7 @@ static void HciEventOnWriteSimplePairingModeComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeSimplePairingModeComplete != NULL) {
-        callbacks->writeSimplePairingModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeSimplePairingModeComplete, &returnParam);
 }
 
 static void HciEventOnReadLocalOOBDataComplete(const void *param, uint8_t length)
@@ -370,12 +250,7 @@ static void HciEventOnReadLocalOOBDataComplete(const void *param, uint8_t length
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalOOBDataComplete != NULL) {
-        callbacks->readLocalOOBDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalOOBDataComplete, &returnParam);
 }
 
 static void HciEventOnSendKeypressNotificationComplete(const void *param, uint8_t length)
@@ -384,12 +259,7 @@ static void HciEventOnSendKeypressNotificationComplete(const void *param, uint8_
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->sendKeypressNotificationComplete != NULL) {
-        callbacks->sendKeypressNotificationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(sendKeypressNotificationComplete, &returnParam);
 }
 
 static void HciEventOnWriteLeHostSupportComplete(const void *param, uint8_t length)
@@ -398,12 +268,7 @@ static void HciEventOnWriteLeHostSupportComplete(const void *param, uint8_t leng
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeLeHostSupportComplete != NULL) {
-        callbacks->writeLeHostSupportComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeLeHostSupportComplete, &returnParam);
 }
 
 static void HciEventOnWriteSecureConnectionsHostSupportComplete(const void *param, uint8_t length)
@@ -412,12 +277,7 @@ static void HciEventOnWriteSecureConnectionsHostSupportComplete(const void *para
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeSecureConnectionsHostSupportComplete != NULL) {
-        callbacks->writeSecureConnectionsHostSupportComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeSecureConnectionsHostSupportComplete, &returnParam);
 }
 
 static void HciEventOnWriteAuthenticatedPayloadTimeoutComplete(const void *param, uint8_t length)
@@ -426,12 +286,7 @@ static void HciEventOnWriteAuthenticatedPayloadTimeoutComplete(const void *param
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeAuthenticatedPayloadTimeoutComplete != NULL) {
-        callbacks->writeAuthenticatedPayloadTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeAuthenticatedPayloadTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnReadLocalOOBExtendedDataComplete(const void *param, uint8_t length)
@@ -440,12 +295,7 @@ static void HciEventOnReadLocalOOBExtendedDataComplete(const void *param, uint8_
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalOOBExtendedDataComplete != NULL) {
-        callbacks->readLocalOOBExtendedDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalOOBExtendedDataComplete, &returnParam);
 }
 
 static void HciEventOnSetEventFilterComplete(const void *param, uint8_t length)
@@ -454,12 +304,7 @@ static void HciEventOnSetEventFilterComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setEventFilterComplete != NULL) {
-        callbacks->setEventFilterComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setEventFilterComplete, &returnParam);
 }
 
 static void HciEventOnFlushComplete(const void *param, uint8_t length)
@@ -468,12 +313,7 @@ static void HciEventOnFlushComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->flushComplete != NULL) {
-        callbacks->flushComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(flushComplete, &returnParam);
 }
 
 static void HciEventOnReadPinTypeComplete(const void *param, uint8_t length)
@@ -482,12 +322,7 @@ static void HciEventOnReadPinTypeComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readPinTypeComplete != NULL) {
-        callbacks->readPinTypeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readPinTypeComplete, &returnParam);
 }
 
 static void HciEventOnWritePinTypeComplete(const void *param, uint8_t length)
@@ -496,12 +331,7 @@ static void HciEventOnWritePinTypeComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writePinTypeComplete != NULL) {
-        callbacks->writePinTypeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writePinTypeComplete, &returnParam);
 }
 
 static void HciEventOnCreateNewUnitKeyComplete(const void *param, uint8_t length)
@@ -510,12 +340,7 @@ static void HciEventOnCreateNewUnitKeyComplete(const void *param, uint8_t length
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->createNewUnitKeyComplete != NULL) {
-        callbacks->createNewUnitKeyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(createNewUnitKeyComplete, &returnParam);
 }
 
 static void HciEventOnReadStoredLinkKeyComplete(const void *param, uint8_t length)
@@ -524,12 +349,7 @@ static void HciEventOnReadStoredLinkKeyComplete(const void *param, uint8_t lengt
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readStoredLinkKeyComplete != NULL) {
-        callbacks->readStoredLinkKeyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readStoredLinkKeyComplete, &returnParam);
 }
 
 static void HciEventOnWriteStoredLinkKeyComplete(const void *param, uint8_t length)
@@ -538,12 +358,7 @@ static void HciEventOnWriteStoredLinkKeyComplete(const void *param, uint8_t leng
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeStoredLinkKeyComplete != NULL) {
-        callbacks->writeStoredLinkKeyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeStoredLinkKeyComplete, &returnParam);
 }
 
 static void HciEventOnDeleteStoredLinkKeyComplete(const void *param, uint8_t length)
@@ -552,12 +367,7 @@ static void HciEventOnDeleteStoredLinkKeyComplete(const void *param, uint8_t len
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->deleteStoredLinkKeyComplete != NULL) {
-        callbacks->deleteStoredLinkKeyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(deleteStoredLinkKeyComplete, &returnParam);
 }
 
 static void HciEventOnReadConnectionAcceptTimeoutComplete(const void *param, uint8_t length)
@@ -566,12 +376,7 @@ static void HciEventOnReadConnectionAcceptTimeoutComplete(const void *param, uin
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readConnectionAcceptTimeoutComplete != NULL) {
-        callbacks->readConnectionAcceptTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readConnectionAcceptTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnWriteConnectionAcceptTimeoutComplete(const void *param, uint8_t length)
@@ -580,12 +385,7 @@ static void HciEventOnWriteConnectionAcceptTimeoutComplete(const void *param, ui
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeConnectionAcceptTimeoutComplete != NULL) {
-        callbacks->writeConnectionAcceptTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeConnectionAcceptTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnReadPageTimeoutComplete(const void *param, uint8_t length)
@@ -594,12 +394,7 @@ static void HciEventOnReadPageTimeoutComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readPageTimeoutComplete != NULL) {
-        callbacks->readPageTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readPageTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnWritePageTimeoutComplete(const void *param, uint8_t length)
@@ -608,12 +403,7 @@ static void HciEventOnWritePageTimeoutComplete(const void *param, uint8_t length
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writePageTimeoutComplete != NULL) {
-        callbacks->writePageTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writePageTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnWriteAuthenticationEnableComplete(const void *param, uint8_t length)
@@ -622,12 +412,7 @@ static void HciEventOnWriteAuthenticationEnableComplete(const void *param, uint8
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeAuthenticationEnableComplete != NULL) {
-        callbacks->writeAuthenticationEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeAuthenticationEnableComplete, &returnParam);
 }
 
 static void HciEventOnReadVoiceSettingComplete(const void *param, uint8_t length)
@@ -636,12 +421,7 @@ static void HciEventOnReadVoiceSettingComplete(const void *param, uint8_t length
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readVoiceSettingComplete != NULL) {
-        callbacks->readVoiceSettingComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readVoiceSettingComplete, &returnParam);
 }
 
 static void HciEventOnReadAutomaticFlushTimeoutComplete(const void *param, uint8_t length)
@@ -650,12 +430,7 @@ static void HciEventOnReadAutomaticFlushTimeoutComplete(const void *param, uint8
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readAutomaticFlushTimeoutComplete != NULL) {
-        callbacks->readAutomaticFlushTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readAutomaticFlushTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnWriteAutomaticFlushTimeoutComplete(const void *param, uint8_t length)
@@ -664,12 +439,7 @@ static void HciEventOnWriteAutomaticFlushTimeoutComplete(const void *param, uint
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeAutomaticFlushTimeoutComplete != NULL) {
-        callbacks->writeAutomaticFlushTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeAutomaticFlushTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnReadNumBroadcastRetransmissionsComplete(const void *param, uint8_t length)
@@ -678,12 +448,7 @@ static void HciEventOnReadNumBroadcastRetransmissionsComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readNumBroadcastRetransmissionsComplete != NULL) {
-        callbacks->readNumBroadcastRetransmissionsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readNumBroadcastRetransmissionsComplete, &returnParam);
 }
 
 static void HciEventOnWriteNumBroadcastRetransmissionsComplete(const void *param, uint8_t length)
@@ -692,12 +457,7 @@ static void HciEventOnWriteNumBroadcastRetransmissionsComplete(const void *param
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeNumBroadcastRetransmissionsComplete != NULL) {
-        callbacks->writeNumBroadcastRetransmissionsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeNumBroadcastRetransmissionsComplete, &returnParam);
 }
 
 static void HciEventOnReadHoldModeActivityComplete(const void *param, uint8_t length)
@@ -706,12 +466,7 @@ static void HciEventOnReadHoldModeActivityComplete(const void *param, uint8_t le
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readHoldModeActivityComplete != NULL) {
-        callbacks->readHoldModeActivityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readHoldModeActivityComplete, &returnParam);
 }
 
 static void HciEventOnWriteHoldModeActivityComplete(const void *param, uint8_t length)
@@ -720,12 +475,7 @@ static void HciEventOnWriteHoldModeActivityComplete(const void *param, uint8_t l
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeHoldModeActivityComplete != NULL) {
-        callbacks->writeHoldModeActivityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeHoldModeActivityComplete, &returnParam);
 }
 
 static void HciEventOnReadTransmitPowerLevelComplete(const void *param, uint8_t length)
@@ -734,12 +484,7 @@ static void HciEventOnReadTransmitPowerLevelComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readTransmitPowerLevelComplete != NULL) {
-        callbacks->readTransmitPowerLevelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readTransmitPowerLevelComplete, &returnParam);
 }
 
 static void HciEventOnReadSynchronousFlowControlEnableComplete(const void *param, uint8_t length)
@@ -748,12 +493,7 @@ static void HciEventOnReadSynchronousFlowControlEnableComplete(const void *param
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readSynchronousFlowControlEnableComplete != NULL) {
-        callbacks->readSynchronousFlowControlEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readSynchronousFlowControlEnableComplete, &returnParam);
 }
 
 static void HciEventOnWriteSynchronousFlowControlEnableComplete(const void *param, uint8_t length)
@@ -762,12 +502,7 @@ static void HciEventOnWriteSynchronousFlowControlEnableComplete(const void *para
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeSynchronousFlowControlEnableComplete != NULL) {
-        callbacks->writeSynchronousFlowControlEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeSynchronousFlowControlEnableComplete, &returnParam);
 }
 
 static void HciEventOnSetControllerToHostFlowControlComplete(const void *param, uint8_t length)
@@ -776,12 +511,7 @@ static void HciEventOnSetControllerToHostFlowControlComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setControllerToHostFlowControlComplete != NULL) {
-        callbacks->setControllerToHostFlowControlComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setControllerToHostFlowControlComplete, &returnParam);
 }
 
 static void HciEventOnReadLinkSupervisionTimeoutComplete(const void *param, uint8_t length)
@@ -790,12 +520,7 @@ static void HciEventOnReadLinkSupervisionTimeoutComplete(const void *param, uint
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLinkSupervisionTimeoutComplete != NULL) {
-        callbacks->readLinkSupervisionTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLinkSupervisionTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnWriteLinkSupervisionTimeoutComplete(const void *param, uint8_t length)
@@ -804,12 +529,7 @@ static void HciEventOnWriteLinkSupervisionTimeoutComplete(const void *param, uin
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeLinkSupervisionTimeoutComplete != NULL) {
-        callbacks->writeLinkSupervisionTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeLinkSupervisionTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnSetAFHHostChannelClassificationComplete(const void *param, uint8_t length)
@@ -818,12 +538,7 @@ static void HciEventOnSetAFHHostChannelClassificationComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setAfhHostChannelClassificationComplete != NULL) {
-        callbacks->setAfhHostChannelClassificationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setAfhHostChannelClassificationComplete, &returnParam);
 }
 
 static void HciEventOnReadNumberOfSupportedIACComplete(const void *param, uint8_t length)
@@ -832,12 +547,7 @@ static void HciEventOnReadNumberOfSupportedIACComplete(const void *param, uint8_
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readNumberOfSupportedIacComplete != NULL) {
-        callbacks->readNumberOfSupportedIacComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readNumberOfSupportedIacComplete, &returnParam);
 }
 
 static void HciEventOnReadAFHChannelAssessmentModeComplete(const void *param, uint8_t length)
@@ -846,12 +556,7 @@ static void HciEventOnReadAFHChannelAssessmentModeComplete(const void *param, ui
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readAfhChannelAssessmentModeComplete != NULL) {
-        callbacks->readAfhChannelAssessmentModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readAfhChannelAssessmentModeComplete, &returnParam);
 }
 
 static void HciEventOnWriteAFHChannelAssessmentModeComplete(const void *param, uint8_t length)
@@ -860,12 +565,7 @@ static void HciEventOnWriteAFHChannelAssessmentModeComplete(const void *param, u
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeAfhChannelAssessmentModeComplete != NULL) {
-        callbacks->writeAfhChannelAssessmentModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeAfhChannelAssessmentModeComplete, &returnParam);
 }
 
 static void HciEventOnReadExtendedInquiryResponseComplete(const void *param, uint8_t length)
@@ -874,12 +574,7 @@ static void HciEventOnReadExtendedInquiryResponseComplete(const void *param, uin
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readExtendedInquiryResponseComplete != NULL) {
-        callbacks->readExtendedInquiryResponseComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readExtendedInquiryResponseComplete, &returnParam);
 }
 
 static void HciEventOnReadSimplePairingModeComplete(const void *param, uint8_t length)
@@ -888,12 +583,7 @@ static void HciEventOnReadSimplePairingModeComplete(const void *param, uint8_t l
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readSimplePairingModeComplete != NULL) {
-        callbacks->readSimplePairingModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readSimplePairingModeComplete, &returnParam);
 }
 
 static void HciEventOnWriteInquiryTransmitPowerLevelComplete(const void *param, uint8_t length)
@@ -902,12 +592,7 @@ static void HciEventOnWriteInquiryTransmitPowerLevelComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeInquiryTransmitPowerLevelComplete != NULL) {
-        callbacks->writeInquiryTransmitPowerLevelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeInquiryTransmitPowerLevelComplete, &returnParam);
 }
 
 static void HciEventOnReadDefaultErroneousDataReportingComplete(const void *param, uint8_t length)
@@ -916,12 +601,7 @@ static void HciEventOnReadDefaultErroneousDataReportingComplete(const void *para
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readDefaultErroneousDataReportingComplete != NULL) {
-        callbacks->readDefaultErroneousDataReportingComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readDefaultErroneousDataReportingComplete, &returnParam);
 }
 
 static void HciEventOnWriteDefaultErroneousDataReportingLevelComplete(const void *param, uint8_t length)
@@ -930,12 +610,7 @@ static void HciEventOnWriteDefaultErroneousDataReportingLevelComplete(const void
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeDefaultErroneousDataReportingComplete != NULL) {
-        callbacks->writeDefaultErroneousDataReportingComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeDefaultErroneousDataReportingComplete, &returnParam);
 }
 
 static void HciEventOnWriteLogicalLinkAcceptTimeoutComplete(const void *param, uint8_t length)
@@ -944,12 +619,7 @@ static void HciEventOnWriteLogicalLinkAcceptTimeoutComplete(const void *param, u
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeLogicalLinkAcceptTimeoutComplete != NULL) {
-        callbacks->writeLogicalLinkAcceptTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeLogicalLinkAcceptTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnSetEventMaskPage2Complete(const void *param, uint8_t length)
@@ -958,12 +628,7 @@ static void HciEventOnSetEventMaskPage2Complete(const void *param, uint8_t lengt
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setEventMaskPage2Complete != NULL) {
-        callbacks->setEventMaskPage2Complete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setEventMaskPage2Complete, &returnParam);
 }
 
 static void HciEventOnReadLocationDataComplete(const void *param, uint8_t length)
@@ -972,12 +637,7 @@ static void HciEventOnReadLocationDataComplete(const void *param, uint8_t length
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocationDataComplete != NULL) {
-        callbacks->readLocationDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocationDataComplete, &returnParam);
 }
 
 static void HciEventOnWriteLocationDataComplete(const void *param, uint8_t length)
@@ -986,12 +646,7 @@ static void HciEventOnWriteLocationDataComplete(const void *param, uint8_t lengt
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeLocationDataComplete != NULL) {
-        callbacks->writeLocationDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeLocationDataComplete, &returnParam);
 }
 
 static void HciEventOnReadFlowControlModeComplete(const void *param, uint8_t length)
@@ -1000,12 +655,7 @@ static void HciEventOnReadFlowControlModeComplete(const void *param, uint8_t len
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readFlowControlModeComplete != NULL) {
-        callbacks->readFlowControlModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readFlowControlModeComplete, &returnParam);
 }
 
 static void HciEventOnWriteFlowControlModeComplete(const void *param, uint8_t length)
@@ -1014,12 +664,7 @@ static void HciEventOnWriteFlowControlModeComplete(const void *param, uint8_t le
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeFlowControlModeComplete != NULL) {
-        callbacks->writeFlowControlModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeFlowControlModeComplete, &returnParam);
 }
 
 static void HciEventOnReadEnhancedTransmitPowerLevelComplete(const void *param, uint8_t length)
@@ -1028,12 +673,7 @@ static void HciEventOnReadEnhancedTransmitPowerLevelComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readEnhancedTransmitPowerLevelComplete != NULL) {
-        callbacks->readEnhancedTransmitPowerLevelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readEnhancedTransmitPowerLevelComplete, &returnParam);
 }
 
 static void HciEventOnReadBestEffortFlushTimeoutComplete(const void *param, uint8_t length)
@@ -1042,12 +682,7 @@ static void HciEventOnReadBestEffortFlushTimeoutComplete(const void *param, uint
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readBestEffortFlushTimeoutComplete != NULL) {
-        callbacks->readBestEffortFlushTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readBestEffortFlushTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnWriteBestEffortFlushTimeoutComplete(const void *param, uint8_t length)
@@ -1056,12 +691,7 @@ static void HciEventOnWriteBestEffortFlushTimeoutComplete(const void *param, uin
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeBestEffortFlushTimeoutComplete != NULL) {
-        callbacks->writeBestEffortFlushTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeBestEffortFlushTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnReadLEHostSupportComplete(const void *param, uint8_t length)
@@ -1070,12 +700,7 @@ static void HciEventOnReadLEHostSupportComplete(const void *param, uint8_t lengt
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLeHostSupportComplete != NULL) {
-        callbacks->readLeHostSupportComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLeHostSupportComplete, &returnParam);
 }
 
 static void HciEventOnSetMWSChannelParametersComplete(const void *param, uint8_t length)
@@ -1084,12 +709,7 @@ static void HciEventOnSetMWSChannelParametersComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setMwsChannelParametersComplete != NULL) {
-        callbacks->setMwsChannelParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setMwsChannelParametersComplete, &returnParam);
 }
 
 static void HciEventOnSetExternalFrameConfigurationComplete(const void *param, uint8_t length)
@@ -1098,12 +718,7 @@ static void HciEventOnSetExternalFrameConfigurationComplete(const void *param, u
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setExternalFrameConfigurationComplete != NULL) {
-        callbacks->setExternalFrameConfigurationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setExternalFrameConfigurationComplete, &returnParam);
 }
 
 static void HciEventOnSetMWSSignalingComplete(const void *param, uint8_t length)
@@ -1112,12 +727,7 @@ static void HciEventOnSetMWSSignalingComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setMwsSignalingComplete != NULL) {
-        callbacks->setMwsSignalingComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setMwsSignalingComplete, &returnParam);
 }
 
 static void HciEventOnSetMWSTransportLayerComplete(const void *param, uint8_t length)
@@ -1126,12 +736,7 @@ static void HciEventOnSetMWSTransportLayerComplete(const void *param, uint8_t le
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setMwsTransportLayerComplete != NULL) {
-        callbacks->setMwsTransportLayerComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setMwsTransportLayerComplete, &returnParam);
 }
 
 static void HciEventOnSetMWSScanFrequencyTableComplete(const void *param, uint8_t length)
@@ -1140,12 +745,7 @@ static void HciEventOnSetMWSScanFrequencyTableComplete(const void *param, uint8_
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setMwsScanFrequencyTableComplete != NULL) {
-        callbacks->setMwsScanFrequencyTableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setMwsScanFrequencyTableComplete, &returnParam);
 }
 
 static void HciEventOnSetMWSPATTERNConfigurationComplete(const void *param, uint8_t length)
@@ -1154,12 +754,7 @@ static void HciEventOnSetMWSPATTERNConfigurationComplete(const void *param, uint
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setMwsPatternConfigurationComplete != NULL) {
-        callbacks->setMwsPatternConfigurationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setMwsPatternConfigurationComplete, &returnParam);
 }
 
 static void HciEventOnSetReservedLTADDRComplete(const void *param, uint8_t length)
@@ -1168,12 +763,7 @@ static void HciEventOnSetReservedLTADDRComplete(const void *param, uint8_t lengt
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setReservedLtAddrComplete != NULL) {
-        callbacks->setReservedLtAddrComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setReservedLtAddrComplete, &returnParam);
 }
 
 static void HciEventOnDeleteReservedLTADDRComplete(const void *param, uint8_t length)
@@ -1182,12 +772,7 @@ static void HciEventOnDeleteReservedLTADDRComplete(const void *param, uint8_t le
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->deleteReservedLtAddrComplete != NULL) {
-        callbacks->deleteReservedLtAddrComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(deleteReservedLtAddrComplete, &returnParam);
 }
 
 static void HciEventOnSetConnectionlessSlaveBroadcastDataComplete(const void *param, uint8_t length)
@@ -1196,12 +781,7 @@ static void HciEventOnSetConnectionlessSlaveBroadcastDataComplete(const void *pa
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setConnectionlessSlaveBroadcastDataComplete != NULL) {
-        callbacks->setConnectionlessSlaveBroadcastDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setConnectionlessSlaveBroadcastDataComplete, &returnParam);
 }
 
 static void HciEventOnReadSynchronizationTrainParametersComplete(const void *param, uint8_t length)
@@ -1210,12 +790,7 @@ static void HciEventOnReadSynchronizationTrainParametersComplete(const void *par
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readSynchronizationTrainParametersComplete != NULL) {
-        callbacks->readSynchronizationTrainParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readSynchronizationTrainParametersComplete, &returnParam);
 }
 
 static void HciEventOnWriteSynchronizationTrainParametersComplete(const void *param, uint8_t length)
@@ -1224,12 +799,7 @@ static void HciEventOnWriteSynchronizationTrainParametersComplete(const void *pa
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeSynchronizationTrainParametersComplete != NULL) {
-        callbacks->writeSynchronizationTrainParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeSynchronizationTrainParametersComplete, &returnParam);
 }
 
 static void HciEventOnReadSecureConnectionsHostSupportComplete(const void *param, uint8_t length)
@@ -1238,12 +808,7 @@ static void HciEventOnReadSecureConnectionsHostSupportComplete(const void *param
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readSecureConnectionsHostSupportComplete != NULL) {
-        callbacks->readSecureConnectionsHostSupportComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readSecureConnectionsHostSupportComplete, &returnParam);
 }
 
 static void HciEventOnReadAuthenticatedPayloadTimeoutComplete(const void *param, uint8_t length)
@@ -1252,12 +817,7 @@ static void HciEventOnReadAuthenticatedPayloadTimeoutComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readAuthenticatedPayloadTimeoutComplete != NULL) {
-        callbacks->readAuthenticatedPayloadTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readAuthenticatedPayloadTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnReadExtendedPageTimeoutComplete(const void *param, uint8_t length)
@@ -1266,12 +826,7 @@ static void HciEventOnReadExtendedPageTimeoutComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readExtendedPageTimeoutComplete != NULL) {
-        callbacks->readExtendedPageTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readExtendedPageTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnWriteExtendedPageTimeoutComplete(const void *param, uint8_t length)
@@ -1280,12 +835,7 @@ static void HciEventOnWriteExtendedPageTimeoutComplete(const void *param, uint8_
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeExtendedPageTimeoutComplete != NULL) {
-        callbacks->writeExtendedPageTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeExtendedPageTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnReadExtendedInquiryLengthComplete(const void *param, uint8_t length)
@@ -1294,12 +844,7 @@ static void HciEventOnReadExtendedInquiryLengthComplete(const void *param, uint8
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readExtendedInquiryLengthComplete != NULL) {
-        callbacks->readExtendedInquiryLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readExtendedInquiryLengthComplete, &returnParam);
 }
 
 static void HciEventOnWriteExtendedInquiryLengthComplete(const void *param, uint8_t length)
@@ -1308,12 +853,7 @@ static void HciEventOnWriteExtendedInquiryLengthComplete(const void *param, uint
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeExtendedInquiryLengthComplete != NULL) {
-        callbacks->writeExtendedInquiryLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeExtendedInquiryLengthComplete, &returnParam);
 }
 
 static HciEventCommandCompleteFunc g_controllerBasebandCommandCompleteMap[] = {
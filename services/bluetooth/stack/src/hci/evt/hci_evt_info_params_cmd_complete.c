@@ -34,12 +34,7 @@ static void HciEventOnReadLocalVersionComplete(const void *param, uint8_t length
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalVersionInformationComplete != NULL) {
-        callbacks->readLocalVersionInformationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalVersionInformationComplete, &returnParam);
 }
 
 static void HciEventOnReadLocalSupportedCommandsComplete(const void *param, uint8_t length)
@@ -48,12 +43,7 @@ static void HciEventOnReadLocalSupportedCommandsComplete(const void *param, uint
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalSupportedCommandsComplete != NULL) {
-        callbacks->readLocalSupportedCommandsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalSupportedCommandsComplete, &returnParam);
 }
 
 static void HciEventOnReadLocalSupportedFeaturesComplete(const void *param, uint8_t length)
@@ -62,12 +52,7 @@ static void HciEventOnReadLocalSupportedFeaturesComplete(const void *param, uint
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalSupportedFeaturesComplete != NULL) {
-        callbacks->readLocalSupportedFeaturesComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalSupportedFeaturesComplete, &returnParam);
 }
 
 static void HciEventOnReadLocalExtendedFeaturesComplete(const void *param, uint8_t length)
@@ -76,12 +61,7 @@ static void HciEventOnReadLocalExtendedFeaturesComplete(const void *param, uint8
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalExtendedFeaturesComplete != NULL) {
-        callbacks->readLocalExtendedFeaturesComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalExtendedFeaturesComplete, &returnParam);
 }
 
 static void HciEventOnReadBufferSizeComplete(const void *param, uint8_t length)
@@ -90,12 +70,7 @@ static void HciEventOnReadBufferSizeComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readBufferSizeComplete != NULL) {
-        callbacks->readBufferSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readBufferSizeComplete, &returnParam);
 }
 
 static void HciEventOnReadBdAddr(const void *param, uint8_t length)
@@ -104,12 +79,7 @@ static void HciEventOnReadBdAddr(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readBdAddrComplete != NULL) {
-        callbacks->readBdAddrComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readBdAddrComplete, &returnParam);
 }
 
 static void HciCopySupportedCodecs(uint8_t *supportedCodecs, uint8_t count, const uint8_t *buf)
@@ -179,12 +149,7 @@ static void HciEventOnReadLocalSupportedCodecs(const void *param, uint8_t length
         }
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalSupportedCodecsComplete != NULL) {
-        callbacks->readLocalSupportedCodecsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalSupportedCodecsComplete, &returnParam);
 
     if (returnParam.supportedCodecs != NULL) {
         MEM_MALLOC.free(returnParam.supportedCodecs);
@@ -19,8 +19,6 @@
 
 #include "btstack.h"
 #include "platform/include/allocator.h"
-#include "platform/include/list.h"
-#include "platform/include/mutex.h"
 
 #include "hci/acl/hci_acl.h"
 #include "hci/hci.h"
@@ -28,6 +26,7 @@
 #include "hci/hci_error.h"
 
 #include "hci_evt.h"
+#include "hci_evt_statistics.h"
 #include "log.h"
 
 typedef void (*HciLeEventFunc)(const uint8_t *param, size_t length);
@@ -44,12 +43,7 @@ static void HciEventOnLeConnectionCompleteEvent(const uint8_t *param, size_t len
         HciAclOnConnectionComplete(eventParam->connectionHandle, TRANSPORT_LE);
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leConnectionComplete != NULL) {
-        callbacks->leConnectionComplete(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leConnectionComplete, eventParam);
 }
 
 static void HciEventOnLeAdvertisingReportEvent(const uint8_t *param, size_t length)
@@ -96,12 +90,7 @@ static void HciEventOnLeAdvertisingReportEvent(const uint8_t *param, size_t leng
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leAdvertisingReport != NULL) {
-        callbacks->leAdvertisingReport(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leAdvertisingReport, &eventParam);
 
     if (reports != NULL) {
         MEM_MALLOC.free(reports);
@@ -116,12 +105,7 @@ static void HciEventOnLeConnectionUpdateCompleteEvent(const uint8_t *param, size
 
     HciLeConnectionUpdateCompleteEventParam *eventParam = (HciLeConnectionUpdateCompleteEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leConnectionUpdateComplete != NULL) {
-        callbacks->leConnectionUpdateComplete(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leConnectionUpdateComplete, eventParam);
 }
 
 static void HciEventOnLeReadRemoteFeaturesCompleteEvent(const uint8_t *param, size_t length)
@@ -132,12 +116,7 @@ static void HciEventOnLeReadRemoteFeaturesCompleteEvent(const uint8_t *param, si
 
     HciLeReadRemoteFeaturesCompleteEventParam *eventParam = (HciLeReadRemoteFeaturesCompleteEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadRemoteFeaturesComplete != NULL) {
-        callbacks->leReadRemoteFeaturesComplete(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadRemoteFeaturesComplete, eventParam);
 }
 
 static void HciEventOnLeLongTermKeyRequestEvent(const uint8_t *param, size_t length)
@@ -148,12 +127,7 @@ static void HciEventOnLeLongTermKeyRequestEvent(const uint8_t *param, size_t len
 
     HciLeLongTermKeyRequestEventParam *eventParam = (HciLeLongTermKeyRequestEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leLongTermKeyRequest != NULL) {
-        callbacks->leLongTermKeyRequest(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leLongTermKeyRequest, eventParam);
 }
 
 static void HciEventOnLeRemoteConnectionParameterRequestEvent(const uint8_t *param, size_t length)
@@ -165,12 +139,7 @@ static void HciEventOnLeRemoteConnectionParameterRequestEvent(const uint8_t *par
     HciLeRemoteConnectionParameterRequestEventParam *eventParam =
         (HciLeRemoteConnectionParameterRequestEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoteConnectionParameterRequest != NULL) {
-        callbacks->leRemoteConnectionParameterRequest(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoteConnectionParameterRequest, eventParam);
 }
 
 static void HciEventOnLeReadLocalP256PublicKeyCompleteEvent(const uint8_t *param, size_t length)
@@ -181,12 +150,7 @@ static void HciEventOnLeReadLocalP256PublicKeyCompleteEvent(const uint8_t *param
 
     HciLeReadLocalP256PublicKeyCompleteEventParam *eventParam = (HciLeReadLocalP256PublicKeyCompleteEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadLocalP256PublicKeyComplete != NULL) {
-        callbacks->leReadLocalP256PublicKeyComplete(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadLocalP256PublicKeyComplete, eventParam);
 }
 
 static void HciEventOnLeGenerateDHKeyCompleteEvent(const uint8_t *param, size_t length)
@@ -197,12 +161,7 @@ static void HciEventOnLeGenerateDHKeyCompleteEvent(const uint8_t *param, size_t
 
     HciLeGenerateDHKeyCompleteEventParam *eventParam = (HciLeGenerateDHKeyCompleteEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leGenerateDHKeyComplete != NULL) {
-        callbacks->leGenerateDHKeyComplete(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leGenerateDHKeyComplete, eventParam);
 }
 
 static void HciEventOnLeEnhancedConnectionCompleteEvent(const uint8_t *param, size_t length)
@@ -217,12 +176,7 @@ static void HciEventOnLeEnhancedConnectionCompleteEvent(const uint8_t *param, si
         HciAclOnConnectionComplete(eventParam->connectionHandle, TRANSPORT_LE);
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leEnhancedConnectionComplete != NULL) {
-        callbacks->leEnhancedConnectionComplete(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leEnhancedConnectionComplete, eventParam);
 }
 
 static void HciParseLeDirectedAdvertisingReport(
@@ -275,12 +229,7 @@ static void HciEventOnLeDirectedAdvertisingReportCompleteEvent(const uint8_t *pa
         eventParam.reports = reports;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leDirectedAdvertisingReport != NULL) {
-        callbacks->leDirectedAdvertisingReport(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leDirectedAdvertisingReport, &eventParam);
 
     if (reports != NULL) {
         MEM_MALLOC.free(reports);
@@ -295,12 +244,7 @@ static void HciEventOnLePHYUpdateCompleteEvent(const uint8_t *param, size_t leng
 
     HciLePhyUpdateCompleteEventParam *eventParam = (HciLePhyUpdateCompleteEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->lePhyUpdateComplete != NULL) {
-        callbacks->lePhyUpdateComplete(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(lePhyUpdateComplete, eventParam);
 }
 
 static bool HciParseLeExtendedAdvertisingReport(
@@ -397,12 +341,7 @@ static void HciEventOnLeExtendedAdvertisingReportEvent(const uint8_t *param, siz
         return;
     }
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leExtendedAdvertisingReport != NULL) {
-        callbacks->leExtendedAdvertisingReport(&eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leExtendedAdvertisingReport, &eventParam);
 
     MEM_MALLOC.free(reports);
 }
@@ -415,22 +354,12 @@ static void HciEventOnLeChannelSelectionAlgorithmEvent(const uint8_t *param, siz
 
     HciLeChannelSelectionAlgorithmEventParam *eventParam = (HciLeChannelSelectionAlgorithmEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leChannelSelectionAlgorithm != NULL) {
-        callbacks->leChannelSelectionAlgorithm(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leChannelSelectionAlgorithm, eventParam);
 }
 
 static void HciEventOnLeScanTimeoutEvent(const uint8_t *param, size_t length)
 {
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leScanTimeoutComplete != NULL) {
-        callbacks->leScanTimeoutComplete();
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leScanTimeoutComplete);
 }
 
 static void HciEventOnLeAdvertisingSetTerminatedEvent(const uint8_t *param, size_t length)
@@ -441,12 +370,7 @@ static void HciEventOnLeAdvertisingSetTerminatedEvent(const uint8_t *param, size
 
     HciLeAdvertisingSetTerminatedEventParam *eventParam = (HciLeAdvertisingSetTerminatedEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leAdvertisingSetTerminated != NULL) {
-        callbacks->leAdvertisingSetTerminated(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leAdvertisingSetTerminated, eventParam);
 }
 
 static void HciEventOnLeScanRequestReceivedEvent(const uint8_t *param, size_t length)
@@ -457,12 +381,7 @@ static void HciEventOnLeScanRequestReceivedEvent(const uint8_t *param, size_t le
 
     HciLeScanRequestReceivedEventParam *eventParam = (HciLeScanRequestReceivedEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leScanRequestReceived != NULL) {
-        callbacks->leScanRequestReceived(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leScanRequestReceived, eventParam);
 }
 
 static void HciEventOnLEDataLengthChangeEvent(const uint8_t *param, size_t length)
@@ -473,12 +392,7 @@ static void HciEventOnLEDataLengthChangeEvent(const uint8_t *param, size_t lengt
 
     HciLeDataLengthChangeEventParam *eventParam = (HciLeDataLengthChangeEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leDataLengthChange != NULL) {
-        callbacks->leDataLengthChange(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leDataLengthChange, eventParam);
 }
 
 static void HciEventOnLEPeriodicAdvertisingSyncEstablishedEvent(const uint8_t *param, size_t length)
@@ -490,12 +404,7 @@ static void HciEventOnLEPeriodicAdvertisingSyncEstablishedEvent(const uint8_t *p
     HciLePeriodicAdvertisingSyncEstablishedEventParam *eventParam =
         (HciLePeriodicAdvertisingSyncEstablishedEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->lePeriodicAdvertisingSyncEstablished != NULL) {
-        callbacks->lePeriodicAdvertisingSyncEstablished(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(lePeriodicAdvertisingSyncEstablished, eventParam);
 }
 
 static void HciEventOnLEPeriodicAdvertisingReportEvent(const uint8_t *param, size_t length)
@@ -506,12 +415,7 @@ static void HciEventOnLEPeriodicAdvertisingReportEvent(const uint8_t *param, siz
 
     HciLePeriodicAdvertisingReportEventParam *eventParam = (HciLePeriodicAdvertisingReportEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->lePeriodicAdvertisingReport != NULL) {
-        callbacks->lePeriodicAdvertisingReport(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(lePeriodicAdvertisingReport, eventParam);
 }
 
 static void HciEventOnLEPeriodicAdvertisingSyncLostEvent(const uint8_t *param, size_t length)
@@ -522,12 +426,7 @@ static void HciEventOnLEPeriodicAdvertisingSyncLostEvent(const uint8_t *param, s
 
     HciLePeriodicAdvertisingSyncLostEventParam *eventParam = (HciLePeriodicAdvertisingSyncLostEventParam *)param;
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->lePeriodicAdvertisingSyncLost != NULL) {
-        callbacks->lePeriodicAdvertisingSyncLost(eventParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(lePeriodicAdvertisingSyncLost, eventParam);
 }
 
 static HciLeEventFunc g_leEventMap[] = {
@@ -556,6 +455,8 @@ static HciLeEventFunc g_leEventMap[] = {
 
 #define LESUBEVENTCODE_MAX 0x14
 
+static HciEventStatisticsCounters g_leEventStatistics[LESUBEVENTCODE_MAX + 1];
+
 void HciEventOnLeMetaEvent(Packet *packet)
 {
     Buffer *payloadBuffer = PacketContinuousPayload(packet);
@@ -577,10 +478,27 @@ void HciEventOnLeMetaEvent(Packet *packet)
 
     HciLeEventFunc func = g_leEventMap[buf[0]];
     if (func != NULL) {
+        uint64_t beginNs = HciEventGetTimestamp();
         if (length > 1) {
             func(buf + 1, length - 1);
         } else {
             func(NULL, 0);
         }
+        HciEventUpdateStatistics(&g_leEventStatistics[buf[0]], beginNs);
+    }
+}
+
+int HCI_GetLeEventStatistics(uint8_t subeventCode, HciEventStatistics *statistics)
+{
+    if (subeventCode > LESUBEVENTCODE_MAX || statistics == NULL) {
+        return BT_BAD_PARAM;
     }
+
+    HciEventLoadStatistics(&g_leEventStatistics[subeventCode], statistics);
+    return BT_SUCCESS;
+}
+
+void HciEventResetLeStatistics()
+{
+    HciEventResetStatistics(g_leEventStatistics, LESUBEVENTCODE_MAX + 1);
 }
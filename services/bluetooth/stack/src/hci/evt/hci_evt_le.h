@@ -24,6 +24,8 @@ extern "C" {
 
 void HciEventOnLeMetaEvent(Packet *packet);
 
+void HciEventResetLeStatistics();
+
 #ifdef __cplusplus
 }
 #endif
@@ -32,12 +32,7 @@ static void HciEventOnLeSetEventMaskComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetEventMaskComplete != NULL) {
-        callbacks->leSetEventMaskComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetEventMaskComplete, &returnParam);
 }
 
 static void HciEventOnLeReadBufferSizeComplete(const void *param, uint8_t length)
@@ -46,12 +41,7 @@ static void HciEventOnLeReadBufferSizeComplete(const void *param, uint8_t length
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadBufferSizeComplete != NULL) {
-        callbacks->leReadBufferSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadBufferSizeComplete, &returnParam);
 }
 
 static void HciEventOnLeReadLocalSupportedFeaturesComplete(const void *param, uint8_t length)
@@ -60,12 +50,7 @@ static void HciEventOnLeReadLocalSupportedFeaturesComplete(const void *param, ui
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadLocalSupportedFeaturesComplete != NULL) {
-        callbacks->leReadLocalSupportedFeaturesComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadLocalSupportedFeaturesComplete, &returnParam);
 }
 
 static void HciEventOnLeSetRandomAddressComplete(const void *param, uint8_t length)
@@ -74,12 +59,7 @@ static void HciEventOnLeSetRandomAddressComplete(const void *param, uint8_t leng
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetRandomAddressComplete != NULL) {
-        callbacks->leSetRandomAddressComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetRandomAddressComplete, &returnParam);
 }
 
 static void HciEventOnLeSetAdvertisingParametersComplete(const void *param, uint8_t length)
@@ -88,12 +68,7 @@ static void HciEventOnLeSetAdvertisingParametersComplete(const void *param, uint
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetAdvertisingParametersComplete != NULL) {
-        callbacks->leSetAdvertisingParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetAdvertisingParametersComplete, &returnParam);
 }
 
 static void HciEventOnLeReadAdvertisingChannelTxPowerComplete(const void *param, uint8_t length)
@@ -102,12 +77,7 @@ static void HciEventOnLeReadAdvertisingChannelTxPowerComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadAdvertisingChannelTxPowerComplete != NULL) {
-        callbacks->leReadAdvertisingChannelTxPowerComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadAdvertisingChannelTxPowerComplete, &returnParam);
 }
 
 static void HciEventOnLeSetAdvertisingDataComplete(const void *param, uint8_t length)
@@ -116,12 +86,7 @@ static void HciEventOnLeSetAdvertisingDataComplete(const void *param, uint8_t le
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetAdvertisingDataComplete != NULL) {
-        callbacks->leSetAdvertisingDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetAdvertisingDataComplete, &returnParam);
 }
 
 static void HciEventOnLeSetScanResponseDataComplete(const void *param, uint8_t length)
@@ -130,12 +95,7 @@ static void HciEventOnLeSetScanResponseDataComplete(const void *param, uint8_t l
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetScanResponseDataComplete != NULL) {
-        callbacks->leSetScanResponseDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetScanResponseDataComplete, &returnParam);
 }
 
 static void HciEventOnLeSetAdvertisingEnableComplete(const void *param, uint8_t length)
@@ -144,12 +104,7 @@ static void HciEventOnLeSetAdvertisingEnableComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetAdvertisingEnableComplete != NULL) {
-        callbacks->leSetAdvertisingEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetAdvertisingEnableComplete, &returnParam);
 }
 
 static void HciEventOnLeSetScanParametersComplete(const void *param, uint8_t length)
@@ -158,12 +113,7 @@ static void HciEventOnLeSetScanParametersComplete(const void *param, uint8_t len
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetScanParametersComplete != NULL) {
-        callbacks->leSetScanParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetScanParametersComplete, &returnParam);
 }
 
 static void HciEventOnLeSetScanEnableComplete(const void *param, uint8_t length)
@@ -172,12 +122,7 @@ static void HciEventOnLeSetScanEnableComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetScanEnableComplete != NULL) {
-        callbacks->leSetScanEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetScanEnableComplete, &returnParam);
 }
 
 static void HciEventOnLeCreateConnectionCancelComplete(const void *param, uint8_t length)
@@ -186,12 +131,7 @@ static void HciEventOnLeCreateConnectionCancelComplete(const void *param, uint8_
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leCreateConnectionCancelComplete != NULL) {
-        callbacks->leCreateConnectionCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leCreateConnectionCancelComplete, &returnParam);
 }
 
 static void HciEventOnLeReadWhiteListSizeComplete(const void *param, uint8_t length)
@@ -200,12 +140,7 @@ static void HciEventOnLeReadWhiteListSizeComplete(const void *param, uint8_t len
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadWhiteListSizeComplete != NULL) {
-        callbacks->leReadWhiteListSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadWhiteListSizeComplete, &returnParam);
 }
 
 static void HciEventOnLeClearWhiteListComplete(const void *param, uint8_t length)
@@ -214,12 +149,7 @@ static void HciEventOnLeClearWhiteListComplete(const void *param, uint8_t length
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leClearWhiteListComplete != NULL) {
-        callbacks->leClearWhiteListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leClearWhiteListComplete, &returnParam);
 }
 
 static void HciEventOnLeAddDeviceToWhiteListComplete(const void *param, uint8_t length)
@@ -228,12 +158,7 @@ static void HciEventOnLeAddDeviceToWhiteListComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leAddDeviceToWhiteListComplete != NULL) {
-        callbacks->leAddDeviceToWhiteListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leAddDeviceToWhiteListComplete, &returnParam);
 }
 
 static void HciEventOnLeRemoveDeviceFromWhiteListComplete(const void *param, uint8_t length)
@@ -242,12 +167,7 @@ static void HciEventOnLeRemoveDeviceFromWhiteListComplete(const void *param, uin
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoveDeviceFromWhiteListComplete != NULL) {
-        callbacks->leRemoveDeviceFromWhiteListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoveDeviceFromWhiteListComplete, &returnParam);
 }
 
 static void HciEventOnLeSetHostChannelClassificationComplete(const void *param, uint8_t length)
@@ -256,12 +176,7 @@ static void HciEventOnLeSetHostChannelClassificationComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetHostChannelClassificationComplete != NULL) {
-        callbacks->leSetHostChannelClassificationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetHostChannelClassificationComplete, &returnParam);
 }
 
 static void HciEventOnLeReadChannelMapComplete(const void *param, uint8_t length)
@@ -270,12 +185,7 @@ static void HciEventOnLeReadChannelMapComplete(const void *param, uint8_t length
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadChannelMapComplete != NULL) {
-        callbacks->leReadChannelMapComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadChannelMapComplete, &returnParam);
 }
 
 static void HciEventOnLeEncryptComplete(const void *param, uint8_t length)
@@ -284,12 +194,7 @@ static void HciEventOnLeEncryptComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leEncryptComplete != NULL) {
-        callbacks->leEncryptComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leEncryptComplete, &returnParam);
 }
 
 static void HciEventOnLeRandComplete(const void *param, uint8_t length)
@@ -298,12 +203,7 @@ static void HciEventOnLeRandComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRandComplete != NULL) {
-        callbacks->leRandComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRandComplete, &returnParam);
 }
 
 static void HciEventOnLeLongTermKeyRequestReplyComplete(const void *param, uint8_t length)
@@ -312,12 +212,7 @@ static void HciEventOnLeLongTermKeyRequestReplyComplete(const void *param, uint8
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leLongTermKeyRequestReplyComplete != NULL) {
-        callbacks->leLongTermKeyRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leLongTermKeyRequestReplyComplete, &returnParam);
 }
 
 static void HciEventOnLeLongTermKeyRequestNegativeReplyComplete(const void *param, uint8_t length)
@@ -326,12 +221,7 @@ static void HciEventOnLeLongTermKeyRequestNegativeReplyComplete(const void *para
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leLongTermKeyRequestNegativeReplyComplete != NULL) {
-        callbacks->leLongTermKeyRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leLongTermKeyRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciEventOnLeRemoteConnectionParameterRequestReplyComplete(const void *param, uint8_t length)
@@ -340,12 +230,7 @@ static void HciEventOnLeRemoteConnectionParameterRequestReplyComplete(const void
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoteConnectionParameterRequestReplyComplete != NULL) {
-        callbacks->leRemoteConnectionParameterRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoteConnectionParameterRequestReplyComplete, &returnParam);
 }
 
 static void HciEventOnLeRemoteConnectionParameterRequestNegativeReplyComplete(const void *param, uint8_t length)
@@ -354,12 +239,7 @@ static void HciEventOnLeRemoteConnectionParameterRequestNegativeReplyComplete(co
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoteConnectionParameterRequestNegativeReplyComplete != NULL) {
-        callbacks->leRemoteConnectionParameterRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoteConnectionParameterRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciEventOnLeAddDeviceToResolvingListComplete(const void *param, uint8_t length)
@@ -368,12 +248,7 @@ static void HciEventOnLeAddDeviceToResolvingListComplete(const void *param, uint
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leAddDeviceToResolvingListComplete != NULL) {
-        callbacks->leAddDeviceToResolvingListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leAddDeviceToResolvingListComplete, &returnParam);
 }
 
 static void HciEventOnLeRemoveDeviceFromResolvingListComplete(const void *param, uint8_t length)
@@ -382,12 +257,7 @@ static void HciEventOnLeRemoveDeviceFromResolvingListComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoveDeviceFromResolvingListComplete != NULL) {
-        callbacks->leRemoveDeviceFromResolvingListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoveDeviceFromResolvingListComplete, &returnParam);
 }
 
 static void HciEventOnLeClearResolvingListComplete(const void *param, uint8_t length)
@@ -396,12 +266,7 @@ static void HciEventOnLeClearResolvingListComplete(const void *param, uint8_t le
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leClearResolvingListComplete != NULL) {
-        callbacks->leClearResolvingListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leClearResolvingListComplete, &returnParam);
 }
 
 static void HciEventOnLeReadResolvingListSizeComplete(const void *param, uint8_t length)
@@ -410,12 +275,7 @@ static void HciEventOnLeReadResolvingListSizeComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadResolvingListSizeComplete != NULL) {
-        callbacks->leReadResolvingListSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadResolvingListSizeComplete, &returnParam);
 }
 
 static void HciEventOnLeReadPeerResolvableAddressComplete(const void *param, uint8_t length)
@@ -424,12 +284,7 @@ static void HciEventOnLeReadPeerResolvableAddressComplete(const void *param, uin
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadPeerResolvableAddressComplete != NULL) {
-        callbacks->leReadPeerResolvableAddressComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadPeerResolvableAddressComplete, &returnParam);
 }
 
 static void HciEventOnLeReadLocalResolvableAddressComplete(const void *param, uint8_t length)
@@ -438,12 +293,7 @@ static void HciEventOnLeReadLocalResolvableAddressComplete(const void *param, ui
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadLocalResolvableAddressComplete != NULL) {
-        callbacks->leReadLocalResolvableAddressComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadLocalResolvableAddressComplete, &returnParam);
 }
 
 static void HciEventOnLeSetAddressResolutionEnableComplete(const void *param, uint8_t length)
@@ -452,12 +302,7 @@ static void HciEventOnLeSetAddressResolutionEnableComplete(const void *param, ui
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetAddressResolutionEnableComplete != NULL) {
-        callbacks->leSetAddressResolutionEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetAddressResolutionEnableComplete, &returnParam);
 }
 
 static void HciEventOnSetResolvablePrivateAddressTimeoutComplete(const void *param, uint8_t length)
@@ -466,12 +311,7 @@ static void HciEventOnSetResolvablePrivateAddressTimeoutComplete(const void *par
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetResolvablePrivateAddressTimeoutComplete != NULL) {
-        callbacks->leSetResolvablePrivateAddressTimeoutComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetResolvablePrivateAddressTimeoutComplete, &returnParam);
 }
 
 static void HciEventOnLeSetAdvertisingSetRandomAddressComplete(const void *param, uint8_t length)
@@ -480,12 +320,7 @@ static void HciEventOnLeSetAdvertisingSetRandomAddressComplete(const void *param
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetAdvertisingSetRandomAddressComplete != NULL) {
-        callbacks->leSetAdvertisingSetRandomAddressComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetAdvertisingSetRandomAddressComplete, &returnParam);
 }
 
 static void HciEventOnLeSetExtendedAdvertisingParametersComplete(const void *param, uint8_t length)
@@ -494,12 +329,7 @@ static void HciEventOnLeSetExtendedAdvertisingParametersComplete(const void *par
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetExtendedAdvertisingParametersComplete != NULL) {
-        callbacks->leSetExtendedAdvertisingParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetExtendedAdvertisingParametersComplete, &returnParam);
 }
 
 static void HciEventOnLeSetExtendedAdvertisingDataComplete(const void *param, uint8_t length)
@@ -508,12 +338,7 @@ static void HciEventOnLeSetExtendedAdvertisingDataComplete(const void *param, ui
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetExtendedAdvertisingDataComplete != NULL) {
-        callbacks->leSetExtendedAdvertisingDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetExtendedAdvertisingDataComplete, &returnParam);
 }
 
 static void HciEventOnLeSetExtendedScanResponseDataComplete(const void *param, uint8_t length)
@@ -522,12 +347,7 @@ static void HciEventOnLeSetExtendedScanResponseDataComplete(const void *param, u
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetExtendedScanResponseDataComplete != NULL) {
-        callbacks->leSetExtendedScanResponseDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetExtendedScanResponseDataComplete, &returnParam);
 }
 
 static void HciEventOnLeSetExtendedAdvertisingEnableComplete(const void *param, uint8_t length)
@@ -536,12 +356,7 @@ static void HciEventOnLeSetExtendedAdvertisingEnableComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetExtendedAdvertisingEnableComplete != NULL) {
-        callbacks->leSetExtendedAdvertisingEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetExtendedAdvertisingEnableComplete, &returnParam);
 }
 
 static void HciEventOnLeReadMaximumAdvertisingDataLengthComplete(const void *param, uint8_t length)
@@ -550,12 +365,7 @@ static void HciEventOnLeReadMaximumAdvertisingDataLengthComplete(const void *par
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadMaximumAdvertisingDataLengthComplete != NULL) {
-        callbacks->leReadMaximumAdvertisingDataLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadMaximumAdvertisingDataLengthComplete, &returnParam);
 }
 
 static void HciEventOnLeReadNumberofSupportedAdvertisingSetsComplete(const void *param, uint8_t length)
@@ -564,12 +374,7 @@ static void HciEventOnLeReadNumberofSupportedAdvertisingSetsComplete(const void
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadNumberofSupportedAdvertisingSetsComplete != NULL) {
-        callbacks->leReadNumberofSupportedAdvertisingSetsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadNumberofSupportedAdvertisingSetsComplete, &returnParam);
 }
 
 static void HciEventOnLeRemoveAdvertisingSetComplete(const void *param, uint8_t length)
@@ -578,12 +383,7 @@ static void HciEventOnLeRemoveAdvertisingSetComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoveAdvertisingSetComplete != NULL) {
-        callbacks->leRemoveAdvertisingSetComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoveAdvertisingSetComplete, &returnParam);
 }
 
 static void HciEventOnLeClearAdvertisingSetsComplete(const void *param, uint8_t length)
@@ -592,12 +392,7 @@ static void HciEventOnLeClearAdvertisingSetsComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leClearAdvertisingSetsComplete != NULL) {
-        callbacks->leClearAdvertisingSetsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leClearAdvertisingSetsComplete, &returnParam);
 }
 
 static void HciEventOnLeSetExtendedScanParametersComplete(const void *param, uint8_t length)
@@ -606,12 +401,7 @@ static void HciEventOnLeSetExtendedScanParametersComplete(const void *param, uin
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetExtendedScanParametersComplete != NULL) {
-        callbacks->leSetExtendedScanParametersComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetExtendedScanParametersComplete, &returnParam);
 }
 
 static void HciEventOnLeSetExtendedScanEnableComplete(const void *param, uint8_t length)
@@ -620,12 +410,7 @@ static void HciEventOnLeSetExtendedScanEnableComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetExtendedScanEnableComplete != NULL) {
-        callbacks->leSetExtendedScanEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetExtendedScanEnableComplete, &returnParam);
 }
 
 static void HciEventOnLeReadSupportedStatesComplete(const void *param, uint8_t length)
@@ -634,12 +419,7 @@ static void HciEventOnLeReadSupportedStatesComplete(const void *param, uint8_t l
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadSupportedStatesComplete != NULL) {
-        callbacks->leReadSupportedStatesComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadSupportedStatesComplete, &returnParam);
 }
 
 static void HciEventOnLeReceiverTestComplete(const void *param, uint8_t length)
@@ -648,12 +428,7 @@ static void HciEventOnLeReceiverTestComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReceiverTestComplete != NULL) {
-        callbacks->leReceiverTestComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReceiverTestComplete, &returnParam);
 }
 
 static void HciEventOnLeTransmitterTestComplete(const void *param, uint8_t length)
@@ -662,12 +437,7 @@ static void HciEventOnLeTransmitterTestComplete(const void *param, uint8_t lengt
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leTransmitterTestComplete != NULL) {
-        callbacks->leTransmitterTestComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leTransmitterTestComplete, &returnParam);
 }
 
 static void HciEventOnLeTestEndComplete(const void *param, uint8_t length)
@@ -676,12 +446,7 @@ static void HciEventOnLeTestEndComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leTestEndComplete != NULL) {
-        callbacks->leTestEndComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leTestEndComplete, &returnParam);
 }
 
 static void HciEventOnLeSetDataLengthComplete(const void *param, uint8_t length)
@@ -690,12 +455,7 @@ static void HciEventOnLeSetDataLengthComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetDataLengthComplete != NULL) {
-        callbacks->leSetDataLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetDataLengthComplete, &returnParam);
 }
 
 static void HciEventOnLeReadSuggestedDefaultDataLengthComplete(const void *param, uint8_t length)
@@ -704,12 +464,7 @@ static void HciEventOnLeReadSuggestedDefaultDataLengthComplete(const void *param
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadSuggestedDefaultDataLengthComplete != NULL) {
-        callbacks->leReadSuggestedDefaultDataLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadSuggestedDefaultDataLengthComplete, &returnParam);
 }
 
 static void HciEventOnLeWriteSuggestedDefaultDataLengthComplete(const void *param, uint8_t length)
@@ -718,12 +473,7 @@ static void HciEventOnLeWriteSuggestedDefaultDataLengthComplete(const void *para
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leWriteSuggestedDefaultDataLengthComplete != NULL) {
-        callbacks->leWriteSuggestedDefaultDataLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leWriteSuggestedDefaultDataLengthComplete, &returnParam);
 }
 
 static void HciEventOnLeReadMaximumDataLengthComplete(const void *param, uint8_t length)
@@ -732,12 +482,7 @@ static void HciEventOnLeReadMaximumDataLengthComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadMaximumDataLengthComplete != NULL) {
-        callbacks->leReadMaximumDataLengthComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadMaximumDataLengthComplete, &returnParam);
 }
 
 static void HciEventOnLeReadPhyComplete(const void *param, uint8_t length)
@@ -746,12 +491,7 @@ static void HciEventOnLeReadPhyComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadPhyComplete != NULL) {
-        callbacks->leReadPhyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadPhyComplete, &returnParam);
 }
 
 static void HciEventOnLeSetDefaultPhyComplete(const void *param, uint8_t length)
@@ -760,12 +500,7 @@ static void HciEventOnLeSetDefaultPhyComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetDefaultPhyComplete != NULL) {
-        callbacks->leSetDefaultPhyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetDefaultPhyComplete, &returnParam);
 }
 
 static void HciEventOnLeEnhancedReceiverTestComplete(const void *param, uint8_t length)
@@ -774,12 +509,7 @@ static void HciEventOnLeEnhancedReceiverTestComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leEnhancedReceiverTestComplete != NULL) {
-        callbacks->leEnhancedReceiverTestComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leEnhancedReceiverTestComplete, &returnParam);
 }
 
 static void HciEventOnLeEnhancedTransmitterTestComplete(const void *param, uint8_t length)
@@ -788,12 +518,7 @@ static void HciEventOnLeEnhancedTransmitterTestComplete(const void *param, uint8
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leEnhancedTransmitterTestComplete != NULL) {
-        callbacks->leEnhancedTransmitterTestComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leEnhancedTransmitterTestComplete, &returnParam);
 }
 
 static void HciEventOnLeSetPeriodicAdvertisingParametersComplete(const void *param, uint8_t length)
@@ -802,12 +527,7 @@ static void HciEventOnLeSetPeriodicAdvertisingParametersComplete(const void *par
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetPeriodicAdvertisingParametersComplete != NULL) {
-        callbacks->leSetPeriodicAdvertisingParametersComplete(param);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetPeriodicAdvertisingParametersComplete, param);
 }
 
 static void HciEventOnLeSetPeriodicAdvertisingDataComplete(const void *param, uint8_t length)
@@ -816,12 +536,7 @@ static void HciEventOnLeSetPeriodicAdvertisingDataComplete(const void *param, ui
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetPeriodicAdvertisingDataComplete != NULL) {
-        callbacks->leSetPeriodicAdvertisingDataComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetPeriodicAdvertisingDataComplete, &returnParam);
 }
 
 static void HciEventOnLeSetPeriodicAdvertisingEnableComplete(const void *param, uint8_t length)
@@ -830,12 +545,7 @@ static void HciEventOnLeSetPeriodicAdvertisingEnableComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetPeriodicAdvertisingEnableComplete != NULL) {
-        callbacks->leSetPeriodicAdvertisingEnableComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetPeriodicAdvertisingEnableComplete, &returnParam);
 }
 
 static void HciEventOnLePeriodicAdvertisingCreateSyncCancelComplete(const void *param, uint8_t length)
@@ -844,12 +554,7 @@ static void HciEventOnLePeriodicAdvertisingCreateSyncCancelComplete(const void *
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->lePeriodicAdvertisingCreateSyncCancelComplete != NULL) {
-        callbacks->lePeriodicAdvertisingCreateSyncCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(lePeriodicAdvertisingCreateSyncCancelComplete, &returnParam);
 }
 
 static void HciEventOnLePeriodicAdvertisingTerminateSyncComplete(const void *param, uint8_t length)
@@ -858,12 +563,7 @@ static void HciEventOnLePeriodicAdvertisingTerminateSyncComplete(const void *par
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->lePeriodicAdvertisingTerminateSyncComplete != NULL) {
-        callbacks->lePeriodicAdvertisingTerminateSyncComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(lePeriodicAdvertisingTerminateSyncComplete, &returnParam);
 }
 
 static void HciEventOnLeAddDeviceToPeriodicAdvertiserListComplete(const void *param, uint8_t length)
@@ -872,12 +572,7 @@ static void HciEventOnLeAddDeviceToPeriodicAdvertiserListComplete(const void *pa
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leAddDeviceToPeriodicAdvertiserListComplete != NULL) {
-        callbacks->leAddDeviceToPeriodicAdvertiserListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leAddDeviceToPeriodicAdvertiserListComplete, &returnParam);
 }
 
 static void HciEventOnLeRemoveDeviceFromPeriodicAdvertiserListComplete(const void *param, uint8_t length)
@@ -886,12 +581,7 @@ static void HciEventOnLeRemoveDeviceFromPeriodicAdvertiserListComplete(const voi
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leRemoveDeviceFromPeriodicAdvertiserListComplete != NULL) {
-        callbacks->leRemoveDeviceFromPeriodicAdvertiserListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leRemoveDeviceFromPeriodicAdvertiserListComplete, &returnParam);
 }
 
 static void HciEventOnLeClearPeriodicAdvertiserListComplete(const void *param, uint8_t length)
@@ -900,12 +590,7 @@ static void HciEventOnLeClearPeriodicAdvertiserListComplete(const void *param, u
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leClearPeriodicAdvertiserListComplete != NULL) {
-        callbacks->leClearPeriodicAdvertiserListComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leClearPeriodicAdvertiserListComplete, &returnParam);
 }
 
 static void HciEventOnLeReadPeriodicAdvertiserListSizeComplete(const void *param, uint8_t length)
@@ -914,12 +599,7 @@ static void HciEventOnLeReadPeriodicAdvertiserListSizeComplete(const void *param
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadPeriodicAdvertiserListSizeComplete != NULL) {
-        callbacks->leReadPeriodicAdvertiserListSizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadPeriodicAdvertiserListSizeComplete, &returnParam);
 }
 
 static void HciEventOnLeReadTransmitPowerComplete(const void *param, uint8_t length)
@@ -928,12 +608,7 @@ static void HciEventOnLeReadTransmitPowerComplete(const void *param, uint8_t len
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadTransmitPowerComplete != NULL) {
-        callbacks->leReadTransmitPowerComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadTransmitPowerComplete, &returnParam);
 }
 
 static void HciEventOnLeReadRFPathCompensationComplete(const void *param, uint8_t length)
@@ -942,12 +617,7 @@ static void HciEventOnLeReadRFPathCompensationComplete(const void *param, uint8_
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leReadRfPathCompensationComplete != NULL) {
-        callbacks->leReadRfPathCompensationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leReadRfPathCompensationComplete, &returnParam);
 }
 
 static void HciEventOnLeWriteRFPathCompensationComplete(const void *param, uint8_t length)
@@ -956,12 +626,7 @@ static void HciEventOnLeWriteRFPathCompensationComplete(const void *param, uint8
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leWriteRfPathCompensationComplete != NULL) {
-        callbacks->leWriteRfPathCompensationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leWriteRfPathCompensationComplete, &returnParam);
 }
 
 static void HciEventOnLeSetPrivacyModeComplete(const void *param, uint8_t length)
@@ -970,12 +635,7 @@ static void HciEventOnLeSetPrivacyModeComplete(const void *param, uint8_t length
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->leSetPrivacyModeComplete != NULL) {
-        callbacks->leSetPrivacyModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(leSetPrivacyModeComplete, &returnParam);
 }
 
 static HciLeCmdCompleteFunc g_leControllerCommandCompleteMap[] = {
@@ -34,12 +34,7 @@ static void HciEventOnInquiryCancelComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->inquiryCancelComplete != NULL) {
-        callbacks->inquiryCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(inquiryCancelComplete, &returnParam);
 }
 
 static void HciEventOnCreateConnectionCancelComplete(const void *param, uint8_t length)
@@ -48,12 +43,7 @@ static void HciEventOnCreateConnectionCancelComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->createConnectionCancelComplete != NULL) {
-        callbacks->createConnectionCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(createConnectionCancelComplete, &returnParam);
 }
 
 static void HciEventOnLinkKeyRequestReplyComplete(const void *param, uint8_t length)
@@ -62,12 +52,7 @@ static void HciEventOnLinkKeyRequestReplyComplete(const void *param, uint8_t len
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->linkKeyRequestReplyComplete != NULL) {
-        callbacks->linkKeyRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(linkKeyRequestReplyComplete, &returnParam);
 }
 
 static void HciEventOnLinkKeyRequestNegativeReplyComplete(const void *param, uint8_t length)
@@ -76,12 +61,7 @@ static void HciEventOnLinkKeyRequestNegativeReplyComplete(const void *param, uin
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->linkKeyRequestNegativeReplyComplete != NULL) {
-        callbacks->linkKeyRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(linkKeyRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciEventOnPINCodeRequestReplyCompete(const void *param, uint8_t length)
@@ -90,12 +70,7 @@ static void HciEventOnPINCodeRequestReplyCompete(const void *param, uint8_t leng
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->pinCodeRequestReplyComplete != NULL) {
-        callbacks->pinCodeRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(pinCodeRequestReplyComplete, &returnParam);
 }
 
 static void HciEventOnPINCodeRequestNegativeReplyComplete(const void *param, uint8_t length)
@@ -104,12 +79,7 @@ static void HciEventOnPINCodeRequestNegativeReplyComplete(const void *param, uin
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->pinCodeRequestNegativeReplyComplete != NULL) {
-        callbacks->pinCodeRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(pinCodeRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciEventOnRemoteNameRequestCancelComplete(const void *param, uint8_t length)
@@ -118,12 +88,7 @@ static void HciEventOnRemoteNameRequestCancelComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->remoteNameRequestCancelComplete != NULL) {
-        callbacks->remoteNameRequestCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(remoteNameRequestCancelComplete, &returnParam);
 }
 
 static void HciEventOnIOCapabilityRequestReplyComplete(const void *param, uint8_t length)
@@ -132,12 +97,7 @@ static void HciEventOnIOCapabilityRequestReplyComplete(const void *param, uint8_
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->ioCapabilityRequestReplyComplete != NULL) {
-        callbacks->ioCapabilityRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(ioCapabilityRequestReplyComplete, &returnParam);
 }
 
 static void HciEventOnUserConfirmationRequestReplyComplete(const void *param, uint8_t length)
@@ -146,12 +106,7 @@ static void HciEventOnUserConfirmationRequestReplyComplete(const void *param, ui
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->userConfirmationRequestReplyComplete != NULL) {
-        callbacks->userConfirmationRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(userConfirmationRequestReplyComplete, &returnParam);
 }
 
 static void HciEventOnUserConfirmationRequestNegativeReplyComplete(const void *param, uint8_t length)
@@ -160,12 +115,7 @@ static void HciEventOnUserConfirmationRequestNegativeReplyComplete(const void *p
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->userConfirmationRequestNegativeReplyComplete != NULL) {
-        callbacks->userConfirmationRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(userConfirmationRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciEventOnUserPasskeyRequestReplyComplete(const void *param, uint8_t length)
@@ -174,12 +124,7 @@ static void HciEventOnUserPasskeyRequestReplyComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->userPasskeyRequestReplyComplete != NULL) {
-        callbacks->userPasskeyRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(userPasskeyRequestReplyComplete, &returnParam);
 }
 
 static void HciEventOnUserPasskeyRequestNegativeReplyComplete(const void *param, uint8_t length)
@@ -188,12 +133,7 @@ static void HciEventOnUserPasskeyRequestNegativeReplyComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->userPasskeyRequestNegativeReplyComplete != NULL) {
-        callbacks->userPasskeyRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(userPasskeyRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciEventOnRemoteOOBDataRequestReplyComplete(const void *param, uint8_t length)
@@ -202,12 +142,7 @@ static void HciEventOnRemoteOOBDataRequestReplyComplete(const void *param, uint8
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->remoteOOBDataRequestReplyComplete != NULL) {
-        callbacks->remoteOOBDataRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(remoteOOBDataRequestReplyComplete, &returnParam);
 }
 
 static void HciEventOnRemoteOOBDataRequestNegativeReplyComplete(const void *param, uint8_t length)
@@ -216,12 +151,7 @@ static void HciEventOnRemoteOOBDataRequestNegativeReplyComplete(const void *para
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->remoteOOBDataRequestNegativeReplyComplete != NULL) {
-        callbacks->remoteOOBDataRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(remoteOOBDataRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciEventOnIOCapabilityRequestNegativeReplyComplete(const void *param, uint8_t length)
@@ -230,12 +160,7 @@ static void HciEventOnIOCapabilityRequestNegativeReplyComplete(const void *param
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->iOCapabilityRequestNegativeReplyComplete != NULL) {
-        callbacks->iOCapabilityRequestNegativeReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(iOCapabilityRequestNegativeReplyComplete, &returnParam);
 }
 
 static void HciEventOnRemoteOOBExtendedDataRequestReplyComplete(const void *param, uint8_t length)
@@ -244,12 +169,7 @@ static void HciEventOnRemoteOOBExtendedDataRequestReplyComplete(const void *para
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->remoteOOBExtendedDataRequestReplyComplete != NULL) {
-        callbacks->remoteOOBExtendedDataRequestReplyComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(remoteOOBExtendedDataRequestReplyComplete, &returnParam);
 }
 
 static void HciEventOnExitPeriodicInquiryModeComplete(const void *param, uint8_t length)
@@ -258,12 +178,7 @@ static void HciEventOnExitPeriodicInquiryModeComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->exitPeriodicInquiryModeComplete != NULL) {
-        callbacks->exitPeriodicInquiryModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(exitPeriodicInquiryModeComplete, &returnParam);
 }
 
 static void HciEventOnPeriodicInquiryModeComplete(const void *param, uint8_t length)
@@ -272,12 +187,7 @@ static void HciEventOnPeriodicInquiryModeComplete(const void *param, uint8_t len
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->periodicInquiryModeComplete != NULL) {
-        callbacks->periodicInquiryModeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(periodicInquiryModeComplete, &returnParam);
 }
 
 static void HciEventOnReadLMPHandleComplete(const void *param, uint8_t length)
@@ -286,12 +196,7 @@ static void HciEventOnReadLMPHandleComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLmpHandleComplete != NULL) {
-        callbacks->readLmpHandleComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLmpHandleComplete, &returnParam);
 }
 
 static void HciEventOnLogicalLinkCancelComplete(const void *param, uint8_t length)
@@ -300,12 +205,7 @@ static void HciEventOnLogicalLinkCancelComplete(const void *param, uint8_t lengt
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->logicalLinkCancelComplete != NULL) {
-        callbacks->logicalLinkCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(logicalLinkCancelComplete, &returnParam);
 }
 
 static void HciEventOnTruncatedPageCancelComplete(const void *param, uint8_t length)
@@ -314,12 +214,7 @@ static void HciEventOnTruncatedPageCancelComplete(const void *param, uint8_t len
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->truncatedPageCancelComplete != NULL) {
-        callbacks->truncatedPageCancelComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(truncatedPageCancelComplete, &returnParam);
 }
 
 static void HciEventOnSetConnectionlessSlaveBroadcastComplete(const void *param, uint8_t length)
@@ -328,12 +223,7 @@ static void HciEventOnSetConnectionlessSlaveBroadcastComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setConnectionlessSlaveBroadcastComplete != NULL) {
-        callbacks->setConnectionlessSlaveBroadcastComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setConnectionlessSlaveBroadcastComplete, &returnParam);
 }
 
 static void HciEventOnSetConnectionlessSlaveBroadcastReceiveComplete(const void *param, uint8_t length)
@@ -342,12 +232,7 @@ static void HciEventOnSetConnectionlessSlaveBroadcastReceiveComplete(const void
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setConnectionlessSlaveBroadcastReceiveComplete != NULL) {
-        callbacks->setConnectionlessSlaveBroadcastReceiveComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setConnectionlessSlaveBroadcastReceiveComplete, &returnParam);
 }
 
 static HciEventCommandCompleteFunc g_linkControlCommandCompleteMap[] = {
@@ -34,12 +34,7 @@ static void HciEventOnWriteLinkPolicySettingsComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeLinkPolicySettingsComplete != NULL) {
-        callbacks->writeLinkPolicySettingsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeLinkPolicySettingsComplete, &returnParam);
 }
 
 static void HciEventOnSniffSubratingComplete(const void *param, uint8_t length)
@@ -48,12 +43,7 @@ static void HciEventOnSniffSubratingComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->sniffSubratingComplete != NULL) {
-        callbacks->sniffSubratingComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(sniffSubratingComplete, &returnParam);
 }
 
 static void HciEventOnRoleDiscoveryComplete(const void *param, uint8_t length)
@@ -62,12 +52,7 @@ static void HciEventOnRoleDiscoveryComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->roleDiscoveryComplete != NULL) {
-        callbacks->roleDiscoveryComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(roleDiscoveryComplete, &returnParam);
 }
 
 static void HciEventOnReadLinkPolicySettingsComplete(const void *param, uint8_t length)
@@ -76,12 +61,7 @@ static void HciEventOnReadLinkPolicySettingsComplete(const void *param, uint8_t
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLinkPolicySettingsComplete != NULL) {
-        callbacks->readLinkPolicySettingsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLinkPolicySettingsComplete, &returnParam);
 }
 
 static void HciEventOnWriteDefaultLinkPolicySettingsComplete(const void *param, uint8_t length)
@@ -90,12 +70,7 @@ static void HciEventOnWriteDefaultLinkPolicySettingsComplete(const void *param,
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeDefaultLinkPolicySettingsComplete != NULL) {
-        callbacks->writeDefaultLinkPolicySettingsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeDefaultLinkPolicySettingsComplete, &returnParam);
 }
 
 static void HciEventOnReadDefaultLinkPolicySettingsComplete(const void *param, uint8_t length)
@@ -104,12 +79,7 @@ static void HciEventOnReadDefaultLinkPolicySettingsComplete(const void *param, u
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readDefaultLinkPolicySettingsComplete != NULL) {
-        callbacks->readDefaultLinkPolicySettingsComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readDefaultLinkPolicySettingsComplete, &returnParam);
 }
 
 static HciEventCommandCompleteFunc g_linkPolicyCommandCompleteMap[] = {
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HCI_EVT_STATISTICS_H
+#define HCI_EVT_STATISTICS_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include "hci/hci.h"
+
+// Counters behind HciEventStatistics. Updated on the thread dispatching events and read or reset from any thread,
+// each field on its own, so a reader may see one dispatch counted in some fields only.
+typedef struct {
+    atomic_uint_fast64_t count;
+    atomic_uint_fast64_t totalNs;
+    atomic_uint_fast64_t maxNs;
+    atomic_uint_fast32_t latencyHistogram[HCI_EVENT_LATENCY_BUCKETS];
+} HciEventStatisticsCounters;
+
+uint64_t HciEventGetTimestamp();
+void HciEventUpdateStatistics(HciEventStatisticsCounters *counters, uint64_t beginNs);
+void HciEventLoadStatistics(const HciEventStatisticsCounters *counters, HciEventStatistics *statistics);
+void HciEventResetStatistics(HciEventStatisticsCounters *counters, size_t num);
+
+#endif
@@ -34,12 +34,7 @@ static void HciEventOnReadRssiComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readRssiComplete != NULL) {
-        callbacks->readRssiComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readRssiComplete, &returnParam);
 }
 
 static void HciEventOnReadFailedContactCounterComplete(const void *param, uint8_t length)
@@ -48,12 +43,7 @@ static void HciEventOnReadFailedContactCounterComplete(const void *param, uint8_
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readFailedContactCounterComplete != NULL) {
-        callbacks->readFailedContactCounterComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readFailedContactCounterComplete, &returnParam);
 }
 
 static void HciEventOnResetFailedContactCounterComplete(const void *param, uint8_t length)
@@ -62,12 +52,7 @@ static void HciEventOnResetFailedContactCounterComplete(const void *param, uint8
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->resetFailedContactCounterComplete != NULL) {
-        callbacks->resetFailedContactCounterComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(resetFailedContactCounterComplete, &returnParam);
 }
 
 static void HciEventOnReadLinkQualityComplete(const void *param, uint8_t length)
@@ -76,12 +61,7 @@ static void HciEventOnReadLinkQualityComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLinkQualityComplete != NULL) {
-        callbacks->readLinkQualityComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLinkQualityComplete, &returnParam);
 }
 
 static void HciEventOnReadAFHChannelMapComplete(const void *param, uint8_t length)
@@ -90,12 +70,7 @@ static void HciEventOnReadAFHChannelMapComplete(const void *param, uint8_t lengt
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readAfhChannelMapComplete != NULL) {
-        callbacks->readAfhChannelMapComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readAfhChannelMapComplete, &returnParam);
 }
 
 static void HciEventOnReadClockComplete(const void *param, uint8_t length)
@@ -104,12 +79,7 @@ static void HciEventOnReadClockComplete(const void *param, uint8_t length)
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readClockComplete != NULL) {
-        callbacks->readClockComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readClockComplete, &returnParam);
 }
 
 static void HciEventOnReadEncryptionKeySizeComplete(const void *param, uint8_t length)
@@ -118,12 +88,7 @@ static void HciEventOnReadEncryptionKeySizeComplete(const void *param, uint8_t l
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readEncryptionKeySizeComplete != NULL) {
-        callbacks->readEncryptionKeySizeComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readEncryptionKeySizeComplete, &returnParam);
 }
 
 static void HciEventOnReadLocalAMPInfoComplete(const void *param, uint8_t length)
@@ -132,12 +97,7 @@ static void HciEventOnReadLocalAMPInfoComplete(const void *param, uint8_t length
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalAmpInfoComplete != NULL) {
-        callbacks->readLocalAmpInfoComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalAmpInfoComplete, &returnParam);
 }
 
 static void HciEventOnReadLocalAMPASSOCComplete(const void *param, uint8_t length)
@@ -146,12 +106,7 @@ static void HciEventOnReadLocalAMPASSOCComplete(const void *param, uint8_t lengt
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->readLocalAmpAssocComplete != NULL) {
-        callbacks->readLocalAmpAssocComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(readLocalAmpAssocComplete, &returnParam);
 }
 
 static void HciEventOnWriteRemoteAMPASSOCComplete(const void *param, uint8_t length)
@@ -160,12 +115,7 @@ static void HciEventOnWriteRemoteAMPASSOCComplete(const void *param, uint8_t len
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->writeRemoteAmpAssocComplete != NULL) {
-        callbacks->writeRemoteAmpAssocComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(writeRemoteAmpAssocComplete, &returnParam);
 }
 
 static void HciEventOnGetMWSTransportLayerConfigurationComplete(const void *param, uint8_t length)
@@ -174,12 +124,7 @@ static void HciEventOnGetMWSTransportLayerConfigurationComplete(const void *para
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->getMwsTransportLayerConfigurationComplete != NULL) {
-        callbacks->getMwsTransportLayerConfigurationComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(getMwsTransportLayerConfigurationComplete, &returnParam);
 }
 
 static void HciEventOnSetTriggeredClockCaptureComplete(const void *param, uint8_t length)
@@ -188,12 +133,7 @@ static void HciEventOnSetTriggeredClockCaptureComplete(const void *param, uint8_
     (void)memcpy_s(
         &returnParam, sizeof(returnParam), param, (length > sizeof(returnParam)) ? sizeof(returnParam) : length);
 
-    HciEventCallbacks *callbacks = NULL;
-    HCI_FOREACH_EVT_CALLBACKS_START(callbacks);
-    if (callbacks->setTriggeredClockCaptureComplete != NULL) {
-        callbacks->setTriggeredClockCaptureComplete(&returnParam);
-    }
-    HCI_FOREACH_EVT_CALLBACKS_END;
+    HCI_EVT_CALLBACKS_DISPATCH(setTriggeredClockCaptureComplete, &returnParam);
 }
 
 static HciEventCommandCompleteFunc g_statusParametersCommandCompleteMap[] = {
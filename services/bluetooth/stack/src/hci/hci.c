@@ -122,14 +122,15 @@ NO_SANITIZE("cfi") static int HciInitHal()
     int result = BT_SUCCESS;
 
     g_waitHdiInit = SemaphoreCreate(0);
+    // Arm the alarm first: the HDI may report OnInited before hdiInit returns.
+    g_waitHdiInitAlarm = AlarmCreate(NULL, false);
+    if (g_waitHdiInitAlarm == NULL) {
+        LOG_ERROR("HdiInited alarm create failed");
+    } else {
+        AlarmSet(g_waitHdiInitAlarm, HCI_WAIT_HDI_INIT_TIME, HciOnHDIInitedTimerTimeout, NULL);
+    }
     int ret = g_hdiLib->hdiInit(&g_hdiCallacks);
     if (ret == SUCCESS) {
-        g_waitHdiInitAlarm = AlarmCreate(NULL, false);
-        if (g_waitHdiInitAlarm == NULL) {
-            LOG_ERROR("HdiInited alarm create failed");
-        } else {
-            AlarmSet(g_waitHdiInitAlarm, HCI_WAIT_HDI_INIT_TIME, HciOnHDIInitedTimerTimeout, NULL);
-        }
         SemaphoreWait(g_waitHdiInit);
         if (g_hdiInitStatus != SUCCESS) {
             LOG_ERROR("HdiInited failed: %{public}d", g_hdiInitStatus);
@@ -137,6 +138,11 @@ NO_SANITIZE("cfi") static int HciInitHal()
         }
     } else {
         LOG_ERROR("hdiInit failed: %{public}d", ret);
+        if (g_waitHdiInitAlarm != NULL) {
+            AlarmCancel(g_waitHdiInitAlarm);
+            AlarmDelete(g_waitHdiInitAlarm);
+            g_waitHdiInitAlarm = NULL;
+        }
         result = BT_OPERATION_FAILED;
     }
     SemaphoreDelete(g_waitHdiInit);
@@ -1450,6 +1450,21 @@ typedef struct {
 int HCI_RegisterEventCallbacks(const HciEventCallbacks *callbacks);
 int HCI_DeregisterEventCallbacks(const HciEventCallbacks *callbacks);
 
+#define HCI_EVENT_LATENCY_BUCKETS 12
+
+// Dispatch statistics of one event code or LE subevent code. Bucket i of latencyHistogram counts handler runs
+// shorter than 2^i microseconds; the last bucket also takes every longer run.
+typedef struct {
+    uint64_t count;
+    uint64_t totalNs;
+    uint64_t maxNs;
+    uint32_t latencyHistogram[HCI_EVENT_LATENCY_BUCKETS];
+} HciEventStatistics;
+
+int HCI_GetEventStatistics(uint8_t eventCode, HciEventStatistics *statistics);
+int HCI_GetLeEventStatistics(uint8_t subeventCode, HciEventStatistics *statistics);
+void HCI_ResetEventStatistics();
+
 typedef struct {
     void (*onAclData)(uint16_t handle, uint8_t pbFlag, uint8_t bcFlag, Packet *packet);
 } HciAclCallbacks;
@@ -1468,6 +1483,18 @@ int HCI_DeregisterFailureCallback(const HciFailureCallbacks *callbacks);
 #define FLUSHABLE_PACKET 1
 int HCI_SendAclData(uint16_t handle, uint8_t flushable, Packet *packet);
 
+// Controller ACL buffer credits and the BR/EDR packets of one connection. completedPackets counts the Number Of
+// Completed Packets reported for the connection since it was established.
+typedef struct {
+    uint16_t totalPackets;
+    uint16_t freePackets;
+    uint16_t inFlightPackets;
+    uint16_t waitingPackets;
+    uint32_t completedPackets;
+} HciAclFlowStatus;
+
+int HCI_GetAclFlowStatus(uint16_t handle, HciAclFlowStatus *status);
+
 #define TRANSMISSON_TYPE_H2C_CMD 1
 #define TRANSMISSON_TYPE_C2H_EVENT 2
 #define TRANSMISSON_TYPE_H2C_DATA 3
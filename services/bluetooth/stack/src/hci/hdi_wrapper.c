@@ -16,6 +16,7 @@
 #include "hdi_wrapper.h"
 
 #include <dlfcn.h>
+#include <stdlib.h>
 
 #include "log.h"
 #include "platform/include/allocator.h"
@@ -26,14 +27,26 @@
 #define HDI_LIB "libbluetooth_hdi_adapter.z.so"
 #endif
 
+#ifdef BT_HDI_LIB_OVERRIDE
+// Names another HDI library, e.g. libbluetooth_hdi_virtual.z.so, to run the stack without a chip.
+#define HDI_LIB_ENV "BT_HDI_LIB"
+#endif
+
 HDILib *LoadHdiLib()
 {
     HDILib *lib = MEM_CALLOC.alloc(sizeof(HDILib));
     if (lib != NULL) {
         do {
-            lib->lib = dlopen(HDI_LIB, RTLD_LAZY | RTLD_NODELETE);
+            const char *name = HDI_LIB;
+#ifdef BT_HDI_LIB_OVERRIDE
+            const char *override = getenv(HDI_LIB_ENV);
+            if ((override != NULL) && (override[0] != '\0')) {
+                name = override;
+            }
+#endif
+            lib->lib = dlopen(name, RTLD_LAZY | RTLD_NODELETE);
             if (lib->lib == NULL) {
-                LOG_ERROR("Load libbluetooth_hdi_adapter.so failed, %{public}s", dlerror());
+                LOG_ERROR("Load %{public}s failed, %{public}s", name, dlerror());
                 break;
             }
 
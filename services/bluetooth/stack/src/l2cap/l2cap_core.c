@@ -448,7 +448,7 @@ static void L2capAddCrc(Packet *pkt)
     uint16_t crc;
     uint8_t *tail = NULL;
 
-    crc = PacketCalCrc16(pkt, CalCrc16WithPrev);
+    crc = PacketCalCrc16Block(pkt, CalCrc16BlockWithPrev, 0);
     tail = BufferPtr(PacketTail(pkt));
     L2capCpuToLe16(tail, crc);
 
@@ -467,7 +467,7 @@ static int L2capCheckCrc(Packet *pkt)
     tailPtr = tail;
     fcs = L2capLe16ToCpu(tailPtr);
 
-    fcsCalc = PacketCalCrc16(pkt, CalCrc16WithPrev);
+    fcsCalc = PacketCalCrc16Block(pkt, CalCrc16BlockWithPrev, 0);
     if (fcs != fcsCalc) {
         LOG_ERROR("L2cap CRC Error, %{public}s:%{public}d", __FUNCTION__, __LINE__);
         return BT_BAD_PARAM;
@@ -15,6 +15,8 @@
 
 #include "l2cap_crc.h"
 
+#include <pthread.h>
+
 #define G_CRCTABLENUM 256
 static const uint16_t G_CRCTABLE[G_CRCTABLENUM] = {
     0x0000, 0xc0c1,
@@ -150,4 +152,49 @@ static const uint16_t G_CRCTABLE[G_CRCTABLENUM] = {
 uint16_t CalCrc16WithPrev(uint8_t data, uint16_t preCrc)
 {
     return ((preCrc >> 0x08) & 0x00ff) ^ G_CRCTABLE[(uint8_t)(preCrc & 0x00ff) ^ data];
+}
+
+/*
+ * Slice-by-8: G_CRCSLICETABLE[k][i] is the CRC of byte i followed by k zero bytes, so eight input bytes are folded
+ * with eight independent lookups instead of a dependent chain of eight.
+ */
+#define G_CRCSLICENUM 8
+static uint16_t G_CRCSLICETABLE[G_CRCSLICENUM][G_CRCTABLENUM];
+static pthread_once_t g_crcSliceOnce = PTHREAD_ONCE_INIT;
+
+static void CrcSliceTableInit(void)
+{
+    for (int i = 0; i < G_CRCTABLENUM; i++) {
+        uint16_t crc = G_CRCTABLE[i];
+        G_CRCSLICETABLE[0][i] = crc;
+        for (int k = 1; k < G_CRCSLICENUM; k++) {
+            crc = ((crc >> 0x08) & 0x00ff) ^ G_CRCTABLE[crc & 0x00ff];
+            G_CRCSLICETABLE[k][i] = crc;
+        }
+    }
+}
+
+uint16_t CalCrc16BlockWithPrev(const uint8_t *data, uint32_t length, uint16_t preCrc)
+{
+    uint16_t crc = preCrc;
+
+    (void)pthread_once(&g_crcSliceOnce, CrcSliceTableInit);
+
+    while (length >= G_CRCSLICENUM) {
+        crc ^= (uint16_t)(data[0] | (data[1] << 0x08));
+        crc = G_CRCSLICETABLE[7][crc & 0x00ff] ^ G_CRCSLICETABLE[6][crc >> 0x08] ^
+              G_CRCSLICETABLE[5][data[2]] ^ G_CRCSLICETABLE[4][data[3]] ^
+              G_CRCSLICETABLE[3][data[4]] ^ G_CRCSLICETABLE[2][data[5]] ^
+              G_CRCSLICETABLE[1][data[6]] ^ G_CRCSLICETABLE[0][data[7]];
+        data += G_CRCSLICENUM;
+        length -= G_CRCSLICENUM;
+    }
+
+    while (length) {
+        crc = CalCrc16WithPrev(*data, crc);
+        data++;
+        length--;
+    }
+
+    return crc;
 }
\ No newline at end of file
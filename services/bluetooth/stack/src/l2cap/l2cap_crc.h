@@ -24,6 +24,16 @@ extern "C" {
 
 uint16_t CalCrc16WithPrev(uint8_t data, uint16_t preCrc);
 
+/**
+ * @brief Continue the L2CAP FCS over a block of bytes, bit-exact with CalCrc16WithPrev applied to every byte.
+ *
+ * @param data Block to add, may be NULL when length is 0.
+ * @param length Block length.
+ * @param preCrc CRC of everything before the block, 0 to start a new frame.
+ * @return CRC including the block.
+ */
+uint16_t CalCrc16BlockWithPrev(const uint8_t *data, uint32_t length, uint16_t preCrc);
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
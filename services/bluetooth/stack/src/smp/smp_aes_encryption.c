@@ -21,6 +21,21 @@
 
 #include "smp.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <wmmintrin.h>
+#define SMP_AES_NI_SUPPORT 1
+#endif
+
+#define SMP_AES128_ROUNDS 10
+
+typedef struct {
+    AES_KEY opensslKey;
+#ifdef SMP_AES_NI_SUPPORT
+    __m128i roundKey[SMP_AES128_ROUNDS + 1];
+#endif
+    bool useAesNi;
+} SMP_AesBlockCipher;
+
 static void SMP_ReverseData(const uint8_t *intput, uint8_t *output, int size)
 {
     for (int i = 0x00; i < size; i++) {
@@ -76,4 +91,98 @@ int SMP_Aes128(
     }
 
     return SMP_Aes128Internal(&keyInput[0], &input[0], &out[0]);
-}
\ No newline at end of file
+}
+
+#ifdef SMP_AES_NI_SUPPORT
+__attribute__((target("aes,sse2"))) static __m128i SMP_AesNiExpandKey(__m128i key, __m128i assist)
+{
+    assist = _mm_shuffle_epi32(assist, 0xFF);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 0x04));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 0x04));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 0x04));
+    return _mm_xor_si128(key, assist);
+}
+
+__attribute__((target("aes,sse2"))) static void SMP_AesNiSetKey(const uint8_t key[AES_BLOCK_SIZE], __m128i *roundKey)
+{
+    roundKey[0] = _mm_loadu_si128((const __m128i *)key);
+    roundKey[1] = SMP_AesNiExpandKey(roundKey[0], _mm_aeskeygenassist_si128(roundKey[0], 0x01));
+    roundKey[2] = SMP_AesNiExpandKey(roundKey[1], _mm_aeskeygenassist_si128(roundKey[1], 0x02));
+    roundKey[3] = SMP_AesNiExpandKey(roundKey[2], _mm_aeskeygenassist_si128(roundKey[2], 0x04));
+    roundKey[4] = SMP_AesNiExpandKey(roundKey[3], _mm_aeskeygenassist_si128(roundKey[3], 0x08));
+    roundKey[5] = SMP_AesNiExpandKey(roundKey[4], _mm_aeskeygenassist_si128(roundKey[4], 0x10));
+    roundKey[6] = SMP_AesNiExpandKey(roundKey[5], _mm_aeskeygenassist_si128(roundKey[5], 0x20));
+    roundKey[7] = SMP_AesNiExpandKey(roundKey[6], _mm_aeskeygenassist_si128(roundKey[6], 0x40));
+    roundKey[8] = SMP_AesNiExpandKey(roundKey[7], _mm_aeskeygenassist_si128(roundKey[7], 0x80));
+    roundKey[9] = SMP_AesNiExpandKey(roundKey[8], _mm_aeskeygenassist_si128(roundKey[8], 0x1B));
+    roundKey[10] = SMP_AesNiExpandKey(roundKey[9], _mm_aeskeygenassist_si128(roundKey[9], 0x36));
+}
+
+__attribute__((target("aes,sse2"))) static void SMP_AesNiEncrypt(
+    const __m128i *roundKey, const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE])
+{
+    __m128i block = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in), roundKey[0]);
+    for (int round = 1; round < SMP_AES128_ROUNDS; round++) {
+        block = _mm_aesenc_si128(block, roundKey[round]);
+    }
+    block = _mm_aesenclast_si128(block, roundKey[SMP_AES128_ROUNDS]);
+    _mm_storeu_si128((__m128i *)out, block);
+}
+#endif
+
+static void SMP_AesBlockCipherInit(SMP_AesBlockCipher *cipher, const uint8_t key[AES_BLOCK_SIZE])
+{
+#ifdef SMP_AES_NI_SUPPORT
+    cipher->useAesNi = __builtin_cpu_supports("aes");
+    if (cipher->useAesNi) {
+        SMP_AesNiSetKey(key, cipher->roundKey);
+        return;
+    }
+#else
+    cipher->useAesNi = false;
+#endif
+    AES_set_encrypt_key(key, AES_BLOCK_SIZE * 0x08, &cipher->opensslKey);
+}
+
+static void SMP_AesBlockCipherEncrypt(
+    const SMP_AesBlockCipher *cipher, const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE])
+{
+#ifdef SMP_AES_NI_SUPPORT
+    if (cipher->useAesNi) {
+        SMP_AesNiEncrypt(cipher->roundKey, in, out);
+        return;
+    }
+#endif
+    AES_encrypt(in, out, &cipher->opensslKey);
+}
+
+static void SMP_AesBlockCipherClear(SMP_AesBlockCipher *cipher)
+{
+    (void)memset_s(cipher, sizeof(SMP_AesBlockCipher), 0x00, sizeof(SMP_AesBlockCipher));
+}
+
+static void SMP_AesCbcMacBlocks(
+    const SMP_AesBlockCipher *cipher, const uint8_t *message, uint32_t blocks, uint8_t x[AES_BLOCK_SIZE])
+{
+    for (uint32_t block = 0; block < blocks; block++) {
+        for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+            x[i] ^= message[block * AES_BLOCK_SIZE + i];
+        }
+        SMP_AesBlockCipherEncrypt(cipher, x, x);
+    }
+}
+
+int SMP_AesCbcMac(
+    const uint8_t key[AES_BLOCK_SIZE], const uint8_t *message, uint32_t blocks, uint8_t x[AES_BLOCK_SIZE])
+{
+    if ((key == NULL) || (x == NULL) || ((message == NULL) && (blocks != 0))) {
+        return -1;
+    }
+
+    SMP_AesBlockCipher cipher;
+    SMP_AesBlockCipherInit(&cipher, key);
+    SMP_AesCbcMacBlocks(&cipher, message, blocks, x);
+    SMP_AesBlockCipherClear(&cipher);
+
+    return 0;
+}
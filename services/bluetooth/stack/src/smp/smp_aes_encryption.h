@@ -39,6 +39,20 @@ extern "C" {
 int SMP_Aes128(
     const uint8_t *key, const uint8_t keyLen, const uint8_t *in, const uint8_t inLen, uint8_t out[AES_BLOCK_SIZE]);
 
+/**
+ * @brief AES-CBC-MAC over complete blocks, the AES-CMAC body before the last block.
+ *        Key, message and x are most significant byte first.
+ *
+ * @param key key data, 128bit.
+ * @param message blocks * 16 bytes of message.
+ * @param blocks number of 16 byte blocks.
+ * @param x chaining value, updated in place.
+ * @return Returns <b>0</b> if the operation is success.
+ *         returns <b>-1</b> if the operation is failed.
+ */
+int SMP_AesCbcMac(
+    const uint8_t key[AES_BLOCK_SIZE], const uint8_t *message, uint32_t blocks, uint8_t x[AES_BLOCK_SIZE]);
+
 #ifdef __cplusplus
 }
 #endif
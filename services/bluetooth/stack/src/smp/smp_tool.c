@@ -20,6 +20,7 @@
 #include "log.h"
 #include "platform/include/allocator.h"
 #include "smp.h"
+#include "smp_aes_encryption.h"
 #include "smp_common.h"
 #include "smp_def.h"
 #include "smp_send.h"
@@ -608,6 +609,20 @@ int SMP_CryptographicAesCmacStep3(const SMP_CryptAesCmacStep3Param *param)
     encCmd->i = 0x00;
     encCmd->signCounter = param->signCounter;
 
+    if ((!param->isUsingHwAes128) && (encCmd->n > 0x01)) {
+        // Host AES: chain every block but the last here, so only the final block goes through an encrypt step.
+        uint8_t key[CRYPT_AESCMAC_KEY_LEN];
+        SMP_MemoryReverseCopy(key, param->key, CRYPT_AESCMAC_KEY_LEN);
+        ret = SMP_AesCbcMac(key, param->message, (uint32_t)(encCmd->n - 0x01), encCmd->X);
+        (void)memset_s(key, CRYPT_AESCMAC_KEY_LEN, 0x00, CRYPT_AESCMAC_KEY_LEN);
+        if (ret != SMP_SUCCESS) {
+            LOG_ERROR("SMP_AesCbcMac failed.");
+            SMP_FreeEncCmd(encCmd);
+            return SMP_ERR_INVAL_STATE;
+        }
+        encCmd->i = encCmd->n - 0x01;
+    }
+
     if (encCmd->i < (encCmd->n - 0x01)) {
         cryptXor128param.b = &param->message[CRYPT_AESCMAC_TMP_LEN * encCmd->i];
         SMP_CryptographicXor128(&cryptXor128param);
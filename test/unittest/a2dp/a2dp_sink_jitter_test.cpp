@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "a2dp_decoder_sbc.h"
+#include "a2dp_sink_jitter_buffer.h"
+#include "benchmark_report.h"
+#include "packet.h"
+#include "sbc_decoder.h"
+#include "sbc_encoder.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+// The decoder loads libbtsbc with dlopen; the test links the codec sources in directly.
+A2dpSBCDynamicLibCtrl::A2dpSBCDynamicLibCtrl(bool isEncoder) : isEncoder_(isEncoder)
+{}
+
+A2dpSBCDynamicLibCtrl::~A2dpSBCDynamicLibCtrl()
+{}
+
+CODECSbcLib *A2dpSBCDynamicLibCtrl::LoadCodecSbcLib() const
+{
+    auto lib = new CODECSbcLib {};
+    lib->sbcDecoder.createSbcDecode = []() -> sbc::IDecoderBase * { return new sbc::Decoder(); };
+    lib->sbcDecoder.destroySbcDecode = [](sbc::IDecoderBase *decoder) { delete decoder; };
+    return lib;
+}
+
+void A2dpSBCDynamicLibCtrl::UnloadCodecSbcLib(CODECSbcLib *lib) const
+{
+    delete lib;
+}
+
+namespace {
+constexpr uint32_t SAMPLE_RATE = 44100;
+constexpr int CHANNELS = 2;
+constexpr int SAMPLES_PER_FRAME = 128;
+constexpr int FRAMES_PER_PACKET = 5;
+constexpr uint32_t PACKET_SAMPLES = SAMPLES_PER_FRAME * FRAMES_PER_PACKET;
+constexpr uint64_t PACKET_US = 1000000ULL * PACKET_SAMPLES / SAMPLE_RATE;
+constexpr int STREAM_PACKETS = 400;
+constexpr uint32_t FIRST_TIMESTAMP = 0xFFFFF000;  // wraps a few packets in
+
+class PcmRecorder : public A2dpDecoderObserver {
+public:
+    void DataAvailable(uint8_t *buf, uint32_t size) override
+    {
+        pcm.insert(pcm.end(), buf, buf + size);
+    }
+    std::vector<uint8_t> pcm;
+};
+
+struct MediaPacket {
+    std::vector<uint8_t> payload;
+    uint32_t timeStamp;
+    uint64_t arrivalUs;
+};
+
+// Records an SBC stream the way a source sends it: a sine encoded 44.1 kHz joint stereo, five frames per packet.
+std::vector<MediaPacket> RecordStream()
+{
+    sbc::CodecParam param = {sbc::SBC_FREQ_44100, sbc::SBC_BLOCK16, sbc::SBC_SUBBAND8,
+        sbc::SBC_CHANNEL_MODE_JOINT_STEREO, sbc::SBC_ALLOCATION_LOUDNESS, 53, sbc::SBC_ENDIANESS_LE};
+    sbc::Encoder encoder;
+    std::vector<MediaPacket> stream;
+    int64_t sample = 0;
+    for (int i = 0; i < STREAM_PACKETS; i++) {
+        MediaPacket packet = {{FRAMES_PER_PACKET}, FIRST_TIMESTAMP + static_cast<uint32_t>(i) * PACKET_SAMPLES,
+            static_cast<uint64_t>(i) * PACKET_US};
+        for (int f = 0; f < FRAMES_PER_PACKET; f++) {
+            int16_t pcm[SAMPLES_PER_FRAME * CHANNELS];
+            for (int s = 0; s < SAMPLES_PER_FRAME; s++, sample++) {
+                auto value = static_cast<int16_t>(8000 * std::sin(2 * M_PI * 440 * sample / SAMPLE_RATE));
+                pcm[s * CHANNELS] = value;
+                pcm[s * CHANNELS + 1] = value;
+            }
+            uint8_t frame[sbc::Encoder::BUFFER_SIZE];
+            size_t written = 0;
+            encoder.SBCEncode(param, reinterpret_cast<uint8_t *>(pcm), sizeof(pcm), frame, sizeof(frame), &written);
+            packet.payload.insert(packet.payload.end(), frame, frame + written);
+        }
+        stream.push_back(packet);
+    }
+    return stream;
+}
+
+Packet *ToPacket(const MediaPacket &media)
+{
+    Packet *packet = PacketMalloc(0, 0, media.payload.size());
+    PacketPayloadWrite(packet, media.payload.data(), 0, media.payload.size());
+    return packet;
+}
+
+struct Playout {
+    std::vector<uint32_t> played;
+    std::vector<uint8_t> pcm;
+    A2dpSinkJitterStats stats;
+};
+
+// Runs the stream through the jitter buffer on a 1 ms clock, decoding each packet the moment it is due.
+Playout Play(const std::vector<MediaPacket> &stream)
+{
+    PcmRecorder recorder;
+    A2dpSbcDecoder decoder(&recorder);
+    A2dpSinkJitterBuffer jitter;
+    jitter.Reset(SAMPLE_RATE);
+    std::map<Packet *, uint32_t> timeStamps;
+    Playout playout;
+
+    std::vector<const MediaPacket *> arrivals;
+    for (const auto &media : stream) {
+        arrivals.push_back(&media);
+    }
+    std::stable_sort(arrivals.begin(), arrivals.end(),
+        [](const MediaPacket *a, const MediaPacket *b) { return a->arrivalUs < b->arrivalUs; });
+    uint64_t endUs = arrivals.back()->arrivalUs + 1000000;
+    size_t next = 0;
+    for (uint64_t nowUs = 0; nowUs <= endUs; nowUs += 1000) {
+        for (; next < arrivals.size() && arrivals[next]->arrivalUs <= nowUs; next++) {
+            Packet *packet = ToPacket(*arrivals[next]);
+            timeStamps[packet] = arrivals[next]->timeStamp;
+            jitter.Push(packet, arrivals[next]->timeStamp, nowUs);
+        }
+        Packet *packet = nullptr;
+        while ((packet = jitter.Pop(nowUs)) != nullptr) {
+            playout.played.push_back(timeStamps[packet]);
+            EXPECT_TRUE(decoder.DecodePacket(packet));
+            PacketFree(packet);
+        }
+    }
+    playout.pcm = recorder.pcm;
+    playout.stats = jitter.GetStats();
+    return playout;
+}
+
+std::vector<uint8_t> Reference(const std::vector<MediaPacket> &stream)
+{
+    PcmRecorder recorder;
+    A2dpSbcDecoder decoder(&recorder);
+    for (const auto &media : stream) {
+        Packet *packet = ToPacket(media);
+        decoder.DecodePacket(packet);
+        PacketFree(packet);
+    }
+    return recorder.pcm;
+}
+
+void Report(const char *name, const A2dpSinkJitterStats &stats)
+{
+    BenchmarkReport(name)
+        .Add("received", stats.received)
+        .Add("played", stats.played)
+        .Add("underruns", stats.underruns)
+        .Add("overruns", stats.overruns)
+        .Add("late", stats.late)
+        .Add("jitter_us", stats.jitterUs)
+        .Add("target_delay_us", stats.targetDelayUs)
+        .Publish();
+}
+}  // namespace
+
+class A2dpSinkJitterTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {
+        stream_ = RecordStream();
+        reference_ = Reference(stream_);
+    }
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+
+    static std::vector<MediaPacket> stream_;
+    static std::vector<uint8_t> reference_;
+};
+
+std::vector<MediaPacket> A2dpSinkJitterTest::stream_;
+std::vector<uint8_t> A2dpSinkJitterTest::reference_;
+
+/**
+ * @tc.number: A2dpSinkJitter_UnitTest001
+ * @tc.name: SteadyStream
+ * @tc.desc: A steady stream plays every packet in order with the minimum delay and decodes to the reference PCM.
+ */
+HWTEST_F(A2dpSinkJitterTest, A2dpSinkJitter_UnitTest_SteadyStream, TestSize.Level1)
+{
+    ASSERT_EQ(reference_.size(), static_cast<size_t>(STREAM_PACKETS) * PACKET_SAMPLES * CHANNELS * sizeof(int16_t));
+    Playout playout = Play(stream_);
+    EXPECT_EQ(playout.stats.played, static_cast<uint64_t>(STREAM_PACKETS));
+    EXPECT_EQ(playout.stats.underruns, 1u);  // only when the stream ends
+    EXPECT_EQ(playout.stats.overruns, 0u);
+    EXPECT_EQ(playout.stats.late, 0u);
+    EXPECT_LT(playout.stats.targetDelayUs, 2 * PACKET_US * 4);
+    EXPECT_TRUE(playout.pcm == reference_);
+    Report("A2dpSinkSteady", playout.stats);
+}
+
+/**
+ * @tc.number: A2dpSinkJitter_UnitTest002
+ * @tc.name: InjectedJitter
+ * @tc.desc: Packets delayed, bunched and reordered on the air still play gap free once the target has grown.
+ */
+HWTEST_F(A2dpSinkJitterTest, A2dpSinkJitter_UnitTest_InjectedJitter, TestSize.Level1)
+{
+    std::vector<MediaPacket> stream = stream_;
+    std::mt19937 random(7);
+    std::uniform_int_distribution<uint64_t> delay(0, 30000);
+    for (size_t i = 0; i < stream.size(); i++) {
+        stream[i].arrivalUs += delay(random);
+        // Every second the link stalls for 60 ms and then delivers what it held in one burst.
+        uint64_t second = stream[i].arrivalUs / 1000000;
+        uint64_t stallEnd = second * 1000000 + 60000;
+        if (second > 0 && stream[i].arrivalUs < stallEnd) {
+            stream[i].arrivalUs = stallEnd;
+        }
+    }
+    Playout playout = Play(stream);
+
+    A2dpSinkJitterStats stats = playout.stats;
+    EXPECT_EQ(stats.received, static_cast<uint64_t>(STREAM_PACKETS));
+    EXPECT_EQ(stats.played + stats.late + stats.overruns, stats.received);
+    EXPECT_GT(stats.targetDelayUs, 40000u);
+    for (size_t i = 1; i < playout.played.size(); i++) {
+        EXPECT_LT(static_cast<int32_t>(playout.played[i - 1] - playout.played[i]), 0);
+    }
+    // Once the jitter estimate has settled, the tail of the stream plays without further loss.
+    EXPECT_LE(stats.underruns, 3u);
+    const size_t tail = 100;
+    ASSERT_GE(playout.played.size(), tail);
+    for (size_t i = playout.played.size() - tail + 1; i < playout.played.size(); i++) {
+        EXPECT_EQ(playout.played[i] - playout.played[i - 1], PACKET_SAMPLES);
+    }
+    if (stats.late == 0 && stats.overruns == 0) {
+        EXPECT_TRUE(playout.pcm == reference_);
+    }
+    Report("A2dpSinkInjectedJitter", stats);
+}
+
+/**
+ * @tc.number: A2dpSinkJitter_UnitTest003
+ * @tc.name: UnderrunAndOverrun
+ * @tc.desc: A long stall counts an underrun and buffers again; a flood past twice the target drops the oldest.
+ */
+HWTEST_F(A2dpSinkJitterTest, A2dpSinkJitter_UnitTest_UnderrunAndOverrun, TestSize.Level1)
+{
+    std::vector<MediaPacket> stream = stream_;
+    // Packets 100..139 are held for 400 ms, then arrive together with the ones due meanwhile.
+    const uint64_t stallStart = stream[100].arrivalUs;
+    const uint64_t stallEnd = stallStart + 400000;
+    for (auto &media : stream) {
+        if (media.arrivalUs >= stallStart && media.arrivalUs < stallEnd) {
+            media.arrivalUs = stallEnd;
+        }
+    }
+    Playout playout = Play(stream);
+
+    A2dpSinkJitterStats stats = playout.stats;
+    EXPECT_GE(stats.underruns, 2u);
+    EXPECT_GT(stats.overruns, 0u);
+    EXPECT_EQ(stats.played + stats.late + stats.overruns, stats.received);
+    EXPECT_EQ(playout.pcm.size(), stats.played * PACKET_SAMPLES * CHANNELS * sizeof(int16_t));
+    Report("A2dpSinkStallAndFlood", stats);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,344 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "a2dp_encoder_sbc.h"
+#include "a2dp_sbc_param_ctrl.h"
+#include "a2dp_source_fanout.h"
+#include "benchmark_report.h"
+#include "packet.h"
+#include "sbc_encoder.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+// SBC frames encoded by every encoder in the process.
+uint64_t g_encodedFrames = 0;
+
+class CountingEncoder : public sbc::Encoder {
+public:
+    ssize_t SBCEncode(const sbc::CodecParam &codecParam, const uint8_t *in, size_t iLength, uint8_t *out,
+        size_t oLength, size_t *written) override
+    {
+        g_encodedFrames++;
+        return sbc::Encoder::SBCEncode(codecParam, in, iLength, out, oLength, written);
+    }
+};
+}  // namespace
+
+// The encoder loads libbtsbc with dlopen; the test links the codec sources in directly.
+A2dpSBCDynamicLibCtrl::A2dpSBCDynamicLibCtrl(bool isEncoder) : isEncoder_(isEncoder)
+{}
+
+A2dpSBCDynamicLibCtrl::~A2dpSBCDynamicLibCtrl()
+{}
+
+CODECSbcLib *A2dpSBCDynamicLibCtrl::LoadCodecSbcLib() const
+{
+    auto lib = new CODECSbcLib {};
+    lib->sbcEncoder.createSbcEncode = []() -> sbc::IEncoderBase * { return new CountingEncoder(); };
+    lib->sbcEncoder.destroySbcEncode = [](sbc::IEncoderBase *encoder) { delete encoder; };
+    return lib;
+}
+
+void A2dpSBCDynamicLibCtrl::UnloadCodecSbcLib(CODECSbcLib *lib) const
+{
+    delete lib;
+}
+
+namespace {
+constexpr uint8_t HIGH_BITPOOL = 53;
+constexpr uint8_t LOW_BITPOOL = 35;
+constexpr uint16_t PEER_MTU = 895;
+constexpr size_t LONG_QUEUE = 1024;
+constexpr size_t SHORT_QUEUE = 4;
+constexpr int TICKS = 50;
+constexpr int SINKS = 6;
+constexpr double TONE_STEP = 0.0627;
+constexpr double TONE_LEVEL = 8000.0;
+
+// A negotiated SBC configuration, 44.1 kHz joint stereo 16 blocks 8 subbands, differing in the maximum bitpool.
+class TestCodecConfig : public A2dpCodecConfig {
+public:
+    explicit TestCodecConfig(uint8_t maxBitpool) : A2dpCodecConfig(A2DP_SOURCE_CODEC_INDEX_SBC)
+    {
+        A2dpSBCCapability cap = {A2DP_SBC_SAMPLE_RATE_44100, A2DP_SBC_CHANNEL_MODE_JOINT_STEREO, A2DP_SBC_BLOCKS_16,
+            A2DP_SBC_SUBBAND_8, A2DP_SBC_ALLOC_MODE_L, A2DP_SBC_MIN_BITPOOL, maxBitpool, A2DP_SAMPLE_BITS_16};
+        (void)BuildSbcInfo(&cap, otaCodecConfig_);
+        codecConfig_.bitsPerSample = A2DP_SAMPLE_BITS_16;
+    }
+    bool SetCodecConfig(const uint8_t *peerCodeInfo, uint8_t *resultCodecInfo) override
+    {
+        (void)peerCodeInfo;
+        (void)resultCodecInfo;
+        return true;
+    }
+    bool SetPeerCodecCapabilities(const uint8_t *peerCapabilities) override
+    {
+        (void)peerCapabilities;
+        return true;
+    }
+};
+
+// Stereo tone standing in for the audio framework, counting what the fan-out reads.
+class ToneSource {
+public:
+    uint32_t Read(uint8_t *buf, uint32_t size)
+    {
+        int16_t *samples = reinterpret_cast<int16_t *>(buf);
+        for (uint32_t i = 0; i < size / sizeof(int16_t); i++) {
+            samples[i] = static_cast<int16_t>(TONE_LEVEL * std::sin(TONE_STEP * static_cast<double>(phase_++ / 2)));
+        }
+        bytesRead += size;
+        return size;
+    }
+    uint64_t bytesRead = 0;
+
+private:
+    uint64_t phase_ = 0;
+};
+
+std::unique_ptr<A2dpEncoder> CreateSbcEncoder(
+    const A2dpEncoderInitPeerParams &peerParams, A2dpCodecConfig &config, A2dpEncoderObserver &observer)
+{
+    return std::make_unique<A2dpSbcEncoder>(&peerParams, &config, &observer);
+}
+
+BtAddr Address(uint8_t index)
+{
+    BtAddr addr = {{0x11, 0x22, 0x33, 0x44, 0x55, index}, BT_PUBLIC_DEVICE_ADDRESS};
+    return addr;
+}
+
+A2dpEncoderInitPeerParams Link()
+{
+    A2dpEncoderInitPeerParams params = {};
+    params.isPeerEdr = true;
+    params.peerSupports3mbps = true;
+    params.peermtu = PEER_MTU;
+    return params;
+}
+
+std::vector<uint8_t> Payload(const Packet *packet)
+{
+    std::vector<uint8_t> data(PacketPayloadSize(packet));
+    PacketPayloadRead(packet, data.data(), 0, data.size());
+    return data;
+}
+
+void Report(const char *name, int sinks, size_t groups, uint64_t encodedFrames, double usPerTick)
+{
+    BenchmarkReport(name)
+        .Add("sinks", sinks)
+        .Add("groups", groups)
+        .Add("ticks", TICKS)
+        .Add("encoded_frames", encodedFrames)
+        .Add("us_per_tick", usPerTick)
+        .Publish();
+}
+
+struct FanoutRun {
+    uint64_t encodedFrames;
+    uint64_t pcmBytes;
+    size_t groups;
+    double usPerTick;
+    std::vector<A2dpSourcePeerStats> stats;
+};
+
+// Streams the tone to sinks 0..n-1, the first highBitpoolSinks of them on the high bitpool configuration.
+FanoutRun Stream(int sinks, int highBitpoolSinks)
+{
+    TestCodecConfig high(HIGH_BITPOOL);
+    TestCodecConfig low(LOW_BITPOOL);
+    ToneSource source;
+    A2dpSourceFanout fanout(CreateSbcEncoder,
+        [&source](uint8_t *buf, uint32_t size) { return source.Read(buf, size); }, LONG_QUEUE);
+    for (int i = 0; i < sinks; i++) {
+        fanout.AddPeer(Address(i), Link(), (i < highBitpoolSinks) ? high : low);
+    }
+
+    uint64_t before = g_encodedFrames;
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < TICKS; tick++) {
+        fanout.SendFrames(0);
+    }
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+
+    FanoutRun result = {g_encodedFrames - before, source.bytesRead, fanout.GetGroupCount(),
+        elapsed.count() / TICKS, {}};
+    for (int i = 0; i < sinks; i++) {
+        result.stats.push_back(fanout.GetPeerStats(Address(i)));
+    }
+    return result;
+}
+}  // namespace
+
+class A2dpSourceFanoutTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+};
+
+/**
+ * @tc.number: A2dpSourceFanout_UnitTest001
+ * @tc.name: EncodesOncePerConfiguration
+ * @tc.desc: Six sinks on two configurations cost the SBC frames of two encoders and one read of the PCM per tick.
+ */
+HWTEST_F(A2dpSourceFanoutTest, A2dpSourceFanout_UnitTest_EncodesOncePerConfiguration, TestSize.Level1)
+{
+    FanoutRun one = Stream(1, 1);
+    FanoutRun six = Stream(SINKS, SINKS - 2);
+    Report("a2dp_source_fanout_1_sink", 1, one.groups, one.encodedFrames, one.usPerTick);
+    Report("a2dp_source_fanout_6_sinks", SINKS, six.groups, six.encodedFrames, six.usPerTick);
+
+    EXPECT_EQ(one.groups, 1u);
+    EXPECT_EQ(six.groups, 2u);
+    EXPECT_GT(one.encodedFrames, static_cast<uint64_t>(TICKS));
+    EXPECT_EQ(six.encodedFrames, 2 * one.encodedFrames);
+    EXPECT_EQ(six.pcmBytes, one.pcmBytes);
+    for (const auto &stats : six.stats) {
+        EXPECT_EQ(stats.queued, static_cast<uint64_t>(TICKS));
+        EXPECT_EQ(stats.dropped, 0u);
+    }
+}
+
+/**
+ * @tc.number: A2dpSourceFanout_UnitTest002
+ * @tc.name: SharesEncodedPayload
+ * @tc.desc: Sinks of one configuration get references to the same encoded packet, another configuration its own.
+ */
+HWTEST_F(A2dpSourceFanoutTest, A2dpSourceFanout_UnitTest_SharesEncodedPayload, TestSize.Level1)
+{
+    TestCodecConfig high(HIGH_BITPOOL);
+    TestCodecConfig low(LOW_BITPOOL);
+    ToneSource source;
+    A2dpSourceFanout fanout(CreateSbcEncoder,
+        [&source](uint8_t *buf, uint32_t size) { return source.Read(buf, size); }, LONG_QUEUE);
+    fanout.AddPeer(Address(0), Link(), high);
+    fanout.AddPeer(Address(1), Link(), high);
+    fanout.AddPeer(Address(2), Link(), low);
+    fanout.SendFrames(0);
+
+    A2dpSourcePacket first = {};
+    A2dpSourcePacket second = {};
+    A2dpSourcePacket other = {};
+    ASSERT_TRUE(fanout.DequeuePacket(Address(0), first));
+    ASSERT_TRUE(fanout.DequeuePacket(Address(1), second));
+    ASSERT_TRUE(fanout.DequeuePacket(Address(2), other));
+    EXPECT_NE(first.packet, second.packet);
+    EXPECT_EQ(BufferPtr(PacketHead(first.packet)), BufferPtr(PacketHead(second.packet)));
+    EXPECT_NE(BufferPtr(PacketHead(first.packet)), BufferPtr(PacketHead(other.packet)));
+    EXPECT_EQ(Payload(first.packet), Payload(second.packet));
+    EXPECT_NE(Payload(first.packet), Payload(other.packet));
+    EXPECT_EQ(first.timeStamp, second.timeStamp);
+    EXPECT_EQ(first.frames, second.frames);
+    PacketFree(first.packet);
+    PacketFree(second.packet);
+    PacketFree(other.packet);
+}
+
+/**
+ * @tc.number: A2dpSourceFanout_UnitTest003
+ * @tc.name: DropsPerPeer
+ * @tc.desc: A sink that stops draining drops its own oldest packets while a sink of the same group loses none.
+ */
+HWTEST_F(A2dpSourceFanoutTest, A2dpSourceFanout_UnitTest_DropsPerPeer, TestSize.Level1)
+{
+    TestCodecConfig high(HIGH_BITPOOL);
+    ToneSource source;
+    A2dpSourceFanout fanout(CreateSbcEncoder,
+        [&source](uint8_t *buf, uint32_t size) { return source.Read(buf, size); }, SHORT_QUEUE);
+    fanout.AddPeer(Address(0), Link(), high);
+    fanout.AddPeer(Address(1), Link(), high);
+
+    std::vector<uint32_t> drained;
+    for (int tick = 0; tick < TICKS; tick++) {
+        fanout.SendFrames(0);
+        A2dpSourcePacket packet = {};
+        while (fanout.DequeuePacket(Address(0), packet)) {
+            drained.push_back(packet.timeStamp);
+            PacketFree(packet.packet);
+        }
+    }
+
+    A2dpSourcePeerStats fast = fanout.GetPeerStats(Address(0));
+    A2dpSourcePeerStats stalled = fanout.GetPeerStats(Address(1));
+    EXPECT_EQ(fast.dropped, 0u);
+    EXPECT_EQ(fast.sent, fast.queued);
+    EXPECT_EQ(drained.size(), fast.queued);
+    for (size_t i = 1; i < drained.size(); i++) {
+        EXPECT_GT(drained[i], drained[i - 1]);
+    }
+    EXPECT_EQ(stalled.queued, fast.queued);
+    EXPECT_EQ(stalled.dropped, stalled.queued - SHORT_QUEUE);
+
+    // The stalled sink is left with the newest packets.
+    A2dpSourcePacket packet = {};
+    ASSERT_TRUE(fanout.DequeuePacket(Address(1), packet));
+    EXPECT_EQ(packet.timeStamp, drained[drained.size() - SHORT_QUEUE]);
+    PacketFree(packet.packet);
+}
+
+/**
+ * @tc.number: A2dpSourceFanout_UnitTest004
+ * @tc.name: PeersComeAndGo
+ * @tc.desc: The group outlives the sink whose config built its encoder, regroups on reconfiguration and goes with
+ *           its last sink.
+ */
+HWTEST_F(A2dpSourceFanoutTest, A2dpSourceFanout_UnitTest_PeersComeAndGo, TestSize.Level1)
+{
+    TestCodecConfig high(HIGH_BITPOOL);
+    TestCodecConfig low(LOW_BITPOOL);
+    ToneSource source;
+    A2dpSourceFanout fanout(CreateSbcEncoder,
+        [&source](uint8_t *buf, uint32_t size) { return source.Read(buf, size); }, LONG_QUEUE);
+    fanout.AddPeer(Address(0), Link(), high);
+    fanout.AddPeer(Address(1), Link(), high);
+    fanout.AddPeer(Address(2), Link(), low);
+    EXPECT_EQ(fanout.GetGroupCount(), 2u);
+
+    fanout.RemovePeer(Address(0));
+    EXPECT_EQ(fanout.GetGroupCount(), 2u);
+    fanout.SendFrames(0);
+    EXPECT_GT(fanout.GetPeerStats(Address(1)).queued, 0u);
+
+    // Sink 2 renegotiates to the configuration of sink 1.
+    fanout.AddPeer(Address(2), Link(), high);
+    EXPECT_EQ(fanout.GetGroupCount(), 1u);
+    fanout.Regroup();
+    EXPECT_EQ(fanout.GetGroupCount(), 1u);
+    EXPECT_EQ(fanout.GetPeers().size(), 2u);
+
+    fanout.RemovePeers([](const BtAddr &) { return true; });
+    EXPECT_EQ(fanout.GetGroupCount(), 0u);
+    EXPECT_TRUE(fanout.GetPeers().empty());
+    uint64_t read = source.bytesRead;
+    fanout.SendFrames(0);
+    EXPECT_EQ(source.bytesRead, read);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,452 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#include "a2dp_encoder_sbc.h"
+#include "a2dp_sbc_bitpool_ctrl.h"
+#include "a2dp_sbc_param_ctrl.h"
+#include "a2dp_source_fanout.h"
+#include "benchmark_report.h"
+#include "packet.h"
+#include "sbc_encoder.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+// The encoder loads libbtsbc with dlopen; the test links the codec sources in directly.
+A2dpSBCDynamicLibCtrl::A2dpSBCDynamicLibCtrl(bool isEncoder) : isEncoder_(isEncoder)
+{}
+
+A2dpSBCDynamicLibCtrl::~A2dpSBCDynamicLibCtrl()
+{}
+
+CODECSbcLib *A2dpSBCDynamicLibCtrl::LoadCodecSbcLib() const
+{
+    auto lib = new CODECSbcLib {};
+    lib->sbcEncoder.createSbcEncode = []() -> sbc::IEncoderBase * { return new sbc::Encoder(); };
+    lib->sbcEncoder.destroySbcEncode = [](sbc::IEncoderBase *encoder) { delete encoder; };
+    return lib;
+}
+
+void A2dpSBCDynamicLibCtrl::UnloadCodecSbcLib(CODECSbcLib *lib) const
+{
+    delete lib;
+}
+
+namespace {
+constexpr uint8_t MAX_BITPOOL = 53;
+constexpr uint16_t PEER_MTU = 895;
+constexpr uint64_t TICK_US = 20000;
+constexpr uint32_t SAMPLE_RATE = 44100;
+constexpr uint32_t FRAME_BYTES = 4;
+constexpr uint64_t US_PER_SECOND = 1000000;
+constexpr uint32_t BYTES_PER_TICK = SAMPLE_RATE / 50 * FRAME_BYTES;
+constexpr size_t QUEUE_LENGTH = 8;
+// Bytes AVDTP and L2CAP put around a media payload.
+constexpr uint32_t MEDIA_OVERHEAD = 13;
+constexpr uint32_t ACL_PACKET_LENGTH = 1021;
+constexpr uint16_t ACL_BUFFERS = 4;
+// The media payload header is in the packet head, the payload starts with an SBC frame header.
+constexpr size_t SBC_SYNC_OFFSET = 0;
+constexpr size_t SBC_BITPOOL_OFFSET = 2;
+constexpr uint8_t SBC_SYNCWORD = 0x9C;
+
+// Scripted link capacity in payload bytes per tick.
+struct Phase {
+    int ticks;
+    uint32_t capacity;
+};
+constexpr uint32_t CLEAR_CAPACITY = 2000;
+constexpr uint32_t CONGESTED_CAPACITY = 600;
+const std::vector<Phase> TRACE = {{50, CLEAR_CAPACITY}, {150, CONGESTED_CAPACITY}, {200, CLEAR_CAPACITY}};
+
+class TestCodecConfig : public A2dpCodecConfig {
+public:
+    TestCodecConfig() : A2dpCodecConfig(A2DP_SOURCE_CODEC_INDEX_SBC)
+    {
+        A2dpSBCCapability cap = {A2DP_SBC_SAMPLE_RATE_44100, A2DP_SBC_CHANNEL_MODE_JOINT_STEREO, A2DP_SBC_BLOCKS_16,
+            A2DP_SBC_SUBBAND_8, A2DP_SBC_ALLOC_MODE_L, A2DP_SBC_MIN_BITPOOL, MAX_BITPOOL, A2DP_SAMPLE_BITS_16};
+        (void)BuildSbcInfo(&cap, otaCodecConfig_);
+        codecConfig_.bitsPerSample = A2DP_SAMPLE_BITS_16;
+    }
+    bool SetCodecConfig(const uint8_t *peerCodeInfo, uint8_t *resultCodecInfo) override
+    {
+        (void)peerCodeInfo;
+        (void)resultCodecInfo;
+        return true;
+    }
+    bool SetPeerCodecCapabilities(const uint8_t *peerCapabilities) override
+    {
+        (void)peerCapabilities;
+        return true;
+    }
+};
+
+// Noise keeps every subband busy, so the frames use the whole bitpool.
+class NoiseSource {
+public:
+    uint32_t Read(uint8_t *buf, uint32_t size)
+    {
+        int16_t *samples = reinterpret_cast<int16_t *>(buf);
+        for (uint32_t i = 0; i < size / sizeof(int16_t); i++) {
+            seed_ = seed_ * 1103515245u + 12345u;
+            samples[i] = static_cast<int16_t>(seed_ >> 16);
+        }
+        bytesRead += size;
+        return size;
+    }
+    uint64_t bytesRead = 0;
+
+private:
+    uint32_t seed_ = 1;
+};
+
+// Controller ACL buffers in front of a radio moving the scripted bytes per tick. Packets without a free buffer wait
+// in the host, and AVDTP stops taking media packets while any do.
+class SimLink {
+public:
+    bool Writable() const
+    {
+        return waiting_.empty();
+    }
+    void Submit(uint32_t bytes)
+    {
+        for (uint32_t left = bytes + MEDIA_OVERHEAD; left > 0;) {
+            uint32_t length = std::min(left, ACL_PACKET_LENGTH);
+            waiting_.push_back(length);
+            left -= length;
+        }
+        Refill();
+    }
+    void Transmit(uint32_t capacity)
+    {
+        uint32_t budget = capacity + carry_;
+        while (!inFlight_.empty() && inFlight_.front() <= budget) {
+            budget -= inFlight_.front();
+            inFlight_.pop_front();
+            completed_++;
+        }
+        carry_ = inFlight_.empty() ? 0 : std::min(budget, ACL_PACKET_LENGTH);
+        Refill();
+    }
+    bool Status(BtmAclFlowStatus &status) const
+    {
+        status.totalPackets = ACL_BUFFERS;
+        status.freePackets = static_cast<uint16_t>(ACL_BUFFERS - inFlight_.size());
+        status.inFlightPackets = static_cast<uint16_t>(inFlight_.size());
+        status.waitingPackets = static_cast<uint16_t>(waiting_.size());
+        status.completedPackets = completed_;
+        return true;
+    }
+
+private:
+    void Refill()
+    {
+        while (!waiting_.empty() && inFlight_.size() < ACL_BUFFERS) {
+            inFlight_.push_back(waiting_.front());
+            waiting_.pop_front();
+        }
+    }
+
+    std::deque<uint32_t> inFlight_ {};
+    std::deque<uint32_t> waiting_ {};
+    uint32_t completed_ = 0;
+    uint32_t carry_ = 0;
+};
+
+std::unique_ptr<A2dpEncoder> CreateSbcEncoder(
+    const A2dpEncoderInitPeerParams &peerParams, A2dpCodecConfig &config, A2dpEncoderObserver &observer)
+{
+    return std::make_unique<A2dpSbcEncoder>(&peerParams, &config, &observer);
+}
+
+BtAddr Address()
+{
+    BtAddr addr = {{0x11, 0x22, 0x33, 0x44, 0x55, 0x66}, BT_PUBLIC_DEVICE_ADDRESS};
+    return addr;
+}
+
+A2dpEncoderInitPeerParams Link()
+{
+    A2dpEncoderInitPeerParams params = {};
+    params.isPeerEdr = true;
+    params.peerSupports3mbps = true;
+    params.peermtu = PEER_MTU;
+    return params;
+}
+
+uint8_t Bitpool(const Packet *packet)
+{
+    uint8_t header[SBC_BITPOOL_OFFSET + 1] = {};
+    PacketPayloadRead(packet, header, 0, sizeof(header));
+    return (header[SBC_SYNC_OFFSET] == SBC_SYNCWORD) ? header[SBC_BITPOOL_OFFSET] : 0;
+}
+
+struct PhaseResult {
+    uint64_t payloadBytes = 0;
+    int ticks = 0;
+    uint8_t minBitpool = UINT8_MAX;
+    uint8_t lastBitpool = 0;
+    double BytesPerTick() const
+    {
+        return (ticks > 0) ? static_cast<double>(payloadBytes) / ticks : 0;
+    }
+};
+
+struct TraceRun {
+    std::vector<PhaseResult> phases;
+    uint64_t dropped;
+    uint64_t sent;
+    // Sent during the last quarter of the final phase.
+    PhaseResult tail;
+};
+
+TraceRun PlayTrace(bool adaptive)
+{
+    TestCodecConfig config;
+    NoiseSource source;
+    SimLink link;
+    A2dpSourceFanout fanout(CreateSbcEncoder,
+        [&source](uint8_t *buf, uint32_t size) { return source.Read(buf, size); }, QUEUE_LENGTH);
+    fanout.SetLinkAdaptation(adaptive);
+    fanout.SetLinkMonitor([&link](const BtAddr &, BtmAclFlowStatus &status) { return link.Status(status); });
+    fanout.AddPeer(Address(), Link(), config);
+
+    TraceRun run = {};
+    uint64_t nowUs = TICK_US;
+    for (size_t p = 0; p < TRACE.size(); p++) {
+        PhaseResult result;
+        int tailStart = TRACE[p].ticks - TRACE[p].ticks / 4;
+        for (int tick = 0; tick < TRACE[p].ticks; tick++, nowUs += TICK_US) {
+            fanout.SendFrames(nowUs);
+            A2dpSourcePacket packet = {};
+            while (link.Writable() && fanout.DequeuePacket(Address(), packet)) {
+                uint8_t bitpool = Bitpool(packet.packet);
+                result.payloadBytes += packet.bytes;
+                result.minBitpool = std::min(result.minBitpool, bitpool);
+                result.lastBitpool = bitpool;
+                if ((p + 1 == TRACE.size()) && (tick >= tailStart)) {
+                    run.tail.payloadBytes += packet.bytes;
+                    run.tail.minBitpool = std::min(run.tail.minBitpool, bitpool);
+                    run.tail.lastBitpool = bitpool;
+                }
+                link.Submit(packet.bytes);
+                PacketFree(packet.packet);
+            }
+            link.Transmit(TRACE[p].capacity);
+            result.ticks++;
+            if ((p + 1 == TRACE.size()) && (tick >= tailStart)) {
+                run.tail.ticks++;
+            }
+        }
+        run.phases.push_back(result);
+    }
+    A2dpSourcePeerStats stats = fanout.GetPeerStats(Address());
+    run.dropped = stats.dropped;
+    run.sent = stats.sent;
+    return run;
+}
+
+void Report(const char *name, const TraceRun &run)
+{
+    BenchmarkReport(name)
+        .Add("dropped", run.dropped)
+        .Add("sent", run.sent)
+        .Add("clear_bytes_per_tick", run.phases[0].BytesPerTick())
+        .Add("congested_bytes_per_tick", run.phases[1].BytesPerTick())
+        .Add("congested_min_bitpool", run.phases[1].minBitpool)
+        .Add("recovered_bytes_per_tick", run.tail.BytesPerTick())
+        .Add("recovered_bitpool", run.tail.lastBitpool)
+        .Publish();
+}
+
+A2dpLinkSample QueueSample(size_t queued)
+{
+    A2dpLinkSample sample {};
+    sample.queuedPackets = queued;
+    sample.queueLength = QUEUE_LENGTH;
+    return sample;
+}
+}  // namespace
+
+class A2dpSourceRateTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+};
+
+/**
+ * @tc.number: A2dpSourceRate_UnitTest001
+ * @tc.name: RidesOutCongestion
+ * @tc.desc: Through a congested stretch the adaptive bitpool drops far fewer packets than the fixed one, and the
+ *           full bitrate is back once the link clears.
+ */
+HWTEST_F(A2dpSourceRateTest, A2dpSourceRate_UnitTest_RidesOutCongestion, TestSize.Level1)
+{
+    TraceRun fixed = PlayTrace(false);
+    TraceRun adaptive = PlayTrace(true);
+    Report("a2dp_source_rate_fixed_bitpool", fixed);
+    Report("a2dp_source_rate_adaptive_bitpool", adaptive);
+
+    EXPECT_EQ(fixed.phases[1].minBitpool, MAX_BITPOOL);
+    EXPECT_GT(fixed.dropped, 0u);
+    EXPECT_LT(adaptive.dropped * 4, fixed.dropped);
+
+    // The congested link carries the smaller frames, inside the negotiated range.
+    EXPECT_EQ(adaptive.phases[0].minBitpool, MAX_BITPOOL);
+    EXPECT_LT(adaptive.phases[1].minBitpool, MAX_BITPOOL);
+    EXPECT_GE(adaptive.phases[1].minBitpool, MAX_BITPOOL / 2);
+    EXPECT_LE(adaptive.phases[1].BytesPerTick(), CONGESTED_CAPACITY);
+
+    // The bitrate recovers when the congestion clears.
+    EXPECT_EQ(adaptive.tail.minBitpool, MAX_BITPOOL);
+    EXPECT_GE(adaptive.tail.BytesPerTick(), adaptive.phases[0].BytesPerTick() * 0.98);
+}
+
+/**
+ * @tc.number: A2dpSourceRate_UnitTest002
+ * @tc.name: PacesOnMonotonicClock
+ * @tc.desc: With a late, jittery timer the encoder reads the PCM of the time passed, while a fixed read per tick
+ *           drifts away from it.
+ */
+HWTEST_F(A2dpSourceRateTest, A2dpSourceRate_UnitTest_PacesOnMonotonicClock, TestSize.Level1)
+{
+    constexpr int ticks = 500;
+    constexpr uint64_t slowTickUs = 20200;
+    constexpr uint64_t stallUs = 70000;
+    constexpr int stallTick = 250;
+    const std::vector<int64_t> jitterUs = {0, 4000, -3000, 1500, -2500};
+
+    TestCodecConfig config;
+    NoiseSource paced;
+    NoiseSource fixed;
+    A2dpSourceFanout pacedFanout(CreateSbcEncoder,
+        [&paced](uint8_t *buf, uint32_t size) { return paced.Read(buf, size); }, QUEUE_LENGTH);
+    A2dpSourceFanout fixedFanout(CreateSbcEncoder,
+        [&fixed](uint8_t *buf, uint32_t size) { return fixed.Read(buf, size); }, QUEUE_LENGTH);
+    pacedFanout.AddPeer(Address(), Link(), config);
+    fixedFanout.AddPeer(Address(), Link(), config);
+
+    uint64_t startUs = TICK_US;
+    uint64_t nowUs = startUs;
+    for (int tick = 0; tick < ticks; tick++) {
+        uint64_t firedUs = nowUs + jitterUs[tick % jitterUs.size()];
+        pacedFanout.SendFrames(firedUs);
+        fixedFanout.SendFrames(0);
+        A2dpSourcePacket packet = {};
+        while (pacedFanout.DequeuePacket(Address(), packet)) {
+            PacketFree(packet.packet);
+        }
+        while (fixedFanout.DequeuePacket(Address(), packet)) {
+            PacketFree(packet.packet);
+        }
+        nowUs += (tick == stallTick) ? stallUs : slowTickUs;
+    }
+
+    // The first tick reads one period, every later one the time since the tick before.
+    uint64_t lastUs = nowUs - slowTickUs + jitterUs[(ticks - 1) % jitterUs.size()];
+    uint64_t expected = (lastUs - startUs) * SAMPLE_RATE / US_PER_SECOND * FRAME_BYTES + BYTES_PER_TICK;
+    int64_t pacedError = static_cast<int64_t>(paced.bytesRead) - static_cast<int64_t>(expected);
+    int64_t fixedError = static_cast<int64_t>(fixed.bytesRead) - static_cast<int64_t>(expected);
+
+    BenchmarkReport("a2dp_source_pacing")
+        .Add("ticks", ticks)
+        .Add("expected_bytes", expected)
+        .Add("paced_error_bytes", pacedError)
+        .Add("fixed_error_bytes", fixedError)
+        .Publish();
+
+    EXPECT_LE(std::llabs(pacedError), static_cast<long long>(FRAME_BYTES));
+    EXPECT_GT(std::llabs(fixedError), static_cast<long long>(BYTES_PER_TICK) * 4);
+}
+
+/**
+ * @tc.number: A2dpSourceRate_UnitTest003
+ * @tc.name: HoldsBitpoolOnFlappingLink
+ * @tc.desc: A link flapping between congested and clear only takes the bitpool down; it comes back up after the
+ *           link stayed clear for the recover time, one step at a time.
+ */
+HWTEST_F(A2dpSourceRateTest, A2dpSourceRate_UnitTest_HoldsBitpoolOnFlappingLink, TestSize.Level1)
+{
+    constexpr int flapTicks = 200;
+    constexpr int flapPeriod = 6;
+    A2dpSbcBitpoolController controller;
+    controller.Reset(MAX_BITPOOL / 2, MAX_BITPOOL);
+
+    uint8_t previous = controller.GetBitpool();
+    for (int tick = 0; tick < flapTicks; tick++) {
+        bool congested = (tick % flapPeriod) < (flapPeriod / 2);
+        uint8_t bitpool = controller.Update(QueueSample(congested ? QUEUE_LENGTH : 0));
+        EXPECT_LE(bitpool, previous);
+        previous = bitpool;
+    }
+    EXPECT_EQ(controller.GetStats().increases, 0u);
+    EXPECT_EQ(controller.GetBitpool(), MAX_BITPOOL / 2);
+
+    int ticksToFull = 0;
+    while (controller.GetBitpool() < MAX_BITPOOL) {
+        uint8_t bitpool = controller.Update(QueueSample(0));
+        EXPECT_LE(bitpool, previous + 2);
+        previous = bitpool;
+        ticksToFull++;
+    }
+    // 500 ms clear, then a step every 100 ms.
+    EXPECT_GT(ticksToFull, 25);
+    EXPECT_LT(ticksToFull, 25 + 5 * (MAX_BITPOOL / 2 / 2 + 1));
+}
+
+/**
+ * @tc.number: A2dpSourceRate_UnitTest004
+ * @tc.name: ReactsToAclCredits
+ * @tc.desc: ACL packets waiting for controller buffers, or exhausted buffers completing nothing, count as congestion
+ *           with an empty media queue; busy buffers that still complete do not.
+ */
+HWTEST_F(A2dpSourceRateTest, A2dpSourceRate_UnitTest_ReactsToAclCredits, TestSize.Level1)
+{
+    A2dpSbcBitpoolController controller;
+    controller.Reset(MAX_BITPOOL / 2, MAX_BITPOOL);
+
+    A2dpLinkSample busy = QueueSample(0);
+    busy.aclValid = true;
+    busy.aclCreditsExhausted = true;
+    busy.inFlightAclPackets = ACL_BUFFERS;
+    busy.completedAclPackets = 1;
+    EXPECT_EQ(controller.Update(busy), MAX_BITPOOL);
+
+    A2dpLinkSample stalled = busy;
+    stalled.completedAclPackets = 0;
+    EXPECT_LT(controller.Update(stalled), MAX_BITPOOL);
+
+    controller.Reset(MAX_BITPOOL / 2, MAX_BITPOOL);
+    A2dpLinkSample waiting = QueueSample(0);
+    waiting.aclValid = true;
+    waiting.waitingAclPackets = 1;
+    EXPECT_LT(controller.Update(waiting), MAX_BITPOOL);
+    EXPECT_EQ(controller.GetStats().congestedTicks, 1u);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+#include "sbc_decoder.h"
+#include "sbc_encoder.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr int FRAME_COUNT = 200;
+constexpr int MAX_DELAY = 256;
+constexpr double TONE_HZ = 1000.0;
+constexpr double TONE_AMPLITUDE = 8000.0;
+constexpr double MIN_SNR_DB = 40.0;
+
+struct RoundTrip {
+    std::vector<int16_t> input;
+    std::vector<int16_t> output;
+};
+
+// Encodes a mono tone frame by frame and decodes every frame again, keeping the first channel of the output.
+RoundTrip EncodeDecode(const sbc::CodecParam &param, int channels, int samplesPerFrame, uint32_t sampleRate)
+{
+    sbc::Encoder encoder;
+    sbc::Decoder decoder;
+    RoundTrip trip;
+    int64_t sample = 0;
+    for (int f = 0; f < FRAME_COUNT; f++) {
+        std::vector<int16_t> pcm(samplesPerFrame * channels);
+        for (int s = 0; s < samplesPerFrame; s++, sample++) {
+            auto value = static_cast<int16_t>(TONE_AMPLITUDE * std::sin(2 * M_PI * TONE_HZ * sample / sampleRate));
+            trip.input.push_back(value);
+            for (int ch = 0; ch < channels; ch++) {
+                pcm[s * channels + ch] = value;
+            }
+        }
+        uint8_t frame[sbc::Encoder::BUFFER_SIZE];
+        size_t encoded = 0;
+        size_t pcmBytes = pcm.size() * sizeof(int16_t);
+        EXPECT_EQ(encoder.SBCEncode(param, reinterpret_cast<uint8_t *>(pcm.data()), pcmBytes, frame, sizeof(frame),
+            &encoded), static_cast<ssize_t>(pcmBytes));
+
+        std::vector<int16_t> decoded(samplesPerFrame * channels);
+        size_t written = 0;
+        decoder.SBCDecode(param, frame, encoded, reinterpret_cast<uint8_t *>(decoded.data()),
+            decoded.size() * sizeof(int16_t), &written);
+        EXPECT_EQ(written, pcmBytes);
+        for (int s = 0; s < samplesPerFrame; s++) {
+            trip.output.push_back(decoded[s * channels]);
+        }
+    }
+    return trip;
+}
+
+// Signal to noise ratio of the decoded tone, at the codec delay that matches the input best.
+double BestSnrDb(const RoundTrip &trip)
+{
+    double best = -INFINITY;
+    size_t length = trip.input.size() - MAX_DELAY;
+    for (int delay = 0; delay < MAX_DELAY; delay++) {
+        double signal = 0;
+        double noise = 0;
+        for (size_t i = MAX_DELAY; i < length; i++) {
+            double error = static_cast<double>(trip.output[i + delay]) - trip.input[i];
+            signal += static_cast<double>(trip.input[i]) * trip.input[i];
+            noise += error * error;
+        }
+        best = std::max(best, 10 * std::log10(signal / std::max(noise, 1.0)));
+    }
+    return best;
+}
+}  // namespace
+
+class SbcCodecTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+};
+
+/**
+ * @tc.number: SbcCodec_UnitTest001
+ * @tc.name: A2dpRoundTrip
+ * @tc.desc: A tone encoded with the A2DP source configuration, 16 blocks of 8 subbands in joint stereo, decodes
+ *           back to the tone.
+ */
+HWTEST_F(SbcCodecTest, SbcCodec_UnitTest_A2dpRoundTrip, TestSize.Level1)
+{
+    sbc::CodecParam param = {sbc::SBC_FREQ_44100, sbc::SBC_BLOCK16, sbc::SBC_SUBBAND8,
+        sbc::SBC_CHANNEL_MODE_JOINT_STEREO, sbc::SBC_ALLOCATION_LOUDNESS, 53, sbc::SBC_ENDIANESS_LE};
+    RoundTrip trip = EncodeDecode(param, 2, 128, 44100);
+
+    double snr = BestSnrDb(trip);
+    GTEST_LOG_(INFO) << "a2dp round trip snr " << snr << " dB";
+    EXPECT_GT(snr, MIN_SNR_DB);
+}
+
+/**
+ * @tc.number: SbcCodec_UnitTest002
+ * @tc.name: MsbcRoundTrip
+ * @tc.desc: mSBC frames hold 15 blocks, so every other frame ends with a block of 8 samples that the encoder
+ *           reads on its own. A tone still decodes back to the tone.
+ */
+HWTEST_F(SbcCodecTest, SbcCodec_UnitTest_MsbcRoundTrip, TestSize.Level1)
+{
+    sbc::CodecParam param = {};
+    param.endian = sbc::SBC_ENDIANESS_LE;
+    param.msbc = 1;
+    RoundTrip trip = EncodeDecode(param, 1, MSBC_BLOCKS * 8, 16000);
+
+    double snr = BestSnrDb(trip);
+    GTEST_LOG_(INFO) << "msbc round trip snr " << snr << " dB";
+    EXPECT_GT(snr, MIN_SNR_DB);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
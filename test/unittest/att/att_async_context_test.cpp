@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "att_async_context.h"
+#include "att_common.h"
+
+using namespace testing::ext;
+
+// The target links with -Wl,--wrap=malloc/calloc so that heap allocations made by the ATT sources are counted.
+namespace {
+std::atomic<uint64_t> g_heapAllocations {0};
+}  // namespace
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t num, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t num, size_t size)
+{
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __real_calloc(num, size);
+}
+}
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr uint16_t CONNECT_HANDLE = 1;
+constexpr int STEADY_ROUNDS = 10000;
+constexpr int OUTSTANDING = 8;
+constexpr int THREAD_NUM = 4;
+}  // namespace
+
+class AttAsyncContextTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+};
+
+/**
+ * @tc.number: AttAsyncContext_UnitTest001
+ * @tc.name: ContextTypesFit
+ * @tc.desc: Every context taken from the slabs by att_send_request.c and att_send_response.c fits in a block.
+ */
+HWTEST_F(AttAsyncContextTest, AttAsyncContext_UnitTest_ContextTypesFit, TestSize.Level1)
+{
+    EXPECT_LE(sizeof(AttError), ATT_ASYNC_CONTEXT_SIZE);
+    EXPECT_LE(sizeof(ErrorResponseAsync), ATT_ASYNC_CONTEXT_SIZE);
+    EXPECT_LE(sizeof(ExchangeMTUAsync), ATT_ASYNC_CONTEXT_SIZE);
+    EXPECT_LE(sizeof(FindInformationRequestAsync), ATT_ASYNC_CONTEXT_SIZE);
+    EXPECT_LE(sizeof(ReadRequestAsync), ATT_ASYNC_CONTEXT_SIZE);
+    EXPECT_LE(sizeof(ReadResponseAsync), ATT_ASYNC_CONTEXT_SIZE);
+    EXPECT_LE(sizeof(ReadBlobRequestAsync), ATT_ASYNC_CONTEXT_SIZE);
+    EXPECT_LE(sizeof(WriteAsync), ATT_ASYNC_CONTEXT_SIZE);
+    EXPECT_LE(sizeof(WriteResponseAsync), ATT_ASYNC_CONTEXT_SIZE);
+    EXPECT_LE(sizeof(PrepareWriteAsync), ATT_ASYNC_CONTEXT_SIZE);
+    EXPECT_LE(sizeof(ExecuteWriteRequestAsync), ATT_ASYNC_CONTEXT_SIZE);
+    EXPECT_GE(ATT_ASYNC_SLAB_NUM, MAXCONNECT);
+}
+
+/**
+ * @tc.number: AttAsyncContext_UnitTest002
+ * @tc.name: SteadyStateNoHeap
+ * @tc.desc: Contexts of the notification and response sizes with a bounded number in flight never touch the
+ *           heap. The send path around them is covered by AttSequence_UnitTest_SteadyStateHeap.
+ */
+HWTEST_F(AttAsyncContextTest, AttAsyncContext_UnitTest_SteadyStateNoHeap, TestSize.Level1)
+{
+    void *inFlight[OUTSTANDING] = {nullptr};
+    uint64_t before = g_heapAllocations.load();
+    for (int round = 0; round < STEADY_ROUNDS; round++) {
+        int slot = round % OUTSTANDING;
+        if (inFlight[slot] != nullptr) {
+            AttAsyncContextFree(inFlight[slot]);
+        }
+        auto *notification = static_cast<WriteAsync *>(AttAsyncContextAlloc(CONNECT_HANDLE, sizeof(WriteAsync)));
+        ASSERT_NE(notification, nullptr);
+        notification->connectHandle = CONNECT_HANDLE;
+        auto *response =
+            static_cast<ReadResponseAsync *>(AttAsyncContextAlloc(MAXCONNECT, sizeof(ReadResponseAsync)));
+        ASSERT_NE(response, nullptr);
+        response->connectHandle = MAXCONNECT;
+        AttAsyncContextFree(response);
+        inFlight[slot] = notification;
+    }
+    for (auto *context : inFlight) {
+        AttAsyncContextFree(context);
+    }
+    EXPECT_EQ(g_heapAllocations.load() - before, 0u);
+}
+
+/**
+ * @tc.number: AttAsyncContext_UnitTest003
+ * @tc.name: HeapFallback
+ * @tc.desc: A full slab, an unknown connect handle and an oversized context fall back to the heap, and are
+ *           released there.
+ */
+HWTEST_F(AttAsyncContextTest, AttAsyncContext_UnitTest_HeapFallback, TestSize.Level1)
+{
+    std::vector<void *> contexts;
+    uint64_t before = g_heapAllocations.load();
+    for (int i = 0; i < ATT_ASYNC_CONTEXT_NUM; i++) {
+        contexts.push_back(AttAsyncContextAlloc(CONNECT_HANDLE, sizeof(WriteAsync)));
+    }
+    EXPECT_EQ(g_heapAllocations.load() - before, 0u);
+
+    contexts.push_back(AttAsyncContextAlloc(CONNECT_HANDLE, sizeof(WriteAsync)));
+    contexts.push_back(AttAsyncContextAlloc(0, sizeof(WriteAsync)));
+    contexts.push_back(AttAsyncContextAlloc(ATT_ASYNC_SLAB_NUM + 1, sizeof(WriteAsync)));
+    contexts.push_back(AttAsyncContextAlloc(CONNECT_HANDLE + 1, ATT_ASYNC_CONTEXT_SIZE + 1));
+    EXPECT_EQ(g_heapAllocations.load() - before, 4u);
+
+    for (auto *context : contexts) {
+        ASSERT_NE(context, nullptr);
+        AttAsyncContextFree(context);
+    }
+
+    before = g_heapAllocations.load();
+    AttAsyncContextFree(AttAsyncContextAlloc(CONNECT_HANDLE, sizeof(WriteAsync)));
+    EXPECT_EQ(g_heapAllocations.load() - before, 0u);
+}
+
+/**
+ * @tc.number: AttAsyncContext_UnitTest004
+ * @tc.name: ConcurrentCallers
+ * @tc.desc: Callers on several threads never get the same block, and contexts freed on another thread return
+ *           to the slab.
+ */
+HWTEST_F(AttAsyncContextTest, AttAsyncContext_UnitTest_ConcurrentCallers, TestSize.Level1)
+{
+    std::atomic<bool> collision {false};
+    uint64_t before = g_heapAllocations.load();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_NUM; t++) {
+        threads.emplace_back([t, &collision]() {
+            WriteAsync *held[OUTSTANDING] = {nullptr};
+            for (int round = 0; round < STEADY_ROUNDS; round++) {
+                for (auto &context : held) {
+                    context = static_cast<WriteAsync *>(AttAsyncContextAlloc(CONNECT_HANDLE, sizeof(WriteAsync)));
+                    context->attHandle = static_cast<uint16_t>(t);
+                }
+                for (auto &context : held) {
+                    if (context->attHandle != t) {
+                        collision = true;
+                    }
+                    AttAsyncContextFree(context);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(collision.load());
+    EXPECT_EQ(g_heapAllocations.load() - before, 0u);
+
+    auto *context = AttAsyncContextAlloc(CONNECT_HANDLE, sizeof(WriteAsync));
+    std::thread([context]() { AttAsyncContextFree(context); }).join();
+    before = g_heapAllocations.load();
+    std::vector<void *> contexts;
+    for (int i = 0; i < ATT_ASYNC_CONTEXT_NUM; i++) {
+        contexts.push_back(AttAsyncContextAlloc(CONNECT_HANDLE, sizeof(WriteAsync)));
+    }
+    EXPECT_EQ(g_heapAllocations.load() - before, 0u);
+    for (auto *held : contexts) {
+        AttAsyncContextFree(held);
+    }
+}
+}  // namespace bluetooth
+}  // namespace OHOS
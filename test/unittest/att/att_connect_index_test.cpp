@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+
+#include "att_connect_index.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr uint32_t RANDOM_SEED = 20220301;
+constexpr int RANDOM_ROUNDS = 20000;
+constexpr uint16_t SLOT_NUM = 22;
+constexpr uint16_t KEY_RANGE = 96;
+}  // namespace
+
+class AttConnectIndexTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {
+        AttConnectIndexClear(&index_);
+    }
+    void TearDown()
+    {}
+
+protected:
+    AttConnectIndex index_ {};
+};
+
+/**
+ * @tc.number: AttConnectIndex_UnitTest001
+ * @tc.name: InsertFindRemove
+ * @tc.desc: Keys resolve to their slot, re-inserting a slot moves it to the new key, removed slots are not found.
+ */
+HWTEST_F(AttConnectIndexTest, AttConnectIndex_UnitTest_InsertFindRemove, TestSize.Level1)
+{
+    const uint16_t aclHandle = 0x0040;
+    const uint16_t otherHandle = 0x0041;
+
+    EXPECT_EQ(AttConnectIndexFind(&index_, aclHandle), ATT_CONNECT_INDEX_NONE);
+    AttConnectIndexInsert(&index_, aclHandle, 3);
+    EXPECT_EQ(AttConnectIndexFind(&index_, aclHandle), 3);
+
+    AttConnectIndexInsert(&index_, otherHandle, 3);
+    EXPECT_EQ(AttConnectIndexFind(&index_, aclHandle), ATT_CONNECT_INDEX_NONE);
+    EXPECT_EQ(AttConnectIndexFind(&index_, otherHandle), 3);
+
+    AttConnectIndexRemove(&index_, 3);
+    AttConnectIndexRemove(&index_, 3);
+    EXPECT_EQ(AttConnectIndexFind(&index_, otherHandle), ATT_CONNECT_INDEX_NONE);
+
+    AttConnectIndexInsert(&index_, aclHandle, ATT_CONNECT_INDEX_SLOTS);
+    EXPECT_EQ(AttConnectIndexFind(&index_, aclHandle), ATT_CONNECT_INDEX_NONE);
+}
+
+/**
+ * @tc.number: AttConnectIndex_UnitTest002
+ * @tc.name: MatchesLinearScan
+ * @tc.desc: Random connect and disconnect sequences give the lowest matching slot, as the linear scan of the
+ *           connect table did.
+ */
+HWTEST_F(AttConnectIndexTest, AttConnectIndex_UnitTest_MatchesLinearScan, TestSize.Level1)
+{
+    std::mt19937 rng(RANDOM_SEED);
+    std::map<uint16_t, uint16_t> slotKey;
+    for (int round = 0; round < RANDOM_ROUNDS; round++) {
+        uint16_t slot = rng() % SLOT_NUM;
+        if (rng() % 2) {
+            uint16_t key = rng() % KEY_RANGE;
+            AttConnectIndexInsert(&index_, key, slot);
+            slotKey[slot] = key;
+        } else {
+            AttConnectIndexRemove(&index_, slot);
+            slotKey.erase(slot);
+        }
+
+        uint16_t probe = rng() % KEY_RANGE;
+        uint16_t expected = ATT_CONNECT_INDEX_NONE;
+        for (const auto &entry : slotKey) {
+            if (entry.second == probe) {
+                expected = entry.first;
+                break;
+            }
+        }
+        ASSERT_EQ(AttConnectIndexFind(&index_, probe), expected) << "round " << round;
+    }
+}
+}  // namespace bluetooth
+}  // namespace OHOS
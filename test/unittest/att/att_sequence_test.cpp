@@ -0,0 +1,483 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "alarm.h"
+#include "att.h"
+#include "att_async_context.h"
+#include "att_common.h"
+#include "att_connect.h"
+#include "btm.h"
+#include "gap_le_if.h"
+#include "l2cap_if.h"
+#include "l2cap_le_if.h"
+#include "module.h"
+#include "packet.h"
+
+using namespace testing::ext;
+
+namespace {
+constexpr uint16_t ACL_HANDLE = 0x0040;
+constexpr uint16_t FIRST_HANDLE = 0x0010;
+constexpr uint16_t VALUE_HANDLE = 0x0020;
+constexpr int STEADY_ROUNDS = 1000;
+
+struct SentPdu {
+    uint8_t opcode;
+    uint16_t handle;
+};
+
+Module *g_attModule = nullptr;
+std::vector<SentPdu> g_sent;
+std::vector<uint16_t> g_clientEvents;
+std::vector<uint16_t> g_serverEvents;
+uint16_t g_connectHandle = 0;
+std::map<Alarm *, bool> g_alarmArmed;
+std::map<Alarm *, std::pair<void (*)(void *), void *>> g_alarmCallbacks;
+
+// The target links with -Wl,--wrap=malloc/calloc/free so that heap use of the ATT and platform sources is counted.
+std::atomic<uint64_t> g_heapAllocations {0};
+std::atomic<uint64_t> g_heapFrees {0};
+
+void RecordPdu(const Packet *pkt)
+{
+    uint8_t pdu[3] = {0};
+    size_t size = PacketSize(pkt);
+    PacketRead(pkt, pdu, 0, size < sizeof(pdu) ? size : sizeof(pdu));
+    g_sent.push_back({pdu[0], static_cast<uint16_t>(pdu[1] | (pdu[2] << 8))});
+}
+}  // namespace
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t num, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size)
+{
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t num, size_t size)
+{
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __real_calloc(num, size);
+}
+
+void __wrap_free(void *ptr)
+{
+    if (ptr != nullptr) {
+        g_heapFrees.fetch_add(1, std::memory_order_relaxed);
+    }
+    __real_free(ptr);
+}
+
+void ModuleRegister(Module *module)
+{
+    if (strcmp(module->name, MODULE_NAME_ATT) == 0) {
+        g_attModule = module;
+    }
+}
+
+Alarm *AlarmCreate(const char *name, bool isPeriodic)
+{
+    // Every startup creates a few alarms per connection slot, each needs a distinct address.
+    return reinterpret_cast<Alarm *>(new char);
+}
+
+void AlarmDelete(Alarm *alarm)
+{
+    g_alarmArmed.erase(alarm);
+    g_alarmCallbacks.erase(alarm);
+    delete reinterpret_cast<char *>(alarm);
+}
+
+int32_t AlarmSet(Alarm *alarm, uint64_t timeMs, void (*callback)(void *parameter), void *parameter)
+{
+    g_alarmArmed[alarm] = true;
+    g_alarmCallbacks[alarm] = {callback, parameter};
+    return 0;
+}
+
+void AlarmCancel(Alarm *alarm)
+{
+    g_alarmArmed[alarm] = false;
+}
+
+int BTM_CreateProcessingQueue(uint8_t queueId, uint16_t size)
+{
+    return BT_SUCCESS;
+}
+
+int BTM_DeleteProcessingQueue(uint8_t queueId)
+{
+    return BT_SUCCESS;
+}
+
+// The ATT processing queue runs tasks inline so every API call has completed when it returns.
+int BTM_RunTaskInProcessingQueue(uint8_t queueId, void (*task)(void *context), void *context)
+{
+    task(context);
+    return BT_SUCCESS;
+}
+
+int L2CIF_LeSendFixChannelData(
+    uint16_t aclHandle, uint16_t cid, Packet *pkt, void (*cb)(uint16_t aclHandle, int result))
+{
+    RecordPdu(pkt);
+    return BT_SUCCESS;
+}
+
+int L2CIF_SendData(uint16_t lcid, const Packet *pkt, void (*cb)(uint16_t lcid, int result))
+{
+    RecordPdu(pkt);
+    return BT_SUCCESS;
+}
+
+int L2CIF_LeRegisterFixChannel(uint16_t cid, const L2capLeFixChannel *chan, void (*cb)(uint16_t cid, int result))
+{
+    return BT_SUCCESS;
+}
+
+int L2CIF_RegisterService(uint16_t lpsm, const L2capService *svc, void *context, void (*cb)(uint16_t lpsm, int result))
+{
+    return BT_SUCCESS;
+}
+
+int L2CIF_LeConnect(const BtAddr *addr, const L2capLeConnectionParameter *param, void (*cb)(const BtAddr *, int))
+{
+    return BT_SUCCESS;
+}
+
+int L2CIF_LeConnectCancel(const BtAddr *addr)
+{
+    return BT_SUCCESS;
+}
+
+void L2CIF_LeDisconnect(uint16_t aclHandle, void (*cb)(uint16_t aclHandle, int result))
+{}
+
+int L2CIF_ConnectReq(const BtAddr *addr, uint16_t lpsm, uint16_t rpsm, void *context,
+    void (*cb)(const BtAddr *addr, uint16_t lcid, int result, void *context))
+{
+    return BT_SUCCESS;
+}
+
+void L2CIF_ConnectRsp(
+    uint16_t lcid, uint8_t id, uint16_t result, uint16_t status, void (*cb)(uint16_t lcid, int result))
+{}
+
+int L2CIF_ConfigReq(uint16_t lcid, const L2capConfigInfo *cfg, void (*cb)(uint16_t lcid, int result))
+{
+    return BT_SUCCESS;
+}
+
+int L2CIF_ConfigRsp(
+    uint16_t lcid, uint8_t id, const L2capConfigInfo *cfg, uint16_t result, void (*cb)(uint16_t lcid, int result))
+{
+    return BT_SUCCESS;
+}
+
+void L2CIF_DisconnectionReq(uint16_t lcid, void (*cb)(uint16_t lcid, int result))
+{}
+
+void L2CIF_DisconnectionRsp(uint16_t lcid, uint8_t id, void (*cb)(uint16_t lcid, int result))
+{}
+
+int GAPIF_RequestSecurityAsync(const BtAddr *addr, const GapRequestSecurityParam *param)
+{
+    return BT_SUCCESS;
+}
+
+int GAPIF_LeDataSignatureGenerationAsync(
+    const BtAddr *addr, GapSignatureData dataInfo, GAPSignatureGenerationResult callback, void *context)
+{
+    return BT_SUCCESS;
+}
+
+int GAPIF_LeDataSignatureConfirmationAsync(const BtAddr *addr, GapSignatureData dataInfo,
+    const uint8_t signature[GAP_SIGNATURE_SIZE], GAPSignatureConfirmationResult callback, void *context)
+{
+    return BT_SUCCESS;
+}
+}
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+void LeConnectCompleted(uint16_t connectHandle, AttLeConnectCallback *data, void *context)
+{
+    g_connectHandle = connectHandle;
+}
+
+void ClientCallback(uint16_t connectHandle, uint16_t event, void *eventData, Buffer *buffer, void *context)
+{
+    g_clientEvents.push_back(event);
+}
+
+void ServerCallback(uint16_t connectHandle, uint16_t event, void *eventData, Buffer *buffer, void *context)
+{
+    g_serverEvents.push_back(event);
+}
+
+void ReceivePdu(const std::vector<uint8_t> &pdu)
+{
+    Packet *pkt = PacketMalloc(0, 0, pdu.size());
+    PacketPayloadWrite(pkt, pdu.data(), 0, pdu.size());
+    AttRecvLeData(ACL_HANDLE, pkt);
+    PacketFree(pkt);
+}
+
+Buffer *Value()
+{
+    Buffer *buffer = BufferMalloc(sizeof(uint32_t));
+    (void)memset(BufferPtr(buffer), 0xA5, sizeof(uint32_t));
+    return buffer;
+}
+
+AttConnectInfo *Connect()
+{
+    uint16_t index = 0;
+    AttConnectInfo *connect = nullptr;
+    AttGetConnectInfoIndexByConnectHandle(g_connectHandle, &index, &connect);
+    return connect;
+}
+
+// Heap allocations of one notification and one read response, checking that each pair frees what it took.
+uint64_t SteadyStateAllocations(Buffer *value)
+{
+    uint64_t perRound = 0;
+    for (int round = 0; round < STEADY_ROUNDS; round++) {
+        uint64_t allocations = g_heapAllocations.load();
+        uint64_t frees = g_heapFrees.load();
+        ATT_HandleValueNotification(g_connectHandle, VALUE_HANDLE, value);
+        ATT_ReadResponse(g_connectHandle, value);
+        allocations = g_heapAllocations.load() - allocations;
+        EXPECT_EQ(g_heapFrees.load() - frees, allocations);
+        if (round == 0) {
+            perRound = allocations;
+        }
+        EXPECT_EQ(allocations, perRound);
+        g_sent.clear();
+    }
+    return perRound;
+}
+
+void ExpireAlarm(Alarm *alarm)
+{
+    ASSERT_TRUE(g_alarmArmed[alarm]);
+    g_alarmArmed[alarm] = false;
+    g_alarmCallbacks[alarm].first(g_alarmCallbacks[alarm].second);
+}
+}  // namespace
+
+class AttSequenceTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {
+        ASSERT_NE(g_attModule, nullptr);
+        g_attModule->startup();
+
+        AttConnectCallback connectCallback = {};
+        connectCallback.attLEConnectCompleted = LeConnectCompleted;
+        ATT_ConnectRegister(connectCallback, nullptr);
+        ATT_ClientDataRegister(ClientCallback, nullptr);
+        ATT_ServerDataRegister(ServerCallback, nullptr);
+
+        BtAddr addr = {{0x01, 0x02, 0x03, 0x04, 0x05, 0x06}, BT_PUBLIC_DEVICE_ADDRESS};
+        AttLeConnected(&addr, ACL_HANDLE, LEROLESLAVE, BT_SUCCESS);
+        ASSERT_NE(Connect(), nullptr);
+
+        g_sent.clear();
+        g_clientEvents.clear();
+        g_serverEvents.clear();
+    }
+    void TearDown()
+    {
+        g_attModule->shutdown();
+        g_connectHandle = 0;
+    }
+};
+
+/**
+ * @tc.number: AttSequence_UnitTest001
+ * @tc.name: NotificationBypassesPendingRequest
+ * @tc.desc: A notification and a write command go out while a read request waits for its response.
+ */
+HWTEST_F(AttSequenceTest, AttSequence_UnitTest_NotificationBypassesPendingRequest, TestSize.Level1)
+{
+    Buffer *value = Value();
+    ATT_ReadRequest(g_connectHandle, FIRST_HANDLE);
+    ATT_ReadRequest(g_connectHandle, FIRST_HANDLE + 1);
+    ATT_HandleValueNotification(g_connectHandle, VALUE_HANDLE, value);
+    ATT_WriteCommand(g_connectHandle, VALUE_HANDLE, value);
+    BufferFree(value);
+
+    ASSERT_EQ(g_sent.size(), 3u);
+    EXPECT_EQ(g_sent[0].opcode, READ_REQUEST);
+    EXPECT_EQ(g_sent[0].handle, FIRST_HANDLE);
+    EXPECT_EQ(g_sent[1].opcode, HANDLE_VALUE_NOTIFICATION);
+    EXPECT_EQ(g_sent[2].opcode, WRITE_COMMAND);
+    EXPECT_EQ(Connect()->sequencedPduCount, 1u);
+    EXPECT_EQ(Connect()->directPduCount, 2u);
+    EXPECT_EQ(ListGetSize(Connect()->instruct), 2);
+}
+
+/**
+ * @tc.number: AttSequence_UnitTest002
+ * @tc.name: ConfirmationLeavesRequestQueue
+ * @tc.desc: Indications are sequenced on their own queue; a confirmation releases the next indication but neither
+ *           completes the pending read request nor sends the queued one.
+ */
+HWTEST_F(AttSequenceTest, AttSequence_UnitTest_ConfirmationLeavesRequestQueue, TestSize.Level1)
+{
+    Buffer *value = Value();
+    ATT_ReadRequest(g_connectHandle, FIRST_HANDLE);
+    ATT_ReadRequest(g_connectHandle, FIRST_HANDLE + 1);
+    ATT_HandleValueIndication(g_connectHandle, VALUE_HANDLE, value);
+    ATT_HandleValueIndication(g_connectHandle, VALUE_HANDLE + 1, value);
+    BufferFree(value);
+
+    ASSERT_EQ(g_sent.size(), 2u);
+    EXPECT_EQ(g_sent[1].opcode, HANDLE_VALUE_INDICATION);
+    EXPECT_EQ(g_sent[1].handle, VALUE_HANDLE);
+    EXPECT_TRUE(g_alarmArmed[Connect()->indicationAlarm]);
+
+    ReceivePdu({HANDLE_VALUE_CONFIRMATION});
+
+    ASSERT_EQ(g_sent.size(), 3u);
+    EXPECT_EQ(g_sent[2].opcode, HANDLE_VALUE_INDICATION);
+    EXPECT_EQ(g_sent[2].handle, VALUE_HANDLE + 1);
+    EXPECT_EQ(ListGetSize(Connect()->instruct), 2);
+    EXPECT_TRUE(g_alarmArmed[Connect()->alarm]);
+    EXPECT_TRUE(g_clientEvents.empty());
+    ASSERT_EQ(g_serverEvents.size(), 1u);
+    EXPECT_EQ(g_serverEvents[0], ATT_HANDLE_VALUE_CONFIRMATION_ID);
+
+    ReceivePdu({HANDLE_VALUE_CONFIRMATION});
+
+    EXPECT_EQ(g_sent.size(), 3u);
+    EXPECT_EQ(ListGetSize(Connect()->indication), 0);
+    EXPECT_FALSE(g_alarmArmed[Connect()->indicationAlarm]);
+    EXPECT_TRUE(g_alarmArmed[Connect()->alarm]);
+}
+
+/**
+ * @tc.number: AttSequence_UnitTest003
+ * @tc.name: RequestOrderUnchanged
+ * @tc.desc: Requests still go out one at a time in submission order, each after the previous response.
+ */
+HWTEST_F(AttSequenceTest, AttSequence_UnitTest_RequestOrderUnchanged, TestSize.Level1)
+{
+    const int requestNum = 3;
+    for (int i = 0; i < requestNum; i++) {
+        ATT_ReadRequest(g_connectHandle, FIRST_HANDLE + i);
+    }
+
+    for (int i = 0; i < requestNum; i++) {
+        ASSERT_EQ(g_sent.size(), static_cast<size_t>(i + 1));
+        EXPECT_EQ(g_sent[i].opcode, READ_REQUEST);
+        EXPECT_EQ(g_sent[i].handle, FIRST_HANDLE + i);
+
+        Buffer *value = Value();
+        ATT_HandleValueNotification(g_connectHandle, VALUE_HANDLE, value);
+        BufferFree(value);
+        g_sent.pop_back();
+
+        ReceivePdu({READ_RESPONSE, 0x01, 0x02});
+    }
+
+    EXPECT_EQ(g_sent.size(), static_cast<size_t>(requestNum));
+    EXPECT_EQ(g_clientEvents.size(), static_cast<size_t>(requestNum));
+    EXPECT_EQ(ListGetSize(Connect()->instruct), 0);
+    EXPECT_FALSE(g_alarmArmed[Connect()->alarm]);
+    EXPECT_EQ(Connect()->sequencedPduCount, static_cast<uint32_t>(requestNum));
+    EXPECT_EQ(Connect()->directPduCount, static_cast<uint32_t>(requestNum));
+}
+
+/**
+ * @tc.number: AttSequence_UnitTest004
+ * @tc.name: TimeOutClearsOwnQueue
+ * @tc.desc: An indication timeout drops the queued indications only, a request timeout the queued requests only.
+ */
+HWTEST_F(AttSequenceTest, AttSequence_UnitTest_TimeOutClearsOwnQueue, TestSize.Level1)
+{
+    Buffer *value = Value();
+    ATT_ReadRequest(g_connectHandle, FIRST_HANDLE);
+    ATT_ReadRequest(g_connectHandle, FIRST_HANDLE + 1);
+    ATT_HandleValueIndication(g_connectHandle, VALUE_HANDLE, value);
+    ATT_HandleValueIndication(g_connectHandle, VALUE_HANDLE + 1, value);
+    BufferFree(value);
+
+    ExpireAlarm(Connect()->indicationAlarm);
+
+    EXPECT_EQ(ListGetSize(Connect()->indication), 0);
+    EXPECT_EQ(ListGetSize(Connect()->instruct), 2);
+    EXPECT_TRUE(g_clientEvents.empty());
+    ASSERT_EQ(g_serverEvents.size(), 1u);
+    EXPECT_EQ(g_serverEvents[0], ATT_TRANSACTION_TIME_OUT_ID);
+
+    Buffer *next = Value();
+    ATT_HandleValueIndication(g_connectHandle, VALUE_HANDLE + 2, next);
+    BufferFree(next);
+
+    ExpireAlarm(Connect()->alarm);
+
+    EXPECT_EQ(ListGetSize(Connect()->instruct), 0);
+    EXPECT_EQ(ListGetSize(Connect()->indication), 1);
+    ASSERT_EQ(g_clientEvents.size(), 1u);
+    EXPECT_EQ(g_clientEvents[0], ATT_TRANSACTION_TIME_OUT_ID);
+    EXPECT_EQ(g_serverEvents.size(), 1u);
+}
+
+/**
+ * @tc.number: AttSequence_UnitTest005
+ * @tc.name: SteadyStateHeap
+ * @tc.desc: Notifications and read responses sent back to back return to the heap everything they take, and
+ *           take their async context from the connection slab: only an exhausted slab adds a heap allocation.
+ *           The value reference, the packet and the processing queue task are still heap allocated per PDU.
+ */
+HWTEST_F(AttSequenceTest, AttSequence_UnitTest_SteadyStateHeap, TestSize.Level1)
+{
+    Buffer *value = Value();
+    g_sent.reserve(2);
+    uint64_t pooled = SteadyStateAllocations(value);
+
+    std::vector<void *> held;
+    for (int i = 0; i < ATT_ASYNC_CONTEXT_NUM; i++) {
+        held.push_back(AttAsyncContextAlloc(g_connectHandle, sizeof(ReadResponseAsync)));
+    }
+    uint64_t exhausted = SteadyStateAllocations(value);
+    for (auto *context : held) {
+        AttAsyncContextFree(context);
+    }
+    BufferFree(value);
+
+    // One context per PDU, two PDUs per round.
+    EXPECT_EQ(exhausted - pooled, 2u);
+    GTEST_LOG_(INFO) << "heap allocations per notification and read response: " << pooled;
+}
+}  // namespace bluetooth
+}  // namespace OHOS
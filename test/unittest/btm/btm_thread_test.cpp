@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "btm_thread.h"
+#include "btstack.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr int WAIT_TIMEOUT_SEC = 5;
+constexpr int BURST_TASKS = 40;
+constexpr int TASK_BUDGET = 16;
+constexpr uint16_t SMALL_QUEUE_SIZE = 2;
+constexpr int BLOCKED_CHECK_MS = 50;
+
+struct Recorder {
+    std::mutex lock;
+    std::vector<int> order;
+    std::promise<void> done;
+    int expected = 0;
+
+    void Add(int value)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        order.push_back(value);
+        if (static_cast<int>(order.size()) == expected) {
+            done.set_value();
+        }
+    }
+};
+
+struct RecordTask {
+    Recorder *recorder;
+    int value;
+};
+
+void RunRecordTask(void *context)
+{
+    auto *task = static_cast<RecordTask *>(context);
+    task->recorder->Add(task->value);
+}
+
+struct ThreadTask {
+    Thread *stackThread;
+    std::promise<bool> onStackThread;
+};
+
+void RunThreadTask(void *context)
+{
+    auto *task = static_cast<ThreadTask *>(context);
+    task->onStackThread.set_value(ThreadIsSelf(task->stackThread) == 0);
+}
+
+void RunNothing(void *context)
+{
+    (void)context;
+}
+
+// Holds the thread of its queue until released, optionally posting to another queue of that thread first.
+struct BlockTask {
+    std::promise<void> started;
+    std::shared_future<void> filled;
+    std::shared_future<void> release;
+    uint8_t selfPostQueue = PROCESSING_QUEUE_ID_MAX;
+    int selfPostResult = BT_SUCCESS;
+};
+
+void RunBlockTask(void *context)
+{
+    auto *task = static_cast<BlockTask *>(context);
+    task->started.set_value();
+    if (task->selfPostQueue != PROCESSING_QUEUE_ID_MAX) {
+        task->filled.wait();
+        task->selfPostResult = BTM_RunTaskInProcessingQueue(task->selfPostQueue, RunNothing, nullptr);
+    }
+    task->release.wait();
+}
+
+bool WaitFor(std::future<void> &future)
+{
+    return future.wait_for(std::chrono::seconds(WAIT_TIMEOUT_SEC)) == std::future_status::ready;
+}
+}  // namespace
+
+class BtmThreadTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {
+        BtmInitThread();
+    }
+    void TearDown()
+    {
+        for (uint8_t id = 0; id < PROCESSING_QUEUE_ID_MAX; id++) {
+            BTM_DeleteProcessingQueue(id);
+        }
+        BtmCloseThread();
+    }
+};
+
+/**
+ * @tc.number: BtmThread_UnitTest001
+ * @tc.name: ThreadGroup
+ * @tc.desc: A moved queue runs on its own thread, pinned or created queues cannot move.
+ */
+HWTEST_F(BtmThreadTest, BtmThread_UnitTest_ThreadGroup, TestSize.Level1)
+{
+    EXPECT_EQ(BTM_SetProcessingQueueThreadGroup(PROCESSING_QUEUE_ID_HCI, 1), BT_BAD_STATUS);
+    EXPECT_EQ(BTM_SetProcessingQueueThreadGroup(PROCESSING_QUEUE_ID_AVDTP, BTM_THREAD_GROUP_MAX), BT_BAD_PARAM);
+    EXPECT_EQ(BTM_SetProcessingQueueThreadGroup(PROCESSING_QUEUE_ID_AVDTP, 1), BT_SUCCESS);
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_AVDTP, BTM_PROCESSING_QUEUE_SIZE_DEFAULT), BT_SUCCESS);
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_SDP, BTM_PROCESSING_QUEUE_SIZE_DEFAULT), BT_SUCCESS);
+    EXPECT_EQ(BTM_SetProcessingQueueThreadGroup(PROCESSING_QUEUE_ID_AVDTP, BTM_THREAD_GROUP_STACK), BT_BAD_STATUS);
+
+    ThreadTask avdtp = {BTM_GetProcessingThread(), {}};
+    ThreadTask sdp = {BTM_GetProcessingThread(), {}};
+    auto avdtpResult = avdtp.onStackThread.get_future();
+    auto sdpResult = sdp.onStackThread.get_future();
+    ASSERT_EQ(BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_AVDTP, RunThreadTask, &avdtp), BT_SUCCESS);
+    ASSERT_EQ(BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_SDP, RunThreadTask, &sdp), BT_SUCCESS);
+    EXPECT_FALSE(avdtpResult.get());
+    EXPECT_TRUE(sdpResult.get());
+
+    // Closing the stack puts every queue back on the stack thread.
+    EXPECT_EQ(BTM_DeleteProcessingQueue(PROCESSING_QUEUE_ID_AVDTP), BT_SUCCESS);
+    EXPECT_EQ(BTM_DeleteProcessingQueue(PROCESSING_QUEUE_ID_SDP), BT_SUCCESS);
+    BtmCloseThread();
+    BtmInitThread();
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_AVDTP, BTM_PROCESSING_QUEUE_SIZE_DEFAULT), BT_SUCCESS);
+    ThreadTask again = {BTM_GetProcessingThread(), {}};
+    auto againResult = again.onStackThread.get_future();
+    ASSERT_EQ(BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_AVDTP, RunThreadTask, &again), BT_SUCCESS);
+    EXPECT_TRUE(againResult.get());
+}
+
+/**
+ * @tc.number: BtmThread_UnitTest002
+ * @tc.name: GroupOrder
+ * @tc.desc: Tasks posted to several queues of one thread run in posting order across the queues, even when
+ *           one queue has more tasks than a wakeup runs.
+ */
+HWTEST_F(BtmThreadTest, BtmThread_UnitTest_GroupOrder, TestSize.Level1)
+{
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_BTM, BTM_PROCESSING_QUEUE_SIZE_DEFAULT), BT_SUCCESS);
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_SDP, BTM_PROCESSING_QUEUE_SIZE_DEFAULT), BT_SUCCESS);
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_RFCOMM, BTM_PROCESSING_QUEUE_SIZE_DEFAULT), BT_SUCCESS);
+
+    std::promise<void> release;
+    BlockTask block;
+    block.release = release.get_future().share();
+    auto started = block.started.get_future();
+    ASSERT_EQ(BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_BTM, RunBlockTask, &block), BT_SUCCESS);
+    ASSERT_TRUE(WaitFor(started));
+
+    // A burst longer than the budget on SDP, then tasks alternating between all three queues.
+    const uint8_t queues[] = {PROCESSING_QUEUE_ID_SDP, PROCESSING_QUEUE_ID_RFCOMM, PROCESSING_QUEUE_ID_BTM};
+    Recorder recorder;
+    recorder.expected = BURST_TASKS + TASK_BUDGET;
+    std::vector<RecordTask> tasks;
+    tasks.reserve(recorder.expected);
+    for (int i = 0; i < recorder.expected; i++) {
+        tasks.push_back({&recorder, i});
+        uint8_t queueId = (i < BURST_TASKS) ? PROCESSING_QUEUE_ID_SDP : queues[i % sizeof(queues)];
+        ASSERT_EQ(BTM_RunTaskInProcessingQueue(queueId, RunRecordTask, &tasks.back()), BT_SUCCESS);
+    }
+
+    auto done = recorder.done.get_future();
+    release.set_value();
+    ASSERT_TRUE(WaitFor(done));
+
+    std::vector<int> expected;
+    for (int i = 0; i < recorder.expected; i++) {
+        expected.push_back(i);
+    }
+    EXPECT_EQ(recorder.order, expected);
+
+    BtmProcessingQueueStats stats = {};
+    ASSERT_EQ(BTM_GetProcessingQueueStats(PROCESSING_QUEUE_ID_SDP, &stats), BT_SUCCESS);
+    EXPECT_EQ(stats.executed, stats.enqueued);
+    EXPECT_EQ(stats.depth, 0u);
+    EXPECT_GE(stats.maxDepth, static_cast<uint32_t>(BURST_TASKS));
+}
+
+/**
+ * @tc.number: BtmThread_UnitTest003
+ * @tc.name: FullQueue
+ * @tc.desc: Posting to a full queue waits for room, except on the thread of the queue, which gets an error.
+ */
+HWTEST_F(BtmThreadTest, BtmThread_UnitTest_FullQueue, TestSize.Level1)
+{
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_BTM, BTM_PROCESSING_QUEUE_SIZE_DEFAULT), BT_SUCCESS);
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_SDP, SMALL_QUEUE_SIZE), BT_SUCCESS);
+
+    std::promise<void> filled;
+    std::promise<void> release;
+    BlockTask block;
+    block.filled = filled.get_future().share();
+    block.release = release.get_future().share();
+    block.selfPostQueue = PROCESSING_QUEUE_ID_SDP;
+    auto started = block.started.get_future();
+    ASSERT_EQ(BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_BTM, RunBlockTask, &block), BT_SUCCESS);
+    ASSERT_TRUE(WaitFor(started));
+
+    Recorder recorder;
+    recorder.expected = SMALL_QUEUE_SIZE + 1;
+    std::vector<RecordTask> tasks;
+    for (int i = 0; i <= SMALL_QUEUE_SIZE; i++) {
+        tasks.push_back({&recorder, i});
+    }
+    for (int i = 0; i < SMALL_QUEUE_SIZE; i++) {
+        ASSERT_EQ(BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_SDP, RunRecordTask, &tasks[i]), BT_SUCCESS);
+    }
+    filled.set_value();
+
+    std::atomic<bool> posted {false};
+    int result = BT_OPERATION_FAILED;
+    std::thread poster([&]() {
+        result = BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_SDP, RunRecordTask, &tasks[SMALL_QUEUE_SIZE]);
+        posted = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(BLOCKED_CHECK_MS));
+    EXPECT_FALSE(posted.load());
+
+    auto done = recorder.done.get_future();
+    release.set_value();
+    poster.join();
+    EXPECT_EQ(result, BT_SUCCESS);
+    ASSERT_TRUE(WaitFor(done));
+    EXPECT_EQ(recorder.order, std::vector<int>({0, 1, 2}));
+    EXPECT_EQ(block.selfPostResult, BT_NO_MEMORY);
+}
+
+/**
+ * @tc.number: BtmThread_UnitTest004
+ * @tc.name: DeleteWithPoster
+ * @tc.desc: Deleting a queue with a poster waiting for room returns after the poster's task ran.
+ */
+HWTEST_F(BtmThreadTest, BtmThread_UnitTest_DeleteWithPoster, TestSize.Level1)
+{
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_BTM, BTM_PROCESSING_QUEUE_SIZE_DEFAULT), BT_SUCCESS);
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_SDP, SMALL_QUEUE_SIZE), BT_SUCCESS);
+
+    std::promise<void> release;
+    BlockTask block;
+    block.release = release.get_future().share();
+    auto started = block.started.get_future();
+    ASSERT_EQ(BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_BTM, RunBlockTask, &block), BT_SUCCESS);
+    ASSERT_TRUE(WaitFor(started));
+
+    Recorder recorder;
+    recorder.expected = SMALL_QUEUE_SIZE + 1;
+    std::vector<RecordTask> tasks;
+    for (int i = 0; i <= SMALL_QUEUE_SIZE; i++) {
+        tasks.push_back({&recorder, i});
+    }
+    for (int i = 0; i < SMALL_QUEUE_SIZE; i++) {
+        ASSERT_EQ(BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_SDP, RunRecordTask, &tasks[i]), BT_SUCCESS);
+    }
+    int result = BT_OPERATION_FAILED;
+    std::thread poster([&]() {
+        result = BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_SDP, RunRecordTask, &tasks[SMALL_QUEUE_SIZE]);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(BLOCKED_CHECK_MS));
+
+    release.set_value();
+    EXPECT_EQ(BTM_DeleteProcessingQueue(PROCESSING_QUEUE_ID_SDP), BT_SUCCESS);
+    poster.join();
+    EXPECT_EQ(result, BT_SUCCESS);
+    std::lock_guard<std::mutex> guard(recorder.lock);
+    EXPECT_EQ(recorder.order, std::vector<int>({0, 1, 2}));
+}
+
+/**
+ * @tc.number: BtmThread_UnitTest005
+ * @tc.name: ChainOrder
+ * @tc.desc: A module on its own thread group posting to L2CAP and then to HCI sees the HCI task run after the
+ *           L2CAP one, even with a backlog on L2CAP.
+ */
+HWTEST_F(BtmThreadTest, BtmThread_UnitTest_ChainOrder, TestSize.Level1)
+{
+    ASSERT_EQ(BTM_SetProcessingQueueThreadGroup(PROCESSING_QUEUE_ID_AVDTP, 1), BT_SUCCESS);
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_BTM, BTM_PROCESSING_QUEUE_SIZE_DEFAULT), BT_SUCCESS);
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_LA2CAP, BTM_PROCESSING_QUEUE_SIZE_DEFAULT), BT_SUCCESS);
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_HCI, BTM_PROCESSING_QUEUE_SIZE_DEFAULT), BT_SUCCESS);
+    ASSERT_EQ(BTM_CreateProcessingQueue(PROCESSING_QUEUE_ID_AVDTP, BTM_PROCESSING_QUEUE_SIZE_DEFAULT), BT_SUCCESS);
+
+    std::promise<void> release;
+    BlockTask block;
+    block.release = release.get_future().share();
+    auto started = block.started.get_future();
+    ASSERT_EQ(BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_BTM, RunBlockTask, &block), BT_SUCCESS);
+    ASSERT_TRUE(WaitFor(started));
+
+    Recorder recorder;
+    recorder.expected = BURST_TASKS + 2;
+    std::vector<RecordTask> tasks;
+    tasks.reserve(recorder.expected);
+    for (int i = 0; i < BURST_TASKS; i++) {
+        tasks.push_back({&recorder, i});
+        ASSERT_EQ(BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_LA2CAP, RunRecordTask, &tasks.back()),
+            BT_SUCCESS);
+    }
+    tasks.push_back({&recorder, BURST_TASKS});
+    tasks.push_back({&recorder, BURST_TASKS + 1});
+
+    struct ChainTask {
+        RecordTask *l2cap;
+        RecordTask *hci;
+        std::promise<bool> posted;
+    } chain = {&tasks[BURST_TASKS], &tasks[BURST_TASKS + 1], {}};
+    auto posted = chain.posted.get_future();
+    auto runChain = [](void *context) {
+        auto *task = static_cast<ChainTask *>(context);
+        bool result = BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_LA2CAP, RunRecordTask, task->l2cap) ==
+            BT_SUCCESS;
+        result = result &&
+            (BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_HCI, RunRecordTask, task->hci) == BT_SUCCESS);
+        task->posted.set_value(result);
+    };
+    ASSERT_EQ(BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_AVDTP, runChain, &chain), BT_SUCCESS);
+    ASSERT_TRUE(posted.get());
+
+    auto done = recorder.done.get_future();
+    release.set_value();
+    ASSERT_TRUE(WaitFor(done));
+    std::vector<int> expected;
+    for (int i = 0; i < recorder.expected; i++) {
+        expected.push_back(i);
+    }
+    EXPECT_EQ(recorder.order, expected);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
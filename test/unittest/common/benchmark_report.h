@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCHMARK_REPORT_H
+#define BENCHMARK_REPORT_H
+
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace OHOS {
+namespace bluetooth {
+/**
+ * @brief One benchmark result as a single line JSON object, {"benchmark":"<name>",...}.
+ *
+ * Publish() logs the line and records it as a property of the running test, so that results can be collected
+ * from the test log or the XML report.
+ */
+class BenchmarkReport {
+public:
+    explicit BenchmarkReport(const std::string &name) : name_(name)
+    {
+        line_ << "{\"benchmark\":\"" << name << "\"";
+    }
+
+    template<typename T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type = 0>
+    BenchmarkReport &Add(const char *key, T value)
+    {
+        line_ << ",\"" << key << "\":" << static_cast<long long>(value);
+        return *this;
+    }
+
+    template<typename T, typename std::enable_if<std::is_unsigned<T>::value, int>::type = 0>
+    BenchmarkReport &Add(const char *key, T value)
+    {
+        line_ << ",\"" << key << "\":" << static_cast<unsigned long long>(value);
+        return *this;
+    }
+
+    BenchmarkReport &Add(const char *key, double value, int precision = 1)
+    {
+        line_ << ",\"" << key << "\":" << std::fixed << std::setprecision(precision) << value;
+        return *this;
+    }
+
+    std::string ToString() const
+    {
+        return line_.str() + "}";
+    }
+
+    /**
+     * @brief Log the line and record it as test property.
+     *
+     * @param property Property name, the benchmark name by default.
+     * @return The JSON line.
+     */
+    std::string Publish(const std::string &property = "") const
+    {
+        std::string line = ToString();
+        GTEST_LOG_(INFO) << line;
+        testing::Test::RecordProperty(property.empty() ? name_ : property, line);
+        return line;
+    }
+
+private:
+    std::string name_;
+    std::ostringstream line_ {};
+};
+}  // namespace bluetooth
+}  // namespace OHOS
+
+#endif  // BENCHMARK_REPORT_H
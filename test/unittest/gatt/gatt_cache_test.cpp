@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "base_def.h"
+#include "bt_def.h"
+#include "gatt_cache.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+const std::string TEST_ADDRESS = "00:11:22:33:44:55";
+const std::string TEST_CACHE_FILE = BT_CONFIG_PATH + "gatt_storage_cache_" + TEST_ADDRESS + "_LE";
+constexpr uint16_t UUID_HEART_RATE_SERVICE = 0x180D;
+constexpr uint16_t UUID_GENERIC_ATTRIBUTE = 0x1801;
+constexpr uint16_t UUID_BATTERY_SERVICE = 0x180F;
+constexpr uint16_t UUID_BATTERY_LEVEL = 0x2A19;
+constexpr uint16_t UUID_CCCD = 0x2902;
+constexpr uint8_t PROPERTY_READ_NOTIFY = 0x12;
+constexpr int LARGE_DATABASE_SERVICES = 100;
+constexpr int LARGE_DATABASE_CHARACTERISTICS = 3;
+constexpr int LOAD_ROUNDS = 100;
+
+GattDevice MakeDevice()
+{
+    GattDevice device;
+    device.addr_ = RawAddress(TEST_ADDRESS);
+    device.transport_ = GATT_TRANSPORT_TYPE_LE;
+    device.isEncryption_ = true;
+    return device;
+}
+
+GattCache::DatabaseHash MakeHash()
+{
+    GattCache::DatabaseHash hash = {};
+    for (size_t i = 0; i < hash.size(); i++) {
+        hash[i] = static_cast<uint8_t>(0xA0 + i);
+    }
+    return hash;
+}
+
+// Service: handle, characteristic: handle + 1, value: handle + 2, CCCD: handle + 3.
+void AddBatteryService(GattCache &cache, uint16_t handle, uint16_t endHandle)
+{
+    cache.AddService(GattCache::Service(true, handle, endHandle, Uuid::ConvertFrom16Bits(UUID_BATTERY_SERVICE)));
+    cache.AddCharacteristic(handle, GattCache::Characteristic(handle + 1, PROPERTY_READ_NOTIFY,
+        handle + 2, Uuid::ConvertFrom16Bits(UUID_BATTERY_LEVEL)));
+    cache.AddDescriptor(handle + 1, GattCache::Descriptor(handle + 3, Uuid::ConvertFrom16Bits(UUID_CCCD)));
+}
+}  // namespace
+
+class GattCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {
+        mkdir(BT_CONFIG_PATH.c_str(), S_IRWXU);
+    }
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {
+        unlink(TEST_CACHE_FILE.c_str());
+    }
+    void TearDown()
+    {
+        unlink(TEST_CACHE_FILE.c_str());
+    }
+};
+
+/**
+ * @tc.number: GattCache001
+ * @tc.name: RoundTrip
+ * @tc.desc: Services, include services, characteristics, descriptors and the database hash survive a store/load.
+ */
+HWTEST_F(GattCacheTest, RoundTrip, TestSize.Level1)
+{
+    GattDevice device = MakeDevice();
+    GattCache stored;
+    stored.AddService(GattCache::Service(true, 0x0001, 0x0005, Uuid::ConvertFrom16Bits(UUID_GENERIC_ATTRIBUTE)));
+    stored.AddService(GattCache::Service(false, 0x0010, 0x0013, Uuid::ConvertFrom16Bits(UUID_BATTERY_SERVICE)));
+    stored.AddService(GattCache::Service(true, 0x0020, 0x0030, Uuid::ConvertFrom16Bits(UUID_HEART_RATE_SERVICE)));
+    stored.AddIncludeService(0x0020, GattCache::IncludeService(0x0021, 0x0010, 0x0013,
+        Uuid::ConvertFrom16Bits(UUID_BATTERY_SERVICE)));
+    stored.AddCharacteristic(0x0010, GattCache::Characteristic(0x0011, PROPERTY_READ_NOTIFY, 0x0012,
+        Uuid::ConvertFrom16Bits(UUID_BATTERY_LEVEL)));
+    stored.AddDescriptor(0x0011, GattCache::Descriptor(0x0013, Uuid::ConvertFrom16Bits(UUID_CCCD)));
+    stored.SetDatabaseHash(MakeHash());
+    ASSERT_EQ(GattStatus::GATT_SUCCESS, stored.StoredToFile(device));
+
+    GattCache loaded;
+    ASSERT_EQ(GattStatus::GATT_SUCCESS, loaded.LoadFromFile(device));
+
+    auto &services = loaded.GetServices();
+    ASSERT_EQ(3u, services.size());
+    EXPECT_FALSE(services[0x0010].isPrimary_);
+    EXPECT_EQ(0x0013, services[0x0010].endHandle_);
+    EXPECT_EQ(Uuid::ConvertFrom16Bits(UUID_HEART_RATE_SERVICE), services[0x0020].uuid_);
+
+    auto includes = loaded.GetIncludeServices(0x0020);
+    ASSERT_NE(nullptr, includes);
+    ASSERT_EQ(1u, includes->size());
+    EXPECT_EQ(0x0010, includes->front().startHandle_);
+    EXPECT_EQ(0x0013, includes->front().endHandle_);
+
+    auto ccc = loaded.GetCharacteristic(0x0012);
+    ASSERT_NE(nullptr, ccc);
+    EXPECT_EQ(0x0011, ccc->handle_);
+    EXPECT_EQ(PROPERTY_READ_NOTIFY, ccc->properties_);
+    EXPECT_EQ(Uuid::ConvertFrom16Bits(UUID_BATTERY_LEVEL), ccc->uuid_);
+
+    auto descriptors = loaded.GetDescriptors(0x0011);
+    ASSERT_NE(nullptr, descriptors.first);
+    EXPECT_EQ(1u, descriptors.first->size());
+    auto desc = loaded.GetDescriptor(0x0013);
+    ASSERT_NE(nullptr, desc);
+    EXPECT_EQ(Uuid::ConvertFrom16Bits(UUID_CCCD), desc->uuid_);
+
+    GattCache::DatabaseHash hash = {};
+    ASSERT_TRUE(loaded.GetDatabaseHash(hash));
+    EXPECT_EQ(MakeHash(), hash);
+}
+
+/**
+ * @tc.number: GattCache002
+ * @tc.name: RejectCorruptedFile
+ * @tc.desc: A truncated or modified cache file is rejected instead of producing a partial database.
+ */
+HWTEST_F(GattCacheTest, RejectCorruptedFile, TestSize.Level1)
+{
+    GattDevice device = MakeDevice();
+    GattCache stored;
+    AddBatteryService(stored, 0x0010, 0x0013);
+    ASSERT_EQ(GattStatus::GATT_SUCCESS, stored.StoredToFile(device));
+
+    struct stat st = {};
+    ASSERT_EQ(0, stat(TEST_CACHE_FILE.c_str(), &st));
+    {
+        std::fstream file(TEST_CACHE_FILE, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(st.st_size - 1);
+        file.put(static_cast<char>(0xFF));
+    }
+    GattCache loaded;
+    EXPECT_NE(GattStatus::GATT_SUCCESS, loaded.LoadFromFile(device));
+    EXPECT_TRUE(loaded.GetServices().empty());
+
+    ASSERT_EQ(0, truncate(TEST_CACHE_FILE.c_str(), st.st_size - 1));
+    EXPECT_NE(GattStatus::GATT_SUCCESS, loaded.LoadFromFile(device));
+
+    unlink(TEST_CACHE_FILE.c_str());
+    EXPECT_EQ(GattStatus::REQUEST_NOT_SUPPORT, loaded.LoadFromFile(device));
+}
+
+/**
+ * @tc.number: GattCache003
+ * @tc.name: LoadLargeDatabase
+ * @tc.desc: Load a database of 1000 attributes and report the reconnect cost of restoring it.
+ */
+HWTEST_F(GattCacheTest, LoadLargeDatabase, TestSize.Level1)
+{
+    GattDevice device = MakeDevice();
+    GattCache stored;
+    constexpr uint16_t serviceSpan = 1 + LARGE_DATABASE_CHARACTERISTICS * 3;
+    for (int i = 0; i < LARGE_DATABASE_SERVICES; i++) {
+        uint16_t handle = 1 + i * serviceSpan;
+        stored.AddService(GattCache::Service(true, handle, handle + serviceSpan - 1,
+            Uuid::ConvertFrom16Bits(UUID_BATTERY_SERVICE)));
+        for (int j = 0; j < LARGE_DATABASE_CHARACTERISTICS; j++) {
+            uint16_t cccHandle = handle + 1 + j * 3;
+            stored.AddCharacteristic(handle, GattCache::Characteristic(cccHandle, PROPERTY_READ_NOTIFY,
+                cccHandle + 1, Uuid::ConvertFrom16Bits(UUID_BATTERY_LEVEL)));
+            stored.AddDescriptor(cccHandle, GattCache::Descriptor(cccHandle + 2, Uuid::ConvertFrom16Bits(UUID_CCCD)));
+        }
+    }
+    stored.SetDatabaseHash(MakeHash());
+    ASSERT_EQ(GattStatus::GATT_SUCCESS, stored.StoredToFile(device));
+
+    GattCache loaded;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < LOAD_ROUNDS; i++) {
+        ASSERT_EQ(GattStatus::GATT_SUCCESS, loaded.LoadFromFile(device));
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    GTEST_LOG_(INFO) << "load " << LARGE_DATABASE_SERVICES * serviceSpan << " attributes: "
+                     << elapsed.count() / LOAD_ROUNDS << " us";
+
+    EXPECT_EQ(static_cast<size_t>(LARGE_DATABASE_SERVICES), loaded.GetServices().size());
+    uint16_t lastValueHandle = LARGE_DATABASE_SERVICES * serviceSpan - 1;
+    EXPECT_NE(nullptr, loaded.GetCharacteristic(lastValueHandle));
+    EXPECT_NE(nullptr, loaded.GetDescriptor(lastValueHandle + 1));
+}
+}  // namespace bluetooth
+}  // namespace OHOS
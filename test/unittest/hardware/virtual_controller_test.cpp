@@ -0,0 +1,707 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <sys/socket.h>
+
+#include "virtual_controller.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr uint16_t HCI_CREATE_CONNECTION = 0x0405;
+constexpr uint16_t HCI_DISCONNECT = 0x0406;
+constexpr uint16_t HCI_ACCEPT_CONNECTION_REQUEST = 0x0409;
+constexpr uint16_t HCI_RESET = 0x0C03;
+constexpr uint16_t HCI_WRITE_SCAN_ENABLE = 0x0C1A;
+constexpr uint16_t HCI_READ_BUFFER_SIZE = 0x1005;
+constexpr uint16_t HCI_READ_BD_ADDR = 0x1009;
+constexpr uint16_t HCI_LE_READ_BUFFER_SIZE = 0x2002;
+constexpr uint16_t HCI_LE_SET_ADVERTISING_ENABLE = 0x200A;
+constexpr uint16_t HCI_LE_SET_SCAN_ENABLE = 0x200C;
+constexpr uint16_t HCI_LE_CREATE_CONNECTION = 0x200D;
+constexpr uint16_t HCI_LE_ENCRYPT = 0x2017;
+constexpr uint16_t HCI_LE_START_ENCRYPTION = 0x2019;
+constexpr uint16_t HCI_LE_LONG_TERM_KEY_REQUEST_REPLY = 0x201A;
+
+constexpr uint8_t HCI_CONNECTION_COMPLETE_EVENT = 0x03;
+constexpr uint8_t HCI_CONNECTION_REQUEST_EVENT = 0x04;
+constexpr uint8_t HCI_DISCONNECTION_COMPLETE_EVENT = 0x05;
+constexpr uint8_t HCI_ENCRYPTION_CHANGE_EVENT = 0x08;
+constexpr uint8_t HCI_COMMAND_COMPLETE_EVENT = 0x0E;
+constexpr uint8_t HCI_COMMAND_STATUS_EVENT = 0x0F;
+constexpr uint8_t HCI_NUMBER_OF_COMPLETED_PACKETS_EVENT = 0x13;
+constexpr uint8_t HCI_LE_META_EVENT = 0x3E;
+constexpr uint8_t HCI_INVALID_HCI_COMMAND_PARAMETERS = 0x12;
+constexpr uint8_t HCI_LE_CONNECTION_COMPLETE_EVENT = 0x01;
+constexpr uint8_t HCI_LE_ADVERTISING_REPORT_EVENT = 0x02;
+constexpr uint8_t HCI_LE_LONG_TERM_KEY_REQUEST_EVENT = 0x05;
+
+constexpr size_t EVENT_HEADER_SIZE = 2;
+constexpr size_t ACL_HEADER_SIZE = 4;
+constexpr size_t L2CAP_HEADER_SIZE = 4;
+constexpr uint16_t HANDLE_MASK = 0x0FFF;
+constexpr uint8_t PB_CONTINUING = 0x01;
+constexpr uint8_t PB_FIRST_NON_FLUSHABLE = 0x00;
+constexpr auto WAIT_TIMEOUT = std::chrono::seconds(3);
+constexpr auto POLL_INTERVAL = std::chrono::milliseconds(1);
+
+constexpr std::array<uint8_t, 6> ADDRESS_A = {0x00, 0x1B, 0xDC, 0x00, 0x00, 0x0A};
+constexpr std::array<uint8_t, 6> ADDRESS_B = {0x00, 0x1B, 0xDC, 0x00, 0x00, 0x0B};
+
+void AppendUint16(std::vector<uint8_t> &out, uint16_t value)
+{
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+uint16_t ReadUint16(const uint8_t *data)
+{
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+void AppendAddress(std::vector<uint8_t> &out, const std::array<uint8_t, 6> &address)
+{
+    out.insert(out.end(), address.rbegin(), address.rend());
+}
+
+// A minimal host: tracks command and ACL credits like the stack does and reassembles L2CAP frames.
+class TestHost {
+public:
+    explicit TestHost(const VirtualControllerConfig &config)
+        : config_(config),
+          aclCredits_(config.totalNumAclDataPackets),
+          leCredits_(config.totalNumLeAclDataPackets),
+          commandCredits_(1),
+          controller_(config, [this](BtPacketType type, const uint8_t *data, size_t size) {
+              OnPacket(type, data, size);
+          })
+    {}
+
+    std::vector<uint8_t> Command(uint16_t opcode, const std::vector<uint8_t> &param)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait_for(lock, WAIT_TIMEOUT, [this]() { return commandCredits_ > 0; });
+            commandCredits_--;
+        }
+        SendCommand(opcode, param);
+        std::vector<uint8_t> event;
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait_for(lock, WAIT_TIMEOUT, [this, opcode, &event]() {
+            for (auto it = events_.begin(); it != events_.end(); ++it) {
+                const std::vector<uint8_t> &candidate = *it;
+                if ((candidate[0] == HCI_COMMAND_COMPLETE_EVENT && ReadUint16(&candidate[3]) == opcode) ||
+                    (candidate[0] == HCI_COMMAND_STATUS_EVENT && ReadUint16(&candidate[4]) == opcode)) {
+                    event = candidate;
+                    events_.erase(it);
+                    return true;
+                }
+            }
+            return false;
+        });
+        return event;
+    }
+
+    // Sends without waiting for a Num_HCI_Command_Packets credit.
+    void SendCommand(uint16_t opcode, const std::vector<uint8_t> &param)
+    {
+        std::vector<uint8_t> packet;
+        AppendUint16(packet, opcode);
+        packet.push_back(static_cast<uint8_t>(param.size()));
+        packet.insert(packet.end(), param.begin(), param.end());
+        controller_.SendFromHost(PACKET_TYPE_CMD, packet.data(), packet.size());
+    }
+
+    std::vector<uint8_t> WaitEvent(uint8_t code, uint8_t subevent = 0)
+    {
+        std::vector<uint8_t> event;
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait_for(lock, WAIT_TIMEOUT, [this, code, subevent, &event]() {
+            for (auto it = events_.begin(); it != events_.end(); ++it) {
+                if ((*it)[0] == code && (code != HCI_LE_META_EVENT || (*it)[EVENT_HEADER_SIZE] == subevent)) {
+                    event = *it;
+                    events_.erase(it);
+                    return true;
+                }
+            }
+            return false;
+        });
+        return event;
+    }
+
+    // Fragments an L2CAP frame to the controller buffer size, sending a fragment only with a credit.
+    void SendFrame(uint16_t handle, bool le, const std::vector<uint8_t> &frame)
+    {
+        size_t mtu = le ? config_.leAclDataPacketLength : config_.aclDataPacketLength;
+        for (size_t offset = 0; offset < frame.size(); offset += mtu) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                int &credits = le ? leCredits_ : aclCredits_;
+                cond_.wait_for(lock, WAIT_TIMEOUT, [&credits]() { return credits > 0; });
+                credits--;
+            }
+            size_t length = std::min(mtu, frame.size() - offset);
+            uint8_t flags = offset == 0 ? PB_FIRST_NON_FLUSHABLE : PB_CONTINUING;
+            SendAcl(handle, flags, frame.data() + offset, length);
+        }
+    }
+
+    void SendAcl(uint16_t handle, uint8_t flags, const uint8_t *data, size_t length)
+    {
+        std::vector<uint8_t> packet;
+        AppendUint16(packet, static_cast<uint16_t>(handle | (flags << 12)));
+        AppendUint16(packet, static_cast<uint16_t>(length));
+        packet.insert(packet.end(), data, data + length);
+        controller_.SendFromHost(PACKET_TYPE_ACL, packet.data(), packet.size());
+    }
+
+    bool PopFrame(std::vector<uint8_t> &frame, std::chrono::milliseconds timeout = std::chrono::milliseconds(0))
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!cond_.wait_for(lock, timeout, [this]() { return !frames_.empty(); })) {
+            return false;
+        }
+        frame = std::move(frames_.front());
+        frames_.pop_front();
+        return true;
+    }
+
+    void WaitFrame(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait_for(lock, timeout, [this]() { return !frames_.empty(); });
+    }
+
+    uint64_t CompletedPackets()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return completedPackets_;
+    }
+
+    void SetLeHandle(uint16_t handle)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        leHandle_ = handle;
+    }
+
+    VirtualControllerConfig config_;
+
+private:
+    int aclCredits_;
+    int leCredits_;
+    int commandCredits_;
+
+public:
+    VirtualController controller_;
+
+private:
+    void OnPacket(BtPacketType type, const uint8_t *data, size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (type == PACKET_TYPE_EVENT) {
+            OnEvent(std::vector<uint8_t>(data, data + size));
+        } else if (type == PACKET_TYPE_ACL && size >= ACL_HEADER_SIZE) {
+            uint8_t flags = data[1] >> 4;
+            if ((flags & 0x03) != PB_CONTINUING) {
+                reassembly_.clear();
+            }
+            reassembly_.insert(reassembly_.end(), data + ACL_HEADER_SIZE, data + size);
+            if (reassembly_.size() >= L2CAP_HEADER_SIZE &&
+                reassembly_.size() >= L2CAP_HEADER_SIZE + ReadUint16(reassembly_.data())) {
+                frames_.push_back(std::move(reassembly_));
+                reassembly_.clear();
+            }
+        }
+        cond_.notify_all();
+    }
+
+    void OnEvent(std::vector<uint8_t> event)
+    {
+        const uint8_t *param = event.data() + EVENT_HEADER_SIZE;
+        if (event[0] == HCI_NUMBER_OF_COMPLETED_PACKETS_EVENT) {
+            for (uint8_t i = 0; i < param[0]; i++) {
+                uint16_t handle = ReadUint16(param + 1 + i * 4) & HANDLE_MASK;
+                uint16_t count = ReadUint16(param + 3 + i * 4);
+                (handle == leHandle_ ? leCredits_ : aclCredits_) += count;
+                completedPackets_ += count;
+            }
+            return;
+        }
+        if (event[0] == HCI_COMMAND_COMPLETE_EVENT) {
+            commandCredits_ = param[0];
+        } else if (event[0] == HCI_COMMAND_STATUS_EVENT) {
+            commandCredits_ = param[1];
+        }
+        events_.push_back(std::move(event));
+    }
+
+    std::mutex mutex_ {};
+    std::condition_variable cond_ {};
+    std::deque<std::vector<uint8_t>> events_ {};
+    std::deque<std::vector<uint8_t>> frames_ {};
+    std::vector<uint8_t> reassembly_ {};
+    uint64_t completedPackets_ = 0;
+    uint16_t leHandle_ = 0xFFFF;
+};
+
+VirtualControllerConfig MakeConfig(const std::array<uint8_t, 6> &address)
+{
+    VirtualControllerConfig config;
+    config.address = address;
+    config.advertisingReportsPerSecond = 0;
+    config.syntheticAdvertisers = 0;
+    return config;
+}
+
+// Profile traffic as the stack frames it, carried in L2CAP frames on one channel.
+struct Scenario {
+    const char *name;
+    bool le;
+    uint16_t cid;
+    // Profile header and trailer around the payload inside the L2CAP frame.
+    size_t headerSize;
+    size_t payloadSize;
+    size_t trailerSize;
+    // Frames in flight before the receiver has to acknowledge or grant credits, 0 without flow control.
+    int window;
+    // Size of the acknowledgement or credit frame, sent for every half window received.
+    size_t ackSize;
+    uint16_t ackCid;
+};
+
+std::vector<uint8_t> BuildFrame(uint16_t cid, size_t bodySize, uint32_t sequence)
+{
+    std::vector<uint8_t> frame;
+    AppendUint16(frame, static_cast<uint16_t>(bodySize));
+    AppendUint16(frame, cid);
+    frame.resize(L2CAP_HEADER_SIZE + bodySize, 0x5A);
+    for (size_t i = 0; i < sizeof(sequence) && i < bodySize; i++) {
+        frame[L2CAP_HEADER_SIZE + i] = static_cast<uint8_t>(sequence >> (i * 8));
+    }
+    return frame;
+}
+
+uint32_t ReadSequence(const std::vector<uint8_t> &frame)
+{
+    uint32_t sequence = 0;
+    for (size_t i = 0; i < sizeof(sequence) && L2CAP_HEADER_SIZE + i < frame.size(); i++) {
+        sequence |= static_cast<uint32_t>(frame[L2CAP_HEADER_SIZE + i]) << (i * 8);
+    }
+    return sequence;
+}
+}  // namespace
+
+class VirtualControllerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {
+        a_ = std::make_unique<TestHost>(MakeConfig(ADDRESS_A));
+        b_ = std::make_unique<TestHost>(MakeConfig(ADDRESS_B));
+    }
+    void TearDown()
+    {
+        a_->controller_.Stop();
+        b_->controller_.Stop();
+    }
+
+    void StartLinked()
+    {
+        a_->controller_.Start();
+        b_->controller_.Start();
+        VirtualController::Link(a_->controller_, b_->controller_);
+    }
+
+    static uint8_t Status(const std::vector<uint8_t> &event)
+    {
+        if (event.empty()) {
+            return 0xFF;
+        }
+        // Command Complete carries the status after the opcode, the other events first.
+        return event[0] == HCI_COMMAND_COMPLETE_EVENT ? event[EVENT_HEADER_SIZE + 3] : event[EVENT_HEADER_SIZE];
+    }
+
+    void ConnectBrEdr(uint16_t &handleA, uint16_t &handleB)
+    {
+        EXPECT_EQ(Status(b_->Command(HCI_WRITE_SCAN_ENABLE, {0x02})), 0);
+        std::vector<uint8_t> param;
+        AppendAddress(param, ADDRESS_B);
+        param.insert(param.end(), {0x18, 0xCC, 0x01, 0x00, 0x00, 0x00, 0x01});
+        EXPECT_EQ(Status(a_->Command(HCI_CREATE_CONNECTION, param)), 0);
+        ASSERT_FALSE(b_->WaitEvent(HCI_CONNECTION_REQUEST_EVENT).empty());
+        param.clear();
+        AppendAddress(param, ADDRESS_A);
+        param.push_back(0x01);
+        EXPECT_EQ(Status(b_->Command(HCI_ACCEPT_CONNECTION_REQUEST, param)), 0);
+        auto completeA = a_->WaitEvent(HCI_CONNECTION_COMPLETE_EVENT);
+        auto completeB = b_->WaitEvent(HCI_CONNECTION_COMPLETE_EVENT);
+        ASSERT_EQ(Status(completeA), 0);
+        ASSERT_EQ(Status(completeB), 0);
+        handleA = ReadUint16(&completeA[EVENT_HEADER_SIZE + 1]);
+        handleB = ReadUint16(&completeB[EVENT_HEADER_SIZE + 1]);
+    }
+
+    void ConnectLe(uint16_t &handleA, uint16_t &handleB)
+    {
+        EXPECT_EQ(Status(b_->Command(HCI_LE_SET_ADVERTISING_ENABLE, {0x01})), 0);
+        std::vector<uint8_t> param = {0x60, 0x00, 0x30, 0x00, 0x00, 0x00};
+        AppendAddress(param, ADDRESS_B);
+        param.insert(param.end(), {0x00, 0x18, 0x00, 0x28, 0x00, 0x00, 0x00, 0xF4, 0x01, 0x00, 0x00, 0x00, 0x00});
+        EXPECT_EQ(Status(a_->Command(HCI_LE_CREATE_CONNECTION, param)), 0);
+        auto completeA = a_->WaitEvent(HCI_LE_META_EVENT, HCI_LE_CONNECTION_COMPLETE_EVENT);
+        auto completeB = b_->WaitEvent(HCI_LE_META_EVENT, HCI_LE_CONNECTION_COMPLETE_EVENT);
+        ASSERT_FALSE(completeA.empty());
+        ASSERT_FALSE(completeB.empty());
+        EXPECT_EQ(completeA[EVENT_HEADER_SIZE + 1], 0);
+        EXPECT_EQ(completeB[EVENT_HEADER_SIZE + 1], 0);
+        handleA = ReadUint16(&completeA[EVENT_HEADER_SIZE + 2]);
+        handleB = ReadUint16(&completeB[EVENT_HEADER_SIZE + 2]);
+        a_->SetLeHandle(handleA);
+        b_->SetLeHandle(handleB);
+    }
+
+    void RunScenario(const Scenario &scenario, uint16_t handleA, uint16_t handleB, int frameNum)
+    {
+        size_t bodySize = scenario.headerSize + scenario.payloadSize + scenario.trailerSize;
+        int sent = 0;
+        int received = 0;
+        int window = scenario.window;
+        int sinceAck = 0;
+        int outOfOrder = 0;
+        std::vector<uint8_t> frame;
+        VirtualController::Stats before = a_->controller_.GetStats();
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + std::chrono::seconds(30);
+        while (received < frameNum && std::chrono::steady_clock::now() < deadline) {
+            while (b_->PopFrame(frame)) {
+                if (ReadSequence(frame) != static_cast<uint32_t>(received) || frame.size() != bodySize + 4) {
+                    outOfOrder++;
+                }
+                received++;
+                if (scenario.window != 0 && ++sinceAck == scenario.window / 2) {
+                    b_->SendFrame(handleB, scenario.le, BuildFrame(scenario.ackCid, scenario.ackSize, 0));
+                    sinceAck = 0;
+                }
+            }
+            while (a_->PopFrame(frame)) {
+                window += scenario.window / 2;
+            }
+            if (sent < frameNum && (scenario.window == 0 || window > 0)) {
+                a_->SendFrame(handleA, scenario.le, BuildFrame(scenario.cid, bodySize, sent));
+                sent++;
+                window--;
+                continue;
+            }
+            b_->WaitFrame(POLL_INTERVAL);
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double kbps = scenario.payloadSize * received * 8 / elapsed / 1000;
+        uint32_t airKbps = scenario.le ? a_->config_.leAirKbps : a_->config_.brEdrAirKbps;
+        // Share of the air time the profile payload gets after L2CAP and profile overhead.
+        double efficiency = static_cast<double>(scenario.payloadSize) / (bodySize + L2CAP_HEADER_SIZE);
+        // The wall clock rate depends on the load of the test machine and is only reported.
+        GTEST_LOG_(INFO) << scenario.name << ": " << static_cast<long>(kbps) << " kbit/s payload, "
+                         << static_cast<long>(airKbps * efficiency) << " kbit/s air limit";
+        EXPECT_EQ(received, frameNum);
+        EXPECT_EQ(outOfOrder, 0);
+
+        // On the controller clock every frame took the air time of its L2CAP frame, so the payload rate is the
+        // air rate scaled by the framing efficiency.
+        VirtualController::Stats stats = a_->controller_.GetStats();
+        uint64_t airTimeUs = stats.aclAirTimeUs - before.aclAirTimeUs;
+        EXPECT_EQ(stats.aclBytesSent - before.aclBytesSent,
+            static_cast<uint64_t>(frameNum) * (bodySize + L2CAP_HEADER_SIZE));
+        ASSERT_NE(airTimeUs, 0u);
+        double airClockKbps = scenario.payloadSize * received * 8.0 * 1000 / airTimeUs;
+        EXPECT_NEAR(airClockKbps, airKbps * efficiency, airKbps * efficiency * 0.01);
+    }
+
+    std::unique_ptr<TestHost> a_;
+    std::unique_ptr<TestHost> b_;
+};
+
+/**
+ * @tc.number: VirtualController_UnitTest001
+ * @tc.name: InitSequence
+ * @tc.desc: Reset and the informational commands the stack reads at startup return the configured values.
+ */
+HWTEST_F(VirtualControllerTest, VirtualController_UnitTest_InitSequence, TestSize.Level1)
+{
+    a_->controller_.Start();
+    EXPECT_EQ(Status(a_->Command(HCI_RESET, {})), 0);
+
+    auto address = a_->Command(HCI_READ_BD_ADDR, {});
+    ASSERT_EQ(address.size(), EVENT_HEADER_SIZE + 4 + 6);
+    std::vector<uint8_t> expected;
+    AppendAddress(expected, ADDRESS_A);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), address.begin() + EVENT_HEADER_SIZE + 4));
+
+    auto buffer = a_->Command(HCI_READ_BUFFER_SIZE, {});
+    ASSERT_GE(buffer.size(), EVENT_HEADER_SIZE + 11);
+    EXPECT_EQ(ReadUint16(&buffer[EVENT_HEADER_SIZE + 4]), a_->config_.aclDataPacketLength);
+    EXPECT_EQ(ReadUint16(&buffer[EVENT_HEADER_SIZE + 7]), a_->config_.totalNumAclDataPackets);
+
+    auto leBuffer = a_->Command(HCI_LE_READ_BUFFER_SIZE, {});
+    ASSERT_GE(leBuffer.size(), EVENT_HEADER_SIZE + 7);
+    EXPECT_EQ(ReadUint16(&leBuffer[EVENT_HEADER_SIZE + 4]), a_->config_.leAclDataPacketLength);
+    EXPECT_EQ(leBuffer[EVENT_HEADER_SIZE + 6], a_->config_.totalNumLeAclDataPackets);
+
+    // FIPS-197 AES-128 example, in the little endian byte order of LE Encrypt.
+    std::vector<uint8_t> param;
+    for (int i = 15; i >= 0; i--) {
+        param.push_back(static_cast<uint8_t>(i));
+    }
+    for (int i = 15; i >= 0; i--) {
+        param.push_back(static_cast<uint8_t>(i * 0x11));
+    }
+    auto encrypted = a_->Command(HCI_LE_ENCRYPT, param);
+    std::vector<uint8_t> cipher = {0x5a, 0xc5, 0xb4, 0x70, 0x80, 0xb7, 0xcd, 0xd8,
+        0x30, 0x04, 0x7b, 0x6a, 0xd8, 0xe0, 0xc4, 0x69};
+    ASSERT_EQ(encrypted.size(), EVENT_HEADER_SIZE + 4 + cipher.size());
+    EXPECT_TRUE(std::equal(cipher.begin(), cipher.end(), encrypted.begin() + EVENT_HEADER_SIZE + 4));
+
+    // Commands shorter than their parameters are rejected with Invalid HCI Command Parameters.
+    param.resize(16);
+    EXPECT_EQ(Status(a_->Command(HCI_LE_ENCRYPT, param)), HCI_INVALID_HCI_COMMAND_PARAMETERS);
+    EXPECT_EQ(Status(a_->Command(HCI_CREATE_CONNECTION, {0x01, 0x02})), HCI_INVALID_HCI_COMMAND_PARAMETERS);
+    EXPECT_EQ(a_->controller_.GetStats().commandFlowViolations, 0u);
+}
+
+/**
+ * @tc.number: VirtualController_UnitTest002
+ * @tc.name: CommandFlowControl
+ * @tc.desc: A command sent without a Num_HCI_Command_Packets credit is counted as a violation.
+ */
+HWTEST_F(VirtualControllerTest, VirtualController_UnitTest_CommandFlowControl, TestSize.Level1)
+{
+    // Both are queued before the controller runs, so the second one was sent before any credit came back.
+    a_->SendCommand(HCI_READ_BD_ADDR, {});
+    a_->SendCommand(HCI_READ_BD_ADDR, {});
+    a_->controller_.Start();
+    a_->WaitEvent(HCI_COMMAND_COMPLETE_EVENT);
+    a_->WaitEvent(HCI_COMMAND_COMPLETE_EVENT);
+    EXPECT_EQ(a_->controller_.GetStats().commandFlowViolations, 1u);
+
+    a_->Command(HCI_READ_BD_ADDR, {});
+    a_->Command(HCI_READ_BD_ADDR, {});
+    EXPECT_EQ(a_->controller_.GetStats().commandFlowViolations, 1u);
+}
+
+/**
+ * @tc.number: VirtualController_UnitTest003
+ * @tc.name: AclCredits
+ * @tc.desc: Number Of Completed Packets returns every buffer, and sending beyond the credits is detected.
+ */
+HWTEST_F(VirtualControllerTest, VirtualController_UnitTest_AclCredits, TestSize.Level1)
+{
+    StartLinked();
+    uint16_t handleA = 0;
+    uint16_t handleB = 0;
+    ConnectBrEdr(handleA, handleB);
+
+    constexpr int packetNum = 40;
+    for (int i = 0; i < packetNum; i++) {
+        a_->SendFrame(handleA, false, BuildFrame(0x0040, 100, i));
+    }
+    std::vector<uint8_t> frame;
+    for (int i = 0; i < packetNum; i++) {
+        ASSERT_TRUE(b_->PopFrame(frame, std::chrono::duration_cast<std::chrono::milliseconds>(WAIT_TIMEOUT)));
+        EXPECT_EQ(ReadSequence(frame), static_cast<uint32_t>(i));
+    }
+    auto deadline = std::chrono::steady_clock::now() + WAIT_TIMEOUT;
+    while (a_->CompletedPackets() < packetNum && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(POLL_INTERVAL);
+    }
+    EXPECT_EQ(a_->CompletedPackets(), static_cast<uint64_t>(packetNum));
+    EXPECT_EQ(a_->controller_.GetStats().aclCreditViolations, 0u);
+
+    std::vector<uint8_t> data = BuildFrame(0x0040, 100, 0);
+    for (int i = 0; i <= a_->config_.totalNumAclDataPackets; i++) {
+        a_->SendAcl(handleA, PB_FIRST_NON_FLUSHABLE, data.data(), data.size());
+    }
+    for (int i = 0; i <= a_->config_.totalNumAclDataPackets; i++) {
+        ASSERT_TRUE(b_->PopFrame(frame, std::chrono::duration_cast<std::chrono::milliseconds>(WAIT_TIMEOUT)));
+    }
+    EXPECT_EQ(a_->controller_.GetStats().aclCreditViolations, 1u);
+}
+
+/**
+ * @tc.number: VirtualController_UnitTest004
+ * @tc.name: AdvertisingReportRate
+ * @tc.desc: Scanning yields advertising reports at the configured rate, including the advertising peer.
+ */
+HWTEST_F(VirtualControllerTest, VirtualController_UnitTest_AdvertisingReportRate, TestSize.Level1)
+{
+    VirtualControllerConfig config = MakeConfig(ADDRESS_A);
+    config.advertisingReportsPerSecond = 200;
+    config.syntheticAdvertisers = 4;
+    a_ = std::make_unique<TestHost>(config);
+    StartLinked();
+    EXPECT_EQ(Status(b_->Command(HCI_LE_SET_ADVERTISING_ENABLE, {0x01})), 0);
+
+    EXPECT_EQ(Status(a_->Command(HCI_LE_SET_SCAN_ENABLE, {0x01, 0x00})), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    EXPECT_EQ(Status(a_->Command(HCI_LE_SET_SCAN_ENABLE, {0x00, 0x00})), 0);
+
+    // Reports are due every period from scan enable on the controller clock, however late the thread ran them.
+    VirtualController::Stats stats = a_->controller_.GetStats();
+    const uint64_t periodUs = 1000000 / config.advertisingReportsPerSecond;
+    GTEST_LOG_(INFO) << "advertising reports in 500 ms at 200/s: " << stats.advertisingReports;
+    EXPECT_GE(stats.advertisingReports, 1u);
+    EXPECT_EQ(stats.lastAdvertisingReportUs % periodUs, 0u);
+    EXPECT_EQ(stats.advertisingReports, stats.lastAdvertisingReportUs / periodUs + 1);
+
+    bool peerSeen = false;
+    std::vector<uint8_t> expected;
+    AppendAddress(expected, ADDRESS_B);
+    for (auto event = a_->WaitEvent(HCI_LE_META_EVENT, HCI_LE_ADVERTISING_REPORT_EVENT); !event.empty();
+         event = a_->WaitEvent(HCI_LE_META_EVENT, HCI_LE_ADVERTISING_REPORT_EVENT)) {
+        peerSeen = peerSeen || std::equal(expected.begin(), expected.end(), event.begin() + EVENT_HEADER_SIZE + 4);
+        if (peerSeen) {
+            break;
+        }
+    }
+    EXPECT_TRUE(peerSeen);
+}
+
+/**
+ * @tc.number: VirtualController_UnitTest005
+ * @tc.name: ConnectEncryptDisconnect
+ * @tc.desc: Linked controllers connect over BR/EDR and LE, encrypt the LE link and report disconnection to both.
+ */
+HWTEST_F(VirtualControllerTest, VirtualController_UnitTest_ConnectEncryptDisconnect, TestSize.Level1)
+{
+    StartLinked();
+    uint16_t brHandleA = 0;
+    uint16_t brHandleB = 0;
+    ConnectBrEdr(brHandleA, brHandleB);
+    uint16_t leHandleA = 0;
+    uint16_t leHandleB = 0;
+    ConnectLe(leHandleA, leHandleB);
+    EXPECT_NE(brHandleA, leHandleA);
+
+    std::vector<uint8_t> param;
+    AppendUint16(param, leHandleA);
+    param.insert(param.end(), 10, 0);
+    param.insert(param.end(), 16, 0x42);
+    EXPECT_EQ(Status(a_->Command(HCI_LE_START_ENCRYPTION, param)), 0);
+    ASSERT_FALSE(b_->WaitEvent(HCI_LE_META_EVENT, HCI_LE_LONG_TERM_KEY_REQUEST_EVENT).empty());
+    param.clear();
+    AppendUint16(param, leHandleB);
+    param.insert(param.end(), 16, 0x42);
+    EXPECT_EQ(Status(b_->Command(HCI_LE_LONG_TERM_KEY_REQUEST_REPLY, param)), 0);
+    auto changeA = a_->WaitEvent(HCI_ENCRYPTION_CHANGE_EVENT);
+    auto changeB = b_->WaitEvent(HCI_ENCRYPTION_CHANGE_EVENT);
+    ASSERT_FALSE(changeA.empty());
+    ASSERT_FALSE(changeB.empty());
+    EXPECT_EQ(Status(changeA), 0);
+    EXPECT_EQ(changeA[EVENT_HEADER_SIZE + 3], 1);
+    EXPECT_EQ(Status(changeB), 0);
+
+    param.clear();
+    AppendUint16(param, brHandleA);
+    param.push_back(0x13);
+    EXPECT_EQ(Status(a_->Command(HCI_DISCONNECT, param)), 0);
+    auto disconnectedA = a_->WaitEvent(HCI_DISCONNECTION_COMPLETE_EVENT);
+    auto disconnectedB = b_->WaitEvent(HCI_DISCONNECTION_COMPLETE_EVENT);
+    ASSERT_FALSE(disconnectedA.empty());
+    ASSERT_FALSE(disconnectedB.empty());
+    EXPECT_EQ(disconnectedA[EVENT_HEADER_SIZE + 3], 0x16);
+    EXPECT_EQ(ReadUint16(&disconnectedB[EVENT_HEADER_SIZE + 1]), brHandleB);
+    EXPECT_EQ(disconnectedB[EVENT_HEADER_SIZE + 3], 0x13);
+
+    // The LE link is still up.
+    std::vector<uint8_t> frame;
+    b_->SendFrame(leHandleB, true, BuildFrame(0x0004, 20, 7));
+    ASSERT_TRUE(a_->PopFrame(frame, std::chrono::duration_cast<std::chrono::milliseconds>(WAIT_TIMEOUT)));
+    EXPECT_EQ(ReadSequence(frame), 7u);
+}
+
+/**
+ * @tc.number: VirtualController_UnitTest006
+ * @tc.name: SocketLink
+ * @tc.desc: Controllers linked over a stream socket, as two stack processes are, connect and exchange data.
+ */
+HWTEST_F(VirtualControllerTest, VirtualController_UnitTest_SocketLink, TestSize.Level1)
+{
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    a_->controller_.Start();
+    b_->controller_.Start();
+    a_->controller_.LinkSocket(fds[0]);
+    b_->controller_.LinkSocket(fds[1]);
+
+    uint16_t handleA = 0;
+    uint16_t handleB = 0;
+    ConnectLe(handleA, handleB);
+    std::vector<uint8_t> frame;
+    a_->SendFrame(handleA, true, BuildFrame(0x0004, 200, 3));
+    ASSERT_TRUE(b_->PopFrame(frame, std::chrono::duration_cast<std::chrono::milliseconds>(WAIT_TIMEOUT)));
+    EXPECT_EQ(ReadSequence(frame), 3u);
+
+    b_->controller_.Stop();
+    auto disconnected = a_->WaitEvent(HCI_DISCONNECTION_COMPLETE_EVENT);
+    ASSERT_FALSE(disconnected.empty());
+    EXPECT_EQ(disconnected[EVENT_HEADER_SIZE + 3], 0x08);
+}
+
+/**
+ * @tc.number: VirtualController_UnitTest007
+ * @tc.name: ProfileThroughput
+ * @tc.desc: Report payload throughput of RFCOMM, L2CAP ERTM, LE credit based channels, ATT notifications
+ *           and AVDTP media framing over the simulated air link, with each profile's flow control.
+ */
+HWTEST_F(VirtualControllerTest, VirtualController_UnitTest_ProfileThroughput, TestSize.Level1)
+{
+    StartLinked();
+    uint16_t brHandleA = 0;
+    uint16_t brHandleB = 0;
+    ConnectBrEdr(brHandleA, brHandleB);
+    uint16_t leHandleA = 0;
+    uint16_t leHandleB = 0;
+    ConnectLe(leHandleA, leHandleB);
+
+    const Scenario scenarios[] = {
+        // UIH frame with credit field and FCS, credits returned in empty UIH frames.
+        {"RFCOMM", false, 0x0040, 5, 990, 1, 8, 6, 0x0040},
+        // I-frames with enhanced control field and FCS, acknowledged by RR S-frames.
+        {"L2CAP ERTM", false, 0x0041, 4, 1009, 2, 10, 4, 0x0041},
+        // First K-frame of each SDU with the SDU length, credits returned by LE Flow Control Credit.
+        {"LE CoC", true, 0x0042, 2, 245, 0, 10, 8, 0x0005},
+        // Handle Value Notification at ATT_MTU 247.
+        {"ATT notification", true, 0x0004, 3, 244, 0, 0, 0, 0x0004},
+        // RTP header and SBC media payload header followed by SBC frames.
+        {"AVDTP media", false, 0x0043, 13, 595, 0, 0, 0, 0x0043},
+    };
+    for (const auto &scenario : scenarios) {
+        RunScenario(scenario, scenario.le ? leHandleA : brHandleA, scenario.le ? leHandleB : brHandleB, 128);
+    }
+    EXPECT_EQ(a_->controller_.GetStats().aclCreditViolations, 0u);
+    EXPECT_EQ(b_->controller_.GetStats().aclCreditViolations, 0u);
+    EXPECT_EQ(a_->controller_.GetStats().commandFlowViolations, 0u);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <ctime>
+#include <utility>
+#include <vector>
+
+#include "btm/btm_thread.h"
+#include "btstack.h"
+#include "hci/cmd/hci_cmd.h"
+#include "hci/hci_def.h"
+#include "hci/hci_error.h"
+#include "hci/hci_internal.h"
+#include "packet.h"
+#include "platform/include/alarm.h"
+#include "platform/include/allocator.h"
+#include "platform/include/thread.h"
+
+using namespace testing::ext;
+
+namespace {
+// Scripted controller: records what the host puts on the wire and answers with Command Complete/Status.
+struct FakeController {
+    std::vector<uint16_t> sent;
+    std::vector<std::pair<uint16_t, uint8_t>> failed;
+    std::vector<uint16_t> disconnectStatus;
+    int timeouts = 0;
+    uint64_t nowMs = 0;
+    AlarmCallback alarmCallback = nullptr;
+    uint64_t alarmMs = 0;
+
+    void Complete(uint16_t opCode, uint8_t credits)
+    {
+        // Same order as HciEventOnCommandCompleteEvent.
+        HciSetNumberOfHciCmd(credits);
+        HciCmdOnCommandComplete(opCode);
+    }
+
+    void Status(uint16_t opCode, uint8_t status, uint8_t credits)
+    {
+        HciSetNumberOfHciCmd(credits);
+        HciCmdOnCommandStatus(opCode, status);
+    }
+
+    void FireAlarm()
+    {
+        AlarmCallback callback = alarmCallback;
+        alarmCallback = nullptr;
+        ASSERT_NE(callback, nullptr);
+        callback(nullptr);
+    }
+};
+
+FakeController g_controller;
+Alarm *const FAKE_ALARM = reinterpret_cast<Alarm *>(0x1);
+Thread *const FAKE_THREAD = reinterpret_cast<Thread *>(0x2);
+constexpr uint64_t CMD_TIMEOUT_MS = 10 * 1000;
+
+int SendDisconnect(uint16_t handle)
+{
+    HciDisconnectParam param = {handle, HCI_REMOTE_USER_TERMINATED_CONNECTION};
+    return HciSendCmd(HciAllocCmd(HCI_DISCONNECT, &param, sizeof(param)));
+}
+
+template<typename Param>
+int SendWithParam(uint16_t opCode, const Param &param)
+{
+    return HciSendCmd(HciAllocCmd(opCode, &param, sizeof(param)));
+}
+
+int Send(uint16_t opCode)
+{
+    return HciSendCmd(HciAllocCmd(opCode, nullptr, 0));
+}
+}  // namespace
+
+extern "C" {
+void HciPushToTxQueue(HciPacket *packet)
+{
+    uint16_t opCode = 0;
+    (void)memcpy(&opCode, BufferPtr(PacketHead(packet->packet)), sizeof(opCode));
+    g_controller.sent.push_back(opCode);
+    PacketFree(packet->packet);
+    MEM_MALLOC.free(packet);
+}
+
+void HciAclOnDisconnectStatus(uint16_t connectionHandle)
+{
+    g_controller.disconnectStatus.push_back(connectionHandle);
+}
+
+void HciOnCmdFailed(uint16_t opCode, uint8_t status, const void *param)
+{
+    g_controller.failed.emplace_back(opCode, status);
+}
+
+void HciOnCmdTimeout()
+{
+    g_controller.timeouts++;
+}
+
+Thread *BTM_GetProcessingThread()
+{
+    return FAKE_THREAD;
+}
+
+void ThreadPostTask(Thread *thread, TaskFunc func, void *context)
+{
+    func(context);
+}
+
+Alarm *AlarmCreate(const char *name, const bool isPeriodic)
+{
+    return FAKE_ALARM;
+}
+
+void AlarmDelete(Alarm *alarm)
+{}
+
+int32_t AlarmSet(Alarm *alarm, uint64_t timeMs, AlarmCallback callback, void *parameter)
+{
+    g_controller.alarmCallback = callback;
+    g_controller.alarmMs = timeMs;
+    return 0;
+}
+
+void AlarmCancel(Alarm *alarm)
+{
+    g_controller.alarmCallback = nullptr;
+}
+
+// Linked with -Wl,--wrap=clock_gettime so command deadlines follow the scripted clock.
+int __wrap_clock_gettime(clockid_t clockId, struct timespec *ts)
+{
+    ts->tv_sec = static_cast<time_t>(g_controller.nowMs / MS_PER_SECOND);
+    ts->tv_nsec = static_cast<long>((g_controller.nowMs % MS_PER_SECOND) * NS_PER_MS);
+    return 0;
+}
+}
+
+namespace OHOS {
+namespace bluetooth {
+class HciCmdPipelineTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {
+        g_controller = FakeController();
+        g_controller.nowMs = CMD_TIMEOUT_MS;
+        HciInitCmd();
+    }
+    void TearDown()
+    {
+        HciCloseCmd();
+    }
+};
+
+/**
+ * @tc.number: HciCmdPipeline_UnitTest001
+ * @tc.name: LinkCriticalOvertakes
+ * @tc.desc: Queued disconnect and LTK reply leave before earlier queued scan and resolving list commands.
+ */
+HWTEST_F(HciCmdPipelineTest, HciCmdPipeline_UnitTest_LinkCriticalOvertakes, TestSize.Level1)
+{
+    EXPECT_EQ(Send(HCI_WRITE_SCAN_ENABLE), BT_SUCCESS);
+    EXPECT_EQ(Send(HCI_LE_SET_SCAN_PARAMETERS), BT_SUCCESS);
+    EXPECT_EQ(Send(HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST), BT_SUCCESS);
+    EXPECT_EQ(SendDisconnect(0x0040), BT_SUCCESS);
+    EXPECT_EQ(Send(HCI_LE_LONG_TERM_KEY_REQUEST_REPLY), BT_SUCCESS);
+    EXPECT_EQ(g_controller.sent, std::vector<uint16_t>({HCI_WRITE_SCAN_ENABLE}));
+
+    g_controller.Complete(HCI_WRITE_SCAN_ENABLE, 1);
+    g_controller.Status(HCI_DISCONNECT, HCI_SUCCESS, 1);
+    g_controller.Complete(HCI_LE_LONG_TERM_KEY_REQUEST_REPLY, 1);
+    g_controller.Complete(HCI_LE_SET_SCAN_PARAMETERS, 1);
+    g_controller.Complete(HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST, 1);
+
+    EXPECT_EQ(g_controller.sent,
+        std::vector<uint16_t>({HCI_WRITE_SCAN_ENABLE, HCI_DISCONNECT, HCI_LE_LONG_TERM_KEY_REQUEST_REPLY,
+            HCI_LE_SET_SCAN_PARAMETERS, HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST}));
+    EXPECT_EQ(g_controller.disconnectStatus, std::vector<uint16_t>({0x0040}));
+    EXPECT_TRUE(g_controller.failed.empty());
+}
+
+/**
+ * @tc.number: HciCmdPipeline_UnitTest002
+ * @tc.name: PipelinedSameOpcode
+ * @tc.desc: With several credits commands go out back to back and completes retire same-opcode commands in order.
+ */
+HWTEST_F(HciCmdPipelineTest, HciCmdPipeline_UnitTest_PipelinedSameOpcode, TestSize.Level1)
+{
+    const uint8_t credits = 4;
+    HciSetNumberOfHciCmd(credits);
+    for (int i = 0; i < credits; i++) {
+        EXPECT_EQ(Send(HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST), BT_SUCCESS);
+    }
+    EXPECT_EQ(Send(HCI_LE_SET_SCAN_PARAMETERS), BT_SUCCESS);
+    EXPECT_EQ(g_controller.sent.size(), static_cast<size_t>(credits));
+
+    g_controller.Complete(HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST, 1);
+    EXPECT_EQ(g_controller.sent.back(), HCI_LE_SET_SCAN_PARAMETERS);
+
+    // A late status for the second resolving list command reports against the oldest one still in flight.
+    g_controller.nowMs += 1;
+    g_controller.Status(HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST, HCI_MEMORY_CAPACITY_EXCEEDED, 0);
+    ASSERT_EQ(g_controller.failed.size(), 1u);
+    EXPECT_EQ(g_controller.failed[0].first, HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST);
+
+    g_controller.Complete(HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST, 0);
+    g_controller.Complete(HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST, 0);
+    g_controller.Complete(HCI_LE_SET_SCAN_PARAMETERS, 1);
+
+    // Nothing is left in flight, so an expiring alarm times nothing out.
+    g_controller.nowMs += CMD_TIMEOUT_MS;
+    g_controller.FireAlarm();
+    EXPECT_EQ(g_controller.timeouts, 0);
+    EXPECT_EQ(g_controller.alarmCallback, nullptr);
+}
+
+/**
+ * @tc.number: HciCmdPipeline_UnitTest003
+ * @tc.name: DeadlineOrderedTimeout
+ * @tc.desc: One alarm covers every command in flight, expires them in deadline order and re-arms for the next.
+ */
+HWTEST_F(HciCmdPipelineTest, HciCmdPipeline_UnitTest_DeadlineOrderedTimeout, TestSize.Level1)
+{
+    const uint64_t gapMs = 3000;
+    HciSetNumberOfHciCmd(3);
+    EXPECT_EQ(Send(HCI_LE_SET_SCAN_PARAMETERS), BT_SUCCESS);
+    EXPECT_EQ(g_controller.alarmMs, CMD_TIMEOUT_MS);
+    g_controller.alarmMs = 0;
+
+    g_controller.nowMs += gapMs;
+    EXPECT_EQ(Send(HCI_WRITE_SCAN_ENABLE), BT_SUCCESS);
+    g_controller.nowMs += gapMs;
+    EXPECT_EQ(Send(HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST), BT_SUCCESS);
+    // Later deadlines do not touch the armed alarm.
+    EXPECT_EQ(g_controller.alarmMs, 0u);
+
+    // The head completes; the alarm still fires at its old deadline and moves on to the next command.
+    g_controller.Complete(HCI_LE_SET_SCAN_PARAMETERS, 1);
+    g_controller.nowMs += CMD_TIMEOUT_MS - gapMs - gapMs;
+    g_controller.FireAlarm();
+    EXPECT_EQ(g_controller.timeouts, 0);
+    EXPECT_EQ(g_controller.alarmMs, gapMs);
+
+    g_controller.nowMs += gapMs;
+    g_controller.FireAlarm();
+    EXPECT_EQ(g_controller.timeouts, 1);
+    ASSERT_EQ(g_controller.failed.size(), 1u);
+    EXPECT_EQ(g_controller.failed[0].first, HCI_WRITE_SCAN_ENABLE);
+    EXPECT_EQ(g_controller.failed[0].second, HCI_TIMEOUT);
+    EXPECT_EQ(g_controller.alarmMs, gapMs);
+
+    // Both expire if the alarm runs late.
+    EXPECT_EQ(Send(HCI_LE_SET_SCAN_PARAMETERS), BT_SUCCESS);
+    g_controller.nowMs += CMD_TIMEOUT_MS;
+    g_controller.FireAlarm();
+    EXPECT_EQ(g_controller.timeouts, 3);
+    ASSERT_EQ(g_controller.failed.size(), 3u);
+    EXPECT_EQ(g_controller.failed[1].first, HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST);
+    EXPECT_EQ(g_controller.failed[2].first, HCI_LE_SET_SCAN_PARAMETERS);
+}
+
+/**
+ * @tc.number: HciCmdPipeline_UnitTest004
+ * @tc.name: SameLinkKeepsOrder
+ * @tc.desc: Link-critical commands do not overtake a queued command for the same connection handle.
+ */
+HWTEST_F(HciCmdPipelineTest, HciCmdPipeline_UnitTest_SameLinkKeepsOrder, TestSize.Level1)
+{
+    EXPECT_EQ(Send(HCI_WRITE_SCAN_ENABLE), BT_SUCCESS);
+    EXPECT_EQ(SendWithParam(HCI_AUTHENTICATION_REQUESTED, HciAuthenticationRequestedParam {0x0040}), BT_SUCCESS);
+    EXPECT_EQ(SendWithParam(HCI_SET_CONNECTION_ENCRYPTION, HciSetConnectionEncryptionParam {0x0040, 0x01}),
+        BT_SUCCESS);
+    EXPECT_EQ(SendDisconnect(0x0041), BT_SUCCESS);
+    EXPECT_EQ(SendDisconnect(0x0040), BT_SUCCESS);
+
+    g_controller.Complete(HCI_WRITE_SCAN_ENABLE, 1);
+    g_controller.Status(HCI_DISCONNECT, HCI_SUCCESS, 1);
+    g_controller.Status(HCI_AUTHENTICATION_REQUESTED, HCI_SUCCESS, 1);
+    g_controller.Status(HCI_SET_CONNECTION_ENCRYPTION, HCI_SUCCESS, 1);
+    g_controller.Status(HCI_DISCONNECT, HCI_SUCCESS, 1);
+
+    EXPECT_EQ(g_controller.sent,
+        std::vector<uint16_t>({HCI_WRITE_SCAN_ENABLE, HCI_DISCONNECT, HCI_AUTHENTICATION_REQUESTED,
+            HCI_SET_CONNECTION_ENCRYPTION, HCI_DISCONNECT}));
+    EXPECT_EQ(g_controller.disconnectStatus, std::vector<uint16_t>({0x0041, 0x0040}));
+    EXPECT_TRUE(g_controller.failed.empty());
+}
+}  // namespace bluetooth
+}  // namespace OHOS
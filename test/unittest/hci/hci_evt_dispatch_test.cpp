@@ -0,0 +1,470 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "benchmark_report.h"
+#include "btstack.h"
+#include "hci/acl/hci_acl.h"
+#include "hci/evt/hci_evt.h"
+#include "hci/hci.h"
+#include "packet.h"
+#include "platform/include/allocator.h"
+
+using namespace testing::ext;
+
+namespace {
+// Set to make MEM_MALLOC fail, as under memory pressure.
+bool g_allocFails = false;
+// Blocks taken from MEM_MALLOC and MEM_CALLOC and not yet freed.
+std::atomic<int64_t> g_liveAllocations {0};
+}
+
+extern "C" {
+// The allocator is the test's own, so that allocations can be made to fail.
+static void *TestMalloc(size_t size)
+{
+    if (g_allocFails) {
+        return nullptr;
+    }
+    g_liveAllocations++;
+    return malloc(size);
+}
+static void *TestCalloc(size_t size)
+{
+    if (g_allocFails) {
+        return nullptr;
+    }
+    g_liveAllocations++;
+    return calloc(1, size);
+}
+static void TestFree(void *ptr)
+{
+    if (ptr != nullptr) {
+        g_liveAllocations--;
+    }
+    free(ptr);
+}
+const Allocator MEM_MALLOC = {TestMalloc, TestFree};
+const Allocator MEM_CALLOC = {TestCalloc, TestFree};
+
+// The command and ACL halves of HCI are not linked into this test.
+void HciEventOnCommandCompleteEvent(Packet *packet)
+{}
+void HciCmdOnCommandStatus(uint16_t opCode, uint8_t status)
+{}
+void HciSetNumberOfHciCmd(uint8_t numberOfHciCmd)
+{}
+void HciAclOnConnectionComplete(uint16_t handle, uint8_t transport)
+{}
+void HciAclOnDisconnectComplete(uint16_t handle)
+{}
+void HciAclOnNumberOfCompletedPacket(uint8_t numberOfHandles, const HciNumberOfCompletedPackets *list)
+{}
+}
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr uint8_t EVENT_MODE_CHANGE = 0x14;
+constexpr uint8_t EVENT_LE_META = 0x3E;
+constexpr uint8_t LE_ADVERTISING_REPORT = 0x02;
+constexpr int IDLE_MODULES = 7;
+constexpr int BENCH_EVENTS = 50000;
+constexpr int CHURN_ROUNDS = 1000;
+constexpr int READ_EVENTS = 20000;
+
+std::vector<int> g_calls;
+
+const std::vector<uint8_t> MODE_CHANGE = {EVENT_MODE_CHANGE, 0x06, 0x00, 0x01, 0x00, 0x02, 0x20, 0x03};
+const std::vector<uint8_t> ADVERTISING_REPORT = {EVENT_LE_META, 0x0F, LE_ADVERTISING_REPORT, 0x01, 0x00, 0x00, 0x11,
+    0x22, 0x33, 0x44, 0x55, 0x66, 0x03, 0x02, 0x01, 0x06, 0xC0};
+
+// HciOnEvent strips the event header from the packet, so every delivery needs a fresh packet.
+void DeliverEvent(const std::vector<uint8_t> &event)
+{
+    Packet *packet = PacketMalloc(0, 0, event.size());
+    PacketPayloadWrite(packet, event.data(), 0, event.size());
+    HciOnEvent(packet);
+    PacketFree(packet);
+}
+
+void OnModeChangeFirst(const HciModeChangeEventParam *eventParam)
+{
+    g_calls.push_back(1);
+}
+
+void OnModeChangeSecond(const HciModeChangeEventParam *eventParam)
+{
+    g_calls.push_back(2);
+}
+
+void OnAdvertisingReport(const HciLeAdvertisingReportEventParam *eventParam)
+{
+    g_calls.push_back(eventParam->numReports);
+}
+
+void OnConnectionComplete(const HciConnectionCompleteEventParam *eventParam)
+{}
+
+std::atomic<bool> g_entered {false};
+std::atomic<bool> g_release {false};
+
+// Holds the dispatch until the test releases it.
+void OnModeChangeBlocking(const HciModeChangeEventParam *eventParam)
+{
+    g_entered = true;
+    while (!g_release) {
+        std::this_thread::yield();
+    }
+}
+
+HciEventCallbacks g_selfRemoving = {};
+
+void OnModeChangeSelfRemoving(const HciModeChangeEventParam *eventParam)
+{
+    g_calls.push_back(HCI_DeregisterEventCallbacks(&g_selfRemoving));
+}
+
+uint64_t HistogramTotal(const HciEventStatistics &statistics)
+{
+    uint64_t total = 0;
+    for (uint32_t bucket : statistics.latencyHistogram) {
+        total += bucket;
+    }
+    return total;
+}
+}  // namespace
+
+class HciEvtDispatchTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {
+        HciInitEvent();
+        g_calls.clear();
+        g_allocFails = false;
+    }
+    void TearDown()
+    {
+        g_allocFails = false;
+        HciCloseEvent();
+    }
+};
+
+/**
+ * @tc.number: HciEvtDispatch_UnitTest001
+ * @tc.name: SubscribersOnly
+ * @tc.desc: An event reaches only modules with that member set, in registration order, and stops after deregister.
+ */
+HWTEST_F(HciEvtDispatchTest, HciEvtDispatch_UnitTest_SubscribersOnly, TestSize.Level1)
+{
+    HciEventCallbacks first = {};
+    first.modeChange = OnModeChangeFirst;
+    HciEventCallbacks idle = {};
+    idle.connectionComplete = OnConnectionComplete;
+    HciEventCallbacks second = {};
+    second.modeChange = OnModeChangeSecond;
+    second.leAdvertisingReport = OnAdvertisingReport;
+
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&first), BT_SUCCESS);
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&idle), BT_SUCCESS);
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&second), BT_SUCCESS);
+
+    const HciEventSubscriberTable *table = HciGetEventSubscriberTable();
+    ASSERT_NE(table, nullptr);
+    size_t slot = HCI_EVENT_CALLBACK_SLOT(modeChange);
+    EXPECT_EQ(table->begin[slot + 1] - table->begin[slot], 2);
+    EXPECT_EQ(table->begin[HCI_EVENT_CALLBACK_SLOTS], 4);
+
+    DeliverEvent(MODE_CHANGE);
+    EXPECT_EQ(g_calls, std::vector<int>({1, 2}));
+
+    g_calls.clear();
+    DeliverEvent(ADVERTISING_REPORT);
+    EXPECT_EQ(g_calls, std::vector<int>({1}));
+
+    EXPECT_EQ(HCI_DeregisterEventCallbacks(&first), BT_SUCCESS);
+    g_calls.clear();
+    DeliverEvent(MODE_CHANGE);
+    EXPECT_EQ(g_calls, std::vector<int>({2}));
+
+    EXPECT_EQ(HCI_DeregisterEventCallbacks(&idle), BT_SUCCESS);
+    EXPECT_EQ(HCI_DeregisterEventCallbacks(&second), BT_SUCCESS);
+    g_calls.clear();
+    DeliverEvent(MODE_CHANGE);
+    DeliverEvent(ADVERTISING_REPORT);
+    EXPECT_TRUE(g_calls.empty());
+}
+
+/**
+ * @tc.number: HciEvtDispatch_UnitTest002
+ * @tc.name: Statistics
+ * @tc.desc: Event codes and LE subevent codes are counted separately and every run lands in one histogram bucket.
+ */
+HWTEST_F(HciEvtDispatchTest, HciEvtDispatch_UnitTest_Statistics, TestSize.Level1)
+{
+    HciEventCallbacks callbacks = {};
+    callbacks.modeChange = OnModeChangeFirst;
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&callbacks), BT_SUCCESS);
+
+    const int modeChanges = 3;
+    for (int i = 0; i < modeChanges; i++) {
+        DeliverEvent(MODE_CHANGE);
+    }
+    DeliverEvent(ADVERTISING_REPORT);
+
+    HciEventStatistics statistics = {};
+    EXPECT_EQ(HCI_GetEventStatistics(EVENT_MODE_CHANGE, &statistics), BT_SUCCESS);
+    EXPECT_EQ(statistics.count, static_cast<uint64_t>(modeChanges));
+    EXPECT_EQ(HistogramTotal(statistics), statistics.count);
+    EXPECT_GE(statistics.totalNs, statistics.maxNs);
+
+    EXPECT_EQ(HCI_GetEventStatistics(EVENT_LE_META, &statistics), BT_SUCCESS);
+    EXPECT_EQ(statistics.count, 1u);
+    EXPECT_EQ(HCI_GetLeEventStatistics(LE_ADVERTISING_REPORT, &statistics), BT_SUCCESS);
+    EXPECT_EQ(statistics.count, 1u);
+    EXPECT_EQ(HistogramTotal(statistics), 1u);
+
+    EXPECT_EQ(HCI_GetEventStatistics(0xFF, &statistics), BT_BAD_PARAM);
+    EXPECT_EQ(HCI_GetLeEventStatistics(LE_ADVERTISING_REPORT, nullptr), BT_BAD_PARAM);
+
+    HCI_ResetEventStatistics();
+    EXPECT_EQ(HCI_GetEventStatistics(EVENT_MODE_CHANGE, &statistics), BT_SUCCESS);
+    EXPECT_EQ(statistics.count, 0u);
+
+    EXPECT_EQ(HCI_DeregisterEventCallbacks(&callbacks), BT_SUCCESS);
+}
+
+/**
+ * @tc.number: HciEvtDispatch_UnitTest003
+ * @tc.name: Latency
+ * @tc.desc: Dispatch cost of LE advertising reports and mode changes with one subscriber among eight modules.
+ */
+HWTEST_F(HciEvtDispatchTest, HciEvtDispatch_UnitTest_Latency, TestSize.Level1)
+{
+    std::vector<HciEventCallbacks> idle(IDLE_MODULES);
+    for (auto &callbacks : idle) {
+        callbacks = {};
+        callbacks.connectionComplete = OnConnectionComplete;
+        EXPECT_EQ(HCI_RegisterEventCallbacks(&callbacks), BT_SUCCESS);
+    }
+    HciEventCallbacks subscriber = {};
+    subscriber.modeChange = OnModeChangeFirst;
+    subscriber.leAdvertisingReport = OnAdvertisingReport;
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&subscriber), BT_SUCCESS);
+
+    auto measure = [](const char *name, const std::vector<uint8_t> &event) {
+        std::vector<Packet *> packets(BENCH_EVENTS);
+        for (auto &packet : packets) {
+            packet = PacketMalloc(0, 0, event.size());
+            PacketPayloadWrite(packet, event.data(), 0, event.size());
+        }
+        g_calls.clear();
+        g_calls.reserve(BENCH_EVENTS);
+        auto start = std::chrono::steady_clock::now();
+        for (Packet *packet : packets) {
+            HciOnEvent(packet);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        BenchmarkReport(name)
+            .Add("ns_per_event", seconds * 1e9 / BENCH_EVENTS)
+            .Add("modules", IDLE_MODULES + 1)
+            .Publish();
+        EXPECT_EQ(g_calls.size(), static_cast<size_t>(BENCH_EVENTS));
+        for (Packet *packet : packets) {
+            PacketFree(packet);
+        }
+    };
+
+    measure("HciDispatchLeAdvertisingReport", ADVERTISING_REPORT);
+    measure("HciDispatchModeChange", MODE_CHANGE);
+
+    EXPECT_EQ(HCI_DeregisterEventCallbacks(&subscriber), BT_SUCCESS);
+    for (auto &callbacks : idle) {
+        EXPECT_EQ(HCI_DeregisterEventCallbacks(&callbacks), BT_SUCCESS);
+    }
+}
+
+/**
+ * @tc.number: HciEvtDispatch_UnitTest004
+ * @tc.name: DeregisterWaitsForDispatch
+ * @tc.desc: Deregistration returns only after a dispatch running on another thread has left the callbacks.
+ */
+HWTEST_F(HciEvtDispatchTest, HciEvtDispatch_UnitTest_DeregisterWaitsForDispatch, TestSize.Level1)
+{
+    HciEventCallbacks callbacks = {};
+    callbacks.modeChange = OnModeChangeBlocking;
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&callbacks), BT_SUCCESS);
+
+    g_entered = false;
+    g_release = false;
+    std::thread dispatcher([]() { DeliverEvent(MODE_CHANGE); });
+    while (!g_entered) {
+        std::this_thread::yield();
+    }
+
+    std::atomic<bool> deregistered {false};
+    std::thread deregistration([&callbacks, &deregistered]() {
+        EXPECT_EQ(HCI_DeregisterEventCallbacks(&callbacks), BT_SUCCESS);
+        deregistered = true;
+    });
+    const int settleMs = 50;
+    std::this_thread::sleep_for(std::chrono::milliseconds(settleMs));
+    EXPECT_FALSE(deregistered);
+
+    g_release = true;
+    dispatcher.join();
+    deregistration.join();
+    EXPECT_TRUE(deregistered);
+}
+
+/**
+ * @tc.number: HciEvtDispatch_UnitTest005
+ * @tc.name: DeregisterFromCallback
+ * @tc.desc: A module may deregister from within its own event callback without waiting on itself.
+ */
+HWTEST_F(HciEvtDispatchTest, HciEvtDispatch_UnitTest_DeregisterFromCallback, TestSize.Level1)
+{
+    g_selfRemoving = {};
+    g_selfRemoving.modeChange = OnModeChangeSelfRemoving;
+    HciEventCallbacks other = {};
+    other.modeChange = OnModeChangeSecond;
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&g_selfRemoving), BT_SUCCESS);
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&other), BT_SUCCESS);
+
+    // The dispatch in progress finishes on the table it loaded.
+    DeliverEvent(MODE_CHANGE);
+    EXPECT_EQ(g_calls, std::vector<int>({BT_SUCCESS, 2}));
+
+    g_calls.clear();
+    DeliverEvent(MODE_CHANGE);
+    EXPECT_EQ(g_calls, std::vector<int>({2}));
+    EXPECT_EQ(HCI_DeregisterEventCallbacks(&other), BT_SUCCESS);
+}
+
+/**
+ * @tc.number: HciEvtDispatch_UnitTest006
+ * @tc.name: DeregisterWithoutMemory
+ * @tc.desc: Deregistration still removes the callbacks when no memory is left for a new subscriber table.
+ */
+HWTEST_F(HciEvtDispatchTest, HciEvtDispatch_UnitTest_DeregisterWithoutMemory, TestSize.Level1)
+{
+    HciEventCallbacks first = {};
+    first.modeChange = OnModeChangeFirst;
+    HciEventCallbacks second = {};
+    second.modeChange = OnModeChangeSecond;
+    HciEventCallbacks late = {};
+    late.modeChange = OnModeChangeFirst;
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&first), BT_SUCCESS);
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&second), BT_SUCCESS);
+
+    g_allocFails = true;
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&late), BT_NO_MEMORY);
+    EXPECT_EQ(HCI_DeregisterEventCallbacks(&first), BT_SUCCESS);
+    g_allocFails = false;
+    DeliverEvent(MODE_CHANGE);
+    EXPECT_EQ(g_calls, std::vector<int>({2}));
+
+    g_allocFails = true;
+    EXPECT_EQ(HCI_DeregisterEventCallbacks(&second), BT_SUCCESS);
+    g_allocFails = false;
+    g_calls.clear();
+    DeliverEvent(MODE_CHANGE);
+    EXPECT_TRUE(g_calls.empty());
+}
+
+/**
+ * @tc.number: HciEvtDispatch_UnitTest007
+ * @tc.name: RetiredTablesReleased
+ * @tc.desc: Registering and deregistering over and over does not keep the superseded subscriber tables.
+ */
+HWTEST_F(HciEvtDispatchTest, HciEvtDispatch_UnitTest_RetiredTablesReleased, TestSize.Level1)
+{
+    HciEventCallbacks first = {};
+    first.modeChange = OnModeChangeFirst;
+    HciEventCallbacks second = {};
+    second.modeChange = OnModeChangeSecond;
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&first), BT_SUCCESS);
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&second), BT_SUCCESS);
+    EXPECT_EQ(HCI_DeregisterEventCallbacks(&second), BT_SUCCESS);
+
+    int64_t live = g_liveAllocations.load();
+    for (int round = 0; round < CHURN_ROUNDS; round++) {
+        EXPECT_EQ(HCI_RegisterEventCallbacks(&second), BT_SUCCESS);
+        EXPECT_EQ(HCI_DeregisterEventCallbacks(&second), BT_SUCCESS);
+    }
+    EXPECT_EQ(g_liveAllocations.load(), live);
+
+    DeliverEvent(MODE_CHANGE);
+    EXPECT_EQ(g_calls, std::vector<int>({1}));
+    EXPECT_EQ(HCI_DeregisterEventCallbacks(&first), BT_SUCCESS);
+}
+
+/**
+ * @tc.number: HciEvtDispatch_UnitTest008
+ * @tc.name: StatisticsWhileDispatching
+ * @tc.desc: Statistics read on another thread while events are dispatched only ever grow, and end up complete.
+ */
+HWTEST_F(HciEvtDispatchTest, HciEvtDispatch_UnitTest_StatisticsWhileDispatching, TestSize.Level1)
+{
+    HciEventCallbacks callbacks = {};
+    callbacks.modeChange = OnModeChangeFirst;
+    EXPECT_EQ(HCI_RegisterEventCallbacks(&callbacks), BT_SUCCESS);
+
+    std::atomic<bool> started {false};
+    std::atomic<bool> done {false};
+    bool monotonic = true;
+    std::thread reader([&started, &done, &monotonic]() {
+        HciEventStatistics last = {};
+        started = true;
+        while (!done) {
+            HciEventStatistics statistics = {};
+            HCI_GetEventStatistics(EVENT_MODE_CHANGE, &statistics);
+            if (statistics.count < last.count || statistics.totalNs < last.totalNs ||
+                statistics.maxNs < last.maxNs) {
+                monotonic = false;
+            }
+            last = statistics;
+        }
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < READ_EVENTS; i++) {
+        DeliverEvent(MODE_CHANGE);
+    }
+    done = true;
+    reader.join();
+    EXPECT_TRUE(monotonic);
+
+    HciEventStatistics statistics = {};
+    EXPECT_EQ(HCI_GetEventStatistics(EVENT_MODE_CHANGE, &statistics), BT_SUCCESS);
+    EXPECT_EQ(statistics.count, static_cast<uint64_t>(READ_EVENTS));
+    EXPECT_EQ(HistogramTotal(statistics), static_cast<uint64_t>(READ_EVENTS));
+    g_calls.clear();
+    EXPECT_EQ(HCI_DeregisterEventCallbacks(&callbacks), BT_SUCCESS);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "benchmark_report.h"
+#include "hid_host_input_writer.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr int READ_TIMEOUT_MS = 1000;
+constexpr int BENCH_REPORTS = 2000;
+constexpr int REPORT_INTERVAL_US = 125;
+// Header of a UHID_INPUT2 event: type and size.
+constexpr size_t INPUT2_HEADER = sizeof(uint32_t) + sizeof(uint16_t);
+}  // namespace
+
+// A seqpacket socket keeps each write as one message, so the test sees exactly what uhid would be handed.
+class HidHostInputWriterTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds_), 0);
+    }
+    void TearDown()
+    {
+        writer_.Stop();
+        close(fds_[0]);
+        close(fds_[1]);
+    }
+
+    std::vector<uint8_t> ReadEvent(int timeoutMs = READ_TIMEOUT_MS)
+    {
+        struct pollfd pfd = {fds_[1], POLLIN, 0};
+        if (poll(&pfd, 1, timeoutMs) <= 0) {
+            return {};
+        }
+        std::vector<uint8_t> event(sizeof(struct uhid_event));
+        ssize_t ret = read(fds_[1], event.data(), event.size());
+        event.resize(ret > 0 ? ret : 0);
+        return event;
+    }
+
+    int fds_[2] = {-1, -1};
+    HidHostInputWriter writer_;
+};
+
+/**
+ * @tc.number: HidHostInputWriter_UnitTest001
+ * @tc.name: TrimmedInput2
+ * @tc.desc: A report goes out as UHID_INPUT2 cut to its length, with the report id prepended when there is one.
+ */
+HWTEST_F(HidHostInputWriterTest, HidHostInputWriter_UnitTest_TrimmedInput2, TestSize.Level1)
+{
+    ASSERT_EQ(writer_.Start(fds_[0]), 0);
+    writer_.SetReady(true);
+
+    const uint8_t report[] = {0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    EXPECT_EQ(writer_.Push(0x01, report, sizeof(report)), 0);
+    std::vector<uint8_t> event = ReadEvent();
+    ASSERT_EQ(event.size(), INPUT2_HEADER + 1 + sizeof(report));
+    struct uhid_event ev = {};
+    (void)memcpy(&ev, event.data(), event.size());
+    EXPECT_EQ(ev.type, static_cast<uint32_t>(UHID_INPUT2));
+    EXPECT_EQ(ev.u.input2.size, 1 + sizeof(report));
+    EXPECT_EQ(ev.u.input2.data[0], 0x01);
+    EXPECT_EQ(memcmp(ev.u.input2.data + 1, report, sizeof(report)), 0);
+
+    EXPECT_EQ(writer_.Push(0, report, sizeof(report)), 0);
+    event = ReadEvent();
+    ASSERT_EQ(event.size(), INPUT2_HEADER + sizeof(report));
+    EXPECT_EQ(memcmp(event.data() + INPUT2_HEADER, report, sizeof(report)), 0);
+
+    std::vector<uint8_t> oversize(HID_HOST_INPUT_REPORT_MAX);
+    EXPECT_NE(writer_.Push(0x01, oversize.data(), oversize.size()), 0);
+    // Stopping joins the writer, so the last write is accounted for.
+    writer_.Stop();
+    EXPECT_EQ(writer_.GetLatency().reports, 2u);
+    EXPECT_EQ(writer_.GetLatency().dropped, 1u);
+}
+
+/**
+ * @tc.number: HidHostInputWriter_UnitTest002
+ * @tc.name: WaitsForReady
+ * @tc.desc: Reports queue until uhid reports the device started, and a full ring drops instead of blocking.
+ */
+HWTEST_F(HidHostInputWriterTest, HidHostInputWriter_UnitTest_WaitsForReady, TestSize.Level1)
+{
+    const uint8_t report[] = {0x01, 0x02, 0x03};
+    EXPECT_NE(writer_.Push(0, report, sizeof(report)), 0);
+    ASSERT_EQ(writer_.Start(fds_[0]), 0);
+    EXPECT_FALSE(writer_.WaitReady(1));
+
+    const size_t extra = 5;
+    for (size_t i = 0; i < HID_HOST_INPUT_RING_SIZE + extra; i++) {
+        writer_.Push(0, report, sizeof(report));
+    }
+    EXPECT_TRUE(ReadEvent(20).empty());
+    EXPECT_EQ(writer_.GetLatency().dropped, 1 + extra);
+
+    std::thread starter([this] { writer_.SetReady(true); });
+    EXPECT_TRUE(writer_.WaitReady(READ_TIMEOUT_MS));
+    starter.join();
+    for (size_t i = 0; i < HID_HOST_INPUT_RING_SIZE; i++) {
+        ASSERT_EQ(ReadEvent().size(), INPUT2_HEADER + sizeof(report));
+    }
+
+    // After a stop nothing more is written until the next start.
+    writer_.SetReady(false);
+    writer_.Stop();
+    EXPECT_EQ(writer_.GetLatency().reports, HID_HOST_INPUT_RING_SIZE);
+    EXPECT_NE(writer_.Push(0, report, sizeof(report)), 0);
+    EXPECT_TRUE(ReadEvent(20).empty());
+}
+
+/**
+ * @tc.number: HidHostInputWriter_UnitTest003
+ * @tc.name: Latency
+ * @tc.desc: Report-to-uhid latency percentiles while a reader drains the device like the kernel would.
+ */
+HWTEST_F(HidHostInputWriterTest, HidHostInputWriter_UnitTest_Latency, TestSize.Level1)
+{
+    ASSERT_EQ(writer_.Start(fds_[0]), 0);
+    writer_.SetReady(true);
+
+    int received = 0;
+    std::thread reader([this, &received] {
+        while (received < BENCH_REPORTS && !ReadEvent().empty()) {
+            received++;
+        }
+    });
+    const uint8_t report[] = {0x00, 0x10, 0xF0, 0x00};
+    // Paced like a mouse reporting at 8 kHz.
+    for (int i = 0; i < BENCH_REPORTS; i++) {
+        EXPECT_EQ(writer_.Push(0x02, report, sizeof(report)), 0);
+        usleep(REPORT_INTERVAL_US);
+    }
+    reader.join();
+    writer_.Stop();
+    EXPECT_EQ(received, BENCH_REPORTS);
+
+    HidHostInputLatency latency = writer_.GetLatency();
+    EXPECT_EQ(latency.reports, static_cast<uint64_t>(BENCH_REPORTS));
+    EXPECT_EQ(latency.dropped, 0u);
+    EXPECT_LE(latency.p50Us, latency.p90Us);
+    EXPECT_LE(latency.p90Us, latency.p99Us);
+    EXPECT_LE(latency.p99Us, latency.maxUs);
+    BenchmarkReport("HidInputReportToUhid")
+        .Add("reports", latency.reports)
+        .Add("dropped", latency.dropped)
+        .Add("p50_us", latency.p50Us)
+        .Add("p90_us", latency.p90Us)
+        .Add("p99_us", latency.p99Us)
+        .Add("max_us", latency.maxUs)
+        .Publish();
+}
+}  // namespace bluetooth
+}  // namespace OHOS
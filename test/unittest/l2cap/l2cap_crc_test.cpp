@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "benchmark_report.h"
+#include "l2cap_crc.h"
+#include "packet.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr uint32_t RANDOM_SEED = 20220301;
+constexpr int RANDOM_ROUNDS = 500;
+constexpr uint32_t MAX_PAYLOAD = 2048;
+constexpr uint16_t L2CAP_ERTM_HEADER = 6;
+constexpr uint16_t L2CAP_FCS_SIZE = 2;
+constexpr uint32_t BENCH_FRAME_SIZE = 1000;
+constexpr int BENCH_FRAMES = 20000;
+
+uint16_t Crc16Bytewise(const uint8_t *data, size_t length, uint16_t preCrc)
+{
+    uint16_t crc = preCrc;
+    for (size_t i = 0; i < length; i++) {
+        crc = CalCrc16WithPrev(data[i], crc);
+    }
+    return crc;
+}
+
+std::vector<uint8_t> RandomBytes(std::mt19937 &rng, size_t length)
+{
+    std::vector<uint8_t> data(length);
+    for (auto &byte : data) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return data;
+}
+
+// Builds a frame with an ERTM sized head, the payload split at random points, and an FCS tail.
+Packet *BuildSegmentedFrame(std::mt19937 &rng, const std::vector<uint8_t> &header, const std::vector<uint8_t> &payload)
+{
+    Packet *frame = PacketMalloc(header.size(), L2CAP_FCS_SIZE, 0);
+    if (!header.empty()) {
+        (void)memcpy(BufferPtr(PacketHead(frame)), header.data(), header.size());
+    }
+    size_t offset = 0;
+    while (offset < payload.size()) {
+        size_t length = std::min<size_t>(rng() % (payload.size() - offset) + 1, payload.size() - offset);
+        Packet *segment = PacketMalloc(0, 0, length);
+        PacketPayloadWrite(segment, payload.data() + offset, 0, length);
+        PacketAssemble(frame, segment);
+        PacketFree(segment);
+        offset += length;
+    }
+    return frame;
+}
+}  // namespace
+
+class L2capCrcTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+};
+
+/**
+ * @tc.number: L2capCrc_UnitTest001
+ * @tc.name: KnownVector
+ * @tc.desc: The L2CAP FCS is CRC-16 with polynomial 0x8005, reflected, initial value 0.
+ */
+HWTEST_F(L2capCrcTest, L2capCrc_UnitTest_KnownVector, TestSize.Level1)
+{
+    const char *check = "123456789";
+    const uint16_t expected = 0xBB3D;
+    auto data = reinterpret_cast<const uint8_t *>(check);
+    EXPECT_EQ(Crc16Bytewise(data, strlen(check), 0), expected);
+    EXPECT_EQ(CalCrc16BlockWithPrev(data, strlen(check), 0), expected);
+    EXPECT_EQ(CalCrc16BlockWithPrev(nullptr, 0, expected), expected);
+}
+
+/**
+ * @tc.number: L2capCrc_UnitTest002
+ * @tc.name: BlockMatchesBytewise
+ * @tc.desc: Random lengths, start offsets and previous CRC values give the bytewise result.
+ */
+HWTEST_F(L2capCrcTest, L2capCrc_UnitTest_BlockMatchesBytewise, TestSize.Level1)
+{
+    std::mt19937 rng(RANDOM_SEED);
+    for (int round = 0; round < RANDOM_ROUNDS; round++) {
+        auto data = RandomBytes(rng, rng() % MAX_PAYLOAD + 1);
+        size_t start = rng() % data.size();
+        uint16_t preCrc = static_cast<uint16_t>(rng());
+        ASSERT_EQ(CalCrc16BlockWithPrev(data.data() + start, data.size() - start, preCrc),
+            Crc16Bytewise(data.data() + start, data.size() - start, preCrc))
+            << "length " << data.size() - start;
+    }
+}
+
+/**
+ * @tc.number: L2capCrc_UnitTest003
+ * @tc.name: PacketSegments
+ * @tc.desc: PacketCalCrc16Block over randomly segmented frames matches PacketCalCrc16 and the flat CRC, and can be
+ *           continued incrementally from the header CRC.
+ */
+HWTEST_F(L2capCrcTest, L2capCrc_UnitTest_PacketSegments, TestSize.Level1)
+{
+    std::mt19937 rng(RANDOM_SEED);
+    for (int round = 0; round < RANDOM_ROUNDS; round++) {
+        auto header = RandomBytes(rng, L2CAP_ERTM_HEADER);
+        auto payload = RandomBytes(rng, rng() % MAX_PAYLOAD);
+        Packet *frame = BuildSegmentedFrame(rng, header, payload);
+
+        uint16_t expected = Crc16Bytewise(payload.data(), payload.size(), Crc16Bytewise(header.data(), header.size(), 0));
+        EXPECT_EQ(PacketCalCrc16(frame, CalCrc16WithPrev), expected);
+        EXPECT_EQ(PacketCalCrc16Block(frame, CalCrc16BlockWithPrev, 0), expected);
+        EXPECT_EQ(PacketVerCrc16(frame, CalCrc16WithPrev, expected), 0);
+
+        Packet *body = BuildSegmentedFrame(rng, {}, payload);
+        uint16_t headerCrc = CalCrc16BlockWithPrev(header.data(), header.size(), 0);
+        EXPECT_EQ(PacketCalCrc16Block(body, CalCrc16BlockWithPrev, headerCrc), expected);
+
+        PacketFree(body);
+        PacketFree(frame);
+    }
+}
+
+/**
+ * @tc.number: L2capCrc_UnitTest004
+ * @tc.name: Throughput
+ * @tc.desc: FCS throughput over 1000 byte I-frames, bytewise callback against the block callback.
+ */
+HWTEST_F(L2capCrcTest, L2capCrc_UnitTest_Throughput, TestSize.Level1)
+{
+    std::mt19937 rng(RANDOM_SEED);
+    Packet *frame = BuildSegmentedFrame(rng, RandomBytes(rng, L2CAP_ERTM_HEADER), RandomBytes(rng, BENCH_FRAME_SIZE));
+
+    auto measure = [frame](const char *name, uint16_t (*fcs)(Packet *)) {
+        uint16_t sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BENCH_FRAMES; i++) {
+            sink += fcs(frame);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double bytes = static_cast<double>(BENCH_FRAMES) * (BENCH_FRAME_SIZE + L2CAP_ERTM_HEADER);
+        BenchmarkReport(name)
+            .Add("ns_per_op", seconds * 1e9 / BENCH_FRAMES)
+            .Add("mb_per_s", bytes / seconds / 1e6)
+            .Add("sink", sink)
+            .Publish();
+        return seconds;
+    };
+    double bytewise = measure("L2capFcsBytewise", [](Packet *pkt) { return PacketCalCrc16(pkt, CalCrc16WithPrev); });
+    double block = measure(
+        "L2capFcsSliceBy8", [](Packet *pkt) { return PacketCalCrc16Block(pkt, CalCrc16BlockWithPrev, 0); });
+    EXPECT_GT(bytewise, 0);
+    EXPECT_GT(block, 0);
+
+    PacketFree(frame);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
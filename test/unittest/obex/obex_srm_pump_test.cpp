@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark_report.h"
+#include "dispatcher.h"
+#include "obex_body.h"
+#include "obex_headers.h"
+#include "obex_session.h"
+#include "obex_srm_pump.h"
+#include "obex_transport.h"
+#include "packet.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr size_t OBJECT_SIZE = 2 * 1024 * 1024;
+constexpr uint16_t OBEX_MTU = 8192;
+constexpr int LINK_CREDITS = 10;
+constexpr auto LINK_PACKET_TIME = std::chrono::microseconds(40);
+constexpr auto DISPATCHER_LOAD_TIME = std::chrono::microseconds(100);
+constexpr uint8_t CODE_SUCCESS = static_cast<uint8_t>(ObexRspCode::SUCCESS);
+
+std::unique_ptr<ObexHeader> MakeResponse(ObexRspCode code)
+{
+    return ObexHeader::CreateResponse(code);
+}
+
+struct Result {
+    double seconds = 0;
+    size_t packets = 0;
+    size_t bytes = 0;
+    size_t maxInFlight = 0;
+    uint8_t lastCode = 0;
+};
+
+// Loopback transport with L2CAP style credits: each write takes a credit and a link thread returns one per packet
+// time. Busy and idle are reported through the dispatcher, as the socket transport does.
+class CreditTransport : public ObexTransport {
+public:
+    CreditTransport(utility::Dispatcher &dispatcher, std::function<void(bool)> onBusy)
+        : dispatcher_(dispatcher), onBusy_(std::move(onBusy))
+    {
+        link_ = std::thread(&CreditTransport::Link, this);
+    }
+    ~CreditTransport() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        link_.join();
+    }
+    bool Write(Packet &pkt) override
+    {
+        uint8_t code = 0;
+        PacketRead(&pkt, &code, 0, 1);
+        std::lock_guard<std::mutex> lock(mutex_);
+        result_.bytes += PacketSize(&pkt);
+        result_.packets++;
+        result_.lastCode = code;
+        inFlight_++;
+        if (inFlight_ == LINK_CREDITS) {
+            dispatcher_.PostTask(std::bind(onBusy_, true));
+        }
+        cv_.notify_all();
+        return true;
+    }
+    int GetMaxSendPacketSize() override
+    {
+        return OBEX_MTU;
+    }
+    int GetMaxReceivePacketSize() override
+    {
+        return OBEX_MTU;
+    }
+    const RawAddress &GetRemoteAddress() override
+    {
+        return address_;
+    }
+    bool IsConnected() override
+    {
+        return true;
+    }
+    const std::string &GetTransportKey() override
+    {
+        return key_;
+    }
+    // Waits for the link to drain, so no busy notification can follow.
+    void WaitIdle()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return inFlight_ == 0; });
+    }
+    Result GetResult()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return result_;
+    }
+
+private:
+    void Link()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_) {
+            if (inFlight_ == 0) {
+                cv_.wait(lock);
+                continue;
+            }
+            result_.maxInFlight = std::max(result_.maxInFlight, static_cast<size_t>(inFlight_));
+            lock.unlock();
+            std::this_thread::sleep_for(LINK_PACKET_TIME);
+            lock.lock();
+            // Credits come back when the window has half drained, like an ERTM peer acknowledging in batches.
+            if (--inFlight_ == LINK_CREDITS / 2) {
+                dispatcher_.PostTask(std::bind(onBusy_, false));
+            }
+            cv_.notify_all();
+        }
+    }
+    utility::Dispatcher &dispatcher_;
+    std::function<void(bool)> onBusy_;
+    std::thread link_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int inFlight_ = 0;
+    bool stop_ = false;
+    Result result_ {};
+    RawAddress address_ {"00:00:00:00:00:01"};
+    std::string key_ {"loopback"};
+};
+
+// Serves one SRM GET through ObexServerSession while a neighbour keeps the dispatcher busy with short tasks.
+Result ServeSrmGet(size_t window)
+{
+    utility::Dispatcher dispatcher("obex-srm-test");
+    dispatcher.Initialize();
+    std::promise<void> done;
+    std::unique_ptr<ObexServerSession> session;
+    auto onBusy = [&session](bool isBusy) {
+        // Same handling as ObexPrivateMpServer::HandleTransportDataBusy.
+        auto &sendObject = session->GetSendObject();
+        if (!sendObject) {
+            return;
+        }
+        bool oldBusy = sendObject->IsBusy();
+        sendObject->SetBusy(isBusy);
+        if (oldBusy && !isBusy && sendObject->IsSrmSending()) {
+            session->SendSrmResponse();
+        }
+    };
+    auto transport = std::make_unique<CreditTransport>(dispatcher, onBusy);
+    session = std::make_unique<ObexServerSession>(*transport, true, dispatcher,
+        [](ObexServerSession &) { return 0; },
+        [&done](ObexServerSession &, bool isBusy) {
+            if (!isBusy) {
+                done.set_value();
+            }
+        },
+        window);
+    session->SetMaxPacketLength(OBEX_MTU);
+
+    std::atomic_bool loading {true};
+    std::thread neighbour([&dispatcher, &loading]() {
+        while (loading) {
+            std::promise<void> ran;
+            dispatcher.PostTask([&ran]() {
+                std::this_thread::sleep_for(DISPATCHER_LOAD_TIME);
+                ran.set_value();
+            });
+            ran.get_future().wait();
+        }
+    });
+
+    std::vector<uint8_t> object(OBJECT_SIZE, 0x5A);
+    auto body = std::make_shared<ObexArrayBodyObject>(object.data(), object.size());
+    auto start = std::chrono::steady_clock::now();
+    dispatcher.PostTask([&session, &body]() {
+        auto req = ObexHeader::CreateRequest(ObexOpeId::GET_FINAL);
+        req->AppendItemSrm(true);
+        auto resp = MakeResponse(ObexRspCode::CONTINUE);
+        EXPECT_EQ(session->SendGetResponse(*req, *resp, body), 0);
+    });
+    auto finished = done.get_future();
+    EXPECT_EQ(finished.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    loading = false;
+    neighbour.join();
+    transport->WaitIdle();
+    std::promise<void> drained;
+    dispatcher.PostTask([&drained]() { drained.set_value(); });
+    drained.get_future().wait();
+    Result result = transport->GetResult();
+    result.seconds = seconds;
+    session = nullptr;
+    transport = nullptr;
+    dispatcher.Uninitialize();
+    return result;
+}
+}  // namespace
+
+class ObexSrmPumpTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+};
+
+/**
+ * @tc.number: ObexSrmPump_UnitTest001
+ * @tc.name: WindowAndBusy
+ * @tc.desc: A burst stops after one window or when busy, with the window kept prepared, and ends on the final packet.
+ */
+HWTEST_F(ObexSrmPumpTest, ObexSrmPump_UnitTest_WindowAndBusy, TestSize.Level1)
+{
+    const int total = 10;
+    int produced = 0;
+    std::vector<uint8_t> written;
+    bool busy = false;
+    auto next = [&produced](bool &isFinal) {
+        produced++;
+        isFinal = (produced == total);
+        return MakeResponse(isFinal ? ObexRspCode::SUCCESS : ObexRspCode::CONTINUE);
+    };
+    auto write = [&written](ObexHeader &header) {
+        written.push_back(header.GetFieldCode());
+        return 0;
+    };
+    auto isBusy = [&busy]() { return busy; };
+
+    ObexSrmPump pump(4);
+    EXPECT_EQ(pump.Pump(next, write, isBusy), ObexSrmPump::State::WINDOW_SENT);
+    EXPECT_EQ(written.size(), 4u);
+    EXPECT_EQ(pump.GetPreparedCount(), 4u);
+
+    busy = true;
+    EXPECT_EQ(pump.Pump(next, write, isBusy), ObexSrmPump::State::BUSY);
+    EXPECT_EQ(written.size(), 4u);
+
+    busy = false;
+    EXPECT_EQ(pump.Pump(next, write, isBusy), ObexSrmPump::State::WINDOW_SENT);
+    EXPECT_EQ(pump.Pump(next, write, isBusy), ObexSrmPump::State::DONE);
+    EXPECT_EQ(produced, total);
+    ASSERT_EQ(written.size(), static_cast<size_t>(total));
+    EXPECT_EQ(written.back(), CODE_SUCCESS);
+    EXPECT_EQ(pump.GetLastCode(), CODE_SUCCESS);
+    EXPECT_EQ(pump.GetPreparedCount(), 0u);
+}
+
+/**
+ * @tc.number: ObexSrmPump_UnitTest002
+ * @tc.name: Failures
+ * @tc.desc: Packets prepared before a producer error still go out; a write error stops the pump with its code.
+ */
+HWTEST_F(ObexSrmPumpTest, ObexSrmPump_UnitTest_Failures, TestSize.Level1)
+{
+    int produced = 0;
+    size_t written = 0;
+    auto failingNext = [&produced](bool &isFinal) -> std::unique_ptr<ObexHeader> {
+        isFinal = false;
+        if (++produced > 3) {
+            return nullptr;
+        }
+        return MakeResponse(ObexRspCode::CONTINUE);
+    };
+    auto write = [&written](ObexHeader &header) {
+        written++;
+        return 0;
+    };
+    auto idle = []() { return false; };
+
+    ObexSrmPump pump(8);
+    EXPECT_EQ(pump.Pump(failingNext, write, idle), ObexSrmPump::State::FAILED);
+    EXPECT_EQ(written, 3u);
+    EXPECT_EQ(pump.GetError(), -1);
+
+    const int writeError = -5;
+    auto next = [](bool &isFinal) {
+        isFinal = false;
+        return MakeResponse(ObexRspCode::CONTINUE);
+    };
+    auto failingWrite = [](ObexHeader &header) { return writeError; };
+    ObexSrmPump writePump(0);
+    EXPECT_EQ(writePump.GetWindow(), 1u);
+    EXPECT_EQ(writePump.Pump(next, failingWrite, idle), ObexSrmPump::State::FAILED);
+    EXPECT_EQ(writePump.GetError(), writeError);
+    EXPECT_EQ(writePump.GetPreparedCount(), 0u);
+}
+
+/**
+ * @tc.number: ObexSrmPump_UnitTest003
+ * @tc.name: Throughput
+ * @tc.desc: SRM GET throughput over a credit limited loopback link with a loaded dispatcher, per window size.
+ */
+HWTEST_F(ObexSrmPumpTest, ObexSrmPump_UnitTest_Throughput, TestSize.Level1)
+{
+    for (size_t window : {1, 8}) {
+        Result result = ServeSrmGet(window);
+        EXPECT_GT(result.bytes, OBJECT_SIZE);
+        EXPECT_EQ(result.lastCode, CODE_SUCCESS);
+        // Busy arrives through the dispatcher, so at most one window goes out after the credits run out.
+        EXPECT_LE(result.maxInFlight, LINK_CREDITS + window);
+        BenchmarkReport("ObexSrmGet")
+            .Add("window", window)
+            .Add("mib_per_s", OBJECT_SIZE / result.seconds / (1024 * 1024))
+            .Add("packets", result.packets)
+            .Add("mtu", OBEX_MTU)
+            .Add("credits", LINK_CREDITS)
+            .Publish(window == 1 ? "ObexSrmGetWindow1" : "ObexSrmGetWindow8");
+    }
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,565 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "benchmark_report.h"
+#include "buffer.h"
+#include "packet.h"
+#include "platform/include/alarm.h"
+#include "platform/include/event.h"
+#include "platform/include/list.h"
+#include "platform/include/queue.h"
+#include "platform/include/reactor.h"
+#include "platform/include/semaphore.h"
+
+using namespace testing::ext;
+
+/*
+ * Counting shim. The target links with -Wl,--wrap=<symbol> for every function below, so calls made by the
+ * platform sources land here first. free and close are not counted: allocations and blocking or kernel
+ * round trips are what the numbers are about.
+ */
+namespace {
+std::atomic<uint64_t> g_allocations {0};
+std::atomic<uint64_t> g_syscalls {0};
+
+inline void CountAllocation()
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void CountSyscall()
+{
+    g_syscalls.fetch_add(1, std::memory_order_relaxed);
+}
+}  // namespace
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t num, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+int __real_eventfd(unsigned int initval, int flags);
+int __real_eventfd_read(int fd, eventfd_t *value);
+int __real_eventfd_write(int fd, eventfd_t value);
+int __real_epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+int __real_epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout);
+int __real_timerfd_create(int clockid, int flags);
+int __real_timerfd_settime(int fd, int flags, const struct itimerspec *newValue, struct itimerspec *oldValue);
+ssize_t __real_read(int fd, void *buf, size_t count);
+ssize_t __real_write(int fd, const void *buf, size_t count);
+int __real_fcntl(int fd, int cmd, ...);
+
+void *__wrap_malloc(size_t size)
+{
+    CountAllocation();
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t num, size_t size)
+{
+    CountAllocation();
+    return __real_calloc(num, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    CountAllocation();
+    return __real_realloc(ptr, size);
+}
+
+int __wrap_eventfd(unsigned int initval, int flags)
+{
+    CountSyscall();
+    return __real_eventfd(initval, flags);
+}
+
+int __wrap_eventfd_read(int fd, eventfd_t *value)
+{
+    CountSyscall();
+    return __real_eventfd_read(fd, value);
+}
+
+int __wrap_eventfd_write(int fd, eventfd_t value)
+{
+    CountSyscall();
+    return __real_eventfd_write(fd, value);
+}
+
+int __wrap_epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+    CountSyscall();
+    return __real_epoll_ctl(epfd, op, fd, event);
+}
+
+int __wrap_epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout)
+{
+    CountSyscall();
+    return __real_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+int __wrap_timerfd_create(int clockid, int flags)
+{
+    CountSyscall();
+    return __real_timerfd_create(clockid, flags);
+}
+
+int __wrap_timerfd_settime(int fd, int flags, const struct itimerspec *newValue, struct itimerspec *oldValue)
+{
+    CountSyscall();
+    return __real_timerfd_settime(fd, flags, newValue, oldValue);
+}
+
+ssize_t __wrap_read(int fd, void *buf, size_t count)
+{
+    CountSyscall();
+    return __real_read(fd, buf, count);
+}
+
+ssize_t __wrap_write(int fd, const void *buf, size_t count)
+{
+    CountSyscall();
+    return __real_write(fd, buf, count);
+}
+
+int __wrap_fcntl(int fd, int cmd, ...)
+{
+    CountSyscall();
+    va_list args;
+    va_start(args, cmd);
+    long arg = va_arg(args, long);
+    va_end(args);
+    return __real_fcntl(fd, cmd, arg);
+}
+}
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr uint64_t FAST_OPS = 200000;
+constexpr uint64_t SYSCALL_OPS = 50000;
+constexpr uint64_t WAKEUP_OPS = 20000;
+constexpr uint64_t ALARM_FIRE_OPS = 200;
+constexpr int PRODUCER_NUM = 4;
+constexpr uint32_t QUEUE_CAPACITY = 64;
+constexpr int FANOUT_FDS = 16;
+
+constexpr uint16_t ACL_HEADER_SIZE = 4;
+constexpr uint32_t ACL_PAYLOAD_SIZE = 1000;
+constexpr uint32_t SDU_SIZE = 4000;
+constexpr uint32_t FRAGMENT_SIZE = 1021;
+constexpr uint32_t FRAGMENT_NUM = 4;
+constexpr uint32_t SLICE_OFFSET = 10;
+constexpr uint32_t SLICE_SIZE = 500;
+constexpr uint64_t ALARM_LONG_MS = 1000;
+constexpr uint64_t ALARM_SHORT_MS = 1;
+
+struct BenchmarkResult {
+    std::string name;
+    uint64_t ops;
+    double nsPerOp;
+    double allocationsPerOp;
+    double syscallsPerOp;
+};
+
+// One JSON object per line on the log, and appended to $BT_BENCHMARK_OUTPUT when set, for trend tracking.
+void Report(const BenchmarkResult &result)
+{
+    std::string line = BenchmarkReport(result.name)
+        .Add("ops", result.ops)
+        .Add("ns_per_op", result.nsPerOp)
+        .Add("allocs_per_op", result.allocationsPerOp, 2)
+        .Add("syscalls_per_op", result.syscallsPerOp, 2)
+        .Publish();
+
+    const char *path = getenv("BT_BENCHMARK_OUTPUT");
+    if (path != nullptr) {
+        FILE *file = fopen(path, "a");
+        if (file != nullptr) {
+            (void)fprintf(file, "%s\n", line.c_str());
+            (void)fclose(file);
+        }
+    }
+}
+
+// Runs body(ops) once to warm up caches and allocator, then measures a second run.
+template<class Body>
+BenchmarkResult Measure(const char *name, uint64_t ops, Body &&body)
+{
+    body(ops / 10 + 1);
+    uint64_t allocations = g_allocations.load();
+    uint64_t syscalls = g_syscalls.load();
+    auto start = std::chrono::steady_clock::now();
+    body(ops);
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    BenchmarkResult result = {
+        name,
+        ops,
+        elapsed / ops,
+        static_cast<double>(g_allocations.load() - allocations) / ops,
+        static_cast<double>(g_syscalls.load() - syscalls) / ops,
+    };
+    Report(result);
+    return result;
+}
+
+class ReactorThread {
+public:
+    ReactorThread() : reactor_(ReactorCreate())
+    {
+        std::atomic<bool> started {false};
+        thread_ = std::thread([this, &started]() {
+            ReactorSetThreadId(reactor_, (unsigned long)pthread_self());
+            started = true;
+            ReactorStart(reactor_);
+        });
+        while (!started.load()) {
+            std::this_thread::yield();
+        }
+    }
+    ~ReactorThread()
+    {
+        ReactorStop(reactor_);
+        thread_.join();
+        ReactorDelete(reactor_);
+    }
+    Reactor *Get() const
+    {
+        return reactor_;
+    }
+
+private:
+    Reactor *reactor_;
+    std::thread thread_ {};
+};
+
+struct ReactorContext {
+    int fd;
+    Semaphore *done;
+    std::atomic<int> *pending;
+};
+
+void OnReactorReadReady(void *context)
+{
+    auto *ctx = static_cast<ReactorContext *>(context);
+    eventfd_t value;
+    eventfd_read(ctx->fd, &value);
+    if (ctx->pending == nullptr || ctx->pending->fetch_sub(1) == 1) {
+        SemaphorePost(ctx->done);
+    }
+}
+
+void OnAlarm(void *parameter)
+{
+    SemaphorePost(static_cast<Semaphore *>(parameter));
+}
+}  // namespace
+
+class PlatformBenchmarkTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+};
+
+/**
+ * @tc.number: PlatformBenchmark_UnitTest001
+ * @tc.name: Packet
+ * @tc.desc: PacketMalloc of an ACL sized packet, PacketFragment of an SDU into ACL fragments, PacketAssemble
+ *           of the fragments and PacketContinuousPayload of the result.
+ */
+HWTEST_F(PlatformBenchmarkTest, PlatformBenchmark_UnitTest_Packet, TestSize.Level1)
+{
+    Measure("PacketMalloc", FAST_OPS, [](uint64_t ops) {
+        for (uint64_t i = 0; i < ops; i++) {
+            PacketFree(PacketMalloc(ACL_HEADER_SIZE, 0, ACL_PAYLOAD_SIZE));
+        }
+    });
+
+    uint32_t fragments = 0;
+    Measure("PacketFragment", FAST_OPS / FRAGMENT_NUM, [&fragments](uint64_t ops) {
+        for (uint64_t i = 0; i < ops; i++) {
+            Packet *sdu = PacketMalloc(0, 0, SDU_SIZE);
+            uint32_t remain = SDU_SIZE;
+            while (remain > 0) {
+                Packet *fragment = PacketMalloc(ACL_HEADER_SIZE, 0, 0);
+                remain = PacketFragment(sdu, fragment, FRAGMENT_SIZE);
+                PacketFree(fragment);
+                fragments++;
+            }
+            PacketFree(sdu);
+        }
+    });
+    EXPECT_GT(fragments, 0u);
+
+    auto assemble = [](bool continuous, uint64_t ops) {
+        for (uint64_t i = 0; i < ops; i++) {
+            Packet *sdu = PacketMalloc(0, 0, 0);
+            for (uint32_t j = 0; j < FRAGMENT_NUM; j++) {
+                Packet *fragment = PacketMalloc(0, 0, ACL_PAYLOAD_SIZE);
+                PacketAssemble(sdu, fragment);
+                PacketFree(fragment);
+            }
+            if (continuous) {
+                EXPECT_EQ(BufferGetSize(PacketContinuousPayload(sdu)), ACL_PAYLOAD_SIZE * FRAGMENT_NUM);
+            }
+            PacketFree(sdu);
+        }
+    };
+    Measure("PacketAssemble", FAST_OPS / FRAGMENT_NUM, [&assemble](uint64_t ops) { assemble(false, ops); });
+    Measure("PacketContinuousPayload", FAST_OPS / FRAGMENT_NUM, [&assemble](uint64_t ops) { assemble(true, ops); });
+}
+
+/**
+ * @tc.number: PlatformBenchmark_UnitTest002
+ * @tc.name: Buffer
+ * @tc.desc: BufferRefMalloc and BufferSliceMalloc of a shared buffer, single thread and with concurrent
+ *           reference counting from several threads.
+ */
+HWTEST_F(PlatformBenchmarkTest, PlatformBenchmark_UnitTest_Buffer, TestSize.Level1)
+{
+    Buffer *base = BufferMalloc(ACL_PAYLOAD_SIZE);
+    ASSERT_NE(base, nullptr);
+    Measure("BufferRefMalloc", FAST_OPS, [base](uint64_t ops) {
+        for (uint64_t i = 0; i < ops; i++) {
+            BufferFree(BufferRefMalloc(base));
+        }
+    });
+    Measure("BufferSliceMalloc", FAST_OPS, [base](uint64_t ops) {
+        for (uint64_t i = 0; i < ops; i++) {
+            BufferFree(BufferSliceMalloc(base, SLICE_OFFSET, SLICE_SIZE));
+        }
+    });
+    Measure("BufferRefMalloc/contended", FAST_OPS, [base](uint64_t ops) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < PRODUCER_NUM; t++) {
+            threads.emplace_back([base, ops]() {
+                for (uint64_t i = 0; i < ops / PRODUCER_NUM; i++) {
+                    BufferFree(BufferRefMalloc(base));
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    });
+    BufferFree(base);
+}
+
+/**
+ * @tc.number: PlatformBenchmark_UnitTest003
+ * @tc.name: ListQueue
+ * @tc.desc: List add/remove, Queue enqueue/dequeue on one thread, and a Queue fed by several producers.
+ */
+HWTEST_F(PlatformBenchmarkTest, PlatformBenchmark_UnitTest_ListQueue, TestSize.Level1)
+{
+    static int item = 0;
+    List *list = ListCreate(nullptr);
+    Measure("ListAddLast+RemoveFirst", FAST_OPS, [list](uint64_t ops) {
+        for (uint64_t i = 0; i < ops; i++) {
+            ListAddLast(list, &item);
+            ListRemoveFirst(list);
+        }
+    });
+    ListDelete(list);
+
+    Queue *queue = QueueCreate(QUEUE_CAPACITY);
+    Measure("QueueEnqueue+Dequeue", SYSCALL_OPS, [queue](uint64_t ops) {
+        for (uint64_t i = 0; i < ops; i++) {
+            QueueEnqueue(queue, &item);
+            QueueDequeue(queue);
+        }
+    });
+    Measure("QueueEnqueue+Dequeue/contended", SYSCALL_OPS, [queue](uint64_t ops) {
+        std::vector<std::thread> producers;
+        uint64_t perProducer = ops / PRODUCER_NUM;
+        for (int t = 0; t < PRODUCER_NUM; t++) {
+            producers.emplace_back([queue, perProducer]() {
+                for (uint64_t i = 0; i < perProducer; i++) {
+                    QueueEnqueue(queue, &item);
+                }
+            });
+        }
+        for (uint64_t i = 0; i < perProducer * PRODUCER_NUM; i++) {
+            QueueDequeue(queue);
+        }
+        for (auto &producer : producers) {
+            producer.join();
+        }
+    });
+    EXPECT_TRUE(QueueIsEmpty(queue));
+    QueueDelete(queue, nullptr);
+}
+
+/**
+ * @tc.number: PlatformBenchmark_UnitTest004
+ * @tc.name: SemaphoreEvent
+ * @tc.desc: Semaphore and Event signalling on one thread and as a ping-pong between two threads.
+ */
+HWTEST_F(PlatformBenchmarkTest, PlatformBenchmark_UnitTest_SemaphoreEvent, TestSize.Level1)
+{
+    Semaphore *ping = SemaphoreCreate(0);
+    Semaphore *pong = SemaphoreCreate(0);
+    Measure("SemaphorePost+Wait", SYSCALL_OPS, [ping](uint64_t ops) {
+        for (uint64_t i = 0; i < ops; i++) {
+            SemaphorePost(ping);
+            SemaphoreWait(ping);
+        }
+    });
+    Measure("SemaphorePingPong", WAKEUP_OPS, [ping, pong](uint64_t ops) {
+        std::thread peer([ping, pong, ops]() {
+            for (uint64_t i = 0; i < ops; i++) {
+                SemaphoreWait(ping);
+                SemaphorePost(pong);
+            }
+        });
+        for (uint64_t i = 0; i < ops; i++) {
+            SemaphorePost(ping);
+            SemaphoreWait(pong);
+        }
+        peer.join();
+    });
+    SemaphoreDelete(ping);
+    SemaphoreDelete(pong);
+
+    Event *request = EventCreate(true);
+    Event *response = EventCreate(true);
+    Measure("EventSet+Wait", FAST_OPS, [request](uint64_t ops) {
+        for (uint64_t i = 0; i < ops; i++) {
+            EventSet(request);
+            EventWait(request, -1);
+        }
+    });
+    Measure("EventPingPong", WAKEUP_OPS, [request, response](uint64_t ops) {
+        std::thread peer([request, response, ops]() {
+            for (uint64_t i = 0; i < ops; i++) {
+                EventWait(request, -1);
+                EventSet(response);
+            }
+        });
+        for (uint64_t i = 0; i < ops; i++) {
+            EventSet(request);
+            EventWait(response, -1);
+        }
+        peer.join();
+    });
+    EventDelete(request);
+    EventDelete(response);
+}
+
+/**
+ * @tc.number: PlatformBenchmark_UnitTest005
+ * @tc.name: Alarm
+ * @tc.desc: AlarmSet and AlarmCancel of a pending alarm, and the delivery latency of a 1 ms alarm.
+ */
+HWTEST_F(PlatformBenchmarkTest, PlatformBenchmark_UnitTest_Alarm, TestSize.Level1)
+{
+    ASSERT_EQ(AlarmModuleInit(), 0);
+    Semaphore *fired = SemaphoreCreate(0);
+    Alarm *alarm = AlarmCreate("bench", false);
+    ASSERT_NE(alarm, nullptr);
+    Measure("AlarmSet+Cancel", SYSCALL_OPS, [alarm, fired](uint64_t ops) {
+        for (uint64_t i = 0; i < ops; i++) {
+            AlarmSet(alarm, ALARM_LONG_MS, OnAlarm, fired);
+            AlarmCancel(alarm);
+        }
+    });
+    auto result = Measure("AlarmFire1ms", ALARM_FIRE_OPS, [alarm, fired](uint64_t ops) {
+        for (uint64_t i = 0; i < ops; i++) {
+            AlarmSet(alarm, ALARM_SHORT_MS, OnAlarm, fired);
+            SemaphoreWait(fired);
+        }
+    });
+    EXPECT_GE(result.nsPerOp, ALARM_SHORT_MS * 1000000.0);
+    AlarmDelete(alarm);
+    SemaphoreDelete(fired);
+    AlarmModuleCleanup();
+}
+
+/**
+ * @tc.number: PlatformBenchmark_UnitTest006
+ * @tc.name: Reactor
+ * @tc.desc: Wake-up round trip through the reactor thread, and dispatch of many ready fds written by
+ *           several producer threads.
+ */
+HWTEST_F(PlatformBenchmarkTest, PlatformBenchmark_UnitTest_Reactor, TestSize.Level1)
+{
+    ReactorThread reactor;
+    Semaphore *done = SemaphoreCreate(0);
+
+    ReactorContext single = {eventfd(0, EFD_NONBLOCK), done, nullptr};
+    ReactorItem *item = ReactorRegister(reactor.Get(), single.fd, &single, OnReactorReadReady, nullptr);
+    ASSERT_NE(item, nullptr);
+    Measure("ReactorRoundTrip", WAKEUP_OPS, [&single](uint64_t ops) {
+        for (uint64_t i = 0; i < ops; i++) {
+            eventfd_write(single.fd, 1);
+            SemaphoreWait(single.done);
+        }
+    });
+    ReactorUnregister(item);
+    close(single.fd);
+
+    std::atomic<int> pending {0};
+    std::vector<ReactorContext> contexts(FANOUT_FDS);
+    std::vector<ReactorItem *> items;
+    for (auto &context : contexts) {
+        context = {eventfd(0, EFD_NONBLOCK), done, &pending};
+        items.push_back(ReactorRegister(reactor.Get(), context.fd, &context, OnReactorReadReady, nullptr));
+    }
+    // One op is one dispatched fd; every round makes all fds ready from several threads at once.
+    Measure("ReactorFanout/contended", WAKEUP_OPS, [&contexts, &pending, done](uint64_t ops) {
+        for (uint64_t round = 0; round < ops / FANOUT_FDS; round++) {
+            pending = FANOUT_FDS;
+            std::vector<std::thread> producers;
+            for (int t = 0; t < PRODUCER_NUM; t++) {
+                producers.emplace_back([&contexts, t]() {
+                    for (int i = t; i < FANOUT_FDS; i += PRODUCER_NUM) {
+                        eventfd_write(contexts[i].fd, 1);
+                    }
+                });
+            }
+            for (auto &producer : producers) {
+                producer.join();
+            }
+            SemaphoreWait(done);
+        }
+    });
+    for (size_t i = 0; i < items.size(); i++) {
+        ReactorUnregister(items[i]);
+        close(contexts[i].fd);
+    }
+    SemaphoreDelete(done);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+#include <time.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "platform/include/reactor.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr int ITEM_NUM = 32;
+constexpr int SMALL_BATCH = 4;
+constexpr int STRESS_THREADS = 4;
+constexpr int STRESS_ROUNDS = 2000;
+constexpr int WAIT_TIMEOUT_MS = 5000;
+constexpr int SLOW_CALLBACK_MS = 200;
+constexpr int64_t MAX_UNREGISTER_CPU_NS = 50000000;
+
+struct TestItem {
+    int fd = -1;
+    ReactorItem *item = nullptr;
+    bool consume = true;
+    std::atomic<int> calls {0};
+    std::atomic<bool> removed {false};
+    std::atomic<int> *lateCalls = nullptr;
+    // Set on the items whose callback unregisters another item.
+    TestItem *victim = nullptr;
+};
+
+void OnReadReady(void *context)
+{
+    auto *test = static_cast<TestItem *>(context);
+    if (test->removed.load()) {
+        if (test->lateCalls != nullptr) {
+            (*test->lateCalls)++;
+        }
+        return;
+    }
+    test->calls++;
+    if (test->consume) {
+        eventfd_t value;
+        eventfd_read(test->fd, &value);
+    }
+    if (test->victim != nullptr && !test->victim->removed.load()) {
+        ReactorUnregister(test->victim->item);
+        test->victim->removed = true;
+    }
+}
+
+struct SlowItem {
+    int fd = -1;
+    std::atomic<bool> entered {false};
+    std::atomic<bool> returned {false};
+};
+
+void OnReadReadySlow(void *context)
+{
+    auto *test = static_cast<SlowItem *>(context);
+    eventfd_t value;
+    eventfd_read(test->fd, &value);
+    test->entered = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_CALLBACK_MS));
+    test->returned = true;
+}
+
+int64_t ThreadCpuTimeNs()
+{
+    struct timespec ts = {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+bool WaitUntil(const std::function<bool()> &condition)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(WAIT_TIMEOUT_MS);
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+}  // namespace
+
+class ReactorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {
+        reactor_ = ReactorCreate();
+        ASSERT_NE(reactor_, nullptr);
+        for (auto &item : items_) {
+            item.fd = eventfd(0, EFD_NONBLOCK);
+        }
+    }
+    void TearDown()
+    {
+        StopReactor();
+        ReactorDelete(reactor_);
+        for (auto &item : items_) {
+            close(item.fd);
+        }
+    }
+
+    void StartReactor()
+    {
+        std::atomic<bool> started {false};
+        thread_ = std::thread([this, &started]() {
+            ReactorSetThreadId(reactor_, (unsigned long)pthread_self());
+            started = true;
+            ReactorStart(reactor_);
+        });
+        WaitUntil([&started]() { return started.load(); });
+    }
+
+    void StopReactor()
+    {
+        if (thread_.joinable()) {
+            ReactorStop(reactor_);
+            thread_.join();
+        }
+    }
+
+    Reactor *reactor_ = nullptr;
+    std::thread thread_ {};
+    TestItem items_[ITEM_NUM];
+};
+
+/**
+ * @tc.number: Reactor_UnitTest001
+ * @tc.name: ReadReady
+ * @tc.desc: Registered fds are dispatched, unregistered fds are not.
+ */
+HWTEST_F(ReactorTest, Reactor_UnitTest_ReadReady, TestSize.Level1)
+{
+    StartReactor();
+    TestItem &item = items_[0];
+    item.item = ReactorRegister(reactor_, item.fd, &item, OnReadReady, nullptr);
+    ASSERT_NE(item.item, nullptr);
+
+    eventfd_write(item.fd, 1);
+    EXPECT_TRUE(WaitUntil([&item]() { return item.calls.load() == 1; }));
+
+    ReactorUnregister(item.item);
+    eventfd_write(item.fd, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(item.calls.load(), 1);
+}
+
+/**
+ * @tc.number: Reactor_UnitTest002
+ * @tc.name: DrainBatches
+ * @tc.desc: With a batch smaller than the number of ready fds, every fd is still dispatched.
+ */
+HWTEST_F(ReactorTest, Reactor_UnitTest_DrainBatches, TestSize.Level1)
+{
+    ReactorSetEventBatchSize(reactor_, SMALL_BATCH);
+    for (auto &item : items_) {
+        item.item = ReactorRegister(reactor_, item.fd, &item, OnReadReady, nullptr);
+        ASSERT_NE(item.item, nullptr);
+        eventfd_write(item.fd, 1);
+    }
+    StartReactor();
+    for (auto &item : items_) {
+        EXPECT_TRUE(WaitUntil([&item]() { return item.calls.load() == 1; }));
+    }
+    for (auto &item : items_) {
+        ReactorUnregister(item.item);
+    }
+}
+
+/**
+ * @tc.number: Reactor_UnitTest003
+ * @tc.name: UnregisterInCallback
+ * @tc.desc: An item unregistered by another item's callback is not dispatched from the same batch.
+ */
+HWTEST_F(ReactorTest, Reactor_UnitTest_UnregisterInCallback, TestSize.Level1)
+{
+    std::atomic<int> lateCalls {0};
+    for (int i = 0; i < ITEM_NUM; i++) {
+        TestItem &item = items_[i];
+        item.consume = false;
+        item.lateCalls = &lateCalls;
+        // Every even item removes its odd neighbour, whichever of the two is dispatched first.
+        if (i % 2 == 0) {
+            item.victim = &items_[i + 1];
+        }
+        item.item = ReactorRegister(reactor_, item.fd, &item, OnReadReady, nullptr);
+        ASSERT_NE(item.item, nullptr);
+        eventfd_write(item.fd, 1);
+    }
+    StartReactor();
+    for (int i = 1; i < ITEM_NUM; i += 2) {
+        TestItem &item = items_[i];
+        EXPECT_TRUE(WaitUntil([&item]() { return item.removed.load(); }));
+    }
+    StopReactor();
+    EXPECT_EQ(lateCalls.load(), 0);
+    for (int i = 0; i < ITEM_NUM; i += 2) {
+        ReactorUnregister(items_[i].item);
+    }
+}
+
+/**
+ * @tc.number: Reactor_UnitTest004
+ * @tc.name: RegisterUnregisterStress
+ * @tc.desc: Items registered and unregistered from several threads while their fds are permanently ready
+ *           never get a callback after ReactorUnregister returned, and slots are reused.
+ */
+HWTEST_F(ReactorTest, Reactor_UnitTest_RegisterUnregisterStress, TestSize.Level1)
+{
+    std::atomic<int> lateCalls {0};
+    std::atomic<int> registerFailed {0};
+    for (auto &item : items_) {
+        item.consume = false;
+        item.lateCalls = &lateCalls;
+        eventfd_write(item.fd, 1);
+    }
+    StartReactor();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < STRESS_THREADS; t++) {
+        threads.emplace_back([&, t]() {
+            for (int round = 0; round < STRESS_ROUNDS; round++) {
+                for (int i = t; i < ITEM_NUM; i += STRESS_THREADS) {
+                    TestItem &item = items_[i];
+                    item.removed = false;
+                    item.item = ReactorRegister(reactor_, item.fd, &item, OnReadReady, nullptr);
+                    if (item.item == nullptr) {
+                        registerFailed++;
+                    }
+                }
+                std::this_thread::yield();
+                for (int i = t; i < ITEM_NUM; i += STRESS_THREADS) {
+                    TestItem &item = items_[i];
+                    if (item.item != nullptr) {
+                        ReactorUnregister(item.item);
+                    }
+                    item.removed = true;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    StopReactor();
+
+    int calls = 0;
+    for (auto &item : items_) {
+        calls += item.calls.load();
+    }
+    GTEST_LOG_(INFO) << "callbacks dispatched during stress: " << calls;
+    EXPECT_EQ(registerFailed.load(), 0);
+    EXPECT_EQ(lateCalls.load(), 0);
+    EXPECT_GT(calls, 0);
+}
+
+/**
+ * @tc.number: Reactor_UnitTest005
+ * @tc.name: UnregisterWaitsForCallback
+ * @tc.desc: ReactorUnregister from another thread returns only after the running callback of the item has
+ *           returned, and sleeps rather than spins while it waits.
+ */
+HWTEST_F(ReactorTest, Reactor_UnitTest_UnregisterWaitsForCallback, TestSize.Level1)
+{
+    SlowItem slow;
+    slow.fd = items_[0].fd;
+    ReactorItem *item = ReactorRegister(reactor_, slow.fd, &slow, OnReadReadySlow, nullptr);
+    ASSERT_NE(item, nullptr);
+    StartReactor();
+
+    eventfd_write(slow.fd, 1);
+    ASSERT_TRUE(WaitUntil([&slow]() { return slow.entered.load(); }));
+    int64_t cpuStart = ThreadCpuTimeNs();
+    ReactorUnregister(item);
+    int64_t cpuUsed = ThreadCpuTimeNs() - cpuStart;
+
+    EXPECT_TRUE(slow.returned.load());
+    EXPECT_LT(cpuUsed, MAX_UNREGISTER_CPU_NS);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "benchmark_report.h"
+#include "power_activity_tracker.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+const std::string PROFILE_SPP = "SppService";
+const std::string PROFILE_GATT = "GattClientService";
+const RawAddress PEER("00:11:22:33:44:55");
+constexpr uint64_t QUIET_MS = 5;
+constexpr size_t TRANSFER_SIZE = 1024 * 1024;
+constexpr size_t SPP_PACKET_SIZE = 990;
+constexpr auto LINK_PACKET_TIME = std::chrono::microseconds(50);
+
+// Records what PowerManager would post to the dispatcher.
+struct Transitions {
+    std::mutex mutex;
+    std::vector<std::pair<RequestStatus, std::string>> list;
+
+    PowerActivityTracker::TransitionCallback Callback()
+    {
+        return [this](RequestStatus status, const std::string &profileName, const RawAddress &addr) {
+            std::lock_guard<std::mutex> lock(mutex);
+            list.emplace_back(status, profileName);
+        };
+    }
+    size_t Count()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return list.size();
+    }
+};
+
+RawAddress MakeAddress(size_t index)
+{
+    char addr[] = "00:00:00:00:00:00";
+    (void)snprintf(addr, sizeof(addr), "00:00:00:00:%02X:%02X", static_cast<unsigned int>((index >> 8) & 0xFF),
+        static_cast<unsigned int>(index & 0xFF));
+    return RawAddress(addr);
+}
+}  // namespace
+
+class PowerActivityTrackerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+};
+
+/**
+ * @tc.number: PowerActivityTracker_UnitTest001
+ * @tc.name: Transitions
+ * @tc.desc: Only idle to busy and busy to idle after the quiet period are passed on, per device and profile.
+ */
+HWTEST_F(PowerActivityTrackerTest, PowerActivityTracker_UnitTest_Transitions, TestSize.Level1)
+{
+    Transitions transitions;
+    PowerActivityTracker tracker(transitions.Callback(), QUIET_MS);
+
+    for (int i = 0; i < 100; i++) {
+        EXPECT_TRUE(tracker.Update(RequestStatus::BUSY, PROFILE_SPP, PEER));
+        EXPECT_TRUE(tracker.Update(RequestStatus::IDLE, PROFILE_SPP, PEER));
+    }
+    ASSERT_EQ(transitions.list.size(), 1u);
+    EXPECT_EQ(transitions.list[0].first, RequestStatus::BUSY);
+
+    uint64_t now = PowerActivityTracker::NowMs();
+    EXPECT_TRUE(tracker.Sample(now));
+    EXPECT_FALSE(tracker.Sample(now + QUIET_MS));
+    ASSERT_EQ(transitions.list.size(), 2u);
+    EXPECT_EQ(transitions.list[1], std::make_pair(RequestStatus::IDLE, PROFILE_SPP));
+
+    // A pair left in BUSY, as A2DP does for a whole stream, never goes quiet.
+    EXPECT_TRUE(tracker.Update(RequestStatus::BUSY, PROFILE_GATT, PEER));
+    EXPECT_TRUE(tracker.Sample(PowerActivityTracker::NowMs() + QUIET_MS * 100));
+    EXPECT_EQ(transitions.list.size(), 3u);
+
+    // Another status replaces BUSY in the power device, so the next IDLE is passed on at once.
+    tracker.Reset(PROFILE_GATT, PEER);
+    EXPECT_FALSE(tracker.Sample(PowerActivityTracker::NowMs() + QUIET_MS * 100));
+    EXPECT_TRUE(tracker.Update(RequestStatus::IDLE, PROFILE_GATT, PEER));
+    ASSERT_EQ(transitions.list.size(), 4u);
+    EXPECT_EQ(transitions.list[3], std::make_pair(RequestStatus::IDLE, PROFILE_GATT));
+    EXPECT_TRUE(tracker.Update(RequestStatus::IDLE, PROFILE_GATT, PEER));
+    EXPECT_EQ(transitions.list.size(), 4u);
+}
+
+/**
+ * @tc.number: PowerActivityTracker_UnitTest002
+ * @tc.name: SlotsRunOut
+ * @tc.desc: When every slot is taken the caller is told to report directly, and removing a device frees its slots.
+ */
+HWTEST_F(PowerActivityTrackerTest, PowerActivityTracker_UnitTest_SlotsRunOut, TestSize.Level1)
+{
+    Transitions transitions;
+    PowerActivityTracker tracker(transitions.Callback(), QUIET_MS);
+    const size_t slots = PowerActivityTracker::MAX_SLOTS;
+    for (size_t i = 0; i < slots; i++) {
+        EXPECT_TRUE(tracker.Update(RequestStatus::BUSY, PROFILE_SPP, MakeAddress(i)));
+    }
+    RawAddress extra = MakeAddress(slots);
+    EXPECT_FALSE(tracker.Update(RequestStatus::BUSY, PROFILE_SPP, extra));
+    EXPECT_EQ(transitions.Count(), slots);
+
+    tracker.Remove(MakeAddress(0));
+    EXPECT_TRUE(tracker.Update(RequestStatus::BUSY, PROFILE_SPP, extra));
+    EXPECT_EQ(transitions.Count(), slots + 1);
+
+    tracker.Clear();
+    EXPECT_FALSE(tracker.Sample(PowerActivityTracker::NowMs() + QUIET_MS));
+}
+
+/**
+ * @tc.number: PowerActivityTracker_UnitTest003
+ * @tc.name: TasksPerMegabyte
+ * @tc.desc: Dispatcher tasks for power bookkeeping while an SPP link streams 1 MiB, against two per packet before.
+ */
+HWTEST_F(PowerActivityTrackerTest, PowerActivityTracker_UnitTest_TasksPerMegabyte, TestSize.Level1)
+{
+    Transitions transitions;
+    PowerActivityTracker tracker(transitions.Callback(), QUIET_MS);
+    std::atomic_bool streaming {true};
+    std::atomic<size_t> samples {0};
+    std::thread sampler([&]() {
+        // PowerManager samples from its timer while some pair is reported busy.
+        bool busy = true;
+        while (streaming || busy) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(QUIET_MS));
+            busy = tracker.Sample(PowerActivityTracker::NowMs());
+            samples++;
+        }
+    });
+
+    size_t packets = 0;
+    std::chrono::nanoseconds updateTime {0};
+    for (size_t sent = 0; sent < TRANSFER_SIZE; sent += SPP_PACKET_SIZE) {
+        auto start = std::chrono::steady_clock::now();
+        tracker.Update(RequestStatus::BUSY, PROFILE_SPP, PEER);
+        tracker.Update(RequestStatus::IDLE, PROFILE_SPP, PEER);
+        updateTime += std::chrono::steady_clock::now() - start;
+        packets++;
+        std::this_thread::sleep_for(LINK_PACKET_TIME);
+    }
+    streaming = false;
+    sampler.join();
+
+    size_t tasks = transitions.Count() + samples;
+    ASSERT_GE(transitions.Count(), 2u);
+    EXPECT_EQ(transitions.list.front().first, RequestStatus::BUSY);
+    EXPECT_EQ(transitions.list.back().first, RequestStatus::IDLE);
+    EXPECT_LT(tasks, packets * 2 / 10);
+
+    BenchmarkReport("PowerStatusUpdate")
+        .Add("tasks_per_mib", tasks)
+        .Add("before_tasks_per_mib", packets * 2)
+        .Add("ns_per_update", static_cast<double>(updateTime.count()) / (packets * 2))
+        .Publish();
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,369 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "benchmark_report.h"
+#include "platform/include/allocator.h"
+#include "smp_aes_encryption.h"
+#include "smp_common.h"
+#include "smp_sc_initiator.h"
+#include "smp_send.h"
+#include "smp_tool.h"
+
+using namespace testing::ext;
+
+namespace {
+// One pending LE Encrypt: the software AES result waiting on the processing queue for its step.
+struct EncryptTask {
+    uint16_t step;
+    SMP_EncCmd *encCmd;
+    HciLeEncryptReturnParam result;
+};
+
+SMP_PairMng g_pairMng;
+std::deque<EncryptTask> g_encryptTasks;
+}  // namespace
+
+extern "C" {
+void AlarmCancel(Alarm *alarm)
+{
+    (void)alarm;
+}
+
+void AlarmDelete(Alarm *alarm)
+{
+    (void)alarm;
+}
+
+SMP_PairMng *SMP_GetPairMng()
+{
+    return &g_pairMng;
+}
+
+int SMP_EncryptCompleteJudgeException(uint8_t status, uint8_t role)
+{
+    (void)role;
+    return (status == 0) ? SMP_SUCCESS : SMP_ERR_INVAL_STATE;
+}
+
+SMP_EncCmd *SMP_AllocEncCmd()
+{
+    SMP_EncCmd *encCmd = static_cast<SMP_EncCmd *>(MEM_MALLOC.alloc(sizeof(SMP_EncCmd)));
+    (void)memset(encCmd, 0x00, sizeof(SMP_EncCmd));
+    return encCmd;
+}
+
+void SMP_FreeEncCmd(void *encCmd)
+{
+    SMP_EncCmd *pEncCmd = static_cast<SMP_EncCmd *>(encCmd);
+    if (pEncCmd != nullptr) {
+        MEM_MALLOC.free(pEncCmd->M);
+        MEM_MALLOC.free(pEncCmd);
+    }
+}
+
+// Copies the command like smp_send.c and queues the software AES result, as SMP_Aes128Software does.
+int SMP_SendLeEncryptCmd(
+    const HciLeEncryptParam *pEncryptParam, uint16_t step, const SMP_EncCmd *pEncCmdData, bool isUsingHw)
+{
+    (void)isUsingHw;
+    EncryptTask task = {step, SMP_AllocEncCmd(), {}};
+    *task.encCmd = *pEncCmdData;
+    task.encCmd->M = nullptr;
+    if (pEncCmdData->length != 0) {
+        task.encCmd->M = static_cast<uint8_t *>(MEM_MALLOC.alloc(pEncCmdData->length));
+        (void)memcpy(task.encCmd->M, pEncCmdData->M, pEncCmdData->length);
+    }
+    task.result.status = static_cast<uint8_t>(SMP_Aes128(pEncryptParam->key, sizeof(pEncryptParam->key),
+        pEncryptParam->plaintextData, sizeof(pEncryptParam->plaintextData), task.result.encryptedData));
+    g_encryptTasks.push_back(task);
+    return SMP_SUCCESS;
+}
+}
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+using Block = std::vector<uint8_t>;
+
+constexpr uint16_t STEP_NEXT_BLOCK = SMP_SC_PAIR_JUSTWORKORNUMERIC_MASTER_STEP_9;
+constexpr uint16_t STEP_LAST_BLOCK = SMP_SC_PAIR_JUSTWORKORNUMERIC_MASTER_STEP_10;
+constexpr uint32_t RANDOM_SEED = 20220301;
+constexpr int RANDOM_ROUNDS = 200;
+constexpr uint32_t MAX_MESSAGE = 255;
+constexpr int BENCH_ROUNDS = 20000;
+constexpr size_t SIGNED_WRITE_LEN = 1 + 2 + 20 + 4;
+constexpr size_t F4_LEN = 65;
+constexpr size_t F5_LEN = 53;
+constexpr size_t F6_LEN = 65;
+constexpr size_t G2_LEN = 80;
+
+Block Hex(const char *hex)
+{
+    Block out;
+    for (size_t i = 0; hex[i] != '\0';) {
+        if (hex[i] == ' ') {
+            i++;
+            continue;
+        }
+        unsigned int byte = 0;
+        (void)sscanf(&hex[i], "%2x", &byte);
+        out.push_back(static_cast<uint8_t>(byte));
+        i += 2;
+    }
+    return out;
+}
+
+Block Concat(std::initializer_list<Block> parts)
+{
+    Block out;
+    for (const auto &part : parts) {
+        out.insert(out.end(), part.begin(), part.end());
+    }
+    return out;
+}
+
+Block Reverse(const uint8_t *data, size_t length)
+{
+    return Block(std::reverse_iterator<const uint8_t *>(data + length), std::reverse_iterator<const uint8_t *>(data));
+}
+
+/**
+ * AES-CMAC the way the pairing steps compute it: the subkey encrypt result goes into
+ * SMP_ConstituteAesCmacStep3Param and SMP_CryptographicAesCmacStep3, then every queued encrypt of the next block
+ * goes through SMP_CryptographicAesCmacStep4 until the last block comes back.
+ * With hostCbc the blocks before the last are chained by Step3 itself; without it every block takes an encrypt
+ * step, which is what Step3 did before.
+ */
+Block StepCmac(const Block &key, const Block &message, bool hostCbc, int *encryptSteps = nullptr)
+{
+    const uint8_t zero[AES_BLOCK_SIZE] = {0};
+    Block keyLe = Reverse(key.data(), key.size());
+    HciLeEncryptReturnParam subkey = {};
+    subkey.status = static_cast<uint8_t>(SMP_Aes128(keyLe.data(), AES_BLOCK_SIZE, zero, AES_BLOCK_SIZE,
+        subkey.encryptedData));
+    SMP_EncCmd *encCmd = SMP_AllocEncCmd();
+    (void)memcpy(encCmd->key, keyLe.data(), AES_BLOCK_SIZE);
+    SMP_EncData encData = {&subkey, encCmd};
+
+    SMP_CryptAesCmacStep3Param step3 = {};
+    SMP_ConstituteAesCmacStep3Param(&encData, message.empty() ? zero : message.data(),
+        static_cast<uint8_t>(message.size()), &step3);
+    SMP_FreeEncCmd(encCmd);
+    step3.stepA = STEP_NEXT_BLOCK;
+    step3.stepB = STEP_LAST_BLOCK;
+    step3.isUsingHwAes128 = !hostCbc;
+    EXPECT_EQ(SMP_CryptographicAesCmacStep3(&step3), SMP_SUCCESS);
+
+    Block mac;
+    int steps = 0;
+    while (!g_encryptTasks.empty()) {
+        EncryptTask task = g_encryptTasks.front();
+        g_encryptTasks.pop_front();
+        steps++;
+        if (task.step == STEP_NEXT_BLOCK) {
+            SMP_EncData next = {&task.result, task.encCmd};
+            SMP_CryptAesCmacStep4Param step4 = {};
+            EXPECT_EQ(SMP_ConstituteAesCmacStep4Param(&next, STEP_NEXT_BLOCK, STEP_LAST_BLOCK, SMP_ROLE_MASTER, &step4),
+                SMP_SUCCESS);
+            EXPECT_EQ(SMP_CryptographicAesCmacStep4(&step4), SMP_SUCCESS);
+        } else {
+            EXPECT_EQ(task.step, STEP_LAST_BLOCK);
+            mac = Reverse(task.result.encryptedData, AES_BLOCK_SIZE);
+        }
+        SMP_FreeEncCmd(task.encCmd);
+    }
+    if (encryptSteps != nullptr) {
+        *encryptSteps = steps;
+    }
+    return mac;
+}
+
+Block Cmac(const Block &key, const Block &message)
+{
+    return StepCmac(key, message, true);
+}
+
+double NsPerOp(int rounds, const std::function<void()> &body)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        body();
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+}
+
+void Report(const char *name, double hostNs, double stepsNs)
+{
+    BenchmarkReport(name).Add("host_cbc_ns_per_op", hostNs).Add("encrypt_steps_ns_per_op", stepsNs).Publish();
+}
+
+const Block RFC_KEY = Hex("2b7e1516 28aed2a6 abf71588 09cf4f3c");
+const Block RFC_MESSAGE = Hex("6bc1bee2 2e409f96 e93d7e11 7393172a ae2d8a57 1e03ac9c 9eb76fac 45af8e51"
+                              "30c81c46 a35ce411 e5fbc119 1a0a52ef f69f2445 df4f9b17 ad2b417b e66c3710");
+
+const Block SPEC_U = Hex("20b003d2 f297be2c 5e2c83a7 e9f9a5b9 eff49111 acf4fddb cc030148 0e359de6");
+const Block SPEC_V = Hex("55188b3d 32f6bb9a 900afcfb eed4e72a 59cb9ac2 f19d7cfb 6b4fdd49 f47fc5fd");
+const Block SPEC_X = Hex("d5cb8454 d177733e ffffb2ec 712baeab");
+const Block SPEC_Y = Hex("a6e8e7cc 25a75f6e 216583f7 ff3dc4cf");
+const Block SPEC_W = Hex("ec0234a3 57c8ad05 341010a6 0a397d9b 99796b13 b4f866f1 868d34f3 73bfa698");
+const Block SPEC_N1 = Hex("d5cb8454 d177733e ffffb2ec 712baeab");
+const Block SPEC_N2 = Hex("a6e8e7cc 25a75f6e 216583f7 ff3dc4cf");
+const Block SPEC_A1 = Hex("00561237 37bfce");
+const Block SPEC_A2 = Hex("00a71370 2dcfc1");
+const Block SPEC_R = Hex("12a3343b b453bb54 08da42d2 0c2d0fc8");
+const Block SPEC_IOCAP = Hex("010102");
+const Block SPEC_SALT = Hex("6c888391 aaf5a538 60370bdb 5a6083be");
+const Block SPEC_KEY_ID = Hex("62746c65");
+const Block SPEC_LENGTH = Hex("0100");
+}  // namespace
+
+class SmpAesCmacTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {
+        EXPECT_TRUE(g_encryptTasks.empty());
+    }
+};
+
+/**
+ * @tc.number: SmpAesCmac_UnitTest001
+ * @tc.name: Rfc4493
+ * @tc.desc: RFC 4493 section 4 examples for 0, 16, 40 and 64 byte messages through the Step3/Step4 chain, with the
+ *           host chaining the leading blocks and with one encrypt step per block.
+ */
+HWTEST_F(SmpAesCmacTest, SmpAesCmac_UnitTest_Rfc4493, TestSize.Level1)
+{
+    const std::vector<std::pair<size_t, Block>> examples = {
+        {0, Hex("bb1d6929 e9593728 7fa37d12 9b756746")},
+        {16, Hex("070a16b4 6b4d4144 f79bdd9d d04a287c")},
+        {40, Hex("dfa66747 de9ae630 30ca3261 1497c827")},
+        {64, Hex("51f0bebf 7e3b9d92 fc497417 79363cfe")},
+    };
+    for (const auto &example : examples) {
+        Block message(RFC_MESSAGE.begin(), RFC_MESSAGE.begin() + example.first);
+        EXPECT_EQ(StepCmac(RFC_KEY, message, true), example.second) << "length " << example.first;
+        EXPECT_EQ(StepCmac(RFC_KEY, message, false), example.second) << "length " << example.first;
+    }
+}
+
+/**
+ * @tc.number: SmpAesCmac_UnitTest002
+ * @tc.name: CoreSpecToolbox
+ * @tc.desc: Core spec Vol 3 Part H appendix D vectors for f4, f5, f6 and g2 through the Step3/Step4 chain.
+ */
+HWTEST_F(SmpAesCmacTest, SmpAesCmac_UnitTest_CoreSpecToolbox, TestSize.Level1)
+{
+    EXPECT_EQ(Cmac(SPEC_X, Concat({SPEC_U, SPEC_V, Hex("00")})), Hex("f2c916f1 07a9bd1c f1eda1be a974872d"));
+
+    Block t = Cmac(SPEC_SALT, SPEC_W);
+    EXPECT_EQ(t, Hex("3c128f20 de883288 97624bdb 8dac6989"));
+    Block macKey = Cmac(t, Concat({Hex("00"), SPEC_KEY_ID, SPEC_N1, SPEC_N2, SPEC_A1, SPEC_A2, SPEC_LENGTH}));
+    EXPECT_EQ(macKey, Hex("2965f176 a1084a02 fd3f6a20 ce636e20"));
+    EXPECT_EQ(Cmac(t, Concat({Hex("01"), SPEC_KEY_ID, SPEC_N1, SPEC_N2, SPEC_A1, SPEC_A2, SPEC_LENGTH})),
+        Hex("69867911 69d7cd23 980522b5 94750a38"));
+
+    EXPECT_EQ(Cmac(macKey, Concat({SPEC_N1, SPEC_N2, SPEC_R, SPEC_IOCAP, SPEC_A1, SPEC_A2})),
+        Hex("e3c47398 9cd0e8c5 d26c0b09 da958f61"));
+
+    Block g2 = Cmac(SPEC_X, Concat({SPEC_U, SPEC_V, SPEC_Y}));
+    EXPECT_EQ(Block(g2.end() - 4, g2.end()), Hex("2f9ed5ba"));
+}
+
+/**
+ * @tc.number: SmpAesCmac_UnitTest003
+ * @tc.name: MatchesEncryptSteps
+ * @tc.desc: For random keys and message lengths, chaining on the host gives the MAC of one encrypt step per block
+ *           in a single step, and SMP_AesCbcMac chains full blocks the same way.
+ */
+HWTEST_F(SmpAesCmacTest, SmpAesCmac_UnitTest_MatchesEncryptSteps, TestSize.Level1)
+{
+    std::mt19937 rng(RANDOM_SEED);
+    for (int round = 0; round < RANDOM_ROUNDS; round++) {
+        Block key(AES_BLOCK_SIZE);
+        Block message(rng() % (MAX_MESSAGE + 1));
+        for (auto &byte : key) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        for (auto &byte : message) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        int hostSteps = 0;
+        int blockSteps = 0;
+        size_t blocks = message.empty() ? 1 : (message.size() + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+        ASSERT_EQ(StepCmac(key, message, true, &hostSteps), StepCmac(key, message, false, &blockSteps))
+            << "length " << message.size();
+        EXPECT_EQ(hostSteps, 1);
+        EXPECT_EQ(blockSteps, static_cast<int>(blocks));
+
+        uint32_t fullBlocks = message.size() / AES_BLOCK_SIZE;
+        Block chained(AES_BLOCK_SIZE, 0);
+        Block stepped(AES_BLOCK_SIZE, 0);
+        ASSERT_EQ(SMP_AesCbcMac(key.data(), message.data(), fullBlocks, chained.data()), 0);
+        for (uint32_t block = 0; block < fullBlocks; block++) {
+            ASSERT_EQ(SMP_AesCbcMac(key.data(), &message[block * AES_BLOCK_SIZE], 1, stepped.data()), 0);
+        }
+        ASSERT_EQ(chained, stepped);
+    }
+}
+
+/**
+ * @tc.number: SmpAesCmac_UnitTest004
+ * @tc.name: Latency
+ * @tc.desc: Step3/Step4 AES-CMAC latency for a signed write signature and for the CMACs of one LE Secure
+ *           Connections pairing (f4, g2, f5, two f6), host chaining against one encrypt step per block.
+ */
+HWTEST_F(SmpAesCmacTest, SmpAesCmac_UnitTest_Latency, TestSize.Level1)
+{
+    std::mt19937 rng(RANDOM_SEED);
+    Block key(AES_BLOCK_SIZE);
+    for (auto &byte : key) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    Block signedWrite(SIGNED_WRITE_LEN, 0x5A);
+    volatile uint8_t sink = 0;
+
+    auto sign = [&](bool hostCbc) { return [&, hostCbc]() { sink += StepCmac(key, signedWrite, hostCbc)[0]; }; };
+    Report("SmpSignedWriteSignature", NsPerOp(BENCH_ROUNDS, sign(true)), NsPerOp(BENCH_ROUNDS, sign(false)));
+
+    auto pair = [&](bool hostCbc) {
+        return [&, hostCbc]() {
+            sink += StepCmac(key, Block(F4_LEN), hostCbc)[0];
+            sink += StepCmac(key, Block(G2_LEN), hostCbc)[0];
+            sink += StepCmac(key, Block(SPEC_W), hostCbc)[0];
+            sink += StepCmac(key, Block(F5_LEN), hostCbc)[0];
+            sink += StepCmac(key, Block(F5_LEN), hostCbc)[0];
+            sink += StepCmac(key, Block(F6_LEN), hostCbc)[0];
+            sink += StepCmac(key, Block(F6_LEN), hostCbc)[0];
+        };
+    };
+    Report("SmpScPairingCmacs", NsPerOp(BENCH_ROUNDS / 8, pair(true)), NsPerOp(BENCH_ROUNDS / 8, pair(false)));
+    EXPECT_GE(sink, 0);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "benchmark_report.h"
+#include "socket_bridge.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr uint16_t SPP_MTU = 990;
+constexpr size_t TRANSFER_SIZE = 32 * 1024 * 1024;
+constexpr size_t APP_WRITE_SIZE = 64 * 1024;
+constexpr size_t PATTERN_PERIOD = 65521;
+constexpr int POLL_TIMEOUT_MS = 1000;
+constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+
+uint8_t PatternByte(size_t offset)
+{
+    return static_cast<uint8_t>((offset * 7) ^ (offset >> 11));
+}
+
+Packet *MakeScatterPacket(size_t offset, const std::vector<uint32_t> &sizes)
+{
+    Packet *pkt = PacketMalloc(0, 0, 0);
+    for (uint32_t size : sizes) {
+        Buffer *buf = BufferMalloc(size);
+        auto *data = static_cast<uint8_t *>(BufferPtr(buf));
+        for (uint32_t i = 0; i < size; i++) {
+            data[i] = PatternByte(offset++);
+        }
+        PacketPayloadAddLast(pkt, buf);
+        BufferFree(buf);
+    }
+    return pkt;
+}
+
+// CPU time of the calling thread, which runs the bridge.
+double CpuSeconds()
+{
+    struct timespec ts = {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Two socket pairs like SPP uses: the app writes into out[0] and reads from in[0].
+struct Loopback {
+    int out[2] = {-1, -1};
+    int in[2] = {-1, -1};
+
+    Loopback()
+    {
+        EXPECT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, out), 0);
+        EXPECT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, in), 0);
+    }
+    ~Loopback()
+    {
+        for (int fd : {out[0], out[1], in[0], in[1]}) {
+            if (fd != -1) {
+                close(fd);
+            }
+        }
+    }
+};
+
+struct Result {
+    double seconds = 0;
+    double cpuSeconds = 0;
+    size_t errors = 0;
+};
+
+// Streams TRANSFER_SIZE bytes from an app writer thread through pump back to an app reader thread.
+Result RunLoopback(Loopback &loop, const std::function<bool()> &pump)
+{
+    // Writer and reader work on a repeating pattern so that they keep ahead of the bridge.
+    std::vector<uint8_t> pattern(PATTERN_PERIOD + APP_WRITE_SIZE);
+    for (size_t i = 0; i < pattern.size(); i++) {
+        pattern[i] = PatternByte(i % PATTERN_PERIOD);
+    }
+    Result result;
+    auto start = std::chrono::steady_clock::now();
+    double cpuStart = CpuSeconds();
+    std::thread writer([&loop, &pattern]() {
+        for (size_t sent = 0; sent < TRANSFER_SIZE;) {
+            ssize_t ret = write(loop.out[0], pattern.data() + sent % PATTERN_PERIOD, APP_WRITE_SIZE);
+            ASSERT_GT(ret, 0);
+            sent += ret;
+        }
+        shutdown(loop.out[0], SHUT_WR);
+    });
+    std::thread reader([&loop, &pattern, &result]() {
+        std::vector<uint8_t> chunk(APP_WRITE_SIZE);
+        size_t received = 0;
+        while (received < TRANSFER_SIZE) {
+            ssize_t ret = read(loop.in[0], chunk.data(), chunk.size());
+            ASSERT_GT(ret, 0);
+            result.errors += (memcmp(chunk.data(), pattern.data() + received % PATTERN_PERIOD, ret) != 0) ? 1 : 0;
+            received += ret;
+        }
+    });
+
+    while (pump()) {
+    }
+    writer.join();
+    reader.join();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.cpuSeconds = CpuSeconds() - cpuStart;
+    return result;
+}
+}  // namespace
+
+class SocketBridgeTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+};
+
+/**
+ * @tc.number: SocketBridge_UnitTest001
+ * @tc.name: SendToAppPartial
+ * @tc.desc: Scatter packets reach a slow app exactly once and in order when sends are partial.
+ */
+HWTEST_F(SocketBridgeTest, SocketBridge_UnitTest_SendToAppPartial, TestSize.Level1)
+{
+    Loopback loop;
+    int sndBuf = 4096;
+    ASSERT_EQ(setsockopt(loop.in[1], SOL_SOCKET, SO_SNDBUF, &sndBuf, sizeof(sndBuf)), 0);
+
+    SocketBridge bridge;
+    const size_t packets = SocketBridge::MAX_APP_PACKETS;
+    size_t total = 0;
+    while (bridge.GetAppQueueSize() < packets) {
+        bridge.QueueToApp(MakeScatterPacket(total, {7, 0, 300, 683}));
+        total += SPP_MTU;
+    }
+    bridge.QueueToApp(PacketMalloc(0, 0, 0));
+    EXPECT_EQ(bridge.GetAppQueueSize(), packets);
+
+    std::vector<uint8_t> data(total);
+    size_t received = 0;
+    SocketSendRet ret = SOCKET_SEND_NONE;
+    size_t blocked = 0;
+    while (received < total) {
+        ret = bridge.SendToApp(loop.in[1]);
+        ASSERT_NE(ret, SOCKET_SEND_ERROR);
+        blocked += (ret != SOCKET_SEND_ALL) ? 1 : 0;
+        ssize_t n = recv(loop.in[0], data.data() + received, total - received, MSG_DONTWAIT);
+        if (n > 0) {
+            received += n;
+        }
+    }
+    EXPECT_EQ(ret, SOCKET_SEND_ALL);
+    EXPECT_GT(blocked, 0u);
+    EXPECT_EQ(bridge.GetAppQueueSize(), 0u);
+    for (size_t i = 0; i < total; i++) {
+        ASSERT_EQ(data[i], PatternByte(i)) << "offset " << i;
+    }
+    EXPECT_EQ(recv(loop.in[0], data.data(), 1, MSG_DONTWAIT), -1);
+}
+
+/**
+ * @tc.number: SocketBridge_UnitTest002
+ * @tc.name: ReadFromApp
+ * @tc.desc: The app socket backlog is received at once and cut into MTU sized packets that are kept until taken.
+ */
+HWTEST_F(SocketBridgeTest, SocketBridge_UnitTest_ReadFromApp, TestSize.Level1)
+{
+    Loopback loop;
+    SocketBridge bridge;
+    EXPECT_EQ(bridge.ReadFromApp(loop.out[1], SPP_MTU), 0);
+
+    const size_t total = SPP_MTU * 3 + SPP_MTU / 2;
+    std::vector<uint8_t> data(total);
+    for (size_t i = 0; i < total; i++) {
+        data[i] = PatternByte(i);
+    }
+    ASSERT_EQ(write(loop.out[0], data.data(), total), static_cast<ssize_t>(total));
+    EXPECT_EQ(bridge.ReadFromApp(loop.out[1], SPP_MTU), static_cast<ssize_t>(total));
+
+    size_t offset = 0;
+    std::vector<uint8_t> payload(SPP_MTU);
+    while (Packet *pkt = bridge.FrontToStack()) {
+        uint32_t size = PacketPayloadSize(pkt);
+        EXPECT_EQ(size, std::min<size_t>(SPP_MTU, total - offset));
+        EXPECT_EQ(PacketPayloadSegments(pkt, nullptr, 0), 1u);
+        // The stack refusing a packet leaves it queued.
+        EXPECT_EQ(bridge.FrontToStack(), pkt);
+        ASSERT_EQ(PacketPayloadRead(pkt, payload.data(), 0, size), size);
+        EXPECT_EQ(memcmp(payload.data(), data.data() + offset, size), 0);
+        offset += size;
+        bridge.PopToStack();
+    }
+    EXPECT_EQ(offset, total);
+
+    shutdown(loop.out[0], SHUT_WR);
+    EXPECT_EQ(bridge.ReadFromApp(loop.out[1], SPP_MTU), -1);
+}
+
+/**
+ * @tc.number: SocketBridge_UnitTest003
+ * @tc.name: LoopbackThroughput
+ * @tc.desc: MB/s and CPU time per MB of the bridge against the former read and send per packet.
+ */
+HWTEST_F(SocketBridgeTest, SocketBridge_UnitTest_LoopbackThroughput, TestSize.Level1)
+{
+    Result before;
+    {
+        // Former path: FIONREAD, one read into a new packet per MTU, flatten, one blocking send per packet.
+        Loopback loop;
+        bool eof = false;
+        before = RunLoopback(loop, [&loop, &eof]() {
+            struct pollfd pfd = {loop.out[1], POLLIN, 0};
+            if (eof || poll(&pfd, 1, POLL_TIMEOUT_MS) <= 0) {
+                return false;
+            }
+            int totalSize = 0;
+            if (ioctl(loop.out[1], FIONREAD, &totalSize) != 0 || totalSize == 0) {
+                eof = true;
+                return false;
+            }
+            while (totalSize > 0) {
+                int size = (totalSize > SPP_MTU) ? SPP_MTU : totalSize;
+                Packet *pkt = PacketMalloc(0, 0, size);
+                int rbytes = read(loop.out[1], BufferPtr(PacketContinuousPayload(pkt)), size);
+                Packet *received = PacketRefMalloc(pkt);
+                PacketFree(pkt);
+                if (rbytes > 0) {
+                    uint8_t *data = static_cast<uint8_t *>(BufferPtr(PacketContinuousPayload(received)));
+                    (void)send(loop.in[1], data, rbytes, MSG_NOSIGNAL);
+                }
+                PacketFree(received);
+                totalSize -= size;
+            }
+            return true;
+        });
+    }
+
+    Result after;
+    {
+        Loopback loop;
+        SocketBridge bridge;
+        bool eof = false;
+        after = RunLoopback(loop, [&loop, &bridge, &eof]() {
+            if (!eof && bridge.FrontToStack() == nullptr && bridge.GetAppQueueSize() < SocketBridge::MAX_APP_PACKETS) {
+                eof = (bridge.ReadFromApp(loop.out[1], SPP_MTU) < 0);
+            }
+            while (Packet *pkt = bridge.FrontToStack()) {
+                if (bridge.GetAppQueueSize() >= SocketBridge::MAX_APP_PACKETS) {
+                    break;
+                }
+                // What RFCOMM hands to the peer is what the peer's RFCOMM receives.
+                bridge.QueueToApp(PacketRefMalloc(pkt));
+                bridge.PopToStack();
+            }
+            SocketSendRet ret = bridge.SendToApp(loop.in[1]);
+            if (ret == SOCKET_SEND_ERROR) {
+                return false;
+            }
+            if (ret == SOCKET_SEND_ALL && bridge.FrontToStack() != nullptr) {
+                return true;
+            }
+            if (eof && ret == SOCKET_SEND_ALL) {
+                return false;
+            }
+            struct pollfd pfds[] = {{loop.out[1], 0, 0}, {loop.in[1], 0, 0}};
+            pfds[0].events = (bridge.FrontToStack() == nullptr && !eof) ? POLLIN : 0;
+            pfds[1].events = (ret != SOCKET_SEND_ALL) ? POLLOUT : 0;
+            return poll(pfds, 2, POLL_TIMEOUT_MS) > 0;
+        });
+    }
+
+    EXPECT_EQ(before.errors, 0u);
+    EXPECT_EQ(after.errors, 0u);
+    double mb = TRANSFER_SIZE / BYTES_PER_MB;
+    BenchmarkReport("SppLoopback")
+        .Add("mb_per_s", mb / after.seconds)
+        .Add("cpu_ms_per_mb", after.cpuSeconds * 1000 / mb, 3)
+        .Add("before_mb_per_s", mb / before.seconds)
+        .Add("before_cpu_ms_per_mb", before.cpuSeconds * 1000 / mb, 3)
+        .Publish();
+}
+}  // namespace bluetooth
+}  // namespace OHOS
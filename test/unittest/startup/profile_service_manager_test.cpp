@@ -0,0 +1,414 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "adapter_manager.h"
+#include "class_creator.h"
+#include "dispatcher.h"
+#include "profile_info.h"
+#include "profile_service_manager.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr int WAIT_TIMEOUT_SEC = 5;
+const std::string GATT_CLIENT = "MockGattClient";
+const std::string HID_HOST = "MockHidHost";
+const std::string PAN = "MockPan";
+
+// The GATT client runs on both transports, the HOGP host only on LE and needs the GATT client.
+const std::vector<ProfileInfo> BREDR_PROFILES = {
+    ProfileInfo(GATT_CLIENT, 1, ""),
+    ProfileInfo(PAN, 2, ""),
+};
+const std::vector<ProfileInfo> BLE_PROFILES = {
+    ProfileInfo(GATT_CLIENT, 1, ""),
+    ProfileInfo(HID_HOST, 3, "", {GATT_CLIENT}),
+};
+const std::vector<ProfileInfo> SUPPORT_PROFILES = {
+    ProfileInfo(GATT_CLIENT, 1, ""),
+    ProfileInfo(PAN, 2, ""),
+    ProfileInfo(HID_HOST, 3, "", {GATT_CLIENT}),
+};
+
+std::map<std::string, int> g_enableRequests {};
+std::map<std::string, int> g_disableRequests {};
+std::vector<std::pair<BTTransport, bool>> g_enableResults {};
+std::vector<std::pair<BTTransport, bool>> g_disableResults {};
+int g_adapterToken = 0;
+
+// Enabling and disabling only count the requests, the test completes them through the context callback.
+class MockProfile : public IProfile, public utility::Context {
+public:
+    explicit MockProfile(const std::string &name) : utility::Context(name, "1.0")
+    {}
+    ~MockProfile() override = default;
+
+    int Connect(const RawAddress &) override
+    {
+        return 0;
+    }
+    int Disconnect(const RawAddress &) override
+    {
+        return 0;
+    }
+    std::list<RawAddress> GetConnectDevices() override
+    {
+        return {};
+    }
+    int GetConnectState() override
+    {
+        return 0;
+    }
+    int GetMaxConnectNum() override
+    {
+        return 0;
+    }
+    utility::Context *GetContext() override
+    {
+        return this;
+    }
+    void Enable() override
+    {
+        g_enableRequests[Name()]++;
+    }
+    void Disable() override
+    {
+        g_disableRequests[Name()]++;
+    }
+};
+
+void *CreateGattClient()
+{
+    return static_cast<IProfile *>(new MockProfile(GATT_CLIENT));
+}
+
+void *CreateHidHost()
+{
+    return static_cast<IProfile *>(new MockProfile(HID_HOST));
+}
+
+void *CreatePan()
+{
+    return static_cast<IProfile *>(new MockProfile(PAN));
+}
+}  // namespace
+
+const std::vector<ProfileInfo> &SupportProfilesInfo::GetSupportProfiles()
+{
+    return SUPPORT_PROFILES;
+}
+
+std::string SupportProfilesInfo::IdToName(uint32_t id)
+{
+    for (auto &profile : SUPPORT_PROFILES) {
+        if (profile.id_ == id) {
+            return profile.name_;
+        }
+    }
+    return "";
+}
+
+std::vector<std::string> SupportProfilesInfo::GetDependencies(const std::string &name)
+{
+    for (auto &profile : SUPPORT_PROFILES) {
+        if (profile.name_ == name) {
+            return profile.dependencies_;
+        }
+    }
+    return {};
+}
+
+const std::vector<ProfileInfo> SupportProfilesInfo::GetConfigSupportProfiles(BTTransport transport)
+{
+    return (transport == BTTransport::ADAPTER_BREDR) ? BREDR_PROFILES : BLE_PROFILES;
+}
+
+// Only what the profile service manager uses: both adapters exist and the profile results are recorded.
+struct AdapterManager::impl {};
+
+AdapterManager::AdapterManager() : pimpl(std::make_unique<AdapterManager::impl>())
+{}
+
+AdapterManager::~AdapterManager()
+{}
+
+IAdapterManager *IAdapterManager::GetInstance()
+{
+    return AdapterManager::GetInstance();
+}
+
+AdapterManager *AdapterManager::GetInstance()
+{
+    static AdapterManager instance;
+    return &instance;
+}
+
+void AdapterManager::OnProfileServicesEnableComplete(const BTTransport transport, const bool ret) const
+{
+    g_enableResults.emplace_back(transport, ret);
+}
+
+void AdapterManager::OnProfileServicesDisableComplete(const BTTransport transport, const bool ret) const
+{
+    g_disableResults.emplace_back(transport, ret);
+}
+
+// The manager only checks that the adapters exist, the pointers are never dereferenced.
+std::shared_ptr<IAdapterClassic> AdapterManager::GetClassicAdapterInterface(void) const
+{
+    return std::shared_ptr<IAdapterClassic>(
+        std::shared_ptr<IAdapterClassic>(), reinterpret_cast<IAdapterClassic *>(&g_adapterToken));
+}
+
+std::shared_ptr<IAdapterBle> AdapterManager::GetBleAdapterInterface(void) const
+{
+    return std::shared_ptr<IAdapterBle>(
+        std::shared_ptr<IAdapterBle>(), reinterpret_cast<IAdapterBle *>(&g_adapterToken));
+}
+
+bool AdapterManager::Start()
+{
+    return true;
+}
+
+void AdapterManager::Stop() const
+{}
+
+void AdapterManager::Reset() const
+{}
+
+bool AdapterManager::FactoryReset() const
+{
+    return true;
+}
+
+bool AdapterManager::Enable(const BTTransport) const
+{
+    return true;
+}
+
+bool AdapterManager::Disable(const BTTransport) const
+{
+    return true;
+}
+
+BTStateID AdapterManager::GetState(const BTTransport) const
+{
+    return BTStateID::STATE_TURN_ON;
+}
+
+BTConnectState AdapterManager::GetAdapterConnectState() const
+{
+    return BTConnectState::DISCONNECTED;
+}
+
+bool AdapterManager::RegisterStateObserver(IAdapterStateObserver &) const
+{
+    return true;
+}
+
+bool AdapterManager::DeregisterStateObserver(IAdapterStateObserver &) const
+{
+    return true;
+}
+
+bool AdapterManager::RegisterSystemStateObserver(ISystemStateObserver &) const
+{
+    return true;
+}
+
+bool AdapterManager::DeregisterSystemStateObserver(ISystemStateObserver &) const
+{
+    return true;
+}
+
+int AdapterManager::GetMaxNumConnectedAudioDevices() const
+{
+    return 0;
+}
+
+bool AdapterManager::SetPhonebookPermission(const std::string &, BTPermissionType) const
+{
+    return true;
+}
+
+BTPermissionType AdapterManager::GetPhonebookPermission(const std::string &) const
+{
+    return BTPermissionType::ACCESS_UNKNOWN;
+}
+
+bool AdapterManager::SetMessagePermission(const std::string &, BTPermissionType) const
+{
+    return true;
+}
+
+BTPermissionType AdapterManager::GetMessagePermission(const std::string &) const
+{
+    return BTPermissionType::ACCESS_UNKNOWN;
+}
+
+int AdapterManager::GetPowerMode(const std::string &) const
+{
+    return 0;
+}
+
+class ProfileServiceManagerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {
+        ClassFactory::RegisterClass(GATT_CLIENT, CreateGattClient);
+        ClassFactory::RegisterClass(HID_HOST, CreateHidHost);
+        ClassFactory::RegisterClass(PAN, CreatePan);
+    }
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {
+        g_enableRequests.clear();
+        g_disableRequests.clear();
+        g_enableResults.clear();
+        g_disableResults.clear();
+        dispatcher_.Initialize();
+        manager_ = std::make_unique<ProfileServiceManager>(dispatcher_);
+        Run([this]() { manager_->Start(); });
+    }
+    void TearDown()
+    {
+        Run([this]() { manager_->Stop(); });
+        dispatcher_.Uninitialize();
+        manager_ = nullptr;
+    }
+
+    // The manager is not thread safe, everything it does runs on its dispatcher as in the service.
+    void Run(const std::function<void()> &task)
+    {
+        auto done = std::make_shared<std::promise<void>>();
+        dispatcher_.PostTask([task, done]() {
+            task();
+            done->set_value();
+        });
+        ASSERT_EQ(done->get_future().wait_for(std::chrono::seconds(WAIT_TIMEOUT_SEC)), std::future_status::ready);
+    }
+
+    void Complete(const std::string &name, bool ret)
+    {
+        Run([this, name, ret]() { manager_->GetProfileService(name)->GetContext()->OnEnable(name, ret); });
+        // The result goes through the dispatcher once more.
+        Run([]() {});
+    }
+
+    utility::Dispatcher dispatcher_ {"bt-test-profile-manager"};
+    std::unique_ptr<ProfileServiceManager> manager_ {};
+};
+
+/**
+ * @tc.number: ProfileServiceManager_UnitTest001
+ * @tc.name: DependencyFailed
+ * @tc.desc: A profile whose dependency failed goes back to off, the enable completes without it.
+ */
+HWTEST_F(ProfileServiceManagerTest, ProfileServiceManager_UnitTest_DependencyFailed, TestSize.Level1)
+{
+    Run([this]() { manager_->Enable(BTTransport::ADAPTER_BLE); });
+    EXPECT_EQ(g_enableRequests[GATT_CLIENT], 1);
+    EXPECT_EQ(g_enableRequests[HID_HOST], 0);
+
+    Complete(GATT_CLIENT, false);
+    EXPECT_EQ(g_enableRequests[HID_HOST], 0);
+    EXPECT_NE(manager_->GetStartupReport(BTTransport::ADAPTER_BLE).find(HID_HOST + "=skipped"), std::string::npos);
+    // Nothing is left waiting: the enable completed, failed as neither profile is on.
+    ASSERT_EQ(g_enableResults.size(), 1u);
+    EXPECT_EQ(g_enableResults[0].first, BTTransport::ADAPTER_BLE);
+    EXPECT_FALSE(g_enableResults[0].second);
+
+    // Off again, the next enable starts it.
+    Run([this]() { manager_->Enable(BTTransport::ADAPTER_BLE); });
+    EXPECT_EQ(g_enableRequests[GATT_CLIENT], 2);
+    Complete(GATT_CLIENT, true);
+    EXPECT_EQ(g_enableRequests[HID_HOST], 1);
+}
+
+/**
+ * @tc.number: ProfileServiceManager_UnitTest002
+ * @tc.name: DisableWhileWaiting
+ * @tc.desc: A profile disabled while waiting for its dependencies is not enabled once they complete.
+ */
+HWTEST_F(ProfileServiceManagerTest, ProfileServiceManager_UnitTest_DisableWhileWaiting, TestSize.Level1)
+{
+    Run([this]() { manager_->Enable(BTTransport::ADAPTER_BLE); });
+    Run([this]() { manager_->Disable(BTTransport::ADAPTER_BLE); });
+    EXPECT_TRUE(g_disableResults.empty());
+
+    Complete(GATT_CLIENT, true);
+    EXPECT_EQ(g_enableRequests[HID_HOST], 0);
+    EXPECT_EQ(g_disableRequests[HID_HOST], 0);
+    ASSERT_EQ(g_enableResults.size(), 1u);
+    EXPECT_FALSE(g_enableResults[0].second);
+}
+
+/**
+ * @tc.number: ProfileServiceManager_UnitTest003
+ * @tc.name: OtherTransportOn
+ * @tc.desc: A dependency already on for the other transport releases its dependents without a callback.
+ */
+HWTEST_F(ProfileServiceManagerTest, ProfileServiceManager_UnitTest_OtherTransportOn, TestSize.Level1)
+{
+    Run([this]() { manager_->Enable(BTTransport::ADAPTER_BREDR); });
+    Complete(GATT_CLIENT, true);
+    Complete(PAN, true);
+    ASSERT_EQ(g_enableResults.size(), 1u);
+    EXPECT_TRUE(g_enableResults[0].second);
+
+    Run([this]() { manager_->Enable(BTTransport::ADAPTER_BLE); });
+    EXPECT_EQ(g_enableRequests[GATT_CLIENT], 1);
+    EXPECT_EQ(g_enableRequests[HID_HOST], 1);
+
+    Complete(HID_HOST, true);
+    ASSERT_EQ(g_enableResults.size(), 2u);
+    EXPECT_EQ(g_enableResults[1].first, BTTransport::ADAPTER_BLE);
+    EXPECT_TRUE(g_enableResults[1].second);
+}
+
+/**
+ * @tc.number: ProfileServiceManager_UnitTest004
+ * @tc.name: DependencyStillTurningOn
+ * @tc.desc: A dependency still turning on from an earlier enable holds its dependents back until it completes.
+ */
+HWTEST_F(ProfileServiceManagerTest, ProfileServiceManager_UnitTest_DependencyStillTurningOn, TestSize.Level1)
+{
+    Run([this]() { manager_->Enable(BTTransport::ADAPTER_BLE); });
+    Run([this]() { manager_->Disable(BTTransport::ADAPTER_BLE); });
+    Run([this]() { manager_->Enable(BTTransport::ADAPTER_BLE); });
+    EXPECT_EQ(g_enableRequests[GATT_CLIENT], 1);
+    EXPECT_EQ(g_enableRequests[HID_HOST], 0);
+
+    Complete(GATT_CLIENT, true);
+    EXPECT_EQ(g_enableRequests[HID_HOST], 1);
+    Complete(HID_HOST, true);
+    ASSERT_EQ(g_enableResults.size(), 1u);
+    EXPECT_TRUE(g_enableResults[0].second);
+}
+}  // namespace bluetooth
+}  // namespace OHOS
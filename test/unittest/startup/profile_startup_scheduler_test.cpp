@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark_report.h"
+#include "dispatcher.h"
+#include "phase_timer.h"
+#include "profile_startup_scheduler.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+namespace {
+constexpr int WAIT_TIMEOUT_SEC = 5;
+
+struct MockProfile {
+    std::string name;
+    std::vector<std::string> dependencies;
+    int enableMs;
+    bool result;
+};
+
+// Stands in for the profile service manager: profiles enable on their own dispatchers and report back on its one.
+class MockStartup {
+public:
+    explicit MockStartup(const std::vector<MockProfile> &profiles) : manager_("bt-test-manager")
+    {
+        manager_.Initialize();
+        for (auto &profile : profiles) {
+            profiles_[profile.name] = profile;
+            auto dispatcher = std::make_unique<utility::Dispatcher>("bt-test-" + profile.name);
+            dispatcher->Initialize();
+            dispatchers_[profile.name] = std::move(dispatcher);
+        }
+    }
+
+    ~MockStartup()
+    {
+        for (auto &dispatcher : dispatchers_) {
+            dispatcher.second->Uninitialize();
+        }
+        manager_.Uninitialize();
+    }
+
+    bool Run()
+    {
+        std::vector<ProfileStartupNode> nodes;
+        for (auto &profile : profiles_) {
+            nodes.push_back(ProfileStartupNode {profile.first, profile.second.dependencies});
+        }
+        manager_.PostTask([this, nodes]() { Advance(scheduler_.Start(nodes)); });
+        return done_.get_future().wait_for(std::chrono::seconds(WAIT_TIMEOUT_SEC)) == std::future_status::ready;
+    }
+
+    ProfileStartupScheduler scheduler_ {};
+    std::vector<std::string> enabled_ {};
+    std::vector<std::string> completed_ {};
+    std::vector<std::string> skipped_ {};
+
+private:
+    void Advance(const ProfileStartupScheduler::Step &step)
+    {
+        skipped_.insert(skipped_.end(), step.skipped.begin(), step.skipped.end());
+        for (auto &name : step.ready) {
+            enabled_.push_back(name);
+            MockProfile profile = profiles_[name];
+            dispatchers_[name]->PostTask([this, profile]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(profile.enableMs));
+                manager_.PostTask([this, profile]() {
+                    completed_.push_back(profile.name);
+                    Advance(scheduler_.OnComplete(profile.name, profile.result));
+                });
+            });
+        }
+        if (scheduler_.IsFinished() && !finished_) {
+            finished_ = true;
+            done_.set_value();
+        }
+    }
+
+    utility::Dispatcher manager_;
+    std::map<std::string, MockProfile> profiles_ {};
+    std::map<std::string, std::unique_ptr<utility::Dispatcher>> dispatchers_ {};
+    std::promise<void> done_ {};
+    bool finished_ = false;
+};
+
+size_t IndexOf(const std::vector<std::string> &names, const std::string &name)
+{
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i] == name) {
+            return i;
+        }
+    }
+    return names.size();
+}
+
+const ProfileStartupRecord *FindRecord(const std::vector<ProfileStartupRecord> &records, const std::string &name)
+{
+    for (auto &record : records) {
+        if (record.name == name) {
+            return &record;
+        }
+    }
+    return nullptr;
+}
+}  // namespace
+
+class ProfileStartupTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+};
+
+/**
+ * @tc.number: ProfileStartup_UnitTest001
+ * @tc.name: Order
+ * @tc.desc: A profile is enabled only after its dependency completed, independent profiles are enabled at once.
+ */
+HWTEST_F(ProfileStartupTest, ProfileStartup_UnitTest_Order, TestSize.Level1)
+{
+    MockStartup startup({
+        {"GattClientService", {}, 30, true},
+        {"HidHostService", {"GattClientService"}, 10, true},
+        {"A2dpSrcService", {}, 10, true},
+        {"HfpAgService", {}, 10, true},
+        {"PanService", {"UnknownService"}, 10, true},
+    });
+    ASSERT_TRUE(startup.Run());
+
+    EXPECT_EQ(startup.enabled_.size(), 5u);
+    EXPECT_EQ(startup.completed_.size(), 5u);
+    EXPECT_TRUE(startup.skipped_.empty());
+    // Everything but the HOGP host went out before the first completion came back.
+    EXPECT_EQ(IndexOf(startup.enabled_, "HidHostService"), 4u);
+    EXPECT_LT(IndexOf(startup.completed_, "GattClientService"), IndexOf(startup.completed_, "HidHostService"));
+
+    auto records = startup.scheduler_.GetRecords();
+    const ProfileStartupRecord *gatt = FindRecord(records, "GattClientService");
+    const ProfileStartupRecord *hid = FindRecord(records, "HidHostService");
+    ASSERT_NE(gatt, nullptr);
+    ASSERT_NE(hid, nullptr);
+    EXPECT_TRUE(hid->result);
+    EXPECT_GE(hid->waitUs, gatt->waitUs + gatt->enableUs);
+    EXPECT_NE(startup.scheduler_.ToString().find("total="), std::string::npos);
+}
+
+/**
+ * @tc.number: ProfileStartup_UnitTest002
+ * @tc.name: Failure
+ * @tc.desc: Profiles behind a failed dependency are given up, the others still come up; cycles do not stall.
+ */
+HWTEST_F(ProfileStartupTest, ProfileStartup_UnitTest_Failure, TestSize.Level1)
+{
+    MockStartup startup({
+        {"GattClientService", {}, 5, false},
+        {"HidHostService", {"GattClientService"}, 5, true},
+        {"MockHogpUser", {"HidHostService"}, 5, true},
+        {"A2dpSrcService", {}, 5, true},
+        {"MapMseService", {"OppService"}, 5, true},
+        {"OppService", {"MapMseService"}, 5, true},
+    });
+    ASSERT_TRUE(startup.Run());
+
+    EXPECT_EQ(startup.skipped_.size(), 2u);
+    EXPECT_EQ(IndexOf(startup.enabled_, "HidHostService"), startup.enabled_.size());
+    EXPECT_EQ(IndexOf(startup.enabled_, "MockHogpUser"), startup.enabled_.size());
+    EXPECT_NE(IndexOf(startup.enabled_, "MapMseService"), startup.enabled_.size());
+    EXPECT_NE(IndexOf(startup.enabled_, "OppService"), startup.enabled_.size());
+    EXPECT_EQ(startup.completed_.size(), 4u);
+
+    // Results of profiles the startup did not release change nothing.
+    EXPECT_TRUE(startup.scheduler_.OnComplete("HidHostService", true).ready.empty());
+    EXPECT_TRUE(startup.scheduler_.OnComplete("UnknownService", true).ready.empty());
+    EXPECT_NE(startup.scheduler_.ToString().find("HidHostService=skipped"), std::string::npos);
+}
+
+/**
+ * @tc.number: ProfileStartup_UnitTest003
+ * @tc.name: Benchmark
+ * @tc.desc: Report the startup time of a typical profile set against enabling the same profiles one by one.
+ */
+HWTEST_F(ProfileStartupTest, ProfileStartup_UnitTest_Benchmark, TestSize.Level1)
+{
+    const std::vector<MockProfile> profiles = {
+        {"GattServerService", {}, 20, true},
+        {"GattClientService", {}, 30, true},
+        {"HidHostService", {"GattClientService"}, 20, true},
+        {"A2dpSrcService", {}, 40, true},
+        {"AvrcpTgService", {}, 20, true},
+        {"HfpAgService", {}, 40, true},
+        {"PanService", {}, 10, true},
+        {"MapMseService", {}, 10, true},
+        {"OppService", {}, 10, true},
+    };
+    int serialMs = 0;
+    for (auto &profile : profiles) {
+        serialMs += profile.enableMs;
+    }
+    // GATT client then HID host is the longest chain.
+    const int criticalMs = 50;
+
+    utility::PhaseTimer timer;
+    MockStartup startup(profiles);
+    timer.Mark("dispatchers");
+    ASSERT_TRUE(startup.Run());
+    timer.Mark("startup");
+    EXPECT_EQ(startup.completed_.size(), profiles.size());
+
+    double totalMs = startup.scheduler_.GetTotalUs() / 1000.0;
+    EXPECT_GE(totalMs, criticalMs);
+
+    // The HOGP host waited for the GATT client, every other profile was out before the first one came back.
+    auto records = startup.scheduler_.GetRecords();
+    ASSERT_EQ(records.size(), profiles.size());
+    uint64_t firstCompletedUs = UINT64_MAX;
+    for (auto &record : records) {
+        EXPECT_TRUE(record.released && record.completed);
+        firstCompletedUs = std::min(firstCompletedUs, record.waitUs + record.enableUs);
+    }
+    const ProfileStartupRecord *gatt = FindRecord(records, "GattClientService");
+    const ProfileStartupRecord *hid = FindRecord(records, "HidHostService");
+    ASSERT_NE(gatt, nullptr);
+    ASSERT_NE(hid, nullptr);
+    EXPECT_GE(hid->waitUs, gatt->waitUs + gatt->enableUs);
+    for (auto &record : records) {
+        if (record.name != "HidHostService") {
+            EXPECT_LT(record.waitUs, firstCompletedUs);
+        }
+    }
+
+    BenchmarkReport("profile_startup")
+        .Add("profiles", profiles.size())
+        .Add("serial_ms", serialMs)
+        .Add("critical_path_ms", criticalMs)
+        .Add("startup_ms", totalMs, 3)
+        .Publish();
+    GTEST_LOG_(INFO) << startup.scheduler_.ToString();
+    GTEST_LOG_(INFO) << timer.ToString();
+}
+
+/**
+ * @tc.number: ProfileStartup_UnitTest004
+ * @tc.name: Running
+ * @tc.desc: A profile already being enabled is not released again, its dependents wait for its completion.
+ */
+HWTEST_F(ProfileStartupTest, ProfileStartup_UnitTest_Running, TestSize.Level1)
+{
+    ProfileStartupScheduler scheduler;
+    auto step = scheduler.Start({
+        {"GattClientService", {}, true},
+        {"HidHostService", {"GattClientService"}},
+        {"PanService", {}},
+    });
+    EXPECT_EQ(step.ready, std::vector<std::string> {"PanService"});
+    EXPECT_TRUE(scheduler.OnComplete("PanService", true).ready.empty());
+    EXPECT_FALSE(scheduler.IsFinished());
+
+    step = scheduler.OnComplete("GattClientService", true);
+    EXPECT_EQ(step.ready, std::vector<std::string> {"HidHostService"});
+    EXPECT_TRUE(scheduler.OnComplete("HidHostService", true).ready.empty());
+    EXPECT_TRUE(scheduler.IsFinished());
+}
+}  // namespace bluetooth
+}  // namespace OHOS
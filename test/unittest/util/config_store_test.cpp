@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "config_store.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+using utility::ConfigStore;
+
+namespace {
+const std::string TEST_DIR = "/data/local/tmp/";
+const std::string TEST_XML = TEST_DIR + "bt_config_store_test.xml";
+const std::string SECTION = "Ble Paired Device List";
+const std::string DEVICE = "00:11:22:33:44:55";
+constexpr int FLUSH_DELAY_MS = 20;
+constexpr size_t NO_COMPACT = 1024 * 1024;
+}  // namespace
+
+class ConfigStoreTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {
+        mkdir(TEST_DIR.c_str(), S_IRWXU);
+    }
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {
+        RemoveFiles();
+        std::ofstream xml(TEST_XML, std::ios::out | std::ios::trunc);
+        xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            << "<BluetoothConfig>"
+            << "<T1 section=\"Host\"><T1 property=\"DeviceName\">phone</T1>"
+            << "<T1 property=\"ScanMode\">0x2</T1></T1>"
+            << "<T1 section=\"" << SECTION << "\"><T1 section=\"" << DEVICE << "\">"
+            << "<T1 property=\"PeerIrk\">A1B2C3</T1><T1 property=\"PairFlag\">true</T1></T1></T1>"
+            << "</BluetoothConfig>\n";
+    }
+    void TearDown()
+    {
+        RemoveFiles();
+    }
+
+    static void RemoveFiles()
+    {
+        unlink(TEST_XML.c_str());
+        unlink((TEST_XML + ".journal").c_str());
+        unlink((TEST_XML + ".journal.prev").c_str());
+        unlink((TEST_XML + ".snap").c_str());
+        unlink((TEST_XML + ".snap.prev").c_str());
+        unlink((TEST_XML + ".snap.corrupt").c_str());
+        unlink((TEST_XML + ".snap.tmp").c_str());
+    }
+
+    static void CorruptFile(const std::string &path)
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-1, std::ios::end);
+        char last = 0;
+        ASSERT_TRUE(file.get(last).good());
+        file.seekp(-1, std::ios::end);
+        file.put(static_cast<char>(last ^ 0xFF));
+    }
+};
+
+/**
+ * @tc.number: ConfigStore_UnitTest001
+ * @tc.name: ImportXml
+ * @tc.desc: First load imports the XML document with XmlParse value encoding.
+ */
+HWTEST_F(ConfigStoreTest, ConfigStore_UnitTest_ImportXml, TestSize.Level1)
+{
+    ConfigStore store(FLUSH_DELAY_MS);
+    ASSERT_TRUE(store.Load(TEST_XML));
+
+    std::string name;
+    int scanMode = 0;
+    bool pairFlag = false;
+    std::string irk;
+    EXPECT_TRUE(store.GetValue("Host", "DeviceName", name));
+    EXPECT_EQ(name, "phone");
+    EXPECT_TRUE(store.GetValue("Host", "ScanMode", scanMode));
+    EXPECT_EQ(scanMode, 0x2);
+    EXPECT_TRUE(store.GetValue(SECTION, DEVICE, "PairFlag", pairFlag));
+    EXPECT_TRUE(pairFlag);
+    EXPECT_TRUE(store.GetValue(SECTION, DEVICE, "PeerIrk", irk));
+    EXPECT_EQ(irk, "A1B2C3");
+
+    std::vector<std::string> devices;
+    EXPECT_TRUE(store.GetSubSections(SECTION, devices));
+    EXPECT_EQ(devices, std::vector<std::string> {DEVICE});
+    EXPECT_EQ(access((TEST_XML + ".snap").c_str(), F_OK), 0);
+}
+
+/**
+ * @tc.number: ConfigStore_UnitTest002
+ * @tc.name: GroupCommit
+ * @tc.desc: Save does not block and mutations reach the journal within the flush delay.
+ */
+HWTEST_F(ConfigStoreTest, ConfigStore_UnitTest_GroupCommit, TestSize.Level1)
+{
+    ConfigStore store(FLUSH_DELAY_MS, NO_COMPACT);
+    ASSERT_TRUE(store.Load(TEST_XML));
+    for (int i = 0; i < 100; i++) {
+        EXPECT_TRUE(store.SetValue(SECTION, DEVICE, "PeerSignCounter", i));
+        EXPECT_TRUE(store.Save());
+    }
+    EXPECT_TRUE(store.RemoveProperty(SECTION, DEVICE, "PeerIrk"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(FLUSH_DELAY_MS * 10));
+
+    ConfigStore reader(FLUSH_DELAY_MS, NO_COMPACT);
+    ASSERT_TRUE(reader.Load(TEST_XML));
+    int counter = 0;
+    EXPECT_TRUE(reader.GetValue(SECTION, DEVICE, "PeerSignCounter", counter));
+    EXPECT_EQ(counter, 99);
+    EXPECT_FALSE(reader.HasProperty(SECTION, DEVICE, "PeerIrk"));
+}
+
+/**
+ * @tc.number: ConfigStore_UnitTest003
+ * @tc.name: Compaction
+ * @tc.desc: Journal is folded into the snapshot and state survives reload.
+ */
+HWTEST_F(ConfigStoreTest, ConfigStore_UnitTest_Compaction, TestSize.Level1)
+{
+    {
+        ConfigStore store(FLUSH_DELAY_MS, 512);
+        ASSERT_TRUE(store.Load(TEST_XML));
+        for (int i = 0; i < 200; i++) {
+            std::string device = "00:00:00:00:00:" + std::to_string(i % 50);
+            store.SetValue(SECTION, device, "PeerKeySize", i);
+            if (i % 10 == 0) {
+                EXPECT_TRUE(store.Flush());
+            }
+        }
+        EXPECT_TRUE(store.RemoveSection(SECTION, DEVICE));
+        EXPECT_TRUE(store.Flush());
+    }
+    struct stat st {};
+    ASSERT_EQ(stat((TEST_XML + ".journal").c_str(), &st), 0);
+    EXPECT_LE(st.st_size, 512);
+
+    ConfigStore store(FLUSH_DELAY_MS);
+    ASSERT_TRUE(store.Load(TEST_XML));
+    std::vector<std::string> devices;
+    EXPECT_TRUE(store.GetSubSections(SECTION, devices));
+    EXPECT_EQ(devices.size(), 50u);
+    int keySize = 0;
+    EXPECT_TRUE(store.GetValue(SECTION, "00:00:00:00:00:49", "PeerKeySize", keySize));
+    EXPECT_EQ(keySize, 199);
+    EXPECT_FALSE(store.HasSection(SECTION, DEVICE));
+}
+
+/**
+ * @tc.number: ConfigStore_UnitTest004
+ * @tc.name: TornJournalTail
+ * @tc.desc: Garbage after the last valid record is dropped and appends continue.
+ */
+HWTEST_F(ConfigStoreTest, ConfigStore_UnitTest_TornJournalTail, TestSize.Level1)
+{
+    {
+        ConfigStore store(FLUSH_DELAY_MS, NO_COMPACT);
+        ASSERT_TRUE(store.Load(TEST_XML));
+        store.SetValue("Host", "DeviceName", std::string("tablet"));
+        EXPECT_TRUE(store.Flush());
+    }
+    {
+        std::ofstream journal(TEST_XML + ".journal", std::ios::out | std::ios::app | std::ios::binary);
+        journal << "BTCJ\x10garbage";
+    }
+    {
+        ConfigStore store(FLUSH_DELAY_MS, NO_COMPACT);
+        ASSERT_TRUE(store.Load(TEST_XML));
+        std::string name;
+        EXPECT_TRUE(store.GetValue("Host", "DeviceName", name));
+        EXPECT_EQ(name, "tablet");
+        store.SetValue("Host", "DeviceName", std::string("watch"));
+        EXPECT_TRUE(store.Flush());
+    }
+    ConfigStore store(FLUSH_DELAY_MS, NO_COMPACT);
+    ASSERT_TRUE(store.Load(TEST_XML));
+    std::string name;
+    EXPECT_TRUE(store.GetValue("Host", "DeviceName", name));
+    EXPECT_EQ(name, "watch");
+}
+
+/**
+ * @tc.number: ConfigStore_UnitTest005
+ * @tc.name: CrashAtEveryWriteStep
+ * @tc.desc: A crash at any write step, on the journal or the compaction path, leaves a committed prefix on disk.
+ */
+HWTEST_F(ConfigStoreTest, ConfigStore_UnitTest_CrashAtEveryWriteStep, TestSize.Level1)
+{
+    for (size_t compactThreshold : {NO_COMPACT, size_t(0)}) {
+        for (int crashStep = 0; crashStep < ConfigStore::WRITE_STEP_MAX; crashStep++) {
+            SetUp();
+            {
+                ConfigStore store(FLUSH_DELAY_MS, NO_COMPACT);
+                ASSERT_TRUE(store.Load(TEST_XML));
+                store.SetValue(SECTION, DEVICE, "PeerKeySize", 1);
+                ASSERT_TRUE(store.Flush());
+            }
+            {
+                ConfigStore store(FLUSH_DELAY_MS, compactThreshold);
+                store.SetWriteHook([crashStep](ConfigStore::WriteStep step) { return step != crashStep; });
+                ASSERT_TRUE(store.Load(TEST_XML));
+                store.SetValue(SECTION, DEVICE, "PeerKeySize", 2);
+                store.SetValue(SECTION, DEVICE, "PeerEdiv", 3);
+                store.Flush();
+            }
+
+            ConfigStore store(FLUSH_DELAY_MS, NO_COMPACT);
+            ASSERT_TRUE(store.Load(TEST_XML)) << "step " << crashStep;
+            int keySize = 0;
+            int ediv = 0;
+            EXPECT_TRUE(store.GetValue(SECTION, DEVICE, "PeerKeySize", keySize));
+            bool hasEdiv = store.GetValue(SECTION, DEVICE, "PeerEdiv", ediv);
+            EXPECT_TRUE((keySize == 1 && !hasEdiv) || (keySize == 2 && !hasEdiv) || (keySize == 2 && ediv == 3))
+                << "step " << crashStep << " threshold " << compactThreshold;
+
+            // The recovered store must accept and persist new writes.
+            store.SetValue(SECTION, DEVICE, "PeerKeySize", 4);
+            EXPECT_TRUE(store.Flush());
+            ConfigStore reader(FLUSH_DELAY_MS, NO_COMPACT);
+            ASSERT_TRUE(reader.Load(TEST_XML));
+            EXPECT_TRUE(reader.GetValue(SECTION, DEVICE, "PeerKeySize", keySize));
+            EXPECT_EQ(keySize, 4) << "step " << crashStep;
+        }
+    }
+}
+
+/**
+ * @tc.number: ConfigStore_UnitTest006
+ * @tc.name: CorruptedSnapshot
+ * @tc.desc: A snapshot failing its checksum is kept aside and the previous generation with both journals loaded,
+ *           changes committed since the migration survive.
+ */
+HWTEST_F(ConfigStoreTest, ConfigStore_UnitTest_CorruptedSnapshot, TestSize.Level1)
+{
+    {
+        // Every commit compacts, so the XML document is long out of date when the snapshot breaks.
+        ConfigStore store(FLUSH_DELAY_MS, 0);
+        ASSERT_TRUE(store.Load(TEST_XML));
+        store.SetValue("Host", "DeviceName", std::string("tablet"));
+        EXPECT_TRUE(store.Flush());
+        store.SetValue(SECTION, DEVICE, "PeerIrk", std::string("D4E5F6"));
+        EXPECT_TRUE(store.Flush());
+    }
+    CorruptFile(TEST_XML + ".snap");
+    {
+        ConfigStore store(FLUSH_DELAY_MS, NO_COMPACT);
+        ASSERT_TRUE(store.Load(TEST_XML));
+        std::string name;
+        std::string irk;
+        EXPECT_TRUE(store.GetValue("Host", "DeviceName", name));
+        EXPECT_EQ(name, "tablet");
+        EXPECT_TRUE(store.GetValue(SECTION, DEVICE, "PeerIrk", irk));
+        EXPECT_EQ(irk, "D4E5F6");
+    }
+    EXPECT_EQ(access((TEST_XML + ".snap.corrupt").c_str(), F_OK), 0);
+
+    // The rewritten snapshot holds everything by itself.
+    unlink((TEST_XML + ".journal").c_str());
+    unlink((TEST_XML + ".journal.prev").c_str());
+    unlink((TEST_XML + ".snap.prev").c_str());
+    ConfigStore store(FLUSH_DELAY_MS, NO_COMPACT);
+    ASSERT_TRUE(store.Load(TEST_XML));
+    std::string irk;
+    EXPECT_TRUE(store.GetValue(SECTION, DEVICE, "PeerIrk", irk));
+    EXPECT_EQ(irk, "D4E5F6");
+}
+
+/**
+ * @tc.number: ConfigStore_UnitTest007
+ * @tc.name: NoValidSnapshot
+ * @tc.desc: Without a valid snapshot generation the load fails and leaves the files as they are.
+ */
+HWTEST_F(ConfigStoreTest, ConfigStore_UnitTest_NoValidSnapshot, TestSize.Level1)
+{
+    {
+        ConfigStore store(FLUSH_DELAY_MS, NO_COMPACT);
+        ASSERT_TRUE(store.Load(TEST_XML));
+        store.SetValue("Host", "DeviceName", std::string("tablet"));
+        EXPECT_TRUE(store.Flush());
+    }
+    CorruptFile(TEST_XML + ".snap");
+
+    ConfigStore store(FLUSH_DELAY_MS, NO_COMPACT);
+    EXPECT_FALSE(store.Load(TEST_XML));
+    EXPECT_FALSE(store.Load(TEST_XML));
+    EXPECT_EQ(access((TEST_XML + ".snap").c_str(), F_OK), 0);
+    EXPECT_NE(access((TEST_XML + ".snap.corrupt").c_str(), F_OK), 0);
+}
+
+/**
+ * @tc.number: ConfigStore_UnitTest008
+ * @tc.name: EmptySections
+ * @tc.desc: Sections and sub-sections without properties survive the import and a snapshot round trip.
+ */
+HWTEST_F(ConfigStoreTest, ConfigStore_UnitTest_EmptySections, TestSize.Level1)
+{
+    {
+        std::ofstream xml(TEST_XML, std::ios::out | std::ios::trunc);
+        xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            << "<BluetoothConfig>"
+            << "<T1 section=\"Host\"></T1>"
+            << "<T1 section=\"" << SECTION << "\"><T1 section=\"" << DEVICE << "\"></T1></T1>"
+            << "</BluetoothConfig>\n";
+    }
+    {
+        ConfigStore store(FLUSH_DELAY_MS, NO_COMPACT);
+        ASSERT_TRUE(store.Load(TEST_XML));
+        EXPECT_TRUE(store.HasSection("Host"));
+        EXPECT_TRUE(store.HasSection(SECTION, DEVICE));
+    }
+    unlink((TEST_XML + ".journal").c_str());
+    ConfigStore store(FLUSH_DELAY_MS, NO_COMPACT);
+    ASSERT_TRUE(store.Load(TEST_XML));
+    EXPECT_TRUE(store.HasSection("Host"));
+    EXPECT_TRUE(store.HasSection(SECTION, DEVICE));
+    std::vector<std::string> devices;
+    EXPECT_TRUE(store.GetSubSections(SECTION, devices));
+    EXPECT_EQ(devices, std::vector<std::string> {DEVICE});
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "benchmark_report.h"
+#include "bt_device_key.h"
+#include "flat_hash_map.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace bluetooth {
+using utility::BtDeviceKey;
+using utility::FlatHashMap;
+
+namespace {
+constexpr size_t DEVICE_NUM = 10000;
+constexpr int LOOKUP_ROUNDS = 20;
+// Real scans see a few vendors many times over, so addresses share their upper three bytes.
+constexpr size_t VENDOR_NUM = 16;
+
+struct Device {
+    std::array<uint8_t, BtDeviceKey::ADDRESS_LEN> addr;
+    std::string address;
+};
+
+// String form the way RawAddress::ConvertToString builds it from BtAddr bytes.
+std::string ToRawString(const uint8_t *addr)
+{
+    char buf[18] = {};
+    (void)snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X",
+        addr[5], addr[4], addr[3], addr[2], addr[1], addr[0]);
+    return buf;
+}
+
+std::vector<Device> MakeDevices()
+{
+    std::mt19937 random(0x5EED);
+    std::vector<std::array<uint8_t, 3>> vendors(VENDOR_NUM);
+    for (auto &vendor : vendors) {
+        for (auto &byte : vendor) {
+            byte = static_cast<uint8_t>(random());
+        }
+    }
+    std::set<std::string> seen;
+    std::vector<Device> devices;
+    while (devices.size() < DEVICE_NUM) {
+        Device device {};
+        const auto &vendor = vendors[random() % VENDOR_NUM];
+        for (size_t i = 0; i < 3; i++) {
+            device.addr[i] = static_cast<uint8_t>(random());
+            device.addr[i + 3] = vendor[i];
+        }
+        device.address = ToRawString(device.addr.data());
+        if (seen.insert(device.address).second) {
+            devices.push_back(device);
+        }
+    }
+    return devices;
+}
+
+template<class F>
+double NsPerOp(size_t ops, F &&run)
+{
+    auto start = std::chrono::steady_clock::now();
+    run();
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / ops;
+}
+}  // namespace
+
+class DeviceKeyTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+};
+
+/**
+ * @tc.number: DeviceKey_UnitTest001
+ * @tc.name: Conversion
+ * @tc.desc: Keys from strings and from BtAddr bytes agree, convert back unchanged and reject malformed strings.
+ */
+HWTEST_F(DeviceKeyTest, DeviceKey_UnitTest_Conversion, TestSize.Level1)
+{
+    const uint8_t addr[BtDeviceKey::ADDRESS_LEN] = {0x13, 0x71, 0xDA, 0x7D, 0x1A, 0x00};
+    BtDeviceKey key = BtDeviceKey::FromString("00:1A:7D:DA:71:13");
+    EXPECT_TRUE(key.IsValid());
+    EXPECT_EQ(key, BtDeviceKey::FromAddress(addr));
+    EXPECT_EQ(key, BtDeviceKey::FromString("00:1a:7d:da:71:13"));
+    EXPECT_EQ(key.ToString(), "00:1A:7D:DA:71:13");
+    EXPECT_EQ(key.GetType(), BtDeviceKey::TYPE_ANY);
+
+    uint8_t out[BtDeviceKey::ADDRESS_LEN] = {};
+    key.ToAddress(out);
+    EXPECT_EQ(std::vector<uint8_t>(out, out + sizeof(out)), std::vector<uint8_t>(addr, addr + sizeof(addr)));
+
+    BtDeviceKey publicKey = BtDeviceKey::FromAddress(addr, 0x00);
+    BtDeviceKey randomKey = BtDeviceKey::FromAddress(addr, 0x01);
+    EXPECT_NE(publicKey, randomKey);
+    EXPECT_NE(publicKey, key);
+    EXPECT_EQ(randomKey.GetType(), 0x01);
+    EXPECT_EQ(randomKey.ToString(), key.ToString());
+
+    EXPECT_TRUE(BtDeviceKey::FromString("00:00:00:00:00:00").IsValid());
+    EXPECT_TRUE(BtDeviceKey::FromString("FF:FF:FF:FF:FF:FF").IsValid());
+    EXPECT_FALSE(BtDeviceKey::FromString("").IsValid());
+    EXPECT_FALSE(BtDeviceKey::FromString("00:1A:7D:DA:71").IsValid());
+    EXPECT_FALSE(BtDeviceKey::FromString("00-1A-7D-DA-71-13").IsValid());
+    EXPECT_FALSE(BtDeviceKey::FromString("00:1A:7D:DA:71:1G").IsValid());
+    EXPECT_FALSE(BtDeviceKey::FromString("00:1A:7D:DA:71:13:").IsValid());
+
+    // Untyped keys sort like the upper case strings they replace.
+    auto devices = MakeDevices();
+    std::map<BtDeviceKey, std::string> sorted;
+    for (const auto &device : devices) {
+        sorted.emplace(BtDeviceKey::FromString(device.address), device.address);
+    }
+    std::string last;
+    for (const auto &entry : sorted) {
+        EXPECT_LT(last, entry.second);
+        EXPECT_EQ(entry.first.ToString(), entry.second);
+        last = entry.second;
+    }
+}
+
+/**
+ * @tc.number: DeviceKey_UnitTest002
+ * @tc.name: FlatHashMap
+ * @tc.desc: Map keeps every entry reachable through growth and erase, and iterates each entry once.
+ */
+HWTEST_F(DeviceKeyTest, DeviceKey_UnitTest_FlatHashMap, TestSize.Level1)
+{
+    auto devices = MakeDevices();
+    FlatHashMap<BtDeviceKey, std::shared_ptr<size_t>> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(BtDeviceKey::FromString(devices[0].address)), map.end());
+
+    for (size_t i = 0; i < devices.size(); i++) {
+        auto result = map.insert(std::make_pair(BtDeviceKey::FromAddress(devices[i].addr.data()),
+            std::make_shared<size_t>(i)));
+        EXPECT_TRUE(result.second);
+    }
+    EXPECT_EQ(map.size(), devices.size());
+    EXPECT_FALSE(map.emplace(BtDeviceKey::FromString(devices[1].address), nullptr).second);
+    EXPECT_EQ(*map[BtDeviceKey::FromString(devices[1].address)], 1u);
+
+    // Erase every third device, the entries shifted back behind them must stay reachable.
+    for (size_t i = 0; i < devices.size(); i += 3) {
+        EXPECT_EQ(map.erase(BtDeviceKey::FromString(devices[i].address)), 1u);
+    }
+    EXPECT_EQ(map.erase(BtDeviceKey::FromString(devices[0].address)), 0u);
+    for (size_t i = 0; i < devices.size(); i++) {
+        auto it = map.find(BtDeviceKey::FromString(devices[i].address));
+        if (i % 3 == 0) {
+            EXPECT_EQ(it, map.end());
+        } else {
+            ASSERT_NE(it, map.end());
+            EXPECT_EQ(*it->second, i);
+        }
+    }
+
+    // Erasing while iterating revisits the slot an entry moved into, so every even entry goes.
+    for (auto it = map.begin(); it != map.end();) {
+        if (*it->second % 2 == 0) {
+            it = map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    std::set<size_t> visited;
+    for (const auto &entry : map) {
+        EXPECT_EQ(*entry.second % 2, 1u);
+        EXPECT_TRUE(visited.insert(*entry.second).second);
+    }
+    EXPECT_EQ(visited.size(), map.size());
+
+    FlatHashMap<BtDeviceKey, std::shared_ptr<size_t>> copy(map);
+    FlatHashMap<BtDeviceKey, std::shared_ptr<size_t>> moved(std::move(map));
+    EXPECT_EQ(copy.size(), visited.size());
+    EXPECT_EQ(moved.size(), visited.size());
+    for (size_t index : visited) {
+        EXPECT_NE(copy.find(BtDeviceKey::FromString(devices[index].address)), copy.end());
+    }
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(moved.find(BtDeviceKey::FromString(devices[1].address)), moved.end());
+
+    FlatHashMap<uint16_t, std::string> handles;
+    handles[0x0001] = devices[0].address;
+    handles.erase(handles.find(0x0001));
+    EXPECT_TRUE(handles.empty());
+}
+
+/**
+ * @tc.number: DeviceKey_UnitTest003
+ * @tc.name: Benchmark
+ * @tc.desc: Report insert and lookup cost of 10k devices, string keyed std::map against BtDeviceKey FlatHashMap.
+ */
+HWTEST_F(DeviceKeyTest, DeviceKey_UnitTest_Benchmark, TestSize.Level1)
+{
+    auto devices = MakeDevices();
+    std::map<std::string, std::shared_ptr<size_t>> stringMap;
+    FlatHashMap<BtDeviceKey, std::shared_ptr<size_t>> keyMap;
+    auto value = std::make_shared<size_t>(0);
+    size_t found = 0;
+
+    // Stack events carry BtAddr, the string table needs the string built first.
+    double mapInsert = NsPerOp(devices.size(), [&]() {
+        for (const auto &device : devices) {
+            stringMap.insert(std::make_pair(ToRawString(device.addr.data()), value));
+        }
+    });
+    double flatInsert = NsPerOp(devices.size(), [&]() {
+        for (const auto &device : devices) {
+            keyMap.insert(std::make_pair(BtDeviceKey::FromAddress(device.addr.data()), value));
+        }
+    });
+
+    // API calls carry the RawAddress string.
+    size_t lookups = devices.size() * LOOKUP_ROUNDS;
+    double mapFind = NsPerOp(lookups, [&]() {
+        for (int round = 0; round < LOOKUP_ROUNDS; round++) {
+            for (const auto &device : devices) {
+                found += (stringMap.find(device.address) != stringMap.end()) ? 1 : 0;
+            }
+        }
+    });
+    double flatFind = NsPerOp(lookups, [&]() {
+        for (int round = 0; round < LOOKUP_ROUNDS; round++) {
+            for (const auto &device : devices) {
+                found += (keyMap.find(BtDeviceKey::FromString(device.address)) != keyMap.end()) ? 1 : 0;
+            }
+        }
+    });
+    double mapEventFind = NsPerOp(lookups, [&]() {
+        for (int round = 0; round < LOOKUP_ROUNDS; round++) {
+            for (const auto &device : devices) {
+                found += (stringMap.find(ToRawString(device.addr.data())) != stringMap.end()) ? 1 : 0;
+            }
+        }
+    });
+    double flatEventFind = NsPerOp(lookups, [&]() {
+        for (int round = 0; round < LOOKUP_ROUNDS; round++) {
+            for (const auto &device : devices) {
+                found += (keyMap.find(BtDeviceKey::FromAddress(device.addr.data())) != keyMap.end()) ? 1 : 0;
+            }
+        }
+    });
+    EXPECT_EQ(found, lookups * 4);
+    EXPECT_EQ(stringMap.size(), keyMap.size());
+
+    BenchmarkReport("device_key_table")
+        .Add("devices", devices.size())
+        .Add("map_insert_ns", mapInsert)
+        .Add("flat_insert_ns", flatInsert)
+        .Add("map_find_string_ns", mapFind)
+        .Add("flat_find_string_ns", flatFind)
+        .Add("map_find_btaddr_ns", mapEventFind)
+        .Add("flat_find_btaddr_ns", flatEventFind)
+        .Publish();
+}
+}  // namespace bluetooth
+}  // namespace OHOS
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "dispatcher.h"
+#include "fixed_queue.h"
+#include "mpsc_queue.h"
+#include "task.h"
+
+using namespace testing::ext;
+
+namespace {
+// Counts every allocation of this test binary, so tests read deltas around the code they measure.
+std::atomic<size_t> g_allocCount {0};
+}  // namespace
+
+void *operator new(size_t size)
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace OHOS {
+namespace bluetooth {
+using utility::Dispatcher;
+using utility::MpscQueue;
+using utility::Task;
+
+namespace {
+constexpr int PRODUCER_NUM = 4;
+constexpr int POSTS_PER_PRODUCER = 20000;
+// Posts in flight per producer, kept below the dispatcher queue depth so no post is dropped.
+constexpr int WINDOW = 16;
+constexpr int BENCH_POSTS = 200000;
+
+// A typical profile event: a few handles plus an address-sized payload.
+struct EventPayload {
+    uint16_t handle;
+    uint16_t status;
+    std::array<uint8_t, 40> data;
+};
+
+// Dispatcher as it was before Task and MpscQueue, used as the benchmark baseline.
+class LegacyDispatcher {
+public:
+    LegacyDispatcher() : taskQueue_(128)
+    {}
+    void Initialize()
+    {
+        start_ = true;
+        thread_ = std::thread([this] {
+            while (start_) {
+                std::function<void()> task;
+                taskQueue_.Pop(task);
+                task();
+            }
+        });
+    }
+    void Uninitialize()
+    {
+        start_ = false;
+        taskQueue_.Push([] {});
+        thread_.join();
+    }
+    void PostTask(const std::function<void()> &task)
+    {
+        if (start_) {
+            taskQueue_.TryPush(std::move(task));
+        }
+    }
+
+private:
+    std::atomic_bool start_ {false};
+    std::thread thread_ {};
+    utility::FixedQueue<std::function<void()>> taskQueue_;
+};
+
+void WaitFor(const std::atomic<int> &counter, int expected)
+{
+    while (counter.load(std::memory_order_acquire) < expected) {
+        std::this_thread::yield();
+    }
+}
+
+template<class D>
+void RunBenchmark(D &dispatcher, const char *name)
+{
+    std::atomic<int> done {0};
+    EventPayload payload = {};
+    size_t allocBefore = g_allocCount.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_POSTS; i++) {
+        payload.handle = static_cast<uint16_t>(i);
+        dispatcher.PostTask([payload, &done]() {
+            if (payload.status == 0) {
+                done.fetch_add(1, std::memory_order_release);
+            }
+        });
+        if ((i + 1) % WINDOW == 0) {
+            WaitFor(done, i + 1);
+        }
+    }
+    WaitFor(done, BENCH_POSTS);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t allocs = g_allocCount.load() - allocBefore;
+    GTEST_LOG_(INFO) << name << ": " << static_cast<long>(BENCH_POSTS / elapsed) << " posts/s, "
+                     << static_cast<double>(allocs) / BENCH_POSTS << " allocations/post";
+}
+}  // namespace
+
+class DispatcherTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp()
+    {}
+    void TearDown()
+    {}
+};
+
+/**
+ * @tc.number: Dispatcher_UnitTest001
+ * @tc.name: TaskStorage
+ * @tc.desc: Captures up to the inline size do not allocate, larger ones allocate once, move-only captures work.
+ */
+HWTEST_F(DispatcherTest, Dispatcher_UnitTest_TaskStorage, TestSize.Level1)
+{
+    int result = 0;
+    EventPayload payload = {};
+    payload.status = 7;
+
+    size_t allocBefore = g_allocCount.load();
+    Task small([payload, &result]() { result = payload.status; });
+    Task moved(std::move(small));
+    EXPECT_EQ(g_allocCount.load(), allocBefore);
+    EXPECT_FALSE(small);
+    moved();
+    EXPECT_EQ(result, 7);
+
+    std::array<uint8_t, Task::INLINE_SIZE * 2> large = {};
+    large[0] = 9;
+    allocBefore = g_allocCount.load();
+    Task big([large, &result]() { result = large[0]; });
+    Task bigMoved(std::move(big));
+    EXPECT_EQ(g_allocCount.load(), allocBefore + 1);
+    bigMoved();
+    EXPECT_EQ(result, 9);
+
+    auto owned = std::make_unique<int>(11);
+    Task unique([owned = std::move(owned), &result]() { result = *owned; });
+    unique();
+    EXPECT_EQ(result, 11);
+
+    EXPECT_FALSE(Task(std::function<void()>()));
+}
+
+/**
+ * @tc.number: Dispatcher_UnitTest002
+ * @tc.name: MpscQueueBounded
+ * @tc.desc: Queue keeps FIFO order, rejects pushes when full and reuses slots after pops.
+ */
+HWTEST_F(DispatcherTest, Dispatcher_UnitTest_MpscQueueBounded, TestSize.Level1)
+{
+    MpscQueue<int> queue(5);
+    constexpr int capacity = 8;
+    for (int i = 0; i < capacity; i++) {
+        EXPECT_TRUE(queue.TryPush(int(i)));
+    }
+    EXPECT_FALSE(queue.TryPush(int(capacity)));
+    for (int round = 0; round < capacity * 3; round++) {
+        int value = -1;
+        ASSERT_TRUE(queue.TryPop(value));
+        EXPECT_EQ(value, round);
+        EXPECT_TRUE(queue.TryPush(round + capacity));
+    }
+}
+
+/**
+ * @tc.number: Dispatcher_UnitTest003
+ * @tc.name: MultiProducer
+ * @tc.desc: Tasks from several producers all run, and each producer's tasks run in posting order.
+ */
+HWTEST_F(DispatcherTest, Dispatcher_UnitTest_MultiProducer, TestSize.Level1)
+{
+    Dispatcher dispatcher("bt-dispatcher-test");
+    dispatcher.Initialize();
+
+    std::array<std::atomic<int>, PRODUCER_NUM> done = {};
+    std::array<int, PRODUCER_NUM> lastSeen = {};
+    std::atomic<int> outOfOrder {0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCER_NUM; p++) {
+        lastSeen[p] = -1;
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < POSTS_PER_PRODUCER; i++) {
+                dispatcher.PostTask([&, p, i]() {
+                    if (lastSeen[p] + 1 != i) {
+                        outOfOrder++;
+                    }
+                    lastSeen[p] = i;
+                    done[p].fetch_add(1, std::memory_order_release);
+                });
+                if ((i + 1) % WINDOW == 0) {
+                    WaitFor(done[p], i + 1);
+                }
+            }
+            WaitFor(done[p], POSTS_PER_PRODUCER);
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    dispatcher.Uninitialize();
+
+    for (int p = 0; p < PRODUCER_NUM; p++) {
+        EXPECT_EQ(done[p].load(), POSTS_PER_PRODUCER);
+    }
+    EXPECT_EQ(outOfOrder.load(), 0);
+}
+
+/**
+ * @tc.number: Dispatcher_UnitTest004
+ * @tc.name: Restart
+ * @tc.desc: Uninitialize returns while idle, and a restarted dispatcher runs new tasks.
+ */
+HWTEST_F(DispatcherTest, Dispatcher_UnitTest_Restart, TestSize.Level1)
+{
+    Dispatcher dispatcher("bt-dispatcher-test");
+    std::atomic<int> done {0};
+    for (int round = 0; round < 3; round++) {
+        dispatcher.Initialize();
+        dispatcher.PostTask([&done]() { done++; });
+        WaitFor(done, round + 1);
+        dispatcher.Uninitialize();
+    }
+    dispatcher.PostTask([&done]() { done++; });
+    EXPECT_EQ(done.load(), 3);
+}
+
+/**
+ * @tc.number: Dispatcher_UnitTest005
+ * @tc.name: Benchmark
+ * @tc.desc: Report posts/s and allocations/post of the dispatcher against the FixedQueue implementation.
+ */
+HWTEST_F(DispatcherTest, Dispatcher_UnitTest_Benchmark, TestSize.Level1)
+{
+    LegacyDispatcher legacy;
+    legacy.Initialize();
+    RunBenchmark(legacy, "FixedQueue<std::function>");
+    legacy.Uninitialize();
+
+    Dispatcher dispatcher("bt-dispatcher-bench");
+    dispatcher.Initialize();
+    RunBenchmark(dispatcher, "MpscQueue<Task>");
+    dispatcher.Uninitialize();
+}
+}  // namespace bluetooth
+}  // namespace OHOS